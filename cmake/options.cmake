@@ -110,12 +110,16 @@ option(DNNL_ENABLE_JIT_PROFILING
 
 set(DNNL_CPU_RUNTIME "OMP" CACHE STRING
     "specifies the threading runtime for CPU engines;
-    supports OMP (default) or TBB.
+    supports OMP (default), TBB, SEQ or THREADPOOL.
 
     To use Intel(R) Threading Building Blocks (Intel(R) TBB) one should also
     set TBBROOT (either environment variable or CMake option) to the library
-    location.")
-if(NOT ${DNNL_CPU_RUNTIME} MATCHES "^(OMP|TBB|SEQ)$")
+    location.
+
+    THREADPOOL makes the library run parallel regions through a threadpool
+    supplied by the user via stream attributes (see dnnl_threadpool_iface.hpp).
+    Without a threadpool the primitives are executed sequentially.")
+if(NOT ${DNNL_CPU_RUNTIME} MATCHES "^(OMP|TBB|SEQ|THREADPOOL)$")
     message(FATAL_ERROR "Unsupported CPU runtime: ${DNNL_CPU_RUNTIME}")
 endif()
 
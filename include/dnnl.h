@@ -592,6 +592,122 @@ dnnl_status_t DNNL_API dnnl_post_ops_get_params_eltwise(
         const_dnnl_post_ops_t post_ops, int index, float *scale,
         dnnl_alg_kind_t *alg_kind, float *alpha, float *beta);
 
+/// Appends a binary post-op.
+///
+/// The kind of this post operation is #dnnl_binary.
+///
+/// In the simplest case when the binary is the only post operation, the
+/// computations would be:
+///
+///     dst[:] <- binary_op (op(...), src1[:])
+///
+/// where binary_op is configured with the given parameters and src1 is the
+/// second source tensor. The tensor is passed at the execution stage in the
+/// argument with index
+/// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_SRC_1`), where index
+/// is the position of the post-op. The dimensions of @p src1_desc must be
+/// equal to the dimensions of the destination or to 1, in which case the
+/// tensor is broadcast along them.
+///
+/// @param post_ops Post-ops.
+/// @param alg_kind Binary algorithm for the post-op.
+/// @param src1_desc Memory descriptor of the second source tensor.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_post_ops_append_binary(dnnl_post_ops_t post_ops,
+        dnnl_alg_kind_t alg_kind, const dnnl_memory_desc_t *src1_desc);
+
+/// Returns the parameters of a binary post-op.
+///
+/// @param post_ops Post-ops.
+/// @param index Index of the binary post-op.
+/// @param alg_kind Output binary algorithm kind.
+/// @param src1_desc Output memory descriptor of the second source tensor.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+/// @returns #dnnl_invalid_arguments if @p index does not refer to a binary
+///     post-op.
+dnnl_status_t DNNL_API dnnl_post_ops_get_params_binary(
+        const_dnnl_post_ops_t post_ops, int index, dnnl_alg_kind_t *alg_kind,
+        const dnnl_memory_desc_t **src1_desc);
+
+/// Appends a depthwise post-op convolution with kernel size 3, stride 1 and
+/// padding 1.
+///
+/// The kind of this post operation is #dnnl_convolution.
+///
+/// The post-op convolves the result of a 1x1 convolution with a 3x3
+/// depthwise filter, so the primitive destination has the spatial
+/// dimensions of the depthwise convolution output. The weights and the
+/// optional bias of the depthwise convolution are passed at the execution
+/// stage in the arguments with indices
+/// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_WEIGHTS`) and
+/// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_BIAS`), where index is
+/// the position of the post-op. Their memory descriptors should be queried
+/// from the primitive descriptor using #dnnl_query_exec_arg_md.
+///
+/// Only a single depthwise post-op can be appended.
+///
+/// @param post_ops Post-ops.
+/// @param weights_data_type Weights data type of the depthwise convolution.
+/// @param bias_data_type Bias data type of the depthwise convolution, or
+///     #dnnl_data_type_undef if the convolution has no bias.
+/// @param dst_data_type Destination data type of the depthwise convolution.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_post_ops_append_dw_k3s1p1(dnnl_post_ops_t post_ops,
+        dnnl_data_type_t weights_data_type, dnnl_data_type_t bias_data_type,
+        dnnl_data_type_t dst_data_type);
+
+/// Returns the parameters of a depthwise post-op convolution with stride 1.
+///
+/// @param post_ops Post-ops.
+/// @param index Index of the depthwise post-op.
+/// @param weights_data_type Output weights data type.
+/// @param bias_data_type Output bias data type.
+/// @param dst_data_type Output destination data type.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+/// @returns #dnnl_invalid_arguments if @p index does not refer to a
+///     depthwise post-op with stride 1.
+dnnl_status_t DNNL_API dnnl_post_ops_get_params_dw_k3s1p1(
+        const_dnnl_post_ops_t post_ops, int index,
+        dnnl_data_type_t *weights_data_type, dnnl_data_type_t *bias_data_type,
+        dnnl_data_type_t *dst_data_type);
+
+/// Appends a depthwise post-op convolution with kernel size 3, stride 2 and
+/// padding 1.
+///
+/// The post-op is identical to the one appended by
+/// dnnl_post_ops_append_dw_k3s1p1() except for the stride.
+///
+/// @param post_ops Post-ops.
+/// @param weights_data_type Weights data type of the depthwise convolution.
+/// @param bias_data_type Bias data type of the depthwise convolution, or
+///     #dnnl_data_type_undef if the convolution has no bias.
+/// @param dst_data_type Destination data type of the depthwise convolution.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_post_ops_append_dw_k3s2p1(dnnl_post_ops_t post_ops,
+        dnnl_data_type_t weights_data_type, dnnl_data_type_t bias_data_type,
+        dnnl_data_type_t dst_data_type);
+
+/// Returns the parameters of a depthwise post-op convolution with stride 2.
+///
+/// @param post_ops Post-ops.
+/// @param index Index of the depthwise post-op.
+/// @param weights_data_type Output weights data type.
+/// @param bias_data_type Output bias data type.
+/// @param dst_data_type Output destination data type.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+/// @returns #dnnl_invalid_arguments if @p index does not refer to a
+///     depthwise post-op with stride 2.
+dnnl_status_t DNNL_API dnnl_post_ops_get_params_dw_k3s2p1(
+        const_dnnl_post_ops_t post_ops, int index,
+        dnnl_data_type_t *weights_data_type, dnnl_data_type_t *bias_data_type,
+        dnnl_data_type_t *dst_data_type);
+
 /// @} dnnl_api_attributes
 
 /// @} dnnl_api_primitives
@@ -797,6 +913,21 @@ dnnl_status_t DNNL_API dnnl_memory_get_data_handle(
 dnnl_status_t DNNL_API dnnl_memory_set_data_handle(
         dnnl_memory_t memory, void *handle);
 
+/// Marks a CPU memory object as holding constant data, such as reordered
+/// weights, to be replicated on the NUMA nodes it is used on. When the memory
+/// is passed as an input to a primitive executed on a stream bound to a NUMA
+/// node (see dnnl_stream_attr_set_numa_node()), the primitive reads a copy of
+/// the memory placed on that node, which is created on first use. The copies
+/// are dropped when the data handle of the memory is changed, so the data
+/// must not be modified otherwise.
+///
+/// @param memory Memory object.
+/// @param replicated Whether the memory is replicated (non-zero) or not.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_memory_set_numa_replicated(
+        dnnl_memory_t memory, int replicated);
+
 #if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
 /// Returns an OpenCL memory object associated with a memory object.
 ///
@@ -1210,6 +1341,49 @@ dnnl_status_t DNNL_API dnnl_dilated_convolution_backward_weights_desc_init(
 
 /// @} dnnl_api_convolution
 
+/// @addtogroup dnnl_api_conv_stack
+/// @{
+
+/// Creates a primitive descriptor for a convolution stack primitive that
+/// computes a sequence of forward inference convolutions in which the
+/// destination of each convolution is the source of the next one.
+///
+/// @note
+///     This primitive is experimental. The memory descriptors of the
+///     intermediate activations (destination of all the convolutions but the
+///     last one and source of all the convolutions but the first one) must be
+///     initialized with #dnnl_format_tag_any. They are never exposed to the
+///     user, which allows an implementation to keep them in cache.
+///
+/// Inputs:
+///  - src (#dnnl_query_src_md, 0)
+///  - weights\[i\] (#dnnl_query_exec_arg_md, #DNNL_ARG_MULTIPLE_WEIGHTS + i)
+///    for i in [0, @p n)
+///  - bias\[i\] (#dnnl_query_exec_arg_md, #DNNL_ARG_MULTIPLE_BIAS + i), if
+///    convolution i is created with bias
+///
+/// Outputs:
+///  - dst (#dnnl_query_dst_md, 0)
+///
+/// @param conv_stack_primitive_desc Output primitive descriptor.
+/// @param n Number of convolutions.
+/// @param conv_descs Array of forward inference convolution descriptors
+///     having @p n elements.
+/// @param conv_attrs Array of primitive attributes of the convolutions having
+///     @p n elements (can be NULL). Each convolution can have at most one
+///     post-op, which must be an eltwise one.
+/// @param attr Primitive attributes to use (can be NULL).
+/// @param engine Engine to use.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_conv_stack_primitive_desc_create(
+        dnnl_primitive_desc_t *conv_stack_primitive_desc, int n,
+        const dnnl_convolution_desc_t *conv_descs,
+        const const_dnnl_primitive_attr_t *conv_attrs,
+        const_dnnl_primitive_attr_t attr, dnnl_engine_t engine);
+
+/// @} dnnl_api_conv_stack
+
 /// @addtogroup dnnl_api_deconvolution
 /// @{
 
@@ -2336,6 +2510,87 @@ dnnl_status_t DNNL_API dnnl_lstm_forward_desc_init(dnnl_rnn_desc_t *rnn_desc,
         const dnnl_memory_desc_t *dst_iter_desc,
         const dnnl_memory_desc_t *dst_iter_c_desc, unsigned flags);
 
+/// Initializes a descriptor for forward propagation primitive of an LSTM
+/// with peephole connections and/or a projection.
+///
+/// The @p src_iter_desc, @p src_iter_c_desc, @p weights_peephole_desc,
+/// @p weights_projection_desc, @p bias_desc, @p dst_iter_desc, and
+/// @p dst_iter_c_desc may either be @c NULL or point to a zero memory
+/// descriptor. This would then indicate that the LSTM forward propagation
+/// primitive should not use them and should default to zero values instead.
+///
+/// The peephole weights have the (num_layers, num_directions, 3,
+/// hidden_channels) shape and the #dnnl_f32 data type. The projection
+/// weights have the (num_layers, num_directions, hidden_channels,
+/// output_channels) shape and the data type of @p weights_layer_desc. With a
+/// projection, the gates and the cell states have hidden_channels channels
+/// while the hidden states and the output have output_channels channels.
+///
+/// @note
+///     All memory descriptors are allowed to be initialized with
+///     #dnnl_format_tag_any or with format_kind set to #dnnl_format_kind_any.
+///
+/// Inputs:
+///  - src_layer (#dnnl_query_src_md, 0)
+///  - src_iter (#dnnl_query_src_md, 1), if used
+///  - src_iter_c (#dnnl_query_src_md, 2), if used
+///  - weights_layer (#dnnl_query_weights_md, 0)
+///  - weights_iter (#dnnl_query_weights_md, 1)
+///  - bias (#dnnl_query_weights_md, 2), if used
+///  - weights_peephole (#dnnl_query_weights_md, 3), if used
+///  - weights_projection (#dnnl_query_weights_md, 4), if used
+///
+/// Outputs:
+///  - dst_layer (#dnnl_query_dst_md, 0)
+///  - dst_iter (#dnnl_query_dst_md, 1), if used
+///  - dst_iter_c (#dnnl_query_dst_md, 2), if used
+///  - workspace (#dnnl_query_workspace_md, 0),
+///     if @p prop_kind equals #dnnl_forward_training; must be queried for
+///     using @ref dnnl_primitive_desc_query_md() after a corresponding
+///     primitive descriptor is created
+///
+/// @param rnn_desc Output descriptor for LSTM primitive.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param direction RNN direction. See @ref dnnl_rnn_direction_t for more
+///     info.
+/// @param src_layer_desc Memory descriptor for the input vector.
+/// @param src_iter_desc Memory descriptor for the input recurrent hidden
+///     state vector.
+/// @param src_iter_c_desc Memory descriptor for the input recurrent cell
+///     state vector.
+/// @param weights_layer_desc Memory descriptor for the weights applied to the
+///     layer input.
+/// @param weights_iter_desc Memory descriptor for the weights applied to the
+///     recurrent input.
+/// @param weights_peephole_desc Memory descriptor for the weights applied to
+///     the cell states (according to the Peephole LSTM formula).
+/// @param weights_projection_desc Memory descriptor for the weights applied
+///     to the hidden states to get the recurrent projection (according to
+///     the Projection LSTM formula).
+/// @param bias_desc Bias memory descriptor.
+/// @param dst_layer_desc Memory descriptor for the output vector.
+/// @param dst_iter_desc Memory descriptor for the output recurrent hidden
+///     state vector.
+/// @param dst_iter_c_desc Memory descriptor for the output recurrent cell
+///     state vector.
+/// @param flags RNN cell flags. See @ref dnnl_rnn_flags_t.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_lstm_forward_desc_init_v2(dnnl_rnn_desc_t *rnn_desc,
+        dnnl_prop_kind_t prop_kind, dnnl_rnn_direction_t direction,
+        const dnnl_memory_desc_t *src_layer_desc,
+        const dnnl_memory_desc_t *src_iter_desc,
+        const dnnl_memory_desc_t *src_iter_c_desc,
+        const dnnl_memory_desc_t *weights_layer_desc,
+        const dnnl_memory_desc_t *weights_iter_desc,
+        const dnnl_memory_desc_t *weights_peephole_desc,
+        const dnnl_memory_desc_t *weights_projection_desc,
+        const dnnl_memory_desc_t *bias_desc,
+        const dnnl_memory_desc_t *dst_layer_desc,
+        const dnnl_memory_desc_t *dst_iter_desc,
+        const dnnl_memory_desc_t *dst_iter_c_desc, unsigned flags);
+
 /// Initializes a descriptor for LSTM backward propagation primitive.
 ///
 /// The @p src_iter_desc together with @p diff_iter_desc, @p src_iter_c_desc
@@ -2846,6 +3101,19 @@ dnnl_status_t DNNL_API dnnl_engine_get_ocl_device(
         dnnl_engine_t engine, cl_device_id *device);
 #endif
 
+/// Sets the allocator of the memory of an engine: the memory of memory
+/// objects the library allocates, the scratchpads and the other buffers the
+/// primitives allocate. The allocator applies to the memory allocated after
+/// the call, the memory allocated before is deallocated with the allocator
+/// it was allocated with.
+///
+/// @param engine Engine. Only CPU engines are supported.
+/// @param allocator Allocator. Passing NULL restores the default allocator.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_set_allocator(
+        dnnl_engine_t engine, const dnnl_allocator_t *allocator);
+
 /// Destroys an engine.
 ///
 /// @param engine Engine to destroy.
@@ -2858,10 +3126,90 @@ dnnl_status_t DNNL_API dnnl_engine_destroy(dnnl_engine_t engine);
 /// @addtogroup dnnl_api_stream
 /// @{
 
+/// Creates execution stream attributes for a stream that runs on a
+/// specified engine kind.
+///
+/// @param attr Output execution stream attributes.
+/// @param kind Target engine kind.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_attr_create(
+        dnnl_stream_attr_t *attr, dnnl_engine_kind_t kind);
+
+/// Destroys execution stream attributes.
+///
+/// @param attr Execution stream attributes to destroy.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_attr_destroy(dnnl_stream_attr_t attr);
+
+/// Sets a threadpool to be used by the execution stream. The threadpool is
+/// an object implementing the dnnl::threadpool_iface interface (see
+/// dnnl_threadpool_iface.hpp) that must outlive the streams created with
+/// the attributes. Passing NULL resets the threadpool.
+///
+/// @param attr Execution stream attributes.
+/// @param threadpool Pointer to an instance of a C++ class that implements
+///     the dnnl::threadpool_iface interface.
+/// @returns #dnnl_success on success, #dnnl_invalid_arguments for engine
+///     kinds other than CPU and #dnnl_unimplemented if the library was not
+///     built with the THREADPOOL CPU runtime.
+dnnl_status_t DNNL_API dnnl_stream_attr_set_threadpool(
+        dnnl_stream_attr_t attr, void *threadpool);
+
+/// Binds the execution of the primitives on the stream to a NUMA node. The
+/// parallel regions of the primitives run on the CPUs of the node, and the
+/// memory objects marked with dnnl_memory_set_numa_replicated() are replaced
+/// with their copies on the node.
+///
+/// @param attr Execution stream attributes.
+/// @param node NUMA node index between 0 and the value returned by
+///     dnnl_get_numa_node_count() (excluded), or -1 to unbind the stream.
+/// @returns #dnnl_success on success, #dnnl_invalid_arguments for engine
+///     kinds other than CPU or an invalid node index and
+///     #dnnl_unimplemented if the library was built with a CPU runtime
+///     other than OpenMP and sequential, which cannot bind the threads.
+dnnl_status_t DNNL_API dnnl_stream_attr_set_numa_node(
+        dnnl_stream_attr_t attr, int node);
+
+/// Returns the NUMA node set in execution stream attributes.
+///
+/// @param attr Execution stream attributes.
+/// @param node Output NUMA node index, -1 if the stream is not bound to a
+///     NUMA node.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_attr_get_numa_node(
+        const_dnnl_stream_attr_t attr, int *node);
+
+/// Returns the threadpool set in execution stream attributes.
+///
+/// @param attr Execution stream attributes.
+/// @param threadpool Output pointer to an instance of a C++ class that
+///     implements the dnnl::threadpool_iface interface. Set to NULL if the
+///     threadpool was not set.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_attr_get_threadpool(
+        const_dnnl_stream_attr_t attr, void **threadpool);
+
 /// Creates an execution @p stream for @p engine and with @p flags.
 dnnl_status_t DNNL_API dnnl_stream_create(
         dnnl_stream_t *stream, dnnl_engine_t engine, unsigned flags);
 
+/// Creates an execution stream for a given engine with flags and
+/// attributes.
+///
+/// @param stream Output execution stream.
+/// @param engine Engine to create the execution stream on.
+/// @param flags Stream behavior flags (@sa dnnl_stream_flags_t).
+/// @param attr Execution stream attributes. May be NULL, in which case the
+///     call is equivalent to dnnl_stream_create().
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_create_v2(dnnl_stream_t *stream,
+        dnnl_engine_t engine, unsigned flags, const_dnnl_stream_attr_t attr);
+
 #if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
 /// Creates an execution stream for a given engine associated with
 /// an OpenCL command queue.
@@ -2987,6 +3335,67 @@ dnnl_status_t DNNL_API dnnl_set_jit_profiling_flags(unsigned flags);
 /// @returns #dnnl_unimplemented/#dnnl::status::unimplemented on Windows.
 dnnl_status_t DNNL_API dnnl_set_jit_profiling_jitdumpdir(const char *dir);
 
+/// Sets the directory of the persistent JIT kernel cache. The code generated
+/// by the JIT kernels that support the cache is stored in this directory and
+/// reused by later runs instead of being generated again.
+///
+/// @note
+///     This setting overrides the DNNL_JIT_KERNEL_CACHE_DIR environment
+///     variable. The cache is disabled by default.
+///
+/// @warning
+///     The code found in the directory is executed. The directory must be
+///     writable only by trusted users.
+///
+/// @param dir Cache directory. The directory must exist. Passing NULL or an
+///     empty string disables the cache.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_jit_kernel_cache_dir(const char *dir);
+
+/// Returns the total size of the code generated by the JIT kernels created by
+/// the calling thread. The difference of the values returned before and
+/// after a primitive creation is the size of the code generated for the
+/// primitive, which is zero if the primitive is found in the primitive cache.
+///
+/// @param size Output code size in bytes.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p size value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_jit_code_size(size_t *size);
+
+/// Returns the number of NUMA nodes of the system the CPU streams can be
+/// bound to. The topology can be replaced with a fake one for testing by the
+/// `DNNL_NUMA_TOPOLOGY` environment variable: either the number of nodes to
+/// split the CPUs into or the CPU lists of the nodes separated by
+/// semicolons, for example `0-3;4-7`.
+///
+/// @param count Output number of NUMA nodes.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p count value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_numa_node_count(int *count);
+
+/// Enables or disables dynamic scheduling of the parallel loops of the
+/// primitives that support it. With dynamic scheduling the threads take
+/// chunks of the iteration space from a shared counter until it is
+/// exhausted, which balances loops whose iterations have different costs,
+/// for instance at the borders of a pooling. By default the iteration space
+/// is split between the threads statically. Dynamic scheduling is an
+/// experimental feature.
+///
+/// @note
+///     Dynamic scheduling is currently supported by the reference
+///     convolution, the reference, nhwc and JIT pooling forward, and the 2D
+///     forward of the AVX-512 direct convolution.
+///
+/// @note
+///     This setting overrides the DNNL_DYNAMIC_SCHEDULING environment
+///     variable.
+///
+/// @param enable Flag value. Set to 0 to disable and set to 1 to enable.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_dynamic_scheduling(int enable);
+
 /// Sets the maximal ISA DNNL can dispatch to on the CPU. See
 /// #dnnl_cpu_isa_t and #dnnl::cpu_isa for the list of the values accepted by
 /// the C and C++ API functions respectively.
@@ -3017,6 +3426,119 @@ dnnl_status_t DNNL_API dnnl_set_jit_profiling_jitdumpdir(const char *dir);
 ///     details).
 dnnl_status_t DNNL_API dnnl_set_max_cpu_isa(dnnl_cpu_isa_t isa);
 
+/// Sets the number of primitives that can be held in the primitive cache at a
+/// time. The cache is shared by all the engines of the process. If the new
+/// capacity is less than the number of primitives in the cache, the excess
+/// entries are evicted.
+///
+/// This function overrides the DNNL_PRIMITIVE_CACHE_CAPACITY environment
+/// variable and can be called at any time.
+///
+/// @param capacity Primitive cache capacity to set. Passing 0 disables the
+///     primitive cache.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+/// @returns #dnnl_unimplemented/#dnnl::status::unimplemented if the primitive
+///     cache was disabled at build time (see @ref dev_guide_build_options for
+///     more details).
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
+
+/// Returns the number of primitives that can be held in the primitive cache
+/// at a time.
+///
+/// @param capacity Primitive cache capacity to query.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
+
+/// Sets the estimated amount of memory in bytes the primitives held in the
+/// primitive cache can occupy. The memory of a primitive is estimated as the
+/// size of the code generated for it plus the size of the scratchpad it
+/// requires. The least recently used primitives are evicted if the limit is
+/// exceeded.
+///
+/// This function can be called at any time.
+///
+/// @param capacity Memory capacity in bytes. Passing 0 removes the limit.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+/// @returns #dnnl_unimplemented/#dnnl::status::unimplemented if the primitive
+///     cache was disabled at build time.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_memory_capacity(
+        size_t capacity);
+
+/// Returns the statistics of the primitive cache.
+///
+/// @param stats Output primitive cache statistics.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats);
+
+/// Evicts all the primitives from the primitive cache. Primitives that are
+/// being created at the time of the call are not affected.
+///
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_flush_primitive_cache(void);
+
+/// Creates primitives for a list of operation descriptors concurrently to
+/// populate the primitive cache ahead of time. The primitives are created as
+/// if by dnnl_primitive_desc_create() followed by dnnl_primitive_create() and
+/// are destroyed right after that, so only the primitive cache keeps them.
+///
+/// The primitives are created with the number of threads that the calling
+/// thread would use, so they match the primitives created later by the
+/// calling thread.
+///
+/// @param engine Engine to create the primitives for.
+/// @param count Number of operation descriptors.
+/// @param op_descs Array of @p count operation descriptors.
+/// @param attrs Array of @p count primitive attributes. The array as well as
+///     its elements can be NULL, in which case default attributes are used.
+/// @param nthreads Number of threads creating the primitives. Passing 0 uses
+///     the number of hardware threads.
+/// @param statuses Output array of @p count statuses of the primitive
+///     creation. May be NULL.
+/// @param times_ms Output array of @p count primitive creation times in
+///     milliseconds. May be NULL.
+/// @returns #dnnl_success/#dnnl::status::success if the arguments are valid,
+///     even if some of the primitives could not be created.
+dnnl_status_t DNNL_API dnnl_primitive_cache_warm_up(dnnl_engine_t engine,
+        int count, const const_dnnl_op_desc_t *op_descs,
+        const const_dnnl_primitive_attr_t *attrs, int nthreads,
+        dnnl_status_t *statuses, double *times_ms);
+
+/// Sets the size in bytes above which the scratchpad arena of a thread
+/// frees its memory once the primitive executions are complete instead of
+/// keeping it for the next executions.
+///
+/// The arenas are used for the scratchpads of the primitives created with
+/// #dnnl_scratchpad_mode_library for CPU engines when the library is built
+/// with DNNL_ENABLE_CONCURRENT_EXEC=OFF.
+///
+/// @param threshold Trim threshold in bytes. Passing SIZE_MAX (default)
+///     keeps the memory, passing 0 frees it after each execution.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_scratchpad_arena_trim_threshold(
+        size_t threshold);
+
+/// Frees the memory of the scratchpad arena of the calling thread. Does
+/// nothing if a primitive is being executed by the calling thread.
+///
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_trim_scratchpad_arena(void);
+
+/// Returns the statistics of the scratchpad arenas of all the threads.
+///
+/// @param stats Output scratchpad arena statistics.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_scratchpad_arena_stats(
+        dnnl_scratchpad_arena_stats_t *stats);
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_blas
@@ -3201,6 +3723,217 @@ dnnl_status_t DNNL_API dnnl_gemm_s8s8s32(char transa, char transb, char offsetc,
         dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, float alpha, const int8_t *A,
         dnnl_dim_t lda, int8_t ao, const int8_t *B, dnnl_dim_t ldb, int8_t bo,
         float beta, int32_t *C, dnnl_dim_t ldc, const int32_t *co);
+
+/// Packs matrix B of a single-precision matrix-matrix multiply.
+///
+/// The packed matrix is used by dnnl_sgemm_compute() to compute
+///
+/// `C := op( A ) * op( B ) + beta * C`
+///
+/// for any number of rows of matrix A, which makes it possible to pack
+/// weights once and multiply them by batches of any size. The layout of the
+/// packed matrix does not depend on the number of threads the computations
+/// run on.
+///
+/// @param packed_b Output packed matrix handle.
+/// @param transa Transposition flag for matrix A the packed matrix will be
+///     multiplied by: 'N' or 'n' means A is not transposed, and 'T' or 't'
+///     means that A is transposed.
+/// @param transb Transposition flag for matrix B: 'N' or 'n' means B is not
+///     transposed, and 'T' or 't' means that B is transposed.
+/// @param M A hint for the M dimension of the computations, which is used
+///     to choose the packed layout. Computations with a different M still
+///     produce correct results.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param B A pointer to the B matrix data, stored in row-major order.
+/// @param ldb The leading dimension for the matrix B.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_sgemm_pack_b(dnnl_packed_matrix_t *packed_b,
+        char transa, char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        const float *B, dnnl_dim_t ldb);
+
+/// Packs matrix B of a bfloat16 matrix-matrix multiply with single-precision
+/// matrix C. The packed matrix is used by dnnl_gemm_bf16bf16f32_compute().
+///
+/// @note
+///     The function returns #dnnl_unimplemented on systems without Intel
+///     AVX-512 support.
+///
+/// @param packed_b Output packed matrix handle.
+/// @param transa Transposition flag for matrix A.
+/// @param transb Transposition flag for matrix B.
+/// @param M A hint for the M dimension of the computations.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param B A pointer to the B matrix data, stored in row-major order as
+///     raw bfloat16 values.
+/// @param ldb The leading dimension for the matrix B.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32_pack_b(
+        dnnl_packed_matrix_t *packed_b, char transa, char transb, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const uint16_t *B, dnnl_dim_t ldb);
+
+/// Packs 8-bit signed matrix B of an integer matrix-matrix multiply with
+/// 8-bit unsigned matrix A. The packed matrix is used by
+/// dnnl_gemm_u8s8s32_compute().
+///
+/// @param packed_b Output packed matrix handle.
+/// @param transa Transposition flag for matrix A.
+/// @param transb Transposition flag for matrix B.
+/// @param M A hint for the M dimension of the computations.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param B A pointer to the B matrix data, stored in row-major order.
+/// @param ldb The leading dimension for the matrix B.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_u8s8s32_pack_b(dnnl_packed_matrix_t *packed_b,
+        char transa, char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        const int8_t *B, dnnl_dim_t ldb);
+
+/// Packs 8-bit signed matrix B of an integer matrix-matrix multiply with
+/// 8-bit signed matrix A. The packed matrix is used by
+/// dnnl_gemm_s8s8s32_compute().
+///
+/// @param packed_b Output packed matrix handle.
+/// @param transa Transposition flag for matrix A.
+/// @param transb Transposition flag for matrix B.
+/// @param M A hint for the M dimension of the computations.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param B A pointer to the B matrix data, stored in row-major order.
+/// @param ldb The leading dimension for the matrix B.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_s8s8s32_pack_b(dnnl_packed_matrix_t *packed_b,
+        char transa, char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        const int8_t *B, dnnl_dim_t ldb);
+
+/// Returns the size of the memory held by a packed matrix.
+///
+/// @param packed_matrix Packed matrix.
+/// @param size Output size in bytes.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_packed_matrix_get_size(
+        const_dnnl_packed_matrix_t packed_matrix, size_t *size);
+
+/// Destroys a packed matrix.
+///
+/// @param packed_matrix Packed matrix to destroy.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_packed_matrix_destroy(
+        dnnl_packed_matrix_t packed_matrix);
+
+/// Performs single-precision matrix-matrix multiply with packed matrix B.
+///
+/// The operation is defined as:
+///
+/// `C := op( A ) * op( B ) + beta * C`
+///
+/// where `op( B )` is the `KxN` matrix packed by dnnl_sgemm_pack_b(). The
+/// transposition flag for matrix A, N and K must match the ones matrix B was
+/// packed with.
+///
+/// @param transa Transposition flag for matrix A.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param A A pointer to the A matrix data.
+/// @param lda The leading dimension for the matrix A.
+/// @param packed_b Packed matrix B.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_sgemm_compute(char transa, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const float *A, dnnl_dim_t lda,
+        const_dnnl_packed_matrix_t packed_b, float beta, float *C,
+        dnnl_dim_t ldc);
+
+/// Performs bfloat16 matrix-matrix multiply with packed matrix B and
+/// single-precision matrix C.
+///
+/// The operation is defined as for dnnl_sgemm_compute(), with matrix B
+/// packed by dnnl_gemm_bf16bf16f32_pack_b().
+///
+/// @param transa Transposition flag for matrix A.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param A A pointer to the A matrix data as raw bfloat16 values.
+/// @param lda The leading dimension for the matrix A.
+/// @param packed_b Packed matrix B.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32_compute(char transa,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const uint16_t *A,
+        dnnl_dim_t lda, const_dnnl_packed_matrix_t packed_b, float beta,
+        float *C, dnnl_dim_t ldc);
+
+/// Performs integer matrix-matrix multiply on 8-bit unsigned matrix A and
+/// 8-bit signed matrix B packed by dnnl_gemm_u8s8s32_pack_b().
+///
+/// The operation is defined as:
+///
+/// `C := op( A ) * op( B ) + beta * C + C_offset`
+///
+/// where `C_offset` is defined by @p offsetc and @p co as for
+/// dnnl_gemm_u8s8s32().
+///
+/// @param transa Transposition flag for matrix A.
+/// @param offsetc Flag specifying how offsets should be applied to matrix C:
+///     'F', 'C', or 'R'.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param A A pointer to the A matrix data.
+/// @param lda The leading dimension for the matrix A.
+/// @param packed_b Packed matrix B.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @param co An array of offset values for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_u8s8s32_compute(char transa, char offsetc,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const uint8_t *A,
+        dnnl_dim_t lda, const_dnnl_packed_matrix_t packed_b, float beta,
+        int32_t *C, dnnl_dim_t ldc, const int32_t *co);
+
+/// Performs integer matrix-matrix multiply on 8-bit signed matrix A and
+/// 8-bit signed matrix B packed by dnnl_gemm_s8s8s32_pack_b().
+///
+/// The operation is defined as for dnnl_gemm_u8s8s32_compute().
+///
+/// @param transa Transposition flag for matrix A.
+/// @param offsetc Flag specifying how offsets should be applied to matrix C:
+///     'F', 'C', or 'R'.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param A A pointer to the A matrix data.
+/// @param lda The leading dimension for the matrix A.
+/// @param packed_b Packed matrix B.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @param co An array of offset values for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_s8s8s32_compute(char transa, char offsetc,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const int8_t *A,
+        dnnl_dim_t lda, const_dnnl_packed_matrix_t packed_b, float beta,
+        int32_t *C, dnnl_dim_t ldc, const int32_t *co);
+
 /// @} dnnl_api_blas
 
 /// @} dnnl_api
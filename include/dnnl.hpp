@@ -32,6 +32,7 @@
 #include <unordered_map>
 
 #include "dnnl.h"
+#include "dnnl_threadpool_iface.hpp"
 
 #if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
 #include <CL/cl.h>
@@ -298,6 +299,8 @@ public:
         matmul = dnnl_matmul,
         /// A resampling primitive.
         resampling = dnnl_resampling,
+        /// A convolution stack primitive (experimental).
+        conv_stack = dnnl_conv_stack,
     };
 
     using handle::handle;
@@ -388,12 +391,11 @@ enum class scratchpad_mode {
     /// specified by the `DNNL_ENABLE_CONCURRENT_EXEC`
     /// [build option](@ref dev_guide_build_options) (default).
     ///
-    /// When `DNNL_ENABLE_CONCURRENT_EXEC=OFF` (default), the library
-    /// scratchpad is common to all primitives to reduce the memory footprint.
-    /// This configuration comes with limited thread-safety properties, namely
-    /// primitives can be created and executed in parallel but cannot migrate
-    /// between threads (in other words, each primitive should be executed in
-    /// the same thread it was created in).
+    /// When `DNNL_ENABLE_CONCURRENT_EXEC=OFF` (default), the scratchpads of
+    /// the primitives executed by a thread are allocated from a memory arena
+    /// of that thread which is reused across primitives and executions to
+    /// reduce the memory footprint. For CPU engines, primitives can be
+    /// executed in any thread.
     ///
     /// When `DNNL_ENABLE_CONCURRENT_EXEC=ON`, the library scratchpad is
     /// private to each primitive. The memory footprint is larger than when
@@ -600,7 +602,10 @@ inline dnnl_normalization_flags_t convert_to_c(normalization_flags flags) {
 /// RNN cell flags.
 enum class rnn_flags : unsigned {
     /// Undefined RNN flags
-    undef = dnnl_rnn_flags_undef
+    undef = dnnl_rnn_flags_undef,
+    /// The sequences of a mini-batch have different lengths passed as the
+    /// #DNNL_ARG_SRC_SEQ_LENGTHS argument.
+    variable_length = dnnl_rnn_flags_variable_length
 };
 
 /// Converts RNN cell flags enum value from C++ API to C API type.
@@ -873,7 +878,8 @@ struct post_ops : public handle<dnnl_post_ops_t> {
     /// In the simplest case when the elementwise is the only post-op, the
     /// computations would be:
     ///
-    ///     dst[:] <- scale * eltwise_op (op(...)) // instead of dst[:] <- op(...)
+    ///     // instead of dst[:] <- op(...)
+    ///     dst[:] <- scale * eltwise_op (op(...))
     ///
     /// where eltwise_op is configured with the given parameters.
     ///
@@ -903,6 +909,145 @@ struct post_ops : public handle<dnnl_post_ops_t> {
                 "could not get parameters of an elementwise post-op");
         algorithm = static_cast<dnnl::algorithm>(c_alg);
     }
+
+    // The methods below depend on dnnl::memory, which is only declared at
+    // this point. They are templates with the memory type as a defaulted
+    // parameter so that it is looked up once the type is complete.
+
+    /// Appends a binary post-op.
+    ///
+    /// The kind of this post operation is #dnnl::primitive::kind::binary.
+    ///
+    /// In the simplest case when the binary is the only post operation, the
+    /// computations would be:
+    ///
+    ///     dst[:] <- binary_op (op(...), src1[:])
+    ///
+    /// where binary_op is configured with the given parameters. The second
+    /// source tensor is passed at the execution stage in the argument with
+    /// index (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_SRC_1`),
+    /// where index is the position of the post-op.
+    ///
+    /// @param algorithm Binary algorithm for the post-op.
+    /// @param src1_desc Memory descriptor of the second source tensor. Its
+    ///     dimensions must be equal to the destination ones or to 1.
+    template <typename memory_t = memory>
+    void append_binary(
+            algorithm algorithm, const typename memory_t::desc &src1_desc) {
+        error::wrap_c_api(dnnl_post_ops_append_binary(get(),
+                                  convert_to_c(algorithm), &src1_desc.data),
+                "could not append a binary post-op");
+    }
+
+    /// Returns the parameters of a binary post-op.
+    ///
+    /// @param index Index of the binary post-op.
+    /// @param algorithm Output binary algorithm kind.
+    /// @param src1_desc Output memory descriptor of the second source tensor.
+    template <typename memory_t = memory>
+    void get_params_binary(int index, algorithm &algorithm,
+            typename memory_t::desc &src1_desc) const {
+        dnnl_alg_kind_t c_alg;
+        const dnnl_memory_desc_t *data;
+        error::wrap_c_api(
+                dnnl_post_ops_get_params_binary(get(), index, &c_alg, &data),
+                "could not get parameters of a binary post-op");
+        algorithm = static_cast<dnnl::algorithm>(c_alg);
+        src1_desc.data = *data;
+    }
+
+    /// Appends a depthwise post-op convolution with kernel size 3, stride 1
+    /// and padding 1.
+    ///
+    /// The kind of this post operation is
+    /// #dnnl::primitive::kind::convolution.
+    ///
+    /// The weights and the optional bias of the depthwise convolution are
+    /// passed at the execution stage in the arguments with indices
+    /// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_WEIGHTS`) and
+    /// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(index) | DNNL_ARG_BIAS`), where index
+    /// is the position of the post-op. Their memory descriptors should be
+    /// queried from the primitive descriptor.
+    ///
+    /// @param weights_data_type Weights data type.
+    /// @param bias_data_type Bias data type, or
+    ///     #dnnl::memory::data_type::undef if there is no bias.
+    /// @param dst_data_type Destination data type.
+    template <typename memory_t = memory>
+    void append_dw_k3s1p1(typename memory_t::data_type weights_data_type,
+            typename memory_t::data_type bias_data_type,
+            typename memory_t::data_type dst_data_type) {
+        error::wrap_c_api(dnnl_post_ops_append_dw_k3s1p1(get(),
+                                  memory_t::convert_to_c(weights_data_type),
+                                  memory_t::convert_to_c(bias_data_type),
+                                  memory_t::convert_to_c(dst_data_type)),
+                "could not append a depthwise post-op");
+    }
+
+    /// Returns the parameters of a depthwise post-op convolution with
+    /// stride 1.
+    ///
+    /// @param index Index of the depthwise post-op.
+    /// @param weights_data_type Output weights data type.
+    /// @param bias_data_type Output bias data type.
+    /// @param dst_data_type Output destination data type.
+    template <typename memory_t = memory>
+    void get_params_dw_k3s1p1(int index,
+            typename memory_t::data_type &weights_data_type,
+            typename memory_t::data_type &bias_data_type,
+            typename memory_t::data_type &dst_data_type) const {
+        typedef typename memory_t::data_type data_type;
+        dnnl_data_type_t c_wei_dt, c_bias_dt, c_dst_dt;
+        error::wrap_c_api(dnnl_post_ops_get_params_dw_k3s1p1(get(), index,
+                                  &c_wei_dt, &c_bias_dt, &c_dst_dt),
+                "could not get parameters of a depthwise post-op");
+        weights_data_type = static_cast<data_type>(c_wei_dt);
+        bias_data_type = static_cast<data_type>(c_bias_dt);
+        dst_data_type = static_cast<data_type>(c_dst_dt);
+    }
+
+    /// Appends a depthwise post-op convolution with kernel size 3, stride 2
+    /// and padding 1.
+    ///
+    /// The post-op is identical to the one appended by append_dw_k3s1p1()
+    /// except for the stride.
+    ///
+    /// @param weights_data_type Weights data type.
+    /// @param bias_data_type Bias data type, or
+    ///     #dnnl::memory::data_type::undef if there is no bias.
+    /// @param dst_data_type Destination data type.
+    template <typename memory_t = memory>
+    void append_dw_k3s2p1(typename memory_t::data_type weights_data_type,
+            typename memory_t::data_type bias_data_type,
+            typename memory_t::data_type dst_data_type) {
+        error::wrap_c_api(dnnl_post_ops_append_dw_k3s2p1(get(),
+                                  memory_t::convert_to_c(weights_data_type),
+                                  memory_t::convert_to_c(bias_data_type),
+                                  memory_t::convert_to_c(dst_data_type)),
+                "could not append a depthwise post-op");
+    }
+
+    /// Returns the parameters of a depthwise post-op convolution with
+    /// stride 2.
+    ///
+    /// @param index Index of the depthwise post-op.
+    /// @param weights_data_type Output weights data type.
+    /// @param bias_data_type Output bias data type.
+    /// @param dst_data_type Output destination data type.
+    template <typename memory_t = memory>
+    void get_params_dw_k3s2p1(int index,
+            typename memory_t::data_type &weights_data_type,
+            typename memory_t::data_type &bias_data_type,
+            typename memory_t::data_type &dst_data_type) const {
+        typedef typename memory_t::data_type data_type;
+        dnnl_data_type_t c_wei_dt, c_bias_dt, c_dst_dt;
+        error::wrap_c_api(dnnl_post_ops_get_params_dw_k3s2p1(get(), index,
+                                  &c_wei_dt, &c_bias_dt, &c_dst_dt),
+                "could not get parameters of a depthwise post-op");
+        weights_data_type = static_cast<data_type>(c_wei_dt);
+        bias_data_type = static_cast<data_type>(c_bias_dt);
+        dst_data_type = static_cast<data_type>(c_dst_dt);
+    }
 };
 
 /// @cond DO_NOT_DOCUMENT_THIS
@@ -1061,11 +1206,11 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
     ///     zero_points vector. The set i-th bit indicates that a dedicated
     ///     zero point is used for each index along that dimension. Set the
     ///     mask to 0 to use a common zero point for the whole output tensor.
-    /// @param zero_points Constant vector of zero points.
     /// @param zero_points Constant vector of zero points. If the zero points
     ///     are known at the time of this call, the following equality must
     ///     hold:
-    ///     \f[zero_points.size() = \prod\limits_{d \in mask} argument.dims[d].\f]
+    ///     \f[zero_points.size() =
+    ///         \prod\limits_{d \in mask} argument.dims[d].\f]
     ///     If the zero points are not known at the time of the call, this
     ///     vector must contain a single #DNNL_RUNTIME_F32_VAL value and the
     ///     zero points must be passed at execution time as an argument with
@@ -1214,6 +1359,20 @@ struct engine : public handle<dnnl_engine_t> {
         gpu = dnnl_gpu,
     };
 
+    /// Allocator flags.
+    enum class allocator_flags : unsigned {
+        /// No flags
+        none = dnnl_allocator_flags_none,
+        /// Allocations of 2 MB and larger are aligned to 2 MB and are advised
+        /// to be backed by transparent huge pages when the OS supports it
+        huge_pages = dnnl_allocator_huge_pages,
+        /// The pages of the allocated memory are first touched by the
+        /// threads of the library, so on NUMA systems the memory is placed
+        /// close to the threads that process it. The memory is filled with
+        /// zeros.
+        first_touch = dnnl_allocator_first_touch,
+    };
+
     using handle::handle;
 
     /// Constructs an empty engine. An empty engine cannot be used in any
@@ -1279,6 +1438,32 @@ struct engine : public handle<dnnl_engine_t> {
         return static_cast<engine::kind>(kind);
     }
 
+    /// Sets the allocator of the memory of the engine.
+    /// @sa dnnl_engine_set_allocator()
+    ///
+    /// @param allocate Allocation function. Passing nullptr uses the library
+    ///     allocator.
+    /// @param deallocate Deallocation function. Must be nullptr if and only
+    ///     if @p allocate is nullptr.
+    /// @param context The context passed to the allocation and deallocation
+    ///     functions.
+    /// @param flags Allocator flags.
+    void set_allocator(dnnl_allocate_f allocate, dnnl_deallocate_f deallocate,
+            void *context = nullptr,
+            allocator_flags flags = allocator_flags::none) {
+        dnnl_allocator_t allocator = {allocate, deallocate, context,
+                static_cast<unsigned>(flags)};
+        error::wrap_c_api(dnnl_engine_set_allocator(get(), &allocator),
+                "could not set an allocator of an engine");
+    }
+
+    /// Sets the flags of the library allocator of the engine.
+    ///
+    /// @param flags Allocator flags.
+    void set_allocator(allocator_flags flags) {
+        set_allocator(nullptr, nullptr, nullptr, flags);
+    }
+
 #if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
     /// Returns the OpenCL context associated with the engine.
     /// @returns OpenCL context.
@@ -1339,8 +1524,73 @@ template <>
 struct handle_traits<dnnl_stream_t> {
     static constexpr auto destructor = &dnnl_stream_destroy;
 };
+template <>
+struct handle_traits<dnnl_stream_attr_t> {
+    static constexpr auto destructor = &dnnl_stream_attr_destroy;
+};
 /// @endcond
 
+/// Execution stream attributes.
+struct stream_attr : public handle<dnnl_stream_attr_t> {
+    using handle::handle;
+
+    /// Constructs empty stream attributes.
+    stream_attr() = default;
+
+    /// Constructs stream attributes for a stream that runs on an engine of
+    /// a particular kind.
+    ///
+    /// @param kind Target engine kind.
+    stream_attr(engine::kind kind) {
+        dnnl_stream_attr_t attr;
+        error::wrap_c_api(dnnl_stream_attr_create(&attr,
+                                  static_cast<dnnl_engine_kind_t>(kind)),
+                "could not create stream attributes");
+        reset(attr);
+    }
+
+    /// Sets a threadpool to be used by the execution stream. Always throws
+    /// unless the library was built with the THREADPOOL CPU runtime.
+    ///
+    /// @param threadpool An instance of a class that implements the
+    ///     dnnl::threadpool_iface interface. It must outlive the streams
+    ///     created with the attributes.
+    void set_threadpool(threadpool_iface *threadpool) {
+        error::wrap_c_api(dnnl_stream_attr_set_threadpool(get(), threadpool),
+                "could not set stream threadpool attribute");
+    }
+
+    /// Binds the stream to a NUMA node.
+    ///
+    /// @sa dnnl_stream_attr_set_numa_node()
+    ///
+    /// @param node NUMA node index, or -1 to unbind the stream.
+    void set_numa_node(int node) {
+        error::wrap_c_api(dnnl_stream_attr_set_numa_node(get(), node),
+                "could not set stream NUMA node attribute");
+    }
+
+    /// Returns the NUMA node attribute.
+    ///
+    /// @returns The NUMA node index or -1 if the stream is not bound.
+    int get_numa_node() const {
+        int node;
+        error::wrap_c_api(dnnl_stream_attr_get_numa_node(get(), &node),
+                "could not get stream NUMA node attribute");
+        return node;
+    }
+
+    /// Returns the threadpool attribute.
+    ///
+    /// @returns The threadpool or nullptr if it was not set.
+    threadpool_iface *get_threadpool() const {
+        void *tp;
+        error::wrap_c_api(dnnl_stream_attr_get_threadpool(get(), &tp),
+                "could not get stream threadpool attribute");
+        return static_cast<threadpool_iface *>(tp);
+    }
+};
+
 /// An execution stream.
 struct stream : public handle<dnnl_stream_t> {
     using handle::handle;
@@ -1375,6 +1625,21 @@ struct stream : public handle<dnnl_stream_t> {
         reset(stream);
     }
 
+    /// Constructs a stream for the specified engine and with behavior
+    /// controlled by the specified flags and attributes.
+    ///
+    /// @param engine Engine to create the stream on.
+    /// @param flags Flags controlling stream behavior.
+    /// @param attr Stream attributes.
+    stream(const engine &engine, flags flags, const stream_attr &attr) {
+        dnnl_stream_t stream;
+        error::wrap_c_api(dnnl_stream_create_v2(&stream, engine.get(),
+                                  static_cast<dnnl_stream_flags_t>(flags),
+                                  attr.get(true)),
+                "could not create a stream");
+        reset(stream);
+    }
+
 #if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
     /// Constructs a stream for the specified engine and the OpenCL queue.
     ///
@@ -1407,6 +1672,7 @@ struct stream : public handle<dnnl_stream_t> {
 };
 
 DNNL_DEFINE_BITMASK_OPS(stream::flags)
+DNNL_DEFINE_BITMASK_OPS(engine::allocator_flags)
 
 /// @} dnnl_api_stream
 
@@ -1750,6 +2016,9 @@ struct memory : public handle<dnnl_memory_t> {
         ///    and output gate.
         ///  - For GRU cells, the gates order is update, reset and output gate.
         ldgo = abcd,
+        /// 4D LSTM projection weights tensor in the format (num_layers,
+        /// num_directions, input_channels, output_channels).
+        ldio = abcd,
 
         // Opaque blocked formats
 
@@ -2181,6 +2450,17 @@ struct memory : public handle<dnnl_memory_t> {
                 "could not set native handle of a memory object");
     }
 
+    /// Marks the memory as holding constant data to be replicated on the
+    /// NUMA nodes it is used on.
+    ///
+    /// @sa dnnl_memory_set_numa_replicated()
+    ///
+    /// @param replicated Whether the memory is replicated.
+    void set_numa_replicated(bool replicated = true) const {
+        error::wrap_c_api(dnnl_memory_set_numa_replicated(get(), replicated),
+                "could not set NUMA replication of a memory object");
+    }
+
     /// Maps the data of the memory.
     ///
     /// Mapping allows to read/write directly from/to the memory contents for
@@ -3753,6 +4033,120 @@ struct convolution_backward_weights : public primitive {
 };
 
 /// @} dnnl_api_convolution
+
+/// @addtogroup dnnl_api_conv_stack Convolution Stack
+///
+/// An experimental primitive that computes a sequence of forward inference
+/// convolutions in which the destination of each convolution is the source
+/// of the next one.
+///
+/// @sa @ref dev_guide_conv_stack in developer guide
+///
+/// @{
+
+/// Convolution stack primitive.
+struct conv_stack : public primitive {
+    /// Primitive descriptor for a convolution stack primitive.
+    struct primitive_desc : public primitive_desc_base {
+        using primitive_desc_base::primitive_desc_base;
+
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a convolution stack
+        /// primitive.
+        ///
+        /// @note
+        ///     The memory descriptors of the intermediate activations must
+        ///     be initialized with #dnnl::memory::format_tag::any.
+        ///
+        /// Inputs:
+        ///  - src (#dnnl::primitive_desc_base::src_desc (0))
+        ///  - weights\[i\] (#dnnl::conv_stack::primitive_desc::weights_desc
+        ///    (i))
+        ///  - bias\[i\] (#dnnl::conv_stack::primitive_desc::bias_desc (i)),
+        ///    if convolution i is created with bias
+        ///
+        /// Outputs:
+        ///  - dst (#dnnl::primitive_desc_base::dst_desc (0))
+        ///
+        /// @param convs Vector of descriptors of the forward inference
+        ///     convolutions.
+        /// @param conv_attrs Vector of primitive attributes of the
+        ///     convolutions. Can be empty, otherwise must have as many
+        ///     elements as @p convs.
+        /// @param engine Engine to perform the operation on.
+        /// @param attr Primitive attributes to use (optional).
+        primitive_desc(const std::vector<convolution_forward::desc> &convs,
+                const std::vector<primitive_attr> &conv_attrs,
+                const engine &engine,
+                const primitive_attr &attr = primitive_attr()) {
+            error::wrap_c_api(conv_attrs.empty()
+                                    || conv_attrs.size() == convs.size()
+                            ? dnnl_success
+                            : dnnl_invalid_arguments,
+                    "counts of convolutions and attributes are not equal");
+
+            std::vector<dnnl_convolution_desc_t> c_convs;
+            for (const auto &c : convs)
+                c_convs.push_back(c.data);
+            std::vector<const_dnnl_primitive_attr_t> c_attrs;
+            for (const auto &a : conv_attrs)
+                c_attrs.push_back(a.get());
+
+            dnnl_primitive_desc_t result;
+            error::wrap_c_api(
+                    dnnl_conv_stack_primitive_desc_create(&result,
+                            (int)c_convs.size(), c_convs.data(),
+                            c_attrs.empty() ? nullptr : c_attrs.data(),
+                            attr.get(), engine.get()),
+                    "could not create a primitive descriptor for a "
+                    "convolution stack primitive");
+            reset(result);
+        }
+
+        /// Constructs a primitive descriptor for a convolution stack
+        /// primitive from a C API primitive descriptor that must have a
+        /// matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a convolution stack
+        ///     primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : primitive_desc_base(pd, dnnl::primitive::kind::conv_stack) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// Returns the weights memory descriptor of a convolution.
+        /// @param layer Index of the convolution.
+        /// @returns Weights memory descriptor.
+        memory::desc weights_desc(int layer) const {
+            return query_md(
+                    query::exec_arg_md, DNNL_ARG_MULTIPLE_WEIGHTS + layer);
+        }
+
+        /// Returns the bias memory descriptor of a convolution.
+        /// @param layer Index of the convolution.
+        /// @returns Bias memory descriptor.
+        /// @returns A zero memory descriptor if the convolution does not
+        ///     have bias.
+        memory::desc bias_desc(int layer) const {
+            return query_md(query::exec_arg_md, DNNL_ARG_MULTIPLE_BIAS + layer);
+        }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+    };
+
+    /// Default constructor. Produces an empty object.
+    conv_stack() = default;
+
+    /// Constructs a convolution stack primitive.
+    /// @param pd Primitive descriptor for a convolution stack primitive.
+    conv_stack(const primitive_desc &pd) : primitive(pd.get()) {}
+};
+
+/// @} dnnl_api_conv_stack
 //
 /// @addtogroup dnnl_api_deconvolution Deconvolution
 ///
@@ -6863,6 +7257,12 @@ struct rnn_primitive_desc_base : public primitive_desc {
     /// @returns Source recurrent cell state memory descriptor.
     memory::desc src_iter_c_desc() const { return base::src_desc(2); }
 
+    /// Returns sequence lengths memory descriptor.
+    /// @returns Sequence lengths memory descriptor.
+    /// @returns A zero memory descriptor if the primitive was not created
+    ///          with the #dnnl::rnn_flags::variable_length flag.
+    memory::desc src_seq_lengths_desc() const { return base::src_desc(3); }
+
     /// Returns weights layer memory descriptor.
     /// @returns Weights layer memory descriptor.
     memory::desc weights_layer_desc() const { return base::weights_desc(0); }
@@ -6877,6 +7277,22 @@ struct rnn_primitive_desc_base : public primitive_desc {
     ///          bias parameter.
     memory::desc bias_desc() const { return base::weights_desc(2); }
 
+    /// Returns weights peephole memory descriptor.
+    /// @returns Weights peephole memory descriptor.
+    /// @returns A zero memory descriptor if the primitive does not have a
+    ///          peephole parameter.
+    memory::desc weights_peephole_desc() const {
+        return base::weights_desc(3);
+    }
+
+    /// Returns weights projection memory descriptor.
+    /// @returns Weights projection memory descriptor.
+    /// @returns A zero memory descriptor if the primitive does not have a
+    ///          projection parameter.
+    memory::desc weights_projection_desc() const {
+        return base::weights_desc(4);
+    }
+
     /// Returns destination layer memory descriptor.
     /// @returns Destination layer memory descriptor.
     memory::desc dst_layer_desc() const { return base::dst_desc(0); }
@@ -7483,6 +7899,75 @@ struct lstm_forward : public primitive {
                     "could not create a descriptor for an LSTM forward "
                     "propagation primitive");
         }
+
+        /// Constructs a descriptor for an LSTM forward propagation primitive
+        /// with peephole connections and a projection of the hidden state.
+        ///
+        /// The @p weights_peephole_desc and @p weights_projection_desc may
+        /// point to a zero memory descriptor. This would then indicate that
+        /// the LSTM forward propagation primitive should not use peephole
+        /// connections or the projection respectively. The rest of the
+        /// parameters follow the same rules as in the constructor above.
+        ///
+        /// Inputs, in addition to the ones of the constructor above:
+        ///  - weights_peephole (#dnnl::primitive_desc_base::weights_desc
+        ///    (3)), if used
+        ///  - weights_projection (#dnnl::primitive_desc_base::weights_desc
+        ///    (4)), if used
+        ///
+        /// @param prop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param direction RNN direction. See @ref dnnl::rnn_direction for
+        ///     more info.
+        /// @param src_layer_desc Memory descriptor for the input vector.
+        /// @param src_iter_desc Memory descriptor for the input recurrent
+        ///     hidden state vector.
+        /// @param src_iter_c_desc Memory descriptor for the input recurrent
+        ///     cell state vector.
+        /// @param weights_layer_desc Memory descriptor for the weights
+        ///     applied to the layer input.
+        /// @param weights_iter_desc Memory descriptor for the weights applied
+        ///     to the recurrent input.
+        /// @param weights_peephole_desc Memory descriptor for the weights
+        ///     applied to the cell states (according to the Peephole LSTM
+        ///     formula).
+        /// @param weights_projection_desc Memory descriptor for the weights
+        ///     applied to the hidden states to get the recurrent projection
+        ///     (according to the Projection LSTM formula).
+        /// @param bias_desc Bias memory descriptor.
+        /// @param dst_layer_desc Memory descriptor for the output vector.
+        /// @param dst_iter_desc Memory descriptor for the output recurrent
+        ///     hidden state vector.
+        /// @param dst_iter_c_desc Memory descriptor for the output recurrent
+        ///     cell state vector.
+        /// @param flags Unused.
+        desc(prop_kind prop_kind, rnn_direction direction,
+                const memory::desc &src_layer_desc,
+                const memory::desc &src_iter_desc,
+                const memory::desc &src_iter_c_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &weights_peephole_desc,
+                const memory::desc &weights_projection_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc,
+                const memory::desc &dst_iter_desc,
+                const memory::desc &dst_iter_c_desc,
+                rnn_flags flags = rnn_flags::undef) {
+            error::wrap_c_api(
+                    dnnl_lstm_forward_desc_init_v2(&data,
+                            dnnl::convert_to_c(prop_kind),
+                            dnnl::convert_to_c(direction), &src_layer_desc.data,
+                            &src_iter_desc.data, &src_iter_c_desc.data,
+                            &weights_layer_desc.data, &weights_iter_desc.data,
+                            &weights_peephole_desc.data,
+                            &weights_projection_desc.data, &bias_desc.data,
+                            &dst_layer_desc.data, &dst_iter_desc.data,
+                            &dst_iter_c_desc.data, dnnl::convert_to_c(flags)),
+                    "could not create a descriptor for an LSTM forward "
+                    "propagation primitive");
+        }
     };
 
     /// Primitive descriptor for an LSTM forward propagation primitive.
@@ -7553,6 +8038,19 @@ struct lstm_forward : public primitive {
             return rnn_base::weights_iter_desc();
         }
 
+        /// @copydoc dnnl::rnn_primitive_desc_base::weights_peephole_desc()const
+        memory::desc weights_peephole_desc() const {
+            return rnn_base::weights_peephole_desc();
+        }
+
+        /// Returns weights projection memory descriptor.
+        /// @returns Weights projection memory descriptor.
+        /// @returns A zero memory descriptor if the primitive does not have a
+        ///          projection parameter.
+        memory::desc weights_projection_desc() const {
+            return rnn_base::weights_projection_desc();
+        }
+
         /// @copydoc dnnl::rnn_primitive_desc_base::bias_desc()const
         memory::desc bias_desc() const { return rnn_base::bias_desc(); }
 
@@ -9409,6 +9907,38 @@ inline status set_jit_profiling_jitdumpdir(const std::string &dir) {
     return static_cast<status>(dnnl_set_jit_profiling_jitdumpdir(dir.c_str()));
 }
 
+/// @copydoc dnnl_set_jit_kernel_cache_dir()
+inline status set_jit_kernel_cache_dir(const std::string &dir) {
+    return static_cast<status>(dnnl_set_jit_kernel_cache_dir(dir.c_str()));
+}
+
+/// Returns the total size of the code generated by the JIT kernels created by
+/// the calling thread.
+/// @sa dnnl_get_jit_code_size()
+/// @returns Code size in bytes.
+inline size_t get_jit_code_size() {
+    size_t size = 0;
+    error::wrap_c_api(
+            dnnl_get_jit_code_size(&size), "could not get JIT code size");
+    return size;
+}
+
+/// @copydoc dnnl_set_dynamic_scheduling()
+inline status set_dynamic_scheduling(bool enable) {
+    return static_cast<status>(dnnl_set_dynamic_scheduling(enable));
+}
+
+/// Returns the number of NUMA nodes the CPU streams can be bound to.
+///
+/// @sa dnnl_get_numa_node_count()
+/// @returns Number of NUMA nodes.
+inline int get_numa_node_count() {
+    int count = 0;
+    error::wrap_c_api(dnnl_get_numa_node_count(&count),
+            "could not get the number of NUMA nodes");
+    return count;
+}
+
 /// @copydoc dnnl_cpu_isa_t
 enum class cpu_isa {
     /// @copydoc dnnl_cpu_isa_all
@@ -9437,6 +9967,116 @@ inline status set_max_cpu_isa(cpu_isa isa) {
             dnnl_set_max_cpu_isa(static_cast<dnnl_cpu_isa_t>(isa)));
 }
 
+/// @copydoc dnnl_primitive_cache_stats_t
+using primitive_cache_stats_t = dnnl_primitive_cache_stats_t;
+
+/// @copydoc dnnl_set_primitive_cache_capacity()
+inline status set_primitive_cache_capacity(int capacity) {
+    return static_cast<status>(dnnl_set_primitive_cache_capacity(capacity));
+}
+
+/// Returns the number of primitives that can be held in the primitive cache
+/// at a time.
+/// @returns Primitive cache capacity.
+inline int get_primitive_cache_capacity() {
+    int capacity = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_capacity(&capacity),
+            "could not get primitive cache capacity");
+    return capacity;
+}
+
+/// @copydoc dnnl_set_primitive_cache_memory_capacity()
+inline status set_primitive_cache_memory_capacity(size_t capacity) {
+    return static_cast<status>(
+            dnnl_set_primitive_cache_memory_capacity(capacity));
+}
+
+/// Returns the statistics of the primitive cache.
+/// @returns Primitive cache statistics.
+inline primitive_cache_stats_t get_primitive_cache_stats() {
+    primitive_cache_stats_t stats;
+    error::wrap_c_api(dnnl_get_primitive_cache_stats(&stats),
+            "could not get primitive cache statistics");
+    return stats;
+}
+
+/// @copydoc dnnl_flush_primitive_cache()
+inline status flush_primitive_cache() {
+    return static_cast<status>(dnnl_flush_primitive_cache());
+}
+
+/// @copydoc dnnl_scratchpad_arena_stats_t
+using scratchpad_arena_stats_t = dnnl_scratchpad_arena_stats_t;
+
+/// @copydoc dnnl_set_scratchpad_arena_trim_threshold()
+inline status set_scratchpad_arena_trim_threshold(size_t threshold) {
+    return static_cast<status>(
+            dnnl_set_scratchpad_arena_trim_threshold(threshold));
+}
+
+/// @copydoc dnnl_trim_scratchpad_arena()
+inline status trim_scratchpad_arena() {
+    return static_cast<status>(dnnl_trim_scratchpad_arena());
+}
+
+/// Returns the statistics of the scratchpad arenas.
+/// @returns Scratchpad arena statistics.
+inline scratchpad_arena_stats_t get_scratchpad_arena_stats() {
+    scratchpad_arena_stats_t stats;
+    error::wrap_c_api(dnnl_get_scratchpad_arena_stats(&stats),
+            "could not get scratchpad arena statistics");
+    return stats;
+}
+
+/// Result of a primitive creation by warm_up_primitive_cache().
+struct primitive_warm_up_result {
+    /// Status of the primitive creation.
+    status creation_status;
+    /// Primitive creation time in milliseconds.
+    double time_ms;
+};
+
+/// Creates primitives for a list of operation descriptors concurrently to
+/// populate the primitive cache ahead of time.
+/// @sa dnnl_primitive_cache_warm_up()
+///
+/// @param aengine Engine to create the primitives for.
+/// @param op_descs Operation descriptors, for example the addresses of the
+///     `data` members of the C++ API operation descriptors.
+/// @param attrs Primitive attributes. Either empty or of the same size as
+///     @p op_descs.
+/// @param nthreads Number of threads creating the primitives. Passing 0 uses
+///     the number of hardware threads.
+/// @returns Status and creation time of each primitive.
+inline std::vector<primitive_warm_up_result> warm_up_primitive_cache(
+        const engine &aengine,
+        const std::vector<const_dnnl_op_desc_t> &op_descs,
+        const std::vector<primitive_attr> &attrs
+        = std::vector<primitive_attr>(),
+        int nthreads = 0) {
+    if (!attrs.empty() && attrs.size() != op_descs.size())
+        error::wrap_c_api(dnnl_invalid_arguments,
+                "number of attributes does not match number of descriptors");
+
+    const int count = (int)op_descs.size();
+    std::vector<const_dnnl_primitive_attr_t> c_attrs;
+    for (const auto &attr : attrs)
+        c_attrs.push_back(attr.get());
+    std::vector<dnnl_status_t> statuses(count);
+    std::vector<double> times_ms(count);
+
+    error::wrap_c_api(dnnl_primitive_cache_warm_up(aengine.get(), count,
+                              op_descs.data(),
+                              c_attrs.empty() ? nullptr : c_attrs.data(),
+                              nthreads, statuses.data(), times_ms.data()),
+            "could not warm up the primitive cache");
+
+    std::vector<primitive_warm_up_result> results(count);
+    for (int i = 0; i < count; i++)
+        results[i] = {static_cast<status>(statuses[i]), times_ms[i]};
+    return results;
+}
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_blas BLAS functions
@@ -9472,6 +10112,110 @@ inline status gemm_s8s8s32(char transa, char transb, char offsetc, dnnl_dim_t M,
             K, alpha, A, lda, ao, B, ldb, bo, beta, C, ldc, co));
 }
 
+/// @cond DO_NOT_DOCUMENT_THIS
+template <>
+struct handle_traits<dnnl_packed_matrix_t> {
+    static constexpr auto destructor = &dnnl_packed_matrix_destroy;
+};
+/// @endcond
+
+/// A matrix B packed for matrix-matrix multiplies with any number of rows of
+/// matrix A.
+struct packed_matrix : public handle<dnnl_packed_matrix_t> {
+    using handle::handle;
+
+    /// Constructs an empty packed matrix. An empty packed matrix cannot be
+    /// used in any operations.
+    packed_matrix() = default;
+
+    /// Returns the size of the memory held by the packed matrix.
+    /// @returns The size in bytes.
+    size_t get_size() const {
+        size_t size = 0;
+        error::wrap_c_api(dnnl_packed_matrix_get_size(get(), &size),
+                "could not get the size of a packed matrix");
+        return size;
+    }
+};
+
+/// @copydoc dnnl_sgemm_pack_b()
+inline status sgemm_pack_b(packed_matrix &packed_b, char transa, char transb,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const float *B,
+        dnnl_dim_t ldb) {
+    dnnl_packed_matrix_t c_packed_b = nullptr;
+    status st = static_cast<status>(
+            dnnl_sgemm_pack_b(&c_packed_b, transa, transb, M, N, K, B, ldb));
+    if (st == status::success) packed_b.reset(c_packed_b);
+    return st;
+}
+
+/// @copydoc dnnl_gemm_bf16bf16f32_pack_b()
+inline status gemm_bf16bf16f32_pack_b(packed_matrix &packed_b, char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        const uint16_t *B, dnnl_dim_t ldb) {
+    dnnl_packed_matrix_t c_packed_b = nullptr;
+    status st = static_cast<status>(dnnl_gemm_bf16bf16f32_pack_b(
+            &c_packed_b, transa, transb, M, N, K, B, ldb));
+    if (st == status::success) packed_b.reset(c_packed_b);
+    return st;
+}
+
+/// @copydoc dnnl_gemm_u8s8s32_pack_b()
+inline status gemm_u8s8s32_pack_b(packed_matrix &packed_b, char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const int8_t *B,
+        dnnl_dim_t ldb) {
+    dnnl_packed_matrix_t c_packed_b = nullptr;
+    status st = static_cast<status>(dnnl_gemm_u8s8s32_pack_b(
+            &c_packed_b, transa, transb, M, N, K, B, ldb));
+    if (st == status::success) packed_b.reset(c_packed_b);
+    return st;
+}
+
+/// @copydoc dnnl_gemm_s8s8s32_pack_b()
+inline status gemm_s8s8s32_pack_b(packed_matrix &packed_b, char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, const int8_t *B,
+        dnnl_dim_t ldb) {
+    dnnl_packed_matrix_t c_packed_b = nullptr;
+    status st = static_cast<status>(dnnl_gemm_s8s8s32_pack_b(
+            &c_packed_b, transa, transb, M, N, K, B, ldb));
+    if (st == status::success) packed_b.reset(c_packed_b);
+    return st;
+}
+
+/// @copydoc dnnl_sgemm_compute()
+inline status sgemm_compute(char transa, dnnl_dim_t M, dnnl_dim_t N,
+        dnnl_dim_t K, const float *A, dnnl_dim_t lda,
+        const packed_matrix &packed_b, float beta, float *C, dnnl_dim_t ldc) {
+    return static_cast<status>(dnnl_sgemm_compute(
+            transa, M, N, K, A, lda, packed_b.get(), beta, C, ldc));
+}
+
+/// @copydoc dnnl_gemm_bf16bf16f32_compute()
+inline status gemm_bf16bf16f32_compute(char transa, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const uint16_t *A, dnnl_dim_t lda,
+        const packed_matrix &packed_b, float beta, float *C, dnnl_dim_t ldc) {
+    return static_cast<status>(dnnl_gemm_bf16bf16f32_compute(
+            transa, M, N, K, A, lda, packed_b.get(), beta, C, ldc));
+}
+
+/// @copydoc dnnl_gemm_u8s8s32_compute()
+inline status gemm_u8s8s32_compute(char transa, char offsetc, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const uint8_t *A, dnnl_dim_t lda,
+        const packed_matrix &packed_b, float beta, int32_t *C, dnnl_dim_t ldc,
+        const int32_t *co) {
+    return static_cast<status>(dnnl_gemm_u8s8s32_compute(transa, offsetc, M, N,
+            K, A, lda, packed_b.get(), beta, C, ldc, co));
+}
+
+/// @copydoc dnnl_gemm_s8s8s32_compute()
+inline status gemm_s8s8s32_compute(char transa, char offsetc, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const int8_t *A, dnnl_dim_t lda,
+        const packed_matrix &packed_b, float beta, int32_t *C, dnnl_dim_t ldc,
+        const int32_t *co) {
+    return static_cast<status>(dnnl_gemm_s8s8s32_compute(transa, offsetc, M, N,
+            K, A, lda, packed_b.get(), beta, C, ldc, co));
+}
+
 /// @} dnnl_api_blas
 
 // implementation section
@@ -0,0 +1,57 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/// @file
+/// Threadpool interface
+
+#ifndef DNNL_THREADPOOL_IFACE_HPP
+#define DNNL_THREADPOOL_IFACE_HPP
+
+#include <functional>
+
+namespace dnnl {
+
+/// @addtogroup dnnl_api_stream
+/// @{
+
+/// Abstract threadpool interface. A library built with the THREADPOOL CPU
+/// runtime runs the parallel regions of the primitives executed on a stream
+/// through the threadpool set in the stream attributes (see
+/// dnnl::stream_attr::set_threadpool()).
+struct threadpool_iface {
+    /// Returns the number of worker threads.
+    virtual int get_num_threads() const = 0;
+
+    /// Returns true if the calling thread belongs to this threadpool.
+    virtual bool get_in_parallel() const = 0;
+
+    /// Submits n instances of a closure for execution in parallel and
+    /// returns once all of them are completed:
+    ///
+    /// for (int i = 0; i < n; i++) fn(i, n);
+    ///
+    /// The calling thread may execute some of the instances itself.
+    virtual void parallel_for(int n, const std::function<void(int, int)> &fn)
+            = 0;
+
+    virtual ~threadpool_iface() {}
+};
+
+/// @} dnnl_api_stream
+
+} // namespace dnnl
+
+#endif
@@ -438,6 +438,9 @@ typedef enum {
     ///    and output gate.
     ///  - For GRU cells, the gates order is update, reset and output gate.
     dnnl_ldgo = dnnl_abcd,
+    /// 4D LSTM projection weights tensor in the format (num_layers,
+    /// num_directions, input_channels, output_channels).
+    dnnl_ldio = dnnl_abcd,
 
     // Opaque data types, are not to be used explicitly
 
@@ -680,6 +683,8 @@ typedef enum {
     dnnl_matmul,
     /// A resampling primitive.
     dnnl_resampling,
+    /// A convolution stack primitive (experimental).
+    dnnl_conv_stack,
 } dnnl_primitive_kind_t;
 
 /// Kinds of algorithms.
@@ -934,6 +939,18 @@ typedef enum {
     dnnl_memory_extra_flag_compensation_conv_s8s8 = 0x1U,
     dnnl_memory_extra_flag_scale_adjust = 0x2U,
     dnnl_memory_extra_flag_gpu_rnn_u8s8_compensation = 0x4U,
+    /// Indicates the weights have an additional buffer, that depends on the
+    /// @p asymm_compensation_mask and is used to apply the source zero point
+    /// of an int8 convolution.
+    ///
+    /// For instance, in 4D case with the compensation mask equals (1 << 0)
+    /// the additional buffer would consist of OC values:
+    /// O[oc : 0,OC] =
+    ///  -SUM(ic : 0,IC; kh : 0,KH; kw : 0,KW){ weights(oc, ic, kh, kw) }
+    ///
+    /// If the weights also have the s8s8 compensation, this buffer follows
+    /// it.
+    dnnl_memory_extra_flag_compensation_conv_asymmetric_src = 0x8U,
 } dnnl_memory_extra_flags_t;
 
 /// Description of extra information stored in memory
@@ -945,8 +962,10 @@ typedef struct {
     int compensation_mask;
     /// Scale applied to the data
     float scale_adjust;
+    /// Compensation mask for the source zero point
+    int asymm_compensation_mask;
     /// For future backwards compatibility
-    char reserved[64];
+    char reserved[60];
 } dnnl_memory_extra_desc_t;
 
 /// Memory descriptor. The description is based on a number of dimensions,
@@ -1361,7 +1380,11 @@ typedef struct {
 /// Flags for RNN cell.
 typedef enum {
     /// Undefined RNN flags
-    dnnl_rnn_flags_undef = 0x0
+    dnnl_rnn_flags_undef = 0x0,
+    /// The sequences of a mini-batch have different lengths passed as the
+    /// #DNNL_ARG_SRC_SEQ_LENGTHS argument. The iterations past the end of a
+    /// sequence are not computed.
+    dnnl_rnn_flags_variable_length = 0x1U,
 } dnnl_rnn_flags_t;
 
 /// A direction of RNN primitive execution.
@@ -1411,9 +1434,14 @@ typedef struct {
     dnnl_memory_desc_t dst_iter_desc;
     /// Destination iter memory descriptor for cell state.
     dnnl_memory_desc_t dst_iter_c_desc;
-    /// Placeholders
-    dnnl_memory_desc_t placeholder_desc;
-    dnnl_memory_desc_t placeholder2_desc;
+    /// Weights peephole memory descriptor.
+    /// This memory descriptor is equal to zero memory descriptor in case of
+    /// non-peephole LSTMs and other non-LSTM RNNs.
+    dnnl_memory_desc_t weights_peephole_desc;
+    /// Weights projection memory descriptor.
+    /// This memory descriptor is equal to zero memory descriptor in case of
+    /// non-projection LSTMs and other non-LSTM RNNs.
+    dnnl_memory_desc_t weights_projection_desc;
 
     /// Source gradient layer memory descriptor.
     dnnl_memory_desc_t diff_src_layer_desc;
@@ -1433,9 +1461,14 @@ typedef struct {
     dnnl_memory_desc_t diff_dst_iter_desc;
     /// Destination gradient iteration memory descriptor for cell state.
     dnnl_memory_desc_t diff_dst_iter_c_desc;
-    /// Placeholders
-    dnnl_memory_desc_t diff_placeholder_desc;
-    dnnl_memory_desc_t diff_placeholder2_desc;
+    /// Weights gradient peephole memory descriptor.
+    /// This memory descriptor is equal to zero memory descriptor in case of
+    /// non-peephole LSTMs and other non-LSTM RNNs.
+    dnnl_memory_desc_t diff_weights_peephole_desc;
+    /// Weights gradient projection memory descriptor.
+    /// This memory descriptor is equal to zero memory descriptor in case of
+    /// non-projection LSTMs and other non-LSTM RNNs.
+    dnnl_memory_desc_t diff_weights_projection_desc;
 
     /// RNN cell flags
     unsigned int flags;
@@ -1550,6 +1583,59 @@ typedef struct dnnl_engine *dnnl_engine_t;
 typedef const struct dnnl_engine *const_dnnl_engine_t;
 #endif
 
+/// Usage of the memory allocated by an engine, passed to the allocator of
+/// the engine
+typedef enum {
+    /// Memory of memory objects
+    dnnl_memory_usage_user,
+    /// Scratchpad of primitives (see @ref dev_guide_attributes_scratchpad)
+    dnnl_memory_usage_scratchpad,
+} dnnl_memory_usage_t;
+
+/// Allocator memory allocation function.
+///
+/// @param size Size of the memory to allocate in bytes.
+/// @param alignment Alignment of the memory in bytes, a power of two.
+/// @param usage Usage of the memory.
+/// @param context The context of the allocator.
+/// @returns A pointer to the allocated memory or NULL on failure.
+typedef void *(*dnnl_allocate_f)(size_t size, size_t alignment,
+        dnnl_memory_usage_t usage, void *context);
+
+/// Allocator memory deallocation function.
+///
+/// @param ptr Pointer to the memory returned by the allocation function.
+/// @param usage Usage of the memory passed to the allocation function.
+/// @param context The context of the allocator.
+typedef void (*dnnl_deallocate_f)(
+        void *ptr, dnnl_memory_usage_t usage, void *context);
+
+/// Allocator flags
+typedef enum {
+    /// No flags
+    dnnl_allocator_flags_none = 0x0U,
+    /// Allocations of 2 MB and larger are aligned to 2 MB and are advised to
+    /// be backed by transparent huge pages when the OS supports it
+    dnnl_allocator_huge_pages = 0x1U,
+    /// The pages of the allocated memory are first touched by the threads
+    /// of the library, so on NUMA systems the memory is placed close to the
+    /// threads that process it. The memory is filled with zeros.
+    dnnl_allocator_first_touch = 0x2U,
+} dnnl_allocator_flags_t;
+
+/// Allocator of the memory of an engine
+typedef struct {
+    /// Allocation function. NULL uses the library allocator.
+    dnnl_allocate_f allocate;
+    /// Deallocation function. Must be NULL if and only if the allocation
+    /// function is NULL.
+    dnnl_deallocate_f deallocate;
+    /// The context passed to the allocation and deallocation functions.
+    void *context;
+    /// Allocator flags, a combination of #dnnl_allocator_flags_t values.
+    unsigned flags;
+} dnnl_allocator_t;
+
 /// @} dnnl_api_engine
 
 /// @addtogroup dnnl_api_primitives
@@ -1589,13 +1675,11 @@ typedef enum {
     /// The allocation policy is controlled by the DNNL_ENABLE_CONCURRENT_EXEC
     /// build option (@ref dev_guide_build_options).
     ///
-    /// When DNNL_ENABLE_CONCURRENT_EXEC=OFF (default), the library
-    /// scratchpad is common to all primitives to reduce the memory
-    /// footprint.  This configuration comes with limited
-    /// thread-safety properties, namely different primitives can be
-    /// created and executed in parallel but cannot migrate between
-    /// threads (in other words, each primitive should be executed in
-    /// the same thread it was created in).
+    /// When DNNL_ENABLE_CONCURRENT_EXEC=OFF (default), the scratchpads of
+    /// the primitives executed by a thread are allocated from a memory arena
+    /// of that thread which is reused across primitives and executions to
+    /// reduce the memory footprint. For CPU engines, primitives can be
+    /// executed in any thread.
     ///
     /// When DNNL_ENABLE_CONCURRENT_EXEC=ON, the library scratchpad is private
     /// to each primitive. The memory footprint is larger than when using
@@ -1686,6 +1770,12 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// #DNNL_ARG_SRC_2.
 #define DNNL_ARG_SRC_ITER_C DNNL_ARG_SRC_2
 
+/// Source argument #3.
+#define DNNL_ARG_SRC_3 4
+/// A special mnemonic for RNN sequence lengths of a mini-batch with
+/// variable length sequences. An alias for #DNNL_ARG_SRC_3.
+#define DNNL_ARG_SRC_SEQ_LENGTHS DNNL_ARG_SRC_3
+
 /// Destination argument #0.
 #define DNNL_ARG_DST_0 17
 /// A special mnemonic for destination argument for primitives that have a
@@ -1727,6 +1817,18 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// An alias for #DNNL_ARG_WEIGHTS_1.
 #define DNNL_ARG_WEIGHTS_ITER DNNL_ARG_WEIGHTS_1
 
+/// Weights argument #2.
+#define DNNL_ARG_WEIGHTS_2 35
+/// A special mnemonic for RNN weights applied to the cell states of a
+/// peephole LSTM. An alias for #DNNL_ARG_WEIGHTS_2.
+#define DNNL_ARG_WEIGHTS_PEEPHOLE DNNL_ARG_WEIGHTS_2
+
+/// Weights argument #3.
+#define DNNL_ARG_WEIGHTS_3 36
+/// A special mnemonic for RNN weights applied to the hidden states of an
+/// LSTM with projection. An alias for #DNNL_ARG_WEIGHTS_3.
+#define DNNL_ARG_WEIGHTS_PROJECTION DNNL_ARG_WEIGHTS_3
+
 /// Bias tensor argument.
 #define DNNL_ARG_BIAS 41
 
@@ -1817,6 +1919,22 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// Zero points provided at execution time.
 #define DNNL_ARG_ATTR_ZERO_POINTS 4096
 
+/// Starting index for weights arguments of primitives that consist of a
+/// sequence of layers, e.g. the convolution stack.
+#define DNNL_ARG_MULTIPLE_WEIGHTS 8192
+/// Starting index for bias arguments of primitives that consist of a
+/// sequence of layers, e.g. the convolution stack.
+#define DNNL_ARG_MULTIPLE_BIAS 10240
+
+/// Starting index for arguments of post-ops that take additional inputs.
+#define DNNL_ARG_ATTR_MULTIPLE_POST_OP_BASE 16384
+
+/// Arguments of the post-op with index @p idx, e.g.
+/// (`DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1`) for the second
+/// source of the first binary post-op.
+#define DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx) \
+    (DNNL_ARG_ATTR_MULTIPLE_POST_OP_BASE * ((idx) + 1))
+
 /// A structure that contains an index and a memory object, and is used to pass
 /// arguments to dnnl_primitive_execute().
 typedef struct {
@@ -1944,6 +2062,14 @@ typedef struct dnnl_stream *dnnl_stream_t;
 /// A constant execution stream handle.
 typedef const struct dnnl_stream *const_dnnl_stream_t;
 
+/// @struct dnnl_stream_attr
+/// An opaque structure to describe the attributes of an execution stream.
+struct dnnl_stream_attr;
+/// An execution stream attributes handle.
+typedef struct dnnl_stream_attr *dnnl_stream_attr_t;
+/// A constant execution stream attributes handle.
+typedef const struct dnnl_stream_attr *const_dnnl_stream_attr_t;
+
 /// @} dnnl_api_stream
 
 /// @addtogroup dnnl_api_service
@@ -1958,6 +2084,34 @@ typedef struct {
     const char *hash; ///< Git hash of the sources (may be absent)
 } dnnl_version_t;
 
+/// Structure containing primitive cache statistics
+typedef struct {
+    /// Number of primitive creations served from the cache
+    size_t hits;
+    /// Number of primitive creations that missed the cache
+    size_t misses;
+    /// Number of primitives evicted from the cache to satisfy its capacity
+    size_t evictions;
+    /// Number of primitives currently held in the cache
+    size_t size;
+    /// Estimated memory held by the cached primitives in bytes (size of
+    /// generated code and of the scratchpad they require)
+    size_t memory_size;
+} dnnl_primitive_cache_stats_t;
+
+/// Structure containing scratchpad arena statistics summed over all the
+/// threads
+typedef struct {
+    /// Memory currently reserved by the arenas in bytes
+    size_t reserved_bytes;
+    /// Maximum memory reserved by the arenas at a time in bytes
+    size_t peak_reserved_bytes;
+    /// Number of scratchpads served by the arenas
+    size_t requests;
+    /// Number of memory allocations made by the arenas
+    size_t allocations;
+} dnnl_scratchpad_arena_stats_t;
+
 /// Disable profiling completely
 #define DNNL_JIT_PROFILE_NONE 0u
 
@@ -2017,6 +2171,22 @@ typedef enum {
 
 /// @} dnnl_api_service
 
+/// @addtogroup dnnl_api_blas
+/// @{
+
+/// @struct dnnl_packed_matrix
+/// An opaque structure to describe a matrix packed for a matrix-matrix
+/// multiply.
+struct dnnl_packed_matrix;
+
+/// A packed matrix handle.
+typedef struct dnnl_packed_matrix *dnnl_packed_matrix_t;
+
+/// A constant packed matrix handle.
+typedef const struct dnnl_packed_matrix *const_dnnl_packed_matrix_t;
+
+/// @} dnnl_api_blas
+
 /// @} dnnl_api
 
 #ifdef __cplusplus
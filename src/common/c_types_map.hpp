@@ -311,6 +311,7 @@ const format_tag_t ldnc = dnnl_ldnc;
 const format_tag_t ldigo = dnnl_ldigo;
 const format_tag_t ldgoi = dnnl_ldgoi;
 const format_tag_t ldgo = dnnl_ldgo;
+const format_tag_t ldio = dnnl_ldio;
 const format_tag_t nCdhw16c = dnnl_nCdhw16c;
 const format_tag_t nCdhw4c = dnnl_nCdhw4c;
 const format_tag_t nCdhw8c = dnnl_nCdhw8c;
@@ -449,6 +450,8 @@ const memory_extra_flags_t compensation_conv_s8s8
 const memory_extra_flags_t scale_adjust = dnnl_memory_extra_flag_scale_adjust;
 const memory_extra_flags_t gpu_rnn_u8s8_compensation
         = dnnl_memory_extra_flag_gpu_rnn_u8s8_compensation;
+const memory_extra_flags_t compensation_conv_asymmetric_src
+        = dnnl_memory_extra_flag_compensation_conv_asymmetric_src;
 } // namespace memory_extra_flags
 
 using engine_kind_t = dnnl_engine_kind_t;
@@ -458,11 +461,25 @@ const engine_kind_t cpu = dnnl_cpu;
 const engine_kind_t gpu = dnnl_gpu;
 } // namespace engine_kind
 
+using memory_usage_t = dnnl_memory_usage_t;
+namespace memory_usage {
+const memory_usage_t user = dnnl_memory_usage_user;
+const memory_usage_t scratchpad = dnnl_memory_usage_scratchpad;
+} // namespace memory_usage
+
+using allocator_t = dnnl_allocator_t;
+namespace allocator_flags {
+const unsigned none = dnnl_allocator_flags_none;
+const unsigned huge_pages = dnnl_allocator_huge_pages;
+const unsigned first_touch = dnnl_allocator_first_touch;
+} // namespace allocator_flags
+
 enum runtime_kind_t {
     dnnl_runtime_none,
     dnnl_runtime_seq,
     dnnl_runtime_omp,
     dnnl_runtime_tbb,
+    dnnl_runtime_threadpool,
     dnnl_runtime_ocl,
 };
 
@@ -471,6 +488,7 @@ const runtime_kind_t none = dnnl_runtime_none;
 const runtime_kind_t seq = dnnl_runtime_seq;
 const runtime_kind_t omp = dnnl_runtime_omp;
 const runtime_kind_t tbb = dnnl_runtime_tbb;
+const runtime_kind_t threadpool = dnnl_runtime_threadpool;
 const runtime_kind_t ocl = dnnl_runtime_ocl;
 } // namespace runtime_kind
 
@@ -496,6 +514,7 @@ const primitive_kind_t binary = dnnl_binary;
 const primitive_kind_t logsoftmax = dnnl_logsoftmax;
 const primitive_kind_t matmul = dnnl_matmul;
 const primitive_kind_t resampling = dnnl_resampling;
+const primitive_kind_t conv_stack = dnnl_conv_stack;
 } // namespace primitive_kind
 
 using query_t = dnnl_query_t;
@@ -582,6 +601,8 @@ using gemm_desc_t = dnnl_gemm_desc_t;
 using concat_desc_t = dnnl_concat_desc_t;
 using reorder_desc_t = dnnl_reorder_desc_t;
 using sum_desc_t = dnnl_sum_desc_t;
+using conv_stack_layer_desc_t = dnnl_conv_stack_layer_desc_t;
+using conv_stack_desc_t = dnnl_conv_stack_desc_t;
 
 /* C op_desc_t, which eventually are just (void*) */
 using c_op_desc_t = dnnl_op_desc_t;
@@ -608,6 +629,7 @@ struct op_desc_t {
         binary_desc_t binary;
         matmul_desc_t matmul;
         resampling_desc_t resampling;
+        conv_stack_desc_t conv_stack;
     };
 
 #define DECL_CTOR_AND_CONVERTERS(c_type) \
@@ -636,11 +658,12 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(binary_desc_t);
     DECL_CTOR_AND_CONVERTERS(matmul_desc_t);
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
+    DECL_CTOR_AND_CONVERTERS(conv_stack_desc_t);
 
-    // concat_desc_t and sum_desc_t have data members which have non-trivial
-    // special member functions hence the default destructor is implicitly
-    // deleted by the compiler which causes a warning on Windows so we should
-    // delete the destructor explicitly.
+    // concat_desc_t, sum_desc_t and conv_stack_desc_t have data members which
+    // have non-trivial special member functions hence the default destructor
+    // is implicitly deleted by the compiler which causes a warning on Windows
+    // so we should delete the destructor explicitly.
     ~op_desc_t() = delete;
 
 #undef DECL_CTOR_AND_CONVERTERS
@@ -662,6 +685,10 @@ const stream_flags_t out_of_order = dnnl_stream_out_of_order;
 const stream_flags_t default_flags = dnnl_stream_default_flags;
 } // namespace stream_flags
 using stream_t = dnnl_stream;
+using stream_attr_t = dnnl_stream_attr;
+
+using primitive_cache_stats_t = dnnl_primitive_cache_stats_t;
+using scratchpad_arena_stats_t = dnnl_scratchpad_arena_stats_t;
 
 /* forward declaration of the internal primitive_desc types */
 struct batch_normalization_bwd_pd_t;
@@ -669,6 +696,7 @@ struct batch_normalization_fwd_pd_t;
 struct batch_normalization_pd_t;
 struct binary_pd_t;
 struct concat_pd_t;
+struct conv_stack_pd_t;
 struct convolution_bwd_data_pd_t;
 struct convolution_bwd_weights_pd_t;
 struct convolution_fwd_pd_t;
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "dnnl.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "conv_stack_pd.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::status;
+
+namespace {
+bool has_runtime_dims_or_strides(const convolution_desc_t &cd) {
+    return memory_desc_wrapper(cd.src_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(cd.weights_desc)
+                       .has_runtime_dims_or_strides()
+            || memory_desc_wrapper(cd.bias_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(cd.dst_desc).has_runtime_dims_or_strides();
+}
+
+// The destination of the layer must be the source of the next one. The
+// intermediate activations are internal to the primitive hence their format
+// is always chosen by the implementation.
+bool are_chained(const memory_desc_t &dst_md, const memory_desc_t &src_md) {
+    if (dst_md.ndims != src_md.ndims) return false;
+    for (int d = 0; d < dst_md.ndims; ++d)
+        if (dst_md.dims[d] != src_md.dims[d]) return false;
+    return dst_md.data_type == src_md.data_type
+            && dst_md.format_kind == format_kind::any
+            && src_md.format_kind == format_kind::any;
+}
+} // namespace
+
+status_t dnnl_conv_stack_primitive_desc_create(
+        primitive_desc_t **conv_stack_pd, int n,
+        const convolution_desc_t *conv_descs,
+        const primitive_attr_t *const *conv_attrs,
+        const primitive_attr_t *attr, engine_t *engine) {
+    bool args_ok = !any_null(conv_stack_pd, conv_descs, engine) && n > 0
+            && n <= DNNL_ARG_MULTIPLE_BIAS - DNNL_ARG_MULTIPLE_WEIGHTS;
+    if (!args_ok) return invalid_arguments;
+
+    const primitive_attr_t dummy_attr;
+    if (attr == NULL) attr = &dummy_attr;
+
+    conv_stack_desc_t csd = conv_stack_desc_t();
+    csd.primitive_kind = primitive_kind::conv_stack;
+    csd.n = n;
+    csd.layers.reserve(n);
+
+    const int ndims = conv_descs[0].src_desc.ndims;
+    for (int l = 0; l < n; ++l) {
+        const convolution_desc_t &cd = conv_descs[l];
+        bool ok = cd.primitive_kind == primitive_kind::convolution
+                && cd.prop_kind == prop_kind::forward_inference
+                && cd.src_desc.ndims == ndims
+                && IMPLICATION(
+                        l > 0, are_chained(conv_descs[l - 1].dst_desc,
+                                       cd.src_desc));
+        if (!ok) return invalid_arguments;
+        if (has_runtime_dims_or_strides(cd)) return unimplemented;
+
+        conv_stack_layer_desc_t ld = conv_stack_layer_desc_t();
+        ld.conv_desc = cd;
+        ld.eltwise_alg = alg_kind::undef;
+
+        // A layer may only have an eltwise post-op
+        const primitive_attr_t *l_attr
+                = conv_attrs && conv_attrs[l] ? conv_attrs[l] : &dummy_attr;
+        using smask_t = primitive_attr_t::skip_mask_t;
+        const auto &po = l_attr->post_ops_;
+        ok = l_attr->has_default_values(smask_t::post_ops) && po.len_ <= 1
+                && IMPLICATION(po.len_ == 1, po.entry_[0].is_eltwise());
+        if (!ok) return unimplemented;
+        if (po.len_ == 1) {
+            const auto &e = po.entry_[0].eltwise;
+            ld.eltwise_alg = e.alg;
+            ld.eltwise_scale = e.scale;
+            ld.eltwise_alpha = e.alpha;
+            ld.eltwise_beta = e.beta;
+        }
+        csd.layers.push_back(ld);
+    }
+
+    auto cs_pd = reinterpret_cast<conv_stack_pd_t **>(conv_stack_pd);
+    for (auto c = engine->get_conv_stack_implementation_list(); *c; ++c) {
+        if ((*c)(cs_pd, engine, attr, &csd) == success) return success;
+    }
+    return unimplemented;
+}
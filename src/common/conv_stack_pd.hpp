@@ -0,0 +1,163 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CONV_STACK_PD_HPP
+#define CONV_STACK_PD_HPP
+
+#include <assert.h>
+#include "dnnl.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "type_helpers.hpp"
+
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+struct conv_stack_pd_t : public primitive_desc_t {
+    conv_stack_pd_t(engine_t *engine, const primitive_attr_t *attr,
+            const conv_stack_desc_t *adesc)
+        : primitive_desc_t(engine, attr, primitive_kind::conv_stack)
+        , desc_(*adesc) {
+        const int n = n_layers();
+        src_md_ = layer_desc(0)->src_desc;
+        dst_md_ = layer_desc(n - 1)->dst_desc;
+        weights_mds_.reserve(n);
+        bias_mds_.reserve(n);
+        layer_attrs_.resize(n);
+        for (int l = 0; l < n; ++l) {
+            const auto &ld = desc_.layers[l];
+            weights_mds_.push_back(ld.conv_desc.weights_desc);
+            bias_mds_.push_back(ld.conv_desc.bias_desc);
+            if (ld.eltwise_alg != alg_kind::undef)
+                layer_attrs_[l].post_ops_.append_eltwise(ld.eltwise_scale,
+                        ld.eltwise_alg, ld.eltwise_alpha, ld.eltwise_beta);
+        }
+    }
+
+    const conv_stack_desc_t *desc() const { return &desc_; }
+    virtual const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    virtual void init_info() override { impl::init_info(this, this->info_); }
+
+    virtual arg_usage_t arg_usage(int arg) const override {
+        if (arg == DNNL_ARG_SRC) return arg_usage_t::input;
+
+        const int wei_index = arg - DNNL_ARG_MULTIPLE_WEIGHTS;
+        if (wei_index >= 0 && wei_index < n_layers())
+            return arg_usage_t::input;
+
+        const int bia_index = arg - DNNL_ARG_MULTIPLE_BIAS;
+        if (bia_index >= 0 && bia_index < n_layers() && with_bias(bia_index))
+            return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_DST) return arg_usage_t::output;
+
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    virtual const memory_desc_t *arg_md(int arg) const override {
+        if (arg == DNNL_ARG_SRC) return src_md(0);
+        if (arg == DNNL_ARG_DST) return dst_md(0);
+
+        const int wei_index = arg - DNNL_ARG_MULTIPLE_WEIGHTS;
+        if (wei_index >= 0 && wei_index < n_layers())
+            return weights_md(wei_index);
+
+        const int bia_index = arg - DNNL_ARG_MULTIPLE_BIAS;
+        if (bia_index >= 0 && bia_index < n_layers()) return bias_md(bia_index);
+
+        return primitive_desc_t::arg_md(arg);
+    }
+
+    virtual const memory_desc_t *src_md(int index = 0) const override {
+        return index == 0 ? &src_md_ : &glob_zero_md;
+    }
+    virtual const memory_desc_t *dst_md(int index = 0) const override {
+        return index == 0 ? &dst_md_ : &glob_zero_md;
+    }
+    /** returns the weights of the layer @p index */
+    virtual const memory_desc_t *weights_md(int index = 0) const override {
+        return index < n_layers() ? &weights_mds_[index] : &glob_zero_md;
+    }
+    const memory_desc_t *bias_md(int index) const {
+        return index < n_layers() ? &bias_mds_[index] : &glob_zero_md;
+    }
+
+    virtual int n_inputs() const override {
+        int n_bias = 0;
+        for (int l = 0; l < n_layers(); ++l)
+            n_bias += with_bias(l);
+        return 1 + n_layers() + n_bias;
+    }
+    virtual int n_outputs() const override { return 1; }
+
+    int n_layers() const { return (int)desc_.n; }
+    const convolution_desc_t *layer_desc(int l) const {
+        return &desc_.layers[l].conv_desc;
+    }
+    /** returns the attributes of the layer @p l, i.e. its post-ops */
+    const primitive_attr_t *layer_attr(int l) const {
+        return &layer_attrs_[l];
+    }
+    bool with_bias(int l) const {
+        return !memory_desc_wrapper(bias_mds_[l]).is_zero();
+    }
+
+protected:
+    conv_stack_desc_t desc_;
+    memory_desc_t src_md_, dst_md_;
+    std::vector<memory_desc_t> weights_mds_, bias_mds_;
+    std::vector<primitive_attr_t> layer_attrs_;
+};
+
+#define DECLARE_CONV_STACK_PD_t(impl_name, ...) \
+    static status_t create(conv_stack_pd_t **conv_stack_pd, engine_t *engine, \
+            const primitive_attr_t *attr, const conv_stack_desc_t *adesc) { \
+        using namespace status; \
+        auto _pd = new pd_t(engine, attr, adesc); \
+        if (_pd == nullptr) return out_of_memory; \
+        if (_pd->init() != success) { \
+            delete _pd; \
+            return unimplemented; \
+        } \
+        _pd->init_info(); \
+        _pd->init_scratchpad_md(); \
+        return safe_ptr_assign<conv_stack_pd_t>(*conv_stack_pd, _pd); \
+    } \
+    virtual status_t create_primitive(primitive_t **p) const override { \
+        auto status = this->engine()->get_primitive( \
+                p, this, [=] { return std::make_shared<__VA_ARGS__>(this); }, \
+                false); \
+        return status; \
+    } \
+    virtual pd_t *clone() const override { return new pd_t(*this); } \
+    virtual const char *name() const override { return impl_name; } \
+    virtual std::type_index impl_id() const override { return typeid(pd_t); }
+
+#define DECLARE_CONV_STACK_PD_T(impl_name, ...) \
+    DECLARE_CONV_STACK_PD_t(impl_name, __VA_ARGS__)
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
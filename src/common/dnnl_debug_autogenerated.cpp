@@ -408,6 +408,7 @@ const char *dnnl_prim_kind2str(dnnl_primitive_kind_t v) {
     if (v == dnnl_logsoftmax) return "logsoftmax";
     if (v == dnnl_matmul) return "matmul";
     if (v == dnnl_resampling) return "resampling";
+    if (v == dnnl_conv_stack) return "conv_stack";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
 }
@@ -454,6 +455,7 @@ const char *dnnl_alg_kind2str(dnnl_alg_kind_t v) {
 
 const char *dnnl_rnn_flags2str(dnnl_rnn_flags_t v) {
     if (v == dnnl_rnn_flags_undef) return "undef";
+    if (v == dnnl_rnn_flags_variable_length) return "variable_length";
     assert(!"unknown rnn_flags");
     return "unknown rnn_flags";
 }
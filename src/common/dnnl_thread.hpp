@@ -17,6 +17,10 @@
 #ifndef DNNL_THREAD_HPP
 #define DNNL_THREAD_HPP
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "utils.hpp"
 #include "z_magic.hpp"
 
@@ -86,6 +90,80 @@ inline tbb::static_partitioner dnnl_tbb_partitioner() {
 
 #define PRAGMA_OMP(...)
 
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include <thread>
+#include "dnnl_threadpool_iface.hpp"
+#define DNNL_THR_SYNC 0
+
+namespace dnnl {
+namespace impl {
+namespace threadpool_utils {
+
+// The threadpool the parallel regions of the calling thread run through. It
+// is set by a stream for the duration of a primitive execution.
+inline threadpool_iface *&active_threadpool() {
+    static thread_local threadpool_iface *threadpool = nullptr;
+    return threadpool;
+}
+
+inline void activate_threadpool(threadpool_iface *threadpool) {
+    active_threadpool() = threadpool;
+}
+
+inline void deactivate_threadpool() {
+    active_threadpool() = nullptr;
+}
+
+// The parallel region the calling thread runs in
+struct thread_info_t {
+    int ithr = 0;
+    int nthr = 1;
+    bool in_parallel = false;
+};
+
+inline thread_info_t &thread_info() {
+    static thread_local thread_info_t info;
+    return info;
+}
+
+// Primitives are created outside of the streams, so they are created for
+// this number of threads and may not be executed with more threads
+inline int get_max_concurrency() {
+    static const int max_concurrency
+            = nstl::max(1, (int)std::thread::hardware_concurrency());
+    return max_concurrency;
+}
+
+} // namespace threadpool_utils
+} // namespace impl
+} // namespace dnnl
+
+inline int dnnl_get_max_threads() {
+    using namespace dnnl::impl;
+    dnnl::threadpool_iface *threadpool
+            = threadpool_utils::active_threadpool();
+    const int max_concurrency = threadpool_utils::get_max_concurrency();
+    if (threadpool == nullptr) return max_concurrency;
+    return nstl::max(
+            1, nstl::min(threadpool->get_num_threads(), max_concurrency));
+}
+inline int dnnl_get_num_threads() {
+    using namespace dnnl::impl::threadpool_utils;
+    return thread_info().in_parallel ? thread_info().nthr : 1;
+}
+inline int dnnl_get_thread_num() {
+    using namespace dnnl::impl::threadpool_utils;
+    return thread_info().in_parallel ? thread_info().ithr : 0;
+}
+inline int dnnl_in_parallel() {
+    return dnnl::impl::threadpool_utils::thread_info().in_parallel;
+}
+inline void dnnl_thr_barrier() {
+    assert(!"no barrier in THREADPOOL");
+}
+
+#define PRAGMA_OMP(...)
+
 #endif
 
 // MSVC still supports omp 2.0 only
@@ -115,6 +193,45 @@ inline bool dnnl_thr_syncable() {
     return DNNL_THR_SYNC == 1;
 }
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+namespace numa_utils {
+
+// The NUMA node the parallel regions of the calling thread run on, -1 for the
+// CPUs of the process, and the CPUs to bind the threads to (cpu_set_t on
+// Linux), or nullptr to leave the threads as they are. It is set by a stream
+// for the duration of a primitive execution.
+struct binding_t {
+    int node;
+    const void *cpus;
+};
+
+inline binding_t &active_binding() {
+    static thread_local binding_t binding {-1, nullptr};
+    return binding;
+}
+
+// The NUMA node the calling thread is bound to, -1 for the CPUs of the
+// process, or -2 if the thread has never been bound
+inline int &bound_node() {
+    static thread_local int node = -2;
+    return node;
+}
+
+// Binds the calling thread unless it is already bound to the node, so a
+// thread is only bound again when it runs for another node. The binding is a
+// hint, so failures are ignored.
+inline void maybe_bind_thread(const binding_t &binding) {
+    if (binding.cpus == nullptr || bound_node() == binding.node) return;
+#ifdef __linux__
+    sched_setaffinity(0, sizeof(cpu_set_t), (const cpu_set_t *)binding.cpus);
+#endif
+    bound_node() = binding.node;
+}
+
+} // namespace numa_utils
+#endif
+
 template <typename T, typename U>
 inline void balance211(T n, U team, U tid, T &n_start, T &n_end) {
     T n_min = 1;
@@ -30,8 +30,16 @@
  *                                     calls for_nd
  *  - parallel_nd_in_omp(dims..., f) - queries current nthr and ithr and then
  *                                     calls for_nd (mostly for convenience)
+ *  - parallel_nd_chunked(dims..., f) - same as parallel_nd, but the threads
+ *                                     take chunks of the iteration space one
+ *                                     by one instead of a static range each
+ *  - parallel_nd_dynamic(dims..., f) - calls parallel_nd_chunked if dynamic
+ *                                     scheduling is enabled and parallel_nd
+ *                                     otherwise
  */
 
+#include <atomic>
+
 namespace dnnl {
 namespace impl {
 
@@ -47,8 +55,14 @@ void parallel(int nthr, F f) {
         f(0, 1);
         return;
     }
+    // the team may have more threads than the node the calling thread is
+    // bound to has CPUs, so each thread binds itself
+    const numa_utils::binding_t numa_binding = numa_utils::active_binding();
 #pragma omp parallel num_threads(nthr)
-    f(dnnl_get_thread_num(), dnnl_get_num_threads());
+    {
+        numa_utils::maybe_bind_thread(numa_binding);
+        f(dnnl_get_thread_num(), dnnl_get_num_threads());
+    }
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
     if (nthr == 1) {
         f(0, 1);
@@ -56,6 +70,32 @@ void parallel(int nthr, F f) {
     }
     tbb::parallel_for(
             0, nthr, [&](int ithr) { f(ithr, nthr); }, dnnl_tbb_partitioner());
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    using namespace threadpool_utils;
+    if (nthr == 1) {
+        f(0, 1);
+        return;
+    }
+    auto body = [&](int ithr, int) {
+        thread_info_t &info = thread_info();
+        const thread_info_t saved = info;
+        info.ithr = ithr;
+        info.nthr = nthr;
+        info.in_parallel = true;
+        f(ithr, nthr);
+        info = saved;
+    };
+    // Without a threadpool and in nested regions the threads are emulated
+    // by the calling thread one after another, so the work is split the
+    // same way whatever the threadpool is.
+    threadpool_iface *threadpool = active_threadpool();
+    if (threadpool == nullptr || dnnl_in_parallel()
+            || threadpool->get_in_parallel()) {
+        for (int ithr = 0; ithr < nthr; ithr++)
+            body(ithr, nthr);
+    } else {
+        threadpool->parallel_for(nthr, body);
+    }
 #endif
 }
 
@@ -178,22 +218,35 @@ constexpr size_t get_work_amount(const T &v, Args &&... args) {
 
 /* parallel_nd and parallel_nd_in_omp section */
 
-#if DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_TBB
+#if DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_TBB \
+        && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
 template <typename... Args>
 void parallel_nd(Args &&... args) {
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
     for_nd(0, 1, utils::forward<Args>(args)...);
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
     const bool do_parallel = get_work_amount(utils::forward<Args>(args)...) > 1;
+    const numa_utils::binding_t numa_binding = numa_utils::active_binding();
 #pragma omp parallel if (do_parallel)
     {
+        numa_utils::maybe_bind_thread(numa_binding);
         const int nthr = !do_parallel ? 1 : dnnl_get_num_threads();
         const int ithr = !do_parallel ? 0 : dnnl_get_thread_num();
         for_nd(ithr, nthr, utils::forward<Args>(args)...);
     }
 #endif
 }
-#else // DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_TBB
+#else // TBB or THREADPOOL
+
+// Calls body(ithr) for each of nthr threads
+template <typename B>
+void parallel_nd_for_each_thread(int nthr, B body) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+    tbb::parallel_for(0, nthr, body, dnnl_tbb_partitioner());
+#else
+    parallel(nthr, [&](int ithr, int) { body(ithr); });
+#endif
+}
 
 // gcc 4.8 has a bug with passing parameter pack to lambdas.
 // So have to explicitly instantiate all the cases.
@@ -201,33 +254,29 @@ void parallel_nd(Args &&... args) {
 template <typename T0, typename F>
 void parallel_nd(const T0 &D0, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr, [&](int ithr) { for_nd(ithr, nthr, D0, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, f); });
 }
 
 template <typename T0, typename T1, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr, [&](int ithr) { for_nd(ithr, nthr, D0, D1, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, D1, f); });
 }
 
 template <typename T0, typename T1, typename T2, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr, [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, f); });
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr, [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, f); });
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4,
@@ -235,10 +284,8 @@ template <typename T0, typename T1, typename T2, typename T3, typename T4,
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
         const T4 &D4, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr,
-            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, D4, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, D4, f); });
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4,
@@ -246,13 +293,142 @@ template <typename T0, typename T1, typename T2, typename T3, typename T4,
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
         const T4 &D4, const T5 &D5, F f) {
     const int nthr = dnnl_get_max_threads();
-    tbb::parallel_for(
-            0, nthr,
-            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f); },
-            dnnl_tbb_partitioner());
+    parallel_nd_for_each_thread(nthr,
+            [&](int ithr) { for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f); });
 }
 #endif
 
+/* parallel_nd_chunked section */
+
+// Calls f(start, end) for the chunks of [0, work_amount) taken by the threads
+// from a shared counter. The chunks are small enough for the threads that
+// finish early to take over the work of the others, and large enough to
+// make the counter contention negligible.
+template <typename F>
+void parallel_dynamic(size_t work_amount, F f) {
+    const int chunks_per_thread = 16;
+    const int nthr
+            = (int)nstl::min<size_t>(dnnl_get_max_threads(), work_amount);
+    if (nthr <= 1) {
+        if (work_amount > 0) f((size_t)0, work_amount);
+        return;
+    }
+    const size_t chunk = nstl::max<size_t>(
+            1, work_amount / ((size_t)nthr * chunks_per_thread));
+    std::atomic<size_t> next(0);
+    parallel(nthr, [&](int, int) {
+        for (size_t start = next.fetch_add(chunk); start < work_amount;
+                start = next.fetch_add(chunk))
+            f(start, nstl::min(work_amount, start + chunk));
+    });
+}
+
+// gcc 4.8 has a bug with passing parameter pack to lambdas.
+// So have to explicitly instantiate all the cases.
+
+template <typename T0, typename F>
+void parallel_nd_chunked(const T0 &D0, F f) {
+    parallel_dynamic((size_t)D0, [&](size_t start, size_t end) {
+        for (size_t d0 = start; d0 < end; ++d0)
+            f((T0)d0);
+    });
+}
+
+template <typename T0, typename T1, typename F>
+void parallel_nd_chunked(const T0 &D0, const T1 &D1, F f) {
+    parallel_dynamic((size_t)D0 * D1, [&](size_t start, size_t end) {
+        T0 d0 {0};
+        T1 d1 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1);
+            utils::nd_iterator_step(d0, D0, d1, D1);
+        }
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename F>
+void parallel_nd_chunked(const T0 &D0, const T1 &D1, const T2 &D2, F f) {
+    parallel_dynamic((size_t)D0 * D1 * D2, [&](size_t start, size_t end) {
+        T0 d0 {0};
+        T1 d1 {0};
+        T2 d2 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2);
+        }
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename F>
+void parallel_nd_chunked(
+        const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3, F f) {
+    parallel_dynamic((size_t)D0 * D1 * D2 * D3, [&](size_t start, size_t end) {
+        T0 d0 {0};
+        T1 d1 {0};
+        T2 d2 {0};
+        T3 d3 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2, d3, D3);
+        }
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+        typename F>
+void parallel_nd_chunked(const T0 &D0, const T1 &D1, const T2 &D2,
+        const T3 &D3, const T4 &D4, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4;
+    parallel_dynamic(work_amount, [&](size_t start, size_t end) {
+        T0 d0 {0};
+        T1 d1 {0};
+        T2 d2 {0};
+        T3 d3 {0};
+        T4 d4 {0};
+        utils::nd_iterator_init(
+                start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3, d4);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
+        }
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+        typename T5, typename F>
+void parallel_nd_chunked(const T0 &D0, const T1 &D1, const T2 &D2,
+        const T3 &D3, const T4 &D4, const T5 &D5, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4 * D5;
+    parallel_dynamic(work_amount, [&](size_t start, size_t end) {
+        T0 d0 {0};
+        T1 d1 {0};
+        T2 d2 {0};
+        T3 d3 {0};
+        T4 d4 {0};
+        T5 d5 {0};
+        utils::nd_iterator_init(
+                start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4, d5, D5);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3, d4, d5);
+            utils::nd_iterator_step(
+                    d0, D0, d1, D1, d2, D2, d3, D3, d4, D4, d5, D5);
+        }
+    });
+}
+
+/* parallel_nd_dynamic section */
+
+template <typename... Args>
+void parallel_nd_dynamic(Args &&... args) {
+    if (get_dynamic_scheduling())
+        parallel_nd_chunked(utils::forward<Args>(args)...);
+    else
+        parallel_nd(utils::forward<Args>(args)...);
+}
+
 template <typename... Args>
 void parallel_nd_in_omp(Args &&... args) {
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
@@ -260,7 +436,8 @@ void parallel_nd_in_omp(Args &&... args) {
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
     for_nd(dnnl_get_thread_num(), dnnl_get_num_threads(),
             utils::forward<Args>(args)...);
-#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     assert(!"unsupported parallel_nd_in_omp()");
 #endif
 }
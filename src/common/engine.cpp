@@ -82,9 +82,22 @@ status_t dnnl_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
     return success;
 }
 
+status_t dnnl_engine_set_allocator(
+        engine_t *engine, const allocator_t *allocator) {
+    if (engine == nullptr) return invalid_arguments;
+    if (allocator) {
+        const unsigned known_flags
+                = allocator_flags::huge_pages | allocator_flags::first_touch;
+        bool ok = (allocator->allocate == nullptr)
+                        == (allocator->deallocate == nullptr)
+                && (allocator->flags & ~known_flags) == 0;
+        if (!ok) return invalid_arguments;
+    }
+    return engine->set_allocator(allocator);
+}
+
 status_t dnnl_engine_destroy(engine_t *engine) {
-    /* TODO: engine->dec_ref_count(); */
-    delete engine;
+    if (engine) engine->release();
     return success;
 }
 
@@ -17,7 +17,7 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
-#include <mutex>
+#include <atomic>
 
 #include "dnnl.h"
 
@@ -31,23 +31,26 @@
  * Responsibilities:
  *   - Provide engine specific memory allocation
  *   - Provide engine specific primitive_desc_t creators
- *   - Provide engine specific primitive cache
+ *
+ * Engines are reference counted: a primitive implementation holds a
+ * reference to its engine because it may outlive the user's engine handle in
+ * the global primitive cache.
  */
 struct dnnl_engine : public dnnl::impl::c_compatible {
     dnnl_engine(dnnl::impl::engine_kind_t kind,
             dnnl::impl::runtime_kind_t runtime_kind)
-        : kind_(kind), runtime_kind_(runtime_kind) {
-        primitive_cache_ = dnnl::impl::utils::make_unique<
-                dnnl::impl::lru_primitive_cache_t>(
-                get_primitive_cache_capacity());
-
-        static_assert(std::has_virtual_destructor<
-                              dnnl::impl::primitive_cache_t>::value,
-                "primitive_cache_t should have a virtual destructor");
-    }
+        : kind_(kind)
+        , runtime_kind_(runtime_kind)
+        , allocator_({nullptr, nullptr, nullptr, 0})
+        , ref_count_(1) {}
 
     virtual ~dnnl_engine() {}
 
+    void retain() { ref_count_++; }
+    void release() {
+        if (--ref_count_ == 0) delete this;
+    }
+
     /** get kind of the current engine */
     dnnl::impl::engine_kind_t kind() const { return kind_; }
 
@@ -60,9 +63,20 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
             void *handle)
             = 0;
     dnnl::impl::status_t create_memory_storage(
-            dnnl::impl::memory_storage_t **storage, size_t size) {
-        return create_memory_storage(
-                storage, dnnl::impl::memory_flags_t::alloc, size, nullptr);
+            dnnl::impl::memory_storage_t **storage, size_t size,
+            unsigned usage_flags = 0) {
+        return create_memory_storage(storage,
+                dnnl::impl::memory_flags_t::alloc | usage_flags, size, nullptr);
+    }
+
+    /** get the allocator of the memory of the engine */
+    const dnnl::impl::allocator_t &allocator() const { return allocator_; }
+
+    /** set the allocator of the memory of the engine, nullptr resets the
+     * default one */
+    virtual dnnl::impl::status_t set_allocator(
+            const dnnl::impl::allocator_t *allocator) {
+        return dnnl::impl::status::unimplemented;
     }
 
     /** create stream */
@@ -70,6 +84,12 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
             dnnl::impl::stream_t **stream, unsigned flags)
             = 0;
 
+    /** create stream with attributes, the attributes may be nullptr */
+    virtual dnnl::impl::status_t create_stream(dnnl::impl::stream_t **stream,
+            unsigned flags, const dnnl::impl::stream_attr_t *attr) {
+        return create_stream(stream, flags);
+    }
+
     /** implementation section (typedefs) */
 
     // TODO: remove engine?
@@ -93,6 +113,12 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
             const dnnl::impl::memory_desc_t *dst_md, int n, const float *scales,
             const dnnl::impl::memory_desc_t *src_mds);
 
+    typedef dnnl::impl::status_t (*conv_stack_primitive_desc_create_f)(
+            dnnl::impl::conv_stack_pd_t **conv_stack_pd,
+            dnnl::impl::engine_t *engine,
+            const dnnl::impl::primitive_attr_t *attr,
+            const dnnl::impl::conv_stack_desc_t *adesc);
+
     typedef dnnl::impl::status_t (*primitive_desc_create_f)(
             dnnl::impl::primitive_desc_t **, const dnnl::impl::op_desc_t *,
             const dnnl::impl::primitive_attr_t *attr, dnnl::impl::engine_t *,
@@ -115,6 +141,16 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
     virtual const sum_primitive_desc_create_f *
     get_sum_implementation_list() const = 0;
 
+    /** return the list of convolution stack implementations. engine
+     * guarantees to return a NULL-terminated list. The primitive is
+     * experimental, so engines provide no implementations by default */
+    virtual const conv_stack_primitive_desc_create_f *
+    get_conv_stack_implementation_list() const {
+        static const conv_stack_primitive_desc_create_f empty_list[]
+                = {nullptr};
+        return empty_list;
+    }
+
     /** return the list of implementations. engine guarantees to return a
      * NULL-terminated list */
     virtual const primitive_desc_create_f *get_implementation_list() const = 0;
@@ -145,84 +181,47 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
         dnnl::impl::primitive_hashing::key_t key(
                 pd, this->dnnl_get_max_threads());
 
-        // lock cache
-        recursive_mutex_.lock();
+        // the cache is not locked while a primitive_impl is being created,
+        // so only the threads requesting the same primitive wait for it
+        std::shared_ptr<dnnl::impl::primitive_impl_t> primitive_impl;
+        bool is_cache_hit = false;
+        auto status = dnnl::impl::primitive_cache().get_or_create(key,
+                primitive_impl, is_cache_hit,
+                [&](std::shared_ptr<dnnl::impl::primitive_impl_t> &impl) {
+                    impl = create_primitive_impl();
+                    if (!impl) return dnnl::impl::status::out_of_memory;
+                    return impl->init();
+                });
+        if (status != dnnl::impl::status::success) return status;
+
+        // create a wrapper over the primitive_impl
         dnnl::impl::primitive_t *p = nullptr;
-        auto primitive_impl = primitive_cache_->get(key);
-        if (primitive_impl) {
-            // cache hit
-            // unlock cache because it's safe to create a wrapper in parallel
-            recursive_mutex_.unlock();
-            // create a wrapper for primitive_impl
-            auto status
-                    = dnnl::impl::safe_ptr_assign<dnnl::impl::primitive_t>(p,
-                            new dnnl::impl::primitive_t(
-                                    primitive_impl, use_global_scratchpad));
-            if (status != dnnl::impl::status::success) return status;
-
-            ms = dnnl::impl::get_msec() - ms;
-            print_verbose(dnnl::impl::get_verbose(), true, p, ms);
-            (*primitive) = p;
-            return status;
-        }
-
-        // cache miss
-        // create a requested primitive_impl
-        primitive_impl = create_primitive_impl();
-        // create a wrapper over created primitive_impl
-        auto status = dnnl::impl::safe_ptr_assign<dnnl::impl::primitive_t>(p,
+        status = dnnl::impl::safe_ptr_assign<dnnl::impl::primitive_t>(p,
                 new dnnl::impl::primitive_t(
-                        primitive_impl, use_global_scratchpad));
-
-        if (status != dnnl::impl::status::success) {
-            recursive_mutex_.unlock();
-            return status;
-        }
-
-        status = p->init();
-        if (status != dnnl::impl::status::success) {
-            recursive_mutex_.unlock();
-            delete p;
-            return status;
-        }
-
-        // update op_desc and attr pointers in the key
-        key.op_desc_ = p->pd()->op_desc();
-        key.attr_ = p->pd()->attr();
-
-        primitive_cache_->add(key, p->get_primitive_impl());
-        recursive_mutex_.unlock();
+                        this, primitive_impl, use_global_scratchpad));
+        if (status != dnnl::impl::status::success) return status;
 
         ms = dnnl::impl::get_msec() - ms;
-        print_verbose(dnnl::impl::get_verbose(), false, p, ms);
+        print_verbose(dnnl::impl::get_verbose(), is_cache_hit, p, ms);
         (*primitive) = p;
         return status;
     }
 
-    size_t get_primitive_cache_capacity() const {
-        // Default capacity is 0 - primitive cache is disabled by default
-        // Use call_once to avoid performance impact due to multiple getenv
-        // calls
-        static size_t primitive_cache_capacity = 0;
-#ifdef DNNL_ENABLE_PRIMITIVE_CACHE
-        static std::once_flag initialized;
-        std::call_once(initialized, [&] {
-            primitive_cache_capacity = dnnl::impl::getenv_int(
-                    "DNNL_PRIMITIVE_CACHE_CAPACITY", 200);
-        });
-#endif
-        return primitive_cache_capacity;
-    }
-
     int dnnl_get_max_threads();
 
+    /** get the cache of primitive descriptors created for this engine */
+    dnnl::impl::lru_primitive_desc_cache_t &primitive_desc_cache() {
+        return primitive_desc_cache_;
+    }
+
 protected:
     dnnl::impl::engine_kind_t kind_;
     dnnl::impl::runtime_kind_t runtime_kind_;
-    std::unique_ptr<dnnl::impl::primitive_cache_t> primitive_cache_;
-    // As a primitive can be created inside another one a recursive_mutex is
-    // required
-    std::recursive_mutex recursive_mutex_;
+    dnnl::impl::allocator_t allocator_;
+
+private:
+    std::atomic<int> ref_count_;
+    dnnl::impl::lru_primitive_desc_cache_t primitive_desc_cache_;
 };
 
 namespace dnnl {
@@ -238,16 +237,22 @@ inline runtime_kind_t get_default_runtime(engine_kind_t kind) {
     return runtime_kind::omp;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_TBB
     return runtime_kind::tbb;
+#elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    return runtime_kind::threadpool;
 #else
     return runtime_kind::none;
 #endif
 }
 
 inline bool is_native_runtime(runtime_kind_t kind) {
-    return utils::one_of(
-            kind, runtime_kind::seq, runtime_kind::omp, runtime_kind::tbb);
+    return utils::one_of(kind, runtime_kind::seq, runtime_kind::omp,
+            runtime_kind::tbb, runtime_kind::threadpool);
 }
 
+struct engine_deleter_t {
+    void operator()(engine_t *engine) const { engine->release(); }
+};
+
 struct engine_factory_t : public c_compatible {
     virtual size_t count() const = 0;
     virtual status_t engine_create(engine_t **engine, size_t index) const = 0;
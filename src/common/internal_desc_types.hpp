@@ -48,6 +48,21 @@ typedef struct {
     std::vector<dnnl_memory_desc_t> src_mds;
 } dnnl_sum_desc_t;
 
+typedef struct {
+    dnnl_convolution_desc_t conv_desc;
+    // The only post-op a layer may have, dnnl_alg_kind_undef if none
+    dnnl_alg_kind_t eltwise_alg;
+    float eltwise_scale;
+    float eltwise_alpha;
+    float eltwise_beta;
+} dnnl_conv_stack_layer_desc_t;
+
+typedef struct {
+    dnnl_primitive_kind_t primitive_kind;
+    dnnl_dim_t n;
+    std::vector<dnnl_conv_stack_layer_desc_t> layers;
+} dnnl_conv_stack_desc_t;
+
 } // namespace impl
 } // namespace dnnl
 
@@ -45,10 +45,10 @@ status_t dnnl_matmul_desc_init(matmul_desc_t *matmul_desc,
 
     int offset = 0;
     if (ndims == 3) {
-        // check: batch
+        // check: batch, the batch of src and weights can be broadcast
         ok = ok
-                && everyone_is(op_d.dst_desc.dims[0], op_d.src_desc.dims[0],
-                        op_d.weights_desc.dims[0]);
+                && one_of(op_d.src_desc.dims[0], 1, op_d.dst_desc.dims[0])
+                && one_of(op_d.weights_desc.dims[0], 1, op_d.dst_desc.dims[0]);
         offset = 1;
     }
 
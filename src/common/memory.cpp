@@ -17,11 +17,15 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "dnnl.h"
 
 #include "c_types_map.hpp"
+#include "cpu/cpu_numa.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
+#include "memory.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
@@ -81,6 +85,91 @@ dnnl_memory::dnnl_memory(dnnl::impl::engine_t *engine,
     if (!(flags & omit_zero_pad)) zero_pad();
 }
 
+dnnl_memory::~dnnl_memory() {
+    for (auto &replica : numa_replicas_)
+        delete replica.load();
+}
+
+void dnnl_memory::set_numa_replicated(bool replicated) {
+    numa_replicated_ = replicated;
+    if (!replicated) {
+        drop_numa_replicas();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(numa_replicas_mutex_);
+    if (numa_replicas_.empty())
+        numa_replicas_ = std::vector<std::atomic<memory_t *>>(
+                cpu::numa::get_node_count());
+}
+
+status_t dnnl_memory::acquire_numa_replica(int node, memory_t **replica) {
+    if (!numa_replicated_ || node < 0 || node >= (int)numa_replicas_.size()) {
+        *replica = this;
+        return success;
+    }
+
+    // the user is counted before the copy is read, so the copy is not freed
+    // if it is dropped meanwhile
+    numa_replica_users_++;
+    memory_t *copy = numa_replicas_[node].load();
+    if (copy == nullptr) {
+        std::lock_guard<std::mutex> lock(numa_replicas_mutex_);
+        copy = numa_replicas_[node].load();
+        if (copy == nullptr) {
+            std::unique_ptr<memory_t> new_copy(new memory_t(engine_, &md_,
+                    memory_flags_t::alloc | memory_flags_t::omit_zero_pad,
+                    nullptr));
+            status_t status = new_copy->memory_storage() == nullptr
+                    ? out_of_memory
+                    : success;
+            const char *src = nullptr;
+            char *dst = nullptr;
+            if (status == success) status = get_data_handle((void **)&src);
+            if (status == success)
+                status = new_copy->get_data_handle((void **)&dst);
+            if (status != success) {
+                numa_replica_users_--;
+                return status;
+            }
+            const size_t size = memory_desc_wrapper(md_).size();
+            // the copy is written by the threads bound to the node, so the
+            // OS places its pages on the node
+            parallel(0, [&](int ithr, int nthr) {
+                size_t start = 0, end = 0;
+                balance211(size, nthr, ithr, start, end);
+                if (start < end) memcpy(dst + start, src + start, end - start);
+            });
+            copy = new_copy.release();
+            numa_replicas_[node].store(copy);
+        }
+    }
+    *replica = copy;
+    return success;
+}
+
+void dnnl_memory::release_numa_replica() {
+    if (--numa_replica_users_ > 0 || !has_retired_numa_replicas_.load())
+        return;
+    std::lock_guard<std::mutex> lock(numa_replicas_mutex_);
+    if (numa_replica_users_.load() > 0) return;
+    retired_numa_replicas_.clear();
+    has_retired_numa_replicas_.store(false);
+}
+
+void dnnl_memory::drop_numa_replicas() {
+    std::lock_guard<std::mutex> lock(numa_replicas_mutex_);
+    for (auto &replica : numa_replicas_) {
+        memory_t *copy = replica.exchange(nullptr);
+        if (copy) retired_numa_replicas_.emplace_back(copy);
+    }
+    if (retired_numa_replicas_.empty()) return;
+    // the copies in use are freed by their last user
+    has_retired_numa_replicas_.store(true);
+    if (numa_replica_users_.load() > 0) return;
+    retired_numa_replicas_.clear();
+    has_retired_numa_replicas_.store(false);
+}
+
 status_t dnnl_memory_desc_init_by_tag(memory_desc_t *memory_desc, int ndims,
         const dims_t dims, data_type_t data_type, format_tag_t tag) {
     if (any_null(memory_desc)) return invalid_arguments;
@@ -324,6 +413,13 @@ status_t dnnl_memory_set_data_handle(memory_t *memory, void *handle) {
     return memory->set_data_handle(handle);
 }
 
+status_t dnnl_memory_set_numa_replicated(memory_t *memory, int replicated) {
+    if (any_null(memory)) return invalid_arguments;
+    if (memory->engine()->kind() != engine_kind::cpu) return invalid_arguments;
+    memory->set_numa_replicated(replicated != 0);
+    return success;
+}
+
 status_t dnnl_memory_map_data(const memory_t *memory, void **mapped_ptr) {
     bool args_ok = !any_null(memory, mapped_ptr);
     if (!args_ok) return invalid_arguments;
@@ -18,7 +18,10 @@
 #define MEMORY_HPP
 
 #include <assert.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "dnnl.h"
 
@@ -30,14 +33,26 @@
 
 namespace dnnl {
 namespace impl {
-enum memory_flags_t { alloc = 0x1, use_runtime_ptr = 0x2, omit_zero_pad = 0x4 };
+enum memory_flags_t {
+    alloc = 0x1,
+    use_runtime_ptr = 0x2,
+    omit_zero_pad = 0x4,
+    // The memory is passed to the engine allocator as a scratchpad. It is
+    // user memory otherwise.
+    usage_scratchpad = 0x8,
+};
+
+inline memory_usage_t memory_usage_from_flags(unsigned flags) {
+    if (flags & usage_scratchpad) return memory_usage::scratchpad;
+    return memory_usage::user;
+}
 } // namespace impl
 } // namespace dnnl
 
 struct dnnl_memory : public dnnl::impl::c_compatible {
     dnnl_memory(dnnl::impl::engine_t *engine,
             const dnnl::impl::memory_desc_t *md, unsigned flags, void *handle);
-    virtual ~dnnl_memory() {}
+    virtual ~dnnl_memory();
 
     /** returns memory's engine */
     dnnl::impl::engine_t *engine() const { return engine_; }
@@ -61,6 +76,7 @@ struct dnnl_memory : public dnnl::impl::c_compatible {
 
         if (handle != old_handle) {
             CHECK(memory_storage()->set_data_handle(handle));
+            drop_numa_replicas();
         }
         return zero_pad();
     }
@@ -68,6 +84,19 @@ struct dnnl_memory : public dnnl::impl::c_compatible {
     /** zeros padding */
     dnnl::impl::status_t zero_pad() const;
 
+    /** marks the memory as holding constant data replicated on the NUMA
+     * nodes it is used on */
+    void set_numa_replicated(bool replicated);
+    bool is_numa_replicated() const { return numa_replicated_; }
+
+    /** returns the copy of the memory on a NUMA node, which is created on
+     * first use by the threads bound to the node; the copy is not freed
+     * before release_numa_replica() is called, even if it is dropped
+     * meanwhile */
+    dnnl::impl::status_t acquire_numa_replica(
+            int node, dnnl_memory **replica);
+    void release_numa_replica();
+
 protected:
     dnnl::impl::engine_t *engine_;
     const dnnl::impl::memory_desc_t md_;
@@ -76,10 +105,22 @@ private:
     template <dnnl::impl::data_type_t>
     dnnl::impl::status_t typed_zero_pad() const;
 
+    void drop_numa_replicas();
+
     dnnl_memory() = delete;
     DNNL_DISALLOW_COPY_AND_ASSIGN(dnnl_memory);
 
     std::unique_ptr<dnnl::impl::memory_storage_t> memory_storage_;
+
+    bool numa_replicated_ = false;
+    // The copies are read without the mutex, which only serializes their
+    // creation and dropping. The dropped copies are retired until the
+    // executions using them are done.
+    std::mutex numa_replicas_mutex_;
+    std::vector<std::atomic<dnnl_memory *>> numa_replicas_;
+    std::vector<std::unique_ptr<dnnl_memory>> retired_numa_replicas_;
+    std::atomic<bool> has_retired_numa_replicas_ {false};
+    std::atomic<int> numa_replica_users_ {0};
 };
 
 #endif
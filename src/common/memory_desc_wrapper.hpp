@@ -98,34 +98,42 @@ struct memory_desc_wrapper : public c_compatible {
 
     /** return the size of data type of additional buffer */
     size_t additional_buffer_data_size() const {
-        if (extra().flags & memory_extra_flags::compensation_conv_s8s8)
+        using namespace memory_extra_flags;
+        if (extra().flags
+                & (compensation_conv_s8s8 | compensation_conv_asymmetric_src))
             return sizeof(int32_t);
-        if (extra().flags & memory_extra_flags::gpu_rnn_u8s8_compensation)
+        if (extra().flags & gpu_rnn_u8s8_compensation)
             return sizeof(float);
         return 0;
     }
 
     /** return true if memory format has additional buffer */
     bool is_additional_buffer() const {
+        using namespace memory_extra_flags;
         return (extra().flags
-                & (memory_extra_flags::compensation_conv_s8s8
-                        | memory_extra_flags::gpu_rnn_u8s8_compensation));
+                & (compensation_conv_s8s8 | gpu_rnn_u8s8_compensation
+                        | compensation_conv_asymmetric_src));
     }
 
     /** returns the size of additional buffer */
     size_t additional_buffer_size() const {
-        if (extra().flags
-                & (memory_extra_flags::compensation_conv_s8s8
-                        | memory_extra_flags::gpu_rnn_u8s8_compensation)) {
-            int cmask = extra().compensation_mask;
+        using namespace memory_extra_flags;
+        auto calculate_size = [=](int cmask) {
             assert(cmask == 1 || cmask == 3 || cmask == 27);
             dim_t prod = 1;
             for (int d = 0; d < ndims(); ++d)
                 if (cmask & (1 << d)) prod *= padded_dims()[d];
             return prod * additional_buffer_data_size();
-        }
+        };
 
-        return 0;
+        size_t buff_size = 0;
+        if (extra().flags
+                & (compensation_conv_s8s8 | gpu_rnn_u8s8_compensation))
+            buff_size += calculate_size(extra().compensation_mask);
+        if (extra().flags & compensation_conv_asymmetric_src)
+            buff_size += calculate_size(extra().asymm_compensation_mask);
+
+        return buff_size;
     }
 
     /** returns the size required to store described memory
@@ -160,11 +160,15 @@ enum {
     key_conv_bia_reduction,
     key_conv_bias_bf16_convert_wsp,
     key_conv_dst_bf16_convert_wsp,
+    key_conv_dw_fusion_buffer,
     key_conv_gemm_col,
     key_conv_gemm_imtr,
+    key_conv_gemm_zp_src_comp,
     key_conv_int_dat_in_acc_dt,
     key_conv_padded_bias,
     key_conv_rtus_space,
+    key_conv_stack_nested_scratchpad,
+    key_conv_stack_tile_buffers,
     key_conv_tails,
     key_conv_tr_diff_dst,
     key_conv_tr_diff_dst_bctx,
@@ -269,8 +273,9 @@ struct registry_t {
         return aligned_ptr;
     }
 
-    std::unique_ptr<memory_storage_t> get_memory_storage(
-            const key_t &key, const memory_storage_t *base_mem_storage) const {
+    std::unique_ptr<memory_storage_t> get_memory_storage(const key_t &key,
+            const memory_storage_t *base_mem_storage,
+            size_t base_offset = 0) const {
         if (!base_mem_storage) {
             assert(size() == 0);
             return nullptr;
@@ -279,13 +284,15 @@ struct registry_t {
 
         const auto &e = offset_map_.at(key);
         assert(e.offset + e.size <= size());
-        return base_mem_storage->get_sub_storage(e.offset, e.size);
+        return base_mem_storage->get_sub_storage(
+                base_offset + e.offset, e.size);
     }
 
     size_t size() const { return size_; }
 
     registrar_t registrar();
-    grantor_t grantor(const memory_storage_t *mem_storage) const;
+    grantor_t grantor(
+            const memory_storage_t *mem_storage, size_t base_offset = 0) const;
 
 protected:
     enum { minimal_alignment = 64 };
@@ -315,16 +322,20 @@ protected:
     const key_t prefix_;
 };
 
+// The scratchpad starts at base_offset bytes from the beginning of the base
+// memory storage
 struct grantor_t {
     grantor_t(const registry_t &registry,
-            const memory_storage_t *base_mem_storage)
+            const memory_storage_t *base_mem_storage, size_t base_offset = 0)
         : registry_(registry)
         , prefix_(0)
-        , base_mem_storage_(base_mem_storage) {}
+        , base_mem_storage_(base_mem_storage)
+        , base_offset_(base_offset) {}
     grantor_t(const grantor_t &parent, const key_t &prefix)
         : registry_(parent.registry_)
         , prefix_(make_prefix(parent.prefix_, prefix))
-        , base_mem_storage_(parent.base_mem_storage_) {}
+        , base_mem_storage_(parent.base_mem_storage_)
+        , base_offset_(parent.base_offset_) {}
 
     template <typename T = void>
     T *get(const key_t &key) const {
@@ -333,19 +344,21 @@ struct grantor_t {
         auto status = base_mem_storage_->get_data_handle(&base_ptr);
         assert(status == status::success);
         MAYBE_UNUSED(status);
+        if (base_ptr) base_ptr = (char *)base_ptr + base_offset_;
         return (T *)registry_.get(make_key(prefix_, key), base_ptr);
     }
 
     std::unique_ptr<memory_storage_t> get_memory_storage(
             const key_t &key) const {
         return registry_.get_memory_storage(
-                make_key(prefix_, key), base_mem_storage_);
+                make_key(prefix_, key), base_mem_storage_, base_offset_);
     }
 
 protected:
     const registry_t &registry_;
     const key_t prefix_;
     const memory_storage_t *base_mem_storage_;
+    size_t base_offset_;
 };
 
 inline registrar_t registry_t::registrar() {
@@ -353,8 +366,8 @@ inline registrar_t registry_t::registrar() {
 }
 
 inline grantor_t registry_t::grantor(
-        const memory_storage_t *mem_storage) const {
-    return grantor_t(*this, mem_storage);
+        const memory_storage_t *mem_storage, size_t base_offset) const {
+    return grantor_t(*this, mem_storage, base_offset);
 }
 
 } // namespace memory_tracking
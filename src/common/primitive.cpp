@@ -67,6 +67,30 @@ status_t dnnl_primitive_execute(const primitive_t *primitive, stream_t *stream,
     status_t status = cvt_primtive_args(primitive->pd(), nargs, c_args, args);
     if (status != status::success) return status;
 
+    stream->before_exec_hook();
+
+    // the constant inputs replicated on the NUMA nodes are replaced with
+    // their copies on the node the stream is bound to
+    std::vector<memory_t *> replicated;
+    auto release_replicas = [&]() {
+        for (auto *mem : replicated)
+            mem->release_numa_replica();
+    };
+    if (stream->numa_node() >= 0) {
+        for (auto &arg : args) {
+            memory_t *mem = arg.second.mem;
+            if (!arg.second.is_const || !mem->is_numa_replicated()) continue;
+            status = mem->acquire_numa_replica(
+                    stream->numa_node(), &arg.second.mem);
+            if (status != status::success) {
+                release_replicas();
+                stream->after_exec_hook();
+                return status;
+            }
+            if (arg.second.mem != mem) replicated.push_back(mem);
+        }
+    }
+
     exec_ctx_t ctx(stream, std::move(args));
 
     if (get_verbose()) {
@@ -80,6 +104,9 @@ status_t dnnl_primitive_execute(const primitive_t *primitive, stream_t *stream,
         status = primitive->execute(ctx);
     }
 
+    release_replicas();
+    stream->after_exec_hook();
+
     if (msan_enabled) unpoison_outputs(ctx.args());
 
     return status;
@@ -97,18 +124,30 @@ status_t dnnl_primitive_destroy(primitive_t *primitive) {
     return success;
 }
 
+// primitive_impl_t implementation
+primitive_impl_t::primitive_impl_t(const primitive_desc_t *pd)
+    : pd_(pd->clone()) {
+    engine()->retain();
+}
+
+primitive_impl_t::~primitive_impl_t() {
+    engine_t *engine = pd_->engine();
+    delete pd_;
+    engine->release();
+}
+
 // primitive_t implementation
-dnnl_primitive::dnnl_primitive(
+dnnl_primitive::dnnl_primitive(engine_t *engine,
         const std::shared_ptr<primitive_impl_t> &primitive_impl,
         bool use_global_scratchpad = false)
-    : primitive_impl_(primitive_impl), scratchpad_(nullptr) {
+    : engine_(engine), primitive_impl_(primitive_impl), scratchpad_(nullptr) {
 
     const size_t scratchpad_size
             = primitive_impl_->pd()->scratchpad_size(scratchpad_mode::library);
 
     if (scratchpad_size) {
         auto *scratchpad_ptr = create_scratchpad(
-                engine(), scratchpad_size, use_global_scratchpad);
+                engine_, scratchpad_size, use_global_scratchpad);
         scratchpad_.reset(scratchpad_ptr);
     }
 }
@@ -118,7 +157,7 @@ status_t dnnl_primitive::init() {
 }
 
 engine_t *dnnl_primitive::engine() const {
-    return primitive_impl_->engine();
+    return engine_;
 }
 
 const primitive_desc_t *dnnl_primitive::pd() const {
@@ -132,19 +171,25 @@ dnnl_primitive::get_primitive_impl() const {
 
 status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
-    if (primitive_impl_->pd()->attr()->scratchpad_mode_
-            == scratchpad_mode::user) {
+    size_t offset = 0;
+    const bool user_scratchpad = primitive_impl_->pd()->attr()->scratchpad_mode_
+            == scratchpad_mode::user;
+    if (user_scratchpad) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
     } else if (scratchpad_) {
-        mem_storage = scratchpad_->get_memory_storage();
+        mem_storage = scratchpad_->acquire(offset);
+        if (mem_storage == nullptr) return status::out_of_memory;
     }
 
     ctx.set_scratchpad_grantor(
-            primitive_impl_->pd()->scratchpad_registry().grantor(mem_storage));
+            primitive_impl_->pd()->scratchpad_registry().grantor(
+                    mem_storage, offset));
 
     auto status = primitive_impl_->execute(ctx);
+
+    if (scratchpad_ && !user_scratchpad) scratchpad_->release();
     return status;
 }
 
@@ -40,7 +40,7 @@
     static_cast<ARG_TYPE(type) *>(CTX_OUT_STORAGE(arg).data_handle())
 
 struct dnnl_primitive : public dnnl::impl::c_compatible {
-    dnnl_primitive(
+    dnnl_primitive(dnnl::impl::engine_t *engine,
             const std::shared_ptr<dnnl::impl::primitive_impl_t> &primitive_impl,
             bool use_global_scratchpad);
 
@@ -52,6 +52,9 @@ struct dnnl_primitive : public dnnl::impl::c_compatible {
     dnnl::impl::status_t execute(dnnl::impl::exec_ctx_t &ctx) const;
 
 private:
+    // The engine the primitive was requested for. It may differ from the
+    // engine of the implementation, which can be shared between engines.
+    dnnl::impl::engine_t *engine_;
     std::shared_ptr<dnnl::impl::primitive_impl_t> primitive_impl_;
     std::unique_ptr<dnnl::impl::scratchpad_t> scratchpad_;
 
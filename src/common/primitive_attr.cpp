@@ -17,6 +17,7 @@
 #include "dnnl.h"
 
 #include "c_types_map.hpp"
+#include "memory_desc_wrapper.hpp"
 #include "primitive_attr.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
@@ -157,6 +158,49 @@ status_t post_ops_t::append_eltwise(
     return success;
 }
 
+status_t post_ops_t::append_binary(
+        alg_kind_t alg, const memory_desc_t *src1_desc) {
+    using namespace dnnl::impl::alg_kind;
+    bool known_alg = one_of(alg, binary_add, binary_mul);
+    if (!known_alg) return invalid_arguments;
+
+    bool ok = src1_desc != nullptr && src1_desc->ndims > 0
+            && src1_desc->format_kind != format_kind::any
+            && !memory_desc_wrapper(src1_desc).has_runtime_dims_or_strides();
+    if (!ok) return invalid_arguments;
+
+    if (len_ == capacity) return out_of_memory;
+
+    entry_[len_].kind = primitive_kind::binary;
+    entry_[len_].binary.alg = alg;
+    entry_[len_].binary.src1_desc = *src1_desc;
+
+    len_++;
+
+    return success;
+}
+
+status_t post_ops_t::append_depthwise_conv(int stride, data_type_t wei_dt,
+        data_type_t bias_dt, data_type_t dst_dt) {
+    bool ok = one_of(stride, 1, 2) && wei_dt != data_type::undef
+            && dst_dt != data_type::undef
+            // only a single depthwise convolution can be fused
+            && find(primitive_kind::convolution) == -1;
+    if (!ok) return invalid_arguments;
+
+    if (len_ == capacity) return out_of_memory;
+
+    entry_[len_].kind = primitive_kind::convolution;
+    entry_[len_].depthwise_conv.stride = stride;
+    entry_[len_].depthwise_conv.wei_dt = wei_dt;
+    entry_[len_].depthwise_conv.bias_dt = bias_dt;
+    entry_[len_].depthwise_conv.dst_dt = dst_dt;
+
+    len_++;
+
+    return success;
+}
+
 bool post_ops_t::defined() const {
     for (int idx = 0; idx < len_; ++idx) {
         if (entry_[idx].kind == primitive_kind::sum) {
@@ -166,7 +210,8 @@ bool post_ops_t::defined() const {
             if (is_runtime_value(e.scale) || is_runtime_value(e.alpha)
                     || is_runtime_value(e.beta))
                 return false;
-        } else {
+        } else if (!one_of(entry_[idx].kind, primitive_kind::binary,
+                           primitive_kind::convolution)) {
             assert(!"unreachable");
         }
     }
@@ -347,6 +392,75 @@ status_t dnnl_post_ops_get_params_eltwise(const post_ops_t *post_ops, int index,
     return success;
 }
 
+status_t dnnl_post_ops_append_binary(post_ops_t *post_ops, alg_kind_t kind,
+        const memory_desc_t *src1_desc) {
+    if (post_ops == nullptr) return invalid_arguments;
+
+    return post_ops->append_binary(kind, src1_desc);
+}
+
+status_t dnnl_post_ops_get_params_binary(const post_ops_t *post_ops,
+        int index, alg_kind_t *alg, const memory_desc_t **src1_desc) {
+    bool ok = true
+            && simple_get_params_check(post_ops, index, primitive_kind::binary)
+            && !any_null(alg, src1_desc);
+    if (!ok) return invalid_arguments;
+
+    const auto &e = post_ops->entry_[index].binary;
+    *alg = e.alg;
+    *src1_desc = &e.src1_desc;
+
+    return success;
+}
+
+namespace {
+status_t get_params_depthwise_conv(const post_ops_t *post_ops, int index,
+        int stride, data_type_t *wei_dt, data_type_t *bias_dt,
+        data_type_t *dst_dt) {
+    bool ok = true
+            && simple_get_params_check(
+                    post_ops, index, primitive_kind::convolution)
+            && post_ops->entry_[index].depthwise_conv.stride == stride
+            && !any_null(wei_dt, bias_dt, dst_dt);
+    if (!ok) return invalid_arguments;
+
+    const auto &e = post_ops->entry_[index].depthwise_conv;
+    *wei_dt = e.wei_dt;
+    *bias_dt = e.bias_dt;
+    *dst_dt = e.dst_dt;
+
+    return success;
+}
+} // namespace
+
+status_t dnnl_post_ops_append_dw_k3s1p1(post_ops_t *post_ops,
+        data_type_t wei_dt, data_type_t bias_dt, data_type_t dst_dt) {
+    if (post_ops == nullptr) return invalid_arguments;
+
+    return post_ops->append_depthwise_conv(1, wei_dt, bias_dt, dst_dt);
+}
+
+status_t dnnl_post_ops_get_params_dw_k3s1p1(const post_ops_t *post_ops,
+        int index, data_type_t *wei_dt, data_type_t *bias_dt,
+        data_type_t *dst_dt) {
+    return get_params_depthwise_conv(
+            post_ops, index, 1, wei_dt, bias_dt, dst_dt);
+}
+
+status_t dnnl_post_ops_append_dw_k3s2p1(post_ops_t *post_ops,
+        data_type_t wei_dt, data_type_t bias_dt, data_type_t dst_dt) {
+    if (post_ops == nullptr) return invalid_arguments;
+
+    return post_ops->append_depthwise_conv(2, wei_dt, bias_dt, dst_dt);
+}
+
+status_t dnnl_post_ops_get_params_dw_k3s2p1(const post_ops_t *post_ops,
+        int index, data_type_t *wei_dt, data_type_t *bias_dt,
+        data_type_t *dst_dt) {
+    return get_params_depthwise_conv(
+            post_ops, index, 2, wei_dt, bias_dt, dst_dt);
+}
+
 status_t dnnl_primitive_attr_set_rnn_data_qparams(
         primitive_attr_t *attr, const float scale, const float shift) {
     if (attr == nullptr) return invalid_arguments;
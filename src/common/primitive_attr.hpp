@@ -233,12 +233,26 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
             float scale, alpha, beta;
         };
 
+        struct binary_t {
+            dnnl::impl::alg_kind_t alg;
+            dnnl::impl::memory_desc_t src1_desc;
+        };
+
+        struct depthwise_conv_t {
+            int stride;
+            dnnl::impl::data_type_t wei_dt;
+            dnnl::impl::data_type_t bias_dt;
+            dnnl::impl::data_type_t dst_dt;
+        };
+
         dnnl::impl::primitive_kind_t kind;
         union {
             struct {
                 float scale;
             } sum;
             eltwise_t eltwise;
+            binary_t binary;
+            depthwise_conv_t depthwise_conv;
         };
 
         bool is_eltwise(bool require_scale_one = false) const {
@@ -261,6 +275,14 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
                     && IMPLICATION(require_scale_one, sum.scale == 1.f);
         }
 
+        bool is_binary() const {
+            return kind == dnnl::impl::primitive_kind::binary;
+        }
+
+        bool is_depthwise_conv() const {
+            return kind == dnnl::impl::primitive_kind::convolution;
+        }
+
         bool operator==(const entry_t &rhs) const {
             using namespace dnnl::impl;
             if (kind != rhs.kind) { return false; }
@@ -275,6 +297,19 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
                 case primitive_kind::sum:
                     ret = sum.scale == rhs.sum.scale;
                     break;
+                case primitive_kind::binary:
+                    ret = binary.alg == rhs.binary.alg
+                            && binary.src1_desc == rhs.binary.src1_desc;
+                    break;
+                case primitive_kind::convolution:
+                    ret = depthwise_conv.stride == rhs.depthwise_conv.stride
+                            && depthwise_conv.wei_dt
+                                    == rhs.depthwise_conv.wei_dt
+                            && depthwise_conv.bias_dt
+                                    == rhs.depthwise_conv.bias_dt
+                            && depthwise_conv.dst_dt
+                                    == rhs.depthwise_conv.dst_dt;
+                    break;
                 default: assert(!"unsupported post_op");
             }
             return ret;
@@ -290,6 +325,11 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
     dnnl::impl::status_t append_sum(float scale);
     dnnl::impl::status_t append_eltwise(
             float scale, dnnl::impl::alg_kind_t alg, float alpha, float beta);
+    dnnl::impl::status_t append_binary(dnnl::impl::alg_kind_t alg,
+            const dnnl::impl::memory_desc_t *src1_desc);
+    dnnl::impl::status_t append_depthwise_conv(int stride,
+            dnnl::impl::data_type_t wei_dt, dnnl::impl::data_type_t bias_dt,
+            dnnl::impl::data_type_t dst_dt);
 
     int find(dnnl::impl::primitive_kind_t kind, int start = 0,
             int stop = -1) const {
@@ -0,0 +1,328 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <exception>
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+
+#include "primitive_cache.hpp"
+
+namespace dnnl {
+namespace impl {
+
+constexpr size_t lru_primitive_cache_t::max_shards;
+
+primitive_cache_t &primitive_cache() {
+    // Default capacity is 0 - primitive cache is disabled by default
+    static lru_primitive_cache_t cache(
+#ifdef DNNL_ENABLE_PRIMITIVE_CACHE
+            nstl::max(0, getenv_int("DNNL_PRIMITIVE_CACHE_CAPACITY", 200))
+#else
+            0
+#endif
+    );
+    return cache;
+}
+
+lru_primitive_cache_t::lru_primitive_cache_t(size_t capacity)
+    : capacity_(capacity)
+    , memory_capacity_(0)
+    , use_counter_(0)
+    , size_(0)
+    , memory_size_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0) {}
+
+status_t lru_primitive_cache_t::get_or_create(const key_type &key,
+        value_type &impl, bool &is_hit, const create_func_type &create) {
+    // cache is disabled
+    if (capacity_ == 0) {
+        is_hit = false;
+        return create(impl);
+    }
+
+    auto &shard = get_shard(key);
+    std::promise<result_t> promise;
+    {
+        std::unique_lock<std::mutex> lock(shard.mutex_);
+        auto it = shard.cache_mapper_.find(key);
+        if (it != shard.cache_mapper_.end()) {
+            // move 1 cache_list_ node to the front of the cache_list_
+            shard.cache_list_.splice(shard.cache_list_.begin(),
+                    shard.cache_list_, it->second);
+            auto &entry = shard.cache_list_.front();
+            entry.last_use = use_counter_++;
+            impl = entry.impl;
+            is_hit = true;
+            hits_++;
+            return status::success;
+        }
+
+        auto in_flight_it = shard.in_flight_.find(key);
+        if (in_flight_it != shard.in_flight_.end()) {
+            // another thread is creating the same primitive: wait for it
+            // without holding the shard lock
+            auto pending = in_flight_it->second;
+            lock.unlock();
+            const result_t &result = pending.get();
+            impl = result.impl;
+            is_hit = true;
+            hits_++;
+            return result.status;
+        }
+
+        shard.in_flight_.emplace(key, promise.get_future().share());
+    }
+
+    // cache miss: create the primitive implementation with no lock held so
+    // that creation of distinct primitives (e.g. JIT compilation) proceeds
+    // in parallel and nested primitives may be created from `create`
+    misses_++;
+    is_hit = false;
+    result_t result {status::success, nullptr};
+    bool added = false;
+    try {
+        const size_t jit_code_size_start = get_jit_code_size();
+        result.status = create(result.impl);
+        if (result.status != status::success) result.impl = nullptr;
+
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        shard.in_flight_.erase(key);
+        if (result.status == status::success && capacity_ > 0) {
+            // the memory held by a primitive is estimated as the size of the
+            // code generated for it (including nested primitives) and the
+            // size of the scratchpad every primitive_t over it allocates
+            const size_t memory_size = get_jit_code_size()
+                    - jit_code_size_start
+                    + result.impl->pd()->scratchpad_size(
+                            scratchpad_mode::library);
+            // the key must refer to the descriptors owned by the cached
+            // implementation rather than to the ones of the caller
+            key_type cached_key = key;
+            cached_key.op_desc_ = result.impl->pd()->op_desc();
+            cached_key.attr_ = result.impl->pd()->attr();
+            // place a new entry to cache_list_ and update cache_mapper_
+            shard.cache_list_.emplace_front(
+                    cached_key, result.impl, memory_size, use_counter_++);
+            shard.cache_mapper_.insert(
+                    std::make_pair(cached_key, shard.cache_list_.begin()));
+            size_ += 1;
+            memory_size_ += memory_size;
+            added = true;
+        }
+    } catch (...) {
+        // the threads waiting for this primitive get the same exception,
+        // and the next request for the key creates the primitive again
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            shard.in_flight_.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    promise.set_value(result);
+    if (added) evict_excess();
+
+    impl = result.impl;
+    return result.status;
+}
+
+void lru_primitive_cache_t::erase(
+        shard_t &shard, cache_list_type::iterator it) {
+    size_ -= 1;
+    memory_size_ -= it->memory_size;
+    shard.cache_mapper_.erase(it->key);
+    shard.cache_list_.erase(it);
+}
+
+void lru_primitive_cache_t::evict_excess() {
+    while (is_over_capacity()) {
+        // find the shard with the least recently used tail; shards are
+        // locked one at a time, so the choice is approximate under
+        // concurrent updates
+        shard_t *victim = nullptr;
+        size_t victim_use = 0;
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            if (shard.cache_list_.empty()) continue;
+            size_t use = shard.cache_list_.back().last_use;
+            if (!victim || use < victim_use) {
+                victim = &shard;
+                victim_use = use;
+            }
+        }
+        if (!victim) return;
+
+        std::lock_guard<std::mutex> lock(victim->mutex_);
+        if (victim->cache_list_.empty() || !is_over_capacity()) continue;
+        // invalidate the least recently used entry
+        erase(*victim, std::prev(victim->cache_list_.end()));
+        evictions_++;
+    }
+}
+
+void lru_primitive_cache_t::set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    evict_excess();
+}
+
+void lru_primitive_cache_t::set_memory_capacity(size_t capacity) {
+    memory_capacity_ = capacity;
+    evict_excess();
+}
+
+void lru_primitive_cache_t::get_stats(primitive_cache_stats_t *stats) const {
+    stats->hits = hits_;
+    stats->misses = misses_;
+    stats->evictions = evictions_;
+    stats->size = size_;
+    stats->memory_size = memory_size_;
+}
+
+void lru_primitive_cache_t::flush() {
+    for (auto &shard : shards_) {
+        // release the implementations after unlocking the shard since their
+        // destruction may be expensive
+        cache_list_type list;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            for (auto &entry : shard.cache_list_) {
+                size_ -= 1;
+                memory_size_ -= entry.memory_size;
+            }
+            shard.cache_mapper_.clear();
+            list.swap(shard.cache_list_);
+        }
+    }
+}
+
+namespace {
+// Returns the size of the operation descriptor of the given kind or 0 if the
+// descriptor cannot be copied to lru_primitive_desc_cache_t::entry_t
+size_t get_op_desc_size(primitive_kind_t kind) {
+    using namespace primitive_kind;
+    switch (kind) {
+        case batch_normalization: return sizeof(batch_normalization_desc_t);
+        case binary: return sizeof(binary_desc_t);
+        case convolution:
+        case deconvolution: return sizeof(convolution_desc_t);
+        case eltwise: return sizeof(eltwise_desc_t);
+        case gemm: return sizeof(gemm_desc_t);
+        case inner_product: return sizeof(inner_product_desc_t);
+        case layer_normalization: return sizeof(layer_normalization_desc_t);
+        case lrn: return sizeof(lrn_desc_t);
+        case matmul: return sizeof(matmul_desc_t);
+        case pooling: return sizeof(pooling_desc_t);
+        case resampling: return sizeof(resampling_desc_t);
+        case rnn: return sizeof(rnn_desc_t);
+        case shuffle: return sizeof(shuffle_desc_t);
+        case logsoftmax:
+        case softmax: return sizeof(softmax_desc_t);
+        default: return 0;
+    }
+}
+} // namespace
+
+lru_primitive_desc_cache_t::entry_t::entry_t(
+        const key_type &key, size_t op_desc_size, const value_type &value)
+    : attr(*key.attr_), key(key), value(value) {
+    utils::array_copy(reinterpret_cast<char *>(&op_desc),
+            reinterpret_cast<const char *>(key.op_desc_), op_desc_size);
+    this->key.op_desc_ = reinterpret_cast<const op_desc_t *>(&op_desc);
+    this->key.attr_ = &attr;
+}
+
+bool lru_primitive_desc_cache_t::get(const key_type &key, value_type &value) {
+    if (primitive_cache().get_capacity() == 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_mapper_.find(key);
+    if (it == cache_mapper_.end()) return false;
+    // move 1 cache_list_ node to the front of the cache_list_
+    cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+    value = cache_list_.front().value;
+    return true;
+}
+
+void lru_primitive_desc_cache_t::add(
+        const key_type &key, const value_type &value) {
+    const size_t capacity = primitive_cache().get_capacity();
+    const size_t op_desc_size = get_op_desc_size(key.primitive_kind_);
+    if (capacity == 0 || op_desc_size == 0) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // another thread may have added the same primitive descriptor
+    if (cache_mapper_.count(key)) return;
+    while (!cache_list_.empty() && cache_list_.size() >= capacity) {
+        // invalidate the least recently used entry
+        cache_mapper_.erase(cache_list_.back().key);
+        cache_list_.pop_back();
+    }
+    // place a new entry to cache_list_ and update cache_mapper_
+    cache_list_.emplace_front(key, op_desc_size, value);
+    cache_mapper_.insert(
+            std::make_pair(cache_list_.front().key, cache_list_.begin()));
+}
+
+} // namespace impl
+} // namespace dnnl
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+
+dnnl_status_t dnnl_set_primitive_cache_capacity(int capacity) {
+#ifdef DNNL_ENABLE_PRIMITIVE_CACHE
+    if (capacity < 0) return invalid_arguments;
+    primitive_cache().set_capacity(capacity);
+    return success;
+#else
+    UNUSED(capacity);
+    return unimplemented;
+#endif
+}
+
+dnnl_status_t dnnl_get_primitive_cache_capacity(int *capacity) {
+    if (capacity == nullptr) return invalid_arguments;
+    *capacity = (int)primitive_cache().get_capacity();
+    return success;
+}
+
+dnnl_status_t dnnl_set_primitive_cache_memory_capacity(size_t capacity) {
+#ifdef DNNL_ENABLE_PRIMITIVE_CACHE
+    primitive_cache().set_memory_capacity(capacity);
+    return success;
+#else
+    UNUSED(capacity);
+    return unimplemented;
+#endif
+}
+
+dnnl_status_t dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats) {
+    if (stats == nullptr) return invalid_arguments;
+    primitive_cache().get_stats(stats);
+    return success;
+}
+
+dnnl_status_t dnnl_flush_primitive_cache() {
+    primitive_cache().flush();
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
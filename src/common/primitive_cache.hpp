@@ -17,12 +17,18 @@
 #ifndef PRIMITIVE_CACHE_HPP
 #define PRIMITIVE_CACHE_HPP
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "c_types_map.hpp"
 #include "dnnl.h"
+#include "primitive_attr.hpp"
 #include "primitive_hashing.hpp"
 #include "primitive_impl.hpp"
 #include "type_helpers.hpp"
@@ -33,47 +39,157 @@ namespace impl {
 struct primitive_cache_t : public c_compatible {
     using key_type = primitive_hashing::key_t;
     using value_type = std::shared_ptr<primitive_impl_t>;
+    // Creates and initializes a primitive implementation on a cache miss
+    using create_func_type = std::function<status_t(value_type &)>;
 
-    virtual void add(const key_type &key, const value_type &impl) = 0;
-    virtual value_type get(const key_type &key) = 0;
+    // Returns the implementation for the key, calling `create` on a miss.
+    // The cache is not locked while `create` runs: only the threads that
+    // request the same key wait for its result.
+    virtual status_t get_or_create(const key_type &key, value_type &impl,
+            bool &is_hit, const create_func_type &create)
+            = 0;
+
+    virtual void set_capacity(size_t capacity) = 0;
+    virtual size_t get_capacity() const = 0;
+    // Limits the estimated memory held by the cached implementations, 0 means
+    // no limit
+    virtual void set_memory_capacity(size_t capacity) = 0;
+    virtual void get_stats(primitive_cache_stats_t *stats) const = 0;
+    virtual void flush() = 0;
 
     virtual ~primitive_cache_t() = default;
 };
 
-// The cache uses LRU replacement policy
+// The cache is split into shards selected by the key hash. Each shard has
+// its own lock and keeps its entries in LRU order. The capacities are
+// global: the least recently used entry among the shard tails is evicted
+// when a capacity is exceeded.
 struct lru_primitive_cache_t : public primitive_cache_t {
-    lru_primitive_cache_t(size_t capacity) : capacity_(capacity) {}
-
-    virtual void add(const key_type &key, const value_type &impl) override {
-        // cache is disabled
-        if (capacity_ == 0) return;
-
-        if (cache_list_.size() >= capacity_) {
-            // invalidate the least recently used entry
-            cache_mapper_.erase(cache_list_.back().first);
-            cache_list_.pop_back();
-        }
-        // place a new entry to cache_list_ and update cache_mapper_
-        cache_list_.emplace_front(key, impl);
-        cache_mapper_.insert(std::make_pair(key, cache_list_.begin()));
-    }
+    lru_primitive_cache_t(size_t capacity);
+
+    virtual status_t get_or_create(const key_type &key, value_type &impl,
+            bool &is_hit, const create_func_type &create) override;
+
+    virtual void set_capacity(size_t capacity) override;
+    virtual size_t get_capacity() const override { return capacity_; }
+    virtual void set_memory_capacity(size_t capacity) override;
+    virtual void get_stats(primitive_cache_stats_t *stats) const override;
+    virtual void flush() override;
+
+private:
+    struct result_t {
+        status_t status;
+        value_type impl;
+    };
 
-    virtual value_type get(const key_type &key) override {
-        // cache is disabled
-        if (capacity_ == 0) return nullptr;
+    struct entry_t {
+        entry_t(const key_type &key, const value_type &impl,
+                size_t memory_size, size_t last_use)
+            : key(key)
+            , impl(impl)
+            , memory_size(memory_size)
+            , last_use(last_use) {}
+        key_type key;
+        value_type impl;
+        size_t memory_size;
+        size_t last_use;
+    };
 
-        auto it = cache_mapper_.find(key);
-        if (it == cache_mapper_.end()) { return nullptr; }
-        // move 1 cache_list_ node to the front of the cache_list_
-        cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
-        return cache_list_.front().second;
+    using cache_list_type = std::list<entry_t>;
+
+    struct shard_t {
+        std::mutex mutex_;
+        cache_list_type cache_list_;
+        std::unordered_map<key_type, cache_list_type::iterator> cache_mapper_;
+        // Keys in this map point to the descriptors of the creating thread,
+        // so entries must be removed before the creator returns.
+        std::unordered_map<key_type, std::shared_future<result_t>> in_flight_;
+    };
+
+    shard_t &get_shard(const key_type &key) {
+        return shards_[std::hash<key_type> {}(key) % max_shards];
+    }
+
+    bool is_over_capacity() const {
+        return size_ > capacity_
+                || (memory_capacity_ > 0 && memory_size_ > memory_capacity_);
     }
+    void evict_excess();
+    // Removes an entry; the shard must be locked by the caller
+    void erase(shard_t &shard, cache_list_type::iterator it);
+
+    static constexpr size_t max_shards = 16;
+    shard_t shards_[max_shards];
+
+    std::atomic<size_t> capacity_;
+    std::atomic<size_t> memory_capacity_;
+    // Monotonic counter that orders the uses of entries across shards
+    std::atomic<size_t> use_counter_;
+
+    std::atomic<size_t> size_;
+    std::atomic<size_t> memory_size_;
+    std::atomic<size_t> hits_;
+    std::atomic<size_t> misses_;
+    std::atomic<size_t> evictions_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(lru_primitive_cache_t);
+};
+
+// Returns the primitive cache shared by all the engines of the process
+primitive_cache_t &primitive_cache();
+
+// Caches the primitive descriptor that primitive_desc_iterator_t selects first
+// for an op_desc and attributes along with its index in the engine
+// implementation list, so that the list is not walked again on the next
+// creation. The cache belongs to an engine and uses LRU replacement policy;
+// its capacity follows the capacity of the primitive cache.
+struct lru_primitive_desc_cache_t : public c_compatible {
+    using key_type = primitive_hashing::key_t;
+    struct value_type {
+        int impl_idx;
+        std::shared_ptr<const primitive_desc_t> pd;
+    };
+
+    lru_primitive_desc_cache_t() = default;
+
+    bool get(const key_type &key, value_type &value);
+    void add(const key_type &key, const value_type &value);
 
 private:
-    size_t capacity_;
-    using cache_list_type = std::list<std::pair<key_type, value_type>>;
+    // The key of an entry points to the copies of the operation descriptor and
+    // the attributes the entry holds, so entries are never copied or moved
+    struct entry_t {
+        entry_t(const key_type &key, size_t op_desc_size,
+                const value_type &value);
+        union {
+            batch_normalization_desc_t batch_normalization;
+            binary_desc_t binary;
+            convolution_desc_t convolution;
+            eltwise_desc_t eltwise;
+            gemm_desc_t gemm;
+            inner_product_desc_t inner_product;
+            layer_normalization_desc_t layer_normalization;
+            lrn_desc_t lrn;
+            matmul_desc_t matmul;
+            pooling_desc_t pooling;
+            resampling_desc_t resampling;
+            rnn_desc_t rnn;
+            shuffle_desc_t shuffle;
+            softmax_desc_t softmax;
+        } op_desc;
+        primitive_attr_t attr;
+        key_type key;
+        value_type value;
+
+        DNNL_DISALLOW_COPY_AND_ASSIGN(entry_t);
+    };
+    using cache_list_type = std::list<entry_t>;
+
+    std::mutex mutex_;
     cache_list_type cache_list_;
     std::unordered_map<key_type, cache_list_type::iterator> cache_mapper_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(lru_primitive_desc_cache_t);
 };
 
 } // namespace impl
@@ -51,6 +51,35 @@ struct dnnl_primitive_desc : public dnnl::impl::c_compatible {
     dnnl::impl::engine_t *engine() const { return engine_; }
     dnnl::impl::primitive_kind_t kind() const { return kind_; }
 
+    // Returns the index of the binary post-op whose second source is passed
+    // in the argument, or -1 for other arguments
+    int binary_post_op_index(int arg) const {
+        const auto &po = attr_.post_ops_;
+        for (int idx = 0; idx < po.len_; ++idx)
+            if (po.entry_[idx].is_binary()
+                    && arg == (DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx)
+                               | DNNL_ARG_SRC_1))
+                return idx;
+        return -1;
+    }
+
+    // Returns the index of the depthwise convolution post-op whose weights
+    // or bias are passed in the argument, or -1 for other arguments
+    int depthwise_conv_post_op_index(int arg) const {
+        const auto &po = attr_.post_ops_;
+        const int idx = po.find(dnnl::impl::primitive_kind::convolution);
+        if (idx < 0) return -1;
+        const bool with_bias = po.entry_[idx].depthwise_conv.bias_dt
+                != dnnl::impl::data_type::undef;
+        if (arg == (DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx) | DNNL_ARG_WEIGHTS)
+                || (with_bias
+                        && arg
+                                == (DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx)
+                                        | DNNL_ARG_BIAS)))
+            return idx;
+        return -1;
+    }
+
     virtual void init_info() {}
     const char *info() const { return info_; }
 
@@ -73,12 +102,17 @@ struct dnnl_primitive_desc : public dnnl::impl::c_compatible {
         if ((arg & DNNL_ARG_ATTR_ZERO_POINTS)
                 && !attr()->zero_points_.defined(arg))
             return arg_usage_t::input;
+        if (binary_post_op_index(arg) >= 0) return arg_usage_t::input;
+        if (depthwise_conv_post_op_index(arg) >= 0) return arg_usage_t::input;
         if (arg == DNNL_ARG_SCRATCHPAD && !is_zero_md(scratchpad_md()))
             return arg_usage_t::output;
         return arg_usage_t::unused;
     }
 
     virtual const dnnl::impl::memory_desc_t *arg_md(int arg) const {
+        const int po_idx = binary_post_op_index(arg);
+        if (po_idx >= 0)
+            return &attr()->post_ops_.entry_[po_idx].binary.src1_desc;
         switch (arg) {
             case DNNL_ARG_WORKSPACE: return workspace_md(0);
             case DNNL_ARG_SCRATCHPAD: return scratchpad_md(0);
@@ -44,7 +44,9 @@ status_t cvt_primtive_args(const primitive_desc_t *pd, int nargs,
                 args[arg] = {mem, true};
                 n_inputs++;
                 extra_inputs += (arg == DNNL_ARG_ATTR_OUTPUT_SCALES)
-                        || (arg & DNNL_ARG_ATTR_ZERO_POINTS);
+                        || (arg & DNNL_ARG_ATTR_ZERO_POINTS)
+                        || pd->binary_post_op_index(arg) >= 0
+                        || pd->depthwise_conv_post_op_index(arg) >= 0;
                 break;
             case primitive_desc_t::arg_usage_t::output:
                 if (args.count(arg) != 0) return invalid_arguments;
@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include "engine.hpp"
 #include "primitive_desc.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
@@ -29,6 +30,12 @@ namespace primitive_hashing {
 
 key_t::key_t(const primitive_desc_t *pd, int impl_nthr)
     : primitive_kind_(pd->kind())
+    , engine_kind_(pd->engine()->kind())
+    , runtime_kind_(pd->engine()->runtime_kind())
+    // CPU primitives do not depend on a particular engine and are shared
+    // between all the CPU engines, while GPU kernels are bound to the
+    // context of the engine that created them
+    , engine_id_(engine_kind_ == engine_kind::cpu ? nullptr : pd->engine())
     , op_desc_(pd->op_desc())
     , attr_(pd->attr())
     , impl_id_(pd->impl_id())
@@ -36,6 +43,17 @@ key_t::key_t(const primitive_desc_t *pd, int impl_nthr)
     init_mds(pd);
 }
 
+key_t::key_t(engine_t *engine, const op_desc_t *op_desc,
+        const primitive_attr_t *attr, int impl_nthr)
+    : primitive_kind_(op_desc->kind)
+    , engine_kind_(engine->kind())
+    , runtime_kind_(engine->runtime_kind())
+    , engine_id_(engine_kind_ == engine_kind::cpu ? nullptr : engine)
+    , op_desc_(op_desc)
+    , attr_(attr)
+    , impl_id_(typeid(void))
+    , impl_nthr_(impl_nthr) {}
+
 void key_t::init_mds(const primitive_desc_t *pd) {
     // Put only **relevant** memory descriptors to the list that might
     // affect the equality. The current cases are:
@@ -58,6 +76,9 @@ void key_t::init_mds(const primitive_desc_t *pd) {
         case primitive_kind::concat: {
             break;
         }
+        case primitive_kind::conv_stack: {
+            break;
+        }
         case primitive_kind::convolution: {
             break;
         }
@@ -124,7 +145,10 @@ bool key_t::operator==(const key_t &rhs) const {
     DNNL_SHORT_CIRCUIT_SELF_COMPARISON(rhs);
 
     bool ret = true && primitive_kind_ == rhs.primitive_kind_
-            && impl_id_ == rhs.impl_id_ && impl_nthr_ == rhs.impl_nthr_
+            && engine_kind_ == rhs.engine_kind_
+            && runtime_kind_ == rhs.runtime_kind_
+            && engine_id_ == rhs.engine_id_ && impl_id_ == rhs.impl_id_
+            && impl_nthr_ == rhs.impl_nthr_
             && mds.size() == rhs.mds.size() && *attr_ == *rhs.attr_;
 
     if (!ret) return false;
@@ -141,6 +165,9 @@ bool key_t::operator==(const key_t &rhs) const {
         case primitive_kind::concat:
             ret = cast_and_compare<concat_desc_t>(op_desc_, rhs.op_desc_);
             break;
+        case primitive_kind::conv_stack:
+            ret = cast_and_compare<conv_stack_desc_t>(op_desc_, rhs.op_desc_);
+            break;
         case primitive_kind::convolution:
             ret = cast_and_compare<convolution_desc_t>(op_desc_, rhs.op_desc_);
             break;
@@ -177,6 +204,9 @@ bool key_t::operator==(const key_t &rhs) const {
         case primitive_kind::reorder:
             ret = cast_and_compare<reorder_desc_t>(op_desc_, rhs.op_desc_);
             break;
+        case primitive_kind::resampling:
+            ret = cast_and_compare<resampling_desc_t>(op_desc_, rhs.op_desc_);
+            break;
         case primitive_kind::rnn:
             ret = cast_and_compare<rnn_desc_t>(op_desc_, rhs.op_desc_);
             break;
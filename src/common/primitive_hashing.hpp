@@ -29,10 +29,18 @@ namespace primitive_hashing {
 
 struct key_t {
     key_t(const primitive_desc_t *pd, int impl_nthr);
+    // Key for a primitive descriptor that is yet to be created
+    key_t(engine_t *engine, const op_desc_t *op_desc,
+            const primitive_attr_t *attr, int impl_nthr);
 
     bool operator==(const key_t &rhs) const;
 
     dnnl_primitive_kind_t primitive_kind_;
+    engine_kind_t engine_kind_;
+    runtime_kind_t runtime_kind_;
+    // Identifies the engine for the engine kinds whose primitives cannot be
+    // shared between engines, nullptr otherwise
+    const engine_t *engine_id_;
     const op_desc_t *op_desc_;
     const primitive_attr_t *attr_;
     std::type_index impl_id_;
@@ -107,6 +115,20 @@ static inline size_t get_attr_hash(const primitive_attr_t *attr) {
             case primitive_kind::sum:
                 seed = hash_combine(seed, entry.sum.scale);
                 break;
+            case primitive_kind::binary:
+                seed = hash_combine(
+                        seed, static_cast<size_t>(entry.binary.alg));
+                seed = hash_combine(seed, get_md_hash(entry.binary.src1_desc));
+                break;
+            case primitive_kind::convolution:
+                seed = hash_combine(seed, entry.depthwise_conv.stride);
+                seed = hash_combine(seed,
+                        static_cast<size_t>(entry.depthwise_conv.wei_dt));
+                seed = hash_combine(seed,
+                        static_cast<size_t>(entry.depthwise_conv.bias_dt));
+                seed = hash_combine(seed,
+                        static_cast<size_t>(entry.depthwise_conv.dst_dt));
+                break;
             default: assert(!"unknown post_op");
         }
     }
@@ -190,6 +212,11 @@ static inline size_t get_md_hash(const memory_desc_t &md) {
             seed = hash_combine(seed, md.extra.compensation_mask);
         }
 
+        if (md.extra.flags
+                & dnnl_memory_extra_flag_compensation_conv_asymmetric_src) {
+            seed = hash_combine(seed, md.extra.asymm_compensation_mask);
+        }
+
         if (md.extra.flags & dnnl_memory_extra_flag_scale_adjust) {
             seed = hash_combine(seed, md.extra.scale_adjust);
         }
@@ -286,6 +313,29 @@ size_t get_desc_hash<convolution_desc_t>(const op_desc_t *op_desc) {
     return seed;
 }
 
+// Convolution stack
+template <>
+size_t get_desc_hash<conv_stack_desc_t>(const op_desc_t *op_desc) {
+    const auto *desc = reinterpret_cast<const conv_stack_desc_t *>(op_desc);
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc->primitive_kind));
+    // N
+    seed = hash_combine(seed, desc->n);
+    // Convolutions and their eltwise post-ops
+    for (const auto &l : desc->layers) {
+        seed = hash_combine(seed,
+                get_desc_hash<convolution_desc_t>(
+                        op_desc_t::convert_from_c(&l.conv_desc)));
+        seed = hash_combine(seed, static_cast<size_t>(l.eltwise_alg));
+        seed = hash_combine(seed, l.eltwise_scale);
+        seed = hash_combine(seed, l.eltwise_alpha);
+        seed = hash_combine(seed, l.eltwise_beta);
+    }
+    // Combined hash for convolution stack desc
+    return seed;
+}
+
 // Eltwise
 template <>
 size_t get_desc_hash<eltwise_desc_t>(const op_desc_t *op_desc) {
@@ -495,8 +545,8 @@ size_t get_desc_hash<rnn_desc_t>(const op_desc_t *op_desc) {
     seed = hash_combine(seed, get_md_hash(desc->dst_layer_desc));
     seed = hash_combine(seed, get_md_hash(desc->dst_iter_desc));
     seed = hash_combine(seed, get_md_hash(desc->dst_iter_c_desc));
-    seed = hash_combine(seed, get_md_hash(desc->placeholder_desc));
-    seed = hash_combine(seed, get_md_hash(desc->placeholder2_desc));
+    seed = hash_combine(seed, get_md_hash(desc->weights_peephole_desc));
+    seed = hash_combine(seed, get_md_hash(desc->weights_projection_desc));
     seed = hash_combine(seed, get_md_hash(desc->diff_src_layer_desc));
     seed = hash_combine(seed, get_md_hash(desc->diff_src_iter_desc));
     seed = hash_combine(seed, get_md_hash(desc->diff_src_iter_c_desc));
@@ -506,8 +556,8 @@ size_t get_desc_hash<rnn_desc_t>(const op_desc_t *op_desc) {
     seed = hash_combine(seed, get_md_hash(desc->diff_dst_layer_desc));
     seed = hash_combine(seed, get_md_hash(desc->diff_dst_iter_desc));
     seed = hash_combine(seed, get_md_hash(desc->diff_dst_iter_c_desc));
-    seed = hash_combine(seed, get_md_hash(desc->diff_placeholder_desc));
-    seed = hash_combine(seed, get_md_hash(desc->diff_placeholder2_desc));
+    seed = hash_combine(seed, get_md_hash(desc->diff_weights_peephole_desc));
+    seed = hash_combine(seed, get_md_hash(desc->diff_weights_projection_desc));
     // Flags
     seed = hash_combine(seed, desc->flags);
     // Activation kind
@@ -590,6 +640,10 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
         // Compute hash for primitive_kind_, attr_, impl_id_ and impl_nthr_
         seed = hash_combine(seed,
                 hash_combine(0, static_cast<size_t>(key.primitive_kind_)));
+        // Compute hash for engine_kind_, runtime_kind_ and engine_id_
+        seed = hash_combine(seed, static_cast<size_t>(key.engine_kind_));
+        seed = hash_combine(seed, static_cast<size_t>(key.runtime_kind_));
+        seed = hash_combine(seed, key.engine_id_);
         seed = hash_combine(seed, get_attr_hash(key.attr_));
         seed = hash_combine(seed, hash_combine(0, key.impl_id_));
         seed = hash_combine(seed, hash_combine(0, key.impl_nthr_));
@@ -608,6 +662,10 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
                 seed = hash_combine(
                         seed, get_desc_hash<concat_desc_t>(key.op_desc_));
                 break;
+            case primitive_kind::conv_stack:
+                seed = hash_combine(
+                        seed, get_desc_hash<conv_stack_desc_t>(key.op_desc_));
+                break;
             case primitive_kind::convolution:
                 seed = hash_combine(
                         seed, get_desc_hash<convolution_desc_t>(key.op_desc_));
@@ -29,8 +29,8 @@ namespace dnnl {
 namespace impl {
 
 struct primitive_impl_t : public c_compatible {
-    primitive_impl_t(const primitive_desc_t *pd) : pd_(pd->clone()) {}
-    virtual ~primitive_impl_t() { delete pd_; }
+    primitive_impl_t(const primitive_desc_t *pd);
+    virtual ~primitive_impl_t();
 
     virtual status_t init() { return status::success; }
     engine_t *engine() const { return pd_->engine(); }
@@ -23,10 +23,68 @@
 #include "primitive_desc.hpp"
 #include "primitive_iterator.hpp"
 #include "type_helpers.hpp"
+#include "verbose.hpp"
 
 using namespace dnnl::impl;
 using namespace dnnl::impl::status;
 
+namespace {
+// Advances the iterator to the first suitable implementation and reports the
+// primitive descriptor creation time at verbose level 2.
+void first_impl(primitive_desc_iterator_t &it) {
+    double ms = get_msec();
+    ++it;
+    if (it == it.end() || get_verbose() < 2) return;
+    ms = get_msec() - ms;
+#ifdef DNNL_ENABLE_PRIMITIVE_CACHE
+    const char *str = it.is_cache_hit() ? "dnnl_verbose,create_pd:cache_hit"
+                                        : "dnnl_verbose,create_pd:cache_miss";
+#else
+    const char *str = "dnnl_verbose,create_pd";
+#endif
+    printf("%s,%s,%g\n", str, it.pd()->info(), ms);
+    fflush(0);
+}
+} // namespace
+
+primitive_desc_iterator_t &dnnl_primitive_desc_iterator::operator++() {
+    if (pd_) {
+        delete pd_;
+        pd_ = nullptr;
+    }
+    is_cache_hit_ = false;
+
+    // The first suitable implementation is looked up in the engine's cache of
+    // primitive descriptors to avoid walking the implementation list.
+    // Forward hints are not cached since primitive descriptors keep pointers
+    // to them.
+    const bool use_cache = idx_ == -1 && hint_fwd_pd_ == nullptr;
+    primitive_hashing::key_t key(
+            engine_, op_desc_, &attr_, engine_->dnnl_get_max_threads());
+    if (use_cache) {
+        lru_primitive_desc_cache_t::value_type cached;
+        if (engine_->primitive_desc_cache().get(key, cached)) {
+            idx_ = cached.impl_idx;
+            pd_ = cached.pd->clone();
+            is_cache_hit_ = pd_ != nullptr;
+            if (pd_) return *this;
+        }
+    }
+
+    while (++idx_ != last_idx_) {
+        auto s = impl_list_[idx_](
+                &pd_, op_desc_, &attr_, engine_, hint_fwd_pd_);
+        if (s == success) { break; }
+    }
+
+    if (use_cache && idx_ != last_idx_ && pd_ != nullptr) {
+        lru_primitive_desc_cache_t::value_type value {
+                idx_, std::shared_ptr<const primitive_desc_t>(pd_->clone())};
+        if (value.pd) engine_->primitive_desc_cache().add(key, value);
+    }
+    return *this;
+}
+
 status_t dnnl_primitive_desc_iterator_create(
         primitive_desc_iterator_t **iterator, const_c_op_desc_t c_op_desc,
         const primitive_attr_t *attr, engine_t *engine,
@@ -37,7 +95,7 @@ status_t dnnl_primitive_desc_iterator_create(
     auto it = new primitive_desc_iterator_t(engine, op_desc, attr, hint_fwd_pd);
     if (it == nullptr) return out_of_memory;
 
-    ++(*it);
+    first_impl(*it);
     if (*it == it->end()) {
         delete it;
         return unimplemented;
@@ -82,7 +140,7 @@ status_t dnnl_primitive_desc_create(primitive_desc_t **primitive_desc,
         return invalid_arguments;
 
     dnnl_primitive_desc_iterator it(engine, op_desc, attr, hint_fwd_pd);
-    ++it;
+    first_impl(it);
     if (it == it.end()) return unimplemented;
 
     return safe_ptr_assign<primitive_desc_t>(*primitive_desc, *it);
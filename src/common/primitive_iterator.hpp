@@ -57,18 +57,13 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
         return dnnl_primitive_desc_iterator(engine_, last_idx_);
     }
 
-    dnnl::impl::primitive_desc_iterator_t &operator++() {
-        if (pd_) {
-            delete pd_;
-            pd_ = nullptr;
-        }
-        while (++idx_ != last_idx_) {
-            auto s = impl_list_[idx_](
-                    &pd_, op_desc_, &attr_, engine_, hint_fwd_pd_);
-            if (s == dnnl::impl::status::success) { break; }
-        }
-        return *this;
-    }
+    dnnl::impl::primitive_desc_iterator_t &operator++();
+
+    /** returns true if the current primitive descriptor was taken from the
+     * engine's primitive descriptor cache */
+    bool is_cache_hit() const { return is_cache_hit_; }
+
+    const dnnl::impl::primitive_desc_t *pd() const { return pd_; }
 
     dnnl::impl::primitive_desc_t *operator*() const {
         if (*this == end() || pd_ == nullptr) return nullptr;
@@ -84,6 +79,7 @@ protected:
     const dnnl::impl::primitive_desc_t *hint_fwd_pd_;
     const pd_create_f *impl_list_;
     int last_idx_;
+    bool is_cache_hit_ = false;
 
 private:
     dnnl_primitive_desc_iterator(dnnl::impl::engine_t *engine, int last_idx)
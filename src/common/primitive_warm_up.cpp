@@ -0,0 +1,101 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "dnnl.h"
+
+#include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
+#include "engine.hpp"
+#include "nstl.hpp"
+#include "primitive.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+#include "verbose.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+
+namespace {
+status_t create_primitive(const op_desc_t *op_desc,
+        const primitive_attr_t *attr, engine_t *engine) {
+    primitive_desc_t *pd = nullptr;
+    status_t status
+            = dnnl_primitive_desc_create(&pd, op_desc, attr, engine, nullptr);
+    if (status != success) return status;
+
+    primitive_t *p = nullptr;
+    status = dnnl_primitive_create(&p, pd);
+    if (status == success) dnnl_primitive_destroy(p);
+    dnnl_primitive_desc_destroy(pd);
+    return status;
+}
+} // namespace
+
+status_t dnnl_primitive_cache_warm_up(engine_t *engine, int count,
+        const const_c_op_desc_t *op_descs, const primitive_attr_t *const *attrs,
+        int nthreads, status_t *statuses, double *times_ms) {
+    if (utils::any_null(engine, op_descs) || count < 0 || nthreads < 0)
+        return invalid_arguments;
+    if (count == 0) return success;
+
+    if (nthreads == 0) nthreads = (int)std::thread::hardware_concurrency();
+    nthreads = nstl::max(1, nstl::min(nthreads, count));
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // The primitives depend on the number of threads they are created for,
+    // which is not inherited by the threads spawned below
+    const int max_threads = dnnl_get_max_threads();
+#endif
+
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        omp_set_num_threads(max_threads);
+#endif
+        for (int i = next++; i < count; i = next++) {
+            const op_desc_t *op_desc = (const op_desc_t *)op_descs[i];
+            const primitive_attr_t *attr = attrs ? attrs[i] : nullptr;
+
+            double ms = get_msec();
+            status_t status = op_desc ? create_primitive(op_desc, attr, engine)
+                                      : invalid_arguments;
+            ms = get_msec() - ms;
+
+            if (statuses) statuses[i] = status;
+            if (times_ms) times_ms[i] = ms;
+        }
+    };
+
+    // the calling thread creates primitives as well, so the work is done
+    // even if no threads can be spawned
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nthreads; t++) {
+        try {
+            threads.emplace_back(worker);
+        } catch (...) { break; }
+    }
+    worker();
+    for (auto &t : threads)
+        t.join();
+
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -74,8 +74,11 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *src_iter_c_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc,
         const memory_desc_t *dst_iter_c_desc) {
     using namespace data_type;
     data_type_t src_layer_dt = src_layer_desc->data_type;
@@ -85,7 +88,6 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
 
     bool is_forward = !(prop_kind == prop_kind::backward);
     bool is_inference = prop_kind == prop_kind::forward_inference;
-    bool is_lstm = cell_kind == dnnl_vanilla_lstm;
 
     bool cell_state_check
             = IMPLICATION(!is_zero_md(src_iter_c_desc),
@@ -93,6 +95,14 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
             && IMPLICATION(!is_zero_md(dst_iter_c_desc),
                     one_of(dst_iter_c_desc->data_type, f32, f16));
 
+    // the peephole weights are applied to the cell states and the projection
+    // weights are applied to the hidden states like the other weights
+    bool extra_weights_check
+            = IMPLICATION(!is_zero_md(weights_peephole_desc),
+                      weights_peephole_desc->data_type == f32)
+            && IMPLICATION(!is_zero_md(weights_projection_desc),
+                    weights_projection_desc->data_type == weights_layer_dt);
+
     bool is_f32 = everyone_is(f32, src_layer_dt, dst_layer_dt, weights_iter_dt,
                           weights_layer_dt)
             && IMPLICATION(
@@ -118,7 +128,7 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
                     !is_zero_md(dst_iter_desc), dst_iter_desc->data_type == f16)
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f16);
 
-    bool is_u8u8u8 = is_inference && is_lstm && src_layer_dt == u8
+    bool is_u8u8u8 = is_inference && src_layer_dt == u8
             && IMPLICATION(
                     !is_zero_md(src_iter_desc), src_iter_desc->data_type == u8)
             && IMPLICATION(!is_zero_md(src_iter_c_desc),
@@ -131,7 +141,7 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
             && everyone_is(s8, weights_iter_dt, weights_layer_dt)
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f32);
 
-    bool is_f32u8f32 = is_inference && is_lstm && src_layer_dt == u8
+    bool is_f32u8f32 = is_inference && src_layer_dt == u8
             && IMPLICATION(
                     !is_zero_md(src_iter_desc), src_iter_desc->data_type == f32)
             && IMPLICATION(
@@ -140,7 +150,7 @@ status_t check_data_type_consistency_fwd(dnnl_alg_kind_t cell_kind,
             && everyone_is(s8, weights_iter_dt, weights_layer_dt)
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f32);
 
-    return cell_state_check
+    return cell_state_check && extra_weights_check
                     && (is_f32 || is_bf16 || is_f16 || is_u8u8u8 || is_f32u8f32)
             ? success
             : unimplemented;
@@ -181,12 +191,15 @@ status_t check_data_type_consistency_bwd(dnnl_alg_kind_t cell_kind,
 
 status_t check_dim_consistency(dnnl_alg_kind_t cell_kind,
         rnn_direction_t direction, dim_t L, dim_t D, dim_t T, dim_t N, dim_t G,
-        dim_t SLC, dim_t SIC, dim_t DLC, dim_t DIC,
+        dim_t SLC, dim_t SIC, dim_t DLC, dim_t DHC, dim_t DIC,
         const memory_desc_t *src_layer_desc, const memory_desc_t *src_iter_desc,
         const memory_desc_t *src_iter_c_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc,
         const memory_desc_t *dst_iter_c_desc) {
     bool args_ok;
 
@@ -198,6 +211,33 @@ status_t check_dim_consistency(dnnl_alg_kind_t cell_kind,
     if (!args_ok) return invalid_arguments;
     dim_t extra_bias = cell_kind == alg_kind::lbr_gru;
 
+    // * peephole and projection are LSTM only
+    const bool with_peephole = !is_zero_md(weights_peephole_desc);
+    const bool with_projection = !is_zero_md(weights_projection_desc);
+    args_ok = true
+            && IMPLICATION(with_peephole || with_projection,
+                    cell_kind == alg_kind::vanilla_lstm)
+            && IMPLICATION(!with_projection, DHC == DIC);
+    if (!args_ok) return invalid_arguments;
+
+    // * peephole weights are ldgo with the input, forget and output gates
+    args_ok = IMPLICATION(with_peephole,
+            weights_peephole_desc->ndims == 4
+                    && L == weights_peephole_desc->dims[0]
+                    && D == weights_peephole_desc->dims[1]
+                    && 3 == weights_peephole_desc->dims[2]
+                    && DHC == weights_peephole_desc->dims[3]);
+    if (!args_ok) return invalid_arguments;
+
+    // * projection weights are ldio
+    args_ok = IMPLICATION(with_projection,
+            weights_projection_desc->ndims == 4
+                    && L == weights_projection_desc->dims[0]
+                    && D == weights_projection_desc->dims[1]
+                    && DHC == weights_projection_desc->dims[2]
+                    && DIC == weights_projection_desc->dims[3]);
+    if (!args_ok) return invalid_arguments;
+
     // * on num layers
     args_ok = true && L == weights_layer_desc->dims[0]
             && L == weights_iter_desc->dims[0]
@@ -269,16 +309,20 @@ status_t check_dim_consistency(dnnl_alg_kind_t cell_kind,
             && DLC == dst_layer_desc->dims[2];
     if (!args_ok) return invalid_arguments;
 
-    // * on dic
-    args_ok = true && DIC == weights_layer_desc->dims[4]
-            && DIC == weights_iter_desc->dims[4]
-            && IMPLICATION(!is_zero_md(bias_desc), DIC == bias_desc->dims[3])
+    // * on dhc: the gates and the cell states
+    args_ok = true && DHC == weights_layer_desc->dims[4]
+            && DHC == weights_iter_desc->dims[4]
+            && IMPLICATION(!is_zero_md(bias_desc), DHC == bias_desc->dims[3])
             && IMPLICATION(!is_zero_md(src_iter_c_desc),
-                    DIC == src_iter_c_desc->dims[3])
-            && IMPLICATION(
-                    !is_zero_md(dst_iter_desc), DIC == dst_iter_desc->dims[3])
+                    DHC == src_iter_c_desc->dims[3])
             && IMPLICATION(!is_zero_md(dst_iter_c_desc),
-                    DIC == dst_iter_c_desc->dims[3]);
+                    DHC == dst_iter_c_desc->dims[3]);
+    if (!args_ok) return invalid_arguments;
+
+    // * on dic: the hidden states, projected if a projection is used
+    args_ok = true
+            && IMPLICATION(
+                    !is_zero_md(dst_iter_desc), DIC == dst_iter_desc->dims[3]);
     if (!args_ok) return invalid_arguments;
 
     // * unrolling/fusion conditions
@@ -295,8 +339,11 @@ status_t rnn_common_fwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *src_iter_c_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc,
         const memory_desc_t *dst_iter_c_desc, unsigned flags,
         dnnl_alg_kind_t activation = dnnl_alg_kind_undef, float alpha = 0.0f,
         float beta = 0.0f) {
@@ -307,6 +354,10 @@ status_t rnn_common_fwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
                     dnnl_vanilla_gru, dnnl_lbr_gru);
     if (!args_ok) return invalid_arguments;
 
+    // check that only known flags have been passed
+    if (flags & ~(unsigned)dnnl_rnn_flags_variable_length)
+        return invalid_arguments;
+
     // check that all mandatory parameters are non-null
     args_ok = args_ok
             && !any_null(src_layer_desc, weights_layer_desc, weights_iter_desc,
@@ -334,6 +385,10 @@ status_t rnn_common_fwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
                        .has_runtime_dims_or_strides()
             || memory_desc_wrapper(weights_iter_desc)
                        .has_runtime_dims_or_strides()
+            || memory_desc_wrapper(weights_peephole_desc)
+                       .has_runtime_dims_or_strides()
+            || memory_desc_wrapper(weights_projection_desc)
+                       .has_runtime_dims_or_strides()
             || memory_desc_wrapper(bias_desc).has_runtime_dims_or_strides()
             || memory_desc_wrapper(dst_layer_desc).has_runtime_dims_or_strides()
             || memory_desc_wrapper(dst_iter_desc).has_runtime_dims_or_strides()
@@ -353,17 +408,21 @@ status_t rnn_common_fwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
     dim_t SLC = src_layer_desc->dims[2];
     dim_t SIC = weights_iter_desc->dims[2];
     dim_t DLC = dst_layer_desc->dims[2];
-    dim_t DIC = weights_layer_desc->dims[4];
+    dim_t DHC = weights_layer_desc->dims[4];
+    dim_t DIC = is_zero_md(weights_projection_desc)
+            ? DHC
+            : weights_projection_desc->dims[3];
 
     CHECK(check_dim_consistency(cell_kind, direction, L, D, T, N, G, SLC, SIC,
-            DLC, DIC, src_layer_desc, src_iter_desc, src_iter_c_desc,
-            weights_layer_desc, weights_iter_desc, bias_desc, dst_layer_desc,
-            dst_iter_desc, dst_iter_c_desc));
+            DLC, DHC, DIC, src_layer_desc, src_iter_desc, src_iter_c_desc,
+            weights_layer_desc, weights_iter_desc, weights_peephole_desc,
+            weights_projection_desc, bias_desc, dst_layer_desc, dst_iter_desc,
+            dst_iter_c_desc));
 
     CHECK(check_data_type_consistency_fwd(cell_kind, prop_kind, src_layer_desc,
             src_iter_desc, src_iter_c_desc, weights_layer_desc,
-            weights_iter_desc, bias_desc, dst_layer_desc, dst_iter_desc,
-            dst_iter_c_desc));
+            weights_iter_desc, weights_peephole_desc, weights_projection_desc,
+            bias_desc, dst_layer_desc, dst_iter_desc, dst_iter_c_desc));
 
     // Create the descriptor
     dnnl_rnn_desc_t rd = zero_rnn_desc();
@@ -377,6 +436,8 @@ status_t rnn_common_fwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
     rd.src_iter_c_desc = copy_maybe_null(src_iter_c_desc);
     rd.weights_layer_desc = copy_maybe_null(weights_layer_desc);
     rd.weights_iter_desc = copy_maybe_null(weights_iter_desc);
+    rd.weights_peephole_desc = copy_maybe_null(weights_peephole_desc);
+    rd.weights_projection_desc = copy_maybe_null(weights_projection_desc);
     rd.bias_desc = copy_maybe_null(bias_desc);
     rd.dst_layer_desc = copy_maybe_null(dst_layer_desc);
     rd.dst_iter_desc = copy_maybe_null(dst_iter_desc);
@@ -422,6 +483,10 @@ status_t rnn_common_bwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
                     dnnl_vanilla_gru, dnnl_lbr_gru);
     if (!args_ok) return invalid_arguments;
 
+    // check that only known flags have been passed
+    if (flags & ~(unsigned)dnnl_rnn_flags_variable_length)
+        return invalid_arguments;
+
     // check that all mandatory parameters are non-null
     args_ok = args_ok
             && !any_null(src_layer_desc, weights_layer_desc, weights_iter_desc,
@@ -497,22 +562,24 @@ status_t rnn_common_bwd_desc_init(dnnl_rnn_desc_t *rnn_desc,
     int DIC = weights_layer_desc->dims[4];
 
     status_t st = check_dim_consistency(cell_kind, direction, L, D, T, N, G,
-            SLC, SIC, DLC, DIC, src_layer_desc, src_iter_desc, src_iter_c_desc,
-            weights_layer_desc, weights_iter_desc, bias_desc, dst_layer_desc,
+            SLC, SIC, DLC, DIC, DIC, src_layer_desc, src_iter_desc,
+            src_iter_c_desc, weights_layer_desc, weights_iter_desc,
+            &glob_zero_md, &glob_zero_md, bias_desc, dst_layer_desc,
             dst_iter_desc, dst_iter_c_desc);
     if (st != success) return st;
 
     st = check_dim_consistency(cell_kind, direction, L, D, T, N, G, SLC, SIC,
-            DLC, DIC, diff_src_layer_desc, diff_src_iter_desc,
+            DLC, DIC, DIC, diff_src_layer_desc, diff_src_iter_desc,
             diff_src_iter_c_desc, diff_weights_layer_desc,
-            diff_weights_iter_desc, diff_bias_desc, diff_dst_layer_desc,
-            diff_dst_iter_desc, diff_dst_iter_c_desc);
+            diff_weights_iter_desc, &glob_zero_md, &glob_zero_md,
+            diff_bias_desc, diff_dst_layer_desc, diff_dst_iter_desc,
+            diff_dst_iter_c_desc);
     if (st != success) return st;
 
     CHECK(check_data_type_consistency_fwd(cell_kind, prop_kind, src_layer_desc,
             src_iter_desc, src_iter_c_desc, weights_layer_desc,
-            weights_iter_desc, bias_desc, dst_layer_desc, dst_iter_desc,
-            dst_iter_c_desc));
+            weights_iter_desc, &glob_zero_md, &glob_zero_md, bias_desc,
+            dst_layer_desc, dst_iter_desc, dst_iter_c_desc));
 
     CHECK(check_data_type_consistency_bwd(cell_kind, prop_kind,
             diff_src_layer_desc, diff_src_iter_desc, diff_src_iter_c_desc,
@@ -572,9 +639,9 @@ status_t dnnl_vanilla_rnn_forward_desc_init(dnnl_rnn_desc_t *rnn_desc,
         float beta) {
     status_t st = rnn_common_fwd_desc_init(rnn_desc, prop_kind,
             dnnl_vanilla_rnn, direction, src_layer_desc, src_iter_desc,
-            &glob_zero_md, weights_layer_desc, weights_iter_desc, bias_desc,
-            dst_layer_desc, dst_iter_desc, &glob_zero_md, flags, activation,
-            alpha, beta);
+            &glob_zero_md, weights_layer_desc, weights_iter_desc,
+            &glob_zero_md, &glob_zero_md, bias_desc, dst_layer_desc,
+            dst_iter_desc, &glob_zero_md, flags, activation, alpha, beta);
     return st;
 }
 
@@ -592,7 +659,30 @@ status_t dnnl_lstm_forward_desc_init(dnnl_rnn_desc_t *rnn_desc,
 
     status_t st = rnn_common_fwd_desc_init(rnn_desc, prop_kind,
             dnnl_vanilla_lstm, direction, src_layer_desc, src_iter_desc,
-            src_iter_c_desc, weights_layer_desc, weights_iter_desc, bias_desc,
+            src_iter_c_desc, weights_layer_desc, weights_iter_desc,
+            &glob_zero_md, &glob_zero_md, bias_desc, dst_layer_desc,
+            dst_iter_desc, dst_iter_c_desc, flags);
+    return st;
+}
+
+status_t dnnl_lstm_forward_desc_init_v2(dnnl_rnn_desc_t *rnn_desc,
+        dnnl_prop_kind_t prop_kind, dnnl_rnn_direction_t direction,
+        const dnnl_memory_desc_t *src_layer_desc,
+        const dnnl_memory_desc_t *src_iter_desc,
+        const dnnl_memory_desc_t *src_iter_c_desc,
+        const dnnl_memory_desc_t *weights_layer_desc,
+        const dnnl_memory_desc_t *weights_iter_desc,
+        const dnnl_memory_desc_t *weights_peephole_desc,
+        const dnnl_memory_desc_t *weights_projection_desc,
+        const dnnl_memory_desc_t *bias_desc,
+        const dnnl_memory_desc_t *dst_layer_desc,
+        const dnnl_memory_desc_t *dst_iter_desc,
+        const dnnl_memory_desc_t *dst_iter_c_desc, unsigned flags) {
+
+    status_t st = rnn_common_fwd_desc_init(rnn_desc, prop_kind,
+            dnnl_vanilla_lstm, direction, src_layer_desc, src_iter_desc,
+            src_iter_c_desc, weights_layer_desc, weights_iter_desc,
+            weights_peephole_desc, weights_projection_desc, bias_desc,
             dst_layer_desc, dst_iter_desc, dst_iter_c_desc, flags);
     return st;
 }
@@ -608,8 +698,9 @@ status_t dnnl_gru_forward_desc_init(dnnl_rnn_desc_t *rnn_desc,
         const dnnl_memory_desc_t *dst_iter_desc, unsigned flags) {
     status_t st = rnn_common_fwd_desc_init(rnn_desc, prop_kind,
             dnnl_vanilla_gru, direction, src_layer_desc, src_iter_desc,
-            &glob_zero_md, weights_layer_desc, weights_iter_desc, bias_desc,
-            dst_layer_desc, dst_iter_desc, &glob_zero_md, flags);
+            &glob_zero_md, weights_layer_desc, weights_iter_desc,
+            &glob_zero_md, &glob_zero_md, bias_desc, dst_layer_desc,
+            dst_iter_desc, &glob_zero_md, flags);
     return st;
 }
 
@@ -624,8 +715,9 @@ status_t dnnl_lbr_gru_forward_desc_init(dnnl_rnn_desc_t *rnn_desc,
         const dnnl_memory_desc_t *dst_iter_desc, unsigned flags) {
     status_t st = rnn_common_fwd_desc_init(rnn_desc, prop_kind, dnnl_lbr_gru,
             direction, src_layer_desc, src_iter_desc, &glob_zero_md,
-            weights_layer_desc, weights_iter_desc, bias_desc, dst_layer_desc,
-            dst_iter_desc, &glob_zero_md, flags);
+            weights_layer_desc, weights_iter_desc, &glob_zero_md,
+            &glob_zero_md, bias_desc, dst_layer_desc, dst_iter_desc,
+            &glob_zero_md, flags);
     return st;
 }
 
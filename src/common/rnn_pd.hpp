@@ -42,11 +42,20 @@ struct rnn_pd_t : public primitive_desc_t {
         , src_iter_c_md_(desc_.src_iter_c_desc)
         , weights_layer_md_(desc_.weights_layer_desc)
         , weights_iter_md_(desc_.weights_iter_desc)
+        , weights_peephole_md_(desc_.weights_peephole_desc)
+        , weights_projection_md_(desc_.weights_projection_desc)
         , bias_md_(desc_.bias_desc)
         , dst_layer_md_(desc_.dst_layer_desc)
         , dst_iter_md_(desc_.dst_iter_desc)
         , dst_iter_c_md_(desc_.dst_iter_c_desc)
-        , ws_md_() {}
+        , seq_lengths_md_()
+        , ws_md_() {
+        if (with_seq_lengths()) {
+            dims_t seq_lengths_dims = {MB()};
+            dnnl_memory_desc_init_by_tag(&seq_lengths_md_, 1, seq_lengths_dims,
+                    data_type::s32, format_tag::x);
+        }
+    }
 
     const rnn_desc_t *desc() const { return &desc_; }
     virtual const op_desc_t *op_desc() const override {
@@ -69,12 +78,15 @@ struct rnn_pd_t : public primitive_desc_t {
         if (index == 0) return &src_layer_md_;
         if (index == 1 && with_src_iter()) return &src_iter_md_;
         if (index == 2 && with_src_iter_c()) return &src_iter_c_md_;
+        if (index == 3 && with_seq_lengths()) return &seq_lengths_md_;
         return &glob_zero_md;
     }
     virtual const memory_desc_t *weights_md(int index = 0) const override {
         if (index == 0) return &weights_layer_md_;
         if (index == 1) return &weights_iter_md_;
         if (index == 2 && with_bias()) return &bias_md_;
+        if (index == 3 && with_peephole()) return &weights_peephole_md_;
+        if (index == 4 && with_projection()) return &weights_projection_md_;
         return &glob_zero_md;
     }
     virtual const memory_desc_t *dst_md(int index = 0) const override {
@@ -109,7 +121,11 @@ struct rnn_pd_t : public primitive_desc_t {
 
     dim_t SLC() const { return desc_.weights_layer_desc.dims[2]; }
     dim_t G() const { return desc_.weights_layer_desc.dims[3]; }
-    dim_t DIC() const { return desc_.weights_layer_desc.dims[4]; }
+    dim_t DHC() const { return desc_.weights_layer_desc.dims[4]; }
+    dim_t DIC() const {
+        return with_projection() ? desc_.weights_projection_desc.dims[3]
+                                 : DHC();
+    }
 
     dim_t DLC() const { return desc_.dst_layer_desc.dims[2]; }
 
@@ -117,6 +133,14 @@ struct rnn_pd_t : public primitive_desc_t {
         return !memory_desc_wrapper(desc_.bias_desc).is_zero();
     }
 
+    bool with_peephole() const {
+        return !memory_desc_wrapper(desc_.weights_peephole_desc).is_zero();
+    }
+
+    bool with_projection() const {
+        return !memory_desc_wrapper(desc_.weights_projection_desc).is_zero();
+    }
+
     bool with_src_iter() const {
         return !(memory_desc_wrapper(desc_.src_iter_desc).is_zero());
     }
@@ -134,6 +158,10 @@ struct rnn_pd_t : public primitive_desc_t {
         return is_lstm() && !memory_desc_wrapper(desc_.dst_iter_desc).is_zero();
     }
 
+    bool with_seq_lengths() const {
+        return desc_.flags & dnnl_rnn_flags_variable_length;
+    }
+
     dnnl::impl::alg_kind_t cell_kind() const { return desc_.cell_kind; }
     dnnl::impl::alg_kind_t activation_kind() const {
         return desc_.activation_kind;
@@ -154,10 +182,13 @@ protected:
     memory_desc_t src_iter_c_md_;
     memory_desc_t weights_layer_md_;
     memory_desc_t weights_iter_md_;
+    memory_desc_t weights_peephole_md_;
+    memory_desc_t weights_projection_md_;
     memory_desc_t bias_md_;
     memory_desc_t dst_layer_md_;
     memory_desc_t dst_iter_md_;
     memory_desc_t dst_iter_c_md_;
+    memory_desc_t seq_lengths_md_;
 
     memory_desc_t ws_md_;
 };
@@ -179,9 +210,18 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
         if (arg == DNNL_ARG_SRC_ITER_C && with_src_iter_c())
             return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_SRC_SEQ_LENGTHS && with_seq_lengths())
+            return arg_usage_t::input;
+
         if (utils::one_of(arg, DNNL_ARG_WEIGHTS_LAYER, DNNL_ARG_WEIGHTS_ITER))
             return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_WEIGHTS_PEEPHOLE && with_peephole())
+            return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_WEIGHTS_PROJECTION && with_projection())
+            return arg_usage_t::input;
+
         if (arg == DNNL_ARG_BIAS && with_bias()) return arg_usage_t::input;
 
         if (arg == DNNL_ARG_DST_LAYER) return arg_usage_t::output;
@@ -203,9 +243,12 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
             case DNNL_ARG_SRC_LAYER: return src_md(0);
             case DNNL_ARG_SRC_ITER: return src_md(1);
             case DNNL_ARG_SRC_ITER_C: return src_md(2);
+            case DNNL_ARG_SRC_SEQ_LENGTHS: return src_md(3);
             case DNNL_ARG_WEIGHTS_LAYER: return weights_md(0);
             case DNNL_ARG_WEIGHTS_ITER: return weights_md(1);
             case DNNL_ARG_BIAS: return weights_md(2);
+            case DNNL_ARG_WEIGHTS_PEEPHOLE: return weights_md(3);
+            case DNNL_ARG_WEIGHTS_PROJECTION: return weights_md(4);
             case DNNL_ARG_DST_LAYER: return dst_md(0);
             case DNNL_ARG_DST_ITER: return dst_md(1);
             case DNNL_ARG_DST_ITER_C: return dst_md(2);
@@ -214,7 +257,8 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
     }
 
     virtual int n_inputs() const override {
-        return 3 + with_bias() + with_src_iter() + with_src_iter_c();
+        return 3 + with_bias() + with_src_iter() + with_src_iter_c()
+                + with_seq_lengths() + with_peephole() + with_projection();
     }
     virtual int n_outputs() const override {
         return 1 + with_dst_iter() + with_dst_iter_c() + is_training();
@@ -266,6 +310,9 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
             if (arg == DNNL_ARG_DIFF_SRC_ITER_C) return arg_usage_t::output;
         }
 
+        if (arg == DNNL_ARG_SRC_SEQ_LENGTHS && with_seq_lengths())
+            return arg_usage_t::input;
+
         if (with_dst_iter()
                 && utils::one_of(
                         arg, DNNL_ARG_DST_ITER, DNNL_ARG_DIFF_DST_ITER))
@@ -286,6 +333,7 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
             case DNNL_ARG_SRC_LAYER: return src_md(0);
             case DNNL_ARG_SRC_ITER: return src_md(1);
             case DNNL_ARG_SRC_ITER_C: return src_md(2);
+            case DNNL_ARG_SRC_SEQ_LENGTHS: return src_md(3);
             case DNNL_ARG_DIFF_SRC_LAYER: return diff_src_md(0);
             case DNNL_ARG_DIFF_SRC_ITER: return diff_src_md(1);
             case DNNL_ARG_DIFF_SRC_ITER_C: return diff_src_md(2);
@@ -326,7 +374,8 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
 
     virtual int n_inputs() const override {
         return 6 + with_src_iter() + with_src_iter_c()
-                + 2 * (with_dst_iter() + with_dst_iter_c()) + with_bias();
+                + 2 * (with_dst_iter() + with_dst_iter_c()) + with_bias()
+                + with_seq_lengths();
     }
     virtual int n_outputs() const override {
         return 3 + with_src_iter() + with_src_iter_c() + with_bias();
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2019 Intel Corporation
+* Copyright 2017-2020 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -14,8 +14,13 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
+#include "dnnl.h"
+
+#include "c_types_map.hpp"
 #include "engine.hpp"
 #include "utils.hpp"
 
@@ -29,7 +34,8 @@ namespace {
 memory_storage_t *create_scratchpad_memory_storage(
         engine_t *engine, size_t size) {
     memory_storage_t *mem_storage;
-    auto status = engine->create_memory_storage(&mem_storage, size);
+    auto status = engine->create_memory_storage(
+            &mem_storage, size, memory_flags_t::usage_scratchpad);
     assert(status == status::success);
     MAYBE_UNUSED(status);
     return mem_storage;
@@ -47,7 +53,8 @@ struct concurrent_scratchpad_t : public scratchpad_t {
         mem_storage_.reset(mem_storage);
     }
 
-    virtual const memory_storage_t *get_memory_storage() const override {
+    virtual const memory_storage_t *acquire(size_t &offset) const override {
+        offset = 0;
         return mem_storage_.get();
     }
 
@@ -57,44 +64,183 @@ private:
     DNNL_DISALLOW_COPY_AND_ASSIGN(concurrent_scratchpad_t);
 };
 
+namespace {
+
+std::atomic<size_t> arena_trim_threshold(SIZE_MAX);
+
+// Statistics of all the arenas
+std::atomic<size_t> arena_reserved(0);
+std::atomic<size_t> arena_peak_reserved(0);
+std::atomic<size_t> arena_requests(0);
+std::atomic<size_t> arena_allocations(0);
+
 /*
-  Implementation of the scratchpad_t interface that uses a global
-  scratchpad
+  Per-thread arena the scratchpads of the primitives executed by the thread
+  are allocated from.
+
+  The arena keeps a list of chunks and serves the scratchpads by bumping an
+  offset in the current chunk, so nested executions (a primitive executing
+  other primitives) get consecutive regions. When a scratchpad does not fit
+  into the rest of the current chunk, a new chunk is allocated. Once no
+  scratchpad is in use the chunks are replaced by a single chunk of the
+  largest amount of memory used at a time, so the steady state needs one
+  allocation per thread and none per execution. The chunk is freed instead
+  if it is larger than the trim threshold.
 */
+struct scratchpad_arena_t {
+    scratchpad_arena_t() : cur_chunk_(0), cur_offset_(0), in_use_(0), hwm_(0) {}
+    ~scratchpad_arena_t() { free_chunks(); }
 
-struct global_scratchpad_t : public scratchpad_t {
-    global_scratchpad_t(engine_t *engine, size_t size) {
-        UNUSED(engine);
-        if (size > size_) {
-            auto *mem_storage = create_scratchpad_memory_storage(engine, size);
-            mem_storage_.reset(mem_storage);
-            size_ = size;
+    const memory_storage_t *acquire(
+            engine_t *engine, size_t size, size_t &offset) {
+        size = utils::rnd_up(size, alignment);
+
+        // chunks are allocated by the engine of the first scratchpad, which
+        // is fine for CPU engines with the same allocator as their memory is
+        // interchangeable
+        if (leases_.empty() && !chunks_.empty()
+                && !same_allocator(chunks_[0].engine, engine))
+            free_chunks();
+        leases_.push_back({cur_chunk_, cur_offset_, size});
+
+        while (cur_chunk_ < chunks_.size()
+                && cur_offset_ + size > chunks_[cur_chunk_].size) {
+            cur_chunk_++;
+            cur_offset_ = 0;
+        }
+        if (cur_chunk_ == chunks_.size() && !add_chunk(engine, size)) {
+            cur_chunk_ = leases_.back().chunk;
+            cur_offset_ = leases_.back().offset;
+            leases_.pop_back();
+            return nullptr;
         }
-        reference_count_++;
+
+        offset = cur_offset_;
+        cur_offset_ += size;
+        in_use_ += size;
+        hwm_ = nstl::max(hwm_, in_use_);
+        arena_requests++;
+        return chunks_[cur_chunk_].mem_storage;
     }
 
-    ~global_scratchpad_t() {
-        reference_count_--;
-        if (reference_count_ == 0) {
-            mem_storage_.reset();
-            size_ = 0;
+    void release() {
+        assert(!leases_.empty());
+        const lease_t &l = leases_.back();
+        cur_chunk_ = l.chunk;
+        cur_offset_ = l.offset;
+        in_use_ -= l.size;
+        leases_.pop_back();
+
+        if (leases_.empty()) {
+            size_t reserved = 0;
+            for (const auto &c : chunks_)
+                reserved += c.size;
+            if (chunks_.size() > 1 || reserved > arena_trim_threshold)
+                free_chunks();
         }
     }
 
-    virtual const memory_storage_t *get_memory_storage() const override {
-        return mem_storage_.get();
+    // Frees the memory if no scratchpad is in use
+    void trim() {
+        if (leases_.empty()) {
+            free_chunks();
+            hwm_ = 0;
+        }
     }
 
 private:
-    thread_local static std::unique_ptr<memory_storage_t> mem_storage_;
-    thread_local static size_t size_;
-    thread_local static unsigned int reference_count_;
+    static constexpr size_t alignment = 64;
+
+    struct chunk_t {
+        engine_t *engine;
+        memory_storage_t *mem_storage;
+        size_t size;
+    };
+
+    struct lease_t {
+        size_t chunk;
+        size_t offset;
+        size_t size;
+    };
+
+    static bool same_allocator(const engine_t *e0, const engine_t *e1) {
+        const allocator_t &a0 = e0->allocator(), &a1 = e1->allocator();
+        return a0.allocate == a1.allocate && a0.deallocate == a1.deallocate
+                && a0.context == a1.context && a0.flags == a1.flags;
+    }
+
+    bool add_chunk(engine_t *engine, size_t size) {
+        // The first chunk is large enough for all the scratchpads used at a
+        // time so far, unless this exceeds the trim threshold
+        if (chunks_.empty() && hwm_ <= arena_trim_threshold)
+            size = nstl::max(size, hwm_);
+
+        memory_storage_t *mem_storage = nullptr;
+        if (engine->create_memory_storage(
+                    &mem_storage, size, memory_flags_t::usage_scratchpad)
+                != status::success)
+            return false;
+
+        engine->retain();
+        chunks_.push_back({engine, mem_storage, size});
+
+        size_t reserved = (arena_reserved += size);
+        size_t peak = arena_peak_reserved;
+        while (reserved > peak
+                && !arena_peak_reserved.compare_exchange_weak(peak, reserved))
+            ;
+        arena_allocations++;
+        return true;
+    }
+
+    void free_chunks() {
+        for (auto &c : chunks_) {
+            delete c.mem_storage;
+            c.engine->release();
+            arena_reserved -= c.size;
+        }
+        chunks_.clear();
+        cur_chunk_ = 0;
+        cur_offset_ = 0;
+    }
+
+    std::vector<chunk_t> chunks_;
+    std::vector<lease_t> leases_;
+    size_t cur_chunk_;
+    size_t cur_offset_;
+    size_t in_use_;
+    size_t hwm_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(scratchpad_arena_t);
 };
 
-thread_local std::unique_ptr<memory_storage_t>
-        global_scratchpad_t::mem_storage_(nullptr);
-thread_local size_t global_scratchpad_t::size_ = 0;
-thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
+scratchpad_arena_t &thread_arena() {
+    thread_local scratchpad_arena_t arena;
+    return arena;
+}
+
+} // namespace
+
+/*
+  Implementation of the scratchpad_t interface that allocates the
+  scratchpad from the arena of the executing thread
+*/
+struct arena_scratchpad_t : public scratchpad_t {
+    arena_scratchpad_t(engine_t *engine, size_t size)
+        : engine_(engine), size_(size) {}
+
+    virtual const memory_storage_t *acquire(size_t &offset) const override {
+        return thread_arena().acquire(engine_, size_, offset);
+    }
+
+    virtual void release() const override { thread_arena().release(); }
+
+private:
+    engine_t *engine_;
+    size_t size_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(arena_scratchpad_t);
+};
 
 /*
    Scratchpad creation routine
@@ -103,12 +249,11 @@ scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad) {
 #ifndef DNNL_ENABLE_CONCURRENT_EXEC
     /*
-     * TODO: global scratchpad should be able to handle memory
-     * from different engines.
-     * lock global scratchpad to work with CPU engine only.
+     * TODO: the arena should be able to handle memory from different
+     * engines. Lock the arena to work with CPU engines only.
      */
     if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu)
-        return new global_scratchpad_t(engine, size);
+        return new arena_scratchpad_t(engine, size);
     else
         return new concurrent_scratchpad_t(engine, size);
 #else
@@ -119,3 +264,24 @@ scratchpad_t *create_scratchpad(
 
 } // namespace impl
 } // namespace dnnl
+
+using namespace dnnl::impl;
+
+status_t dnnl_set_scratchpad_arena_trim_threshold(size_t threshold) {
+    arena_trim_threshold = threshold;
+    return status::success;
+}
+
+status_t dnnl_trim_scratchpad_arena() {
+    thread_arena().trim();
+    return status::success;
+}
+
+status_t dnnl_get_scratchpad_arena_stats(scratchpad_arena_stats_t *stats) {
+    if (stats == nullptr) return status::invalid_arguments;
+    stats->reserved_bytes = arena_reserved;
+    stats->peak_reserved_bytes = arena_peak_reserved;
+    stats->requests = arena_requests;
+    stats->allocations = arena_allocations;
+    return status::success;
+}
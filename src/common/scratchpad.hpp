@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2019 Intel Corporation
+* Copyright 2017-2020 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -25,7 +25,13 @@ namespace impl {
 
 struct scratchpad_t {
     virtual ~scratchpad_t() {}
-    virtual const memory_storage_t *get_memory_storage() const = 0;
+
+    /* Returns the memory storage the scratchpad starts in and the offset of
+     * the scratchpad in it. The memory is granted for one execution and must
+     * be returned with release() by the same thread in the reverse order of
+     * acquisition. Returns nullptr if the memory cannot be allocated. */
+    virtual const memory_storage_t *acquire(size_t &offset) const = 0;
+    virtual void release() const {}
 };
 
 scratchpad_t *create_scratchpad(
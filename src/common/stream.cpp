@@ -18,8 +18,10 @@
 #include "dnnl.h"
 
 #include "c_types_map.hpp"
+#include "cpu/cpu_numa.hpp"
 #include "engine.hpp"
 #include "stream.hpp"
+#include "stream_attr.hpp"
 #include "utils.hpp"
 
 using namespace dnnl::impl;
@@ -37,6 +39,65 @@ status_t dnnl_stream_create(
     return engine->create_stream(stream, flags);
 }
 
+status_t dnnl_stream_create_v2(stream_t **stream, engine_t *engine,
+        unsigned flags, const stream_attr_t *attr) {
+    bool args_ok = true && !utils::any_null(stream, engine)
+            && flags == stream_flags::default_flags
+            && IMPLICATION(attr, attr->get_engine_kind() == engine->kind());
+    if (!args_ok) return invalid_arguments;
+
+    return engine->create_stream(stream, flags, attr);
+}
+
+status_t dnnl_stream_attr_create(stream_attr_t **attr, engine_kind_t kind) {
+    if (attr == nullptr) return invalid_arguments;
+
+    return safe_ptr_assign<stream_attr_t>(*attr, new stream_attr_t(kind));
+}
+
+status_t dnnl_stream_attr_destroy(stream_attr_t *attr) {
+    delete attr;
+    return success;
+}
+
+status_t dnnl_stream_attr_set_threadpool(
+        stream_attr_t *attr, void *threadpool) {
+    if (attr == nullptr) return invalid_arguments;
+
+    return attr->set_threadpool(threadpool);
+}
+
+status_t dnnl_stream_attr_set_numa_node(stream_attr_t *attr, int node) {
+    if (attr == nullptr) return invalid_arguments;
+    if (node < -1 || node >= cpu::numa::get_node_count())
+        return invalid_arguments;
+    if (node >= 0 && !cpu::numa::is_binding_supported()) return unimplemented;
+
+    return attr->set_numa_node(node);
+}
+
+status_t dnnl_stream_attr_get_numa_node(const stream_attr_t *attr, int *node) {
+    if (utils::any_null(attr, node)) return invalid_arguments;
+
+    *node = attr->get_numa_node();
+    return success;
+}
+
+status_t dnnl_get_numa_node_count(int *count) {
+    if (count == nullptr) return invalid_arguments;
+
+    *count = cpu::numa::get_node_count();
+    return success;
+}
+
+status_t dnnl_stream_attr_get_threadpool(
+        const stream_attr_t *attr, void **threadpool) {
+    if (utils::any_null(attr, threadpool)) return invalid_arguments;
+
+    *threadpool = attr->get_threadpool();
+    return success;
+}
+
 status_t dnnl_stream_wait(stream_t *stream) {
     bool args_ok = !any_null(stream);
     if (!args_ok) return invalid_arguments;
@@ -37,6 +37,14 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     /** blocks until all submitted primitives to the stream are completed */
     virtual dnnl::impl::status_t wait() = 0;
 
+    /** returns the NUMA node the stream is bound to or -1 */
+    virtual int numa_node() const { return -1; }
+
+    /** called on the calling thread before and after a primitive is
+     * executed on the stream */
+    virtual void before_exec_hook() {}
+    virtual void after_exec_hook() {}
+
 protected:
     dnnl::impl::engine_t *engine_;
     unsigned flags_;
@@ -0,0 +1,61 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef STREAM_ATTR_HPP
+#define STREAM_ATTR_HPP
+
+#include "dnnl.h"
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+struct dnnl_stream_attr : public dnnl::impl::c_compatible {
+    dnnl_stream_attr(dnnl::impl::engine_kind_t kind) : kind_(kind) {}
+
+    dnnl::impl::engine_kind_t get_engine_kind() const { return kind_; }
+
+    dnnl::impl::status_t set_threadpool(void *threadpool) {
+        using namespace dnnl::impl;
+        if (kind_ != engine_kind::cpu) return status::invalid_arguments;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        threadpool_ = threadpool;
+        return status::success;
+#else
+        UNUSED(threadpool);
+        return status::unimplemented;
+#endif
+    }
+
+    void *get_threadpool() const { return threadpool_; }
+
+    dnnl::impl::status_t set_numa_node(int node) {
+        using namespace dnnl::impl;
+        if (kind_ != engine_kind::cpu) return status::invalid_arguments;
+        numa_node_ = node;
+        return status::success;
+    }
+
+    int get_numa_node() const { return numa_node_; }
+
+private:
+    dnnl::impl::engine_kind_t kind_;
+    void *threadpool_ = nullptr;
+    int numa_node_ = -1;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
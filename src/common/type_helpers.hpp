@@ -106,6 +106,10 @@ inline bool memory_extra_desc_is_equal(
             && IMPLICATION(
                     lhs.flags & memory_extra_flags::gpu_rnn_u8s8_compensation,
                     lhs.compensation_mask == rhs.compensation_mask)
+            && IMPLICATION(lhs.flags
+                            & memory_extra_flags::
+                                    compensation_conv_asymmetric_src,
+                    lhs.asymm_compensation_mask == rhs.asymm_compensation_mask)
             && IMPLICATION(lhs.flags & memory_extra_flags::scale_adjust,
                     lhs.scale_adjust == rhs.scale_adjust);
 }
@@ -400,8 +404,8 @@ inline bool operator==(const rnn_desc_t &lhs, const rnn_desc_t &rhs) {
             && COMPARE_DESC_MEMBERS(dst_layer_desc)
             && COMPARE_DESC_MEMBERS(dst_iter_desc)
             && COMPARE_DESC_MEMBERS(dst_iter_c_desc)
-            && COMPARE_DESC_MEMBERS(placeholder_desc)
-            && COMPARE_DESC_MEMBERS(placeholder2_desc)
+            && COMPARE_DESC_MEMBERS(weights_peephole_desc)
+            && COMPARE_DESC_MEMBERS(weights_projection_desc)
             && COMPARE_DESC_MEMBERS(diff_src_layer_desc)
             && COMPARE_DESC_MEMBERS(diff_src_iter_desc)
             && COMPARE_DESC_MEMBERS(diff_src_iter_c_desc)
@@ -411,8 +415,8 @@ inline bool operator==(const rnn_desc_t &lhs, const rnn_desc_t &rhs) {
             && COMPARE_DESC_MEMBERS(diff_dst_layer_desc)
             && COMPARE_DESC_MEMBERS(diff_dst_iter_desc)
             && COMPARE_DESC_MEMBERS(diff_dst_iter_c_desc)
-            && COMPARE_DESC_MEMBERS(diff_placeholder_desc)
-            && COMPARE_DESC_MEMBERS(diff_placeholder2_desc)
+            && COMPARE_DESC_MEMBERS(diff_weights_peephole_desc)
+            && COMPARE_DESC_MEMBERS(diff_weights_projection_desc)
             && COMPARE_DESC_MEMBERS(flags)
             && COMPARE_DESC_MEMBERS(activation_kind)
             && COMPARE_DESC_MEMBERS(alpha) && COMPARE_DESC_MEMBERS(beta);
@@ -448,6 +452,22 @@ inline bool operator==(const sum_desc_t &lhs, const sum_desc_t &rhs) {
     }
     return ret;
 }
+
+inline bool operator==(
+        const conv_stack_desc_t &lhs, const conv_stack_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind) && COMPARE_DESC_MEMBERS(n);
+    if (!ret) return ret;
+
+    for (int i = 0; i < lhs.n; i++) {
+        ret = COMPARE_DESC_MEMBERS(layers[i].conv_desc)
+                && COMPARE_DESC_MEMBERS(layers[i].eltwise_alg)
+                && COMPARE_DESC_MEMBERS(layers[i].eltwise_scale)
+                && COMPARE_DESC_MEMBERS(layers[i].eltwise_alpha)
+                && COMPARE_DESC_MEMBERS(layers[i].eltwise_beta);
+        if (!ret) break;
+    }
+    return ret;
+}
 #undef COMPARE_DESC_MEMBERS
 #undef COMPARE_DESC_ARRAY_MEMBERS
 
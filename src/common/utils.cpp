@@ -119,6 +119,15 @@ int32_t fetch_and_add(int32_t *dst, int32_t val) {
 #endif
 }
 
+static thread_local size_t jit_code_size = 0;
+void add_jit_code_size(size_t size) {
+    jit_code_size += size;
+}
+
+size_t get_jit_code_size() {
+    return jit_code_size;
+}
+
 static setting_t<bool> jit_dump {0};
 bool get_jit_dump() {
     if (!jit_dump.initialized()) {
@@ -128,6 +137,15 @@ bool get_jit_dump() {
     return jit_dump.get();
 }
 
+static setting_t<bool> dynamic_scheduling {false};
+bool get_dynamic_scheduling() {
+    if (!dynamic_scheduling.initialized()) {
+        dynamic_scheduling.set(!!getenv_int(
+                "DNNL_DYNAMIC_SCHEDULING", dynamic_scheduling.get()));
+    }
+    return dynamic_scheduling.get();
+}
+
 static setting_t<unsigned> jit_profiling_flags {DNNL_JIT_PROFILE_VTUNE};
 unsigned get_jit_profiling_flags() {
     if (!jit_profiling_flags.initialized()) {
@@ -194,3 +212,16 @@ dnnl_status_t dnnl_set_jit_profiling_flags(unsigned flags) {
 dnnl_status_t dnnl_set_jit_profiling_jitdumpdir(const char *dir) {
     return dnnl::impl::init_jit_profiling_jitdumpdir(dir, true);
 }
+
+dnnl_status_t dnnl_set_dynamic_scheduling(int enable) {
+    using namespace dnnl::impl;
+    dynamic_scheduling.set(enable);
+    return status::success;
+}
+
+dnnl_status_t dnnl_get_jit_code_size(size_t *size) {
+    using namespace dnnl::impl;
+    if (size == nullptr) return status::invalid_arguments;
+    *size = get_jit_code_size();
+    return status::success;
+}
@@ -40,6 +40,8 @@
 #endif
 #endif
 
+#include "dnnl_config.h"
+
 #include "c_types_map.hpp"
 #include "nstl.hpp"
 #include "z_magic.hpp"
@@ -487,10 +489,16 @@ int getenv(const char *name, char *buffer, int buffer_size);
 // Reads an integer from the environment
 int getenv_int(const char *name, int default_value = 0);
 bool get_jit_dump();
+bool get_dynamic_scheduling();
 unsigned get_jit_profiling_flags();
 std::string get_jit_profiling_jitdumpdir();
 FILE *fopen(const char *filename, const char *mode);
 
+// Counts the size of the code generated by the calling thread. The primitive
+// cache uses the counter to estimate the code size of the primitives it holds.
+void add_jit_code_size(size_t size);
+size_t get_jit_code_size();
+
 constexpr int msan_enabled = MSAN_ENABLED;
 inline void msan_unpoison(void *ptr, size_t size) {
 #if MSAN_ENABLED
@@ -29,6 +29,7 @@
 #include "batch_normalization_pd.hpp"
 #include "binary_pd.hpp"
 #include "concat_pd.hpp"
+#include "conv_stack_pd.hpp"
 #include "convolution_pd.hpp"
 #include "deconvolution_pd.hpp"
 #include "eltwise_pd.hpp"
@@ -228,6 +229,21 @@ void attr2str(char *str, int len, int written, const primitive_attr_t *attr) {
                 const post_ops_t::entry_t::eltwise_t &ew = e.eltwise;
                 DPRINT(str, len, written, "%s:%g:%g:%g;",
                         dnnl_alg_kind2str(ew.alg), ew.alpha, ew.beta, ew.scale);
+            } else if (e.is_binary()) {
+                // the mask of the dimensions the second source is not
+                // broadcast along
+                const memory_desc_t &src1_md = e.binary.src1_desc;
+                int mask = 0;
+                for (int d = 0; d < src1_md.ndims; ++d)
+                    if (src1_md.dims[d] != 1) mask |= 1 << d;
+                DPRINT(str, len, written, "%s:%s:%d;",
+                        dnnl_alg_kind2str(e.binary.alg),
+                        dnnl_dt2str(src1_md.data_type), mask);
+            } else if (e.is_depthwise_conv()) {
+                const auto &dw = e.depthwise_conv;
+                DPRINT(str, len, written, "dw_k3s%dp1:%s:%s:%s;", dw.stride,
+                        dnnl_dt2str(dw.wei_dt), dnnl_dt2str(dw.bias_dt),
+                        dnnl_dt2str(dw.dst_dt));
             }
         }
         DPRINT(str, len, written, "';");
@@ -329,6 +345,65 @@ static void init_info_concat(pd_t *s, char *buffer) {
             dat_str, attr_str, aux_str, prb_str);
 }
 
+template <typename pd_t>
+static void init_info_conv_stack(pd_t *s, char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    { // src
+        auto md = s->src_md();
+        DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, "src_");
+        MD2STR(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, md);
+    }
+    { // wei
+        for (int i = 0; i < s->n_layers(); ++i) {
+            auto md = s->weights_md(i);
+            DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, " wei%d_", i);
+            MD2STR(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, md);
+        }
+    }
+    { // dst
+        auto md = s->dst_md();
+        DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, " dst_");
+        MD2STR(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, md);
+    }
+
+    attr2str(attr_str, DNNL_VERBOSE_ATTR_LEN, attr_written, s->attr());
+
+    DPRINT(aux_str, DNNL_VERBOSE_AUX_LEN, aux_written, "layers:%d",
+            s->n_layers());
+    for (int i = 0; i < s->n_layers(); ++i) {
+        const auto &po = s->layer_attr(i)->post_ops_;
+        if (po.len_ == 0) continue;
+        DPRINT(aux_str, DNNL_VERBOSE_AUX_LEN, aux_written, " post_ops%d:%s", i,
+                dnnl_alg_kind2str(po.entry_[0].eltwise.alg));
+    }
+
+    DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written, "mb" DFMT "_",
+            s->src_md()->dims[0]);
+    for (int i = 0; i < s->n_layers(); ++i) {
+        const convolution_desc_t *cd = s->layer_desc(i);
+        const int ndims = cd->src_desc.ndims;
+        const bool with_groups = cd->weights_desc.ndims == ndims + 1;
+        if (i > 0) DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written, "+");
+        if (with_groups)
+            DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written, "g" DFMT,
+                    cd->weights_desc.dims[0]);
+        DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written, "ic" DFMT "oc" DFMT,
+                cd->src_desc.dims[1], cd->dst_desc.dims[1]);
+        for (int d = 0; d < ndims - 2; ++d) {
+            const char c = "dhw"[5 - ndims + d];
+            DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written,
+                    "_i%c" DFMT "o%c" DFMT "k%c" DFMT "s%c" DFMT "p%c" DFMT, c,
+                    cd->src_desc.dims[2 + d], c, cd->dst_desc.dims[2 + d], c,
+                    cd->weights_desc.dims[2 + d + with_groups], c,
+                    cd->strides[d], c, cd->padding[0][d]);
+        }
+    }
+
+    verbose_templ(buffer, s->engine(), s->kind(), s->name(),
+            prop_kind::forward_inference, dat_str, attr_str, aux_str, prb_str);
+}
+
 template <typename pd_t>
 static void init_info_conv(pd_t *s, char *buffer) {
     DECL_DAT_AUX_PRB_STRS();
@@ -913,6 +988,9 @@ void init_info(binary_pd_t *s, char *b) {
 void init_info(concat_pd_t *s, char *b) {
     init_info_concat(s, b);
 }
+void init_info(conv_stack_pd_t *s, char *b) {
+    init_info_conv_stack(s, b);
+}
 void init_info(convolution_pd_t *s, char *b) {
     init_info_conv(s, b);
 }
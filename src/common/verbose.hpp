@@ -45,6 +45,7 @@ const char *get_isa_info();
 void init_info(batch_normalization_pd_t *s, char *buffer);
 void init_info(binary_pd_t *s, char *buffer);
 void init_info(concat_pd_t *s, char *buffer);
+void init_info(conv_stack_pd_t *s, char *buffer);
 void init_info(convolution_pd_t *s, char *buffer);
 void init_info(deconvolution_pd_t *s, char *buffer);
 void init_info(eltwise_pd_t *s, char *buffer);
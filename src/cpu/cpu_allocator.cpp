@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <string.h>
+
+#include "dnnl_thread.hpp"
+#include "utils.hpp"
+
+#include "cpu_allocator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+namespace {
+const size_t default_alignment = 64;
+const size_t page_size = 4096;
+const size_t huge_page_size = 2 * 1024 * 1024;
+
+// Zeroes the memory from the threads of the library, so the OS places each
+// page on the NUMA node of the thread that processes it in a parallel loop
+// with the same static partitioning
+void first_touch(void *ptr, size_t size) {
+    char *data = (char *)ptr;
+    const size_t npages = utils::div_up(size, page_size);
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start = 0, end = 0;
+        balance211(npages, nthr, ithr, start, end);
+        const size_t begin = start * page_size;
+        const size_t finish = nstl::min(size, end * page_size);
+        if (begin < finish) memset(data + begin, 0, finish - begin);
+    });
+}
+} // namespace
+
+void *allocate(
+        const allocator_t &allocator, size_t size, memory_usage_t usage) {
+    const bool huge_pages = (allocator.flags & allocator_flags::huge_pages)
+            && size >= huge_page_size;
+    const size_t alignment = huge_pages ? huge_page_size : default_alignment;
+
+    void *ptr = allocator.allocate
+            ? allocator.allocate(size, alignment, usage, allocator.context)
+            : malloc(size, (int)alignment);
+    if (ptr == nullptr) return nullptr;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // the advice is a hint, so a failure is not an error
+    if (huge_pages) madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+    if (allocator.flags & allocator_flags::first_touch) first_touch(ptr, size);
+    return ptr;
+}
+
+void deallocate(
+        const allocator_t &allocator, void *ptr, memory_usage_t usage) {
+    if (ptr == nullptr) return;
+    if (allocator.deallocate)
+        allocator.deallocate(ptr, usage, allocator.context);
+    else
+        free(ptr);
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_ALLOCATOR_HPP
+#define CPU_ALLOCATOR_HPP
+
+#include <stddef.h>
+
+#include "common/c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Allocates memory with an engine allocator: the user allocation function
+// if set or the library allocator otherwise, and applies the allocator
+// flags. Returns nullptr on failure.
+void *allocate(
+        const allocator_t &allocator, size_t size, memory_usage_t usage);
+
+// Deallocates memory allocated by allocate() with the same allocator
+void deallocate(
+        const allocator_t &allocator, void *ptr, memory_usage_t usage);
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,42 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "cpu_engine.hpp"
+
+#include "cpu/tiled_conv_stack.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using cspd_create_f = dnnl::impl::engine_t::conv_stack_primitive_desc_create_f;
+
+namespace {
+#define INSTANCE(...) __VA_ARGS__::pd_t::create
+static const cspd_create_f cpu_conv_stack_impl_list[] = {
+        INSTANCE(tiled_conv_stack_t),
+        nullptr,
+};
+#undef INSTANCE
+} // namespace
+
+const cspd_create_f *cpu_engine_t::get_conv_stack_implementation_list() const {
+    return cpu_conv_stack_impl_list;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
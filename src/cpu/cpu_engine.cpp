@@ -22,7 +22,9 @@
 #include "cpu_memory_storage.hpp"
 #include "cpu_stream.hpp"
 #include "memory.hpp"
+#include "stream_attr.hpp"
 
+#include "cpu/matmul/gemm_bf16_matmul.hpp"
 #include "cpu/matmul/gemm_f32_matmul.hpp"
 #include "cpu/matmul/gemm_x8s8s32x_matmul.hpp"
 #include "cpu/matmul/ref_matmul.hpp"
@@ -102,7 +104,15 @@ status_t cpu_engine_t::create_memory_storage(
 }
 
 status_t cpu_engine_t::create_stream(stream_t **stream, unsigned flags) {
-    return safe_ptr_assign<stream_t>(*stream, new cpu_stream_t(this, flags));
+    return create_stream(stream, flags, nullptr);
+}
+
+status_t cpu_engine_t::create_stream(
+        stream_t **stream, unsigned flags, const stream_attr_t *attr) {
+    void *threadpool = attr ? attr->get_threadpool() : nullptr;
+    const int numa_node = attr ? attr->get_numa_node() : -1;
+    return safe_ptr_assign<stream_t>(
+            *stream, new cpu_stream_t(this, flags, threadpool, numa_node));
 }
 
 using pd_create_f = dnnl::impl::engine_t::primitive_desc_create_f;
@@ -402,6 +412,8 @@ static const pd_create_f cpu_impl_list[] = {
         INSTANCE(ref_binary_t<bf16>),
         /* matmul op */
         INSTANCE(gemm_f32_matmul_t),
+        INSTANCE(gemm_bf16_matmul_t<f32>),
+        INSTANCE(gemm_bf16_matmul_t<bf16>),
         INSTANCE(gemm_x8s8s32x_matmul_t<s8, s8, f32>),
         INSTANCE(gemm_x8s8s32x_matmul_t<s8, s8, s32>),
         INSTANCE(gemm_x8s8s32x_matmul_t<s8, s8, s8>),
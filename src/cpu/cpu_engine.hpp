@@ -39,9 +39,19 @@ public:
             unsigned flags, size_t size, void *handle) override;
 
     virtual status_t create_stream(stream_t **stream, unsigned flags) override;
+    virtual status_t create_stream(stream_t **stream, unsigned flags,
+            const stream_attr_t *attr) override;
+
+    virtual status_t set_allocator(const allocator_t *allocator) override {
+        allocator_ = allocator ? *allocator
+                               : allocator_t {nullptr, nullptr, nullptr, 0};
+        return status::success;
+    }
 
     virtual const concat_primitive_desc_create_f *
     get_concat_implementation_list() const override;
+    virtual const conv_stack_primitive_desc_create_f *
+    get_conv_stack_implementation_list() const override;
     virtual const reorder_primitive_desc_create_f *
     get_reorder_implementation_list() const override;
     virtual const sum_primitive_desc_create_f *
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2019 Intel Corporation
+* Copyright 2019-2020 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -17,13 +17,17 @@
 #ifndef CPU_MEMORY_STORAGE_HPP
 #define CPU_MEMORY_STORAGE_HPP
 
+#include <functional>
 #include <memory>
 
 #include "common/c_types_map.hpp"
+#include "common/engine.hpp"
 #include "common/memory.hpp"
 #include "common/memory_storage.hpp"
 #include "common/utils.hpp"
 
+#include "cpu/cpu_allocator.hpp"
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -42,9 +46,15 @@ public:
             return status::success;
         }
         if (flags & memory_flags_t::alloc) {
-            void *data_ptr = malloc(size, 64);
+            // the memory is deallocated with the allocator it was allocated
+            // with even if the allocator of the engine changes
+            const allocator_t allocator = engine()->allocator();
+            const memory_usage_t usage = memory_usage_from_flags(flags);
+            void *data_ptr = allocate(allocator, size, usage);
             if (data_ptr == nullptr) return status::out_of_memory;
-            data_ = decltype(data_)(data_ptr, destroy);
+            data_ = decltype(data_)(data_ptr, [=](void *ptr) {
+                deallocate(allocator, ptr, usage);
+            });
         } else if (flags & memory_flags_t::use_runtime_ptr) {
             data_ = decltype(data_)(handle, release);
         }
@@ -70,12 +80,11 @@ public:
     }
 
 private:
-    std::unique_ptr<void, void (*)(void *)> data_;
+    std::unique_ptr<void, std::function<void(void *)>> data_;
 
     DNNL_DISALLOW_COPY_AND_ASSIGN(cpu_memory_storage_t);
 
     static void release(void *ptr) {}
-    static void destroy(void *ptr) { free(ptr); }
 };
 
 } // namespace cpu
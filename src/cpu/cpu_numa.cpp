@@ -0,0 +1,257 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+#include "dnnl_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "cpu_numa.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+namespace {
+// Parses a CPU list such as `0-3,8,10-11`
+std::vector<int> parse_cpu_list(const char *str) {
+    std::vector<int> cpus;
+    while (*str) {
+        if (!isdigit(*str)) {
+            str++;
+            continue;
+        }
+        char *end;
+        const int first = (int)strtol(str, &end, 10);
+        int last = first;
+        if (*end == '-') last = (int)strtol(end + 1, &end, 10);
+        for (int cpu = first; cpu <= last; cpu++)
+            cpus.push_back(cpu);
+        str = end;
+    }
+    return cpus;
+}
+
+std::vector<std::vector<int>> read_system_topology() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    const char *node_dir = "/sys/devices/system/node";
+    DIR *dir = opendir(node_dir);
+    std::vector<int> node_ids;
+    if (dir) {
+        while (struct dirent *entry = readdir(dir)) {
+            if (strncmp(entry->d_name, "node", 4) == 0
+                    && isdigit(entry->d_name[4]))
+                node_ids.push_back(atoi(entry->d_name + 4));
+        }
+        closedir(dir);
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+    for (int id : node_ids) {
+        const std::string path = std::string(node_dir) + "/node"
+                + std::to_string(id) + "/cpulist";
+        FILE *f = fopen(path.c_str(), "r");
+        if (!f) continue;
+        char buf[4096] = {0};
+        const bool ok = fgets(buf, sizeof(buf), f) != nullptr;
+        fclose(f);
+        if (!ok) continue;
+        // nodes with memory only are skipped
+        std::vector<int> cpus = parse_cpu_list(buf);
+        if (!cpus.empty()) nodes.push_back(cpus);
+    }
+#endif
+    if (nodes.empty()) {
+        const int ncpus
+                = nstl::max(1, (int)std::thread::hardware_concurrency());
+        nodes.emplace_back();
+        for (int cpu = 0; cpu < ncpus; cpu++)
+            nodes.back().push_back(cpu);
+    }
+    return nodes;
+}
+
+std::vector<std::vector<int>> init_topology() {
+    std::vector<std::vector<int>> nodes = read_system_topology();
+
+    char env[4096] = {0};
+    if (getenv("DNNL_NUMA_TOPOLOGY", env, sizeof(env)) <= 0) return nodes;
+
+    if (strchr(env, ';') || strchr(env, '-') || strchr(env, ',')) {
+        std::vector<std::vector<int>> fake_nodes;
+        for (char *list = strtok(env, ";"); list; list = strtok(nullptr, ";"))
+            fake_nodes.push_back(parse_cpu_list(list));
+        for (const auto &cpus : fake_nodes)
+            if (cpus.empty()) return nodes;
+        return fake_nodes;
+    }
+
+    // splits the CPUs evenly, the nodes share the CPUs if there are more
+    // nodes than CPUs
+    const int nnodes = atoi(env);
+    if (nnodes <= 0) return nodes;
+    std::vector<int> all_cpus;
+    for (const auto &cpus : nodes)
+        all_cpus.insert(all_cpus.end(), cpus.begin(), cpus.end());
+    const int ncpus = (int)all_cpus.size();
+    std::vector<std::vector<int>> fake_nodes(nnodes);
+    for (int node = 0; node < nnodes; node++) {
+        int start = 0, end = 0;
+        balance211(ncpus, nnodes, node, start, end);
+        if (start == end) fake_nodes[node].push_back(all_cpus[node % ncpus]);
+        for (int i = start; i < end; i++)
+            fake_nodes[node].push_back(all_cpus[i]);
+    }
+    return fake_nodes;
+}
+
+const std::vector<std::vector<int>> &topology() {
+    static const std::vector<std::vector<int>> nodes = init_topology();
+    return nodes;
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+#ifdef __linux__
+cpu_set_t init_process_cpu_set() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            CPU_SET(cpu, &set);
+    return set;
+}
+
+// The CPUs the process may run on, captured when the library is loaded,
+// before any thread is bound to a node
+const cpu_set_t process_cpu_set = init_process_cpu_set();
+
+std::vector<cpu_set_t> init_node_cpu_sets() {
+    std::vector<cpu_set_t> sets(topology().size());
+    for (size_t node = 0; node < sets.size(); node++) {
+        CPU_ZERO(&sets[node]);
+        for (int cpu : topology()[node])
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &sets[node]);
+    }
+    return sets;
+}
+
+const std::vector<cpu_set_t> &node_cpu_sets() {
+    static const std::vector<cpu_set_t> sets = init_node_cpu_sets();
+    return sets;
+}
+#endif
+
+// The threads are left as they are until a stream is bound to a node
+std::atomic<bool> binding_enabled(false);
+
+// Returns the binding of the parallel regions for a node
+numa_utils::binding_t get_binding(int node) {
+    if (!binding_enabled.load(std::memory_order_relaxed)) return {-1, nullptr};
+#ifdef __linux__
+    return {node, node < 0 ? &process_cpu_set : &node_cpu_sets()[node]};
+#else
+    // the threads are not bound, only the node is tracked
+    static const int dummy_cpus = 0;
+    return {node, &dummy_cpus};
+#endif
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+// The number of threads of the calling thread before it is bound to a node
+int &saved_max_threads() {
+    static thread_local int nthr = 0;
+    return nthr;
+}
+#endif
+#endif
+} // namespace
+
+int get_node_count() {
+    return (int)topology().size();
+}
+
+const std::vector<int> &get_node_cpus(int node) {
+    assert(0 <= node && node < get_node_count());
+    return topology()[node];
+}
+
+bool is_binding_supported() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+    return true;
+#else
+    return false;
+#endif
+}
+
+void bind_threads(int node) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+    if (node >= 0 && !binding_enabled.load(std::memory_order_relaxed))
+        binding_enabled.store(true);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // the parallel regions which take the number of threads from the
+    // runtime run on as many threads as the node has CPUs
+    const int max_threads = dnnl_get_max_threads();
+    const int nthr = node < 0
+            ? max_threads
+            : nstl::min(max_threads, (int)get_node_cpus(node).size());
+    saved_max_threads() = 0;
+    if (nthr != max_threads) {
+        saved_max_threads() = max_threads;
+        omp_set_num_threads(nthr);
+    }
+#endif
+    // the threads of the parallel regions bind themselves, and the calling
+    // thread also runs the sequential code of the primitive
+    numa_utils::active_binding() = get_binding(node);
+    numa_utils::maybe_bind_thread(numa_utils::active_binding());
+#else
+    UNUSED(node);
+#endif
+}
+
+void unbind_threads() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    if (saved_max_threads() > 0) omp_set_num_threads(saved_max_threads());
+    saved_max_threads() = 0;
+#endif
+    numa_utils::active_binding() = get_binding(-1);
+#endif
+}
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,54 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_NUMA_HPP
+#define CPU_NUMA_HPP
+
+#include <vector>
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+// Returns the number of NUMA nodes. The topology is read from sysfs on Linux
+// and can be replaced with a fake one for testing by the DNNL_NUMA_TOPOLOGY
+// environment variable: either the number of nodes to split the CPUs into,
+// e.g. `2`, or the CPU lists of the nodes separated by semicolons, e.g.
+// `0-3;4-7`.
+int get_node_count();
+
+// Returns the CPUs of a node
+const std::vector<int> &get_node_cpus(int node);
+
+// Returns whether the threads can be bound to the CPUs of a node, which is
+// the case for the OpenMP and sequential builds only
+bool is_binding_supported();
+
+// Makes the parallel regions of the calling thread run on the CPUs of a
+// node, or on the CPUs of the process for a negative node, until
+// unbind_threads() is called. The threads of a region bind themselves when
+// the region runs for another node than the previous one, and keep their
+// binding otherwise.
+void bind_threads(int node);
+void unbind_threads();
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -22,6 +22,7 @@
 #include "dnnl_types.h"
 
 #include "common/c_types_map.hpp"
+#include "common/memory_desc_wrapper.hpp"
 #include "common/primitive_attr.hpp"
 #include "common/primitive_exec_types.hpp"
 #include "common/utils.hpp"
@@ -75,4 +76,96 @@
     } \
     MAYBE_UNUSED(zero_point);
 
+#define DEFINE_BINARY_POST_OP_SRC1(src1) \
+    const float *src1 = nullptr; \
+    { \
+        const binary_post_op_t binary_po(pd()->attr()->post_ops_); \
+        if (binary_po.enabled()) { \
+            src1 = CTX_IN_MEM(const float *, binary_po.arg()); \
+            if (src1 == nullptr) return status::invalid_arguments; \
+        } \
+    } \
+    MAYBE_UNUSED(src1);
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// The binary post-op as supported by the CPU implementations: at most one
+// such post-op with an f32 second source that is either a single value or a
+// dense vector of the destination channels (dimension 1)
+struct binary_post_op_t {
+    binary_post_op_t() = default;
+
+    // Expects the post-ops to pass post_ops_ok()
+    binary_post_op_t(const post_ops_t &po) {
+        idx = po.find(primitive_kind::binary);
+        if (idx == -1) return;
+        const auto &e = po.entry_[idx].binary;
+        alg = e.alg;
+        per_oc = memory_desc_wrapper(e.src1_desc).nelems() > 1;
+    }
+
+    // Returns false if the post-ops have binary entries that cannot be
+    // handled, including per-channel ones when allow_per_oc is false
+    static bool post_ops_ok(const post_ops_t &po, const memory_desc_t &dst_md,
+            bool allow_per_oc = true) {
+        const int idx = po.find(primitive_kind::binary);
+        if (idx == -1) return true;
+        if (po.find(primitive_kind::binary, idx + 1) != -1) return false;
+
+        const memory_desc_wrapper src1_d(po.entry_[idx].binary.src1_desc);
+        const memory_desc_wrapper dst_d(dst_md);
+        bool ok = src1_d.data_type() == data_type::f32
+                && src1_d.is_blocking_desc() && src1_d.is_dense()
+                && src1_d.ndims() == dst_d.ndims();
+        if (!ok) return false;
+
+        bool per_tensor = true;
+        bool per_oc = dst_d.ndims() >= 2
+                && src1_d.dims()[1] == dst_d.dims()[1];
+        for (int d = 0; d < src1_d.ndims(); ++d) {
+            if (src1_d.dims()[d] == 1) continue;
+            per_tensor = false;
+            if (d != 1) per_oc = false;
+        }
+        return per_tensor || (per_oc && allow_per_oc);
+    }
+
+    // Returns true if the post-ops are at most one eltwise and at most one
+    // binary post-op, in either order, optionally preceded by a sum. The sum
+    // must be the first entry: it is accumulated before the other post-ops
+    static bool sum_eltwise_binary_ok(const post_ops_t &po) {
+        int n_eltwise = 0, n_binary = 0;
+        const int start = po.contain(primitive_kind::sum, 0) ? 1 : 0;
+        for (int idx = start; idx < po.len_; ++idx) {
+            if (po.entry_[idx].is_eltwise(false))
+                n_eltwise++;
+            else if (po.entry_[idx].is_binary())
+                n_binary++;
+            else
+                return false;
+        }
+        return n_eltwise <= 1 && n_binary <= 1;
+    }
+
+    bool enabled() const { return idx != -1; }
+
+    int arg() const {
+        return DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx) | DNNL_ARG_SRC_1;
+    }
+
+    float compute_scalar(float src0, float src1) const {
+        return alg == alg_kind::binary_add ? src0 + src1 : src0 * src1;
+    }
+
+    int idx = -1;
+    alg_kind_t alg = alg_kind::undef;
+    bool per_oc = false;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
 #endif // CPU_PRIMITIVE_HPP
@@ -18,20 +18,51 @@
 #define CPU_STREAM_HPP
 
 #include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
+#include "cpu/cpu_numa.hpp"
 
 namespace dnnl {
 namespace impl {
 namespace cpu {
 
 struct cpu_stream_t : public stream_t {
-    cpu_stream_t(engine_t *engine, unsigned flags) : stream_t(engine, flags) {}
+    cpu_stream_t(engine_t *engine, unsigned flags, void *threadpool = nullptr,
+            int numa_node = -1)
+        : stream_t(engine, flags)
+        , threadpool_(threadpool)
+        , numa_node_(numa_node) {}
     virtual ~cpu_stream_t() = default;
 
     virtual dnnl::impl::status_t wait() override {
         // CPU execution is synchronous so return immediately
         return dnnl::impl::status::success;
     }
+
+    virtual int numa_node() const override { return numa_node_; }
+
+    virtual void before_exec_hook() override {
+        // the threads are unbound as well if the previous primitive of the
+        // calling thread was executed on a stream bound to a NUMA node
+        numa::bind_threads(numa_node_);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        // The parallel regions of the primitive run through the threadpool
+        // of the stream, or sequentially if the stream has no threadpool
+        threadpool_utils::activate_threadpool(
+                static_cast<threadpool_iface *>(threadpool_));
+#endif
+    }
+
+    virtual void after_exec_hook() override {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        threadpool_utils::deactivate_threadpool();
+#endif
+        numa::unbind_threads();
+    }
+
+private:
+    void *threadpool_;
+    int numa_node_;
 };
 
 } // namespace cpu
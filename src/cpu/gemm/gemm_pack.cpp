@@ -14,6 +14,11 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <limits>
+#include <memory>
+
+#include "dnnl.h"
+
 #include "dnnl_thread.hpp"
 #include "dnnl_traits.hpp"
 #include "dnnl_types.h"
@@ -495,3 +500,223 @@ dnnl_status_t gemm_s8s8s32_compute(const char *transa, const char *transb,
 } // namespace cpu
 } // namespace impl
 } // namespace dnnl
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::cpu;
+
+/* A matrix B packed by the public pack API.
+ *
+ * The public API is row-major while the packing routines are column-major,
+ * so the public matrix B is packed as the column-major matrix A of the
+ * transposed problem, which layout does not depend on the number of rows of
+ * the public matrix A. */
+struct dnnl_packed_matrix : public c_compatible {
+    enum kind_t { f32, bf16, u8s8s32, s8s8s32 };
+
+    dnnl_packed_matrix(kind_t kind, char transa, char transb, int N, int K)
+        : kind(kind)
+        , transa(transa)
+        , transb(transb)
+        , N(N)
+        , K(K)
+        , size(0)
+        , data(nullptr) {}
+
+    ~dnnl_packed_matrix() { dnnl::impl::free(data); }
+
+    kind_t kind;
+    char transa, transb;
+    int N, K;
+    size_t size;
+    void *data;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(dnnl_packed_matrix);
+};
+
+namespace {
+
+using packed_matrix_t = dnnl_packed_matrix;
+
+bool is_trans_valid(char trans) {
+    return utils::one_of(trans, 'N', 'n', 'T', 't');
+}
+
+bool is_trans(char trans) {
+    return utils::one_of(trans, 'T', 't');
+}
+
+// Packs the public matrix B with a pair of the internal get_size and pack
+// functions, that take the same arguments except for the output
+template <typename src_t, typename dst_t, typename get_size_f,
+        typename pack_f>
+status_t pack_b(packed_matrix_t **packed_b, packed_matrix_t::kind_t kind,
+        char transa, char transb, dim_t M, dim_t N, dim_t K, const src_t *B,
+        dim_t ldb, get_size_f get_size, pack_f pack) {
+    if (utils::any_null(packed_b, B)) return status::invalid_arguments;
+    *packed_b = nullptr;
+
+    const int max_dim = std::numeric_limits<int>::max();
+    bool ok = is_trans_valid(transa) && is_trans_valid(transb) && M > 0
+            && N > 0 && K > 0 && M <= max_dim && N <= max_dim && K <= max_dim
+            && ldb >= (is_trans(transb) ? K : N) && ldb <= max_dim;
+    if (!ok) return status::invalid_arguments;
+
+    // Transposed column-major problem: C**T = B**T * A**T. The leading
+    // dimension of the matrix A is not known yet, the smallest valid one is
+    // passed instead.
+    const int m_s32 = (int)N, n_s32 = (int)M, k_s32 = (int)K;
+    const int lda_s32 = (int)ldb;
+    const int ldb_s32 = is_trans(transa) ? n_s32 : k_s32;
+
+    std::unique_ptr<packed_matrix_t> p(
+            new packed_matrix_t(kind, transa, transb, (int)N, (int)K));
+    status_t status = get_size("A", &transb, &transa, &m_s32, &n_s32, &k_s32,
+            &lda_s32, &ldb_s32, &p->size, nullptr);
+    if (status != status::success) return status;
+
+    p->data = dnnl::impl::malloc(p->size, 64);
+    if (p->data == nullptr) return status::out_of_memory;
+
+    status = pack("A", &transb, &transa, &m_s32, &n_s32, &k_s32, &lda_s32,
+            &ldb_s32, (const dst_t *)B, (dst_t *)p->data);
+    if (status != status::success) return status;
+
+    *packed_b = p.release();
+    return status::success;
+}
+
+status_t check_packed_input(packed_matrix_t::kind_t kind, char transa,
+        dim_t M, dim_t N, dim_t K, const void *A, dim_t lda,
+        const packed_matrix_t *packed_b, const void *C, dim_t ldc) {
+    if (utils::any_null(A, packed_b, C)) return status::invalid_arguments;
+    const int max_dim = std::numeric_limits<int>::max();
+    bool ok = packed_b->kind == kind && packed_b->N == N && packed_b->K == K
+            && utils::one_of(transa, packed_b->transa,
+                    is_trans(packed_b->transa) ? 'T' : 'N',
+                    is_trans(packed_b->transa) ? 't' : 'n')
+            && M >= 0 && M <= max_dim
+            && lda >= nstl::max<dim_t>(1, is_trans(transa) ? M : K)
+            && lda <= max_dim && ldc >= N && ldc <= max_dim;
+    return ok ? status::success : status::invalid_arguments;
+}
+
+} // namespace
+
+status_t dnnl_sgemm_pack_b(packed_matrix_t **packed_b, char transa,
+        char transb, dim_t M, dim_t N, dim_t K, const float *B, dim_t ldb) {
+    return pack_b<float, float>(packed_b, packed_matrix_t::f32, transa, transb,
+            M, N, K, B, ldb, sgemm_pack_get_size, sgemm_pack);
+}
+
+status_t dnnl_gemm_bf16bf16f32_pack_b(packed_matrix_t **packed_b,
+        char transa, char transb, dim_t M, dim_t N, dim_t K,
+        const uint16_t *B, dim_t ldb) {
+    return pack_b<uint16_t, bfloat16_t>(packed_b, packed_matrix_t::bf16,
+            transa, transb, M, N, K, B, ldb, gemm_bf16bf16f32_pack_get_size,
+            gemm_bf16bf16f32_pack);
+}
+
+status_t dnnl_gemm_u8s8s32_pack_b(packed_matrix_t **packed_b, char transa,
+        char transb, dim_t M, dim_t N, dim_t K, const int8_t *B, dim_t ldb) {
+    return pack_b<int8_t, void>(packed_b, packed_matrix_t::u8s8s32, transa,
+            transb, M, N, K, B, ldb, gemm_s8u8s32_pack_get_size,
+            gemm_s8u8s32_pack);
+}
+
+status_t dnnl_gemm_s8s8s32_pack_b(packed_matrix_t **packed_b, char transa,
+        char transb, dim_t M, dim_t N, dim_t K, const int8_t *B, dim_t ldb) {
+    return pack_b<int8_t, void>(packed_b, packed_matrix_t::s8s8s32, transa,
+            transb, M, N, K, B, ldb, gemm_s8s8s32_pack_get_size,
+            gemm_s8s8s32_pack);
+}
+
+status_t dnnl_packed_matrix_get_size(
+        const packed_matrix_t *packed_matrix, size_t *size) {
+    if (utils::any_null(packed_matrix, size)) return status::invalid_arguments;
+    *size = packed_matrix->size;
+    return status::success;
+}
+
+status_t dnnl_packed_matrix_destroy(packed_matrix_t *packed_matrix) {
+    delete packed_matrix;
+    return status::success;
+}
+
+status_t dnnl_sgemm_compute(char transa, dim_t M, dim_t N, dim_t K,
+        const float *A, dim_t lda, const packed_matrix_t *packed_b, float beta,
+        float *C, dim_t ldc) {
+    status_t status = check_packed_input(packed_matrix_t::f32, transa, M, N,
+            K, A, lda, packed_b, C, ldc);
+    if (status != status::success || M == 0) return status;
+
+    const int m_s32 = (int)N, n_s32 = (int)M, k_s32 = (int)K;
+    const int lda_s32 = m_s32, ldb_s32 = (int)lda, ldc_s32 = (int)ldc;
+    return sgemm_compute("P", &transa, &m_s32, &n_s32, &k_s32,
+            (const float *)packed_b->data, &lda_s32, A, &ldb_s32, &beta, C,
+            &ldc_s32);
+}
+
+status_t dnnl_gemm_bf16bf16f32_compute(char transa, dim_t M, dim_t N,
+        dim_t K, const uint16_t *A, dim_t lda, const packed_matrix_t *packed_b,
+        float beta, float *C, dim_t ldc) {
+    status_t status = check_packed_input(packed_matrix_t::bf16, transa, M, N,
+            K, A, lda, packed_b, C, ldc);
+    if (status != status::success || M == 0) return status;
+
+    const int m_s32 = (int)N, n_s32 = (int)M, k_s32 = (int)K;
+    const int lda_s32 = m_s32, ldb_s32 = (int)lda, ldc_s32 = (int)ldc;
+    return gemm_bf16bf16f32_compute("P", &transa, &m_s32, &n_s32, &k_s32,
+            (const bfloat16_t *)packed_b->data, &lda_s32,
+            (const bfloat16_t *)A, &ldb_s32, &beta, C, &ldc_s32);
+}
+
+namespace {
+// The offset of the column-major matrix C of the transposed problem
+const char *transposed_offsetc(char offsetc) {
+    switch (offsetc) {
+        case 'F':
+        case 'f': return "F";
+        case 'R':
+        case 'r': return "C";
+        case 'C':
+        case 'c': return "R";
+        default: return nullptr;
+    }
+}
+} // namespace
+
+status_t dnnl_gemm_u8s8s32_compute(char transa, char offsetc, dim_t M,
+        dim_t N, dim_t K, const uint8_t *A, dim_t lda,
+        const packed_matrix_t *packed_b, float beta, int32_t *C, dim_t ldc,
+        const int32_t *co) {
+    status_t status = check_packed_input(packed_matrix_t::u8s8s32, transa, M,
+            N, K, A, lda, packed_b, C, ldc);
+    if (status != status::success) return status;
+    const char *offsetc_t = transposed_offsetc(offsetc);
+    if (utils::any_null(offsetc_t, co)) return status::invalid_arguments;
+    if (M == 0) return status::success;
+
+    const int m_s32 = (int)N, n_s32 = (int)M, k_s32 = (int)K;
+    const int lda_s32 = m_s32, ldb_s32 = (int)lda, ldc_s32 = (int)ldc;
+    return gemm_s8u8s32_compute("P", &transa, offsetc_t, &m_s32, &n_s32,
+            &k_s32, (const int8_t *)packed_b->data, &lda_s32, A, &ldb_s32,
+            &beta, C, &ldc_s32, co);
+}
+
+status_t dnnl_gemm_s8s8s32_compute(char transa, char offsetc, dim_t M,
+        dim_t N, dim_t K, const int8_t *A, dim_t lda,
+        const packed_matrix_t *packed_b, float beta, int32_t *C, dim_t ldc,
+        const int32_t *co) {
+    status_t status = check_packed_input(packed_matrix_t::s8s8s32, transa, M,
+            N, K, A, lda, packed_b, C, ldc);
+    if (status != status::success) return status;
+    const char *offsetc_t = transposed_offsetc(offsetc);
+    if (utils::any_null(offsetc_t, co)) return status::invalid_arguments;
+    if (M == 0) return status::success;
+
+    const int m_s32 = (int)N, n_s32 = (int)M, k_s32 = (int)K;
+    const int lda_s32 = m_s32, ldb_s32 = (int)lda, ldc_s32 = (int)ldc;
+    return gemm_s8s8s32_compute("P", &transa, offsetc_t, &m_s32, &n_s32,
+            &k_s32, (const int8_t *)packed_b->data, &lda_s32, A, &ldb_s32,
+            &beta, C, &ldc_s32, co);
+}
@@ -56,6 +56,8 @@ gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(const pd_t *pd)
     , do_bias_(false)
     , do_eltwise_(false)
     , do_sum_(false)
+    , eltwise_idx_(-1)
+    , binary_(pd->attr()->post_ops_)
     , max_data_reg_idx_(31)
     , max_unroll_(12)
     , compute_reg_step_(1)
@@ -72,6 +74,7 @@ gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(const pd_t *pd)
     auto &post_ops = pd->attr()->post_ops_;
     const int eltwise_ind = post_ops.find(primitive_kind::eltwise);
     do_eltwise_ = eltwise_ind != -1;
+    eltwise_idx_ = eltwise_ind;
     if (do_eltwise_)
         eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                 this, post_ops.entry_[eltwise_ind].eltwise, true,
@@ -86,6 +89,7 @@ gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(const pd_t *pd)
 
     do_bias_ = pd->with_bias();
     if (do_bias_) vreg_bias = Zmm(data_reg_base_idx_++);
+    if (binary_.enabled()) vreg_binary_src1 = Zmm(data_reg_base_idx_++);
 
     vlen_ = cpu_isa_traits<avx512_common>::vlen / sizeof(float);
 
@@ -123,6 +127,19 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::generate() {
 
     if (do_sum_)
         vbroadcastss(vreg_sum_scale, ptr[reg_param + PARAM_OFF(sum_scale)]);
+
+    // All general purpose registers are taken, so the binary source pointer
+    // stays in the arguments and reg_param is kept intact
+    auto load_binary_src1 = [&]() {
+        mov(reg_tmp, ptr[reg_param + PARAM_OFF(binary_src1)]);
+        if (binary_.per_oc) {
+            mov(reg_rem_mask, ptr[reg_param + PARAM_OFF(oc_work)]);
+            sub(reg_rem_mask, reg_oc_iter);
+            vbroadcastss(vreg_binary_src1,
+                    ptr[reg_tmp + reg_rem_mask * sizeof(float)]);
+        } else
+            vbroadcastss(vreg_binary_src1, ptr[reg_tmp]);
+    };
 #undef PARAM_OFF
 
     // Load accumulated value, apply sum (if any), bias (if any)
@@ -160,7 +177,26 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::generate() {
             vfmadd231ps(vreg_dst(idx), vreg_prev_dst(idx), vreg_sum_scale);
         }
 
-        if (do_eltwise_) eltwise_injector_->compute_vector(vreg_dst_idx(idx));
+        auto compute_eltwise = [&]() {
+            if (do_eltwise_)
+                eltwise_injector_->compute_vector(vreg_dst_idx(idx));
+        };
+
+        auto compute_binary = [&]() {
+            if (!binary_.enabled()) return;
+            if (binary_.alg == alg_kind::binary_add)
+                vaddps(vreg_dst(idx), vreg_dst(idx), vreg_binary_src1);
+            else
+                vmulps(vreg_dst(idx), vreg_dst(idx), vreg_binary_src1);
+        };
+
+        if (binary_.enabled() && binary_.idx < eltwise_idx_) {
+            compute_binary();
+            compute_eltwise();
+        } else {
+            compute_eltwise();
+            compute_binary();
+        }
 
         if (dst_data_type == data_type::bf16) {
             // TODO: implement store by zmm registers for bf16
@@ -197,6 +233,7 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::generate() {
     mov(reg_acc, reg_acc_base);
 
     if (do_bias_) vbroadcastss(vreg_bias, ptr[reg_bias]);
+    if (binary_.enabled()) load_binary_src1();
 
     constexpr int n_unroll = default_unroll_2_pow_; // unroll by powers of 2
             // from 2^n to 2^0
@@ -249,8 +286,9 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::generate() {
 template <data_type_t dst_data_type>
 void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::operator()(
         dst_data_t *dst, const acc_data_t *acc, const acc_data_t *bias,
-        float sum_scale, size_t dst_stride_in_elements,
-        size_t acc_stride_in_elements, size_t len, bool do_parallel) {
+        float sum_scale, const float *binary_src1,
+        size_t dst_stride_in_elements, size_t acc_stride_in_elements,
+        size_t len, bool do_parallel) {
     assert(ker_);
     if (len == 0) return;
 
@@ -263,6 +301,7 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::operator()(
             args.dst = dst + start_oc * dst_stride_in_elements;
             args.bias = bias + start_oc;
             args.sum_scale = sum_scale;
+            args.binary_src1 = binary_src1 + (binary_.per_oc ? start_oc : 0);
             args.dst_stride_in_bytes
                     = dst_stride_in_elements * sizeof(dst_data_t);
             args.acc_stride_in_bytes
@@ -275,11 +314,12 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::operator()(
 }
 
 template <data_type_t dst_data_type>
-void gemm_bf16_convolution_fwd_t<dst_data_type>::execute_forward(
+status_t gemm_bf16_convolution_fwd_t<dst_data_type>::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     bool is_bf16_dst = dst_data_type == data_type::bf16;
 
@@ -378,7 +418,9 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::execute_forward(
             if (this->pd()->is_postprocess_required()) {
                 size_t acc_str = LDC;
                 size_t dst_str = M;
-                (*pp_ker_)(dst_local, _acc, bias + g * jcp.oc, sum_scale,
+                const float *s1 = binary_src1
+                        + (binary_po_.per_oc ? g * jcp.oc : 0);
+                (*pp_ker_)(dst_local, _acc, bias + g * jcp.oc, sum_scale, s1,
                         dst_str, acc_str, m, jcp.nthr == 1);
             }
 
@@ -386,6 +428,113 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::execute_forward(
                     owb, nb_ow);
         }
     });
+
+    return status::success;
+}
+
+template <data_type_t dst_data_type>
+status_t gemm_bf16_convolution_fwd_t<dst_data_type>::execute_forward_nspc(
+        const exec_ctx_t &ctx) const {
+    auto src_base = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    auto wei_base = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
+    auto dst_base = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
+
+    const bool is_bf16_dst = dst_data_type == data_type::bf16;
+
+    auto col_base = ctx.get_scratchpad_grantor().template get<src_data_t>(
+            key_conv_gemm_col);
+    acc_data_t *acc_base = is_bf16_dst
+            ? ctx.get_scratchpad_grantor().template get<acc_data_t>(
+                    key_conv_int_dat_in_acc_dt)
+            : nullptr;
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const float *bias = nullptr;
+    if (jcp.with_bias) {
+        if (pd()->desc()->bias_desc.data_type == data_type::bf16) {
+            auto bias_in = CTX_IN_MEM(const bfloat16_t *, DNNL_ARG_BIAS);
+            float *bias_cvt = ctx.get_scratchpad_grantor().template get<float>(
+                    key_conv_bias_bf16_convert_wsp);
+            cvt_bfloat16_to_float(bias_cvt, bias_in, jcp.ngroups * jcp.oc);
+            bias = bias_cvt;
+        } else
+            bias = CTX_IN_MEM(const float *, DNNL_ARG_BIAS);
+    }
+
+    const auto &post_ops = pd()->attr()->post_ops_;
+    const bool do_sum = is_bf16_dst && post_ops.contain(primitive_kind::sum, 0);
+    const float sum_scale = do_sum ? post_ops.entry_[0].sum.scale : 0;
+    const bool do_postprocess
+            = is_bf16_dst || bias || eltwise_ || binary_po_.enabled();
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const int LDB = jcp.im2col_sz ? K : jcp.ngroups * jcp.ic;
+    const int LDC = is_bf16_dst ? jcp.oc : LDA;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * jcp.ngroups * jcp.ic;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+
+    const int nb_os = div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * nb_os * jcp.ngroups;
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        src_data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+
+        int n {0}, osb {0}, g {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, n, jcp.mb, osb, nb_os, g, jcp.ngroups);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int os_start = osb * jcp.os_block;
+            const int os_len = nstl::min(jcp.os_block, M - os_start);
+            const src_data_t *src = src_base + n * src_mb_stride + g * jcp.ic;
+            const wei_data_t *wei = wei_base + g * jcp.oc;
+            dst_data_t *dst = dst_base + n * dst_mb_stride
+                    + (size_t)os_start * LDA + g * jcp.oc;
+            acc_data_t *acc = is_bf16_dst
+                    ? acc_base + (ptrdiff_t)ithr * jcp.os_block * jcp.oc
+                    : (acc_data_t *)dst;
+
+            if (jcp.im2col_sz)
+                jit_gemm_convolution_utils::im2col_nspc<src_data_t>(
+                        jcp, src, col, os_start, os_len);
+
+            const acc_data_t one = 1.0;
+            gemm_bf16bf16f32("N", "N", &jcp.oc, &os_len, &K, &one, wei, &LDA,
+                    jcp.im2col_sz ? col : src + (size_t)os_start * LDB, &LDB,
+                    &this->beta_, acc, &LDC);
+
+            if (do_postprocess) {
+                const float *bia = bias ? bias + g * jcp.oc : nullptr;
+                const float *s1 = binary_src1
+                        + (binary_po_.per_oc ? g * jcp.oc : 0);
+                for (int os = 0; os < os_len; ++os) {
+                    const acc_data_t *a = acc + (size_t)os * LDC;
+                    dst_data_t *d = dst + (size_t)os * LDA;
+                    for (int oc = 0; oc < jcp.oc; ++oc) {
+                        float v = a[oc];
+                        if (bia) v += bia[oc];
+                        if (do_sum) v += sum_scale * (float)d[oc];
+                        for (int idx = 0; idx < post_ops.len_; ++idx) {
+                            const auto &e = post_ops.entry_[idx];
+                            if (e.is_eltwise(false))
+                                v = eltwise_->compute_scalar(v);
+                            else if (e.is_binary())
+                                v = binary_po_.compute_scalar(
+                                        v, s1[binary_po_.per_oc ? oc : 0]);
+                        }
+                        d[oc] = v;
+                    }
+                }
+            }
+            nd_iterator_step(n, jcp.mb, osb, nb_os, g, jcp.ngroups);
+        }
+    });
+
+    return status::success;
 }
 
 template <data_type_t diff_src_data_type>
@@ -468,6 +617,93 @@ void gemm_bf16_convolution_bwd_data_t<diff_src_data_type>::
     });
 }
 
+template <data_type_t diff_src_data_type>
+void gemm_bf16_convolution_bwd_data_t<diff_src_data_type>::
+        execute_backward_data_nspc(const exec_ctx_t &ctx) const {
+    auto diff_dst_base = CTX_IN_MEM(const diff_dst_data_t *, DNNL_ARG_DIFF_DST);
+    auto wei_base = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
+    auto diff_src_base = CTX_OUT_MEM(diff_src_data_t *, DNNL_ARG_DIFF_SRC);
+
+    const bool is_bf16_diff_src = diff_src_data_type == data_type::bf16;
+
+    auto col_base = ctx.get_scratchpad_grantor().template get<acc_data_t>(
+            key_conv_gemm_col);
+    acc_data_t *acc_base = is_bf16_diff_src
+            ? ctx.get_scratchpad_grantor().template get<acc_data_t>(
+                    key_conv_int_dat_in_acc_dt)
+            : nullptr;
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const size_t src_sp_stride = (size_t)jcp.ngroups * jcp.ic;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * src_sp_stride;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+
+    // the output of bf16 is accumulated in f32 with the channels dense
+    const size_t acc_sp_stride = is_bf16_diff_src ? jcp.ic : src_sp_stride;
+    const int LDC = jcp.im2col_sz ? K : (int)acc_sp_stride;
+
+    // the columns of an image are accumulated by the same thread
+    const int nb_os = jcp.im2col_sz ? 1 : div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * jcp.ngroups * nb_os;
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        acc_data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+
+        int n {0}, g {0}, osb {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, osb, nb_os);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const diff_dst_data_t *diff_dst
+                    = diff_dst_base + n * dst_mb_stride + g * jcp.oc;
+            const wei_data_t *wei = wei_base + g * jcp.oc;
+            diff_src_data_t *diff_src
+                    = diff_src_base + n * src_mb_stride + g * jcp.ic;
+            acc_data_t *acc = is_bf16_diff_src
+                    ? acc_base + (ptrdiff_t)ithr * jcp.id * jcp.is * jcp.ic
+                    : (acc_data_t *)diff_src;
+
+            const acc_data_t zero = 0.0, one = 1.0;
+            int sp_start = 0, sp_len = jcp.id * jcp.is;
+            if (jcp.im2col_sz) {
+                for (int is = 0; is < sp_len; ++is) {
+                    PRAGMA_OMP_SIMD()
+                    for (int ic = 0; ic < jcp.ic; ++ic)
+                        acc[is * acc_sp_stride + ic] = 0;
+                }
+                for (int os_start = 0; os_start < M;
+                        os_start += jcp.os_block) {
+                    const int os_len = nstl::min(jcp.os_block, M - os_start);
+                    gemm_bf16bf16f32("T", "N", &K, &os_len, &jcp.oc, &one, wei,
+                            &LDA, diff_dst + (size_t)os_start * LDA, &LDA,
+                            &zero, col, &LDC);
+                    jit_gemm_convolution_utils::col2im_nspc(
+                            jcp, col, acc, acc_sp_stride, os_start, os_len);
+                }
+            } else {
+                sp_start = osb * jcp.os_block;
+                sp_len = nstl::min(jcp.os_block, M - sp_start);
+                if (!is_bf16_diff_src) acc += (size_t)sp_start * LDC;
+                gemm_bf16bf16f32("T", "N", &K, &sp_len, &jcp.oc, &one, wei,
+                        &LDA, diff_dst + (size_t)sp_start * LDA, &LDA, &zero,
+                        acc, &LDC);
+            }
+
+            if (is_bf16_diff_src)
+                for (int is = 0; is < sp_len; ++is)
+                    cvt_float_to_bfloat16(
+                            (bfloat16_t *)diff_src
+                                    + (size_t)(sp_start + is) * src_sp_stride,
+                            acc + (size_t)is * acc_sp_stride, jcp.ic);
+            nd_iterator_step(n, jcp.mb, g, jcp.ngroups, osb, nb_os);
+        }
+    });
+}
+
 template <data_type_t diff_wei_data_type>
 void gemm_bf16_convolution_bwd_weights_t<
         diff_wei_data_type>::bf16_bwd_weights_reduction_par(int ithr_mb,
@@ -684,6 +920,129 @@ void gemm_bf16_convolution_bwd_weights_t<diff_wei_data_type>::
     }
 }
 
+template <data_type_t diff_wei_data_type>
+void gemm_bf16_convolution_bwd_weights_t<diff_wei_data_type>::
+        execute_backward_weights_nspc(const exec_ctx_t &ctx) const {
+    auto diff_dst_base = CTX_IN_MEM(const diff_dst_data_t *, DNNL_ARG_DIFF_DST);
+    auto src_base = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    auto diff_weights = CTX_OUT_MEM(diff_wei_data_t *, DNNL_ARG_DIFF_WEIGHTS);
+
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    auto col_base = scratchpad.template get<src_data_t>(key_conv_gemm_col);
+    auto wei_reduction
+            = scratchpad.template get<acc_data_t>(key_conv_wei_reduction);
+    auto bia_reduction
+            = scratchpad.template get<acc_data_t>(key_conv_bia_reduction);
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const int LDB = jcp.im2col_sz ? K : jcp.ngroups * jcp.ic;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * jcp.ngroups * jcp.ic;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+    const size_t weights_size = (size_t)jcp.ngroups * jcp.oc * K;
+    const size_t bias_size = (size_t)jcp.ngroups * jcp.oc;
+
+    const int nb_os = div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * nb_os;
+
+    // the threads are split between the blocks of output channels and the
+    // output points; each thread accumulates the weights and the bias of its
+    // channels into the copy shared by the threads of its output points
+    int nthr_os_used = jcp.nthr / jcp.nthr_oc;
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        const int nthr_oc = nstl::min(jcp.nthr_oc, nthr);
+        const int nthr_os = nthr / nthr_oc;
+        if (ithr == 0) nthr_os_used = nthr_os;
+        if (ithr >= nthr_oc * nthr_os) return;
+        const int ithr_oc = ithr % nthr_oc;
+        const int ithr_os = ithr / nthr_oc;
+
+        int oc_start {0}, oc_end {0};
+        balance211(div_up(jcp.oc, jcp.oc_block), nthr_oc, ithr_oc, oc_start,
+                oc_end);
+        oc_start *= jcp.oc_block;
+        oc_end = nstl::min(jcp.oc, oc_end * jcp.oc_block);
+        const int oc_len = oc_end - oc_start;
+
+        src_data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+        acc_data_t *wei_acc = wei_reduction + ithr_os * weights_size;
+        acc_data_t *bia_acc = bia_reduction + ithr_os * bias_size;
+
+        for (int k = 0; k < K; ++k)
+            for (int g = 0; g < jcp.ngroups; ++g)
+                for (int oc = oc_start; oc < oc_end; ++oc)
+                    wei_acc[(size_t)k * LDA + g * jcp.oc + oc] = 0;
+        if (jcp.with_bias)
+            for (int g = 0; g < jcp.ngroups; ++g)
+                for (int oc = oc_start; oc < oc_end; ++oc)
+                    bia_acc[g * jcp.oc + oc] = 0;
+
+        int n {0}, osb {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr_os, ithr_os, start, end);
+        nd_iterator_init(start, n, jcp.mb, osb, nb_os);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int os_start = osb * jcp.os_block;
+            const int os_len = nstl::min(jcp.os_block, M - os_start);
+            const diff_dst_data_t *diff_dst = diff_dst_base
+                    + n * dst_mb_stride + (size_t)os_start * LDA;
+
+            for (int g = 0; g < jcp.ngroups; ++g) {
+                const src_data_t *src
+                        = src_base + n * src_mb_stride + g * jcp.ic;
+                if (jcp.im2col_sz)
+                    jit_gemm_convolution_utils::im2col_nspc<src_data_t>(
+                            jcp, src, col, os_start, os_len);
+
+                const acc_data_t one = 1.0;
+                gemm_bf16bf16f32("N", "T", &oc_len, &K, &os_len, &one,
+                        diff_dst + g * jcp.oc + oc_start, &LDA,
+                        jcp.im2col_sz ? col : src + (size_t)os_start * LDB,
+                        &LDB, &one, wei_acc + g * jcp.oc + oc_start, &LDA);
+            }
+
+            if (jcp.with_bias)
+                for (int os = 0; os < os_len; ++os) {
+                    const diff_dst_data_t *d = diff_dst + (size_t)os * LDA;
+                    for (int g = 0; g < jcp.ngroups; ++g)
+                        for (int oc = oc_start; oc < oc_end; ++oc)
+                            bia_acc[g * jcp.oc + oc]
+                                    += (float)d[g * jcp.oc + oc];
+                }
+            nd_iterator_step(n, jcp.mb, osb, nb_os);
+        }
+    });
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start = 0, end = 0;
+        balance211(weights_size, nthr, ithr, start, end);
+        for (size_t s = start; s < end; ++s) {
+            acc_data_t dw = 0;
+            for (int i = 0; i < nthr_os_used; ++i)
+                dw += wei_reduction[i * weights_size + s];
+            diff_weights[s] = dw;
+        }
+    });
+
+    if (jcp.with_bias) {
+        const bool is_bf16_bias
+                = pd()->desc()->diff_bias_desc.data_type == data_type::bf16;
+        auto diff_bias = CTX_OUT_MEM(void *, DNNL_ARG_DIFF_BIAS);
+        for (size_t s = 0; s < bias_size; ++s) {
+            acc_data_t db = 0;
+            for (int i = 0; i < nthr_os_used; ++i)
+                db += bia_reduction[i * bias_size + s];
+            if (is_bf16_bias)
+                ((bfloat16_t *)diff_bias)[s] = db;
+            else
+                ((float *)diff_bias)[s] = db;
+        }
+    }
+}
+
 template struct gemm_bf16_convolution_fwd_t<data_type::f32>;
 template struct gemm_bf16_convolution_fwd_t<data_type::bf16>;
 template struct gemm_bf16_convolution_bwd_data_t<data_type::f32>;
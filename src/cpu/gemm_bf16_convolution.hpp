@@ -21,12 +21,14 @@
 #include "memory_tracking.hpp"
 
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 #include "cpu_engine.hpp"
 #include "cpu_reducer.hpp"
 #include "gemm/gemm.hpp"
 #include "gemm_convolution_utils.hpp"
 #include "jit_avx512_core_bf16cvt.hpp"
 #include "jit_uni_eltwise_injector.hpp"
+#include "ref_eltwise.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -53,6 +55,8 @@ struct gemm_bf16_convolution_fwd_t : public primitive_impl_t {
                             utils::one_of(desc()->bias_desc.data_type,
                                     data_type::bf16, data_type::f32))
                     && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values(
@@ -85,34 +89,27 @@ struct gemm_bf16_convolution_fwd_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
 
         bool post_ops_ok() const {
             auto const &po = attr()->post_ops_;
-            auto is_eltwise
-                    = [&](int idx) { return po.entry_[idx].is_eltwise(); };
-            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(); };
-
-            switch (po.len_) {
-                case 0: return true; // no post_ops
-                case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-                case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
-                default: return false;
-            }
-            return false;
+            return binary_post_op_t::sum_eltwise_binary_ok(po)
+                    && IMPLICATION(po.contain(primitive_kind::sum, 0),
+                            po.entry_[0].is_sum())
+                    && binary_post_op_t::post_ops_ok(po, *dst_md());
         }
     };
 
     gemm_bf16_convolution_fwd_t(const pd_t *apd)
-        : primitive_impl_t(apd), pp_ker_(nullptr) {
+        : primitive_impl_t(apd)
+        , pp_ker_(nullptr)
+        , eltwise_(nullptr)
+        , binary_po_(pd()->attr()->post_ops_) {
         const auto &post_ops = pd()->attr()->post_ops_;
         const acc_data_t one = 1.0, zero = 0.0;
         beta_ = dst_data_type == data_type::f32
@@ -120,11 +117,20 @@ struct gemm_bf16_convolution_fwd_t : public primitive_impl_t {
                 ? one
                 : zero;
 
-        if (this->pd()->is_postprocess_required())
+        // channels-last output is post-processed along the channels
+        const int eltwise_ind = post_ops.find(primitive_kind::eltwise);
+        if (pd()->jcp_.is_nspc) {
+            if (eltwise_ind != -1)
+                eltwise_ = new ref_eltwise_scalar_fwd_t(
+                        post_ops.entry_[eltwise_ind].eltwise);
+        } else if (this->pd()->is_postprocess_required())
             pp_ker_ = new pp_ker_t(this->pd());
     }
 
-    ~gemm_bf16_convolution_fwd_t() { delete pp_ker_; }
+    ~gemm_bf16_convolution_fwd_t() {
+        delete pp_ker_;
+        delete eltwise_;
+    }
 
     typedef typename prec_traits<dst_data_type>::type dst_data_t;
     typedef typename prec_traits<data_type::f32>::type acc_data_t;
@@ -132,12 +138,13 @@ struct gemm_bf16_convolution_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::bf16>::type wei_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return pd()->jcp_.is_nspc ? execute_forward_nspc(ctx)
+                                  : execute_forward(ctx);
     }
 
 private:
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
     class pp_ker_t : jit_generator {
@@ -151,8 +158,9 @@ private:
         }
 
         void operator()(dst_data_t *dst, const acc_data_t *acc,
-                const acc_data_t *bias, float sum_scale, size_t dst_str,
-                size_t acc_str, size_t len, bool do_parallel);
+                const acc_data_t *bias, float sum_scale,
+                const float *binary_src1, size_t dst_str, size_t acc_str,
+                size_t len, bool do_parallel);
 
     private:
         struct ker_args {
@@ -160,6 +168,7 @@ private:
             const acc_data_t *acc;
             const acc_data_t *bias;
             float sum_scale;
+            const float *binary_src1;
             size_t dst_stride_in_bytes;
             size_t acc_stride_in_bytes;
             size_t spatial_length;
@@ -187,7 +196,7 @@ private:
         Xbyak::Reg64 reserved_eltwise_gpr = r10;
         Xbyak::Opmask reserved_eltwise_maskr = k2;
 
-        Xbyak::Zmm vreg_sum_scale, vreg_bias;
+        Xbyak::Zmm vreg_sum_scale, vreg_bias, vreg_binary_src1;
 
         Xbyak::Zmm bf16_emu_reserv_1 = Xbyak::Zmm(27);
         Xbyak::Zmm bf16_emu_reserv_2 = Xbyak::Zmm(28);
@@ -202,6 +211,8 @@ private:
         bool do_bias_;
         bool do_eltwise_;
         bool do_sum_;
+        int eltwise_idx_;
+        binary_post_op_t binary_;
         int max_data_reg_idx_, max_unroll_, compute_reg_step_;
         int data_reg_base_idx_;
         size_t vlen_;
@@ -240,6 +251,8 @@ private:
 
     acc_data_t beta_;
     pp_ker_t *pp_ker_;
+    ref_eltwise_scalar_fwd_t *eltwise_;
+    binary_post_op_t binary_po_;
 };
 
 template <data_type_t diff_src_data_type>
@@ -260,6 +273,8 @@ struct gemm_bf16_convolution_bwd_data_t : public primitive_impl_t {
                     && expect_data_types(diff_src_data_type, data_type::bf16,
                             data_type::undef, data_type::bf16, data_type::f32)
                     && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values()
@@ -278,14 +293,11 @@ struct gemm_bf16_convolution_bwd_data_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
     };
 
@@ -297,12 +309,16 @@ struct gemm_bf16_convolution_bwd_data_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::bf16>::type wei_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_backward_data(ctx);
+        if (pd()->jcp_.is_nspc)
+            execute_backward_data_nspc(ctx);
+        else
+            execute_backward_data(ctx);
         return status::success;
     }
 
 private:
     void execute_backward_data(const exec_ctx_t &ctx) const;
+    void execute_backward_data_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 };
 
@@ -326,7 +342,10 @@ struct gemm_bf16_convolution_bwd_weights_t : public primitive_impl_t {
                     && IMPLICATION(with_bias(),
                             utils::one_of(desc()->diff_bias_desc.data_type,
                                     data_type::bf16, data_type::f32))
-                    && !has_zero_dim_memory() && attr()->has_default_values()
+                    && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
+                    && attr()->has_default_values()
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && memory_desc_matches_tag(*src_md(), dat_tag())
@@ -344,14 +363,11 @@ struct gemm_bf16_convolution_bwd_weights_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
     };
 
@@ -368,7 +384,10 @@ struct gemm_bf16_convolution_bwd_weights_t : public primitive_impl_t {
     typedef typename prec_traits<diff_wei_data_type>::type diff_wei_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_backward_weights(ctx);
+        if (pd()->jcp_.is_nspc)
+            execute_backward_weights_nspc(ctx);
+        else
+            execute_backward_weights(ctx);
         return status::success;
     }
 
@@ -379,6 +398,7 @@ private:
             diff_wei_data_t *weights_base) const;
 
     void execute_backward_weights(const exec_ctx_t &ctx) const;
+    void execute_backward_weights_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
     cpu_accumulator_1d_t<data_type::f32> *acc_ker_;
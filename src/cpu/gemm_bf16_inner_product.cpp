@@ -35,12 +35,13 @@ using namespace memory_tracking::names;
 using namespace dnnl::impl::cpu::bf16_support;
 
 template <data_type_t dst_data_type>
-void gemm_bf16_inner_product_fwd_t<dst_data_type>::execute_forward(
+status_t gemm_bf16_inner_product_fwd_t<dst_data_type>::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const int M = pd()->OC();
     const int N = pd()->MB();
@@ -65,9 +66,12 @@ void gemm_bf16_inner_product_fwd_t<dst_data_type>::execute_forward(
             size_t start = 0, end = 0;
             size_t work_size = M * N;
             balance211(work_size, nthr, ithr, start, end);
-            (*pp_kernel_)(dst, acc, bias, scales, start, end);
+            (*pp_kernel_)(dst, acc, bias, scales, start, end, 0, nullptr,
+                    binary_src1);
         });
     }
+
+    return status::success;
 }
 
 template <data_type_t diff_src_data_type>
@@ -68,16 +68,8 @@ struct gemm_bf16_inner_product_fwd_t : public primitive_impl_t {
     protected:
         bool post_ops_ok() const {
             auto const &po = attr()->post_ops_;
-            auto is_eltwise
-                    = [&](int idx) { return po.entry_[idx].is_eltwise(false); };
-            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(false); };
-            switch (po.len_) {
-                case 0: return true; // no post_ops
-                case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-                case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
-                default: return false;
-            }
-            return false;
+            return binary_post_op_t::sum_eltwise_binary_ok(po)
+                    && binary_post_op_t::post_ops_ok(po, *dst_md());
         }
 
         void init_scratchpad() {
@@ -92,13 +84,14 @@ struct gemm_bf16_inner_product_fwd_t : public primitive_impl_t {
 
     gemm_bf16_inner_product_fwd_t(const pd_t *apd)
         : primitive_impl_t(apd), pp_kernel_(nullptr) {
+        const auto &po = pd()->attr()->post_ops_;
         bool has_bias = pd()->with_bias(),
-             has_eltwise
-                = pd()->attr()->post_ops_.find(primitive_kind::eltwise) >= 0,
+             has_eltwise = po.find(primitive_kind::eltwise) >= 0,
+             has_binary = po.find(primitive_kind::binary) >= 0,
              has_sum_as_postops = !pd()->dst_is_acc_;
         postops_in_ip_ = false
                 || !pd()->dst_is_acc_ /* includes has_sum_as_postops */
-                || has_bias || has_eltwise;
+                || has_bias || has_eltwise || has_binary;
         if (postops_in_ip_)
             pp_kernel_ = new inner_product_utils::pp_kernel_t<data_type::f32,
                     dst_data_type>(apd, !has_sum_as_postops);
@@ -117,8 +110,7 @@ struct gemm_bf16_inner_product_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::bf16>::type wei_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return execute_forward(ctx);
     }
 
 private:
@@ -126,7 +118,7 @@ private:
     bool postops_in_ip_;
     float beta_;
 
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 };
 
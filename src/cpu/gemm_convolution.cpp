@@ -43,11 +43,13 @@ struct im_pos_t {
 };
 } // namespace
 
-void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+status_t gemm_convolution_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     auto col = ctx.get_scratchpad_grantor().get<data_t>(key_conv_gemm_col);
 
@@ -118,7 +120,17 @@ void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
                 // outermost "parallel". It is not good. Consider to use
                 // "parallel" here with number of threads passed as parameter
                 const int oc_start = curr.g * jcp.oc + curr.oc;
-                if (eltwise_) {
+                if (binary_po_.enabled()) {
+                    parallel_nd(step.oc, [&](const int oc) {
+                        data_t b = jcp.with_bias ? bias[oc_start + oc] : 0;
+                        data_t s1 = binary_src1[binary_po_.per_oc
+                                        ? oc_start + oc
+                                        : 0];
+                        data_t *d_ = _dst + oc * M;
+                        for (int oS = 0; oS < m; ++oS)
+                            d_[oS] = apply_post_ops(d_[oS] + b, s1);
+                    });
+                } else if (eltwise_) {
                     // fast branch for ReLU case
                     if (eltwise_->alg_ == alg_kind::eltwise_relu) {
                         parallel_nd(step.oc, [&](const int oc) {
@@ -198,6 +210,82 @@ void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
         else
             assert(!"Unknown loop order");
     });
+
+    return status::success;
+}
+
+status_t gemm_convolution_fwd_t::execute_forward_nspc(
+        const exec_ctx_t &ctx) const {
+    auto src_base = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
+    auto wei_base = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
+    auto bia_base = CTX_IN_MEM(const data_t *, DNNL_ARG_BIAS);
+    auto dst_base = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
+
+    auto col_base = ctx.get_scratchpad_grantor().get<data_t>(key_conv_gemm_col);
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const int LDB = jcp.im2col_sz ? K : jcp.ngroups * jcp.ic;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * jcp.ngroups * jcp.ic;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+
+    const int nb_os = div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * nb_os * jcp.ngroups;
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+
+        int n {0}, osb {0}, g {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, n, jcp.mb, osb, nb_os, g, jcp.ngroups);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int os_start = osb * jcp.os_block;
+            const int os_len = nstl::min(jcp.os_block, M - os_start);
+            const data_t *src = src_base + n * src_mb_stride + g * jcp.ic;
+            const data_t *wei = wei_base + g * jcp.oc;
+            data_t *dst = dst_base + n * dst_mb_stride
+                    + (size_t)os_start * LDA + g * jcp.oc;
+
+            if (jcp.im2col_sz)
+                jit_gemm_convolution_utils::im2col_nspc<data_t>(
+                        jcp, src, col, os_start, os_len);
+
+            const data_t one = 1.0;
+            extended_sgemm("N", "N", &jcp.oc, &os_len, &K, &one, wei, &LDA,
+                    jcp.im2col_sz ? col : src + (size_t)os_start * LDB, &LDB,
+                    &this->beta_, dst, &LDA);
+
+            if (jcp.with_bias || eltwise_ || binary_po_.enabled()) {
+                const data_t *bia
+                        = jcp.with_bias ? bia_base + g * jcp.oc : nullptr;
+                const data_t *s1 = binary_src1
+                        + (binary_po_.per_oc ? g * jcp.oc : 0);
+                for (int os = 0; os < os_len; ++os) {
+                    data_t *d = dst + (size_t)os * LDA;
+                    if (bia) {
+                        PRAGMA_OMP_SIMD()
+                        for (int oc = 0; oc < jcp.oc; ++oc)
+                            d[oc] += bia[oc];
+                    }
+                    if (binary_po_.enabled())
+                        for (int oc = 0; oc < jcp.oc; ++oc)
+                            d[oc] = apply_post_ops(
+                                    d[oc], s1[binary_po_.per_oc ? oc : 0]);
+                    else if (eltwise_)
+                        for (int oc = 0; oc < jcp.oc; ++oc)
+                            d[oc] = eltwise_->compute_scalar(d[oc]);
+                }
+            }
+            nd_iterator_step(n, jcp.mb, osb, nb_os, g, jcp.ngroups);
+        }
+    });
+
+    return status::success;
 }
 
 void gemm_convolution_bwd_data_t::execute_backward_data(
@@ -264,6 +352,69 @@ void gemm_convolution_bwd_data_t::execute_backward_data(
     });
 }
 
+void gemm_convolution_bwd_data_t::execute_backward_data_nspc(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst_base = CTX_IN_MEM(const data_t *, DNNL_ARG_DIFF_DST);
+    auto wei_base = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
+    auto diff_src_base = CTX_OUT_MEM(data_t *, DNNL_ARG_DIFF_SRC);
+
+    auto col_base = ctx.get_scratchpad_grantor().get<data_t>(key_conv_gemm_col);
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const int LDC = jcp.im2col_sz ? K : jcp.ngroups * jcp.ic;
+    const size_t src_sp_stride = (size_t)jcp.ngroups * jcp.ic;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * src_sp_stride;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+
+    // the columns of an image are accumulated by the same thread
+    const int nb_os = jcp.im2col_sz ? 1 : div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * jcp.ngroups * nb_os;
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+
+        int n {0}, g {0}, osb {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, osb, nb_os);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const data_t *diff_dst
+                    = diff_dst_base + n * dst_mb_stride + g * jcp.oc;
+            const data_t *wei = wei_base + g * jcp.oc;
+            data_t *diff_src = diff_src_base + n * src_mb_stride + g * jcp.ic;
+
+            const data_t zero = 0.0, one = 1.0;
+            if (jcp.im2col_sz) {
+                for (int is = 0; is < jcp.id * jcp.is; ++is) {
+                    PRAGMA_OMP_SIMD()
+                    for (int ic = 0; ic < jcp.ic; ++ic)
+                        diff_src[is * src_sp_stride + ic] = 0;
+                }
+                for (int os_start = 0; os_start < M;
+                        os_start += jcp.os_block) {
+                    const int os_len = nstl::min(jcp.os_block, M - os_start);
+                    extended_sgemm("T", "N", &K, &os_len, &jcp.oc, &one, wei,
+                            &LDA, diff_dst + (size_t)os_start * LDA, &LDA,
+                            &zero, col, &LDC);
+                    jit_gemm_convolution_utils::col2im_nspc(jcp, col,
+                            diff_src, src_sp_stride, os_start, os_len);
+                }
+            } else {
+                const int os_start = osb * jcp.os_block;
+                const int os_len = nstl::min(jcp.os_block, M - os_start);
+                extended_sgemm("T", "N", &K, &os_len, &jcp.oc, &one, wei, &LDA,
+                        diff_dst + (size_t)os_start * LDA, &LDA, &zero,
+                        diff_src + (size_t)os_start * LDC, &LDC);
+            }
+            nd_iterator_step(n, jcp.mb, g, jcp.ngroups, osb, nb_os);
+        }
+    });
+}
+
 void gemm_convolution_bwd_weights_t::execute_backward_weights(
         const exec_ctx_t &ctx) const {
     auto diff_dst = CTX_IN_MEM(const data_t *, DNNL_ARG_DIFF_DST);
@@ -404,6 +555,120 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights(
     }
 }
 
+void gemm_convolution_bwd_weights_t::execute_backward_weights_nspc(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst_base = CTX_IN_MEM(const data_t *, DNNL_ARG_DIFF_DST);
+    auto src_base = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
+    auto diff_weights = CTX_OUT_MEM(data_t *, DNNL_ARG_DIFF_WEIGHTS);
+    auto diff_bias = CTX_OUT_MEM(data_t *, DNNL_ARG_DIFF_BIAS);
+
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    auto col_base = scratchpad.get<data_t>(key_conv_gemm_col);
+    auto wei_reduction = scratchpad.get<data_t>(key_conv_wei_reduction);
+    auto bia_reduction = scratchpad.get<data_t>(key_conv_bia_reduction);
+
+    const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
+
+    const int M = jcp.od * jcp.os;
+    const int K = jcp.ic * jcp.ks;
+    const int LDA = jcp.ngroups * jcp.oc;
+    const int LDB = jcp.im2col_sz ? K : jcp.ngroups * jcp.ic;
+    const size_t src_mb_stride = (size_t)jcp.id * jcp.is * jcp.ngroups * jcp.ic;
+    const size_t dst_mb_stride = (size_t)M * jcp.ngroups * jcp.oc;
+    const size_t weights_size = (size_t)jcp.ngroups * jcp.oc * K;
+    const size_t bias_size = (size_t)jcp.ngroups * jcp.oc;
+
+    const int nb_os = div_up(M, jcp.os_block);
+    const size_t work_amount = (size_t)jcp.mb * nb_os;
+
+    // the threads are split between the blocks of output channels and the
+    // output points; each thread accumulates the weights and the bias of its
+    // channels into the copy shared by the threads of its output points
+    int nthr_os_used = jcp.nthr / jcp.nthr_oc;
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        const int nthr_oc = nstl::min(jcp.nthr_oc, nthr);
+        const int nthr_os = nthr / nthr_oc;
+        if (ithr == 0) nthr_os_used = nthr_os;
+        if (ithr >= nthr_oc * nthr_os) return;
+        const int ithr_oc = ithr % nthr_oc;
+        const int ithr_os = ithr / nthr_oc;
+
+        int oc_start {0}, oc_end {0};
+        balance211(div_up(jcp.oc, jcp.oc_block), nthr_oc, ithr_oc, oc_start,
+                oc_end);
+        oc_start *= jcp.oc_block;
+        oc_end = nstl::min(jcp.oc, oc_end * jcp.oc_block);
+        const int oc_len = oc_end - oc_start;
+
+        data_t *col = col_base + (ptrdiff_t)ithr * jcp.im2col_sz;
+        data_t *wei_acc = wei_reduction + ithr_os * weights_size;
+        data_t *bia_acc = bia_reduction + ithr_os * bias_size;
+
+        for (int k = 0; k < K; ++k)
+            for (int g = 0; g < jcp.ngroups; ++g)
+                for (int oc = oc_start; oc < oc_end; ++oc)
+                    wei_acc[(size_t)k * LDA + g * jcp.oc + oc] = 0;
+        if (jcp.with_bias)
+            for (int g = 0; g < jcp.ngroups; ++g)
+                for (int oc = oc_start; oc < oc_end; ++oc)
+                    bia_acc[g * jcp.oc + oc] = 0;
+
+        int n {0}, osb {0};
+        size_t start = 0, end = 0;
+        balance211(work_amount, nthr_os, ithr_os, start, end);
+        nd_iterator_init(start, n, jcp.mb, osb, nb_os);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int os_start = osb * jcp.os_block;
+            const int os_len = nstl::min(jcp.os_block, M - os_start);
+            const data_t *diff_dst = diff_dst_base + n * dst_mb_stride
+                    + (size_t)os_start * LDA;
+
+            for (int g = 0; g < jcp.ngroups; ++g) {
+                const data_t *src = src_base + n * src_mb_stride + g * jcp.ic;
+                if (jcp.im2col_sz)
+                    jit_gemm_convolution_utils::im2col_nspc<data_t>(
+                            jcp, src, col, os_start, os_len);
+
+                const data_t one = 1.0;
+                extended_sgemm("N", "T", &oc_len, &K, &os_len, &one,
+                        diff_dst + g * jcp.oc + oc_start, &LDA,
+                        jcp.im2col_sz ? col : src + (size_t)os_start * LDB,
+                        &LDB, &one, wei_acc + g * jcp.oc + oc_start, &LDA);
+            }
+
+            if (jcp.with_bias)
+                for (int os = 0; os < os_len; ++os) {
+                    const data_t *d = diff_dst + (size_t)os * LDA;
+                    for (int g = 0; g < jcp.ngroups; ++g) {
+                        PRAGMA_OMP_SIMD()
+                        for (int oc = oc_start; oc < oc_end; ++oc)
+                            bia_acc[g * jcp.oc + oc] += d[g * jcp.oc + oc];
+                    }
+                }
+            nd_iterator_step(n, jcp.mb, osb, nb_os);
+        }
+    });
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start = 0, end = 0;
+        balance211(weights_size, nthr, ithr, start, end);
+        for (int i = 0; i < nthr_os_used; ++i) {
+            const data_t *ws_i = wei_reduction + i * weights_size;
+            PRAGMA_OMP_SIMD()
+            for (size_t s = start; s < end; ++s)
+                diff_weights[s] = (i == 0 ? 0 : diff_weights[s]) + ws_i[s];
+        }
+    });
+
+    if (jcp.with_bias)
+        for (size_t s = 0; s < bias_size; ++s) {
+            data_t db = 0;
+            for (int i = 0; i < nthr_os_used; ++i)
+                db += bia_reduction[i * bias_size + s];
+            diff_bias[s] = db;
+        }
+}
+
 } // namespace cpu
 } // namespace impl
 } // namespace dnnl
@@ -25,6 +25,7 @@
 #include "ref_eltwise.hpp"
 
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -47,6 +48,8 @@ struct gemm_convolution_fwd_t : public primitive_impl_t {
                     && expect_data_types(data_type::f32, data_type::f32,
                             data_type::f32, data_type::f32, data_type::f32)
                     && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values(
@@ -67,34 +70,27 @@ struct gemm_convolution_fwd_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
 
         bool post_ops_ok() const {
             auto const &po = attr()->post_ops_;
-            auto is_eltwise
-                    = [&](int idx) { return po.entry_[idx].is_eltwise(); };
-            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(); };
-
-            switch (po.len_) {
-                case 0: return true; // no post_ops
-                case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-                case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
-                default: return false;
-            }
-            return false;
+            // sum is done by gemm with beta = 1, so its scale must be 1
+            return binary_post_op_t::sum_eltwise_binary_ok(po)
+                    && IMPLICATION(po.contain(primitive_kind::sum, 0),
+                            po.entry_[0].is_sum())
+                    && binary_post_op_t::post_ops_ok(po, *dst_md());
         }
     };
 
     gemm_convolution_fwd_t(const pd_t *apd)
-        : primitive_impl_t(apd), eltwise_(nullptr) {
+        : primitive_impl_t(apd)
+        , eltwise_(nullptr)
+        , binary_po_(pd()->attr()->post_ops_) {
         const auto &post_ops = pd()->attr()->post_ops_;
         const data_t one = 1.0, zero = 0.0;
         beta_ = post_ops.find(primitive_kind::sum) >= 0 ? one : zero;
@@ -110,17 +106,32 @@ struct gemm_convolution_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::f32>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return pd()->jcp_.is_nspc ? execute_forward_nspc(ctx)
+                                  : execute_forward(ctx);
     }
 
 private:
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
+    // applies eltwise and binary post-ops in the order of the attributes,
+    // sum is done by gemm
+    data_t apply_post_ops(data_t d, data_t binary_src1) const {
+        const auto &po = pd()->attr()->post_ops_;
+        for (int idx = 0; idx < po.len_; ++idx) {
+            if (po.entry_[idx].is_eltwise(false))
+                d = eltwise_->compute_scalar(d);
+            else if (po.entry_[idx].is_binary())
+                d = binary_po_.compute_scalar(d, binary_src1);
+        }
+        return d;
+    }
+
     data_t beta_;
 
     ref_eltwise_scalar_fwd_t *eltwise_;
+    binary_post_op_t binary_po_;
 };
 
 struct gemm_convolution_bwd_data_t : public primitive_impl_t {
@@ -140,6 +151,8 @@ struct gemm_convolution_bwd_data_t : public primitive_impl_t {
                     && expect_data_types(data_type::f32, data_type::f32,
                             data_type::undef, data_type::f32, data_type::f32)
                     && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values()
@@ -158,14 +171,11 @@ struct gemm_convolution_bwd_data_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
     };
 
@@ -174,12 +184,16 @@ struct gemm_convolution_bwd_data_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::f32>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_backward_data(ctx);
+        if (pd()->jcp_.is_nspc)
+            execute_backward_data_nspc(ctx);
+        else
+            execute_backward_data(ctx);
         return status::success;
     }
 
 private:
     void execute_backward_data(const exec_ctx_t &ctx) const;
+    void execute_backward_data_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 };
 
@@ -200,6 +214,8 @@ struct gemm_convolution_bwd_weights_t : public primitive_impl_t {
                     && expect_data_types(data_type::f32, data_type::f32,
                             data_type::f32, data_type::f32, data_type::f32)
                     && !has_zero_dim_memory()
+                    // no weights layout for grouped 1D and 3D nspc cases
+                    && wei_tag() != format_tag::undef
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values()
@@ -218,14 +234,11 @@ struct gemm_convolution_bwd_weights_t : public primitive_impl_t {
 
     protected:
         format_tag_t dat_tag() const {
-            using namespace format_tag;
-            return utils::pick(ndims() - 3, ncw, nchw, ncdhw);
+            return jit_gemm_convolution_utils::dat_tag(this);
         }
 
         format_tag_t wei_tag() const {
-            using namespace format_tag;
-            return with_groups() ? utils::pick(ndims() - 3, goiw, goihw, goidhw)
-                                 : utils::pick(ndims() - 3, oiw, oihw, oidhw);
+            return jit_gemm_convolution_utils::wei_tag(this);
         }
     };
 
@@ -234,12 +247,16 @@ struct gemm_convolution_bwd_weights_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::f32>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_backward_weights(ctx);
+        if (pd()->jcp_.is_nspc)
+            execute_backward_weights_nspc(ctx);
+        else
+            execute_backward_weights(ctx);
         return status::success;
     }
 
 private:
     void execute_backward_weights(const exec_ctx_t &ctx) const;
+    void execute_backward_weights_nspc(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 };
 
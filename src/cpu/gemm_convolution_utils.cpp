@@ -293,8 +293,11 @@ template void im2col(const jit_gemm_conv_conf_t &jcp,
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T *__restrict imtr, uint8_t *__restrict col, int hs, int hb, int ws,
-        int wb) {
+        int wb, int32_t src_zero_point) {
     uint8_t shift = jcp.signed_input ? 128 : 0;
+    // the padded area holds the source zero point, so that it contributes
+    // nothing once the zero point compensation is applied
+    const uint8_t pad_val = (uint8_t)(shift + src_zero_point);
     const int dh = 1 + jcp.dilate_h;
     const int dw = 1 + jcp.dilate_w;
     const int sh = jcp.stride_h;
@@ -352,23 +355,23 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                     for (int oh = 0; oh < oh_start; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         for (int ow = 0; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad_val;
                     }
                     for (int oh = oh_start; oh < oh_end; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         const ptrdiff_t imtr_idx_oh = imtr_idx_ic + oh * iwb;
                         for (int ow = 0; ow < ow_start; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad_val;
                         for (int ow = ow_start; ow < ow_end; ++ow)
                             col[col_idx_oh + ow]
                                     = imtr[imtr_idx_oh + ow] + shift;
                         for (int ow = ow_end; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad_val;
                     }
                     for (int oh = oh_end; oh < hb; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         for (int ow = 0; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad_val;
                     }
                 }
             }
@@ -383,7 +386,7 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                             * wb;
                     if (ih < 0 || ih >= jcp.ih)
                         for (int ow = 0; ow < wb; ow++)
-                            col[col_idx_base + ow] = shift;
+                            col[col_idx_base + ow] = pad_val;
                     else {
                         const int wp = lp - kw * dw;
                         const int ow_start
@@ -391,7 +394,7 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                         const int ow_end
                                 = saturate(0, wb, div_up(jcp.iw + wp, sw) - ws);
                         for (int ow = 0; ow < ow_start; ow++)
-                            col[col_idx_base + ow] = shift;
+                            col[col_idx_base + ow] = pad_val;
                         const int iw_base = ws * sw - wp;
                         const ptrdiff_t im_idx_base = ih * im_ih_stride + ic;
                         for (int ow = ow_start; ow < ow_end; ow++) {
@@ -401,7 +404,7 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                             col[col_idx_base + ow] = im[im_idx] + shift;
                         }
                         for (int ow = ow_end; ow < wb; ow++)
-                            col[col_idx_base + ow] = shift;
+                            col[col_idx_base + ow] = pad_val;
                     }
                 });
     }
@@ -409,10 +412,12 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
 
 template void im2col_u8<int8_t>(const jit_gemm_conv_conf_t &jcp,
         const int8_t *__restrict im, int8_t *__restrict imtr,
-        uint8_t *__restrict col, int hs, int hb, int ws, int wb);
+        uint8_t *__restrict col, int hs, int hb, int ws, int wb,
+        int32_t src_zero_point);
 template void im2col_u8<uint8_t>(const jit_gemm_conv_conf_t &jcp,
         const uint8_t *__restrict im, uint8_t *__restrict imtr,
-        uint8_t *__restrict col, int hs, int hb, int ws, int wb);
+        uint8_t *__restrict col, int hs, int hb, int ws, int wb,
+        int32_t src_zero_point);
 
 /* im[ih][iw][ic] <-- col2im_s32(col[oh][ow][kh][kw][ic]) */
 void col2im_s32(const jit_gemm_conv_conf_t &jcp, const int32_t *__restrict col,
@@ -543,6 +548,122 @@ void col2im(const jit_gemm_conv_conf_t &jcp, const float *col, float *im) {
     });
 }
 
+/* col[sp][kd][kh][kw][ic] <-- im[id][ih][iw][g][ic], where sp goes over the
+ * output points [sp_start, sp_start + sp_len) and im points to the channels
+ * of the group; the output points are processed by the calling thread */
+template <typename data_type_t>
+void im2col_nspc(const jit_gemm_conv_conf_t &jcp,
+        const data_type_t *__restrict im, data_type_t *__restrict col,
+        int sp_start, int sp_len) {
+    const ptrdiff_t im_sp_stride = (ptrdiff_t)jcp.ngroups * jcp.ic;
+    const ptrdiff_t K = (ptrdiff_t)jcp.ks * jcp.ic;
+
+    int od {0}, oh {0}, ow {0};
+    nd_iterator_init(sp_start, od, jcp.od, oh, jcp.oh, ow, jcp.ow);
+    for (int sp = 0; sp < sp_len; ++sp) {
+        data_type_t *__restrict col_ = col + sp * K;
+        for (int kd = 0; kd < jcp.kd; ++kd) {
+            const int id = od * jcp.stride_d - jcp.f_pad
+                    + kd * (1 + jcp.dilate_d);
+            for (int kh = 0; kh < jcp.kh; ++kh) {
+                const int ih = oh * jcp.stride_h - jcp.t_pad
+                        + kh * (1 + jcp.dilate_h);
+                for (int kw = 0; kw < jcp.kw; ++kw) {
+                    const int iw = ow * jcp.stride_w - jcp.l_pad
+                            + kw * (1 + jcp.dilate_w);
+                    const bool is_pad = id < 0 || id >= jcp.id || ih < 0
+                            || ih >= jcp.ih || iw < 0 || iw >= jcp.iw;
+                    if (is_pad) {
+                        PRAGMA_OMP_SIMD()
+                        for (int ic = 0; ic < jcp.ic; ++ic)
+                            col_[ic] = (data_type_t)0;
+                    } else {
+                        const data_type_t *__restrict im_ = im
+                                + ((id * jcp.ih + ih) * jcp.iw + iw)
+                                        * im_sp_stride;
+                        PRAGMA_OMP_SIMD()
+                        for (int ic = 0; ic < jcp.ic; ++ic)
+                            col_[ic] = im_[ic];
+                    }
+                    col_ += jcp.ic;
+                }
+            }
+        }
+        nd_iterator_step(od, jcp.od, oh, jcp.oh, ow, jcp.ow);
+    }
+}
+
+template void im2col_nspc(const jit_gemm_conv_conf_t &jcp,
+        const float *__restrict im, float *__restrict col, int sp_start,
+        int sp_len);
+
+template void im2col_nspc(const jit_gemm_conv_conf_t &jcp,
+        const bfloat16_t *__restrict im, bfloat16_t *__restrict col,
+        int sp_start, int sp_len);
+
+/* im[id][ih][iw][ic] += col[sp][kd][kh][kw][ic], where the points of im are
+ * im_sp_stride elements apart; the output points are processed by the
+ * calling thread */
+void col2im_nspc(const jit_gemm_conv_conf_t &jcp, const float *__restrict col,
+        float *__restrict im, ptrdiff_t im_sp_stride, int sp_start,
+        int sp_len) {
+    const ptrdiff_t K = (ptrdiff_t)jcp.ks * jcp.ic;
+
+    int od {0}, oh {0}, ow {0};
+    nd_iterator_init(sp_start, od, jcp.od, oh, jcp.oh, ow, jcp.ow);
+    for (int sp = 0; sp < sp_len; ++sp) {
+        const float *__restrict col_ = col + sp * K;
+        for (int kd = 0; kd < jcp.kd; ++kd) {
+            const int id = od * jcp.stride_d - jcp.f_pad
+                    + kd * (1 + jcp.dilate_d);
+            for (int kh = 0; kh < jcp.kh; ++kh) {
+                const int ih = oh * jcp.stride_h - jcp.t_pad
+                        + kh * (1 + jcp.dilate_h);
+                for (int kw = 0; kw < jcp.kw; ++kw) {
+                    const int iw = ow * jcp.stride_w - jcp.l_pad
+                            + kw * (1 + jcp.dilate_w);
+                    const bool is_pad = id < 0 || id >= jcp.id || ih < 0
+                            || ih >= jcp.ih || iw < 0 || iw >= jcp.iw;
+                    if (!is_pad) {
+                        float *__restrict im_ = im
+                                + ((id * jcp.ih + ih) * jcp.iw + iw)
+                                        * im_sp_stride;
+                        PRAGMA_OMP_SIMD()
+                        for (int ic = 0; ic < jcp.ic; ++ic)
+                            im_[ic] += col_[ic];
+                    }
+                    col_ += jcp.ic;
+                }
+            }
+        }
+        nd_iterator_step(od, jcp.od, oh, jcp.oh, ow, jcp.ow);
+    }
+}
+
+format_tag_t dat_tag(const convolution_pd_t *pd) {
+    using namespace format_tag;
+    const int ndims = pd->ndims();
+    const format_tag_t nspc_tag = utils::pick(ndims - 3, nwc, nhwc, ndhwc);
+    const bool is_nspc = false
+            || memory_desc_matches_tag(*pd->invariant_src_md(), nspc_tag)
+            || memory_desc_matches_tag(*pd->invariant_dst_md(), nspc_tag);
+    return is_nspc ? nspc_tag : utils::pick(ndims - 3, ncw, nchw, ncdhw);
+}
+
+format_tag_t wei_tag(const convolution_pd_t *pd) {
+    using namespace format_tag;
+    const int ndims = pd->ndims();
+    const bool is_nspc = utils::one_of(dat_tag(pd), nwc, nhwc, ndhwc);
+    if (is_nspc) {
+        // there are no wigo and dhwigo tags, so the grouped 1D and 3D cases
+        // get format_tag::undef, which the primitive descriptors reject
+        if (pd->with_groups()) return ndims == 4 ? hwigo : format_tag::undef;
+        return utils::pick(ndims - 3, wio, hwio, dhwio);
+    }
+    return pd->with_groups() ? utils::pick(ndims - 3, goiw, goihw, goidhw)
+                             : utils::pick(ndims - 3, oiw, oihw, oidhw);
+}
+
 status_t init_conf(jit_gemm_conv_conf_t &jcp,
         memory_tracking::registrar_t &scratchpad, const convolution_desc_t &cd,
         const memory_desc_wrapper &src_d, const memory_desc_wrapper &weights_d,
@@ -590,6 +711,9 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
     jcp.ks = jcp.kh * jcp.kw * jcp.kd;
 
     jcp.signed_input = src_d.data_type() == data_type::s8;
+    jcp.is_nspc = src_d.matches_one_of_tag(
+                          format_tag::nwc, format_tag::nhwc, format_tag::ndhwc)
+            != format_tag::undef;
 
     jcp.im2col_sz
             = !everyone_is(true, jcp.ow == jcp.iw, jcp.oh == jcp.ih,
@@ -647,6 +771,64 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
     const int L2 = get_cache_size(2, true) / data_size;
     const int gemm_thrld = 64 * 1024;
 
+    if (jcp.is_nspc && !is_int8_conv) {
+        // Channels-last data are processed by blocks of output points. The
+        // columns of a block fit in L2 along with its output, and there are
+        // enough blocks to occupy all the threads.
+        const int K = jcp.ic * jcp.ks;
+        const int spatial = jcp.od * jcp.os;
+        const int outer_work = is_bwd_w ? jcp.mb : jcp.mb * jcp.ngroups;
+        jcp.os_block = nstl::max(simd_w, L2 / (K + jcp.oc));
+        jcp.os_block = nstl::min(jcp.os_block,
+                div_up(spatial, div_up(max_threads, outer_work)));
+        jcp.os_block = nstl::max(1, nstl::min(jcp.os_block, spatial));
+        if (jcp.im2col_sz) jcp.im2col_sz = (ptrdiff_t)K * jcp.os_block;
+
+        // backward by data accumulates the columns of an image in the same
+        // thread, unless they map to the input points one to one
+        const int nb_os = div_up(spatial, jcp.os_block);
+        const bool is_image_work = is_bwd_d && jcp.im2col_sz;
+        const size_t work_amount
+                = (size_t)outer_work * (is_image_work ? 1 : nb_os);
+        // backward by weights splits the output channels between the threads
+        // first, so that only the threads working on the same channels and
+        // different output points need private copies of the weights
+        if (is_bwd_w) {
+            jcp.oc_block = simd_w;
+            jcp.nthr_oc = nstl::min(max_threads, div_up(jcp.oc, simd_w));
+        }
+        jcp.nthr = jcp.nthr_oc
+                * (int)nstl::min<size_t>(
+                        max_threads / jcp.nthr_oc, work_amount);
+        jcp.outer_threading = true;
+
+        const size_t gemm_col_datatype_size = is_bf16_conv && !is_bwd_d
+                ? sizeof(bfloat16_t)
+                : sizeof(float);
+        scratchpad.book(key_conv_gemm_col,
+                gemm_col_datatype_size * jcp.nthr * jcp.im2col_sz);
+
+        if (is_fwd && is_bf16_to_bf16_conv)
+            scratchpad.book(key_conv_int_dat_in_acc_dt,
+                    sizeof(float) * jcp.nthr * jcp.os_block * jcp.oc);
+        if (is_bwd_d && is_bf16_to_bf16_conv)
+            scratchpad.book(key_conv_int_dat_in_acc_dt,
+                    sizeof(float) * jcp.nthr * jcp.id * jcp.is * jcp.ic);
+        if (is_bwd_w) {
+            const int nthr_os = jcp.nthr / jcp.nthr_oc;
+            jcp.need_wei_reduction = true;
+            scratchpad.book(key_conv_wei_reduction,
+                    sizeof(float) * nthr_os * weights_d.nelems());
+            if (jcp.with_bias)
+                scratchpad.book(key_conv_bia_reduction,
+                        sizeof(float) * nthr_os * jcp.ngroups * jcp.oc);
+        }
+        if (is_fwd && jcp.with_bias && cd.bias_desc.data_type == bf16)
+            scratchpad.book(key_conv_bias_bf16_convert_wsp,
+                    sizeof(float) * jcp.ngroups * jcp.oc);
+        return status::success;
+    }
+
     if (is_int8_conv) {
         if (is_fwd) {
             const int wei_size = jcp.oc * jcp.ic * jcp.kh * jcp.kw;
@@ -1071,9 +1253,12 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
 
         const int sizeof_cacheline_float = 16;
         if (is_bwd_w) {
+            // a thread accumulates into its own copy of the weights of a
+            // single group only if the images are split between threads
             jcp.need_wei_reduction = jcp.mb != 1 && jcp.nthr != 1;
-            scratchpad.book(key_conv_wei_reduction,
-                    sizeof(float) * jcp.nthr * weights_d.size());
+            if (jcp.need_wei_reduction)
+                scratchpad.book(key_conv_wei_reduction,
+                        sizeof(float) * jcp.nthr * jcp.ic * jcp.oc * jcp.ks);
         }
 
         if (is_bf16_to_bf16_conv) {
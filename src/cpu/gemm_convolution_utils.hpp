@@ -41,7 +41,7 @@ void im2col(const jit_gemm_conv_conf_t &jcp, const data_type_t *__restrict im,
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T *__restrict imtr, uint8_t *__restrict col, int hs, int hb, int ws,
-        int wb);
+        int wb, int32_t src_zero_point = 0);
 
 void col2im_s32(const jit_gemm_conv_conf_t &jcp, const int32_t *__restrict col,
         int32_t *__restrict im);
@@ -49,6 +49,20 @@ void col2im_3d(
         const jit_gemm_conv_conf_t &jcp, const float *col, float *im, int od);
 void col2im(const jit_gemm_conv_conf_t &jcp, const float *col, float *im);
 
+template <typename data_type_t>
+void im2col_nspc(const jit_gemm_conv_conf_t &jcp,
+        const data_type_t *__restrict im, data_type_t *__restrict col,
+        int sp_start, int sp_len);
+void col2im_nspc(const jit_gemm_conv_conf_t &jcp, const float *__restrict col,
+        float *__restrict im, ptrdiff_t im_sp_stride, int sp_start,
+        int sp_len);
+
+/* returns the channels-last data layout if the user data are channels-last
+ * and the plain channels-first layout otherwise */
+format_tag_t dat_tag(const convolution_pd_t *pd);
+/* returns the weights layout to use along with dat_tag(pd) */
+format_tag_t wei_tag(const convolution_pd_t *pd);
+
 status_t init_conf(jit_gemm_conv_conf_t &jcp,
         memory_tracking::registrar_t &scratchpad, const convolution_desc_t &cd,
         const memory_desc_wrapper &src_d, const memory_desc_wrapper &weights_d,
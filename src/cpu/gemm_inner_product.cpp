@@ -31,12 +31,13 @@ using namespace dnnl::impl::format_tag;
 using namespace dnnl::impl::primitive_kind;
 
 template <impl::data_type_t data_type>
-void gemm_inner_product_fwd_t<data_type>::execute_forward(
+status_t gemm_inner_product_fwd_t<data_type>::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const int MB = pd()->MB();
     const int OC = pd()->OC();
@@ -57,9 +58,12 @@ void gemm_inner_product_fwd_t<data_type>::execute_forward(
         parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
             size_t start, end;
             balance211((size_t)OC * MB, nthr, ithr, start, end);
-            (*pp_kernel_)(dst, dst, (char *)bias, scales, start, end);
+            (*pp_kernel_)(dst, dst, (char *)bias, scales, start, end, 0,
+                    nullptr, binary_src1);
         });
     }
+
+    return status::success;
 }
 
 template <impl::data_type_t data_type>
@@ -57,25 +57,18 @@ struct gemm_inner_product_fwd_t : public primitive_impl_t {
     protected:
         bool post_ops_ok() const {
             auto const &po = attr()->post_ops_;
-            auto is_eltwise
-                    = [&](int idx) { return po.entry_[idx].is_eltwise(false); };
-            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(false); };
-            switch (po.len_) {
-                case 0: return true; // no post_ops
-                case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-                case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
-                default: return false;
-            }
-            return false;
+            return binary_post_op_t::sum_eltwise_binary_ok(po)
+                    && binary_post_op_t::post_ops_ok(po, *dst_md());
         }
     };
 
     gemm_inner_product_fwd_t(const pd_t *apd)
         : primitive_impl_t(apd), pp_kernel_(nullptr), postops_in_ip_(false) {
+        const auto &po = pd()->attr()->post_ops_;
         bool has_bias = pd()->with_bias(),
-             has_eltwise
-                = pd()->attr()->post_ops_.find(primitive_kind::eltwise) >= 0;
-        postops_in_ip_ = has_bias || has_eltwise;
+             has_eltwise = po.find(primitive_kind::eltwise) >= 0,
+             has_binary = po.find(primitive_kind::binary) >= 0;
+        postops_in_ip_ = has_bias || has_eltwise || has_binary;
 
         pp_kernel_ = new inner_product_utils::pp_kernel_t<data_type, data_type>(
                 apd, true);
@@ -89,12 +82,11 @@ struct gemm_inner_product_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<data_type>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return execute_forward(ctx);
     }
 
 private:
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
     inner_product_utils::pp_kernel_t<data_type, data_type> *pp_kernel_;
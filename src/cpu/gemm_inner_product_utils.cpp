@@ -43,7 +43,11 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(size_t OC, size_t MB,
     , do_scale_(false)
     , scale_idx_mult_(0)
     , do_eltwise_(false)
+    , eltwise_idx_(-1)
     , do_sum_(false)
+    , sum_idx_(-1)
+    , binary_(attr->post_ops_)
+    , post_ops_len_(attr->post_ops_.len_)
     , do_dst_zero_points_(false)
     , sum_scale_(0)
     , isa_(isa_any)
@@ -53,6 +57,7 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(size_t OC, size_t MB,
     , compute_vregs_per_iter_(1)
     , compute_vreg_bias_shift_(0)
     , compute_vreg_prev_dst_shift_(0)
+    , compute_vreg_binary_shift_(0)
     , mb_blk_kernel(false) {
     using namespace types;
     using namespace Xbyak;
@@ -65,18 +70,25 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(size_t OC, size_t MB,
     if (dst_type == data_type::u8) vreg_zero = Zmm(idx_compute_vreg_start_++);
 
     auto &p = attr->post_ops_;
-    const int eltwise_ind = p.find(primitive_kind::eltwise);
-    do_eltwise_ = eltwise_ind != -1;
-    if (do_eltwise_) eltwise_ = p.entry_[eltwise_ind].eltwise;
+    eltwise_idx_ = p.find(primitive_kind::eltwise);
+    do_eltwise_ = eltwise_idx_ != -1;
+    if (do_eltwise_) eltwise_ = p.entry_[eltwise_idx_].eltwise;
 
-    const int sum_ind = p.find(primitive_kind::sum);
-    do_sum_ = sum_ind != -1 && !skip_sum;
+    sum_idx_ = p.find(primitive_kind::sum);
+    do_sum_ = sum_idx_ != -1 && !skip_sum;
     if (do_sum_) {
-        sum_scale_ = p.entry_[sum_ind].sum.scale;
+        sum_scale_ = p.entry_[sum_idx_].sum.scale;
         vreg_sum_scale = Zmm(idx_compute_vreg_start_++);
         compute_vreg_prev_dst_shift_ = compute_vregs_per_iter_++;
     }
 
+    if (binary_.enabled()) {
+        if (binary_.per_oc)
+            compute_vreg_binary_shift_ = compute_vregs_per_iter_++;
+        else
+            vreg_binary_src1_common = Zmm(idx_compute_vreg_start_++);
+    }
+
     if (do_bias()) {
         bias_data_type_size_ = data_type_size(bias_data_type_);
         compute_vreg_bias_shift_ = compute_vregs_per_iter_++;
@@ -176,7 +188,7 @@ void pp_kernel_t<acc_type, dst_type>::compute_oc_channel_blk() {
         if (do_scale_) vmulps(vreg_dst_, vreg_dst_, vreg_scale);
 
         auto dst_addr = ptr[reg_dst + offset * sizeof(dst_data_t)];
-        if (do_sum_) {
+        auto compute_sum = [&]() {
             auto vreg_prev_dst_ = vreg_prev_dst(idx);
             auto vreg_prev_dst_msk_ = apply_mask
                     ? vreg_prev_dst_ | kreg_rem_mask
@@ -204,10 +216,32 @@ void pp_kernel_t<acc_type, dst_type>::compute_oc_channel_blk() {
                 vcvtdq2ps(vreg_prev_dst_, vreg_prev_dst_);
 
             vfmadd231ps(vreg_dst_, vreg_prev_dst_, vreg_sum_scale);
+        };
+
+        auto compute_binary = [&]() {
+            auto vreg_src1_ = vreg_binary_src1_common;
+            if (binary_.per_oc) {
+                auto src1_addr = ptr[reg_binary_src1 + offset * sizeof(float)];
+                vreg_src1_ = vreg_binary_src1(idx);
+                vmovups(apply_mask ? vreg_src1_ | kreg_rem_mask : vreg_src1_,
+                        src1_addr);
+            }
+            if (binary_.alg == binary_add)
+                vaddps(vreg_dst_, vreg_dst_, vreg_src1_);
+            else
+                vmulps(vreg_dst_, vreg_dst_, vreg_src1_);
+        };
+
+        // post-ops are applied in the order of the attributes
+        for (int po_idx = 0; po_idx < post_ops_len_; ++po_idx) {
+            if (do_sum_ && po_idx == sum_idx_)
+                compute_sum();
+            else if (do_eltwise_ && po_idx == eltwise_idx_)
+                eltwise_injector_->compute_vector(vreg_dst_.getIdx());
+            else if (po_idx == binary_.idx)
+                compute_binary();
         }
 
-        if (do_eltwise_) eltwise_injector_->compute_vector(vreg_dst_.getIdx());
-
         if (do_dst_zero_points_)
             vaddps(vreg_dst_, vreg_dst_, vreg_dst_zero_points);
 
@@ -244,6 +278,7 @@ void pp_kernel_t<acc_type, dst_type>::compute_oc_channel_blk() {
         if (do_scale_ && scale_idx_mult_ == 1)
             add(reg_scales, offset * sizeof(float));
         if (do_bias()) add(reg_bias, offset * bias_data_type_size_);
+        if (binary_.per_oc) add(reg_binary_src1, offset * sizeof(float));
     };
 
     // Advance all pointers by a value stored in a register
@@ -254,16 +289,22 @@ void pp_kernel_t<acc_type, dst_type>::compute_oc_channel_blk() {
             lea(reg_scales, ptr[reg_scales + offset * sizeof(float)]);
         if (do_bias())
             lea(reg_bias, ptr[reg_bias + offset * bias_data_type_size_]);
+        if (binary_.per_oc)
+            lea(reg_binary_src1,
+                    ptr[reg_binary_src1 + offset * sizeof(float)]);
     };
 
     // Rewind pointers that point to data that is indexed by output channel
-    // (bias or per-oc scaling factors)
+    // (bias, per-oc scaling factors or binary post-op source)
     auto rewind_ptrs = [&]() {
         neg(reg_oc);
         if (do_bias())
             lea(reg_bias, ptr[reg_bias + reg_oc * bias_data_type_size_]);
         if (do_scale_ && scale_idx_mult_ == 1)
             lea(reg_scales, ptr[reg_scales + reg_oc * sizeof(float)]);
+        if (binary_.per_oc)
+            lea(reg_binary_src1,
+                    ptr[reg_binary_src1 + reg_oc * sizeof(float)]);
         neg(reg_oc);
     };
 
@@ -562,6 +603,11 @@ void pp_kernel_t<acc_type, dst_type>::generate() {
     mov(reg_oc_offset, ptr[reg_param + PARAM_OFF(oc_offset)]);
     if (do_scale_ && scale_idx_mult_ == 0)
         vbroadcastss(vreg_scale, dword[reg_scales]);
+    if (binary_.enabled()) {
+        mov(reg_binary_src1, ptr[reg_param + PARAM_OFF(binary_src1)]);
+        if (!binary_.per_oc)
+            vbroadcastss(vreg_binary_src1_common, dword[reg_binary_src1]);
+    }
 #undef PARAM_OFF
 
     if (do_sum_) {
@@ -576,8 +622,8 @@ void pp_kernel_t<acc_type, dst_type>::generate() {
     // at least 2 blocks of mb within vlen
     bool dim_restrict = !runtime_oc() && !runtime_mb() && (OC_ <= vlen / 2)
             && (MB_ >= vlen);
-    bool supported_postops
-            = do_scale_ || do_eltwise_ || do_sum_ || do_dst_zero_points_;
+    bool supported_postops = do_scale_ || do_eltwise_ || do_sum_
+            || do_dst_zero_points_ || binary_.enabled();
 
     if (do_bias() && !supported_postops && dim_restrict) {
         mb_blk_kernel = true;
@@ -597,7 +643,7 @@ template <data_type_t acc_type, data_type_t dst_type>
 void pp_kernel_t<acc_type, dst_type>::operator()(dst_data_t *dst,
         const acc_data_t *acc, const char *bias, const float *scales,
         size_t start, size_t end, size_t runtime_oc,
-        const float *dst_zero_points) {
+        const float *dst_zero_points, const float *binary_src1) {
     using math::get_bias;
 
     if (end <= start) return;
@@ -613,6 +659,7 @@ void pp_kernel_t<acc_type, dst_type>::operator()(dst_data_t *dst,
         args.bias = bias + oc_offset * bias_data_type_size_;
         args.scales = scales + scale_idx_mult_ * oc_offset;
         args.dst_zero_points = dst_zero_points;
+        args.binary_src1 = binary_src1 + (binary_.per_oc ? oc_offset : 0);
         args.oc = OC;
         args.len = end - start;
         args.oc_offset = oc_offset;
@@ -624,8 +671,15 @@ void pp_kernel_t<acc_type, dst_type>::operator()(dst_data_t *dst,
             float d = (float)acc[i];
             if (do_bias()) d += get_bias(bias, oc, bias_data_type_);
             if (do_scale_) d *= scales[oc * scale_idx_mult_];
-            if (do_sum_) d += sum_scale_ * dst[i];
-            if (do_eltwise_) d = ref_eltwise_->compute_scalar(d);
+            for (int po_idx = 0; po_idx < post_ops_len_; ++po_idx) {
+                if (do_sum_ && po_idx == sum_idx_)
+                    d += sum_scale_ * dst[i];
+                else if (do_eltwise_ && po_idx == eltwise_idx_)
+                    d = ref_eltwise_->compute_scalar(d);
+                else if (po_idx == binary_.idx)
+                    d = binary_.compute_scalar(
+                            d, binary_src1[binary_.per_oc ? oc : 0]);
+            }
             if (do_dst_zero_points_) d += dst_zero_points[0];
             dst[i] = qz_a1b0<float, dst_data_t>()(d);
             oc = (oc == OC - 1) ? 0 : oc + 1;
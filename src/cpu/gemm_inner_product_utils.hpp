@@ -20,6 +20,7 @@
 #include "c_types_map.hpp"
 #include "cpu_engine.hpp"
 #include "cpu_inner_product_pd.hpp"
+#include "cpu_primitive.hpp"
 #include "jit_avx512_core_bf16cvt.hpp"
 #include "jit_generator.hpp"
 #include "jit_uni_eltwise_injector.hpp"
@@ -56,7 +57,8 @@ public:
 
     void operator()(dst_data_t *dst, const acc_data_t *acc, const char *bias,
             const float *scales, size_t start, size_t end,
-            size_t runtime_oc = 0, const float *dst_zero_points = nullptr);
+            size_t runtime_oc = 0, const float *dst_zero_points = nullptr,
+            const float *binary_src1 = nullptr);
 
 private:
     void generate();
@@ -69,6 +71,7 @@ private:
         const char *bias;
         const float *scales;
         const float *dst_zero_points;
+        const float *binary_src1;
         float nslope;
         size_t oc;
         size_t len;
@@ -93,10 +96,12 @@ private:
     Xbyak::Reg64 reg_tmp = rcx; // intentional for shifting purposes
     Xbyak::Reg64 reg_oc_offset = r9;
     Xbyak::Reg64 reg_rem_mask = r10;
+    Xbyak::Reg64 reg_binary_src1 = r14;
     Xbyak::Opmask kreg_rem_mask = k1;
 
     // Will be assigned in constructor
     Xbyak::Zmm vreg_zero, vreg_scale, vreg_sum_scale, vreg_dst_zero_points;
+    Xbyak::Zmm vreg_binary_src1_common;
 
     Xbyak::Reg64 eltwise_reserved_1_ = r11;
     Xbyak::Opmask eltwise_reserved_2_ = k2;
@@ -114,8 +119,12 @@ private:
     bool do_scale_;
     size_t scale_idx_mult_;
     bool do_eltwise_;
+    int eltwise_idx_;
     post_ops_t::entry_t::eltwise_t eltwise_;
     bool do_sum_;
+    int sum_idx_;
+    binary_post_op_t binary_;
+    int post_ops_len_;
     bool do_dst_zero_points_;
     float sum_scale_;
     cpu_isa_t isa_;
@@ -124,6 +133,7 @@ private:
     int idx_compute_vreg_max_;
     int compute_vregs_per_iter_;
     int compute_vreg_bias_shift_, compute_vreg_prev_dst_shift_;
+    int compute_vreg_binary_shift_;
     bool mb_blk_kernel;
 
     const size_t vlen = cpu_isa_traits<avx512_core>::vlen / sizeof(float);
@@ -151,6 +161,13 @@ private:
         assert(idx <= idx_compute_vreg_max_);
         return Xbyak::Zmm(idx);
     };
+
+    Xbyak::Zmm vreg_binary_src1(int iter) {
+        int idx = idx_compute_vreg_start_ + iter * compute_vregs_per_iter_
+                + compute_vreg_binary_shift_;
+        assert(idx <= idx_compute_vreg_max_);
+        return Xbyak::Zmm(idx);
+    };
 };
 
 } // namespace inner_product_utils
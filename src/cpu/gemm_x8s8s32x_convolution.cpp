@@ -20,6 +20,7 @@
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
+#include "cpu_primitive.hpp"
 #include "simple_q10n.hpp"
 
 #include "gemm/gemm.hpp"
@@ -34,13 +35,17 @@ using namespace dnnl::impl::math;
 using namespace dnnl::impl::memory_tracking::names;
 
 template <data_type_t src_type, data_type_t dst_type>
-void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward(
+status_t _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src_base = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto wei_base = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bia_base = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
     auto dst_base = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
 
+    DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
+    DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
+
     auto scratchpad = ctx.get_scratchpad_grantor();
 
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
@@ -49,10 +54,34 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward(
             jcp.id != 1, jcp.oh_block == jcp.oh && jcp.ow_block == jcp.ow));
     assert(IMPLICATION(jcp.ow_block != jcp.ow, jcp.oh_block == 1));
 
+    // The s8s8 compensation and the source zero point compensation are
+    // stored after the weights. Both are merged into a single vector of
+    // offsets that gemm adds to each column of the result.
+    const ptrdiff_t offset = (ptrdiff_t)jcp.ngroups * jcp.ks * jcp.ic * jcp.oc;
+    const int32_t *wei_comp = (const int32_t *)(wei_base + offset);
+    if (src_zero_point != 0) {
+        if (src_zero_point < nstl::numeric_limits<src_data_t>::lowest()
+                || src_zero_point > nstl::numeric_limits<src_data_t>::max())
+            return status::invalid_arguments;
+
+        const int32_t *s8s8_comp = jcp.signed_input ? wei_comp : nullptr;
+        const int32_t *zp_comp = wei_comp
+                + (jcp.signed_input ? (ptrdiff_t)jcp.ngroups * jcp.oc : 0);
+        int32_t *comp = scratchpad.get<int32_t>(key_conv_gemm_zp_src_comp);
+        parallel_nd(jcp.ngroups * jcp.oc, [&](int i) {
+            comp[i] = src_zero_point * zp_comp[i]
+                    + (s8s8_comp ? s8s8_comp[i] : 0);
+        });
+        wei_comp = comp;
+    }
+
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
-        execute_forward_thr(
-                ithr, nthr, src_base, wei_base, bia_base, dst_base, scratchpad);
+        execute_forward_thr(ithr, nthr, src_base, wei_base, bia_base, dst_base,
+                wei_comp, src_zero_point, dst_zero_point, binary_src1,
+                scratchpad);
     });
+
+    return status::success;
 }
 
 template <data_type_t src_type, data_type_t dst_type>
@@ -68,6 +97,8 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
     , do_bias_(false)
     , do_eltwise_(false)
     , do_sum_(false)
+    , eltwise_idx_(-1)
+    , binary_(pd->attr()->post_ops_)
     , eltwise_injector_(nullptr)
     , eltwise_(nullptr) {
     using namespace types;
@@ -80,6 +111,8 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
     auto &post_ops = pd->attr()->post_ops_;
 
     do_signed_scaling_ = jcp_.signed_input;
+    do_dst_zero_point_
+            = !pd->attr()->zero_points_.has_default_values(DNNL_ARG_DST);
 
     do_sum_ = post_ops.contain(primitive_kind::sum, 0);
     do_bias_ = pd->with_bias();
@@ -100,6 +133,7 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
 
     const int eltwise_ind = post_ops.find(primitive_kind::eltwise);
     do_eltwise_ = eltwise_ind != -1;
+    eltwise_idx_ = eltwise_ind;
 
     if (!mayiuse(avx512_core)) {
         if (do_eltwise_) {
@@ -135,6 +169,7 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
     Reg64 reg_oc_offset = r9;
     Reg64 reg_rem_mask_short = r10;
     Reg64 reg_rem_mask_vlen = r11;
+    Reg64 reg_binary_src1 = r12;
     Opmask kreg_rem_mask_short = k1;
     Opmask kreg_rem_mask_vlen = k3;
 
@@ -145,6 +180,9 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
     Zmm vreg_nslope = Zmm(2);
     Zmm vreg_sum_scale = Zmm(3);
     Zmm vreg_signed_scale = Zmm(4);
+    // the unrolled computations below use at most Zmm(28)
+    Zmm vreg_dst_zero_point = Zmm(29);
+    Zmm vreg_binary_src1_common = Zmm(30);
 
     size_t def_unroll = 4;
     size_t max_unroll = 12;
@@ -167,9 +205,17 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
     mov(reg_scales, ptr[reg_param + PARAM_OFF(scales)]);
     mov(reg_len, ptr[reg_param + PARAM_OFF(len)]);
     mov(reg_oc_offset, ptr[reg_param + PARAM_OFF(oc_offset)]);
+    if (binary_.enabled()) {
+        mov(reg_binary_src1, ptr[reg_param + PARAM_OFF(binary_src1)]);
+        if (!binary_.per_oc)
+            vbroadcastss(vreg_binary_src1_common, dword[reg_binary_src1]);
+    }
     vbroadcastss(vreg_nslope, ptr[reg_param + PARAM_OFF(nslope)]);
     vbroadcastss(vreg_sum_scale, ptr[reg_param + PARAM_OFF(sum_scale)]);
     vbroadcastss(vreg_signed_scale, ptr[reg_param + PARAM_OFF(signed_scale)]);
+    if (do_dst_zero_point_)
+        vbroadcastss(vreg_dst_zero_point,
+                ptr[reg_param + PARAM_OFF(dst_zero_point)]);
     if (scale_idx_mult_ == 0) vbroadcastss(vreg_scale, dword[reg_scales]);
 
 #undef PARAM_OFF
@@ -253,10 +299,43 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
             vfmadd231ps(vreg_dst(idx), vreg_prev_dst(idx), vreg_sum_scale);
         }
 
-        if (do_eltwise_) {
-            eltwise_injector_->compute_vector(vreg_dst(idx).getIdx());
+        auto compute_eltwise = [&]() {
+            if (do_eltwise_)
+                eltwise_injector_->compute_vector(vreg_dst(idx).getIdx());
+        };
+
+        auto compute_binary = [&]() {
+            if (!binary_.enabled()) return;
+            // bias has already been applied, so its register is reused for
+            // the per-channel binary source
+            auto vreg_src1 = vreg_binary_src1_common;
+            if (binary_.per_oc) {
+                auto vreg_src1_ = vreg_bias(idx);
+                if (apply_mask)
+                    vreg_src1_ = vreg_src1_ | kreg_rem_mask_short;
+                else
+                    vreg_src1_ = vreg_src1_ | kreg_rem_mask_vlen;
+                vmovups(vreg_src1_,
+                        ptr[reg_binary_src1 + offset * sizeof(float)]);
+                vreg_src1 = vreg_bias(idx);
+            }
+            if (binary_.alg == alg_kind::binary_add)
+                vaddps(vreg_dst(idx), vreg_dst(idx), vreg_src1);
+            else
+                vmulps(vreg_dst(idx), vreg_dst(idx), vreg_src1);
+        };
+
+        if (binary_.enabled() && binary_.idx < eltwise_idx_) {
+            compute_binary();
+            compute_eltwise();
+        } else {
+            compute_eltwise();
+            compute_binary();
         }
 
+        if (do_dst_zero_point_)
+            vaddps(vreg_dst(idx), vreg_dst(idx), vreg_dst_zero_point);
+
         if (dst_type != data_type::f32) {
             vcvtps2dq(vreg_dst(idx), vreg_dst(idx));
         }
@@ -282,6 +361,7 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
             add(reg_scales, offset * sizeof(float));
         }
         if (do_bias_) add(reg_bias, offset * bias_data_type_size_);
+        if (binary_.per_oc) add(reg_binary_src1, offset * sizeof(float));
     };
 
     // Advance all pointers by a value stored in a register
@@ -294,12 +374,15 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type,
         }
         if (do_bias_)
             lea(reg_bias, ptr[reg_bias + offset * bias_data_type_size_]);
+        if (binary_.per_oc)
+            lea(reg_binary_src1, ptr[reg_binary_src1 + offset * sizeof(float)]);
     };
 
     // Rewind pointers that point to data that is indexed by output channel
-    // (bias or per-oc scaling factors)
+    // (bias, per-oc scaling factors or per-oc binary source)
     auto rewind_ptrs = [&]() {
         if (do_bias_) sub(reg_bias, OC_ * bias_data_type_size_);
+        if (binary_.per_oc) sub(reg_binary_src1, OC_ * sizeof(float));
         if (scale_idx_mult_) {
             assert(scale_idx_mult_ == 1);
             sub(reg_scales, OC_ * sizeof(float));
@@ -457,7 +540,8 @@ template <data_type_t src_type, data_type_t dst_type>
 void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator()(
         dst_data_t *dst, const acc_data_t *acc, const char *bias,
         const float *scales, float nslope, float sum_scale, float signed_scale,
-        int g, size_t start, size_t end) {
+        float dst_zero_point, const float *binary_src1, int g, size_t start,
+        size_t end) {
     using math::get_bias;
 
     if (end <= start) return;
@@ -474,6 +558,9 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator()(
         args.nslope = nslope;
         args.sum_scale = sum_scale;
         args.signed_scale = signed_scale;
+        args.dst_zero_point = dst_zero_point;
+        args.binary_src1 = binary_src1
+                + (binary_.per_oc ? g * jcp_.oc + oc_offset : 0);
         args.len = end - start;
         args.oc_offset = oc_offset;
         ker_(&args);
@@ -498,7 +585,15 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator()(
 
                 d *= scales[(g * jcp_.oc + oc) * scale_idx_mult_];
                 if (do_sum_) d += sum_scale * dst[dst_off];
+                const float s1 = binary_.enabled()
+                        ? binary_src1[binary_.per_oc ? g * jcp_.oc + oc : 0]
+                        : 0.f;
+                if (binary_.enabled() && binary_.idx < eltwise_idx_)
+                    d = binary_.compute_scalar(d, s1);
                 if (do_eltwise_) d = eltwise_->compute_scalar(d);
+                if (binary_.enabled() && binary_.idx > eltwise_idx_)
+                    d = binary_.compute_scalar(d, s1);
+                if (do_dst_zero_point_) d += dst_zero_point;
                 dst[dst_off] = qz_a1b0<float, dst_data_t>()(d);
             }
         }
@@ -509,6 +604,8 @@ template <data_type_t src_type, data_type_t dst_type>
 void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
         const int ithr, const int nthr, const src_data_t *src_base,
         const wei_data_t *wei_base, const char *bia_base, dst_data_t *dst_base,
+        const int32_t *wei_comp, int32_t src_zero_point, int32_t dst_zero_point,
+        const float *binary_src1,
         const memory_tracking::grantor_t &scratchpad) const {
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
 
@@ -545,8 +642,7 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
     auto acc = scratchpad.get<acc_data_t>(key_conv_int_dat_in_acc_dt)
             + (ptrdiff_t)ithr * jcp.oh_block * jcp.ow_block * jcp.oc;
 
-    const ptrdiff_t offset = (ptrdiff_t)jcp.ngroups * jcp.ks * jcp.ic * jcp.oc;
-    const int32_t *_wei_comp = (const int32_t *)(wei_base + offset);
+    const bool with_comp = jcp.signed_input || src_zero_point != 0;
 
     int g {0}, n {0}, ohb {0}, owb {0};
     size_t start = 0, end = 0;
@@ -565,13 +661,13 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
         const wei_data_t *__restrict wei = wei_base + g * wei_g_stride;
         dst_data_t *__restrict dst
                 = dst_base + n * dst_mb_stride + g * dst_g_stride;
-        const int32_t *wei_comp = _wei_comp + g * jcp.oc;
+        const int32_t *comp = wei_comp + g * jcp.oc;
         const int h_step = nstl::min(jcp.oh_block, jcp.oh - oh);
         const int w_step = nstl::min(jcp.ow_block, jcp.ow - ow);
 
         if (jcp.im2col_sz)
-            jit_gemm_convolution_utils::im2col_u8<src_data_t>(
-                    jcp, src, imtr, col, oh, h_step, ow, w_step);
+            jit_gemm_convolution_utils::im2col_u8<src_data_t>(jcp, src, imtr,
+                    col, oh, h_step, ow, w_step, src_zero_point);
 
         const int M = jcp.oc;
         const int K = jcp.ks * jcp.ic;
@@ -583,9 +679,9 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
         const uint8_t off_b = 0;
         const int32_t off_c = 0;
         const float onef = 1.0, zerof = 0.0;
-        gemm_s8x8s32("N", BT, jcp.signed_input ? "C" : "F", &M, &N, &K, &onef,
-                wei, &LDA, &off_a, jcp.im2col_sz ? col : (uint8_t *)src, &LDB,
-                &off_b, &zerof, acc, &M, jcp.signed_input ? wei_comp : &off_c);
+        gemm_s8x8s32("N", BT, with_comp ? "C" : "F", &M, &N, &K, &onef, wei,
+                &LDA, &off_a, jcp.im2col_sz ? col : (uint8_t *)src, &LDB,
+                &off_b, &zerof, acc, &M, with_comp ? comp : &off_c);
 
         auto wei_adj_scale
                 = (wei_md.extra().flags & memory_extra_flags::scale_adjust)
@@ -596,8 +692,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
             size_t start, end;
             balance211((size_t)N * jcp.oc, nthr, ithr, start, end);
             (*pp_ker_)(dst + (oh * jcp.ow + ow) * pp_ker_->dst_os_stride_, acc,
-                    bia_base, scales, nslope, sum_scale, 1.f / wei_adj_scale, g,
-                    start, end);
+                    bia_base, scales, nslope, sum_scale, 1.f / wei_adj_scale,
+                    (float)dst_zero_point, binary_src1, g, start, end);
         });
 
         nd_iterator_step(n, jcp.mb, g, jcp.ngroups, ohb, nb_oh, owb, nb_ow);
@@ -605,28 +701,37 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::execute_forward_thr(
 }
 
 template <data_type_t dst_type>
-void _gemm_u8s8s32x_convolution_bwd_data_t<dst_type>::execute_backward_data(
+status_t _gemm_u8s8s32x_convolution_bwd_data_t<dst_type>::execute_backward_data(
         const exec_ctx_t &ctx) const {
     auto diff_dst_base = CTX_IN_MEM(const diff_dst_data_t *, DNNL_ARG_DIFF_DST);
     auto wei_base = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bia_base = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
     auto diff_src_base = CTX_OUT_MEM(diff_src_data_t *, DNNL_ARG_DIFF_SRC);
 
+    DEFINE_ZERO_POINT_VALUE(diff_dst_zero_point, DNNL_ARG_SRC);
+    DEFINE_ZERO_POINT_VALUE(diff_src_zero_point, DNNL_ARG_DST);
+    if (diff_dst_zero_point < 0 || diff_dst_zero_point > UINT8_MAX)
+        return status::invalid_arguments;
+
     auto scratchpad = ctx.get_scratchpad_grantor();
 
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
 
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
         execute_backward_data_thr(ithr, nthr, diff_dst_base, wei_base, bia_base,
-                diff_src_base, scratchpad);
+                diff_src_base, diff_dst_zero_point, diff_src_zero_point,
+                scratchpad);
     });
+
+    return status::success;
 }
 
 template <data_type_t dst_type>
 void _gemm_u8s8s32x_convolution_bwd_data_t<dst_type>::execute_backward_data_thr(
         const int ithr, const int nthr, const diff_dst_data_t *diff_dst_base,
         const wei_data_t *wei_base, const char *bia_base,
-        diff_src_data_t *diff_src_base,
+        diff_src_data_t *diff_src_base, int32_t diff_dst_zero_point,
+        int32_t diff_src_zero_point,
         const memory_tracking::grantor_t &scratchpad) const {
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
 
@@ -668,8 +773,11 @@ void _gemm_u8s8s32x_convolution_bwd_data_t<dst_type>::execute_backward_data_thr(
         const int M = jcp.ks * jcp.ic;
         const int N = jcp.os;
         const int K = jcp.oc;
+        // the gemm subtracts the zero point from each diff_dst value, which
+        // keeps the result exact at the borders where col2im drops some of
+        // the products
         const int8_t off_a = 0;
-        const diff_dst_data_t off_b = 0;
+        const diff_dst_data_t off_b = (diff_dst_data_t)diff_dst_zero_point;
         const int32_t off_c = 0;
         const float onef = 1.0, zerof = 0.0;
         const int LD = K * jcp.ngroups;
@@ -687,6 +795,7 @@ void _gemm_u8s8s32x_convolution_bwd_data_t<dst_type>::execute_backward_data_thr(
                 d += get_bias(bia_base, g * jcp.ic + ic,
                         pd()->desc()->bias_desc.data_type);
             d *= scales[(g * jcp.ic + ic) * scale_idx_mult];
+            d += diff_src_zero_point;
             const size_t diff_src_off = is * diff_src_os_stride + ic;
             diff_src[diff_src_off] = qz_a1b0<float, diff_src_data_t>()(d);
         });
@@ -21,6 +21,7 @@
 #include "memory_tracking.hpp"
 
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 
 #include "gemm_convolution_utils.hpp"
 #include "jit_generator.hpp"
@@ -61,17 +62,26 @@ struct _gemm_x8s8s32x_convolution_fwd_t : public primitive_impl_t {
                             dat_tag(), format_tag::any, dat_tag())
                     && attr()->has_default_values(
                             primitive_attr_t::skip_mask_t::oscale
+                            | primitive_attr_t::skip_mask_t::zero_points_runtime
                             | primitive_attr_t::skip_mask_t::post_ops)
-                    && post_ops_ok()
+                    && post_ops_ok() && zero_points_ok()
                     && memory_desc_matches_tag(*src_md(), dat_tag())
                     && memory_desc_matches_tag(*dst_md(), dat_tag())
                     && set_or_check_wei_format();
             if (!ok) return status::unimplemented;
 
             auto scratchpad = scratchpad_registry().registrar();
-            return jit_gemm_convolution_utils::init_conf(jcp_, scratchpad,
+            CHECK(jit_gemm_convolution_utils::init_conf(jcp_, scratchpad,
                     *desc(), src_md(), weights_md(0), dst_md(),
-                    dnnl_get_max_threads());
+                    dnnl_get_max_threads()));
+
+            if (!attr()->zero_points_.has_default_values(DNNL_ARG_SRC)) {
+                using namespace memory_tracking::names;
+                scratchpad.book(key_conv_gemm_zp_src_comp,
+                        sizeof(int32_t) * jcp_.ngroups * jcp_.oc);
+            }
+
+            return status::success;
         }
 
         jit_gemm_conv_conf_t jcp_;
@@ -87,15 +97,20 @@ struct _gemm_x8s8s32x_convolution_fwd_t : public primitive_impl_t {
             memory_desc_t want_wei_md = weights_md_;
             memory_desc_init_by_tag(want_wei_md, with_groups() ? hwigo : hwio);
 
+            const int comp_mask = (1 << 0) + (with_groups() ? (1 << 1) : 0);
             if (is_src_s8) {
                 want_wei_md.extra.flags = 0
                         | memory_extra_flags::compensation_conv_s8s8
                         | memory_extra_flags::scale_adjust;
-                want_wei_md.extra.compensation_mask
-                        = (1 << 0) + (with_groups() ? (1 << 1) : 0);
+                want_wei_md.extra.compensation_mask = comp_mask;
                 want_wei_md.extra.scale_adjust
                         = mayiuse(avx512_core_vnni) ? 1.f : 0.5f;
             }
+            if (!attr()->zero_points_.has_default_values(DNNL_ARG_SRC)) {
+                want_wei_md.extra.flags
+                        |= memory_extra_flags::compensation_conv_asymmetric_src;
+                want_wei_md.extra.asymm_compensation_mask = comp_mask;
+            }
 
             if (weights_md_.format_kind == format_kind::any) {
                 weights_md_ = want_wei_md;
@@ -111,6 +126,10 @@ struct _gemm_x8s8s32x_convolution_fwd_t : public primitive_impl_t {
             auto is_eltwise
                     = [&](int idx) { return po.entry_[idx].is_eltwise(); };
 
+            if (po.find(binary) != -1)
+                return binary_post_op_t::sum_eltwise_binary_ok(po)
+                        && binary_post_op_t::post_ops_ok(po, *dst_md());
+
             switch (po.len_) {
                 case 0: return true;
                 case 1: return is_eltwise(0) || po.contain(sum, 0);
@@ -121,6 +140,20 @@ struct _gemm_x8s8s32x_convolution_fwd_t : public primitive_impl_t {
             }
             return false;
         }
+
+        // Only per-tensor source and destination zero points are supported.
+        // The source zero point fills the padded area, so it has to be
+        // representable in the source data type.
+        bool zero_points_ok() const {
+            typedef typename prec_traits<src_type>::type src_data_t;
+            const auto &zp = attr()->zero_points_;
+            if (!zp.has_default_values(DNNL_ARG_WEIGHTS)) return false;
+            if (!zp.defined(DNNL_ARG_SRC)) return true;
+
+            const int src_zp = *zp.get(DNNL_ARG_SRC);
+            return nstl::numeric_limits<src_data_t>::lowest() <= src_zp
+                    && src_zp <= nstl::numeric_limits<src_data_t>::max();
+        }
     };
 
     _gemm_x8s8s32x_convolution_fwd_t(const pd_t *apd)
@@ -135,8 +168,7 @@ struct _gemm_x8s8s32x_convolution_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::s32>::type acc_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return execute_forward(ctx);
     }
 
 private:
@@ -155,8 +187,8 @@ private:
 
         void operator()(dst_data_t *dst, const acc_data_t *acc,
                 const char *bias, const float *scales, float nslope,
-                float sum_scale, float signed_scale, int g, size_t start,
-                size_t end);
+                float sum_scale, float signed_scale, float dst_zero_point,
+                const float *binary_src1, int g, size_t start, size_t end);
 
         size_t dst_os_stride_;
 
@@ -171,6 +203,8 @@ private:
             float nslope;
             float sum_scale;
             float signed_scale;
+            float dst_zero_point;
+            const float *binary_src1;
             size_t len;
             size_t oc_offset;
         };
@@ -186,16 +220,21 @@ private:
         bool do_eltwise_;
         bool do_sum_;
         bool do_signed_scaling_;
+        bool do_dst_zero_point_;
+        int eltwise_idx_;
+        binary_post_op_t binary_;
         size_t vlen_;
         jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
         ref_eltwise_scalar_fwd_t *eltwise_;
     };
 
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
     void execute_forward_thr(const int ithr, const int nthr,
             const src_data_t *src_base, const wei_data_t *wei_base,
             const char *bia_base, dst_data_t *dst_base,
+            const int32_t *wei_comp, int32_t src_zero_point,
+            int32_t dst_zero_point, const float *binary_src1,
             const memory_tracking::grantor_t &scratchpad) const;
 
     int nthr_ = 0;
@@ -216,6 +255,7 @@ struct _gemm_u8s8s32x_convolution_bwd_data_t : public primitive_impl_t {
 
         status_t init() {
             using namespace data_type;
+            using smask_t = primitive_attr_t::skip_mask_t;
 
             bool ok = true && desc()->prop_kind == prop_kind::backward_data
                     && set_default_alg_kind(alg_kind::convolution_direct)
@@ -228,7 +268,8 @@ struct _gemm_u8s8s32x_convolution_bwd_data_t : public primitive_impl_t {
                     && set_default_formats_common(
                             dat_tag(), wei_tag(), dat_tag())
                     && attr()->has_default_values(
-                            primitive_attr_t::skip_mask_t::oscale)
+                            smask_t::oscale | smask_t::zero_points_runtime)
+                    && zero_points_ok()
                     && memory_desc_matches_tag(*diff_src_md(), dat_tag())
                     && memory_desc_matches_tag(*diff_dst_md(), dat_tag())
                     && memory_desc_matches_tag(*weights_md(), wei_tag());
@@ -250,6 +291,18 @@ struct _gemm_u8s8s32x_convolution_bwd_data_t : public primitive_impl_t {
         format_tag_t wei_tag() const {
             return with_groups() ? format_tag::hwigo : format_tag::hwio;
         }
+
+        // This implementation computes the int8 deconvolution, so the zero
+        // points follow the deconvolution notation: the source zero point
+        // applies to diff_dst and the destination one to diff_src.
+        bool zero_points_ok() const {
+            const auto &zp = attr()->zero_points_;
+            if (!zp.has_default_values(DNNL_ARG_WEIGHTS)) return false;
+            if (!zp.defined(DNNL_ARG_SRC)) return true;
+
+            const int src_zp = *zp.get(DNNL_ARG_SRC);
+            return 0 <= src_zp && src_zp <= UINT8_MAX;
+        }
     };
 
     _gemm_u8s8s32x_convolution_bwd_data_t(const pd_t *apd)
@@ -261,15 +314,15 @@ struct _gemm_u8s8s32x_convolution_bwd_data_t : public primitive_impl_t {
     typedef typename prec_traits<data_type::s32>::type acc_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_backward_data(ctx);
-        return status::success;
+        return execute_backward_data(ctx);
     }
 
 private:
-    void execute_backward_data(const exec_ctx_t &ctx) const;
+    status_t execute_backward_data(const exec_ctx_t &ctx) const;
     void execute_backward_data_thr(const int ithr, const int nthr,
             const diff_dst_data_t *diff_dst_base, const wei_data_t *wei_base,
             const char *bia_base, diff_src_data_t *diff_src_base,
+            int32_t diff_dst_zero_point, int32_t diff_src_zero_point,
             const memory_tracking::grantor_t &scratchpad) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 };
@@ -30,12 +30,13 @@ using namespace format_tag;
 using namespace memory_tracking::names;
 
 template <data_type_t src_type, data_type_t dst_type>
-void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::execute_forward(
+status_t gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const int MB = pd()->MB();
     const int OC = pd()->OC();
@@ -68,9 +69,12 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::execute_forward(
         parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
             size_t start, end;
             balance211((size_t)OC * MB, nthr, ithr, start, end);
-            (*pp_kernel_)(dst, acc, bias, scales, start, end);
+            (*pp_kernel_)(dst, acc, bias, scales, start, end, 0, nullptr,
+                    binary_src1);
         });
     }
+
+    return status::success;
 }
 
 using namespace data_type;
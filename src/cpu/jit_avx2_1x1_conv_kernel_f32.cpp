@@ -25,6 +25,7 @@
 
 #include "memory.hpp"
 
+#include "cpu_primitive.hpp"
 #include "jit_avx2_1x1_conv_kernel_f32.hpp"
 
 #define GET_OFF(field) offsetof(jit_1x1_conv_call_s, field)
@@ -142,7 +143,8 @@ void jit_avx2_1x1_conv_kernel_f32::generate_reduce_loop(
                         + sizeof(float) * jcp.oc_block * j];
             default:
                 return ptr[aux_reg_output_data
-                        + (i * jcp.os + j) * jcp.oc_block * sizeof(float)];
+                        + (i * output_load_stride() + j) * jcp.oc_block
+                                * sizeof(float)];
         }
     };
 
@@ -173,6 +175,27 @@ void jit_avx2_1x1_conv_kernel_f32::generate_reduce_loop(
         vbroadcastss(vreg_bcast, bcast_ptr(0, 0));
     };
 
+    // the reduce loop is over and the loads are done, so its counter and
+    // the broadcast register are free here
+    auto apply_binary = [=]() {
+        mov(reduce_loop_iter, ptr[rsp + reg_binary_rhs_stack_offt]);
+        if (!jcp.binary_per_oc)
+            vbroadcastss(vreg_bcast, ptr[reduce_loop_iter]);
+        for (int i = 0; i < load_loop_blk; ++i) {
+            if (jcp.binary_per_oc)
+                vmovups(vreg_bcast,
+                        ptr[reduce_loop_iter
+                                + sizeof(float) * jcp.oc_block * i]);
+            for (int j = 0; j < ur; ++j) {
+                auto r = vreg_accum(i, j);
+                if (jcp.binary_alg == alg_kind::binary_add)
+                    vaddps(r, r, vreg_bcast);
+                else
+                    vmulps(r, r, vreg_bcast);
+            }
+        }
+    };
+
     auto store = [=]() {
         Label store_noadd;
 
@@ -189,16 +212,19 @@ void jit_avx2_1x1_conv_kernel_f32::generate_reduce_loop(
 
         L(store_noadd);
 
-        if (jcp.with_eltwise) {
+        if (jcp.with_eltwise || jcp.with_binary) {
             assert(ur * load_loop_blk < 14);
 
-            Label store_norelu;
+            Label store_nopost_ops;
             test(reg_reduce_pos_flag, FLAG_REDUCE_LAST);
-            jz(store_norelu, T_NEAR);
+            jz(store_nopost_ops, T_NEAR);
 
-            eltwise_injector_->compute_vector_range(0, ur * load_loop_blk);
+            if (jcp.with_binary && !jcp.binary_after_eltwise) apply_binary();
+            if (jcp.with_eltwise)
+                eltwise_injector_->compute_vector_range(0, ur * load_loop_blk);
+            if (jcp.with_binary && jcp.binary_after_eltwise) apply_binary();
 
-            L(store_norelu);
+            L(store_nopost_ops);
         }
 
         for (int j = 0; j < ur; ++j)
@@ -324,6 +350,11 @@ void jit_avx2_1x1_conv_kernel_f32::generate() {
         } else
             mov(reg_bias_data, ptr[param1 + GET_OFF(bias_data)]);
     }
+    if (jcp.with_binary) {
+        sub(rsp, stack_space_needed);
+        mov(reduce_loop_iter, ptr[param1 + GET_OFF(post_ops_binary_rhs)]);
+        mov(ptr[rsp + reg_binary_rhs_stack_offt], reduce_loop_iter);
+    }
 
     mov(reg_load_loop_work, ptr[param1 + GET_OFF(load_dim)]);
     mov(reg_bcast_loop_work, ptr[param1 + GET_OFF(bcast_dim)]);
@@ -340,8 +371,12 @@ void jit_avx2_1x1_conv_kernel_f32::generate() {
             case forward_inference:
                 add(reg_bias_data,
                         load_loop_blk * jcp.oc_block * sizeof(float));
+                if (jcp.with_binary && jcp.binary_per_oc)
+                    add(qword[rsp + reg_binary_rhs_stack_offt],
+                            load_loop_blk * jcp.oc_block * sizeof(float));
                 add(reg_output_data,
-                        load_loop_blk * jcp.os * jcp.oc_block * sizeof(float));
+                        load_loop_blk * output_load_stride() * jcp.oc_block
+                                * sizeof(float));
                 break;
             case backward_data:
                 add(reg_output_data,
@@ -401,7 +436,9 @@ void jit_avx2_1x1_conv_kernel_f32::generate() {
 
     L(load_loop_blk_end);
 
-    if (jcp.with_bias && jcp.prop_kind == backward_weights) add(rsp, 8);
+    if (jcp.with_bias && jcp.prop_kind == backward_weights)
+        add(rsp, stack_space_needed);
+    if (jcp.with_binary) add(rsp, stack_space_needed);
 
     postamble();
 
@@ -414,11 +451,20 @@ bool jit_avx2_1x1_conv_kernel_f32::post_ops_ok(
 
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    auto is_binary = [&](int idx) { return p.entry_[idx].is_binary(); };
+    // eltwise and binary in either order
+    auto is_eltwise_binary = [&](int idx) {
+        return (is_eltwise(idx) && is_binary(idx + 1))
+                || (is_binary(idx) && is_eltwise(idx + 1));
+    };
 
     switch (p.len_) {
         case 0: return true; // no post_ops
-        case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-        case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+        case 1: return is_eltwise(0) || is_sum(0) || is_binary(0);
+        case 2:
+            return (is_sum(0) && (is_eltwise(1) || is_binary(1)))
+                    || is_eltwise_binary(0); // sum first if present
+        case 3: return is_sum(0) && is_eltwise_binary(1);
         default: return false;
     }
 
@@ -475,6 +521,16 @@ status_t jit_avx2_1x1_conv_kernel_f32::init_conf(jit_1x1_conv_conf_t &jcp,
         if (!mayiuse(avx2) && jcp.eltwise.alg != alg_kind::eltwise_relu)
             return status::unimplemented;
     }
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+        const binary_post_op_t binary_po(p);
+        jcp.binary_alg = binary_po.alg;
+        jcp.binary_per_oc = binary_po.per_oc;
+        jcp.binary_after_eltwise = binary_ind > eltwise_ind;
+        if (!binary_post_op_t::post_ops_ok(p, *dst_d.md_))
+            return status::unimplemented;
+    }
 
     const int is_bwd_d = jcp.prop_kind == backward_data;
 
@@ -494,8 +550,11 @@ status_t jit_avx2_1x1_conv_kernel_f32::init_conf(jit_1x1_conv_conf_t &jcp,
     jcp.oc = rnd_up(jcp.oc, simd_w);
     jcp.ic = rnd_up(jcp.ic, simd_w);
 
+    // a vector of the channels has no values for the padded ones
     bool args_ok = true && jcp.ngroups == 1 && jcp.src_tag == dat_tag
-            && jcp.wei_tag == wei_tag && jcp.dst_tag == dat_tag;
+            && jcp.wei_tag == wei_tag && jcp.dst_tag == dat_tag
+            && IMPLICATION(jcp.with_binary && jcp.binary_per_oc,
+                    jcp.oc == jcp.oc_without_padding);
     if (!args_ok) return status::unimplemented;
 
     args_ok = true && jcp.ih == jcp.oh && jcp.iw == jcp.ow
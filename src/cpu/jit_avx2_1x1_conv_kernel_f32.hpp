@@ -84,6 +84,13 @@ private:
     reg64_t reg_diff_bias_data = bcast_loop_iter;
 
     int reg_diff_bias_data_stack_offt = 0;
+    int reg_binary_rhs_stack_offt = 0; // forward only
+
+    // Distance between the oc blocks of the output in pixels. A fused
+    // depthwise convolution keeps only a few output rows per oc block.
+    int output_load_stride() const {
+        return jcp.with_dw_conv ? jcp.dw_conv_buffer_rows * jcp.ow : jcp.os;
+    }
     int stack_space_needed = 8;
 
     ymm_t vreg_bcast = ymm_t(15);
@@ -36,12 +36,13 @@ using namespace dnnl::impl::utils;
 
 /* convolution forward */
 
-void jit_avx2_1x1_convolution_fwd_t::execute_forward(
+status_t jit_avx2_1x1_convolution_fwd_t::execute_forward(
         const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
@@ -112,6 +113,9 @@ void jit_avx2_1x1_convolution_fwd_t::execute_forward(
                 p.output_data = &dst[dst_off];
 
                 p.bias_data = &bias[_ocb * jcp.oc_block];
+                if (binary_src1)
+                    p.post_ops_binary_rhs = binary_src1
+                            + (jcp.binary_per_oc ? _ocb * jcp.oc_block : 0);
 
                 for (int icb = 0; icb < nb_ic; icb += nb_ic_blocking) {
                     p.first_last_flag = 0 | (icb == 0 ? FLAG_REDUCE_FIRST : 0)
@@ -161,9 +165,207 @@ void jit_avx2_1x1_convolution_fwd_t::execute_forward(
         bias = padded_bias;
     }
 
+    if (jcp.with_dw_conv) {
+        const int dw_conv_arg = DNNL_ARG_ATTR_MULTIPLE_POST_OP(
+                pd()->attr()->post_ops_.find(primitive_kind::convolution));
+        auto weights_dw
+                = CTX_IN_MEM(const data_t *, dw_conv_arg | DNNL_ARG_WEIGHTS);
+        auto bias_dw = CTX_IN_MEM(const data_t *, dw_conv_arg | DNNL_ARG_BIAS);
+        auto scratchpad = ctx.get_scratchpad_grantor();
+
+        parallel(0, [&](const int ithr, const int nthr) {
+            execute_forward_dw_conv_thr(ithr, nthr, src, weights, bias,
+                    weights_dw, bias_dw, dst, scratchpad);
+        });
+        return status::success;
+    }
+
     parallel(0, ker);
 
     if (pd()->wants_zero_pad_dst()) ctx.memory(DNNL_ARG_DST)->zero_pad();
+
+    return status::success;
+}
+
+/* The depthwise convolution is computed row by row from a per-thread buffer
+ * of the 1x1 convolution output rows, as in the Intel AVX-512
+ * implementation. */
+void jit_avx2_1x1_convolution_fwd_t::execute_forward_dw_conv_thr(
+        const int ithr, const int nthr, const data_t *src,
+        const data_t *weights, const data_t *bias, const data_t *weights_dw,
+        const data_t *bias_dw, data_t *dst,
+        const memory_tracking::grantor_t &scratchpad) const {
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+    const memory_desc_wrapper dst_d(pd()->arg_md(DNNL_ARG_DST));
+    const memory_desc_wrapper weights_dw_d(&pd()->dw_weights_md_);
+
+    const auto &jcp = kernel_->jcp;
+    const auto &jcp_dw = pd()->jcp_dw_;
+
+    const int ndims = src_d.ndims();
+    const int oc_block = jcp.oc_block;
+    const int buffer_os = jcp.dw_conv_buffer_rows * jcp.ow;
+    const int chunk_size = jcp_dw.nb_ch_blocking;
+    const int nb_chunks = div_up(jcp_dw.nb_ch, chunk_size);
+
+    data_t *buffer = scratchpad.get<data_t>(key_conv_dw_fusion_buffer)
+            + (size_t)ithr * chunk_size * oc_block * buffer_os;
+
+    const int nb_oh
+            = nstl::min(jcp_dw.oh, div_up(nthr, jcp.mb * nb_chunks));
+    const int oh_block = div_up(jcp_dw.oh, nb_oh);
+    const int work_amount = jcp.mb * nb_chunks * nb_oh;
+
+    int start {0}, end {0};
+    balance211(work_amount, nthr, ithr, start, end);
+
+    auto p = jit_1x1_conv_call_s();
+
+    // computes the 1x1 convolution output pixels [os_start, os_end) into the
+    // buffer that starts with the pixel buffer_start
+    auto conv_1x1 = [&](int n, int ocb, int ocb_num, int buffer_start,
+                            int os_start, int os_end) {
+        const int bcast_step = jcp.nb_bcast_blocking * jcp.bcast_block;
+        for (int os = os_start; os < os_end; os += bcast_step) {
+            p.bcast_dim = nstl::min(bcast_step, os_end - os);
+            p.load_dim = ocb_num * oc_block;
+            p.output_data = buffer + (os - buffer_start) * oc_block;
+            p.bias_data = &bias[ocb * oc_block];
+
+            const int oh = os / jcp.ow, ow = os % jcp.ow;
+            for (int icb = 0; icb < jcp.nb_reduce;
+                    icb += jcp.nb_reduce_blocking) {
+                p.first_last_flag = 0 | (icb == 0 ? FLAG_REDUCE_FIRST : 0)
+                        | (icb + jcp.nb_reduce_blocking >= jcp.nb_reduce
+                                        ? FLAG_REDUCE_LAST
+                                        : 0);
+                p.reduce_dim = this_block_size(icb * jcp.ic_block, jcp.ic,
+                        jcp.nb_reduce_blocking * jcp.ic_block);
+                p.load_data = &weights[weights_d.blk_off(ocb, icb)];
+                p.bcast_data = src + data_blk_off(src_d, n, icb, oh, ow);
+
+                kernel_->jit_ker(&p);
+            }
+        }
+    };
+
+    // computes the depthwise output row oh of the channel chunk starting at
+    // ocb from the buffer that starts with the pixel buffer_start
+    auto conv_dw = [&](int n, int ocb, int buffer_start, int oh) {
+        const int str_h = jcp_dw.stride_h, str_w = jcp_dw.stride_w;
+
+        const int i_t_overflow = nstl::max(0, jcp_dw.t_pad - oh * str_h);
+        const int i_b_overflow = nstl::max(jcp_dw.ih,
+                                         oh * str_h + jcp_dw.kh - jcp_dw.t_pad)
+                - jcp_dw.ih;
+        const int ih = nstl::max(oh * str_h - jcp_dw.t_pad + i_t_overflow, 0);
+        const int kh = i_t_overflow;
+        const int kh_padding = jcp_dw.kh - i_t_overflow - i_b_overflow;
+
+        auto ker = [&](int ur_w_step, int ow) {
+            auto par_conv = jit_conv_call_s();
+
+            const int i_l_overflow = nstl::max(0, jcp_dw.l_pad - ow * str_w);
+            const int i_r_overflow = nstl::max(jcp_dw.iw,
+                                             ow * str_w + jcp_dw.kw
+                                                     - jcp_dw.l_pad)
+                    - jcp_dw.iw;
+            const int iw = nstl::max(ow * str_w - jcp_dw.l_pad + i_l_overflow,
+                    0);
+            const int kw = i_l_overflow;
+            const int kw_padding = jcp_dw.kw - i_l_overflow - i_r_overflow;
+
+            par_conv.src = buffer
+                    + (ih * jcp_dw.iw + iw - buffer_start) * oc_block;
+            par_conv.dst = &dst[dst_d.blk_off(n, ocb, oh, ow)];
+            par_conv.filt
+                    = &weights_dw[weights_dw_d.blk_off(ocb, 0, 0, kh, kw)];
+            if (jcp_dw.with_bias) par_conv.bias = &bias_dw[ocb * oc_block];
+
+            par_conv.kh_padding = (size_t)nstl::max(0, kh_padding);
+            par_conv.kw_padding = (size_t)nstl::max(0, kw_padding);
+            par_conv.ur_w = (size_t)ur_w_step;
+            par_conv.ch_blocks
+                    = nstl::min(ocb + chunk_size, jcp_dw.nb_ch) - ocb;
+
+            kernel_dw_->jit_ker(&par_conv);
+        };
+
+        int ow = 0;
+        const int l_border = nstl::min(div_up(jcp_dw.l_pad, str_w), jcp_dw.ow);
+        for (; ow < l_border; ow++)
+            ker(1, ow);
+
+        const int ur_w_step
+                = (jcp_dw.iw - jcp_dw.kw + jcp_dw.l_pad) / str_w - ow + 1;
+        if (ur_w_step > 0) {
+            ker(ur_w_step, ow);
+            ow += ur_w_step;
+        }
+
+        for (; ow < jcp_dw.ow; ow++)
+            ker(1, ow);
+    };
+
+    int n {0}, chunk {0}, ohb {0};
+    nd_iterator_init(start, n, jcp.mb, chunk, nb_chunks, ohb, nb_oh);
+    for (int iwork = start; iwork < end; ++iwork) {
+        const int ocb = chunk * chunk_size;
+        const int ocb_num = nstl::min(ocb + chunk_size, jcp.nb_load) - ocb;
+        const int oh_start = ohb * oh_block;
+        const int oh_end = nstl::min(oh_start + oh_block, jcp_dw.oh);
+
+        // the 1x1 kernel computes whole unrolled blocks except for the tail
+        // of the image, hence the computed pixels are kept aligned to jcp.ur
+        const int ih_last = nstl::min(jcp_dw.ih,
+                (oh_end - 1) * jcp_dw.stride_h - jcp_dw.t_pad + jcp_dw.kh);
+        const int os_last
+                = nstl::min(rnd_up(ih_last * jcp.ow, jcp.ur), jcp.os);
+
+        int buffer_start = -1, os_done = 0;
+        for (int oh = oh_start; oh < oh_end; ++oh) {
+            const int ih_start
+                    = nstl::max(0, oh * jcp_dw.stride_h - jcp_dw.t_pad);
+            const int ih_end = nstl::min(jcp_dw.ih,
+                    oh * jcp_dw.stride_h - jcp_dw.t_pad + jcp_dw.kh);
+            const int os_needed = ih_end * jcp.ow;
+
+            if (buffer_start < 0) {
+                buffer_start = rnd_dn(ih_start * jcp.ow, jcp.ur);
+                os_done = buffer_start;
+            }
+
+            if (os_done < os_needed) {
+                auto buffer_end = [&]() {
+                    return nstl::min(os_last,
+                            buffer_start + buffer_os >= jcp.os
+                                    ? jcp.os
+                                    : rnd_dn(buffer_start + buffer_os,
+                                            jcp.ur));
+                };
+                if (buffer_end() < os_needed) {
+                    // move the rows still needed to the buffer beginning
+                    const int os_keep = ih_start * jcp.ow;
+                    for (int i = 0; i < ocb_num; ++i) {
+                        data_t *b = buffer + i * buffer_os * oc_block;
+                        utils::array_copy(b,
+                                b + (os_keep - buffer_start) * oc_block,
+                                (os_done - os_keep) * oc_block);
+                    }
+                    buffer_start = os_keep;
+                }
+                const int os_end = buffer_end();
+                assert(os_end >= os_needed);
+                conv_1x1(n, ocb, ocb_num, buffer_start, os_done, os_end);
+                os_done = os_end;
+            }
+
+            conv_dw(n, ocb, buffer_start, oh);
+        }
+
+        nd_iterator_step(n, jcp.mb, chunk, nb_chunks, ohb, nb_oh);
+    }
 }
 
 /* convolution backward wtr data */
@@ -23,16 +23,20 @@
 #include "utils.hpp"
 
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 #include "cpu_reducer.hpp"
 
 #include "jit_avx2_1x1_conv_kernel_f32.hpp"
 #include "jit_uni_1x1_conv_utils.hpp"
+#include "jit_uni_dw_conv_kernel_utils.hpp"
 
 namespace dnnl {
 namespace impl {
 namespace cpu {
 
 struct jit_avx2_1x1_convolution_fwd_t : public primitive_impl_t {
+    typedef jit_uni_dw_conv_fwd_kernel<avx2, data_type::f32> dw_conv_kernel_t;
+
     // TODO: (Roma) Code duplication duplication! Remove with templates
     //              (maybe...)!
     struct pd_t : public cpu_convolution_fwd_pd_t {
@@ -41,7 +45,11 @@ struct jit_avx2_1x1_convolution_fwd_t : public primitive_impl_t {
                 const typename pd_t::base_class *hint_fwd_pd)
             : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
             , jcp_()
-            , rtus_() {}
+            , rtus_()
+            , jcp_dw_()
+            , dw_weights_md_()
+            , dw_bias_md_()
+            , dw_dst_md_() {}
 
         DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit_1x1:", avx2, ""),
                 jit_avx2_1x1_convolution_fwd_t);
@@ -60,22 +68,141 @@ struct jit_avx2_1x1_convolution_fwd_t : public primitive_impl_t {
             const memory_desc_t *src_d = src_md();
             rtus_prepare(this, conv_d, src_d, dst_md());
 
-            status_t status = jit_avx2_1x1_conv_kernel_f32::init_conf(
-                    jcp_, *conv_d, *src_d, *weights_md(), *dst_md(), *attr());
+            // The 1x1 kernel applies the post-ops preceding a fused depthwise
+            // convolution, the depthwise kernel applies the rest of them
+            const int dw_conv_idx
+                    = attr()->post_ops_.find(primitive_kind::convolution);
+            primitive_attr_t attr_1x1(*attr());
+            if (dw_conv_idx >= 0) attr_1x1.post_ops_.len_ = dw_conv_idx;
+
+            status_t status = jit_avx2_1x1_conv_kernel_f32::init_conf(jcp_,
+                    *conv_d, *src_d, *weights_md(), *dst_md(), attr_1x1);
             if (status != status::success) return status;
 
+            if (dw_conv_idx >= 0) {
+                status = init_dw_conv(dw_conv_idx);
+                if (status != status::success) return status;
+            }
+
             auto scratchpad = scratchpad_registry().registrar();
             jit_avx2_1x1_conv_kernel_f32::init_scratchpad(scratchpad, jcp_);
 
             rtus_prepare_space_info(this, scratchpad);
 
+            if (jcp_.with_dw_conv) {
+                const size_t buffer_size = (size_t)dnnl_get_max_threads()
+                        * jcp_dw_.nb_ch_blocking * jcp_.oc_block
+                        * jcp_.dw_conv_buffer_rows * jcp_.ow;
+                scratchpad.book(
+                        memory_tracking::names::key_conv_dw_fusion_buffer,
+                        sizeof(float) * buffer_size);
+            }
+
             return status::success;
         }
 
+        // With a fused depthwise convolution the primitive destination is
+        // the output of the depthwise convolution, while dst_md() keeps
+        // describing the output of the 1x1 convolution
+        virtual status_t query(
+                query_t what, int idx, void *result) const override {
+            if (jcp_.with_dw_conv && what == query::dst_md && idx == 0) {
+                *(const memory_desc_t **)result = &dw_dst_md_;
+                return status::success;
+            }
+            return cpu_convolution_fwd_pd_t::query(what, idx, result);
+        }
+
+        virtual const memory_desc_t *arg_md(int arg) const override {
+            if (jcp_.with_dw_conv) {
+                const int dw_conv_arg = DNNL_ARG_ATTR_MULTIPLE_POST_OP(
+                        attr()->post_ops_.find(primitive_kind::convolution));
+                if (arg == DNNL_ARG_DST) return &dw_dst_md_;
+                if (arg == (dw_conv_arg | DNNL_ARG_WEIGHTS))
+                    return &dw_weights_md_;
+                if (arg == (dw_conv_arg | DNNL_ARG_BIAS)) return &dw_bias_md_;
+            }
+            return cpu_convolution_fwd_pd_t::arg_md(arg);
+        }
+
         jit_1x1_conv_conf_t jcp_;
         reduce_to_unit_stride_t rtus_;
 
+        jit_conv_conf_t jcp_dw_;
+        memory_desc_t dw_weights_md_;
+        memory_desc_t dw_bias_md_;
+        memory_desc_t dw_dst_md_;
+
     protected:
+        status_t init_dw_conv(int dw_conv_idx) {
+            using namespace format_tag;
+            using namespace utils;
+
+            const auto &po = attr()->post_ops_;
+            const auto &dw = po.entry_[dw_conv_idx].depthwise_conv;
+            const bool with_dw_bias = dw.bias_dt != data_type::undef;
+
+            // Same restrictions as in the Intel AVX-512 implementation: the
+            // 1x1 output rows are computed into a small buffer, so the output
+            // must not be read back and must consist of whole rows
+            bool ok = true && ndims() == 4 && !rtus_.reduce_src_
+                    && !jcp_.with_sum
+                    && !jcp_.with_binary
+                    && jcp_.oc == jcp_.oc_without_padding
+                    && everyone_is(data_type::f32, dw.wei_dt, dw.dst_dt)
+                    && IMPLICATION(with_dw_bias, dw.bias_dt == data_type::f32);
+            if (!ok) return status::unimplemented;
+
+            primitive_attr_t attr_dw;
+            for (int idx = dw_conv_idx + 1; idx < po.len_; ++idx)
+                attr_dw.post_ops_.entry_[attr_dw.post_ops_.len_++]
+                        = po.entry_[idx];
+
+            const int kernel = 3, pad = 1;
+            const dim_t stride = dw.stride;
+            const dim_t oc = dst_md_.dims[1];
+            const dim_t ih = dst_md_.dims[2], iw = dst_md_.dims[3];
+            const dim_t oh = (ih + 2 * pad - kernel) / stride + 1;
+            const dim_t ow = (iw + 2 * pad - kernel) / stride + 1;
+
+            const dims_t wei_dims = {oc, 1, 1, kernel, kernel};
+            CHECK(dnnl_memory_desc_init_by_tag(
+                    &dw_weights_md_, 5, wei_dims, dw.wei_dt, Goihw8g));
+            if (with_dw_bias) {
+                const dims_t bias_dims = {oc};
+                CHECK(dnnl_memory_desc_init_by_tag(
+                        &dw_bias_md_, 1, bias_dims, dw.bias_dt, x));
+            }
+            const dims_t dst_dims = {MB(), oc, oh, ow};
+            CHECK(dnnl_memory_desc_init_by_tag(
+                    &dw_dst_md_, 4, dst_dims, dw.dst_dt, nChw8c));
+
+            const dims_t strides = {stride, stride};
+            const dims_t padding_l = {pad, pad};
+            const dims_t padding_r = {(oh - 1) * stride + kernel - ih - pad,
+                    (ow - 1) * stride + kernel - iw - pad};
+            convolution_desc_t dw_cd;
+            CHECK(conv_desc_init(&dw_cd, prop_kind::forward_inference,
+                    alg_kind::convolution_direct, &dst_md_, &dw_weights_md_,
+                    with_dw_bias ? &dw_bias_md_ : nullptr, &dw_dst_md_,
+                    strides, nullptr, padding_l, padding_r));
+            CHECK(dw_conv_kernel_t::init_conf(jcp_dw_, dw_cd, dst_md_,
+                    dw_weights_md_, dw_dst_md_, attr_dw));
+
+            // The buffer keeps the input rows of a depthwise output row plus
+            // a few unrolled 1x1 kernel blocks, and if possible half of L2
+            const int chunk_size = jcp_dw_.nb_ch_blocking * jcp_.oc_block;
+            const int min_rows = jcp_dw_.kh + div_up(2 * jcp_.ur, jcp_.ow);
+            const int L2_size = get_cache_size(2, true) / sizeof(float);
+            const int L2_rows = L2_size / 2 / (chunk_size * jcp_.ow);
+
+            jcp_.with_dw_conv = true;
+            jcp_.dw_conv_buffer_rows
+                    = nstl::max(min_rows, nstl::min(L2_rows, jcp_.oh));
+
+            return status::success;
+        }
+
         bool set_default_formats() {
             using namespace format_tag;
 
@@ -92,28 +219,43 @@ struct jit_avx2_1x1_convolution_fwd_t : public primitive_impl_t {
     friend void init_rtus_driver(conv_t *self);
 
     jit_avx2_1x1_convolution_fwd_t(const pd_t *apd)
-        : primitive_impl_t(apd), kernel_(nullptr), rtus_driver_(nullptr) {
+        : primitive_impl_t(apd)
+        , kernel_(nullptr)
+        , kernel_dw_(nullptr)
+        , rtus_driver_(nullptr) {
         kernel_ = new jit_avx2_1x1_conv_kernel_f32(pd()->jcp_, *pd()->attr());
+        if (pd()->jcp_.with_dw_conv) {
+            // The depthwise kernel reads its input from the row buffer where
+            // the channel blocks are only a few rows apart
+            auto jcp_dw = pd()->jcp_dw_;
+            jcp_dw.ih = pd()->jcp_.dw_conv_buffer_rows;
+            kernel_dw_ = new dw_conv_kernel_t(jcp_dw);
+        }
         init_rtus_driver<avx2>(this);
     }
 
     ~jit_avx2_1x1_convolution_fwd_t() {
         delete kernel_;
+        delete kernel_dw_;
         delete rtus_driver_;
     }
 
     typedef typename prec_traits<data_type::f32>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_forward(ctx);
-        return status::success;
+        return execute_forward(ctx);
     }
 
 private:
-    void execute_forward(const exec_ctx_t &ctx) const;
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    void execute_forward_dw_conv_thr(const int ithr, const int nthr,
+            const data_t *src, const data_t *weights, const data_t *bias,
+            const data_t *weights_dw, const data_t *bias_dw, data_t *dst,
+            const memory_tracking::grantor_t &scratchpad) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
     jit_avx2_1x1_conv_kernel_f32 *kernel_;
+    dw_conv_kernel_t *kernel_dw_;
     rtus_driver_t<avx2> *rtus_driver_;
 };
 
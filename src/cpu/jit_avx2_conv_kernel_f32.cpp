@@ -21,6 +21,7 @@
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
+#include "cpu_primitive.hpp"
 #include "jit_avx2_conv_kernel_f32.hpp"
 
 #define GET_OFF(field) offsetof(jit_conv_call_s, field)
@@ -152,6 +153,23 @@ void jit_avx2_conv_fwd_kernel_f32::oh_step_nopad(int ur_w, int pad_l, int pad_r,
     }
 }
 
+void jit_avx2_conv_fwd_kernel_f32::apply_binary(int ur_w, int oc_blocks) {
+    mov(reg_binary_rhs, ptr[this->param1 + GET_OFF(post_ops_binary_rhs)]);
+    if (!jcp.binary_per_oc) vbroadcastss(ymm15, ptr[reg_binary_rhs]);
+    for (int ii = 0; ii < oc_blocks; ii++) {
+        if (jcp.binary_per_oc)
+            vmovups(ymm15,
+                    yword[reg_binary_rhs + sizeof(float) * ii * jcp.oc_block]);
+        for (int jj = 0; jj < ur_w; jj++) {
+            Ymm reg_out = Ymm(ur_w * ii + jj);
+            if (jcp.binary_alg == alg_kind::binary_add)
+                vaddps(reg_out, reg_out, ymm15);
+            else
+                vmulps(reg_out, reg_out, ymm15);
+        }
+    }
+}
+
 void jit_avx2_conv_fwd_kernel_f32::width_blk_step(int ur_w, int pad_l,
         int pad_r, char pad_tag, int oc_blocks, char oc_blocks_tag) {
     int iw = jcp.iw;
@@ -286,11 +304,16 @@ void jit_avx2_conv_fwd_kernel_f32::width_blk_step(int ur_w, int pad_l,
 
     Label regular_store;
 
-    if (jcp.with_eltwise) {
+    if (jcp.with_eltwise || jcp.with_binary) {
         test(reg_ci_flag, FLAG_IC_LAST);
         je(regular_store, T_NEAR);
 
-        eltwise_injector_->compute_vector_range(0, oc_blocks * ur_w);
+        if (jcp.with_binary && !jcp.binary_after_eltwise)
+            apply_binary(ur_w, oc_blocks);
+        if (jcp.with_eltwise)
+            eltwise_injector_->compute_vector_range(0, oc_blocks * ur_w);
+        if (jcp.with_binary && jcp.binary_after_eltwise)
+            apply_binary(ur_w, oc_blocks);
 
         L(regular_store);
     }
@@ -408,11 +431,20 @@ bool jit_avx2_conv_fwd_kernel_f32::post_ops_ok(
 
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    auto is_binary = [&](int idx) { return p.entry_[idx].is_binary(); };
+    // eltwise and binary in either order
+    auto is_eltwise_binary = [&](int idx) {
+        return (is_eltwise(idx) && is_binary(idx + 1))
+                || (is_binary(idx) && is_eltwise(idx + 1));
+    };
 
     switch (p.len_) {
         case 0: return true; // no post_ops
-        case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-        case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+        case 1: return is_eltwise(0) || is_sum(0) || is_binary(0);
+        case 2:
+            return (is_sum(0) && (is_eltwise(1) || is_binary(1)))
+                    || is_eltwise_binary(0); // sum first if present
+        case 3: return is_sum(0) && is_eltwise_binary(1);
         default: return false;
     }
 
@@ -425,6 +457,7 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
         const primitive_attr_t &attr) {
     if (!mayiuse(avx)) return status::unimplemented;
 
+    jcp = zero<decltype(jcp)>();
     jcp.prop_kind = cd.prop_kind;
 
     const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
@@ -520,6 +553,20 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
         if (mimo) jcp.ic = rnd_up(jcp.ic, simd_w);
     }
 
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+        const binary_post_op_t binary_po(p);
+        jcp.binary_alg = binary_po.alg;
+        jcp.binary_per_oc = binary_po.per_oc;
+        jcp.binary_after_eltwise = binary_ind > eltwise_ind;
+        // a vector of the channels has no values for the padded ones
+        bool ok = binary_post_op_t::post_ops_ok(p, *dst_d.md_)
+                && IMPLICATION(jcp.binary_per_oc,
+                        jcp.oc == jcp.oc_without_padding);
+        if (!ok) return status::unimplemented;
+    }
+
     bool args_ok = true
             && IMPLICATION(flat,
                     true
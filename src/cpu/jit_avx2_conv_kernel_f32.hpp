@@ -37,7 +37,9 @@ struct jit_avx2_conv_fwd_kernel_f32 : public jit_generator {
             eltwise_injector_
                     = new jit_uni_eltwise_injector_f32<avx2>(this, jcp.eltwise);
 
-        this->generate();
+        // the code is defined by jcp
+        jit_kernel_cache::key_t key(name());
+        if (!restore_code(key.append(jcp))) this->generate();
         jit_ker = (void (*)(jit_conv_call_s *))this->getCode();
     }
 
@@ -78,11 +80,14 @@ private:
     reg64_t imm_addr64 = r15;
     reg64_t reg_long_offt = r15;
     Xbyak::Reg32 reg_ci_flag = r13d;
+    // the input is reloaded for every width block, so it is free at the store
+    reg64_t reg_binary_rhs = aux_reg_input;
 
     Xbyak::Ymm ytmp = Xbyak::Ymm(14);
 
     jit_uni_eltwise_injector_f32<avx2> *eltwise_injector_;
 
+    inline void apply_binary(int ur_w, int oc_blocks);
     inline void oh_step_unroll_kw(
             int ur_w, int pad_l, int pad_r, int oc_blocks);
     inline void oh_step_nopad(int ur_w, int pad_l, int pad_r, char pad_label,
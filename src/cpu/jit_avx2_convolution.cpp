@@ -43,11 +43,13 @@ using namespace nstl;
             : (pd()->ndims() == 4) ? wht_blk_off_(f, g, oc, ic, kh, kw) \
                                    : wht_blk_off_(f, g, oc, ic, kd, kh, kw)
 
-void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+status_t jit_avx2_convolution_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
     auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
@@ -126,8 +128,13 @@ void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
                         par_conv.flags |= FLAG_IC_FIRST;
                     }
 
-                    if (jcp.with_eltwise && icb + 1 == jcp.nb_ic) {
+                    if ((jcp.with_eltwise || jcp.with_binary)
+                            && icb + 1 == jcp.nb_ic) {
                         par_conv.flags |= FLAG_IC_LAST;
+                        if (binary_src1)
+                            par_conv.post_ops_binary_rhs = binary_src1
+                                    + (jcp.binary_per_oc ? _oc * jcp.oc_block
+                                                         : 0);
                     }
 
                     par_conv.oc_blocks
@@ -165,6 +172,8 @@ void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
     parallel(0, ker);
 
     if (pd()->wants_zero_pad_dst()) ctx.memory(DNNL_ARG_DST)->zero_pad();
+
+    return status::success;
 }
 
 void jit_avx2_convolution_bwd_data_t::execute_backward_data(
@@ -25,6 +25,7 @@
 #include "utils.hpp"
 
 #include "cpu_barrier.hpp"
+#include "cpu_primitive.hpp"
 #include "memory.hpp"
 
 #include "jit_avx512_common_1x1_conv_kernel.hpp"
@@ -188,7 +189,7 @@ void jit_avx512_common_1x1_conv_kernel::reduce_loop(
         if (one_of(jcp.prop_kind, forward_training, forward_inference,
                     backward_data))
             return EVEX_compress_addr(aux_reg_output_data,
-                    (i_load * jcp.bcast_dim + i_ur) * jcp.load_block
+                    (i_load * output_load_stride() + i_ur) * jcp.load_block
                             * jcp.typesize_out);
         else
             return ptr[aux_reg_output_data
@@ -229,6 +230,27 @@ void jit_avx512_common_1x1_conv_kernel::reduce_loop(
         L(init_done);
     };
 
+    // the reduce loop is over, so its counter and the broadcast register are
+    // free here
+    auto apply_binary = [=]() {
+        mov(reduce_loop_iter, EVEX_compress_addr(rsp, binary_rhs_offt));
+        if (!jcp.binary_per_oc)
+            vbroadcastss(vreg_bcast, ptr[reduce_loop_iter]);
+        for (int i_load = 0; i_load < load_loop_blk; ++i_load) {
+            if (jcp.binary_per_oc)
+                vmovups(vreg_bcast,
+                        EVEX_compress_addr(reduce_loop_iter,
+                                jcp.typesize_out * jcp.oc_block * i_load));
+            for (int i_ur = 0; i_ur < ur; ++i_ur) {
+                auto r = vreg_accum(i_load, i_ur);
+                if (jcp.binary_alg == alg_kind::binary_add)
+                    vaddps(r, r, vreg_bcast);
+                else
+                    vmulps(r, r, vreg_bcast);
+            }
+        }
+    };
+
     auto store = [=]() {
         Label store_noadd;
         if (!jcp.with_sum) {
@@ -243,14 +265,17 @@ void jit_avx512_common_1x1_conv_kernel::reduce_loop(
             }
 
         L(store_noadd);
-        if (jcp.with_eltwise) {
-            Label store_noeltwise;
+        if (jcp.with_eltwise || jcp.with_binary) {
+            Label store_nopost_ops;
             test(reg_reduce_pos_flag, FLAG_REDUCE_LAST);
-            jz(store_noeltwise, T_NEAR);
+            jz(store_nopost_ops, T_NEAR);
 
-            eltwise_injector_->compute_vector_range(0, ur * load_loop_blk);
+            if (jcp.with_binary && !jcp.binary_after_eltwise) apply_binary();
+            if (jcp.with_eltwise)
+                eltwise_injector_->compute_vector_range(0, ur * load_loop_blk);
+            if (jcp.with_binary && jcp.binary_after_eltwise) apply_binary();
 
-            L(store_noeltwise);
+            L(store_nopost_ops);
         }
 
         auto store_output = [=](bool output_is_aligned) {
@@ -459,6 +484,10 @@ void jit_avx512_common_1x1_conv_kernel::generate() {
     sub(rsp, stack_space_needed);
 
     if (jcp.with_bias) mov(reg_bias_data, ptr[param1 + GET_OFF(bias_data)]);
+    if (jcp.with_binary) {
+        mov(reg_bcast_loop_work, ptr[param1 + GET_OFF(post_ops_binary_rhs)]);
+        mov(EVEX_compress_addr(rsp, binary_rhs_offt), reg_bcast_loop_work);
+    }
 
     mov(reg_load_loop_work, ptr[param1 + GET_OFF(load_dim)]);
     mov(reg_bcast_loop_work, ptr[param1 + GET_OFF(bcast_dim)]);
@@ -478,8 +507,11 @@ void jit_avx512_common_1x1_conv_kernel::generate() {
             case forward_inference:
                 add(reg_bias_data,
                         load_loop_blk * jcp.load_block * jcp.typesize_out);
+                if (jcp.with_binary && jcp.binary_per_oc)
+                    add(qword[rsp + binary_rhs_offt],
+                            load_loop_blk * jcp.load_block * jcp.typesize_out);
                 add(reg_output_data,
-                        load_loop_blk * jcp.bcast_dim * jcp.load_block
+                        load_loop_blk * output_load_stride() * jcp.load_block
                                 * jcp.typesize_out);
                 break;
             case backward_data:
@@ -567,11 +599,20 @@ bool jit_avx512_common_1x1_conv_kernel::post_ops_ok(
 
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    auto is_binary = [&](int idx) { return p.entry_[idx].is_binary(); };
+    // eltwise and binary in either order
+    auto is_eltwise_binary = [&](int idx) {
+        return (is_eltwise(idx) && is_binary(idx + 1))
+                || (is_binary(idx) && is_eltwise(idx + 1));
+    };
 
     switch (p.len_) {
         case 0: return true; // no post_ops
-        case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-        case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+        case 1: return is_eltwise(0) || is_sum(0) || is_binary(0);
+        case 2:
+            return (is_sum(0) && (is_eltwise(1) || is_binary(1)))
+                    || is_eltwise_binary(0); // sum first if present
+        case 3: return is_sum(0) && is_eltwise_binary(1);
         default: return false;
     }
 
@@ -588,6 +629,7 @@ status_t jit_avx512_common_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     const int simd_w = cpu_isa_traits<avx512_common>::vlen / sizeof(float);
     const int ndims = src_d.ndims();
 
+    jcp = zero<decltype(jcp)>();
     jcp.prop_kind = cd.prop_kind;
 
     jcp.ngroups = with_groups ? weights_d.dims()[0] : 1;
@@ -636,6 +678,20 @@ status_t jit_avx512_common_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
         jcp.eltwise = p.entry_[eltwise_ind].eltwise;
         if (dst_d.data_type() == data_type::s32) return status::unimplemented;
     }
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+        const binary_post_op_t binary_po(p);
+        jcp.binary_alg = binary_po.alg;
+        jcp.binary_per_oc = binary_po.per_oc;
+        jcp.binary_after_eltwise = binary_ind > eltwise_ind;
+        // a vector of the channels has no values for the padded ones
+        bool ok = dst_d.data_type() == data_type::f32
+                && binary_post_op_t::post_ops_ok(p, *dst_d.md_)
+                && IMPLICATION(jcp.binary_per_oc,
+                        jcp.oc == jcp.oc_without_padding);
+        if (!ok) return status::unimplemented;
+    }
 
     auto dat_tag = pick(ndims - 3, nCw16c, nChw16c);
     jcp.src_tag = src_d.matches_one_of_tag(dat_tag);
@@ -36,7 +36,9 @@ struct jit_avx512_common_1x1_conv_kernel : public jit_generator {
             eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                     this, jcp.eltwise);
 
-        this->generate();
+        // the code is defined by jcp
+        jit_kernel_cache::key_t key(name());
+        if (!restore_code(key.append(jcp))) this->generate();
         jit_ker = (void (*)(jit_1x1_conv_call_s *))this->getCode();
     }
 
@@ -87,8 +89,16 @@ private:
     jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
 
     int bcast_loop_work_offt = 0;
+    int binary_rhs_offt = 8;
     int stack_space_needed = 16;
 
+    // Distance between the oc blocks of the output in pixels. A fused
+    // depthwise convolution keeps only a few output rows per oc block.
+    int output_load_stride() const {
+        return jcp.with_dw_conv ? jcp.dw_conv_buffer_rows * jcp.ow
+                                : jcp.bcast_dim;
+    }
+
     void bcast_loop(int load_loop_blk);
     void reduce_loop(int load_loop_blk, int ur, int substep, bool wraparound);
 
@@ -20,6 +20,7 @@
 #include "utils.hpp"
 
 #include "cpu_barrier.hpp"
+#include "cpu_primitive.hpp"
 
 #include "jit_avx512_common_conv_kernel.hpp"
 
@@ -101,6 +102,25 @@ void _jit_avx512_common_conv_fwd_kernel<Vmm>::prepare_output(int ur_w) {
         }
 }
 
+template <typename Vmm>
+void _jit_avx512_common_conv_fwd_kernel<Vmm>::apply_binary(int ur_w) {
+    // the bias is already added, so its register holds the second source
+    mov(reg_bias, ptr[param1 + GET_OFF(post_ops_binary_rhs)]);
+    if (!jcp.binary_per_oc) vbroadcastss(vmm_wei, ptr[reg_bias]);
+    for (int k = 0; k < jcp.nb_oc_blocking; k++) {
+        if (jcp.binary_per_oc)
+            vmovups(vmm_wei,
+                    EVEX_compress_addr(reg_bias, k * jcp.oc_block * typesize));
+        for (int j = 0; j < ur_w; j++) {
+            Vmm vmm = vmm_out(j, k);
+            if (jcp.binary_alg == alg_kind::binary_add)
+                vaddps(vmm, vmm, vmm_wei);
+            else
+                vmulps(vmm, vmm, vmm_wei);
+        }
+    }
+}
+
 template <typename Vmm>
 void _jit_avx512_common_conv_fwd_kernel<Vmm>::store_output(int ur_w) {
     Label no_update_label, store_label, eltwise_label;
@@ -142,18 +162,22 @@ void _jit_avx512_common_conv_fwd_kernel<Vmm>::store_output(int ur_w) {
     }
 
     L(eltwise_label);
-    if (jcp.with_eltwise) {
+    if (jcp.with_eltwise || jcp.with_binary) {
         cmp(reg_channel, jcp.nb_ic - 1);
         jl(store_label, T_NEAR);
 
-        if (ur_w == jcp.ur_w) {
-            eltwise_injector_->compute_vector_range(
-                    0, jcp.nb_oc_blocking * jcp.ur_w);
-        } else {
-            for (int k = 0; k < jcp.nb_oc_blocking; k++)
+        if (jcp.with_binary && !jcp.binary_after_eltwise) apply_binary(ur_w);
+        if (jcp.with_eltwise) {
+            if (ur_w == jcp.ur_w) {
                 eltwise_injector_->compute_vector_range(
-                        k * jcp.ur_w, k * jcp.ur_w + ur_w);
+                        0, jcp.nb_oc_blocking * jcp.ur_w);
+            } else {
+                for (int k = 0; k < jcp.nb_oc_blocking; k++)
+                    eltwise_injector_->compute_vector_range(
+                            k * jcp.ur_w, k * jcp.ur_w + ur_w);
+            }
         }
+        if (jcp.with_binary && jcp.binary_after_eltwise) apply_binary(ur_w);
     }
 
     L(store_label);
@@ -1113,11 +1137,20 @@ bool jit_avx512_common_conv_fwd_kernel::post_ops_ok(
 
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    auto is_binary = [&](int idx) { return p.entry_[idx].is_binary(); };
+    // eltwise and binary in either order
+    auto is_eltwise_binary = [&](int idx) {
+        return (is_eltwise(idx) && is_binary(idx + 1))
+                || (is_binary(idx) && is_eltwise(idx + 1));
+    };
 
     switch (p.len_) {
         case 0: return true; // no post_ops
-        case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-        case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+        case 1: return is_eltwise(0) || is_sum(0) || is_binary(0);
+        case 2:
+            return (is_sum(0) && (is_eltwise(1) || is_binary(1)))
+                    || is_eltwise_binary(0); // sum first if present
+        case 3: return is_sum(0) && is_eltwise_binary(1);
         default: return false;
     }
 
@@ -1218,6 +1251,20 @@ status_t jit_avx512_common_conv_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
         jcp.eltwise = p.entry_[eltwise_ind].eltwise;
         if (dst_d.data_type() == data_type::s32) return status::unimplemented;
     }
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+        const binary_post_op_t binary_po(p);
+        jcp.binary_alg = binary_po.alg;
+        jcp.binary_per_oc = binary_po.per_oc;
+        jcp.binary_after_eltwise = binary_ind > eltwise_ind;
+        // a vector of the channels has no values for the padded ones
+        bool ok = dst_d.data_type() == data_type::f32
+                && binary_post_op_t::post_ops_ok(p, dst_md)
+                && IMPLICATION(jcp.binary_per_oc,
+                        jcp.oc == jcp.oc_without_padding);
+        if (!ok) return status::unimplemented;
+    }
 
     auto src_tag = jcp.is_1stconv
             ? pick(ndims - 3, ncw, nchw, ncdhw)
@@ -38,7 +38,9 @@ struct _jit_avx512_common_conv_fwd_kernel : public jit_generator {
             eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                     this, jcp.eltwise);
 
-        generate();
+        // the code is defined by jcp
+        jit_kernel_cache::key_t key(name());
+        if (!restore_code(key.append(jcp))) generate();
         jit_ker_ = (void (*)(jit_conv_call_s *))getCode();
     }
 
@@ -128,6 +130,7 @@ private:
     jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
 
     inline void prepare_output(int ur_w);
+    inline void apply_binary(int ur_w);
     inline void store_output(int ur_w);
     inline void compute_loop_fma(int ur_w, int pad_l, int pad_r);
     inline void compute_loop_fma_core(int ur_w, int pad_l, int pad_r);
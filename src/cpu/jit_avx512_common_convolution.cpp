@@ -56,8 +56,10 @@ inline void jit_conv_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
 // The special case for the driver with ow-parallelization (FWD)
 inline void jit_conv_ker_pipeline_ow_thr(jit_conv_ker_t ker, jit_conv_call_s &p,
         const void *src, const void *dst, const void *filt, const void *bias,
-        int channel, int kh_padding, int owb) {
+        int channel, int kh_padding, int owb,
+        const void *post_ops_binary_rhs = nullptr) {
     PIPELINE(owb);
+    PIPELINE(post_ops_binary_rhs);
     jit_conv_ker_pipeline(ker, p, src, dst, filt, bias, channel, kh_padding);
 }
 // The special case for the driver with iw-parallelization (BWD)
@@ -89,7 +91,7 @@ inline void jit_conv_3d_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
 inline void jit_conv_3d_ker_pipeline_ow_thr(jit_conv_ker_t ker,
         jit_conv_call_s &p, const void *src, const void *dst, const void *filt,
         const void *bias, int channel, int kh_padding, int kd_padding,
-        int owb) {
+        int owb, const void *post_ops_binary_rhs) {
     PIPELINE(src);
     PIPELINE(dst);
     PIPELINE(filt);
@@ -100,6 +102,7 @@ inline void jit_conv_3d_ker_pipeline_ow_thr(jit_conv_ker_t ker,
     PIPELINE(kh_padding);
     PIPELINE(kd_padding);
     PIPELINE(owb);
+    PIPELINE(post_ops_binary_rhs);
 
     if (p.src) ker(&p);
 }
@@ -161,7 +164,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
 
 template <data_type_t src_type, data_type_t wei_type, data_type_t dst_type>
 void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
-        dst_type>::execute_forward_1d(const exec_ctx_t &ctx) const {
+        dst_type>::execute_forward_1d(
+        const exec_ctx_t &ctx, const float *binary_src1) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
@@ -214,6 +218,9 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
                 int ow_s = owb * jcp.ow_block;
                 int iw_s = ow_s * jcp.stride_w;
                 auto bias_w = bias ? bias + g_oc : nullptr;
+                auto binary_w = binary_src1
+                        ? binary_src1 + (jcp.binary_per_oc ? g_oc : 0)
+                        : nullptr;
                 auto dst_w = dst + dst_d.blk_off(n, g_ocb, ow_s);
                 auto src_w = src + src_d.blk_off(n, g_icb + icb_l2, iw_s);
                 auto wht_w = weights + wht_blk_off(weights_d, g, ocb, icb_l2);
@@ -221,7 +228,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
                 for (int icb = icb_l2;
                         icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2); ++icb) {
                     jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
-                            src_w, dst_w, wht_w, bias_w, icb, 1, owb);
+                            src_w, dst_w, wht_w, bias_w, icb, 1, owb,
+                            binary_w);
 
                     src_w += src_c_stride;
                     wht_w += wht_ic_stride;
@@ -251,7 +259,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
 
 template <data_type_t src_type, data_type_t wei_type, data_type_t dst_type>
 void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
-        dst_type>::execute_forward_2d(const exec_ctx_t &ctx) const {
+        dst_type>::execute_forward_2d(
+        const exec_ctx_t &ctx, const float *binary_src1) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
@@ -270,10 +279,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
     int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.oh * jcp.nb_ow;
     int nthr = jcp.aligned_threads;
 
-    parallel(nthr, [&](const int ithr, const int nthr) {
-        int start {0}, end {0}, start_copy;
-        balance211(work_amount, nthr, ithr, start, end);
-        start_copy = start;
+    auto ker = [&](int start, int end) {
+        int start_copy = start;
 
         auto par_conv = jit_conv_call_s();
         size_t src_h_stride = src_d.blk_off(0, 0, 1);
@@ -307,6 +314,9 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
                 int iw_s = ow_s * jcp.stride_w;
                 int oh_e = oh_s + work_rem > jcp.oh ? jcp.oh : oh_s + work_rem;
                 auto bias_w = bias ? bias + g_oc : nullptr;
+                auto binary_w = binary_src1
+                        ? binary_src1 + (jcp.binary_per_oc ? g_oc : 0)
+                        : nullptr;
 
                 for (int oh_b = oh_s; oh_b < oh_e; oh_b += jcp.h_blocking) {
                     int ih_b = -jcp.t_pad + oh_b * jcp.stride_h;
@@ -342,7 +352,7 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
 
                             jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker,
                                     par_conv, aux_src, dst_c, aux_wht, bias_w,
-                                    icb, kh_padding, owb);
+                                    icb, kh_padding, owb, binary_w);
 
                             src_c += src_h_stride * jcp.stride_h;
                             dst_c += dst_h_stride;
@@ -369,12 +379,26 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
         // with nullptr, other parameters are not used in real jit call here
         jit_conv_ker_pipeline_ow_thr(
                 kernel_->jit_ker, par_conv, src, dst, weights, bias, 0, 0, 0);
-    });
+    };
+
+    // the dynamic mode hands the (n, g, oc, oh, ow) blocks out in chunks, so
+    // threads that finish early take over the work of the slow ones
+    if (get_dynamic_scheduling())
+        parallel_dynamic(work_amount, [&](size_t start, size_t end) {
+            ker((int)start, (int)end);
+        });
+    else
+        parallel(nthr, [&](const int ithr, const int nthr) {
+            int start {0}, end {0};
+            balance211(work_amount, nthr, ithr, start, end);
+            ker(start, end);
+        });
 }
 
 template <data_type_t src_type, data_type_t wei_type, data_type_t dst_type>
 void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
-        dst_type>::execute_forward_3d(const exec_ctx_t &ctx) const {
+        dst_type>::execute_forward_3d(
+        const exec_ctx_t &ctx, const float *binary_src1) const {
     auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
@@ -444,6 +468,9 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
                         = nstl::max(0, jcp.kd - d_t_overflow - d_b_overflow);
 
                 auto bias_w = bias ? bias + bias_d.blk_off(g_oc) : 0;
+                auto binary_w = binary_src1
+                        ? binary_src1 + (jcp.binary_per_oc ? g_oc : 0)
+                        : nullptr;
                 auto dst_w = dst + dst_d.blk_off(n, g_ocb, od_s, oh_s, ow_s);
                 auto src_w = src
                         + src_d.blk_off(n, g_icb + icb_l2, id_s, ih_s, iw_s)
@@ -470,7 +497,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
                                 par_conv,
                                 src_c + i_t_overflow * dilate_h * src_h_stride,
                                 dst_c, wht_w + i_t_overflow * wht_h_stride,
-                                bias_w, icb, kh_padding, kd_padding, owb);
+                                bias_w, icb, kh_padding, kd_padding, owb,
+                                binary_w);
 
                         src_c += src_h_stride * jcp.stride_h;
                         dst_c += dst_h_stride;
@@ -496,8 +524,8 @@ void jit_avx512_common_convolution_fwd_t<src_type, wei_type,
         // on the last iteration of loop above. Only valid pointers make sense
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
-        jit_conv_3d_ker_pipeline(
-                kernel_->jit_ker, par_conv, src, dst, weights, bias, 0, 0, 0);
+        jit_conv_3d_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv, src, dst,
+                weights, bias, 0, 0, 0, 0, nullptr);
     });
 }
 
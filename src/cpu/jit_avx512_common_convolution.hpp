@@ -24,6 +24,7 @@
 
 #include "cpu_barrier.hpp"
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 #include "cpu_reducer.hpp"
 
 #include "jit_avx512_common_conv_kernel.hpp"
@@ -83,12 +84,13 @@ struct jit_avx512_common_convolution_fwd_t : public primitive_impl_t {
     typedef typename prec_traits<dst_type>::type dst_data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
+        DEFINE_BINARY_POST_OP_SRC1(binary_src1);
         if (pd()->ndims() == 3)
-            execute_forward_1d(ctx);
+            execute_forward_1d(ctx, binary_src1);
         else if (pd()->ndims() == 4)
-            execute_forward_2d(ctx);
+            execute_forward_2d(ctx, binary_src1);
         else if (pd()->ndims() == 5)
-            execute_forward_3d(ctx);
+            execute_forward_3d(ctx, binary_src1);
         else
             assert(false);
 
@@ -100,9 +102,12 @@ struct jit_avx512_common_convolution_fwd_t : public primitive_impl_t {
 private:
     void prepare_padded_bias(const dst_data_t *&bias,
             const memory_tracking::grantor_t &scratchpad) const;
-    void execute_forward_1d(const exec_ctx_t &ctx) const;
-    void execute_forward_2d(const exec_ctx_t &ctx) const;
-    void execute_forward_3d(const exec_ctx_t &ctx) const;
+    void execute_forward_1d(
+            const exec_ctx_t &ctx, const float *binary_src1) const;
+    void execute_forward_2d(
+            const exec_ctx_t &ctx, const float *binary_src1) const;
+    void execute_forward_3d(
+            const exec_ctx_t &ctx, const float *binary_src1) const;
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
     jit_avx512_common_conv_fwd_kernel *kernel_;
@@ -18,11 +18,14 @@
 #define CPU_JIT_GENERATOR_HPP
 
 #include <limits.h>
+#include <memory>
+#include <vector>
 
 #include "dnnl_thread.hpp"
 #include "utils.hpp"
 
 #include "cpu_isa_traits.hpp"
+#include "jit_kernel_cache.hpp"
 #include "jit_utils/jit_utils.hpp"
 
 #if defined(_WIN32) && !defined(__GNUC__)
@@ -1333,11 +1336,72 @@ public:
     virtual const char *name() const = 0;
     virtual const char *source_file() const = 0;
 
+    // The positions of label addresses in the code are recorded to relocate
+    // the code restored from the persistent kernel cache
+    using Xbyak::CodeGenerator::mov;
+    using Xbyak::CodeGenerator::putL;
+
+    void mov(const Xbyak::Reg64 &reg, const Xbyak::Label &label) {
+        Xbyak::CodeGenerator::mov(reg, label);
+        label_addr_offsets_.push_back(getSize() - sizeof(size_t));
+    }
+
+    void mov(const Xbyak::Reg64 &reg, const char *label) {
+        Xbyak::CodeGenerator::mov(reg, label);
+        if (label) label_addr_offsets_.push_back(getSize() - sizeof(size_t));
+    }
+
+    void putL(const Xbyak::Label &label) {
+        Xbyak::CodeGenerator::putL(label);
+        label_addr_offsets_.push_back(getSize() - sizeof(size_t));
+    }
+
+    void putL(std::string label) {
+        Xbyak::CodeGenerator::putL(label);
+        label_addr_offsets_.push_back(getSize() - sizeof(size_t));
+    }
+
+    /* Restores the code of the kernel from the persistent kernel cache (see
+     * jit_kernel_cache.hpp). Returns false if the code is not in the cache:
+     * the kernel must generate the code then, and getCode() stores it in the
+     * cache under the same key.
+     *
+     * Only the kernels which code is fully defined by the key and does not
+     * embed addresses other than the addresses of their own labels may use
+     * the cache.
+     */
+    bool restore_code(const jit_kernel_cache::key_t &key) {
+        if (!isAutoGrow() || getSize() != 0 || !jit_kernel_cache::is_enabled())
+            return false;
+
+        std::vector<uint8_t> code;
+        std::vector<size_t> relocations;
+        if (!jit_kernel_cache::load(key, code, relocations)) {
+            cache_key_.reset(new jit_kernel_cache::key_t(key));
+            return false;
+        }
+
+        db(code.data(), code.size());
+        // the label addresses are stored relative to the beginning of the
+        // code and are resolved by ready()
+        for (size_t offset : relocations) {
+            size_t addr;
+            utils::array_copy((uint8_t *)&addr, &code[offset], sizeof(addr));
+            save(offset, addr, sizeof(addr), Xbyak::inner::LaddTop);
+        }
+        return true;
+    }
+
     const Xbyak::uint8 *getCode() {
         this->ready();
         const Xbyak::uint8 *code = CodeGenerator::getCode();
         size_t code_size = getSize();
+        if (cache_key_) {
+            store_code(*cache_key_, code, code_size);
+            cache_key_.reset();
+        }
         jit_utils::register_jit_code(code, code_size, name(), source_file());
+        add_jit_code_size(code_size);
         return code;
     }
 
@@ -1345,6 +1409,26 @@ public:
     const F getCode() {
         return (const F)getCode();
     }
+
+private:
+    void store_code(const jit_kernel_cache::key_t &key,
+            const Xbyak::uint8 *code, size_t code_size) {
+        std::vector<uint8_t> relocated(code, code + code_size);
+        for (size_t offset : label_addr_offsets_) {
+            size_t addr;
+            utils::array_copy((uint8_t *)&addr, &code[offset], sizeof(addr));
+            // a label address must point into the code
+            if (addr < (size_t)code || addr > (size_t)code + code_size) return;
+            addr -= (size_t)code;
+            utils::array_copy(
+                    &relocated[offset], (uint8_t *)&addr, sizeof(addr));
+        }
+        jit_kernel_cache::store(
+                key, relocated.data(), relocated.size(), label_addr_offsets_);
+    }
+
+    std::vector<size_t> label_addr_offsets_;
+    std::unique_ptr<jit_kernel_cache::key_t> cache_key_;
 };
 
 } // namespace cpu
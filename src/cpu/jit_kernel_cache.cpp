@@ -0,0 +1,244 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "dnnl.h"
+
+#include "utils.hpp"
+#include "verbose.hpp"
+
+#include "cpu_isa_traits.hpp"
+#include "jit_kernel_cache.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace jit_kernel_cache {
+
+namespace {
+
+// Bump the version on any change of the file layout
+const char magic[8] = {'D', 'N', 'N', 'L', 'J', 'I', 'T', 'K'};
+const uint32_t format_version = 1;
+
+// Sanity limits for the sizes read from a file
+const uint64_t max_key_size = 1 << 20;
+const uint64_t max_code_size = 1 << 28;
+
+struct header_t {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t key_size;
+    uint64_t code_size;
+    uint64_t relocations;
+    uint64_t checksum;
+};
+
+// FNV-1a
+const uint64_t fnv_offset_basis = 14695981039346656037ULL;
+uint64_t fnv1a(uint64_t h, const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t checksum(const key_t &key, const uint8_t *code, size_t code_size,
+        const std::vector<uint64_t> &relocations) {
+    uint64_t h = fnv_offset_basis;
+    h = fnv1a(h, key.data().data(), key.data().size());
+    h = fnv1a(h, code, code_size);
+    h = fnv1a(h, relocations.data(), relocations.size() * sizeof(uint64_t));
+    return h;
+}
+
+std::mutex &dir_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::string &dir() {
+    static std::string d = []() {
+        char buf[4096];
+        if (getenv("DNNL_JIT_KERNEL_CACHE_DIR", buf, sizeof(buf)) > 0)
+            return std::string(buf);
+        return std::string();
+    }();
+    return d;
+}
+
+std::string get_dir() {
+    std::lock_guard<std::mutex> guard(dir_mutex());
+    return dir();
+}
+
+std::string file_name(const std::string &d, const key_t &key) {
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)key.hash());
+    return d + "/dnnl_" + key.name() + "_" + hash + ".bin";
+}
+
+bool read(FILE *fp, void *data, size_t size) {
+    return size == 0 || fread(data, size, 1, fp) == 1;
+}
+
+bool write(FILE *fp, const void *data, size_t size) {
+    return size == 0 || fwrite(data, size, 1, fp) == 1;
+}
+
+} // namespace
+
+key_t::key_t(const char *name) : name_(name) {
+    append(name_.data(), name_.size());
+
+    const dnnl_version_t *v = dnnl_version();
+    append(v->major).append(v->minor).append(v->patch);
+    append(v->hash, strlen(v->hash));
+    append(sizeof(void *));
+
+    // The code generated depends on the instruction sets the kernel may use
+    const cpu_isa_t isa[] = {sse41, avx, avx2, avx512_common, avx512_mic,
+            avx512_mic_4ops, avx512_core, avx512_core_vnni, avx512_core_bf16};
+    unsigned isa_mask = 0;
+    for (size_t i = 0; i < sizeof(isa) / sizeof(isa[0]); ++i)
+        if (mayiuse(isa[i])) isa_mask |= 1u << i;
+    append(isa_mask);
+}
+
+void key_t::append(const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+}
+
+uint64_t key_t::hash() const {
+    return fnv1a(fnv_offset_basis, data_.data(), data_.size());
+}
+
+bool is_enabled() {
+    return !get_dir().empty();
+}
+
+bool load(const key_t &key, std::vector<uint8_t> &code,
+        std::vector<size_t> &relocations) {
+    const std::string d = get_dir();
+    if (d.empty()) return false;
+
+    FILE *fp = fopen(file_name(d, key).c_str(), "rb");
+    if (!fp) return false;
+
+    header_t h;
+    std::vector<uint8_t> key_data;
+    std::vector<uint64_t> relocs;
+    bool ok = read(fp, &h, sizeof(h))
+            && !memcmp(h.magic, magic, sizeof(magic))
+            && h.format_version == format_version
+            && h.key_size == key.data().size() && h.key_size <= max_key_size
+            && h.code_size > 0 && h.code_size <= max_code_size
+            && h.relocations <= h.code_size / sizeof(uint64_t);
+    if (ok) {
+        key_data.resize(h.key_size);
+        code.resize(h.code_size);
+        relocs.resize(h.relocations);
+        ok = read(fp, key_data.data(), key_data.size())
+                && read(fp, code.data(), code.size())
+                && read(fp, relocs.data(), relocs.size() * sizeof(uint64_t))
+                && fgetc(fp) == EOF;
+    }
+    fclose(fp);
+
+    ok = ok && key_data == key.data()
+            && h.checksum == checksum(key, code.data(), code.size(), relocs);
+    for (size_t i = 0; ok && i < relocs.size(); ++i)
+        ok = relocs[i] + sizeof(uint64_t) <= code.size();
+    if (!ok) {
+        if (get_verbose() >= 2)
+            printf("dnnl_verbose,info,ignoring invalid jit kernel cache "
+                   "entry for %s\n",
+                    key.name().c_str());
+        return false;
+    }
+
+    relocations.assign(relocs.begin(), relocs.end());
+    return true;
+}
+
+void store(const key_t &key, const uint8_t *code, size_t code_size,
+        const std::vector<size_t> &relocations) {
+    const std::string d = get_dir();
+    if (d.empty() || code_size > max_code_size) return;
+
+    std::vector<uint64_t> relocs(relocations.begin(), relocations.end());
+    header_t h;
+    memcpy(h.magic, magic, sizeof(magic));
+    h.format_version = format_version;
+    h.key_size = (uint32_t)key.data().size();
+    h.code_size = code_size;
+    h.relocations = relocs.size();
+    h.checksum = checksum(key, code, code_size, relocs);
+
+    // The file is written under a unique name and then renamed, so other
+    // processes sharing the directory never read a partially written file
+    static std::atomic<unsigned> counter(0);
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), ".%d.%zx.%u.tmp", (int)getpid(),
+            std::hash<std::thread::id>()(std::this_thread::get_id()),
+            counter++);
+    const std::string name = file_name(d, key);
+    const std::string tmp_name = name + suffix;
+
+    FILE *fp = fopen(tmp_name.c_str(), "wb");
+    if (!fp) return;
+    bool ok = write(fp, &h, sizeof(h))
+            && write(fp, key.data().data(), key.data().size())
+            && write(fp, code, code_size)
+            && write(fp, relocs.data(), relocs.size() * sizeof(uint64_t));
+    ok = fclose(fp) == 0 && ok;
+
+    if (!ok || std::rename(tmp_name.c_str(), name.c_str()) != 0)
+        std::remove(tmp_name.c_str());
+}
+
+status_t set_dir(const char *d) {
+    std::lock_guard<std::mutex> guard(dir_mutex());
+    dir() = d ? d : "";
+    return status::success;
+}
+
+} // namespace jit_kernel_cache
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_set_jit_kernel_cache_dir(const char *dir) {
+    return dnnl::impl::cpu::jit_kernel_cache::set_dir(dir);
+}
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
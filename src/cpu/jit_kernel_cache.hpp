@@ -0,0 +1,91 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_KERNEL_CACHE_HPP
+#define CPU_JIT_KERNEL_CACHE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace jit_kernel_cache {
+
+// Persistent (on-disk) cache of the code generated by JIT kernels.
+//
+// The cache is disabled unless a directory is set with the
+// DNNL_JIT_KERNEL_CACHE_DIR environment variable or with
+// dnnl_set_jit_kernel_cache_dir(). Each kernel is stored in a separate file
+// together with its key and a checksum. A file that does not match the key
+// or the checksum is ignored and the kernel is generated again.
+//
+// Only the kernels which code is fully defined by the key and which do not
+// embed any addresses except the addresses of their own labels may use the
+// cache (see jit_generator::restore_code()).
+
+// The key of a kernel: the kernel name, the library version, the ISA
+// available and the configuration bytes appended by the kernel.
+struct key_t {
+    key_t(const char *name);
+
+    void append(const void *data, size_t size);
+
+    // The value must be trivially copyable and fully initialized, including
+    // padding, otherwise the kernel is never found in the cache.
+    template <typename T>
+    key_t &append(const T &value) {
+        append(&value, sizeof(value));
+        return *this;
+    }
+
+    const std::vector<uint8_t> &data() const { return data_; }
+    uint64_t hash() const;
+    const std::string &name() const { return name_; }
+
+private:
+    std::string name_;
+    std::vector<uint8_t> data_;
+};
+
+// Returns true if the cache directory is set.
+bool is_enabled();
+
+// Looks the kernel up in the cache. On success returns true, the code of the
+// kernel and the offsets of the 64-bit label addresses in the code. The
+// stored addresses are relative to the beginning of the code.
+bool load(const key_t &key, std::vector<uint8_t> &code,
+        std::vector<size_t> &relocations);
+
+// Stores the kernel in the cache. Failures are not reported as the kernel
+// is generated again next time.
+void store(const key_t &key, const uint8_t *code, size_t code_size,
+        const std::vector<size_t> &relocations);
+
+status_t set_dir(const char *dir);
+
+} // namespace jit_kernel_cache
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
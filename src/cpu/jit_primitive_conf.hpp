@@ -102,8 +102,12 @@ struct jit_conv_conf_t {
     bool with_bias;
     bool with_sum;
     bool with_eltwise;
+    bool with_binary;
 
     post_ops_t::entry_t::eltwise_t eltwise;
+    alg_kind_t binary_alg;
+    bool binary_per_oc; // the second source is a vector of the channels
+    bool binary_after_eltwise;
 
     int nthr, nthr_mb, nthr_g, nthr_oc_b, nthr_ic_b;
 
@@ -332,6 +336,8 @@ struct jit_conv_call_s {
     const void *dst_prf;
     const void *filt_prf;
     const void *bias_prf;
+    const void *post_ops_binary_rhs; // follows the bias if per channel
+    const void *post_ops_binary_rhs_prf;
     const void *scales;
     const void *acc_s32;
     const void *compensation;
@@ -424,8 +430,12 @@ struct jit_1x1_conv_conf_t {
     bool with_bias;
     bool with_sum;
     bool with_eltwise;
+    bool with_binary;
 
     post_ops_t::entry_t::eltwise_t eltwise;
+    alg_kind_t binary_alg;
+    bool binary_per_oc; // the second source is a vector of the channels
+    bool binary_after_eltwise;
 
     int is, os;
     int ic_block, oc_block;
@@ -465,6 +475,10 @@ struct jit_1x1_conv_conf_t {
     float wei_adj_scale;
 
     cpu_isa_t isa;
+
+    /* fused depthwise convolution */
+    bool with_dw_conv;
+    int dw_conv_buffer_rows; // output rows buffered per oc block
 };
 
 struct jit_gemm_conv_conf_t {
@@ -478,6 +492,7 @@ struct jit_gemm_conv_conf_t {
     int stride_h, stride_w, stride_d;
     int dilate_h, dilate_w, dilate_d;
     bool with_bias;
+    bool is_nspc;
 
     int is, os, ks;
     int ic_block, oc_block;
@@ -499,6 +514,7 @@ struct jit_1x1_conv_call_s {
     const void *load_data;
     const void *output_data;
     const void *bias_data; // used in forward and backward_weights only
+    const void *post_ops_binary_rhs; // used in forward only
     const void *acc_s32;
     const void *scales;
     const void *compensation;
@@ -62,7 +62,7 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward(
         (*kernel_)(&arg);
     };
 
-    parallel_nd(jpp.mb, jpp.nb_c, jpp.oh,
+    parallel_nd_dynamic(jpp.mb, jpp.nb_c, jpp.oh,
             [&](int n, int b_c, int oh) { ker(n, b_c, oh); });
 }
 
@@ -113,7 +113,7 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward_3d(
         (*kernel_)(&arg);
     };
 
-    parallel_nd(jpp.mb, jpp.nb_c, jpp.od, [&](int n, int b_c, int od) {
+    parallel_nd_dynamic(jpp.mb, jpp.nb_c, jpp.od, [&](int n, int b_c, int od) {
         const int ik = od * jpp.stride_d;
         const int d_t_overflow = nstl::max(0, jpp.f_pad - ik);
         const int d_b_overflow
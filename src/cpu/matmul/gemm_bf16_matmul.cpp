@@ -0,0 +1,240 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include <atomic>
+
+#include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
+#include "memory_tracking.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "gemm_bf16_matmul.hpp"
+
+#include "gemm/gemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace data_type;
+
+template <data_type_t dst_type>
+status_t gemm_bf16_matmul_t<dst_type>::pd_t::init() {
+    using namespace utils;
+
+    auto check_bias = [&]() -> bool {
+        if (!with_bias()) return true;
+
+        const auto &bia_md = *weights_md(1);
+        bool ok = one_of(bia_md.data_type, f32, bf16) && bia_md.dims[0] == 1
+                && IMPLICATION(batched(), bia_md.dims[1] == 1)
+                && bia_md.dims[batched() + 1] == dst_md()->dims[batched() + 1];
+
+        return ok;
+    };
+
+    auto check_attr_oscale = [&]() -> bool {
+        const auto &oscale = attr()->output_scales_;
+        return oscale.mask_ == 0
+                || (oscale.mask_ == (1 << 1) && batched() == false);
+    };
+
+    auto check_attr_post_ops = [&]() -> bool {
+        const auto &p = attr()->post_ops_;
+        return binary_post_op_t::sum_eltwise_binary_ok(p)
+                && binary_post_op_t::post_ops_ok(p, *dst_md(), !batched());
+    };
+
+    bool ok = mayiuse(avx512_core) && src_md()->data_type == src_type
+            && weights_md()->data_type == weights_type
+            && desc()->accum_data_type == acc_type
+            && dst_md()->data_type == dst_type && check_bias()
+            && attr()->has_default_values(
+                    primitive_attr_t::skip_mask_t::oscale_runtime
+                    | primitive_attr_t::skip_mask_t::post_ops)
+            && check_attr_oscale() && check_attr_post_ops()
+            && set_default_formats();
+    if (!ok) return status::unimplemented;
+
+    // The gemm scales dst by the sum post-op before the output scales are
+    // applied, so it can accumulate in dst only if the output scale is 1
+    const auto &oscale = attr()->output_scales_;
+    const bool do_sum = attr()->post_ops_.find(primitive_kind::sum) >= 0;
+    dst_is_acc_ = dst_type == f32
+            && IMPLICATION(do_sum,
+                    oscale.mask_ == 0 && oscale.scales_[0] == 1.f);
+
+    if (!dst_is_acc_ && !one_of(DNNL_RUNTIME_DIM_VAL, batch(), M(), N())) {
+        auto scratchpad = scratchpad_registry().registrar();
+        scratchpad.book(memory_tracking::names::key_matmul_dst_in_acc_dt,
+                sizeof(acc_data_t) * batch() * M() * N());
+    }
+
+    return status::success;
+}
+
+template <data_type_t dst_type>
+status_t gemm_bf16_matmul_t<dst_type>::execute_ref(
+        const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    const auto weights = CTX_IN_MEM(const weights_data_t *, DNNL_ARG_WEIGHTS);
+    const auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+
+    DEFINE_SCALES_BUFFER(scales);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
+
+    const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
+    const auto weights_d = ctx.memory_mdw(DNNL_ARG_WEIGHTS, pd()->weights_md());
+    const auto dst_d = ctx.memory_mdw(DNNL_ARG_DST, pd()->dst_md());
+
+    acc_data_t *acc = pd()->dst_is_acc_
+            ? (acc_data_t *)dst
+            : ctx.get_scratchpad_grantor().template get<acc_data_t>(
+                    memory_tracking::names::key_matmul_dst_in_acc_dt);
+
+    const auto &dst_bd = dst_d.blocking_desc();
+
+    const bool batched = pd()->batched();
+
+    const dim_t batch = batched ? dst_d.dims()[0] : 1;
+    const dim_t M = dst_d.dims()[batched + 0];
+    const dim_t N = dst_d.dims()[batched + 1];
+    const dim_t K = src_d.dims()[batched + 1];
+
+    // case: dynamic sizes
+    bool need_free_acc = false;
+    if (acc == nullptr) {
+        acc = (acc_data_t *)malloc(sizeof(acc_data_t) * batch * M * N, 64);
+        if (acc == nullptr) return status::out_of_memory;
+        need_free_acc = true;
+    }
+
+    const auto &src_strides = &src_d.blocking_desc().strides[batched];
+    const auto &weights_strides = &weights_d.blocking_desc().strides[batched];
+
+    // the batch of src and weights may be broadcast
+    const dim_t src_stride_mb = batched && src_d.dims()[0] > 1
+            ? src_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t weights_stride_mb = batched && weights_d.dims()[0] > 1
+            ? weights_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t dst_stride_mb = batched ? dst_bd.strides[0] : 0;
+    const dim_t acc_stride_mb = pd()->dst_is_acc_ ? dst_stride_mb : M * N;
+
+    const char *transA
+            = src_strides[1] == 1 && src_d.dims()[batched + 0] > 1 ? "N" : "T";
+    const char *transB
+            = weights_strides[1] == 1 && weights_d.dims()[batched + 0] > 1
+            ? "N"
+            : "T";
+
+    const int N_s32 = (int)N;
+    const int K_s32 = (int)K;
+
+    const int lda = (int)src_strides[*transA == 'N' ? 0 : 1];
+    const int ldb = (int)weights_strides[*transB == 'N' ? 0 : 1];
+    const int ldc = (int)dst_bd.strides[batched + 0];
+
+    const auto &post_ops = pd()->attr()->post_ops_;
+    const int sum_idx = post_ops.find(primitive_kind::sum);
+    const float alpha = 1;
+    const float beta = pd()->dst_is_acc_ && sum_idx >= 0
+            ? post_ops.entry_[sum_idx].sum.scale
+            : 0;
+
+    const bool postops_in_matmul = pd()->with_bias()
+            || post_ops.find(primitive_kind::eltwise) >= 0
+            || post_ops.find(primitive_kind::binary) >= 0
+            || !pd()->attr()->output_scales_.has_default_values()
+            || !pd()->dst_is_acc_;
+
+    // A single matrix is multiplied by a gemm call that uses all the threads.
+    // Otherwise the matrices are split into blocks of rows, so that there is
+    // work for every thread, and each block is multiplied by a sequential
+    // gemm call followed by the post-processing of the block, while it is
+    // still in cache.
+    const bool parallel_over_batch = batch > 1;
+    const int nthr = parallel_over_batch ? dnnl_get_max_threads() : 1;
+    const dim_t m_blocks_goal = batch < nthr ? utils::div_up(nthr, batch) : 1;
+    const dim_t m_blk = nstl::max<dim_t>(1, utils::div_up(M, m_blocks_goal));
+    const dim_t m_blocks = utils::div_up(M, m_blk);
+    const bool fuse_postops = postops_in_matmul && parallel_over_batch
+            && !pp_kernel_->sequential_kernel();
+
+    std::atomic<status_t> st(status::success);
+    parallel(nthr, [&](int ithr, int nthr) {
+        size_t start {}, end {};
+        balance211((size_t)(batch * m_blocks), nthr, ithr, start, end);
+
+        dim_t mb {}, m_blk_idx {};
+        utils::nd_iterator_init(start, mb, batch, m_blk_idx, m_blocks);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const dim_t m = m_blk_idx * m_blk;
+            const int M_s32 = (int)nstl::min(m_blk, M - m);
+
+            const src_data_t *curr_src
+                    = src + mb * src_stride_mb + m * src_strides[0];
+            const weights_data_t *curr_weights
+                    = weights + mb * weights_stride_mb;
+            acc_data_t *curr_acc = acc + mb * acc_stride_mb + m * ldc;
+
+            status_t status = gemm_bf16bf16f32(transB, transA, &N_s32, &M_s32,
+                    &K_s32, &alpha, curr_weights, &ldb, curr_src, &lda, &beta,
+                    curr_acc, &ldc);
+            assert(status == status::success);
+            if (status != status::success) st = status;
+
+            if (fuse_postops)
+                (*pp_kernel_)(dst + mb * dst_stride_mb + m * ldc, curr_acc,
+                        bias, scales, 0, (size_t)M_s32 * N, (size_t)N,
+                        nullptr, binary_src1);
+
+            utils::nd_iterator_step(mb, batch, m_blk_idx, m_blocks);
+        }
+    });
+
+    if (st == status::success && postops_in_matmul && !fuse_postops) {
+        const bool force_sequential = pp_kernel_->sequential_kernel();
+        for (dim_t mb = 0; mb < batch; ++mb) {
+            dst_data_t *curr_dst = dst + mb * dst_stride_mb;
+            const acc_data_t *curr_acc = acc + mb * acc_stride_mb;
+            parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
+                size_t start {}, end {};
+                balance211((size_t)(M * N), nthr, ithr, start, end);
+                (*pp_kernel_)(curr_dst, curr_acc, bias, scales, start, end,
+                        (size_t)N, nullptr, binary_src1);
+            });
+        }
+    }
+
+    if (need_free_acc) free(acc);
+
+    return st;
+}
+
+template struct gemm_bf16_matmul_t<f32>;
+template struct gemm_bf16_matmul_t<bf16>;
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
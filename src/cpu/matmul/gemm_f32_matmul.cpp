@@ -18,6 +18,8 @@
 #include <float.h>
 #include <math.h>
 
+#include <atomic>
+
 #include "c_types_map.hpp"
 #include "dnnl_thread.hpp"
 #include "type_helpers.hpp"
@@ -62,12 +64,9 @@ status_t gemm_f32_matmul_t::pd_t::init() {
             return p.contain(sum, idx) && attr()->output_scales_.mask_ == 0
                     && attr()->output_scales_.scales_[0] == 1.f;
         };
-        switch (p.len_) {
-            case 0: return true;
-            case 1: return check_sum(0) || p.contain(eltwise, 0);
-            case 2: return check_sum(0) && p.contain(eltwise, 1);
-            default: return false;
-        }
+        return binary_post_op_t::sum_eltwise_binary_ok(p)
+                && IMPLICATION(p.find(sum) != -1, check_sum(0))
+                && binary_post_op_t::post_ops_ok(p, *dst_md(), !batched());
     };
 
     auto can_use_gemm = [&]() -> bool {
@@ -79,8 +78,7 @@ status_t gemm_f32_matmul_t::pd_t::init() {
     bool ok = src_md()->data_type == src_type
             && weights_md()->data_type == weights_type
             && desc()->accum_data_type == acc_type
-            && dst_md()->data_type == dst_type && can_use_gemm() && batch() == 1
-            && check_bias()
+            && dst_md()->data_type == dst_type && can_use_gemm() && check_bias()
             && attr()->has_default_values(
                     primitive_attr_t::skip_mask_t::oscale_runtime
                     | primitive_attr_t::skip_mask_t::post_ops)
@@ -96,6 +94,7 @@ status_t gemm_f32_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
 
     DEFINE_SCALES_BUFFER(scales);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
     const auto weights_d = ctx.memory_mdw(DNNL_ARG_WEIGHTS, pd()->weights_md());
@@ -105,56 +104,104 @@ status_t gemm_f32_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
 
     const bool batched = pd()->batched();
 
+    const dim_t batch = batched ? dst_d.dims()[0] : 1;
     const dim_t M = dst_d.dims()[batched + 0];
     const dim_t N = dst_d.dims()[batched + 1];
     const dim_t K = src_d.dims()[batched + 1];
 
-    // gemm section
-    {
-        const auto &src_strides = &src_d.blocking_desc().strides[batched];
-        const auto &weights_strides
-                = &weights_d.blocking_desc().strides[batched];
-
-        const char *transA
-                = src_strides[1] == 1 && src_d.dims()[batched + 0] > 1 ? "N"
-                                                                       : "T";
-        const char *transB
-                = weights_strides[1] == 1 && weights_d.dims()[batched + 0] > 1
-                ? "N"
-                : "T";
-
-        const int M_s32 = (int)M;
-        const int N_s32 = (int)N;
-        const int K_s32 = (int)K;
-
-        const int lda = (int)src_strides[*transA == 'N' ? 0 : 1];
-        const int ldb = (int)weights_strides[*transB == 'N' ? 0 : 1];
-        const int ldc = (int)dst_bd.strides[batched + 0];
-
-        int sum_idx = pd()->attr()->post_ops_.find(primitive_kind::sum);
-        const float alpha = 1;
-        const float beta = sum_idx >= 0
-                ? pd()->attr()->post_ops_.entry_[sum_idx].sum.scale
-                : 0;
-
-        status_t status = extended_sgemm(transB, transA, &N_s32, &M_s32, &K_s32,
-                &alpha, weights, &ldb, src, &lda, &beta, dst, &ldc, nullptr,
-                false);
-        assert(status == status::success);
-        if (status != status::success) return status;
-    }
+    const auto &src_strides = &src_d.blocking_desc().strides[batched];
+    const auto &weights_strides = &weights_d.blocking_desc().strides[batched];
+
+    // the batch of src and weights may be broadcast
+    const dim_t src_stride_mb = batched && src_d.dims()[0] > 1
+            ? src_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t weights_stride_mb = batched && weights_d.dims()[0] > 1
+            ? weights_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t dst_stride_mb = batched ? dst_bd.strides[0] : 0;
+
+    const char *transA
+            = src_strides[1] == 1 && src_d.dims()[batched + 0] > 1 ? "N" : "T";
+    const char *transB
+            = weights_strides[1] == 1 && weights_d.dims()[batched + 0] > 1
+            ? "N"
+            : "T";
+
+    const int N_s32 = (int)N;
+    const int K_s32 = (int)K;
+
+    const int lda = (int)src_strides[*transA == 'N' ? 0 : 1];
+    const int ldb = (int)weights_strides[*transB == 'N' ? 0 : 1];
+    const int ldc = (int)dst_bd.strides[batched + 0];
+
+    int sum_idx = pd()->attr()->post_ops_.find(primitive_kind::sum);
+    const float alpha = 1;
+    const float beta = sum_idx >= 0
+            ? pd()->attr()->post_ops_.entry_[sum_idx].sum.scale
+            : 0;
 
     const bool postops_in_matmul = pd()->with_bias()
             || pd()->attr()->post_ops_.find(primitive_kind::eltwise) >= 0
+            || pd()->attr()->post_ops_.find(primitive_kind::binary) >= 0
             || !pd()->attr()->output_scales_.has_default_values();
 
-    if (postops_in_matmul) {
+    // A single matrix is multiplied by a gemm call that uses all the threads.
+    // Otherwise the matrices are split into blocks of rows, so that there is
+    // work for every thread, and each block is multiplied by a sequential
+    // gemm call followed by the post-processing of the block, while it is
+    // still in cache.
+    const bool parallel_over_batch = batch > 1;
+    const int nthr = parallel_over_batch ? dnnl_get_max_threads() : 1;
+    const dim_t m_blocks_goal = batch < nthr ? utils::div_up(nthr, batch) : 1;
+    const dim_t m_blk = nstl::max<dim_t>(1, utils::div_up(M, m_blocks_goal));
+    const dim_t m_blocks = utils::div_up(M, m_blk);
+    const bool fuse_postops = postops_in_matmul && parallel_over_batch
+            && !pp_kernel_->sequential_kernel();
+
+    std::atomic<status_t> st(status::success);
+    parallel(nthr, [&](int ithr, int nthr) {
+        size_t start {}, end {};
+        balance211((size_t)(batch * m_blocks), nthr, ithr, start, end);
+
+        dim_t mb {}, m_blk_idx {};
+        utils::nd_iterator_init(start, mb, batch, m_blk_idx, m_blocks);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const dim_t m = m_blk_idx * m_blk;
+            const int M_s32 = (int)nstl::min(m_blk, M - m);
+
+            const src_data_t *curr_src
+                    = src + mb * src_stride_mb + m * src_strides[0];
+            const weights_data_t *curr_weights
+                    = weights + mb * weights_stride_mb;
+            dst_data_t *curr_dst = dst + mb * dst_stride_mb + m * ldc;
+
+            status_t status = extended_sgemm(transB, transA, &N_s32, &M_s32,
+                    &K_s32, &alpha, curr_weights, &ldb, curr_src, &lda, &beta,
+                    curr_dst, &ldc, nullptr, false);
+            assert(status == status::success);
+            if (status != status::success) st = status;
+
+            if (fuse_postops)
+                (*pp_kernel_)(curr_dst, curr_dst, bias, scales, 0,
+                        (size_t)M_s32 * N, (size_t)N, nullptr, binary_src1);
+
+            utils::nd_iterator_step(mb, batch, m_blk_idx, m_blocks);
+        }
+    });
+    if (st != status::success) return st;
+
+    if (postops_in_matmul && !fuse_postops) {
         const bool force_sequential = pp_kernel_->sequential_kernel();
-        parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
-            size_t start {}, end {};
-            balance211((size_t)(M * N), nthr, ithr, start, end);
-            (*pp_kernel_)(dst, dst, bias, scales, start, end, (size_t)N);
-        });
+        for (dim_t mb = 0; mb < batch; ++mb) {
+            dst_data_t *curr_dst = dst + mb * dst_stride_mb;
+            parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
+                size_t start {}, end {};
+                balance211((size_t)(M * N), nthr, ithr, start, end);
+                (*pp_kernel_)(curr_dst, curr_dst, bias, scales, start, end,
+                        (size_t)N, nullptr, binary_src1);
+            });
+        }
     }
 
     return status::success;
@@ -18,6 +18,8 @@
 #include <float.h>
 #include <math.h>
 
+#include <atomic>
+
 #include "c_types_map.hpp"
 #include "dnnl_thread.hpp"
 #include "memory_tracking.hpp"
@@ -60,20 +62,15 @@ gemm_x8s8s32x_matmul_t<src_type, weights_type, dst_type>::pd_t::init() {
     };
 
     auto check_attr_post_ops = [&]() -> bool {
-        using namespace primitive_kind;
         const auto &p = attr()->post_ops_;
-        switch (p.len_) {
-            case 0: return true;
-            case 1: return p.contain(sum, 0) || p.contain(eltwise, 0);
-            case 2: return p.contain(sum, 0) && p.contain(eltwise, 1);
-            default: return false;
-        }
+        return binary_post_op_t::sum_eltwise_binary_ok(p)
+                && binary_post_op_t::post_ops_ok(p, *dst_md(), !batched());
     };
 
     bool ok = src_md()->data_type == src_type
             && weights_md()->data_type == weights_type
             && desc()->accum_data_type == acc_type
-            && dst_md()->data_type == dst_type && batch() == 1 && check_bias()
+            && dst_md()->data_type == dst_type && check_bias()
             && attr()->has_default_values(
                     primitive_attr_t::skip_mask_t::oscale_runtime
                     | primitive_attr_t::skip_mask_t::zero_points_runtime
@@ -109,6 +106,7 @@ status_t gemm_x8s8s32x_matmul_t<src_type, weights_type, dst_type>::execute_ref(
     DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
     DEFINE_ZERO_POINT_VALUE(weights_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     src_data_t gemm_off_a = (src_data_t)src_zero_point;
     weights_data_t gemm_off_b = (weights_data_t)weights_zero_point;
@@ -144,84 +142,134 @@ status_t gemm_x8s8s32x_matmul_t<src_type, weights_type, dst_type>::execute_ref(
         need_free_acc = true;
     }
 
-    // gemm section
-    {
-        const auto &src_strides = &src_d.blocking_desc().strides[batched];
-        const auto &weights_strides
-                = &weights_d.blocking_desc().strides[batched];
-
-        const char *transA
-                = src_strides[1] == 1 && src_d.dims()[batched + 0] > 1 ? "N"
-                                                                       : "T";
-        const char *transB
-                = weights_strides[1] == 1 && weights_d.dims()[batched + 0] > 1
-                ? "N"
-                : "T";
-
-        const int M_s32 = (int)M;
-        const int N_s32 = (int)N;
-        const int K_s32 = (int)K;
-
-        const int lda = (int)src_strides[*transA == 'N' ? 0 : 1];
-        const int ldb = (int)weights_strides[*transB == 'N' ? 0 : 1];
-        const int ldc = (int)dst_bd.strides[batched + 0];
-
-        const float onef = 1.0, zerof = 0.0;
-        const int32_t gemm_off_c = 0;
-
-        status_t status = gemm_s8x8s32(transB, transA, "F", &N_s32, &M_s32,
-                &K_s32, &onef, weights, &ldb, &gemm_off_b, src, &lda,
-                &gemm_off_a, &zerof, acc, &ldc, &gemm_off_c);
-        assert(status == status::success);
-        if (status != status::success) {
-            if (need_free_acc) free(acc);
-            return status;
-        }
+    const auto &src_strides = &src_d.blocking_desc().strides[batched];
+    const auto &weights_strides = &weights_d.blocking_desc().strides[batched];
 
-        // if igemm cannot handle src and weights zero points
-        if (post_process_src_and_weights_zero_points) {
-            std::vector<acc_data_t> src_compensation(M, 0);
-            std::vector<acc_data_t> weights_compensation(N, 0);
-
-            if (weights_zero_point) {
-                for_(dim_t m = 0; m < M; ++m)
-                for (dim_t k = 0; k < K; ++k)
-                    src_compensation[m]
-                            += src[src_strides[0] * m + src_strides[1] * k];
-            }
-
-            if (src_zero_point) {
-                for_(dim_t k = 0; k < K; ++k)
-                for (dim_t n = 0; n < N; ++n)
-                    weights_compensation[n] += weights[weights_strides[0] * k
-                            + weights_strides[1] * n];
-            }
-
-            for_(dim_t m = 0; m < M; ++m)
-            for (dim_t n = 0; n < N; ++n)
-                acc[m * ldc + n] += 0 - src_zero_point * weights_compensation[n]
-                        - weights_zero_point * src_compensation[m]
-                        + src_zero_point * weights_zero_point * (int)K;
-        }
-    }
+    // the batch of src and weights may be broadcast
+    const dim_t src_stride_mb = batched && src_d.dims()[0] > 1
+            ? src_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t weights_stride_mb = batched && weights_d.dims()[0] > 1
+            ? weights_d.blocking_desc().strides[0]
+            : 0;
+    const dim_t dst_stride_mb = batched ? dst_bd.strides[0] : 0;
+    const dim_t acc_stride_mb = pd()->dst_is_acc_ ? dst_stride_mb : M * N;
+
+    const char *transA
+            = src_strides[1] == 1 && src_d.dims()[batched + 0] > 1 ? "N" : "T";
+    const char *transB
+            = weights_strides[1] == 1 && weights_d.dims()[batched + 0] > 1
+            ? "N"
+            : "T";
+
+    const int N_s32 = (int)N;
+    const int K_s32 = (int)K;
+
+    const int lda = (int)src_strides[*transA == 'N' ? 0 : 1];
+    const int ldb = (int)weights_strides[*transB == 'N' ? 0 : 1];
+    const int ldc = (int)dst_bd.strides[batched + 0];
+
+    const float onef = 1.0, zerof = 0.0;
+    const int32_t gemm_off_c = 0;
 
     const bool postops_in_matmul = pd()->with_bias()
             || !pd()->attr()->has_default_values() || !pd()->dst_is_acc_
             || dst_type != s32 || dst_zero_point_f32 != 0.f;
 
-    if (postops_in_matmul) {
+    // if igemm cannot handle src and weights zero points
+    auto compensate_zero_points = [&](const src_data_t *curr_src,
+                                          const weights_data_t *curr_weights,
+                                          acc_data_t *curr_acc, dim_t M_blk) {
+        std::vector<acc_data_t> src_compensation(M_blk, 0);
+        std::vector<acc_data_t> weights_compensation(N, 0);
+
+        if (weights_zero_point) {
+            for_(dim_t m = 0; m < M_blk; ++m)
+            for (dim_t k = 0; k < K; ++k)
+                src_compensation[m]
+                        += curr_src[src_strides[0] * m + src_strides[1] * k];
+        }
+
+        if (src_zero_point) {
+            for_(dim_t k = 0; k < K; ++k)
+            for (dim_t n = 0; n < N; ++n)
+                weights_compensation[n] += curr_weights[weights_strides[0] * k
+                        + weights_strides[1] * n];
+        }
+
+        for_(dim_t m = 0; m < M_blk; ++m)
+        for (dim_t n = 0; n < N; ++n)
+            curr_acc[m * ldc + n] += 0
+                    - src_zero_point * weights_compensation[n]
+                    - weights_zero_point * src_compensation[m]
+                    + src_zero_point * weights_zero_point * (int)K;
+    };
+
+    // A single matrix is multiplied by a gemm call that uses all the threads.
+    // Otherwise the matrices are split into blocks of rows, so that there is
+    // work for every thread, and each block is multiplied by a sequential
+    // gemm call followed by the post-processing of the block, while it is
+    // still in cache.
+    const bool parallel_over_batch = batch > 1;
+    const int nthr = parallel_over_batch ? dnnl_get_max_threads() : 1;
+    const dim_t m_blocks_goal = batch < nthr ? utils::div_up(nthr, batch) : 1;
+    const dim_t m_blk = nstl::max<dim_t>(1, utils::div_up(M, m_blocks_goal));
+    const dim_t m_blocks = utils::div_up(M, m_blk);
+    const bool fuse_postops = postops_in_matmul && parallel_over_batch
+            && !pp_kernel_->sequential_kernel();
+
+    std::atomic<status_t> st(status::success);
+    parallel(nthr, [&](int ithr, int nthr) {
+        size_t start {}, end {};
+        balance211((size_t)(batch * m_blocks), nthr, ithr, start, end);
+
+        dim_t mb {}, m_blk_idx {};
+        utils::nd_iterator_init(start, mb, batch, m_blk_idx, m_blocks);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const dim_t m = m_blk_idx * m_blk;
+            const int M_s32 = (int)nstl::min(m_blk, M - m);
+
+            const src_data_t *curr_src
+                    = src + mb * src_stride_mb + m * src_strides[0];
+            const weights_data_t *curr_weights
+                    = weights + mb * weights_stride_mb;
+            acc_data_t *curr_acc = acc + mb * acc_stride_mb + m * ldc;
+
+            status_t status = gemm_s8x8s32(transB, transA, "F", &N_s32, &M_s32,
+                    &K_s32, &onef, curr_weights, &ldb, &gemm_off_b, curr_src,
+                    &lda, &gemm_off_a, &zerof, curr_acc, &ldc, &gemm_off_c);
+            assert(status == status::success);
+            if (status != status::success) st = status;
+
+            if (post_process_src_and_weights_zero_points)
+                compensate_zero_points(curr_src, curr_weights, curr_acc, M_s32);
+
+            if (fuse_postops)
+                (*pp_kernel_)(dst + mb * dst_stride_mb + m * ldc, curr_acc,
+                        bias, scales, 0, (size_t)M_s32 * N, (size_t)N,
+                        &dst_zero_point_f32, binary_src1);
+
+            utils::nd_iterator_step(mb, batch, m_blk_idx, m_blocks);
+        }
+    });
+
+    if (st == status::success && postops_in_matmul && !fuse_postops) {
         const bool force_sequential = pp_kernel_->sequential_kernel();
-        parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
-            size_t start {}, end {};
-            balance211((size_t)(M * N), nthr, ithr, start, end);
-            (*pp_kernel_)(dst, acc, bias, scales, start, end, (size_t)N,
-                    &dst_zero_point_f32);
-        });
+        for (dim_t mb = 0; mb < batch; ++mb) {
+            dst_data_t *curr_dst = dst + mb * dst_stride_mb;
+            const acc_data_t *curr_acc = acc + mb * acc_stride_mb;
+            parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
+                size_t start {}, end {};
+                balance211((size_t)(M * N), nthr, ithr, start, end);
+                (*pp_kernel_)(curr_dst, curr_acc, bias, scales, start, end,
+                        (size_t)N, &dst_zero_point_f32, binary_src1);
+            });
+        }
     }
 
     if (need_free_acc) free(acc);
 
-    return status::success;
+    return st;
 }
 
 template struct gemm_x8s8s32x_matmul_t<s8, s8, f32>;
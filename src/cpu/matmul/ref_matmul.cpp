@@ -43,6 +43,7 @@ status_t ref_matmul_t<src_type, weights_type, dst_type, acc_type>::execute_ref(
     DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
     DEFINE_ZERO_POINT_VALUE(weights_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
+    DEFINE_BINARY_POST_OP_SRC1(binary_src1);
 
     const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
     const auto weights_d = ctx.memory_mdw(DNNL_ARG_WEIGHTS, pd()->weights_md());
@@ -51,20 +52,27 @@ status_t ref_matmul_t<src_type, weights_type, dst_type, acc_type>::execute_ref(
 
     const bool batched = pd()->batched();
     const bool non_default_attrs = !pd()->attr()->has_default_values();
-    const bool do_sum = pd()->attr()->post_ops_.contain(primitive_kind::sum, 0);
+    const auto &post_ops = pd()->attr()->post_ops_;
+    const binary_post_op_t binary_po(post_ops);
 
     const dim_t MB = batched ? dst_d.dims()[0] : 1;
     const dim_t M = dst_d.dims()[batched + 0];
     const dim_t N = dst_d.dims()[batched + 1];
     const dim_t K = src_d.dims()[batched + 1];
 
+    // the batch of src and weights may be broadcast
+    const bool src_bcast = batched && src_d.dims()[0] == 1;
+    const bool wei_bcast = batched && weights_d.dims()[0] == 1;
+
     // mm kernel
     auto ker = [&](dim_t mb, dim_t m, dim_t n) {
         acc_data_t acc = 0;
+        const dim_t src_mb = src_bcast ? 0 : mb;
+        const dim_t wei_mb = wei_bcast ? 0 : mb;
         if (batched)
             for (dim_t k = 0; k < K; ++k)
-                acc += (src[src_d.off(mb, m, k)] - src_zero_point)
-                        * (weights[weights_d.off(mb, k, n)]
+                acc += (src[src_d.off(src_mb, m, k)] - src_zero_point)
+                        * (weights[weights_d.off(wei_mb, k, n)]
                                 - weights_zero_point);
         else
             for (dim_t k = 0; k < K; ++k)
@@ -104,8 +112,19 @@ status_t ref_matmul_t<src_type, weights_type, dst_type, acc_type>::execute_ref(
             float res = acc;
             if (bias) res += get_bias(mb, m, n);
             res *= scales[scale_stride * n];
-            if (do_sum) res += dst_value;
-            if (eltwise_ker_) res = eltwise_ker_->compute_scalar(res);
+            for (int idx = 0; idx < post_ops.len_; ++idx) {
+                const auto &e = post_ops.entry_[idx];
+                if (e.is_sum(false)) {
+                    res += dst_value;
+                } else if (e.is_eltwise(false)) {
+                    res = eltwise_ker_->compute_scalar(res);
+                } else if (e.is_binary()) {
+                    // the channel is dimension 1 of the destination
+                    const dim_t c = batched ? m : n;
+                    res = binary_po.compute_scalar(
+                            res, binary_src1[binary_po.per_oc ? c : 0]);
+                }
+            }
             res += (float)dst_zero_point;
             if (dst_type == data_type::f32)
                 dst_value = res;
@@ -26,6 +26,7 @@
 #include "cpu_matmul_pd.hpp"
 
 #include "cpu_isa_traits.hpp"
+#include "cpu_primitive.hpp"
 #include "ref_eltwise.hpp"
 
 namespace dnnl {
@@ -77,14 +78,9 @@ struct ref_matmul_t : public primitive_impl_t {
         }
 
         bool attr_post_ops_ok() const {
-            using namespace primitive_kind;
             const auto &p = attr()->post_ops_;
-            switch (p.len_) {
-                case 0: return true;
-                case 1: return p.contain(sum, 0) || p.contain(eltwise, 0);
-                case 2: return p.contain(sum, 0) && p.contain(eltwise, 1);
-                default: return false;
-            }
+            return binary_post_op_t::sum_eltwise_binary_ok(p)
+                    && binary_post_op_t::post_ops_ok(p, *dst_md());
         }
     };
 
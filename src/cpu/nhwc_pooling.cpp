@@ -112,7 +112,7 @@ void nhwc_pooling_fwd_t<d_type>::execute_forward(const exec_ctx_t &ctx) const {
         return (index > offset) ? index - offset : 0;
     };
 
-    parallel_nd(MB, OD, OH, OW, [&](int mb, int od, int oh, int ow) {
+    parallel_nd_dynamic(MB, OD, OH, OW, [&](int mb, int od, int oh, int ow) {
         size_t dst_offset_init = strided_offset(mb, dst_n_stride, od,
                 dst_d_stride, oh, dst_h_stride, ow, dst_w_stride);
         if (alg == alg_kind::pooling_max) {
@@ -246,7 +246,7 @@ void nhwc_pooling_fwd_t<data_type::bf16>::execute_forward(
         return (index > offset) ? index - offset : 0;
     };
 
-    parallel_nd(MB, OD, OH, OW, [&](int mb, int od, int oh, int ow) {
+    parallel_nd_dynamic(MB, OD, OH, OW, [&](int mb, int od, int oh, int ow) {
         size_t dst_offset_init = strided_offset(mb, dst_n_stride, od,
                 dst_d_stride, oh, dst_h_stride, ow, dst_w_stride);
         if (alg == alg_kind::pooling_max) {
@@ -113,7 +113,7 @@ void ref_convolution_fwd_t<src_type, wei_type, dst_type,
         return d;
     };
 
-    parallel_nd(G, MB, OC, OD, OH, OW,
+    parallel_nd_dynamic(G, MB, OC, OD, OH, OW,
             [&](int g, int mb, int oc, int od, int oh, int ow) {
                 float a = bias ? get_bias(bias, bias_d.off(g * OC + oc),
                                   pd()->desc()->bias_desc.data_type)
@@ -226,7 +226,7 @@ void ref_convolution_bwd_data_t<diff_src_type, wei_type, diff_dst_type,
         return d;
     };
 
-    parallel_nd(G, MB, IC, ID, IH, IW,
+    parallel_nd_dynamic(G, MB, IC, ID, IH, IW,
             [&](int g, int mb, int ic, int id, int ih, int iw) {
                 auto ds_idx = (ndims == 5)
                         ? diff_src_d.off(mb, g * IC + ic, id, ih, iw)
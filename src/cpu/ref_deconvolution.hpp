@@ -176,11 +176,18 @@ struct ref_deconvolution_fwd_t : public primitive_impl_t {
 
         status_t init() {
             using namespace format_tag;
+            using smask_t = primitive_attr_t::skip_mask_t;
+            // the int8 attributes are handled by the convolution
+            const bool is_int8 = utils::one_of(
+                    desc()->src_desc.data_type, data_type::u8, data_type::s8);
             bool ok = true && is_fwd()
                     && utils::one_of(desc()->alg_kind,
                             alg_kind::deconvolution_direct,
                             alg_kind::deconvolution_winograd)
-                    && attr()->has_default_values();
+                    && attr()->has_default_values(is_int8
+                                    ? smask_t::oscale
+                                            | smask_t::zero_points_runtime
+                                    : smask_t::none);
 
             if (ok) {
                 CHECK(init_convolution());
@@ -229,6 +236,10 @@ struct ref_deconvolution_fwd_t : public primitive_impl_t {
         if (pd()->with_bias() && pd()->conv_supports_bias_)
             conv_args[DNNL_ARG_BIAS] = args.at(DNNL_ARG_BIAS);
         conv_args[DNNL_ARG_DIFF_SRC] = args.at(DNNL_ARG_DST);
+        for (int arg : {DNNL_ARG_SRC, DNNL_ARG_DST}) {
+            const int zp_arg = DNNL_ARG_ATTR_ZERO_POINTS | arg;
+            if (args.count(zp_arg)) conv_args[zp_arg] = args.at(zp_arg);
+        }
         if (!types::is_zero_md(pd()->scratchpad_md()))
             conv_args[DNNL_ARG_SCRATCHPAD] = args.at(DNNL_ARG_SCRATCHPAD);
         exec_ctx_t conv_ctx(ctx.stream(), std::move(conv_args));
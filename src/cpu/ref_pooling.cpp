@@ -132,7 +132,7 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
     const int OW = pd()->OW();
 
     if (alg == alg_kind::pooling_max) {
-        parallel_nd(MB, OC, OD, OH, OW,
+        parallel_nd_dynamic(MB, OC, OD, OH, OW,
                 [&](int mb, int oc, int od, int oh, int ow) {
                     data_t *d = is_3d ? &dst[dst_d.off(mb, oc, od, oh, ow)]
                                       : &dst[dst_d.off(mb, oc, oh, ow)];
@@ -141,7 +141,7 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
                     ker_max(d, mb, oc, od, oh, ow);
                 });
     } else {
-        parallel_nd(MB, OC, OD, OH, OW,
+        parallel_nd_dynamic(MB, OC, OD, OH, OW,
                 [&](int mb, int oc, int od, int oh, int ow) {
                     data_t *d = is_3d ? &dst[dst_d.off(mb, oc, od, oh, ow)]
                                       : &dst[dst_d.off(mb, oc, oh, ow)];
@@ -41,18 +41,64 @@ rnn_cell_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
                     && (cell_position & last_iter)
                     && !(cell_position & first_layer));
     if (need_layer_gemm) {
-        (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dic, rnn.mb,
+        (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dhc, rnn.mb,
                 rnn.slc, 1.0, w_layer_[0], rnn.weights_layer_ld, states_t_lm1_,
                 src_layer_ld, 0.0, scratch_gates_, rnn.gates_ws_ld);
     }
-    (this->*gemm_iter_func)('N', 'N', rnn.n_gates * rnn.dic, rnn.mb, rnn.sic,
+    (this->*gemm_iter_func)('N', 'N', rnn.n_gates * rnn.dhc, rnn.mb, rnn.sic,
             1.0, w_iter_[0], rnn.weights_iter_ld, states_tm1_l_, src_iter_ld,
             1.0, scratch_gates_, rnn.gates_ws_ld);
 
-    rnn_postgemm_->execute(rnn, cell_position, ws_gates_, scratch_gates_,
-            states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
+    if (!rnn.is_lstm_projection) {
+        rnn_postgemm_->execute(rnn, cell_position, ws_gates_, scratch_gates_,
+                states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
+                diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
+                bias_[0], weights_peephole_, ws_grid_, scratch_cell_,
+                states_t_l_copy_);
+        return;
+    }
+
+    // With a projection, the postgemm computes the dhc channels of the
+    // hidden state in the scratch, and the projection gemm reduces them to
+    // the dic channels of the cell output
+    src_data_t *proj_ht = reinterpret_cast<src_data_t *>(scratch_cell_);
+    const cell_position_t proj_ht_position = static_cast<cell_position_t>(
+            cell_position & ~(last_layer | last_iter));
+    rnn_postgemm_->execute(rnn, proj_ht_position, ws_gates_, scratch_gates_,
+            proj_ht, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
             diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_, bias_[0],
-            ws_grid_, scratch_cell_, states_t_l_copy_);
+            weights_peephole_, ws_grid_, nullptr, nullptr);
+
+    const int dst_ld = rnn.dst_ld(cell_position);
+    if (std::is_same<src_data_t, acc_data_t>::value) {
+        gemm('N', 'N', rnn.dic, rnn.mb, rnn.dhc, 1.0, w_projection_,
+                rnn.weights_projection_ld, proj_ht, rnn.states_ws_ld, 0.0,
+                reinterpret_cast<acc_data_t *>(states_t_l_), dst_ld);
+    } else {
+        // the accumulation happens in f32 and is converted to the states
+        // data type afterwards
+        acc_data_t *proj_acc = reinterpret_cast<acc_data_t *>(scratch_cell_)
+                + rnn.states_nld * rnn.states_ws_ld;
+        gemm('N', 'N', rnn.dic, rnn.mb, rnn.dhc, 1.0, w_projection_,
+                rnn.weights_projection_ld, proj_ht, rnn.states_ws_ld, 0.0,
+                proj_acc, rnn.states_ws_ld);
+        parallel_nd(rnn.mb, [&](int i) {
+            PRAGMA_OMP_SIMD()
+            for (int j = 0; j < rnn.dic; j++)
+                states_t_l_[i * dst_ld + j]
+                        = (src_data_t)proj_acc[i * rnn.states_ws_ld + j];
+        });
+    }
+
+    if (states_t_l_copy_) {
+        const int dst_copy_ld = rnn.dst_copy_ld(cell_position);
+        parallel_nd(rnn.mb, [&](int i) {
+            PRAGMA_OMP_SIMD()
+            for (int j = 0; j < rnn.dic; j++)
+                states_t_l_copy_[i * dst_copy_ld + j]
+                        = states_t_l_[i * dst_ld + j];
+        });
+    }
 }
 template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution);
 template rnn_cell_execution_sig(ref_rnn_fwd_bf16_t::cell_execution);
@@ -77,7 +123,7 @@ void common_bwd_cell_exec_template(T1 gemm_layer_f, T2 gemm_iter_f,
     rnn_postgemm->execute(rnn, cell_position, ws_gates_, scratch_gates_,
             states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
             diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_, bias_[0],
-            ws_grid_, scratch_cell_, states_t_l_copy_);
+            nullptr, ws_grid_, scratch_cell_, states_t_l_copy_);
 
     /// bwd by data on the cell
     gemm_iter_f(w_iter_[0], scratch_gates_, diff_states_t_l_);
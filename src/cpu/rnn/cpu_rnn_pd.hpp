@@ -48,6 +48,12 @@ protected:
             CHECK(memory_desc_init_by_tag(src_iter_c_md_, ldnc));
         if (with_bias() && bias_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(bias_md_, ldgo));
+        if (with_peephole()
+                && weights_peephole_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_peephole_md_, ldgo));
+        if (with_projection()
+                && weights_projection_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_projection_md_, ldio));
         if (with_dst_iter() && dst_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(dst_iter_md_, ldnc));
         if (with_dst_iter_c() && dst_iter_c_md_.format_kind == format_kind::any)
@@ -97,7 +103,11 @@ protected:
 
         ok = ok
                 && IMPLICATION(!is_zero_md(&bias_md_),
-                        memory_desc_matches_tag(bias_md_, ldgo));
+                        memory_desc_matches_tag(bias_md_, ldgo))
+                && IMPLICATION(!is_zero_md(&weights_peephole_md_),
+                        memory_desc_matches_tag(weights_peephole_md_, ldgo))
+                && IMPLICATION(!is_zero_md(&weights_projection_md_),
+                        memory_desc_matches_tag(weights_projection_md_, ldio));
 
         /* Int8 is supported only for packed weights */
         data_type_t weights_iter_dt = weights_iter_md_.data_type;
@@ -66,6 +66,7 @@ protected:
     size_t scratch_dt_size = types::data_type_size(scratch_data_t);
     size_t gate_dt_size = types::data_type_size(src_data_t);
     size_t bias_dt_size = sizeof(float);
+    size_t qscale_dt_size = sizeof(float);
 
     void generate() {
         using namespace Xbyak;
@@ -84,7 +85,7 @@ protected:
         Reg64 table_reg(rbx); // table is used for data scale and shifts
 
         // We skip vmm0 as it can be used by the injector for masks on sse4.1
-        Vmm G0(1), G1(2), G2(3), tmp1_vmm(5), tmp2_vmm(6);
+        Vmm G0(1), G1(2), G2(3), tmp1_vmm(5), tmp2_vmm(6), tmp3_vmm(7);
 
         // constant table map
         Address one_addr = ptr[table_reg];
@@ -149,20 +150,40 @@ protected:
         {
             // Compute gate 0
             uni_vmovups(G0, sg_addr(0));
-            uni_vmovups(tmp1_vmm, B_addr(0));
-            uni_vaddps(G0, G0, tmp1_vmm);
-            uni_vmovups(tmp1_vmm, sc_addr(0));
-            uni_vaddps(G0, G0, tmp1_vmm);
+            if (src_data_t == data_type::u8) {
+                // both gemms use the same weights scales, so the s32
+                // results are summed up before dequantization
+                uni_vmovups(tmp1_vmm, sc_addr(0));
+                uni_vpaddd(G0, G0, tmp1_vmm);
+                deq_w(G0, tmp1_vmm, tmp2_vmm, 0, true);
+                uni_vmovups(tmp1_vmm, B_addr(0));
+                uni_vaddps(G0, G0, tmp1_vmm);
+            } else {
+                uni_vmovups(tmp1_vmm, B_addr(0));
+                uni_vaddps(G0, G0, tmp1_vmm);
+                uni_vmovups(tmp1_vmm, sc_addr(0));
+                uni_vaddps(G0, G0, tmp1_vmm);
+            }
             sigmoid_injector_->compute_vector(G0.getIdx());
             // if training we write back the gates
             if (is_training) to_src<src_data_t>(wg_addr(0), G0, vlen);
 
             // Compute gate 1
             uni_vmovups(G1, sg_addr(1));
-            uni_vmovups(tmp1_vmm, B_addr(1));
-            uni_vaddps(G1, G1, tmp1_vmm);
-            uni_vmovups(tmp1_vmm, sc_addr(1));
-            uni_vaddps(G1, G1, tmp1_vmm);
+            if (src_data_t == data_type::u8) {
+                // both gemms use the same weights scales, so the s32
+                // results are summed up before dequantization
+                uni_vmovups(tmp1_vmm, sc_addr(1));
+                uni_vpaddd(G1, G1, tmp1_vmm);
+                deq_w(G1, tmp1_vmm, tmp2_vmm, 1, true);
+                uni_vmovups(tmp1_vmm, B_addr(1));
+                uni_vaddps(G1, G1, tmp1_vmm);
+            } else {
+                uni_vmovups(tmp1_vmm, B_addr(1));
+                uni_vaddps(G1, G1, tmp1_vmm);
+                uni_vmovups(tmp1_vmm, sc_addr(1));
+                uni_vaddps(G1, G1, tmp1_vmm);
+            }
             sigmoid_injector_->compute_vector(G1.getIdx());
             // if training we write back the gates
             if (is_training) to_src<src_data_t>(wg_addr(1), G1, vlen);
@@ -171,10 +192,14 @@ protected:
             auto wh_b_addr = sc_addr(2);
             auto ws_h_addr = ptr[addr_ws_h_reg];
             uni_vmovups(tmp1_vmm, wh_b_addr);
+            if (src_data_t == data_type::u8)
+                deq_w(tmp1_vmm, tmp2_vmm, tmp3_vmm, 2, true);
             uni_vmovups(tmp2_vmm, B_addr(3));
             uni_vaddps(tmp1_vmm, tmp1_vmm, tmp2_vmm);
             if (is_training) to_src<src_data_t>(ws_h_addr, tmp1_vmm, vlen);
             uni_vmovups(G2, sg_addr(2));
+            if (src_data_t == data_type::u8)
+                deq_w(G2, tmp2_vmm, tmp3_vmm, 2, true);
             uni_vmovups(tmp2_vmm, B_addr(2));
             uni_vaddps(G2, G2, tmp2_vmm);
             uni_vfmadd231ps(G2, G1, tmp1_vmm);
@@ -206,6 +231,7 @@ protected:
             add(addr_states_tm1_l_reg, vlen_dst);
             add(addr_scratch_cell_reg, vlen);
             if (is_training) add(addr_ws_gates_reg, vlen_dst);
+            inc_regs(vlen);
 
             // increment loop counter
             sub(loop_cnt, vlen);
@@ -226,8 +252,15 @@ protected:
 
             // Compute gate 0
             uni_vmovss(G0s, sg_addr(0));
-            uni_vaddss(G0s, G0s, B_addr(0));
-            uni_vaddss(G0s, G0s, sc_addr(0));
+            if (src_data_t == data_type::u8) {
+                uni_vmovss(tmp1s_vmm, sc_addr(0));
+                uni_vpaddd(G0s, G0s, tmp1s_vmm);
+                deq_w(G0, tmp1_vmm, tmp2_vmm, 0, false);
+                uni_vaddss(G0s, G0s, B_addr(0));
+            } else {
+                uni_vaddss(G0s, G0s, B_addr(0));
+                uni_vaddss(G0s, G0s, sc_addr(0));
+            }
             sigmoid_injector_->compute_vector(G0s.getIdx());
             // if training we write back the gates
             if (is_training)
@@ -235,8 +268,15 @@ protected:
 
             // Compute gate 1
             uni_vmovss(G1s, sg_addr(1));
-            uni_vaddss(G1s, G1s, B_addr(1));
-            uni_vaddss(G1s, G1s, sc_addr(1));
+            if (src_data_t == data_type::u8) {
+                uni_vmovss(tmp1s_vmm, sc_addr(1));
+                uni_vpaddd(G1s, G1s, tmp1s_vmm);
+                deq_w(G1, tmp1_vmm, tmp2_vmm, 1, false);
+                uni_vaddss(G1s, G1s, B_addr(1));
+            } else {
+                uni_vaddss(G1s, G1s, B_addr(1));
+                uni_vaddss(G1s, G1s, sc_addr(1));
+            }
             sigmoid_injector_->compute_vector(G1s.getIdx());
             // if training we write back the gates
             if (is_training)
@@ -246,10 +286,14 @@ protected:
             auto wh_b_addr = sc_addr(2);
             auto ws_h_addr = ptr[addr_ws_h_reg];
             uni_vmovss(tmp1s_vmm, wh_b_addr);
+            if (src_data_t == data_type::u8)
+                deq_w(tmp1_vmm, tmp2_vmm, tmp3_vmm, 2, false);
             uni_vaddss(tmp1s_vmm, tmp1s_vmm, B_addr(3));
             if (is_training)
                 to_src<src_data_t>(ws_h_addr, tmp1_vmm, scratch_dt_size);
             uni_vmovss(G2s, sg_addr(2));
+            if (src_data_t == data_type::u8)
+                deq_w(G2, tmp2_vmm, tmp3_vmm, 2, false);
             uni_vaddss(G2s, G2s, B_addr(2));
             uni_vfmadd231ss(G2s, G1s, tmp1s_vmm);
             tanh_injector_->compute_vector(G2s.getIdx());
@@ -283,6 +327,7 @@ protected:
             add(addr_states_tm1_l_reg, hstate_dt_size);
             add(addr_scratch_cell_reg, scratch_dt_size);
             if (is_training) add(addr_ws_gates_reg, gate_dt_size);
+            inc_regs(qscale_dt_size);
 
             // increment loop counter
             sub(loop_cnt, scratch_dt_size);
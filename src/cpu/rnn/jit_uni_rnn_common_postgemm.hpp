@@ -305,6 +305,22 @@ protected:
 #endif
     }
 
+    // dequantize from u8 to float
+    template <typename Vmm>
+    void deq_h(Vmm dst, Xbyak::Address src, int in_len) {
+        if (in_len == 4) {
+            Xbyak::Xmm dst_s(dst.getIdx());
+            pinsrb(dst_s, src, 0x0);
+            pmovzxbd(dst_s, dst_s);
+        } else if (mayiuse(avx))
+            vpmovzxbd(dst, src);
+        else
+            pmovzxbd(dst, src);
+        uni_vcvtdq2ps(dst, dst);
+        uni_vsubps(dst, dst, dshift_off_addr);
+        uni_vdivps(dst, dst, dscale_off_addr);
+    }
+
     // upconvert from bf16 to float
     template <typename Vmm>
     void bf16_uc(Vmm dst, Xbyak::Address src, int in_len) {
@@ -380,6 +396,7 @@ protected:
                     assert(!"unsupported");
                 break;
             case data_type::bf16: bf16_uc(dst, src, in_len); break;
+            case data_type::u8: deq_h(dst, src, in_len); break;
             default: assert(!"unsupported");
         }
     }
@@ -67,7 +67,8 @@ struct rnn_postgemm_dispatcher {
                                 prop_kind::forward_training)
                 && utils::one_of(src_type, data_type::f32, data_type::u8,
                         data_type::bf16)
-                && !pd->attr()->rnn_tparams_.test_mode_;
+                && !pd->attr()->rnn_tparams_.test_mode_
+                && !rnn.is_lstm_peephole && !rnn.is_lstm_projection;
 
         switch (pd->cell_kind()) {
             case alg_kind::vanilla_lstm:
@@ -186,14 +187,14 @@ struct rnn_postgemm_dispatcher {
             rnn_postgemm_->execute(rnn, cell_position, ws_gates_,
                     scratch_gates_, states_t_l_, c_states_t_l_, states_tm1_l_,
                     c_states_tm1_l_, diff_states_t_l_, diff_states_t_lp1_,
-                    diff_states_tp1_l_, bias_, ws_grid_, scratch_cell_,
-                    states_t_l_copy_);
+                    diff_states_tp1_l_, bias_, weights_peephole_, ws_grid_,
+                    scratch_cell_, states_t_l_copy_);
         else
             (this->*postgemm_func)(rnn, cell_position, ws_gates_,
                     scratch_gates_, states_t_l_, c_states_t_l_, states_tm1_l_,
                     c_states_tm1_l_, diff_states_t_l_, diff_states_t_lp1_,
-                    diff_states_tp1_l_, bias_, ws_grid_, scratch_cell_,
-                    states_t_l_copy_);
+                    diff_states_tp1_l_, bias_, weights_peephole_, ws_grid_,
+                    scratch_cell_, states_t_l_copy_);
     }
 
     // template <typename src_data_t, typename acc_data_t>
@@ -202,14 +203,14 @@ struct rnn_postgemm_dispatcher {
             rnn_postgemm_part2_->execute(rnn, cell_position, ws_gates_,
                     scratch_gates_, states_t_l_, c_states_t_l_, states_tm1_l_,
                     c_states_tm1_l_, diff_states_t_l_, diff_states_t_lp1_,
-                    diff_states_tp1_l_, bias_, ws_grid_, scratch_cell_,
-                    states_t_l_copy_);
+                    diff_states_tp1_l_, bias_, weights_peephole_, ws_grid_,
+                    scratch_cell_, states_t_l_copy_);
         else
             (this->*postgemm_part2_func)(rnn, cell_position, ws_gates_,
                     scratch_gates_, states_t_l_, c_states_t_l_, states_tm1_l_,
                     c_states_tm1_l_, diff_states_t_l_, diff_states_t_lp1_,
-                    diff_states_tp1_l_, bias_, ws_grid_, scratch_cell_,
-                    states_t_l_copy_);
+                    diff_states_tp1_l_, bias_, weights_peephole_, ws_grid_,
+                    scratch_cell_, states_t_l_copy_);
     }
 
 private:
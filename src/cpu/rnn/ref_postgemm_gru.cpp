@@ -21,6 +21,7 @@
 #include "dnnl_thread.hpp"
 #include "math_utils.hpp"
 
+#include "../simple_q10n.hpp"
 #include "jit_uni_rnn_common_postgemm_dispatcher.hpp"
 
 namespace dnnl {
@@ -32,15 +33,19 @@ using namespace dnnl::impl::math;
 using namespace rnn_utils;
 #define AOC array_offset_calculator
 
-template <typename T1, typename T2, typename src_data_t,
-        typename scratch_data_t>
-void gru_fwd_part1_postgemm_template(T1 func1, T2 to_src, const float *scales,
-        const rnn_utils::rnn_conf_t &rnn,
+template <typename T1, typename T2, typename T3, typename T4,
+        typename src_data_t, typename scratch_data_t>
+void gru_fwd_part1_postgemm_template(T1 func1, T2 to_src, T3 to_float,
+        T4 src_to_float, const float *scales, const rnn_utils::rnn_conf_t &rnn,
         rnn_utils::cell_position_t cell_position, src_data_t *ws_gates_,
         scratch_data_t *scratch_gates_, src_data_t *states_t_l_,
         const src_data_t *states_tm1_l_, float *bias_) {
     ws_gates_aoc<src_data_t> ws_gates(rnn, ws_gates_);
     ws_gates_aoc<scratch_data_t> scratch_gates(rnn, scratch_gates_);
+    // the activated gates are passed to part 2 as floats, which for int8
+    // overwrites the s32 accumulators in place
+    ws_gates_aoc<float> scratch_gates_f(
+            rnn, reinterpret_cast<float *>(scratch_gates_));
     bias_aoc_t bias(rnn, bias_);
 
     // auto dst_iter_ld = rnn.dst_iter_ld(cell_position);
@@ -55,14 +60,16 @@ void gru_fwd_part1_postgemm_template(T1 func1, T2 to_src, const float *scales,
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            auto G0 // default func1 is sigmoid
-                    = func1(scales, scratch_gates(i, 0, j) + bias(0, j));
-            auto G1 // default func1 is sigmoid
-                    = func1(scales + 1, scratch_gates(i, 1, j) + bias(1, j));
+            float G0 = func1( // default func1 is sigmoid
+                    scales,
+                    to_float(scratch_gates(i, 0, j), 0, j) + bias(0, j));
+            float G1 = func1( // default func1 is sigmoid
+                    scales + 1,
+                    to_float(scratch_gates(i, 1, j), 1, j) + bias(1, j));
             /* TODO: Can be optimized for fwd_training by using ws_gates instead of scratch_gates in p2 */
-            scratch_gates(i, 0, j) = to_src(G0);
-            scratch_gates(i, 1, j) = to_src(G1);
-            auto t = to_src(states_tm1_l(i, j) * G1);
+            scratch_gates_f(i, 0, j) = G0;
+            scratch_gates_f(i, 1, j) = G1;
+            auto t = to_src(src_to_float(states_tm1_l(i, j)) * G1);
             states_t_l(i, j) = t;
 
             if (rnn.is_training) {
@@ -73,16 +80,18 @@ void gru_fwd_part1_postgemm_template(T1 func1, T2 to_src, const float *scales,
     });
 }
 
-template <typename T1, typename T2, typename src_data_t,
-        typename scratch_data_t>
-void gru_fwd_part2_postgemm_template(T1 func1, T2 to_src, const float *scales,
-        const rnn_utils::rnn_conf_t &rnn,
+template <typename T1, typename T2, typename T3, typename T4,
+        typename src_data_t, typename scratch_data_t>
+void gru_fwd_part2_postgemm_template(T1 func1, T2 to_src, T3 to_float,
+        T4 src_to_float, const float *scales, const rnn_utils::rnn_conf_t &rnn,
         rnn_utils::cell_position_t cell_position, src_data_t *ws_gates_,
         scratch_data_t *scratch_gates_, src_data_t *states_t_l_,
         src_data_t *states_t_l_copy_, const src_data_t *states_tm1_l_,
         float *bias_) {
     ws_gates_aoc<src_data_t> ws_gates(rnn, ws_gates_);
     ws_gates_aoc<scratch_data_t> scratch_gates(rnn, scratch_gates_);
+    ws_gates_aoc<float> scratch_gates_f(
+            rnn, reinterpret_cast<float *>(scratch_gates_));
     bias_aoc_t bias(rnn, bias_);
 
     auto dst_ld = rnn.dst_ld(cell_position);
@@ -97,11 +106,13 @@ void gru_fwd_part2_postgemm_template(T1 func1, T2 to_src, const float *scales,
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            auto G0 = scratch_gates(i, 0, j);
-            auto G2 // default func1 is tanh
-                    = func1(scales + 2, scratch_gates(i, 2, j) + bias(2, j));
+            float G0 = scratch_gates_f(i, 0, j);
+            float G2 = func1( // default func1 is tanh
+                    scales + 2,
+                    to_float(scratch_gates(i, 2, j), 2, j) + bias(2, j));
 
-            auto tmp = to_src(states_tm1_l(i, j) * G0 + (1.0f - G0) * G2);
+            auto tmp = to_src(src_to_float(states_tm1_l(i, j)) * G0
+                    + (1.0f - G0) * G2);
             states_t_l(i, j) = tmp;
             if (states_t_l_copy_ != nullptr) states_t_l_copy(i, j) = tmp;
 
@@ -118,15 +129,17 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_part1_postgemm) {
         return logistic_fwd<float>(a);
     };
     auto to_src = [](float a) { return a; };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](float a) { return a; };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_fwd_part1_postgemm_template(logistic_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_tm1_l_, bias_);
+        gru_fwd_part1_postgemm_template(logistic_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_tm1_l_, bias_);
     else
-        gru_fwd_part1_postgemm_template(linear_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_tm1_l_, bias_);
+        gru_fwd_part1_postgemm_template(linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_tm1_l_, bias_);
 }
 
 template <>
@@ -136,15 +149,19 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_part2_postgemm) {
     auto tanh_f
             = [](const float *scale, float a) { return tanh_fwd<float>(a); };
     auto to_src = [](float a) { return a; };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](float a) { return a; };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_fwd_part2_postgemm_template(tanh_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_);
+        gru_fwd_part2_postgemm_template(tanh_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_);
     else
-        gru_fwd_part2_postgemm_template(linear_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_);
+        gru_fwd_part2_postgemm_template(linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_);
 }
 
 template <>
@@ -152,18 +169,20 @@ rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::gru_part1_postgemm) {
     const float *scales = pd_->attr()->rnn_tparams_.scales_;
     auto linear_f = [](const float *scale, float a) { return *scale * a; };
     auto to_src = [](float a) { return bfloat16_t(a); };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](bfloat16_t a) { return (float)a; };
     auto logistic_f = [](const float *scale, float a) {
         return logistic_fwd<float>(a);
     };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_fwd_part1_postgemm_template(logistic_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_tm1_l_, bias_);
+        gru_fwd_part1_postgemm_template(logistic_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_tm1_l_, bias_);
     else
-        gru_fwd_part1_postgemm_template(linear_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_tm1_l_, bias_);
+        gru_fwd_part1_postgemm_template(linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_tm1_l_, bias_);
 }
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::gru_part2_postgemm) {
@@ -172,25 +191,96 @@ rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::gru_part2_postgemm) {
     auto tanh_f
             = [](const float *scale, float a) { return tanh_fwd<float>(a); };
     auto to_src = [](float a) { return bfloat16_t(a); };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](bfloat16_t a) { return (float)a; };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_fwd_part2_postgemm_template(tanh_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_);
+        gru_fwd_part2_postgemm_template(tanh_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_);
     else
-        gru_fwd_part2_postgemm_template(linear_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_);
+        gru_fwd_part2_postgemm_template(linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_);
 }
 
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_part1_postgemm) {
-    assert(!"GRU int8 is not supported");
+    const float *scales = pd_->attr()->rnn_tparams_.scales_;
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto linear_f = [](const float *scale, float a) { return *scale * a; };
+    auto logistic_f = [](const float *scale, float a) {
+        return logistic_fwd<float>(a);
+    };
+    auto quantize_f32_u8 = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+    auto dequantize_s32_f32 = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0
+                ? saturate<float>(s) * (1.f / (weights_scales[0] * data_scale))
+                : saturate<float>(s)
+                        * (1.f
+                                / (weights_scales[gate * rnn.dic + j]
+                                        * data_scale));
+    };
+    auto dequantize_u8_f32 = [&](src_data_t s) {
+        return (static_cast<float>(s) - data_shift) * (1.f / data_scale);
+    };
+
+    if (!pd_->attr()->rnn_tparams_.test_mode_)
+        gru_fwd_part1_postgemm_template(logistic_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_tm1_l_, bias_);
+    else
+        gru_fwd_part1_postgemm_template(linear_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_tm1_l_, bias_);
 }
 
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_part2_postgemm) {
-    assert(!"GRU int8 is not supported");
+    const float *scales = pd_->attr()->rnn_tparams_.scales_;
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto linear_f = [](const float *scale, float a) { return *scale * a; };
+    auto tanh_f
+            = [](const float *scale, float a) { return tanh_fwd<float>(a); };
+    auto quantize_f32_u8 = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+    auto dequantize_s32_f32 = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0
+                ? saturate<float>(s) * (1.f / (weights_scales[0] * data_scale))
+                : saturate<float>(s)
+                        * (1.f
+                                / (weights_scales[gate * rnn.dic + j]
+                                        * data_scale));
+    };
+    auto dequantize_u8_f32 = [&](src_data_t s) {
+        return (static_cast<float>(s) - data_shift) * (1.f / data_scale);
+    };
+
+    if (!pd_->attr()->rnn_tparams_.test_mode_)
+        gru_fwd_part2_postgemm_template(tanh_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_t_l_copy_, states_tm1_l_, bias_);
+    else
+        gru_fwd_part2_postgemm_template(linear_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_t_l_copy_, states_tm1_l_, bias_);
 }
 
 template <typename T, typename src_data_t, typename acc_data_t,
@@ -21,6 +21,7 @@
 #include "dnnl_thread.hpp"
 #include "math_utils.hpp"
 
+#include "../simple_q10n.hpp"
 #include "jit_uni_rnn_common_postgemm_dispatcher.hpp"
 
 namespace dnnl {
@@ -32,10 +33,10 @@ using namespace dnnl::impl::math;
 using namespace rnn_utils;
 #define AOC array_offset_calculator
 
-template <typename T1, typename T2, typename T3, typename src_data_t,
-        typename scratch_data_t>
-void gru_lbr_fwd_postgemm_template(T1 func1, T2 func2, T3 to_src,
-        const float *scales, const rnn_utils::rnn_conf_t &rnn,
+template <typename T1, typename T2, typename T3, typename T4, typename T5,
+        typename src_data_t, typename scratch_data_t>
+void gru_lbr_fwd_postgemm_template(T1 func1, T2 func2, T3 to_src, T4 to_float,
+        T5 src_to_float, const float *scales, const rnn_utils::rnn_conf_t &rnn,
         rnn_utils::cell_position_t cell_position, src_data_t *ws_gates_,
         scratch_data_t *scratch_gates_, src_data_t *states_t_l_,
         src_data_t *states_t_l_copy_, const src_data_t *states_tm1_l_,
@@ -59,16 +60,20 @@ void gru_lbr_fwd_postgemm_template(T1 func1, T2 func2, T3 to_src,
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            float Wh_b = scratch_cell(i, 2, j) + bias(3, j);
-            auto G0 = func1(scales, // default func1 is sigmoid
-                    scratch_gates(i, 0, j) + scratch_cell(i, 0, j)
+            float Wh_b = to_float(scratch_cell(i, 2, j), 2, j) + bias(3, j);
+            float G0 = func1(scales, // default func1 is sigmoid
+                    to_float(scratch_gates(i, 0, j), 0, j)
+                            + to_float(scratch_cell(i, 0, j), 0, j)
                             + bias(0, j));
-            auto G1 = func1(scales + 1, // default func1 is sigmoid
-                    scratch_gates(i, 1, j) + scratch_cell(i, 1, j)
+            float G1 = func1(scales + 1, // default func1 is sigmoid
+                    to_float(scratch_gates(i, 1, j), 1, j)
+                            + to_float(scratch_cell(i, 1, j), 1, j)
                             + bias(1, j));
-            auto G2 = func2(scales + 2, // default func2 is tanh
-                    scratch_gates(i, 2, j) + G1 * Wh_b + bias(2, j));
-            auto tmp = to_src(states_tm1_l(i, j) * G0 + (1.0f - G0) * G2);
+            float G2 = func2(scales + 2, // default func2 is tanh
+                    to_float(scratch_gates(i, 2, j), 2, j) + G1 * Wh_b
+                            + bias(2, j));
+            auto tmp = to_src(src_to_float(states_tm1_l(i, j)) * G0
+                    + (1.0f - G0) * G2);
             states_t_l(i, j) = tmp;
             if (states_t_l_copy_ != nullptr) states_t_l_copy(i, j) = tmp;
             if (rnn.is_training) {
@@ -92,17 +97,19 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_lbr_postgemm) {
     auto tanh_f
             = [](const float *scale, float a) { return tanh_fwd<float>(a); };
     auto to_src = [](float a) { return a; };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](float a) { return a; };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_lbr_fwd_postgemm_template(logistic_f, tanh_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_, ws_grid_,
-                scratch_cell_);
+        gru_lbr_fwd_postgemm_template(logistic_f, tanh_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_, ws_grid_, scratch_cell_);
     else
-        gru_lbr_fwd_postgemm_template(linear_f, linear_f, to_src, scales, rnn,
-                cell_position, ws_gates_, scratch_gates_, states_t_l_,
-                states_t_l_copy_, states_tm1_l_, bias_, ws_grid_,
-                scratch_cell_);
+        gru_lbr_fwd_postgemm_template(linear_f, linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_, ws_grid_, scratch_cell_);
 }
 
 template <>
@@ -116,24 +123,64 @@ rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::gru_lbr_postgemm) {
     auto tanh_f
             = [](const float *scale, float a) { return tanh_fwd<float>(a); };
     auto to_src = [](float a) { return bfloat16_t(a); };
+    auto deq_id = [](float a, int i, int j) { return a; };
+    auto deq_id_src = [](bfloat16_t a) { return (float)a; };
 
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        gru_lbr_fwd_postgemm_template(logistic_f, tanh_f, to_src, scales, rnn,
+        gru_lbr_fwd_postgemm_template(logistic_f, tanh_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_, ws_grid_, scratch_cell_);
+    else
+        gru_lbr_fwd_postgemm_template(linear_f, linear_f, to_src, deq_id,
+                deq_id_src, scales, rnn, cell_position, ws_gates_,
+                scratch_gates_, states_t_l_, states_t_l_copy_, states_tm1_l_,
+                bias_, ws_grid_, scratch_cell_);
+}
+
+template <>
+rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_lbr_postgemm) {
+    const float *scales = pd_->attr()->rnn_tparams_.scales_;
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto linear_f = [](const float *scale, float a) { return *scale * a; };
+    auto logistic_f = [](const float *scale, float a) {
+        return logistic_fwd<float>(a);
+    };
+    auto tanh_f
+            = [](const float *scale, float a) { return tanh_fwd<float>(a); };
+    auto quantize_f32_u8 = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+    auto dequantize_s32_f32 = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0
+                ? saturate<float>(s) * (1.f / (weights_scales[0] * data_scale))
+                : saturate<float>(s)
+                        * (1.f
+                                / (weights_scales[gate * rnn.dic + j]
+                                        * data_scale));
+    };
+    auto dequantize_u8_f32 = [&](src_data_t s) {
+        return (static_cast<float>(s) - data_shift) * (1.f / data_scale);
+    };
+
+    if (!pd_->attr()->rnn_tparams_.test_mode_)
+        gru_lbr_fwd_postgemm_template(logistic_f, tanh_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
                 cell_position, ws_gates_, scratch_gates_, states_t_l_,
                 states_t_l_copy_, states_tm1_l_, bias_, ws_grid_,
                 scratch_cell_);
     else
-        gru_lbr_fwd_postgemm_template(linear_f, linear_f, to_src, scales, rnn,
+        gru_lbr_fwd_postgemm_template(linear_f, linear_f, quantize_f32_u8,
+                dequantize_s32_f32, dequantize_u8_f32, scales, rnn,
                 cell_position, ws_gates_, scratch_gates_, states_t_l_,
                 states_t_l_copy_, states_tm1_l_, bias_, ws_grid_,
                 scratch_cell_);
 }
 
-template <>
-rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_lbr_postgemm) {
-    assert(!"GRU LBR int8 is not supported");
-}
-
 template <typename T1, typename src_data_t, typename acc_data_t,
         typename scratch_data_t>
 void gru_lbr_bwd_postgemm_template(T1 to_src, const rnn_utils::rnn_conf_t &rnn,
@@ -41,10 +41,11 @@ void lstm_fwd_postgemm_template(T1 func1, T2 func2, T3 to_src_dt, T4 to_float,
         scratch_data_t *scratch_gates_, src_data_t *states_t_l_,
         src_data_t *states_t_l_copy_, float *c_states_t_l_,
         const src_data_t *states_tm1_l_, const float *c_states_tm1_l_,
-        float *bias_) {
+        float *bias_, const float *weights_peephole_) {
     ws_gates_aoc<src_data_t> ws_gates(rnn, ws_gates_);
     ws_gates_aoc<scratch_data_t> scratch_gates(rnn, scratch_gates_);
     bias_aoc_t bias(rnn, bias_);
+    weights_peephole_aoc_t weights_peephole(rnn, weights_peephole_);
 
     auto dst_iter_c_ld = rnn.dst_iter_c_ld(cell_position);
     auto src_iter_c_ld = rnn.src_iter_c_ld(cell_position);
@@ -61,20 +62,23 @@ void lstm_fwd_postgemm_template(T1 func1, T2 func2, T3 to_src_dt, T4 to_float,
 
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
-        for (int j = 0; j < rnn.dic; j++) {
-            float G0 = func1( // default func1 is sigmoid
-                    scales,
-                    to_float(scratch_gates(i, 0, j), 0, j) + bias(0, j));
-            float G1 = func1( // default func1 is sigmoid
-                    scales + 1,
-                    to_float(scratch_gates(i, 1, j), 1, j) + bias(1, j));
+        for (int j = 0; j < rnn.dhc; j++) {
+            float gate_i = to_float(scratch_gates(i, 0, j), 0, j) + bias(0, j);
+            float gate_f = to_float(scratch_gates(i, 1, j), 1, j) + bias(1, j);
+            if (rnn.is_lstm_peephole) {
+                gate_i += weights_peephole(0, j) * c_states_tm1_l(i, j);
+                gate_f += weights_peephole(1, j) * c_states_tm1_l(i, j);
+            }
+            float G0 = func1(scales, gate_i); // default func1 is sigmoid
+            float G1 = func1(scales + 1, gate_f); // default func1 is sigmoid
             float G2 = func2( // default func2 is tanh
                     scales + 2,
                     to_float(scratch_gates(i, 2, j), 2, j) + bias(2, j));
-            float G3 = func1( // default func1 is sigmoid
-                    scales + 3,
-                    to_float(scratch_gates(i, 3, j), 3, j) + bias(3, j));
             float tmp = G1 * c_states_tm1_l(i, j) + G0 * G2;
+            // the output gate peeks at the new cell state
+            float gate_o = to_float(scratch_gates(i, 3, j), 3, j) + bias(3, j);
+            if (rnn.is_lstm_peephole) gate_o += weights_peephole(2, j) * tmp;
+            float G3 = func1(scales + 3, gate_o); // default func1 is sigmoid
             states_t_l(i, j) = to_src_dt(G3 * func2(cscale, tmp));
             if (states_t_l_copy_ != nullptr)
                 states_t_l_copy(i, j) = states_t_l(i, j);
@@ -111,12 +115,12 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::lstm_postgemm) {
         lstm_fwd_postgemm_template(logistic_f, tanh_f, q_id, deq_id, scales,
                 cscale, rnn, cell_position, ws_gates_, scratch_gates_,
                 states_t_l_, states_t_l_copy_, c_states_t_l_, states_tm1_l_,
-                c_states_tm1_l_, bias_);
+                c_states_tm1_l_, bias_, weights_peephole_);
     else
         lstm_fwd_postgemm_template(linear_f, linear_f, q_id, deq_id, scales,
                 cscale, rnn, cell_position, ws_gates_, scratch_gates_,
                 states_t_l_, states_t_l_copy_, c_states_t_l_, states_tm1_l_,
-                c_states_tm1_l_, bias_);
+                c_states_tm1_l_, bias_, weights_peephole_);
 }
 
 template <>
@@ -137,12 +141,12 @@ rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::lstm_postgemm) {
         lstm_fwd_postgemm_template(logistic_f, tanh_f, round_f32_bf16, deq_id,
                 scales, cscale, rnn, cell_position, ws_gates_, scratch_gates_,
                 states_t_l_, states_t_l_copy_, c_states_t_l_, states_tm1_l_,
-                c_states_tm1_l_, bias_);
+                c_states_tm1_l_, bias_, weights_peephole_);
     else
         lstm_fwd_postgemm_template(linear_f, linear_f, round_f32_bf16, deq_id,
                 scales, cscale, rnn, cell_position, ws_gates_, scratch_gates_,
                 states_t_l_, states_t_l_copy_, c_states_t_l_, states_tm1_l_,
-                c_states_tm1_l_, bias_);
+                c_states_tm1_l_, bias_, weights_peephole_);
 }
 
 template <>
@@ -164,7 +168,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
                 ? saturate<float>(s) * (1.f / (weights_scales[0] * data_scale))
                 : saturate<float>(s)
                         * (1.f
-                                / (weights_scales[gate * rnn.dic + j]
+                                / (weights_scales[gate * rnn.dhc + j]
                                         * data_scale));
     };
 
@@ -179,12 +183,14 @@ rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
         lstm_fwd_postgemm_template(logistic_f, tanh_f, quantize_f32_u8,
                 dequantize_s32_f32, scales, cscale, rnn, cell_position,
                 ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                c_states_t_l_, states_tm1_l_, c_states_tm1_l_, bias_);
+                c_states_t_l_, states_tm1_l_, c_states_tm1_l_, bias_,
+                weights_peephole_);
     else
         lstm_fwd_postgemm_template(linear_f, linear_f, quantize_f32_u8,
                 dequantize_s32_f32, scales, cscale, rnn, cell_position,
                 ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                c_states_t_l_, states_tm1_l_, c_states_tm1_l_, bias_);
+                c_states_t_l_, states_tm1_l_, c_states_tm1_l_, bias_,
+                weights_peephole_);
 }
 
 template <typename T1, typename T2, typename src_data_t, typename acc_data_t,
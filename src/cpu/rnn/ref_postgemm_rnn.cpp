@@ -21,6 +21,7 @@
 #include "dnnl_thread.hpp"
 #include "math_utils.hpp"
 
+#include "../simple_q10n.hpp"
 #include "jit_uni_rnn_common_postgemm_dispatcher.hpp"
 
 namespace dnnl {
@@ -71,8 +72,10 @@ float linear(float s, float alpha, float clipping) {
     return alpha * s;
 }
 
-template <typename T, typename src_data_t, typename scratch_data_t>
-void rnn_fwd_postgemm_template(T func1, const float *scales, float alpha,
+template <typename T1, typename T2, typename T3, typename src_data_t,
+        typename scratch_data_t>
+void rnn_fwd_postgemm_template(T1 func1, T2 to_src_dt, T3 to_float,
+        const float *scales, float alpha,
         const rnn_utils::rnn_conf_t &rnn,
         rnn_utils::cell_position_t cell_position, src_data_t *ws_gates_,
         scratch_data_t *scratch_gates_, src_data_t *states_t_l_,
@@ -93,8 +96,9 @@ void rnn_fwd_postgemm_template(T func1, const float *scales, float alpha,
 
     parallel_nd(rnn.mb, [&](int i) {
         for (int j = 0; j < rnn.dic; j++) {
-            const float h
-                    = func1(scratch_gates(i, 0, j) + bias(0, j), alpha, 0);
+            const src_data_t h = to_src_dt(func1(
+                    to_float(scratch_gates(i, 0, j), 0, j) + bias(0, j), alpha,
+                    0));
             states_t_l(i, j) = h;
             if (states_t_l_copy_ != nullptr) states_t_l_copy(i, j) = h;
             if (rnn.is_training) ws_gates(i, 0, j) = h;
@@ -111,40 +115,76 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::rnn_postgemm) {
     auto linear_f = [](float a, float alpha, float clipping) {
         return linear(a, alpha, clipping);
     };
+    auto q_id = [&](float f) { return f; };
+    auto deq_id = [&](float f, int i, int j) { return f; };
     auto alpha = pd_->desc()->alpha;
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        rnn_fwd_postgemm_template(act_f, nullptr, alpha, rnn, cell_position,
-                ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                states_tm1_l_, bias_);
+        rnn_fwd_postgemm_template(act_f, q_id, deq_id, nullptr, alpha, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_t_l_copy_, states_tm1_l_, bias_);
     else
-        rnn_fwd_postgemm_template(linear_f, scales, alpha, rnn, cell_position,
-                ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                states_tm1_l_, bias_);
+        rnn_fwd_postgemm_template(linear_f, q_id, deq_id, scales, alpha, rnn,
+                cell_position, ws_gates_, scratch_gates_, states_t_l_,
+                states_t_l_copy_, states_tm1_l_, bias_);
 }
 
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_bf16_t::rnn_postgemm) {
     const float *scales = pd_->attr()->rnn_tparams_.scales_;
     auto act_f = [this](float a, float alpha, float clipping) {
-        return bfloat16_t(this->activation_func(a, alpha, clipping));
+        return this->activation_func(a, alpha, clipping);
     };
     auto linear_f = [](float a, float alpha, float clipping) {
-        return bfloat16_t(linear(a, alpha, clipping));
+        return linear(a, alpha, clipping);
     };
+    auto round_f32_bf16 = [&](float f) { return bfloat16_t(f); };
+    auto deq_id = [&](float f, int i, int j) { return f; };
     auto alpha = pd_->desc()->alpha;
     if (!pd_->attr()->rnn_tparams_.test_mode_)
-        rnn_fwd_postgemm_template(act_f, nullptr, alpha, rnn, cell_position,
-                ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                states_tm1_l_, bias_);
+        rnn_fwd_postgemm_template(act_f, round_f32_bf16, deq_id, nullptr,
+                alpha, rnn, cell_position, ws_gates_, scratch_gates_,
+                states_t_l_, states_t_l_copy_, states_tm1_l_, bias_);
     else
-        rnn_fwd_postgemm_template(linear_f, scales, alpha, rnn, cell_position,
-                ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
-                states_tm1_l_, bias_);
+        rnn_fwd_postgemm_template(linear_f, round_f32_bf16, deq_id, scales,
+                alpha, rnn, cell_position, ws_gates_, scratch_gates_,
+                states_t_l_, states_t_l_copy_, states_tm1_l_, bias_);
 }
 
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::rnn_postgemm) {
-    assert(!"VANILLA RNN int8 is not supported");
+    const float *scales = pd_->attr()->rnn_tparams_.scales_;
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto act_f = [this](float a, float alpha, float clipping) {
+        return this->activation_func(a, alpha, clipping);
+    };
+    auto linear_f = [](float a, float alpha, float clipping) {
+        return linear(a, alpha, clipping);
+    };
+    auto quantize_f32_u8 = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+    auto dequantize_s32_f32 = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0
+                ? saturate<float>(s) * (1.f / (weights_scales[0] * data_scale))
+                : saturate<float>(s)
+                        * (1.f
+                                / (weights_scales[gate * rnn.dic + j]
+                                        * data_scale));
+    };
+    auto alpha = pd_->desc()->alpha;
+    if (!pd_->attr()->rnn_tparams_.test_mode_)
+        rnn_fwd_postgemm_template(act_f, quantize_f32_u8, dequantize_s32_f32,
+                nullptr, alpha, rnn, cell_position, ws_gates_, scratch_gates_,
+                states_t_l_, states_t_l_copy_, states_tm1_l_, bias_);
+    else
+        rnn_fwd_postgemm_template(linear_f, quantize_f32_u8,
+                dequantize_s32_f32, scales, alpha, rnn, cell_position,
+                ws_gates_, scratch_gates_, states_t_l_, states_t_l_copy_,
+                states_tm1_l_, bias_);
 }
 
 template <typename T1, typename T2, typename src_data_t, typename acc_data_t,
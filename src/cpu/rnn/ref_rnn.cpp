@@ -32,6 +32,7 @@
 #include "dnnl_thread.hpp"
 #include "math_utils.hpp"
 
+#include "../cpu_barrier.hpp"
 #include "../gemm/gemm.hpp"
 #include "../simple_q10n.hpp"
 #include "gemm/gemm_pack.hpp"
@@ -146,6 +147,55 @@ rnn_gemm_sig(ref_rnn_fwd_u8s8_t::packed_gemm) {
     MAYBE_UNUSED(st);
 }
 
+//************* Grid computations strategy: wavefront **************//
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
+        data_type_t acc_type>
+template <typename cell_execution_t>
+void _ref_rnn_common_t<aprop, src_type, weights_type,
+        acc_type>::wavefront_execution(const rnn_conf_t &rnn,
+        scratch_data_t *scratch_gates_, scratch_data_t *scratch_cell_,
+        const cell_execution_t &cell_execution_at) const {
+    // The cell (lay, iter) reads the states the cells (lay - 1, iter) and
+    // (lay, iter - 1) put into ws_states, so all the cells of an
+    // anti-diagonal lay + iter = const are independent. The directions do
+    // not depend on each other at all and run on separate groups of threads.
+    const size_t scratch_gates_per_thr = (size_t)rnn.n_iter_scratch_gates
+            * rnn.gates_nld * rnn.gates_ws_ld;
+    const size_t scratch_cell_per_thr
+            = rnn.scratch_cell_size / rnn.wavefront_nthr / sizeof(acc_data_t);
+    const int n_diag = rnn.n_layer + rnn.n_iter - 1;
+
+    simple_barrier::ctx_t barrier_ctx[2];
+    for (int dir = 0; dir < rnn.n_dir; dir++)
+        simple_barrier::ctx_init(&barrier_ctx[dir]);
+
+    parallel(rnn.wavefront_nthr, [&](const int ithr, const int nthr) {
+        // with a single thread per group, one group runs both directions
+        const int n_grp = nstl::min(rnn.n_dir, nthr);
+        const int grp = ithr % n_grp;
+        const int grp_ithr = ithr / n_grp;
+        const int grp_nthr = (nthr - grp + n_grp - 1) / n_grp;
+
+        scratch_data_t *scratch_gates
+                = scratch_gates_ + ithr * scratch_gates_per_thr;
+        scratch_data_t *scratch_cell
+                = scratch_cell_ + ithr * scratch_cell_per_thr;
+
+        for (int dir = grp; dir < rnn.n_dir; dir += n_grp)
+            for (int diag = 0; diag < n_diag; diag++) {
+                const int lay_start = nstl::max(0, diag - rnn.n_iter + 1);
+                const int lay_end = nstl::min(rnn.n_layer, diag + 1);
+                for (int lay = lay_start + grp_ithr; lay < lay_end;
+                        lay += grp_nthr)
+                    cell_execution_at(
+                            dir, lay, diag - lay, scratch_gates, scratch_cell);
+
+                if (grp_nthr > 1)
+                    simple_barrier::barrier(&barrier_ctx[grp], grp_nthr);
+            }
+    });
+}
+
 //*************** Grid computations strategy: linear ***************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
         data_type_t acc_type>
@@ -182,6 +232,115 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
     auto dst_iter_mdw = memory_desc_wrapper(pd()->dst_md(1));
     auto src_iter_c_mdw = memory_desc_wrapper(pd()->src_md(2));
     auto dst_iter_c_mdw = memory_desc_wrapper(pd()->dst_md(2));
+    auto weights_peephole_mdw = memory_desc_wrapper(pd()->weights_md(3));
+    auto weights_projection_mdw = memory_desc_wrapper(pd()->weights_md(4));
+
+    // Executes the cell (lay, iter) of direction dir
+    auto cell_execution_at = [&](int dir, int lay, int iter,
+                                     scratch_data_t *scratch_gates,
+                                     scratch_data_t *scratch_cell) {
+        // With sequences of different lengths only the entries longer than
+        // iter are computed. They are the first ones since the entries are
+        // sorted by decreasing length. The cell is skipped if all the
+        // sequences ended before iter.
+        rnn_conf_t cell_rnn = rnn;
+        if (seq_lengths_) {
+            while (cell_rnn.mb > 0 && seq_lengths_[cell_rnn.mb - 1] <= iter)
+                cell_rnn.mb--;
+            if (cell_rnn.mb == 0) return;
+        }
+
+        // We set the FWD parameters to the cell execution call
+        src_data_t *states_t_l = &(ws_states(lay + 1, dir, iter + 1, 0));
+        // this is not null only if nocopy dst_layer and dst_iter and for the
+        // last cell
+        src_data_t *states_t_l_copy_ = nullptr;
+
+        const src_data_t *states_t_lm1 = &(ws_states(lay, dir, iter + 1, 0));
+        const src_data_t *states_tm1_l = &(ws_states(lay + 1, dir, iter, 0));
+        float *c_states_t_l = &(ws_c_states(lay + 1, dir, iter + 1, 0));
+        const float *c_states_tm1_l = &(ws_c_states(lay + 1, dir, iter, 0));
+
+        // the cell_position is used only when skip_data_copy is
+        // supported currently supported only for forward
+        cell_position_t cell_position = middle_cell;
+        if (iter == 0) cell_position |= first_iter;
+        if (lay == 0) cell_position |= first_layer;
+        if (iter == rnn.n_iter - 1) cell_position |= last_iter;
+        if (lay == rnn.n_layer - 1) cell_position |= last_layer;
+
+        // The dst_* paths should be before the src_* paths as
+        // the later will override states_tm1_l and
+        // states_l_tm1 appropriatly for 1st layer and 1st
+        // iter.
+        bool last_iter_skip_copy
+                = rnn.skip_dst_iter_copy() && (cell_position & last_iter);
+        if (last_iter_skip_copy) {
+            states_t_l = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
+            states_t_lm1 = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
+        }
+
+        if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
+            // Note: for last layer and last iter, the output is in dst_layer
+            // and still need to be copied to dst_iter
+            states_t_l = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
+            states_t_l_copy_ = last_iter_skip_copy
+                    ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
+                    : nullptr;
+            states_tm1_l = (iter != 0)
+                    ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
+                    : states_tm1_l;
+        }
+        if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
+            states_tm1_l = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
+
+        if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
+            states_t_lm1 = src_layer_ + src_layer_mdw.off(iter, 0, 0);
+
+        // because the c state is always f32 and require no
+        // conversion, we can always skip to copy for the 1st
+        // and last iteration
+        if (iter == 0 && src_iter_c_) {
+            c_states_tm1_l = src_iter_c_ + src_iter_c_mdw.off(lay, dir, 0, 0);
+            cell_position |= c_state_first_iter;
+        }
+        // with sequences of different lengths the last states are copied
+        // to the destination after the grid is computed
+        if (iter == rnn.n_iter - 1 && dst_iter_c_ && !rnn.with_seq_lengths) {
+            c_states_t_l = dst_iter_c_ + dst_iter_c_mdw.off(lay, dir, 0, 0);
+            cell_position |= c_state_last_iter;
+        }
+
+        const weights_data_t *w_projection = rnn.is_lstm_projection
+                ? weights_projection_
+                        + weights_projection_mdw.off(lay, dir, 0, 0)
+                : nullptr;
+        const float *w_peephole = rnn.is_lstm_peephole
+                ? weights_peephole_ + weights_peephole_mdw.off(lay, dir, 0, 0)
+                : nullptr;
+
+        (this->*cell_func)(cell_rnn, cell_position, states_t_l, c_states_t_l,
+                &(ws_diff_states(lay, dir, 0, iter, 0)),
+                &(weights_layer(lay, dir, 0)), &(weights_iter(lay, dir, 0)),
+                w_projection, w_peephole, &(bias(lay, dir, 0)), states_t_lm1,
+                states_tm1_l,
+                c_states_tm1_l, &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
+                &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
+                &(diff_weights_layer(lay, dir, 0)),
+                &(diff_weights_iter(lay, dir, 0)), &(diff_bias(lay, dir, 0)),
+                &(ws_gates(lay, dir, iter, 0)),
+                rnn.n_iter_scratch_gates == 1
+                        ? scratch_gates
+                        : scratch_gates
+                                + iter * rnn.gates_nld * rnn.gates_ws_ld,
+                &(ws_grid(lay, dir, iter, 0)), scratch_cell, states_t_l_copy_);
+    };
+
+    if (rnn.use_wavefront) {
+        wavefront_execution(
+                rnn, scratch_gates_, scratch_cell_, cell_execution_at);
+        return;
+    }
 
     // We run the grid of computation
     for (int dir = 0; dir < rnn.n_dir; dir++) {
@@ -204,7 +363,7 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
                     n_iter = rnn.n_iter;
                 }
 
-                (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dic,
+                (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dhc,
                         rnn.mb * n_iter, rnn.slc, 1.0,
                         weights_layer(lay, dir, 0), rnn.weights_layer_ld,
                         states_t_lm1, src_layer_ld, 0.0,
@@ -214,89 +373,8 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
             for (int i = 0; i < rnn.n_iter; i++) {
                 int iter = (aprop == prop_kind::forward) ? i
                                                          : rnn.n_iter - i - 1;
-
-                // We set the FWD parameters to the cell execution call
-                src_data_t *states_t_l
-                        = &(ws_states(lay + 1, dir, iter + 1, 0));
-                // this is not null only if nocopy dst_layer and dst_iter and for the last cell
-                src_data_t *states_t_l_copy_ = nullptr;
-
-                const src_data_t *states_t_lm1
-                        = &(ws_states(lay, dir, iter + 1, 0));
-                const src_data_t *states_tm1_l
-                        = &(ws_states(lay + 1, dir, iter, 0));
-                float *c_states_t_l = &(ws_c_states(lay + 1, dir, iter + 1, 0));
-                const float *c_states_tm1_l
-                        = &(ws_c_states(lay + 1, dir, iter, 0));
-
-                // the cell_position is used only when skip_data_copy is
-                // supported currently supported only for forward
-                cell_position_t cell_position = middle_cell;
-                if (iter == 0) cell_position |= first_iter;
-                if (lay == 0) cell_position |= first_layer;
-                if (iter == rnn.n_iter - 1) cell_position |= last_iter;
-                if (lay == rnn.n_layer - 1) cell_position |= last_layer;
-
-                // The dst_* paths should be before the src_* paths as
-                // the later will override states_tm1_l and
-                // states_l_tm1 appropriatly for 1st layer and 1st
-                // iter.
-                bool last_iter_skip_copy = rnn.skip_dst_iter_copy()
-                        && (cell_position & last_iter);
-                if (last_iter_skip_copy) {
-                    states_t_l = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
-                    states_t_lm1
-                            = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
-                }
-
-                if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
-                    // Note: for last layer and last iter, the output is in dst_layer
-                    // and still need to be copied to dst_iter
-                    states_t_l = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
-                    states_t_l_copy_ = last_iter_skip_copy
-                            ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
-                            : nullptr;
-                    states_tm1_l = (iter != 0)
-                            ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
-                            : states_tm1_l;
-                }
-                if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
-                    states_tm1_l = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
-
-                if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
-                    states_t_lm1 = src_layer_ + src_layer_mdw.off(iter, 0, 0);
-
-                // because the c state is always f32 and require no
-                // conversion, we can always skip to copy for the 1st
-                // and last iteration
-                if (iter == 0 && src_iter_c_) {
-                    c_states_tm1_l
-                            = src_iter_c_ + src_iter_c_mdw.off(lay, dir, 0, 0);
-                    cell_position |= c_state_first_iter;
-                }
-                if (iter == rnn.n_iter - 1 && dst_iter_c_) {
-                    c_states_t_l
-                            = dst_iter_c_ + dst_iter_c_mdw.off(lay, dir, 0, 0);
-                    cell_position |= c_state_last_iter;
-                }
-
-                (this->*cell_func)(rnn, cell_position, states_t_l, c_states_t_l,
-                        &(ws_diff_states(lay, dir, 0, iter, 0)),
-                        &(weights_layer(lay, dir, 0)),
-                        &(weights_iter(lay, dir, 0)), &(bias(lay, dir, 0)),
-                        states_t_lm1, states_tm1_l, c_states_tm1_l,
-                        &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
-                        &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
-                        &(diff_weights_layer(lay, dir, 0)),
-                        &(diff_weights_iter(lay, dir, 0)),
-                        &(diff_bias(lay, dir, 0)),
-                        &(ws_gates(lay, dir, iter, 0)),
-                        rnn.n_iter_scratch_gates == 1 ? scratch_gates_
-                                                      : scratch_gates_
-                                        + iter * rnn.gates_nld
-                                                * rnn.gates_ws_ld,
-                        &(ws_grid(lay, dir, iter, 0)), scratch_cell_,
-                        states_t_l_copy_);
+                cell_execution_at(
+                        dir, lay, iter, scratch_gates_, scratch_cell_);
             }
 
             if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
@@ -513,7 +591,7 @@ void copy_init_iter_fwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
                 rnn.n_layer, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
                     for (int j = 0; j < rnn.sic; j++)
                         ws_states(lay + 1, dir, 0, b, j) = (src_data_t)0;
-                    for (int j = 0; j < rnn.dic; j++)
+                    for (int j = 0; j < rnn.dhc; j++)
                         ws_c_states(lay + 1, dir, 1, b, j) = 0.0f;
                 });
     }
@@ -524,20 +602,23 @@ void copy_init_iter_bwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
         acc_data_t *ws_diff_states_, const acc_data_t *diff_dst_iter_,
         const memory_desc_wrapper diff_dst_iter_d,
         const float *diff_dst_iter_c_,
-        const memory_desc_wrapper diff_dst_iter_c_d) {
+        const memory_desc_wrapper diff_dst_iter_c_d,
+        const int32_t *seq_lengths_) {
     AOC<acc_data_t, 6> ws_diff_states(ws_diff_states_, rnn.n_layer + 1,
             rnn.n_dir, rnn.n_states + 1, rnn.n_iter + 1, rnn.mb,
             rnn.states_ws_ld);
     if (diff_dst_iter_) {
         parallel_nd(
                 rnn.n_layer, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
-                    array_copy(&(ws_diff_states(lay, dir, 0, rnn.n_iter, b, 0)),
+                    // the last iteration of a sequence consumes the diff of
+                    // the last states
+                    const int it = seq_lengths_ ? seq_lengths_[b] : rnn.n_iter;
+                    array_copy(&(ws_diff_states(lay, dir, 0, it, b, 0)),
                             diff_dst_iter_
                                     + diff_dst_iter_d.blk_off(lay, dir, b),
                             rnn.dic);
                     if (pd->cell_kind() == alg_kind::vanilla_lstm)
-                        array_copy(&(ws_diff_states(
-                                           lay, dir, 1, rnn.n_iter, b, 0)),
+                        array_copy(&(ws_diff_states(lay, dir, 1, it, b, 0)),
                                 diff_dst_iter_c_
                                         + diff_dst_iter_c_d.blk_off(
                                                 lay, dir, b),
@@ -562,7 +643,8 @@ void copy_init_iter_bwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
             const input_data_t *__restrict src_iter_, \
             const float *__restrict src_iter_c_, \
             const acc_data_t *__restrict diff_dst_iter_, \
-            const float *__restrict diff_dst_iter_c_) const { \
+            const float *__restrict diff_dst_iter_c_, \
+            const int32_t *__restrict seq_lengths_) const { \
         auto src_iter_d = memory_desc_wrapper(pd()->src_md(1)); \
         auto src_iter_c_d = memory_desc_wrapper(pd()->src_md(2)); \
         copy_init_iter_fwd_template(rnn, pd(), ws_states_, ws_c_states_, \
@@ -579,13 +661,13 @@ RNN_DECL_COPY_INIT_ITER_FWD(ref_rnn_fwd_u8s8_t)
     void cname::copy_init_iter(const rnn_conf_t &rnn, src_data_t *ws_states_, \
             float *ws_c_states_, acc_data_t *ws_diff_states_, \
             const input_data_t *src_iter_, const float *src_iter_c_, \
-            const acc_data_t *diff_dst_iter_, const float *diff_dst_iter_c_) \
-            const { \
+            const acc_data_t *diff_dst_iter_, const float *diff_dst_iter_c_, \
+            const int32_t *seq_lengths_) const { \
         auto diff_dst_iter_d = memory_desc_wrapper(pd()->diff_dst_md(1)); \
         auto diff_dst_iter_c_d = memory_desc_wrapper(pd()->diff_dst_md(2)); \
         copy_init_iter_bwd_template(rnn, pd(), ws_diff_states_, \
                 diff_dst_iter_, diff_dst_iter_d, diff_dst_iter_c_, \
-                diff_dst_iter_c_d); \
+                diff_dst_iter_c_d, seq_lengths_); \
     }
 
 RNN_DECL_COPY_INIT_ITER_BWD(ref_rnn_bwd_f32_t)
@@ -595,7 +677,7 @@ template <typename src_data_t, typename dst_layer_dt, typename dst_iter_dt>
 void copy_res_layer_fwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
         dst_layer_dt *dst_layer_, memory_desc_wrapper &dst_layer_d,
         const dst_iter_dt *dst_iter_, const memory_desc_wrapper &dst_iter_d,
-        const src_data_t *ws_states_) {
+        const src_data_t *ws_states_, const int32_t *seq_lengths_) {
 
     AOC<const src_data_t, 5> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
             rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
@@ -647,6 +729,14 @@ void copy_res_layer_fwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
     // in dst_iter, not in workspace
     parallel_nd(rnn.n_iter - (rnn.skip_dst_iter_copy() ? 1 : 0), rnn.mb,
             [&](int it, int b) {
+                // the iterations past the end of a sequence are not computed
+                // and their output is zero
+                if (seq_lengths_ && it >= seq_lengths_[b]) {
+                    auto *dd = &dst_layer_[dst_layer_d.blk_off(it, b, 0)];
+                    for (int s = 0; s < rnn.dlc; s++)
+                        dd[s] = (dst_layer_dt)0;
+                    return;
+                }
                 int dir = 0;
                 if (rnn.exec_dir != r2l) {
                     const auto *ss = &ws_states(rnn.n_layer, dir, it + 1, b, 0);
@@ -726,11 +816,12 @@ void copy_res_layer_bwd_template(const rnn_conf_t &rnn,
     void cname::copy_res_layer(const rnn_conf_t &rnn, \
             dst_layer_dt *dst_layer_, acc_data_t *diff_src_layer, \
             const dst_iter_dt *dst_iter_, const src_data_t *ws_states_, \
-            const acc_data_t *ws_diff_states_) const { \
+            const acc_data_t *ws_diff_states_, const int32_t *seq_lengths_) \
+            const { \
         auto dst_layer_d = memory_desc_wrapper(pd()->dst_md(0)); \
         auto dst_iter_d = memory_desc_wrapper(pd()->dst_md(1)); \
         copy_res_layer_fwd_template(rnn, pd(), dst_layer_, dst_layer_d, \
-                dst_iter_, dst_iter_d, ws_states_); \
+                dst_iter_, dst_iter_d, ws_states_, seq_lengths_); \
     }
 
 RNN_DECL_COPY_RES_LAYER_FWD(ref_rnn_fwd_f32_t)
@@ -743,7 +834,8 @@ RNN_DECL_COPY_RES_LAYER_FWD(ref_rnn_fwd_u8s8_t)
     void cname::copy_res_layer(const rnn_conf_t &rnn, \
             dst_layer_dt *dst_layer_, acc_data_t *diff_src_layer_, \
             const dst_iter_dt *dst_iter_, const src_data_t *ws_states_, \
-            const acc_data_t *ws_diff_states_) const { \
+            const acc_data_t *ws_diff_states_, const int32_t *seq_lengths_) \
+            const { \
         auto diff_src_layer_d = memory_desc_wrapper(pd()->diff_src_md(0)); \
         copy_res_layer_bwd_template( \
                 rnn, diff_src_layer_, diff_src_layer_d, ws_diff_states_); \
@@ -757,7 +849,8 @@ void copy_res_iter_fwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
         dst_iter_dt *dst_iter_, memory_desc_wrapper &dst_iter_d,
         float *dst_iter_c_, memory_desc_wrapper dst_iter_c_d,
         const dst_layer_dt *dst_layer_, memory_desc_wrapper dst_layer_d,
-        const src_data_t *ws_states_, const float *ws_c_states_) {
+        const src_data_t *ws_states_, const float *ws_c_states_,
+        const int32_t *seq_lengths_) {
     if (dst_iter_ == nullptr) return;
 
     AOC<const src_data_t, 5> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
@@ -787,9 +880,17 @@ void copy_res_iter_fwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
     auto n_layer_in_ws = rnn.n_layer - rnn.skip_dst_layer_copy();
 
     parallel_nd(n_layer_in_ws, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
-        const auto *ss = &ws_states(lay + 1, dir, rnn.n_iter, b, 0);
+        const int it = seq_lengths_ ? seq_lengths_[b] : rnn.n_iter;
+        const auto *ss = &ws_states(lay + 1, dir, it, b, 0);
         auto *dd = dst_iter_ + dst_iter_d.blk_off(lay, dir, b, 0);
         copy_vec(dd, ss);
+        // otherwise the cells of the last iteration write the cell states
+        // to dst_iter_c
+        if (seq_lengths_ && dst_iter_c_) {
+            const float *cs = &ws_c_states(lay + 1, dir, it, b, 0);
+            float *cd = dst_iter_c_ + dst_iter_c_d.blk_off(lay, dir, b, 0);
+            array_copy(cd, cs, rnn.dhc);
+        }
     });
 
     if (rnn.skip_dst_layer_copy()) {
@@ -835,13 +936,14 @@ void copy_res_iter_bwd_template(const rnn_conf_t &rnn, const rnn_pd_t *pd,
             float *dst_iter_c_, acc_data_t *diff_src_iter_, \
             float *diff_src_iter_c_, const dst_layer_dt *dst_layer_, \
             const src_data_t *ws_states_, const float *ws_c_states_, \
-            const acc_data_t *ws_diff_states_) const { \
+            const acc_data_t *ws_diff_states_, const int32_t *seq_lengths_) \
+            const { \
         auto dst_layer_d = memory_desc_wrapper(pd()->dst_md(0)); \
         auto dst_iter_d = memory_desc_wrapper(pd()->dst_md(1)); \
         auto dst_iter_c_d = memory_desc_wrapper(pd()->dst_md(2)); \
         copy_res_iter_fwd_template(rnn, pd(), dst_iter_, dst_iter_d, \
                 dst_iter_c_, dst_iter_c_d, dst_layer_, dst_layer_d, \
-                ws_states_, ws_c_states_); \
+                ws_states_, ws_c_states_, seq_lengths_); \
     }
 
 RNN_DECL_COPY_RES_ITER_FWD(ref_rnn_fwd_f32_t)
@@ -855,7 +957,8 @@ RNN_DECL_COPY_RES_ITER_FWD(ref_rnn_fwd_u8s8_t)
             float *dst_iter_c_, acc_data_t *diff_src_iter_, \
             float *diff_src_iter_c_, const dst_data_t *dst_layer_, \
             const src_data_t *ws_states_, const float *ws_c_states_, \
-            const acc_data_t *ws_diff_states_) const { \
+            const acc_data_t *ws_diff_states_, const int32_t *seq_lengths_) \
+            const { \
         auto diff_src_iter_d = memory_desc_wrapper(pd()->diff_src_md(1)); \
         auto diff_src_iter_c_d = memory_desc_wrapper(pd()->diff_src_md(2)); \
         copy_res_iter_bwd_template(rnn, pd(), diff_src_iter_, diff_src_iter_d, \
@@ -870,17 +973,17 @@ template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
 rnn_bias_prepare_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
         acc_type>::bias_prepare)) {
     /* Original set of bias provided by the user */
-    AOC<const float, 5> b(b_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dic);
+    AOC<const float, 5> b(b_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dhc);
     /* Array of pointers initialized in packing */
     AOC<float *, 3> bias(bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
     AOC<float, 3> scratch_bias(
-            scratch_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dic);
+            scratch_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dhc);
 
     if (rnn.copy_bias) {
         parallel_nd(rnn.n_layer * rnn.n_dir, [&](size_t i) {
-            int off = i * rnn.n_bias * rnn.dic;
+            int off = i * rnn.n_bias * rnn.dhc;
             PRAGMA_OMP_SIMD()
-            for (int j = 0; j < rnn.n_bias * rnn.dic; j++)
+            for (int j = 0; j < rnn.n_bias * rnn.dhc; j++)
                 scratch_bias_[off + j] = b_[off + j];
         });
     }
@@ -892,7 +995,7 @@ rnn_bias_prepare_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
                 bias(i, d, p) = rnn.copy_bias
                         ? (float *)&scratch_bias(i, d, offset_bias)
                         : (float *)&b(i, d, offset_bias);
-                offset_bias += rnn.parts_bias[p] * rnn.dic;
+                offset_bias += rnn.parts_bias[p] * rnn.dhc;
             }
         }
     }
@@ -907,13 +1010,23 @@ rnn_bias_finalize_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
         float data_scale = pd()->attr()->rnn_data_qparams_.scale_;
         float *weights_scales = pd()->attr()->rnn_weights_qparams_.scales_;
         bool scale_per_oc = pd()->attr()->rnn_weights_qparams_.mask_ != 0;
+        // The compensations are computed per gate while LBR GRU keeps the
+        // bias of the iteration part of its last gate separately
         for (int i = 0; i < rnn.n_layer * rnn.n_dir; i++)
-            for (int j = 0; j < rnn.n_bias * rnn.dic; j++) {
-                size_t off = i * rnn.n_bias * rnn.dic + j;
+            for (int j = 0; j < rnn.n_gates * rnn.dhc; j++) {
+                size_t comp_off = i * rnn.n_gates * rnn.dhc + j;
+                size_t bias_off = i * rnn.n_bias * rnn.dhc + j;
                 float weights_scale
                         = scale_per_oc ? weights_scales[j] : weights_scales[0];
-                scratch_bias_[off] -= (w_iter_comp[off] + w_layer_comp[off])
-                        * data_shift / (weights_scale * data_scale);
+                float factor = data_shift / (weights_scale * data_scale);
+                if (rnn.is_lbr && j >= 2 * rnn.dhc) {
+                    scratch_bias_[bias_off] -= w_layer_comp[comp_off] * factor;
+                    scratch_bias_[bias_off + rnn.dhc]
+                            -= w_iter_comp[comp_off] * factor;
+                } else
+                    scratch_bias_[bias_off]
+                            -= (w_iter_comp[comp_off] + w_layer_comp[comp_off])
+                            * factor;
             }
     }
 }
@@ -963,15 +1076,32 @@ rnn_weights_assign_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
 //********************* Execution function *********************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
         data_type_t acc_type>
-void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
+status_t _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
         const exec_ctx_t &ctx) const {
     const rnn_conf_t &rnn = this->pd()->rnn_;
     auto input = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC_LAYER);
     auto states = CTX_IN_MEM(const char *, DNNL_ARG_SRC_ITER);
     auto c_states = CTX_IN_MEM(const float *, DNNL_ARG_SRC_ITER_C);
+    auto seq_lengths = rnn.with_seq_lengths
+            ? CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_SEQ_LENGTHS)
+            : nullptr;
+
+    // the batch entries are expected to be sorted by decreasing length
+    if (rnn.with_seq_lengths) {
+        if (seq_lengths == nullptr) return status::invalid_arguments;
+        int32_t prev_len = rnn.n_iter;
+        for (int b = 0; b < rnn.mb; b++) {
+            if (seq_lengths[b] < 1 || seq_lengths[b] > prev_len)
+                return status::invalid_arguments;
+            prev_len = seq_lengths[b];
+        }
+    }
     auto layer_weights_n_comp
             = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS_LAYER);
     auto iter_weights_n_comp = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS_ITER);
+    auto w_projection = CTX_IN_MEM(
+            const weights_data_t *, DNNL_ARG_WEIGHTS_PROJECTION);
+    auto w_peephole = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS_PEEPHOLE);
     auto bias = CTX_IN_MEM(const float *, DNNL_ARG_BIAS);
 
     auto dst_last_layer = rnn.is_fwd
@@ -1057,12 +1187,12 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
     (this->*bias_preparation_func)(rnn, ptr_bias, bias, ws_bias);
 
     (this->*weights_iter_assign_func)(rnn, pd()->weights_md(1),
-            rnn.weights_iter_nld, rnn.weights_iter_ld, rnn.dic, rnn.sic,
+            rnn.weights_iter_nld, rnn.weights_iter_ld, rnn.dhc, rnn.sic,
             rnn.n_parts_weights_iter, rnn.parts_weights_iter,
             rnn.part_weights_iter_pack_size, ptr_wei_iter, w_iter, ptr_bias,
             bias, ws_bias);
     (this->*weights_layer_assign_func)(rnn, pd()->weights_md(0),
-            rnn.weights_layer_nld, rnn.weights_layer_ld, rnn.dic, rnn.slc,
+            rnn.weights_layer_nld, rnn.weights_layer_ld, rnn.dhc, rnn.slc,
             rnn.n_parts_weights_layer, rnn.parts_weights_layer,
             rnn.part_weights_layer_pack_size, ptr_wei_layer, w_layer, ptr_bias,
             bias, ws_bias);
@@ -1077,41 +1207,44 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
         if (pd()->src_md(1)->data_type == data_type::f32)
             copy_init_iter(rnn, ws_states, ws_c_states, ws_diff_states,
                     (const float *)states, c_states, diff_dst_iter,
-                    diff_dst_iter_c);
+                    diff_dst_iter_c, seq_lengths);
         else
             copy_init_iter(rnn, ws_states, ws_c_states, ws_diff_states,
                     (const src_data_t *)states, c_states, diff_dst_iter,
-                    diff_dst_iter_c);
+                    diff_dst_iter_c, seq_lengths);
     }
 
     // run the execution on the grid
-    (this->*grid_computation)(rnn, ptr_wei_layer, ptr_wei_iter, ptr_bias, input,
-            (const src_data_t *)states, c_states, (src_data_t *)dst_last_layer,
-            (src_data_t *)dst_last_iter, dst_last_iter_c, ws_states,
-            ws_c_states, ws_diff_states, ws_gates, ws_grid, scratch_gates,
-            scratch_cell, diff_weights_layer, diff_weights_iter, diff_bias);
+    (this->*grid_computation)(rnn, ptr_wei_layer, ptr_wei_iter, w_projection,
+            w_peephole, ptr_bias, input, (const src_data_t *)states, c_states,
+            seq_lengths,
+            (src_data_t *)dst_last_layer, (src_data_t *)dst_last_iter,
+            dst_last_iter_c, ws_states, ws_c_states, ws_diff_states, ws_gates,
+            ws_grid, scratch_gates, scratch_cell, diff_weights_layer,
+            diff_weights_iter, diff_bias);
 
     // Finally we copy the results to the result buffers
     if (!(rnn.skip_dst_layer_copy() && rnn.is_fwd)) {
         if (pd()->dst_md(0)->data_type == data_type::f32)
             copy_res_layer(rnn, (float *)dst_last_layer, diff_src_layer,
-                    dst_last_iter, ws_states, ws_diff_states);
+                    dst_last_iter, ws_states, ws_diff_states, seq_lengths);
         else
             copy_res_layer(rnn, (src_data_t *)dst_last_layer, diff_src_layer,
-                    dst_last_iter, ws_states, ws_diff_states);
+                    dst_last_iter, ws_states, ws_diff_states, seq_lengths);
     }
 
     if (!(rnn.skip_dst_iter_copy() && rnn.is_fwd)) {
         if (pd()->dst_md(1)->data_type == data_type::f32)
             copy_res_iter(rnn, (float *)dst_last_iter, dst_last_iter_c,
                     diff_src_iter, diff_src_iter_c, dst_last_layer, ws_states,
-                    ws_c_states, ws_diff_states);
+                    ws_c_states, ws_diff_states, seq_lengths);
         else
             copy_res_iter(rnn, (src_data_t *)dst_last_iter, dst_last_iter_c,
                     diff_src_iter, diff_src_iter_c, dst_last_layer, ws_states,
-                    ws_c_states, ws_diff_states);
+                    ws_c_states, ws_diff_states, seq_lengths);
     }
-};
+    return status::success;
+}
 
 /* Fix for MSVS warning C4661 */
 template <>
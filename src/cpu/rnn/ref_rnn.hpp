@@ -65,7 +65,11 @@ struct _ref_rnn_common_t : public primitive_impl_t {
     typedef typename prec_traits<weights_type>::type weights_data_t;
     typedef typename prec_traits<acc_type>::type acc_data_t;
 
-    typedef typename utils::conditional<aprop == prop_kind::forward, acc_data_t,
+    // The C enumerator is used on purpose: prop_kind::forward has internal
+    // linkage, and gcc then gives internal linkage to every member whose
+    // signature depends on scratch_data_t, so the explicit instantiations of
+    // the cell execution functions would not be visible from ref_rnn.cpp
+    typedef typename utils::conditional<aprop == dnnl_forward, acc_data_t,
             src_data_t>::type scratch_data_t;
 
     using class_name
@@ -101,6 +105,9 @@ struct _ref_rnn_common_t : public primitive_impl_t {
             data_type_t weights_layer_dt
                     = this->desc()->weights_layer_desc.data_type;
 
+            // There is no quantization scheme for the projection output,
+            // and the int8 peephole is not validated, so both are
+            // supported for f32 and bf16 only
             bool ok = true
                     && one_of(cell_kind, alg_kind::vanilla_rnn,
                             alg_kind::vanilla_lstm, alg_kind::vanilla_gru,
@@ -114,7 +121,16 @@ struct _ref_rnn_common_t : public primitive_impl_t {
                     && everyone_is(
                             weights_type, weights_iter_dt, weights_layer_dt)
                     && this->set_default_params() == status::success
-                    && this->with_bias();
+                    && this->with_bias()
+                    && IMPLICATION(this->with_seq_lengths(),
+                            this->direction()
+                                    == dnnl_unidirectional_left2right)
+                    && IMPLICATION(
+                            this->with_peephole() || this->with_projection(),
+                            aprop == prop_kind::forward)
+                    && IMPLICATION(this->with_peephole()
+                                    || this->with_projection(),
+                            src_type != data_type::u8);
             if (!ok) return status::unimplemented;
 
             ok = init_conf(rnn_, *this->desc(), this->src_md(0),
@@ -157,8 +173,8 @@ struct _ref_rnn_common_t : public primitive_impl_t {
             CHECK(this->check_layout_consistency());
 
             set_conf(rnn_, *this->desc(), this->weights_md(0),
-                    this->weights_md(1), this->diff_weights_md(0),
-                    this->diff_weights_md(1));
+                    this->weights_md(1), this->weights_md(4),
+                    this->diff_weights_md(0), this->diff_weights_md(1));
 
             size_t scratchpad_sz {0}, ws_sz {0};
             get_scratchpad_and_workspace_sizes(rnn_, scratchpad_sz, ws_sz);
@@ -253,13 +269,16 @@ struct _ref_rnn_common_t : public primitive_impl_t {
     // typedef typename prec_traits::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-        execute_(ctx);
-        return status::success;
+        return execute_(ctx);
     }
 
 private:
-    void execute_(const exec_ctx_t &ctx) const;
+    status_t execute_(const exec_ctx_t &ctx) const;
     rnn_grid_execution_sig(linear_execution);
+    template <typename cell_execution_t>
+    void wavefront_execution(const rnn_utils::rnn_conf_t &rnn,
+            scratch_data_t *scratch_gates_, scratch_data_t *scratch_cell_,
+            const cell_execution_t &cell_execution_at) const;
     rnn_cell_execution_sig(cell_execution);
     rnn_cell_execution_sig(cell_execution_gru);
     rnn_cell_execution_sig(cell_execution_gru_lbr);
@@ -281,20 +300,22 @@ private:
             src_data_t *ws_states_, float *ws_c_states_,
             acc_data_t *ws_diff_states_, const input_data_t *firstit_states_,
             const float *firstit_c_states_, const acc_data_t *diff_dst_iter_,
-            const float *diff_dst_iter_c_) const;
+            const float *diff_dst_iter_c_, const int32_t *seq_lengths_) const;
 
     template <typename dst_layer_dt, typename dst_iter_dt>
     void copy_res_layer(const rnn_utils::rnn_conf_t &rnn,
             dst_layer_dt *dst_layer_, acc_data_t *diff_src_layer_,
             const dst_iter_dt *dst_iter_, const src_data_t *ws_states_,
-            const acc_data_t *ws_diff_states_) const;
+            const acc_data_t *ws_diff_states_,
+            const int32_t *seq_lengths_) const;
 
     template <typename output_data_t, typename dst_data_t>
     void copy_res_iter(const rnn_utils::rnn_conf_t &rnn,
             output_data_t *dst_iter_, float *dst_iter_c_,
             acc_data_t *diff_src_iter_, float *diff_src_iter_c_,
             const dst_data_t *dst_layer_, const src_data_t *ws_states_,
-            const float *ws_c_states, const acc_data_t *ws_diff_states_) const;
+            const float *ws_c_states, const acc_data_t *ws_diff_states_,
+            const int32_t *seq_lengths_) const;
 
     const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
 
@@ -114,7 +114,6 @@ struct rnn_weights_reorder_s8_t : public primitive_impl_t {
                     && od.data_type() == data_type::s8
                     && od.format_kind() == format_kind::rnn_packed
                     && od.rnn_packed_desc().format == dnnl_ldigo_p
-                    && od.rnn_packed_desc().n_parts == 1
                     && attr->has_default_values(
                             primitive_attr_t::skip_mask_t::rnn_data_qparams
                             | primitive_attr_t::skip_mask_t::
@@ -70,6 +70,9 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.is_training = utils::one_of(
             rd.prop_kind, prop_kind::forward_training, prop_kind::backward);
     rnn.is_lbr = rd.cell_kind == dnnl_lbr_gru;
+    rnn.is_lstm_peephole = !types::is_zero_md(&rd.weights_peephole_desc);
+    rnn.is_lstm_projection = !types::is_zero_md(&rd.weights_projection_desc);
+    rnn.with_seq_lengths = rd.flags & dnnl_rnn_flags_variable_length;
 
     switch (rd.direction) {
         case dnnl_unidirectional_left2right: rnn.exec_dir = l2r; break;
@@ -108,11 +111,13 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.mb = src_layer_d.dims()[1];
     rnn.sic = weights_iter_d.dims()[2];
     rnn.slc = weights_layer_d.dims()[2];
-    rnn.dic = weights_layer_d.dims()[4];
+    rnn.dhc = weights_layer_d.dims()[4];
+    rnn.dic = rnn.is_lstm_projection ? rd.weights_projection_desc.dims[3]
+                                     : rnn.dhc;
     rnn.dlc = dst_layer_d.dims()[2];
 
     // set workspace (not)leading dimensions
-    rnn.gates_ld = rnn.dic * rnn.n_gates;
+    rnn.gates_ld = rnn.dhc * rnn.n_gates;
     rnn.gates_nld = rnn.mb;
     rnn.states_nld = rnn.mb;
 
@@ -120,7 +125,8 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     // Assumption: weights datatype size is the same as state datatype size
     int sizeof_states_dt = types::data_type_size(weights_layer_d.data_type());
     rnn.states_ws_ld = get_good_ld(
-            nstl::max(rnn.slc, nstl::max(rnn.sic, rnn.dic)), sizeof_states_dt);
+            nstl::max(nstl::max(rnn.slc, rnn.sic), nstl::max(rnn.dic, rnn.dhc)),
+            sizeof_states_dt);
     // Assumption: {src,dst}_layer has tnc layout, {src,dst}_iter has ldnc,
     rnn.src_layer_ld_ = src_layer_d.blocking_desc().strides[1];
     rnn.dst_layer_ld_ = dst_layer_d.blocking_desc().strides[1];
@@ -165,12 +171,32 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     auto dst_layer_is_trivial_stride = dst_layer_d.blocking_desc().strides[0]
             == (rnn.dst_layer_ld_ * rnn.mb);
 
-    rnn.merge_gemm_layer = ((rnn.is_fwd && src_layer_is_trivial_stride)
-                                   || ((rd.prop_kind == prop_kind::backward)
-                                           && dst_layer_is_trivial_stride))
-            && (((rnn.is_fwd && rnn.mb < 128) || !rnn.is_fwd) || rnn.is_int8());
-    rnn.merge_gemm_iter
-            = dst_layer_is_trivial_stride && !(rnn.is_fwd || is_gru);
+    // The cells of an anti-diagonal of the (layer, iteration) grid and the
+    // cells of the two directions are independent and can be computed by
+    // different threads. This only pays off when a single cell is too small
+    // to keep all the threads busy, which depends on the machine, so it is
+    // enabled with DNNL_RNN_WAVEFRONT=1. The variable is read at each
+    // creation, so it can be changed at run-time.
+    const bool want_wavefront = getenv_int("DNNL_RNN_WAVEFRONT", 0) > 0;
+    const int nthr = dnnl_get_max_threads();
+    const int max_parallel_cells
+            = rnn.n_dir * nstl::min(rnn.n_layer, rnn.n_iter);
+    rnn.use_wavefront = want_wavefront && rnn.is_fwd && dnnl_thr_syncable()
+            && nthr > 1 && max_parallel_cells > 1;
+    rnn.wavefront_nthr
+            = rnn.use_wavefront ? nstl::min(nthr, max_parallel_cells) : 1;
+
+    // The merged layer gemm computes all the iterations of a layer at once,
+    // which serializes the layers and computes the iterations past the end
+    // of the sequences
+    rnn.merge_gemm_layer = !rnn.use_wavefront && !rnn.with_seq_lengths
+            && ((rnn.is_fwd && src_layer_is_trivial_stride)
+                    || ((rd.prop_kind == prop_kind::backward)
+                            && dst_layer_is_trivial_stride))
+            && (((rnn.is_fwd && rnn.mb < 128) || !rnn.is_fwd)
+                    || rnn.is_int8());
+    rnn.merge_gemm_iter = dst_layer_is_trivial_stride
+            && !(rnn.is_fwd || is_gru || rnn.with_seq_lengths);
     rnn.force_nocopy = !mayiuse(avx512_mic) && mayiuse(avx)
             && ((is_inference && (rnn.n_layer > 1 || rnn.mb < 100))
                     || (rnn.is_training && rnn.dic < 500));
@@ -200,8 +226,8 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
         bool pack = true;
         weights_pack_size = 0;
         for (int p = 0; p < n_parts; p++) {
-            int m_p = rnn.is_fwd ? (parts[p] * rnn.dic) : feature_size;
-            int k_p = rnn.is_fwd ? feature_size : (parts[p] * rnn.dic);
+            int m_p = rnn.is_fwd ? (parts[p] * rnn.dhc) : feature_size;
+            int k_p = rnn.is_fwd ? feature_size : (parts[p] * rnn.dhc);
             int n_p = merge ? rnn.mb * rnn.n_iter : rnn.mb;
             bool pack_part = true;
 
@@ -266,6 +292,7 @@ bool rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
         const memory_desc_wrapper &weights_layer_d,
         const memory_desc_wrapper &weights_iter_d,
+        const memory_desc_wrapper &weights_projection_d,
         const memory_desc_wrapper &diff_weights_layer_d,
         const memory_desc_wrapper &diff_weights_iter_d) {
 
@@ -287,6 +314,11 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     };
     set_dims(weights_layer_d, rnn.weights_layer_ld, rnn.weights_layer_nld);
     set_dims(weights_iter_d, rnn.weights_iter_ld, rnn.weights_iter_nld);
+    // the projection weights are ldio
+    rnn.weights_projection_ld = rnn.is_lstm_projection
+            ? (int)weights_projection_d.blocking_desc().strides[2]
+            : 0;
+    rnn.weights_projection_nld = rnn.is_lstm_projection ? rnn.dhc : 0;
     if (!rnn.is_fwd) {
         set_dims(diff_weights_layer_d, rnn.diff_weights_layer_ld,
                 rnn.diff_weights_layer_nld);
@@ -329,22 +361,31 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                                         : (size_t)0;
     rnn.n_iter_scratch_gates
             = (rnn.merge_gemm_layer || rnn.merge_gemm_iter) ? rnn.n_iter : 1;
-    rnn.scratch_gates_size = rnn.n_iter_scratch_gates * rnn.gates_nld
-            * rnn.gates_ws_ld * sizeof_scratch_dt;
+    rnn.scratch_gates_size = (size_t)rnn.wavefront_nthr
+            * rnn.n_iter_scratch_gates * rnn.gates_nld * rnn.gates_ws_ld
+            * sizeof_scratch_dt;
 
     /* set other sizes */
-    /// scratchpad buffer for each cell to hold intermediate data in gru/lbr_gru
-    rnn.scratch_cell_size = rnn.is_lbr
-            ? (size_t)rnn.gates_nld * rnn.gates_ws_ld * sizeof_acc_dt
-            : (rd.cell_kind == alg_kind::vanilla_gru ? (size_t)rnn.states_nld
-                                    * rnn.states_ws_ld * sizeof_acc_dt
-                                                     : 0);
+    /// scratchpad buffer for each cell to hold intermediate data in
+    /// gru/lbr_gru, and the hidden states before and after the projection
+    /// in lstm with projection
+    size_t scratch_cell_per_thr = 0;
+    if (rnn.is_lbr)
+        scratch_cell_per_thr
+                = (size_t)rnn.gates_nld * rnn.gates_ws_ld * sizeof_acc_dt;
+    else if (rd.cell_kind == alg_kind::vanilla_gru)
+        scratch_cell_per_thr
+                = (size_t)rnn.states_nld * rnn.states_ws_ld * sizeof_acc_dt;
+    else if (rnn.is_lstm_projection)
+        scratch_cell_per_thr = (size_t)2 * rnn.states_nld * rnn.states_ws_ld
+                * sizeof_acc_dt;
+    rnn.scratch_cell_size = rnn.wavefront_nthr * scratch_cell_per_thr;
     /// workspace needed for lbr GRU
-    rnn.ws_per_cell = (size_t)rnn.is_lbr * rnn.mb * rnn.dic * sizeof_acc_dt;
+    rnn.ws_per_cell = (size_t)rnn.is_lbr * rnn.mb * rnn.dhc * sizeof_acc_dt;
     rnn.ws_grid_comp_size = (size_t)rnn.is_lbr * rnn.is_training * rnn.n_layer
             * rnn.n_dir * rnn.n_iter * rnn.ws_per_cell * sizeof(float);
     /// bias ws needed to add compensation in int8
-    rnn.ws_bias_size = (size_t)rnn.n_layer * rnn.n_dir * rnn.n_bias * rnn.dic
+    rnn.ws_bias_size = (size_t)rnn.n_layer * rnn.n_dir * rnn.n_bias * rnn.dhc
             * sizeof(float);
 }
 
@@ -28,7 +28,8 @@
             float *c_states_t_l_, const src_data_t *states_tm1_l_, \
             const float *c_states_tm1_l_, acc_data_t *diff_states_t_l_, \
             acc_data_t *diff_states_t_lp1_, acc_data_t *diff_states_tp1_l_, \
-            float *bias_, src_data_t *ws_grid_, scratch_data_t *scratch_cell_, \
+            float *bias_, const float *weights_peephole_, \
+            src_data_t *ws_grid_, scratch_data_t *scratch_cell_, \
             src_data_t *states_t_l_copy_) const
 
 #define rnn_cell_execution_sig(f) \
@@ -36,7 +37,9 @@
             rnn_utils::cell_position_t cell_position, src_data_t *states_t_l_, \
             float *c_states_t_l_, acc_data_t *diff_states_t_l_, \
             weights_data_t **w_layer_, weights_data_t **w_iter_, \
-            float **bias_, const src_data_t *states_t_lm1_, \
+            const weights_data_t *w_projection_, \
+            const float *weights_peephole_, float **bias_, \
+            const src_data_t *states_t_lm1_, \
             const src_data_t *states_tm1_l_, const float *c_states_tm1_l_, \
             acc_data_t *diff_states_t_lp1_, acc_data_t *diff_states_tp1_l_, \
             acc_data_t *diff_w_layer_, acc_data_t *diff_w_iter_, \
@@ -46,11 +49,14 @@
 
 #define rnn_grid_execution_sig(f) \
     void f(const rnn_utils::rnn_conf_t &rnn, weights_data_t **weights_layer_, \
-            weights_data_t **weights_iter_, float **bias_, \
+            weights_data_t **weights_iter_, \
+            const weights_data_t *weights_projection_, \
+            const float *weights_peephole_, float **bias_, \
             const src_data_t *src_layer_, const src_data_t *src_iter_, \
-            const float *src_iter_c_, src_data_t *dst_layer_, \
-            src_data_t *dst_iter_, float *dst_iter_c_, src_data_t *ws_states_, \
-            float *ws_c_states_, acc_data_t *ws_diff_states_, \
+            const float *src_iter_c_, const int32_t *seq_lengths_, \
+            src_data_t *dst_layer_, src_data_t *dst_iter_, float *dst_iter_c_, \
+            src_data_t *ws_states_, float *ws_c_states_, \
+            acc_data_t *ws_diff_states_, \
             src_data_t *ws_gates_, src_data_t *ws_grid_, \
             scratch_data_t *scratch_gates_, scratch_data_t *scratch_cell_, \
             acc_data_t *diff_weights_layer_, acc_data_t *diff_weights_iter_, \
@@ -125,7 +131,10 @@ struct rnn_conf_t {
     data_type_conf_t dt_conf;
     int n_layer, n_iter, n_dir, n_gates, n_states;
     int mb;
-    int slc, sic, dic, dlc;
+    /* dhc is the number of channels of the gates and of the cell states.
+     * It differs from the number of channels of the hidden states dic only
+     * for LSTM with projection */
+    int slc, sic, dhc, dic, dlc;
     int gates_ld, gates_nld, gates_ws_ld;
     int n_parts_weights_layer, parts_weights_layer[DNNL_RNN_MAX_N_PARTS];
     int n_parts_weights_iter, parts_weights_iter[DNNL_RNN_MAX_N_PARTS];
@@ -141,10 +150,15 @@ struct rnn_conf_t {
     int diff_weights_layer_ld, diff_weights_layer_nld;
     int weights_iter_ld, weights_iter_nld;
     int diff_weights_iter_ld, diff_weights_iter_nld;
+    int weights_projection_ld, weights_projection_nld;
     int states_nld, states_ws_ld, src_layer_ld_, src_iter_ld_, src_iter_c_ld_,
             dst_layer_ld_, dst_iter_ld_, dst_iter_c_ld_;
     int weights_iter_compensation_size, weights_layer_compensation_size;
-    bool is_fwd, is_training, is_lbr;
+    bool is_fwd, is_training, is_lbr, is_lstm_peephole, is_lstm_projection;
+    /* The sequences have different lengths: the batch entries are sorted by
+     * decreasing length and iteration t only computes the entries that are
+     * longer than t */
+    bool with_seq_lengths;
     bool use_workspace;
 
     /* Size of workspace for each tensor in bytes */
@@ -154,6 +168,11 @@ struct rnn_conf_t {
     bool merge_gemm_iter, merge_gemm_layer, force_nocopy, use_layer_packed_gemm,
             use_iter_packed_gemm;
     int n_iter_scratch_gates;
+    /* Wavefront execution: the cells of an anti-diagonal of the
+     * (layer, iteration) grid run concurrently, each with its own copy of
+     * the scratch gates and the scratch cell */
+    bool use_wavefront;
+    int wavefront_nthr;
 
     inline bool is_int8() const {
         return utils::one_of(
@@ -172,12 +191,12 @@ struct rnn_conf_t {
                         dt_conf, u8u8u8u8, u8u8u8f32, all_f32, all_bf16);
     }
     inline bool skip_dst_layer_copy() const {
-        return (exec_dir == l2r)
+        return (exec_dir == l2r) && !with_seq_lengths
                 && utils::one_of(
                         dt_conf, u8u8u8u8, f32u8f32u8, all_f32, all_bf16);
     }
     inline bool skip_dst_iter_copy() const {
-        return (exec_dir == l2r) && (dst_iter_ld_ > 0)
+        return (exec_dir == l2r) && (dst_iter_ld_ > 0) && !with_seq_lengths
                 && utils::one_of(
                         dt_conf, u8u8u8u8, u8u8u8f32, all_f32, all_bf16);
     }
@@ -252,6 +271,7 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
         const memory_desc_wrapper &weights_layer_d,
         const memory_desc_wrapper &weights_iter_d,
+        const memory_desc_wrapper &weights_projection_d,
         const memory_desc_wrapper &diff_weights_layer_d,
         const memory_desc_wrapper &diff_weights_iter_d);
 
@@ -271,7 +291,7 @@ status_t set_good_strides(memory_desc_t &weights_md, format_tag_t tag);
 template <typename T>
 struct ws_gates_aoc {
     ws_gates_aoc(const rnn_conf_t &rnn, T *data)
-        : gates_(data, rnn.gates_nld, rnn.gates_ws_ld), DIC_(rnn.dic) {}
+        : gates_(data, rnn.gates_nld, rnn.gates_ws_ld), DIC_(rnn.dhc) {}
     T &operator()(int batch, int gate, int dic) {
         return gates_(batch, gate * DIC_ + dic);
     }
@@ -283,9 +303,21 @@ private:
 using ws_gates_aoc_t = ws_gates_aoc<float>;
 using ws_gates_aoc_s32_t = ws_gates_aoc<int32_t>;
 
+struct weights_peephole_aoc_t {
+    weights_peephole_aoc_t(const rnn_conf_t &rnn, const float *data)
+        : weights_peephole_(data, 3, rnn.dhc) {}
+    const float &operator()(int g, int dhc) {
+        return weights_peephole_(g, dhc);
+    }
+
+private:
+    dnnl::impl::utils::array_offset_calculator<const float, 2>
+            weights_peephole_;
+};
+
 struct bias_aoc_t {
     bias_aoc_t(const rnn_conf_t &rnn, const float *data)
-        : bias_(data, rnn.n_bias, rnn.dic) {}
+        : bias_(data, rnn.n_bias, rnn.dhc) {}
     const float &operator()(int bias_n, int dic) { return bias_(bias_n, dic); }
 
 private:
@@ -136,7 +136,9 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
         return simple_attr_check(attr, true, false)
                 && output_d.matches_tag(tag_o)
                 && (output_d.extra().flags
-                        & memory_extra_flags::compensation_conv_s8s8)
+                        & (memory_extra_flags::compensation_conv_s8s8
+                                | memory_extra_flags::
+                                        compensation_conv_asymmetric_src))
                 && (input_d.data_type() == f32 || input_d.data_type() == s8)
                 && output_d.data_type() == s8
                 && (D_mask == 1 || D_mask == (size_t)g * oc);
@@ -162,18 +164,24 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
         const size_t D_mask = utils::array_product(input_d.dims(),
                 math::ilog2q(pd->attr()->output_scales_.mask_ + 1));
 
-        assert(output_d.extra().flags
-                & memory_extra_flags::compensation_conv_s8s8);
+        const bool req_comp = output_d.extra().flags
+                & memory_extra_flags::compensation_conv_s8s8;
+        const bool req_asymmetric_comp = output_d.extra().flags
+                & memory_extra_flags::compensation_conv_asymmetric_src;
+        assert(req_comp || req_asymmetric_comp);
         float adj_scale
                 = (output_d.extra().flags & memory_extra_flags::scale_adjust)
                 ? output_d.extra().scale_adjust
                 : 1.f;
 
+        // the s8s8 compensation goes first, the source zero point
+        // compensation follows it
         size_t offset = G * pdims[w_groups + 0] * pdims[w_groups + 1] * H * W;
         int32_t *cp = reinterpret_cast<int32_t *>(output + offset);
+        int32_t *zp = cp + (req_comp ? G * OC : 0);
 
         parallel_nd(G, OC, [&](int g, int oc) {
-            cp[g * OC + oc] = 0;
+            int32_t wei_sum = 0;
             for_(int ic = 0; ic < IC; ic++)
             for_(int h = 0; h < H; h++)
             for (int w = 0; w < W; w++) {
@@ -182,9 +190,10 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
                 const float s = scales[(D_mask == 1) ? 0 : g * OC + oc];
 
                 o = qz_b0<data_t<type_i>, data_t<type_o>>()(i, s * adj_scale);
-                cp[g * OC + oc] -= (int32_t)o;
+                wei_sum += (int32_t)o;
             }
-            cp[g * OC + oc] *= 128;
+            if (req_comp) cp[g * OC + oc] = -128 * wei_sum;
+            if (req_asymmetric_comp) zp[g * OC + oc] = -wei_sum;
         });
         return status::success;
     }
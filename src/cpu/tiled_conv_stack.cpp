@@ -0,0 +1,468 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "convolution_pd.hpp"
+#include "dnnl_thread.hpp"
+#include "memory.hpp"
+#include "reorder_pd.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+#include "tiled_conv_stack.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+namespace {
+// The tiles are blocks of rows, so the batch and the height of the
+// activations the tiles are cut from must not be blocked
+bool is_row_addressable(const memory_desc_t &md) {
+    const memory_desc_wrapper d(md);
+    if (!d.is_blocking_desc()) return false;
+    const auto &blk = d.blocking_desc();
+    for (int i = 0; i < blk.inner_nblks; ++i)
+        if (one_of(blk.inner_idxs[i], 0, 2)) return false;
+    return true;
+}
+
+// A dense memory descriptor for `rows` rows of a single image that has the
+// same layout as the activation `md`
+memory_desc_t tile_md(const memory_desc_t &md, dim_t rows) {
+    memory_desc_t tmd = md;
+    tmd.dims[0] = 1;
+    tmd.dims[2] = rows;
+    const blocking_desc_t blk = md.format_desc.blocking;
+    memory_desc_init_by_blocking_desc(tmd, blk);
+    return tmd;
+}
+
+// A view of `rows` rows of a single image of the activation `md` that keeps
+// the strides of the activation. The view starts at the beginning of the
+// rows, so the offset of the rows is applied to the data handle.
+memory_desc_t row_view_md(const memory_desc_t &md, dim_t rows) {
+    memory_desc_t vmd = md;
+    vmd.dims[0] = vmd.padded_dims[0] = 1;
+    vmd.dims[2] = vmd.padded_dims[2] = rows;
+    vmd.offset0 = 0;
+    return vmd;
+}
+
+// Returns true if the nested primitives can use the view as the dense tile,
+// i.e. if their strides match for all the dimensions with several blocks
+bool is_dense_view(const memory_desc_t &view, const memory_desc_t &dense) {
+    dims_t blocks;
+    memory_desc_wrapper(view).compute_blocks(blocks);
+    const auto &v_strides = view.format_desc.blocking.strides;
+    const auto &d_strides = dense.format_desc.blocking.strides;
+    for (int d = 0; d < view.ndims; ++d) {
+        if (view.padded_dims[d] / blocks[d] == 1) continue;
+        if (v_strides[d] != d_strides[d]) return false;
+    }
+    return true;
+}
+
+status_t create_conv_pd(primitive_desc_t **pd, engine_t *engine,
+        const convolution_desc_t &cd, const primitive_attr_t &attr) {
+    dnnl_primitive_desc_iterator it(
+            engine, (const op_desc_t *)&cd, &attr, nullptr);
+    if (++it == it.end()) return unimplemented;
+    *pd = *it;
+    return *pd ? success : out_of_memory;
+}
+
+dim_t ker_range_h(const convolution_desc_t &cd) {
+    const bool with_groups
+            = cd.weights_desc.ndims == cd.src_desc.ndims + 1;
+    const dim_t KH = cd.weights_desc.dims[with_groups + 2];
+    return (KH - 1) * (cd.dilates[0] + 1) + 1;
+}
+} // namespace
+
+status_t tiled_conv_stack_t::pd_t::init() {
+    using namespace data_type;
+
+    // 2D forward inference f32 convolutions with at most an eltwise post-op
+    bool ok = attr()->has_default_values() && src_md_.ndims == 4;
+    for (int l = 0; l < n_layers() && ok; ++l) {
+        const convolution_desc_t &cd = *layer_desc(l);
+        ok = one_of(cd.alg_kind, alg_kind::convolution_direct,
+                     alg_kind::convolution_auto)
+                && everyone_is(f32, cd.src_desc.data_type,
+                        cd.weights_desc.data_type, cd.dst_desc.data_type)
+                && IMPLICATION(with_bias(l), cd.bias_desc.data_type == f32);
+    }
+    if (!ok) return unimplemented;
+
+    std::vector<memory_desc_t> act_mds;
+    CHECK(init_layers(act_mds));
+    CHECK(init_tiles(act_mds));
+    init_scratchpad();
+
+    return success;
+}
+
+// Chooses the formats of the activations and weights the way the layers
+// would choose them if they were computed one by one. act_mds[l] is the
+// source of the layer l and act_mds[n_layers()] is the destination of the
+// stack.
+status_t tiled_conv_stack_t::pd_t::init_layers(
+        std::vector<memory_desc_t> &act_mds) {
+    const int L = n_layers();
+    act_mds.resize(L + 1);
+    act_mds[0] = src_md_;
+    for (int l = 0; l < L; ++l) {
+        convolution_desc_t cd = *layer_desc(l);
+        cd.src_desc = act_mds[l];
+
+        primitive_desc_t *cpd = nullptr;
+        CHECK(create_conv_pd(&cpd, engine_, cd, *layer_attr(l)));
+        act_mds[l] = *cpd->src_md(0);
+        act_mds[l + 1] = *cpd->dst_md(0);
+        weights_mds_[l] = *cpd->weights_md(0);
+        bias_mds_[l] = *cpd->weights_md(1);
+        delete cpd;
+
+        if (!is_row_addressable(act_mds[l])) return unimplemented;
+    }
+    if (!is_row_addressable(act_mds[L])) return unimplemented;
+
+    src_md_ = act_mds[0];
+    dst_md_ = act_mds[L];
+
+    return success;
+}
+
+// Returns the size of the largest pair of source and destination tiles of a
+// layer for a tile of `h` rows of the destination of the stack
+dim_t tiled_conv_stack_t::pd_t::tile_working_set(
+        const std::vector<memory_desc_t> &act_mds, dim_t h) const {
+    dim_t working_set = 0;
+    dim_t out_rows = h;
+    for (int l = n_layers() - 1; l >= 0; --l) {
+        const convolution_desc_t &cd = *layer_desc(l);
+        const dim_t in_rows = nstl::min(cd.src_desc.dims[2],
+                (out_rows - 1) * cd.strides[0] + ker_range_h(cd));
+        const dim_t in_size
+                = in_rows * act_mds[l].dims[3] * act_mds[l].padded_dims[1];
+        const dim_t out_size = out_rows * act_mds[l + 1].dims[3]
+                * act_mds[l + 1].padded_dims[1];
+        working_set = nstl::max(
+                working_set, (dim_t)sizeof(float) * (in_size + out_size));
+        out_rows = in_rows;
+    }
+    return working_set;
+}
+
+status_t tiled_conv_stack_t::pd_t::init_tiles(
+        const std::vector<memory_desc_t> &act_mds) {
+    const int L = n_layers();
+    const dim_t MB = dst_md_.dims[0];
+    const dim_t OH = dst_md_.dims[2];
+
+    // The tile works on the L2 cache of a single core. Half of it is left
+    // for the weights and the data of the neighbouring layers.
+    const dim_t l2_budget = get_cache_size(2, true) / 2;
+    tile_h_ = OH;
+    while (tile_h_ > 1 && tile_working_set(act_mds, tile_h_) > l2_budget)
+        tile_h_--;
+    // Every thread should get a tile even for small batches
+    const dim_t nthr = dnnl_get_max_threads();
+    tile_h_ = nstl::min(tile_h_, div_up(OH, div_up(nthr, MB)));
+
+    const dim_t n_tiles = div_up(OH, tile_h_);
+    tiles_.resize(n_tiles);
+    for (dim_t t = 0; t < n_tiles; ++t) {
+        tile_t &tile = tiles_[t];
+        tile.dst_row = t * tile_h_;
+        tile.dst_rows = nstl::min(tile_h_, OH - tile.dst_row);
+        tile.convs.resize(L);
+
+        // Walk the layers backwards computing the rows each layer reads.
+        // The padding of a tile is the part of the padding of the layer its
+        // rows cover.
+        dim_t o0 = tile.dst_row, o1 = tile.dst_row + tile.dst_rows;
+        for (int l = L - 1; l >= 0; --l) {
+            const convolution_desc_t &lcd = *layer_desc(l);
+            const dim_t s = o0 * lcd.strides[0] - lcd.padding[0][0];
+            const dim_t e = (o1 - 1) * lcd.strides[0] - lcd.padding[0][0]
+                    + ker_range_h(lcd);
+            const dim_t i0 = nstl::max<dim_t>(0, s);
+            const dim_t i1 = nstl::min(lcd.src_desc.dims[2], e);
+            if (i1 <= i0) return unimplemented;
+
+            const memory_desc_t src_tile = tile_md(act_mds[l], i1 - i0);
+            const memory_desc_t dst_tile = tile_md(act_mds[l + 1], o1 - o0);
+            const dims_t padding_l = {i0 - s, lcd.padding[0][1]};
+            const dims_t padding_r = {e - i1, lcd.padding[1][1]};
+            convolution_desc_t cd;
+            CHECK(conv_desc_init(&cd, prop_kind::forward_inference,
+                    lcd.alg_kind, &src_tile, &weights_mds_[l],
+                    with_bias(l) ? &bias_mds_[l] : nullptr, &dst_tile,
+                    lcd.strides, lcd.dilates, padding_l, padding_r));
+
+            primitive_attr_t attr(*layer_attr(l));
+            CHECK(attr.set_scratchpad_mode(scratchpad_mode::user));
+            CHECK(find_or_create_conv(cd, attr, tile.convs[l]));
+
+            o0 = i0;
+            o1 = i1;
+        }
+        tile.src_row = o0;
+        tile.src_rows = o1 - o0;
+
+        const memory_desc_t &src_tile = *conv_pds_[tile.convs[0]]->src_md(0);
+        const memory_desc_t src_view = row_view_md(src_md_, tile.src_rows);
+        tile.src_reorder = -1;
+        if (!is_dense_view(src_view, src_tile))
+            CHECK(find_or_create_reorder(src_view, src_tile, tile.src_reorder));
+
+        const memory_desc_t &dst_tile
+                = *conv_pds_[tile.convs[L - 1]]->dst_md(0);
+        const memory_desc_t dst_view = row_view_md(dst_md_, tile.dst_rows);
+        tile.dst_reorder = -1;
+        if (!is_dense_view(dst_view, dst_tile))
+            CHECK(find_or_create_reorder(dst_tile, dst_view, tile.dst_reorder));
+    }
+
+    return success;
+}
+
+status_t tiled_conv_stack_t::pd_t::find_or_create_conv(
+        const convolution_desc_t &cd, const primitive_attr_t &attr,
+        int &idx) {
+    for (size_t i = 0; i < conv_pds_.size(); ++i) {
+        const auto *cpd_desc = reinterpret_cast<const convolution_desc_t *>(
+                conv_pds_[i]->op_desc());
+        if (*cpd_desc == cd && *conv_pds_[i]->attr() == attr) {
+            idx = (int)i;
+            return success;
+        }
+    }
+
+    primitive_desc_t *cpd = nullptr;
+    CHECK(create_conv_pd(&cpd, engine_, cd, attr));
+    // the nested convolution must take the weights of the layer as is
+    if (*cpd->weights_md(0) != cd.weights_desc) {
+        delete cpd;
+        return unimplemented;
+    }
+    idx = (int)conv_pds_.size();
+    conv_pds_.push_back(cpd);
+    return success;
+}
+
+status_t tiled_conv_stack_t::pd_t::find_or_create_reorder(
+        const memory_desc_t &src_md, const memory_desc_t &dst_md, int &idx) {
+    for (size_t i = 0; i < reorder_pds_.size(); ++i) {
+        if (*reorder_pds_[i]->src_md(0) == src_md
+                && *reorder_pds_[i]->dst_md(0) == dst_md) {
+            idx = (int)i;
+            return success;
+        }
+    }
+
+    primitive_attr_t attr;
+    CHECK(attr.set_scratchpad_mode(scratchpad_mode::user));
+    for (auto r = engine_->get_reorder_implementation_list(); *r; ++r) {
+        reorder_pd_t *r_pd = nullptr;
+        if ((*r)(&r_pd, engine_, &attr, engine_, &src_md, engine_, &dst_md)
+                == success) {
+            idx = (int)reorder_pds_.size();
+            reorder_pds_.push_back(r_pd);
+            return success;
+        }
+    }
+    return unimplemented;
+}
+
+void tiled_conv_stack_t::pd_t::init_scratchpad() {
+    const int L = n_layers();
+    auto md_size = [](const memory_desc_t *md) {
+        return memory_desc_wrapper(md).size();
+    };
+
+    buf_size_ = 0;
+    for (const auto &tile : tiles_) {
+        if (tile.src_reorder >= 0)
+            buf_size_ = nstl::max(
+                    buf_size_, md_size(conv_pds_[tile.convs[0]]->src_md(0)));
+        for (int l = 0; l < L; ++l) {
+            if (l == L - 1 && tile.dst_reorder < 0) continue;
+            buf_size_ = nstl::max(
+                    buf_size_, md_size(conv_pds_[tile.convs[l]]->dst_md(0)));
+        }
+    }
+
+    nested_scratchpad_size_ = 0;
+    for (const auto &cpd : conv_pds_)
+        nested_scratchpad_size_ = nstl::max(nested_scratchpad_size_,
+                (size_t)cpd->scratchpad_size(scratchpad_mode::user));
+    for (const auto &rpd : reorder_pds_)
+        nested_scratchpad_size_ = nstl::max(nested_scratchpad_size_,
+                (size_t)rpd->scratchpad_size(scratchpad_mode::user));
+
+    // the threads do not share the pages of their buffers
+    buf_size_ = rnd_up(buf_size_, PAGE_4K);
+    nested_scratchpad_size_ = rnd_up(nested_scratchpad_size_, PAGE_4K);
+
+    const dim_t work_amount = dst_md_.dims[0] * (dim_t)tiles_.size();
+    nthr_ = (int)nstl::min<dim_t>(dnnl_get_max_threads(), work_amount);
+
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.book(key_conv_stack_tile_buffers, 2 * buf_size_ * nthr_,
+            PAGE_4K);
+    scratchpad.book(key_conv_stack_nested_scratchpad,
+            nested_scratchpad_size_ * nthr_, PAGE_4K);
+}
+
+status_t tiled_conv_stack_t::execute_nested(const exec_ctx_t &ctx,
+        const primitive_t *p, exec_args_t &args, char *scratchpad) const {
+    const memory_desc_t *scratchpad_md = p->pd()->scratchpad_md();
+    memory_t scratchpad_mem(engine(), scratchpad_md,
+            memory_flags_t::use_runtime_ptr, scratchpad);
+    if (!types::is_zero_md(scratchpad_md))
+        args[DNNL_ARG_SCRATCHPAD] = {&scratchpad_mem, false};
+
+    exec_ctx_t nested_ctx(ctx.stream(), std::move(args));
+    return p->execute(nested_ctx);
+}
+
+status_t tiled_conv_stack_t::execute_tile(const exec_ctx_t &ctx, dim_t n,
+        const pd_t::tile_t &tile, const memory_arg_t *weights,
+        const memory_arg_t *bias, char *buf[2], char *scratchpad) const {
+    // the buffers and the user memory are already padded with zeros
+    const unsigned flags
+            = memory_flags_t::use_runtime_ptr | memory_flags_t::omit_zero_pad;
+    const size_t dt_size = sizeof(float);
+    const int L = pd()->n_layers();
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    char *src_rows = const_cast<char *>(src)
+            + src_d.blk_off(n, 0, tile.src_row) * dt_size;
+    char *dst_rows = dst + dst_d.blk_off(n, 0, tile.dst_row) * dt_size;
+
+    char *l_src = src_rows;
+    if (tile.src_reorder >= 0) {
+        const primitive_t *r = reorders_[tile.src_reorder];
+        memory_t view(engine(), r->pd()->src_md(), flags, src_rows);
+        memory_t src_tile(engine(), r->pd()->dst_md(), flags, buf[0]);
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = {&view, true};
+        r_args[DNNL_ARG_DST] = {&src_tile, false};
+        CHECK(execute_nested(ctx, r, r_args, scratchpad));
+        l_src = buf[0];
+    }
+
+    for (int l = 0; l < L; ++l) {
+        const primitive_t *c = convs_[tile.convs[l]];
+        char *l_dst = l == L - 1 && tile.dst_reorder < 0 ? dst_rows
+                                                         : buf[(l + 1) % 2];
+        memory_t src_tile(engine(), c->pd()->src_md(), flags, l_src);
+        memory_t dst_tile(engine(), c->pd()->dst_md(), flags, l_dst);
+        exec_args_t c_args;
+        c_args[DNNL_ARG_SRC] = {&src_tile, true};
+        c_args[DNNL_ARG_WEIGHTS] = weights[l];
+        if (bias[l].mem) c_args[DNNL_ARG_BIAS] = bias[l];
+        c_args[DNNL_ARG_DST] = {&dst_tile, false};
+        CHECK(execute_nested(ctx, c, c_args, scratchpad));
+        l_src = l_dst;
+    }
+
+    if (tile.dst_reorder >= 0) {
+        const primitive_t *r = reorders_[tile.dst_reorder];
+        memory_t dst_tile(engine(), r->pd()->src_md(), flags, l_src);
+        memory_t view(engine(), r->pd()->dst_md(), flags, dst_rows);
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = {&dst_tile, true};
+        r_args[DNNL_ARG_DST] = {&view, false};
+        CHECK(execute_nested(ctx, r, r_args, scratchpad));
+    }
+
+    return success;
+}
+
+status_t tiled_conv_stack_t::execute(const exec_ctx_t &ctx) const {
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    char *buffers = scratchpad.get<char>(key_conv_stack_tile_buffers);
+    char *nested_scratchpad
+            = scratchpad.get<char>(key_conv_stack_nested_scratchpad);
+
+    const dim_t MB = pd()->dst_md()->dims[0];
+    const dim_t n_tiles = (dim_t)pd()->tiles_.size();
+    const size_t buf_size = pd()->buf_size_;
+    const size_t nested_scratchpad_size = pd()->nested_scratchpad_size_;
+
+    // look the layer arguments up once instead of per tile and thread; the
+    // bias is only expected for the layers created with one
+    const int L = pd()->n_layers();
+    std::vector<memory_arg_t> weights(L, {nullptr, true});
+    std::vector<memory_arg_t> bias(L, {nullptr, true});
+    for (int l = 0; l < L; ++l) {
+        auto w = ctx.args().find(DNNL_ARG_MULTIPLE_WEIGHTS + l);
+        if (w == ctx.args().end()) return status::invalid_arguments;
+        weights[l] = w->second;
+        if (!pd()->with_bias(l)) continue;
+        auto b = ctx.args().find(DNNL_ARG_MULTIPLE_BIAS + l);
+        if (b == ctx.args().end()) return status::invalid_arguments;
+        bias[l] = b->second;
+    }
+
+    // The nested primitives run in the threads of the stack, which split
+    // the images and the tiles between them
+    std::vector<status_t> thr_status(pd()->nthr_, success);
+    parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(MB * n_tiles, nthr, ithr, start, end);
+
+        char *buf[2] = {buffers + 2 * ithr * buf_size,
+                buffers + (2 * ithr + 1) * buf_size};
+        char *thr_scratchpad = nested_scratchpad
+                ? nested_scratchpad + ithr * nested_scratchpad_size
+                : nullptr;
+
+        dim_t n {0}, t {0};
+        nd_iterator_init(start, n, MB, t, n_tiles);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            status_t st = execute_tile(ctx, n, pd()->tiles_[t],
+                    weights.data(), bias.data(), buf, thr_scratchpad);
+            if (st != success) {
+                thr_status[ithr] = st;
+                break;
+            }
+            nd_iterator_step(n, MB, t, n_tiles);
+        }
+    });
+
+    for (auto st : thr_status)
+        if (st != success) return st;
+    return success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,162 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_TILED_CONV_STACK_HPP
+#define CPU_TILED_CONV_STACK_HPP
+
+#include <vector>
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "primitive_iterator.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_conv_stack_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+/* Computes the stack of convolutions tile by tile. A tile is a block of rows
+ * of the destination of the last layer of a single image. The rows of the
+ * intermediate activations a tile depends on (including the halo rows shared
+ * with the neighbouring tiles, which are recomputed) are small enough to stay
+ * in the L2 cache of the thread that computes the tile, so the intermediate
+ * activations never go to the main memory.
+ *
+ * Every layer of a tile is computed by a nested convolution created for the
+ * shape of the tile. Since most of the tiles have the same shape only a few
+ * nested convolutions are created per layer. */
+struct tiled_conv_stack_t : public primitive_impl_t {
+    struct pd_t : public cpu_conv_stack_pd_t {
+        using cpu_conv_stack_pd_t::cpu_conv_stack_pd_t;
+
+        pd_t(const pd_t &rhs) : cpu_conv_stack_pd_t(rhs) { copy_from(rhs); }
+
+        ~pd_t() { clear(); }
+
+        pd_t &operator=(const pd_t &rhs) {
+            DNNL_SHORT_CIRCUIT_SELF_ASSIGN(rhs);
+            cpu_conv_stack_pd_t::operator=(rhs);
+            clear();
+            copy_from(rhs);
+            return *this;
+        }
+
+        DECLARE_CONV_STACK_PD_T("tiled:any", tiled_conv_stack_t);
+
+        status_t init();
+
+        struct tile_t {
+            // the source rows the tile reads
+            dim_t src_row, src_rows;
+            // the destination rows the tile writes
+            dim_t dst_row, dst_rows;
+            // the reorders between the user memory and the buffers, -1 if
+            // the nested convolutions work directly on the user memory
+            int src_reorder, dst_reorder;
+            // the nested convolution of each layer
+            std::vector<int> convs;
+        };
+
+        std::vector<tile_t> tiles_;
+        std::vector<const primitive_desc_t *> conv_pds_;
+        std::vector<const primitive_desc_t *> reorder_pds_;
+
+        dim_t tile_h_ = 0;
+        // the per thread sizes of the buffers and the nested scratchpad
+        size_t buf_size_ = 0;
+        size_t nested_scratchpad_size_ = 0;
+        int nthr_ = 0;
+
+    private:
+        status_t init_layers(std::vector<memory_desc_t> &act_mds);
+        dim_t tile_working_set(
+                const std::vector<memory_desc_t> &act_mds, dim_t h) const;
+        status_t init_tiles(const std::vector<memory_desc_t> &act_mds);
+        status_t find_or_create_conv(const convolution_desc_t &cd,
+                const primitive_attr_t &attr, int &idx);
+        status_t find_or_create_reorder(const memory_desc_t &src_md,
+                const memory_desc_t &dst_md, int &idx);
+        void init_scratchpad();
+
+        void copy_from(const pd_t &rhs) {
+            tiles_ = rhs.tiles_;
+            for (auto &cpd : rhs.conv_pds_)
+                conv_pds_.push_back(cpd->clone());
+            for (auto &rpd : rhs.reorder_pds_)
+                reorder_pds_.push_back(rpd->clone());
+            tile_h_ = rhs.tile_h_;
+            buf_size_ = rhs.buf_size_;
+            nested_scratchpad_size_ = rhs.nested_scratchpad_size_;
+            nthr_ = rhs.nthr_;
+        }
+
+        void clear() {
+            for (auto &cpd : conv_pds_)
+                delete cpd;
+            for (auto &rpd : reorder_pds_)
+                delete rpd;
+            conv_pds_.clear();
+            reorder_pds_.clear();
+        }
+    };
+
+    tiled_conv_stack_t(const pd_t *apd) : primitive_impl_t(apd) {}
+
+    ~tiled_conv_stack_t() {
+        for (auto &c : convs_)
+            delete c;
+        for (auto &r : reorders_)
+            delete r;
+    }
+
+    virtual status_t init() override {
+        for (auto &cpd : pd()->conv_pds_) {
+            primitive_t *c = nullptr;
+            CHECK(cpd->create_primitive(&c));
+            convs_.push_back(c);
+        }
+        for (auto &rpd : pd()->reorder_pds_) {
+            primitive_t *r = nullptr;
+            CHECK(rpd->create_primitive(&r));
+            reorders_.push_back(r);
+        }
+        return status::success;
+    }
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    status_t execute_tile(const exec_ctx_t &ctx, dim_t n,
+            const pd_t::tile_t &tile, const memory_arg_t *weights,
+            const memory_arg_t *bias, char *buf[2], char *scratchpad) const;
+    status_t execute_nested(const exec_ctx_t &ctx, const primitive_t *p,
+            exec_args_t &args, char *scratchpad) const;
+
+    const pd_t *pd() const { return (const pd_t *)primitive_impl_t::pd(); }
+    std::vector<primitive_t *> convs_;
+    std::vector<primitive_t *> reorders_;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -63,7 +63,7 @@ dnnl_status_t gemm_generic(cl_command_queue queue, const char *transa,
     OCL_CHECK(clGetCommandQueueInfo(
             queue, CL_QUEUE_DEVICE, sizeof(ocl_dev), &ocl_dev, nullptr));
 
-    std::unique_ptr<ocl_gpu_engine_t> engine;
+    std::unique_ptr<ocl_gpu_engine_t, engine_deleter_t> engine;
     engine_t *engine_ptr;
 
     status = ocl_engine_factory_t(engine_kind::gpu)
@@ -176,7 +176,7 @@ dnnl_status_t gemm_x8x8s32(cl_command_queue queue, const char *transa,
     OCL_CHECK(clGetCommandQueueInfo(
             queue, CL_QUEUE_DEVICE, sizeof(ocl_dev), &ocl_dev, nullptr));
 
-    std::unique_ptr<ocl_gpu_engine_t> engine;
+    std::unique_ptr<ocl_gpu_engine_t, engine_deleter_t> engine;
     engine_t *engine_ptr;
 
     status = ocl_engine_factory_t(engine_kind::gpu)
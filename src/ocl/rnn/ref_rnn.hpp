@@ -123,10 +123,13 @@ struct _ref_rnn_common_t : public primitive_impl_t {
                     && everyone_is(
                             weights_type, weights_iter_dt, weights_layer_dt)
                     && this->set_default_params() == status::success
-                    && this->with_bias()
+                    && this->with_bias() && !this->with_seq_lengths()
+                    && !this->with_peephole() && !this->with_projection()
                     && IMPLICATION(src_type == data_type::f16
                                     || src_type == data_type::u8,
                             this->desc()->prop_kind == forward_inference)
+                    && IMPLICATION(src_type == data_type::u8,
+                            cell_kind == alg_kind::vanilla_lstm)
                     && compute_engine->mayiuse(
                             compute::device_ext_t::intel_subgroups)
                     && IMPLICATION(src_type == data_type::f16,
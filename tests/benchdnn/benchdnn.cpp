@@ -31,6 +31,7 @@
 #include "bnorm/bnorm.hpp"
 #include "concat/concat.hpp"
 #include "conv/conv.hpp"
+#include "conv_stack/conv_stack.hpp"
 #include "conv/deconv.hpp"
 #include "eltwise/eltwise.hpp"
 #include "ip/ip.hpp"
@@ -48,6 +49,7 @@
 
 int verbose {0};
 bench_mode_t bench_mode {CORR};
+cold_cache_mode_t cold_cache_mode {COLD_CACHE_NONE};
 stat_t benchdnn_stat {0};
 const char *driver_name = "";
 
@@ -55,6 +57,10 @@ double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
 
+int n_instances {2};
+int threads_per_instance {0};
+bool use_scratchpad_arena {true};
+
 bool fast_ref_gpu {true};
 
 int main(int argc, char **argv) {
@@ -103,6 +109,8 @@ int main(int argc, char **argv) {
             prim = MATMUL;
         else if (!strcmp("--resampling", argv[0]))
             prim = RESAMPLING;
+        else if (!strcmp("--conv_stack", argv[0]))
+            prim = CONV_STACK;
         else
             break;
     }
@@ -129,6 +137,7 @@ int main(int argc, char **argv) {
         case BINARY: binary::bench(argc, argv); break;
         case MATMUL: matmul::bench(argc, argv); break;
         case RESAMPLING: resampling::bench(argc, argv); break;
+        case CONV_STACK: conv_stack::bench(argc, argv); break;
         default: fprintf(stderr, "err: unknown driver\n");
     }
 
@@ -77,7 +77,7 @@ static int init_pd(const prb_t *p, dnnl_binary_desc_t &bd,
             WARN);
 
     dnnl_status_t init_status
-            = dnnl_primitive_desc_create(&bpd, &bd, NULL, engine_tgt, NULL);
+            = create_primitive_desc(&bpd, &bd, NULL, engine_tgt, NULL, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -174,7 +174,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, bd, bpd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&bo, bpd), WARN);
+    DNN_SAFE(create_primitive(&bo, bpd, r), WARN);
 
     const auto q = [=](dnnl_query_t query, int index = 0) {
         return *dnnl_primitive_desc_query_md(bpd, query, index);
@@ -233,7 +233,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare(p, dst_fp, dst, r), WARN);
     }
 
-    measure_perf(r->timer, bo, args);
+    measure_perf(r, bo, args);
 
     DNN_SAFE(dnnl_primitive_desc_destroy(bpd), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(bo), CRIT);
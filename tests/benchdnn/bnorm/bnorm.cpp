@@ -534,8 +534,8 @@ static int init_pd(const prb_t *p, dnnl_batch_normalization_desc_t &bd,
             SAFE(init_fwd_status, WARN);
     }
     auto dnnl_attr = create_dnnl_attr(p->attr, 1, NULL);
-    dnnl_status_t init_status = dnnl_primitive_desc_create(
-            &bpd, &bd, dnnl_attr, engine_tgt, hint_fwd_pd);
+    dnnl_status_t init_status = create_primitive_desc(
+            &bpd, &bd, dnnl_attr, engine_tgt, hint_fwd_pd, r);
 
     dnnl_primitive_desc_destroy(hint_fwd_pd);
     dnnl_primitive_attr_destroy(dnnl_attr);
@@ -602,7 +602,7 @@ static int cvt_mask_to_ws(
             WARN);
 
     dnnl_primitive_t b;
-    DNN_SAFE(dnnl_primitive_create(&b, bpd), WARN);
+    DNN_SAFE(create_primitive(&b, bpd, nullptr), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(bpd), CRIT);
 
     args_t args;
@@ -660,7 +660,7 @@ int doit(const prb_t *p, res_t *r) {
         ws_dt = dnn_mem_t(*ws_md, engine_tgt);
     }
 
-    DNN_SAFE(dnnl_primitive_create(&b, bpd), WARN);
+    DNN_SAFE(create_primitive(&b, bpd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(bpd), CRIT);
 
     dnn_mem_t d_dst_dt, placeholder_d_src_dt;
@@ -762,7 +762,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, b, args);
+    measure_perf(r, b, args);
 
     DNN_SAFE(dnnl_primitive_destroy(b), CRIT);
 
@@ -43,17 +43,43 @@
 #endif
 
 const char *bench_mode2str(bench_mode_t mode) {
+    if (mode & THROUGHPUT)
+        return (mode & CORR) ? "CORR+THROUGHPUT" : "THROUGHPUT";
     const char *modes[] = {"MODE_UNDEF", "CORR", "PERF", "CORR+PERF", "LIST"};
     assert((int)mode < sizeof(modes) / sizeof(*modes));
     return modes[(int)mode];
 }
 
+const char *cold_cache_mode2str(cold_cache_mode_t mode) {
+    switch (mode) {
+        case COLD_CACHE_NONE: return "none";
+        case COLD_CACHE_WEI: return "wei";
+        case COLD_CACHE_ALL: return "all";
+    }
+    assert(!"unknown cold cache mode");
+    return "unknown cold cache mode";
+}
+
+cold_cache_mode_t str2cold_cache_mode(const char *str) {
+    if (!strcasecmp("none", str)) return COLD_CACHE_NONE;
+    if (!strcasecmp("wei", str)) return COLD_CACHE_WEI;
+    if (!strcasecmp("all", str)) return COLD_CACHE_ALL;
+    []() {
+        SAFE(FAIL, CRIT);
+        return 0;
+    }();
+    return COLD_CACHE_NONE;
+}
+
 bench_mode_t str2bench_mode(const char *str) {
     bench_mode_t mode = MODE_UNDEF;
     if (strchr(str, 'c') || strchr(str, 'C'))
         mode = (bench_mode_t)((int)mode | (int)CORR);
     if (strchr(str, 'p') || strchr(str, 'P'))
         mode = (bench_mode_t)((int)mode | (int)PERF);
+    // throughput mode measures the performance of a single execution too
+    if (strchr(str, 't') || strchr(str, 'T'))
+        mode = (bench_mode_t)((int)mode | (int)PERF | (int)THROUGHPUT);
     if (strchr(str, 'l') || strchr(str, 'L')) {
         // list mode is exclusive
         assert(mode == MODE_UNDEF);
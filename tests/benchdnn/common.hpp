@@ -128,6 +128,7 @@ enum prim_t {
     BINARY,
     MATMUL,
     RESAMPLING,
+    CONV_STACK,
     DEF = CONV,
 };
 
@@ -136,10 +137,22 @@ enum bench_mode_t {
     CORR = 0x1,
     PERF = 0x2,
     LIST = 0x4,
+    THROUGHPUT = 0x8,
 };
 const char *bench_mode2str(bench_mode_t mode);
 bench_mode_t str2bench_mode(const char *str);
 extern bench_mode_t bench_mode;
+
+/* arguments replaced with copies between the iterations of cold-cache
+ * performance measurements */
+enum cold_cache_mode_t {
+    COLD_CACHE_NONE = 0x0,
+    COLD_CACHE_WEI = 0x1,
+    COLD_CACHE_ALL = 0x2,
+};
+const char *cold_cache_mode2str(cold_cache_mode_t mode);
+cold_cache_mode_t str2cold_cache_mode(const char *str);
+extern cold_cache_mode_t cold_cache_mode;
 extern const char *driver_name;
 
 /* perf */
@@ -147,6 +160,11 @@ extern double max_ms_per_prb; /** maximum time spends per prb in ms */
 extern int min_times_per_prb; /** minimal amount of runs per prb */
 extern int fix_times_per_prb; /** if non-zero run prb that many times */
 
+/* throughput */
+extern int n_instances; /** number of concurrent executions */
+extern int threads_per_instance; /** if zero, divide threads evenly */
+extern bool use_scratchpad_arena; /** keep the scratchpad between runs */
+
 extern bool fast_ref_gpu;
 
 struct benchdnn_timer_t {
@@ -209,10 +227,25 @@ enum res_state_t {
 };
 const char *state2str(res_state_t state, bool allow_unimpl);
 
+/* results of concurrent executions in throughput mode */
+struct benchdnn_throughput_t {
+    int instances; /** number of concurrent executions */
+    int threads; /** number of threads of an execution */
+    long long times; /** number of executions of all the instances */
+    double total_ms; /** from the first start to the last finish */
+    double avg_ms, p50_ms, p99_ms; /** execution latencies */
+};
+
 struct res_t {
     res_state_t state;
     size_t errors, total;
     benchdnn_timer_t timer;
+    benchdnn_timer_t cold_timer; /** filled with --cold-cache only */
+    benchdnn_throughput_t thr; /** filled with --mode=throughput only */
+    double create_pd_ms; /** primitive descriptor creation time */
+    double create_miss_ms; /** primitive creation time */
+    double create_hit_ms; /** same, from the primitive cache, perf mode only */
+    size_t jit_code_size; /** code generated for the primitive in bytes */
 };
 
 void parse_result(res_t &res, bool &want_perf_report, bool allow_unimpl,
@@ -48,6 +48,7 @@ static int init_pd(const prb_t *p, dnnl_primitive_desc_t &cpd, res_t *r) {
                 WARN);
     }
 
+    set_benchdnn_threads();
     dnnl_status_t init_status = dnnl_concat_primitive_desc_create(&cpd,
             p->dtag != dnnl_format_tag_undef ? &dst_d : NULL, p->n_inputs(),
             p->axis, src_d.data(), NULL, engine_tgt);
@@ -132,7 +133,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, cpd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&c, cpd), WARN);
+    DNN_SAFE(create_primitive(&c, cpd, r), WARN);
 
     const auto q = [=](dnnl_query_t query, int index = 0) {
         return *dnnl_primitive_desc_query_md(cpd, query, index);
@@ -178,7 +179,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare(p, dst_data_type, dst_fp, dst, r), WARN);
     }
 
-    measure_perf(r->timer, c, args);
+    measure_perf(r, c, args);
 
     DNN_SAFE(dnnl_primitive_desc_destroy(cpd), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(c), CRIT);
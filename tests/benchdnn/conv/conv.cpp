@@ -321,8 +321,12 @@ int fill_src(const prb_t *p, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp, res_t *r) {
 int fill_wei(const prb_t *p, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp, res_t *r) {
     const bool wino_s8 = p->alg == WINO && p->cfg[WEI].dt == dnnl_s8;
     const bool s8_s8 = p->cfg[WEI].dt == dnnl_s8 && p->cfg[SRC].dt == dnnl_s8;
+    // weights with the source zero point compensation cannot be reordered
+    // back, the same as the s8s8 ones
+    const bool src_zp = !p->attr.zero_points.is_def(DNNL_ARG_SRC);
     const bool diff_data_type = mem_dt.dt() != mem_fp.dt();
-    const bool check_reorder = diff_data_type && !wino_s8 && !s8_s8;
+    const bool check_reorder
+            = diff_data_type && !wino_s8 && !s8_s8 && !src_zp;
 
     dnn_mem_t extra_mem;
     if (check_reorder) {
@@ -532,10 +536,10 @@ inline int init_pd(dnnl_engine_t eng, const prb_t *p,
     DNN_SAFE(cd.accum_data_type == acc_dt ? dnnl_success : dnnl_unimplemented,
             CRIT);
 
-    auto dnnl_attr = create_dnnl_attr(p->attr, p->oc, p->scales);
+    auto dnnl_attr = create_dnnl_attr(p->attr, p->oc, p->scales, &cd.dst_desc);
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(&cpd, &cd, dnnl_attr, eng, NULL);
+    init_status = create_primitive_desc(&cpd, &cd, dnnl_attr, eng, NULL, r);
 
     dnnl_primitive_attr_destroy(dnnl_attr);
 
@@ -594,6 +598,48 @@ inline int init_pd(dnnl_engine_t eng, const prb_t *p,
     return OK;
 }
 
+inline int find_dw_conv_post_op(const attr_t &attr) {
+    for (int idx = 0; idx < attr.post_ops.len; ++idx)
+        if (attr.post_ops.entry[idx].is_depthwise_conv()) return idx;
+    return -1;
+}
+
+/* A fused depthwise convolution is checked as a separate problem reading the
+ * output of the convolution, which becomes the source of the depthwise one */
+inline desc_t dw_conv_desc(
+        const prb_t *p, const attr_t::post_ops_t::entry_t &e) {
+    desc_t d = *p;
+    d.g = d.ic = d.oc = p->oc;
+    d.id = d.od = d.kd = d.sd = 1;
+    d.ih = p->oh;
+    d.iw = p->ow;
+    d.kh = d.kw = 3;
+    d.sh = d.sw = e.kind == attr_t::post_ops_t::DW_K3S2P1 ? 2 : 1;
+    d.pd = 0;
+    d.ph = d.pw = 1;
+    d.dd = d.dh = d.dw = 0;
+    d.oh = (d.ih + 2 * d.ph - d.kh) / d.sh + 1;
+    d.ow = (d.iw + 2 * d.pw - d.kw) / d.sw + 1;
+    d.has_groups = true;
+    return d;
+}
+
+/* The generic weights are the same for all the channels of a depthwise
+ * convolution. The source of a fused one is usually the output of relu, so
+ * most of its output would have the sign of the sum of the kernel, and be
+ * zeroed by the eltwise post-ops that follow. Negate every other channel to
+ * keep the output of the chained post-ops meaningful. */
+inline int flip_dw_wei(
+        const prb_t *p_dw, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp) {
+    dnnl::impl::parallel_nd(p_dw->g / 2, p_dw->kh, p_dw->kw,
+            [&](int g2, int kh, int kw) {
+                const size_t off = wei_off_f(p_dw, 2 * g2 + 1, 0, 0, 0, kh, kw);
+                ((float *)mem_fp)[off] = -((float *)mem_fp)[off];
+            });
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+    return OK;
+}
+
 int doit(const prb_t *p, res_t *r) {
     if (bench_mode == LIST) return r->state = LISTED, OK;
 
@@ -618,7 +664,11 @@ int doit(const prb_t *p, res_t *r) {
     auto src_tag = get_default_tag(src_ndims);
     auto wei_tag = get_default_tag(wei_ndims);
 
-    if (bench_mode & CORR && engine_tgt_kind == dnnl_gpu && fast_ref_gpu) {
+    const int dw_idx = find_dw_conv_post_op(p->attr);
+    const bool with_dw_conv = dw_idx >= 0;
+
+    if (bench_mode & CORR && engine_tgt_kind == dnnl_gpu && fast_ref_gpu
+            && !with_dw_conv) {
         SAFE(dnnl_engine_create(&engine_ref, dnnl_cpu, 0), WARN);
         SAFE(init_pd(engine_ref, p, cd_ref, cpd_ref, nullptr, fp, fp, fp, fp,
                      fp, src_tag, wei_tag, dnnl_x, src_tag),
@@ -631,7 +681,23 @@ int doit(const prb_t *p, res_t *r) {
             p->attr, p->mb);
     p = &p_new;
 
-    DNN_SAFE(dnnl_primitive_create(&c, cpd), WARN);
+    // with a depthwise post-op the destination is described by p_dw
+    attr_t attr_conv = p->attr, attr_dw;
+    desc_t desc_dw = *p;
+    if (with_dw_conv) {
+        const auto &po = p->attr.post_ops;
+        attr_conv.post_ops.len = dw_idx;
+        for (int idx = dw_idx + 1; idx < po.len; ++idx)
+            attr_dw.post_ops.entry[attr_dw.post_ops.len++] = po.entry[idx];
+        desc_dw = dw_conv_desc(p, po.entry[dw_idx]);
+    }
+    prb_t p_conv((desc_t)*p, p->dir, p->cfg, p->stag, p->wtag, p->dtag, p->alg,
+            attr_conv, p->mb);
+    prb_t p_dw(desc_dw, FWD_B, p->cfg, p->dtag, dnnl_format_tag_any, p->dtag,
+            DIRECT, attr_dw, p->mb);
+    const prb_t *p_dst = with_dw_conv ? &p_dw : p;
+
+    DNN_SAFE(create_primitive(&c, cpd, r), WARN);
     if (cpd_ref) {
         DNN_SAFE(dnnl_primitive_create(&c_ref, cpd_ref), WARN);
         print(5, "%s\n", "benchdnn: use CPU primitive as the reference");
@@ -660,23 +726,69 @@ int doit(const prb_t *p, res_t *r) {
 
     SAFE(fill_src(p, src_dt, src_fp, r), WARN);
     SAFE(fill_wei(p, wei_dt, wei_fp, r), WARN);
-    SAFE(fill_dst(p, dst_dt, dst_fp, r), WARN);
+    SAFE(fill_dst(p_dst, dst_dt, dst_fp, r), WARN);
     if (p->dir & FLAG_BIA) SAFE(fill_bia(p, bia_dt, bia_fp, r), WARN);
 
+    const int dw_arg = DNNL_ARG_ATTR_MULTIPLE_POST_OP(dw_idx);
+    dnn_mem_t wei_dw_dt, wei_dw_fp, bia_dw_dt, bia_dw_fp;
+    if (with_dw_conv) {
+        const_dnnl_primitive_desc_t const_pd;
+        DNN_SAFE(dnnl_primitive_get_primitive_desc(c, &const_pd), CRIT);
+        auto q = [&](int arg) {
+            return *dnnl_primitive_desc_query_md(
+                    const_pd, dnnl_query_exec_arg_md, arg);
+        };
+
+        wei_dw_dt = dnn_mem_t(q(dw_arg | DNNL_ARG_WEIGHTS), engine_tgt);
+        bia_dw_dt = dnn_mem_t(q(dw_arg | DNNL_ARG_BIAS), engine_tgt);
+        wei_dw_fp = dnn_mem_t(
+                wei_dw_dt.md_, fp, get_default_tag(src_ndims + 1), engine_tgt);
+        bia_dw_fp = dnn_mem_t(bia_dw_dt.md_, fp, dnnl_x, engine_tgt);
+
+        SAFE(fill_wei(&p_dw, wei_dw_dt, wei_dw_fp, r), WARN);
+        SAFE(flip_dw_wei(&p_dw, wei_dw_dt, wei_dw_fp), WARN);
+        SAFE(fill_bia(&p_dw, bia_dw_dt, bia_dw_fp, r), WARN);
+    }
+
+    dnn_mem_t src_zero_points_m, dst_zero_points_m;
+    maybe_prepare_runtime_zero_points(
+            src_zero_points_m, p->attr, DNNL_ARG_SRC, engine_tgt);
+    maybe_prepare_runtime_zero_points(
+            dst_zero_points_m, p->attr, DNNL_ARG_DST, engine_tgt);
+
     args_t args;
+    std::vector<dnn_mem_t> binary_po_m;
 
     if (p->dir & FLAG_FWD) {
         args.set(DNNL_ARG_SRC, src_dt);
         args.set(DNNL_ARG_WEIGHTS, wei_dt);
         if (p->dir & FLAG_BIA) args.set(DNNL_ARG_BIAS, bia_dt);
         args.set(DNNL_ARG_DST, dst_dt);
+        args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_SRC, src_zero_points_m);
+        args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_DST, dst_zero_points_m);
+        maybe_prepare_binary_post_ops(
+                binary_po_m, args, p->attr, c, engine_tgt);
+        if (with_dw_conv) {
+            args.set(dw_arg | DNNL_ARG_WEIGHTS, wei_dw_dt);
+            args.set(dw_arg | DNNL_ARG_BIAS, bia_dw_dt);
+        }
 
         DNN_SAFE(execute_and_wait(c, stream_tgt, args), WARN);
 
         if (bench_mode & CORR) {
-            compute_ref_fwd(p, c_ref, src_fp, wei_fp, bia_fp, dst_fp);
+            if (with_dw_conv) {
+                dnnl_dims_t dims = {p->mb, p->oc, p->oh, p->ow};
+                dnn_mem_t dst_conv_fp(
+                        src_ndims, dims, fp, src_tag, engine_tgt);
+                compute_ref_fwd(&p_conv, nullptr, src_fp, wei_fp, bia_fp,
+                        dst_conv_fp);
+                compute_ref_fwd(&p_dw, nullptr, dst_conv_fp, wei_dw_fp,
+                        bia_dw_fp, dst_fp);
+            } else {
+                compute_ref_fwd(p, c_ref, src_fp, wei_fp, bia_fp, dst_fp);
+            }
             dnn_mem_t dst(dst_dt, fp, src_tag, engine_tgt);
-            SAFE(compare_dst(p, dst, dst_fp, r, true), WARN);
+            SAFE(compare_dst(p_dst, dst, dst_fp, r, true), WARN);
         }
     } else if (p->dir == BWD_D) {
         args.set(DNNL_ARG_DIFF_DST, dst_dt);
@@ -711,7 +823,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(FAIL, CRIT);
     }
 
-    measure_perf(r->timer, c, args);
+    measure_perf(r, c, args);
 
     DNN_SAFE(dnnl_primitive_destroy(c), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(c_ref), CRIT);
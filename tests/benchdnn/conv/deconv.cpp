@@ -155,8 +155,8 @@ inline int init_pd(const prb_t *p, dnnl_deconvolution_desc_t &cd,
     auto dnnl_attr = create_dnnl_attr(p->attr, p->oc, p->scales);
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(
-            &dpd, &cd, dnnl_attr, engine_tgt, NULL);
+    init_status = create_primitive_desc(
+            &dpd, &cd, dnnl_attr, engine_tgt, NULL, r);
 
     dnnl_primitive_attr_destroy(dnnl_attr);
 
@@ -224,7 +224,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, cd, dpd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&c, dpd), WARN);
+    DNN_SAFE(create_primitive(&c, dpd, r), WARN);
     DNN_SAFE_V(dnnl_primitive_desc_destroy(dpd));
 
     auto &src_dt_d = p->dir == BWD_D ? cd.diff_src_desc : cd.src_desc;
@@ -263,6 +263,12 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(transpose_data_wei(p, wei_fp, wei_tr_fp), WARN);
     if (p->dir & FLAG_BIA) SAFE(fill_bia(p, bia_dt, bia_fp, r), WARN);
 
+    dnn_mem_t src_zero_points_m, dst_zero_points_m;
+    maybe_prepare_runtime_zero_points(
+            src_zero_points_m, p->attr, DNNL_ARG_SRC, engine_tgt);
+    maybe_prepare_runtime_zero_points(
+            dst_zero_points_m, p->attr, DNNL_ARG_DST, engine_tgt);
+
     args_t args;
 
     if (p->dir & FLAG_FWD) {
@@ -270,6 +276,8 @@ int doit(const prb_t *p, res_t *r) {
         args.set(DNNL_ARG_WEIGHTS, wei_dt);
         if (p->dir & FLAG_BIA) args.set(DNNL_ARG_BIAS, bia_dt);
         args.set(DNNL_ARG_DST, dst_dt);
+        args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_SRC, src_zero_points_m);
+        args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_DST, dst_zero_points_m);
 
         DNN_SAFE(execute_and_wait(c, stream_tgt, args), WARN);
 
@@ -314,7 +322,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(FAIL, CRIT);
     }
 
-    measure_perf(r->timer, c, args);
+    measure_perf(r, c, args);
 
     DNN_SAFE_V(dnnl_primitive_destroy(c));
 
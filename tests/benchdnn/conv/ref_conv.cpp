@@ -124,6 +124,9 @@ void compute_ref_bwd_w(const prb_t *p, dnnl_primitive_t c_ref, dnn_mem_t &src_m,
 
 void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &wei_m,
         dnn_mem_t &bia_m, dnn_mem_t &dst_m) {
+    const int src_zero_point = p->attr.zero_points[DNNL_ARG_SRC];
+    const int dst_zero_point = p->attr.zero_points[DNNL_ARG_DST];
+
     auto ker = [&](float &d, int64_t g, int64_t mb, int64_t oc, int64_t od,
                        int64_t oh, int64_t ow) {
         /* help compiler optimize the code */
@@ -155,7 +158,7 @@ void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &wei_m,
                                           + kh)
                                         * KW
                                 + kw;
-                        d += ((float *)src_m)[src_off]
+                        d += (((float *)src_m)[src_off] - src_zero_point)
                                 * ((float *)wei_m)[wei_off];
                     }
                 }
@@ -179,7 +182,8 @@ void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &wei_m,
 
                 maybe_scale(
                         conv_res, p->scales, g * p->oc / p->g + oc, p->attr);
-                maybe_post_ops(conv_res, dst, p->attr);
+                maybe_post_ops(conv_res, dst, p->attr, g * p->oc / p->g + oc);
+                conv_res += dst_zero_point;
 
                 dst = conv_res;
             });
@@ -190,6 +194,11 @@ void compute_ref_direct_bwd_d(const prb_t *p, dnn_mem_t &diff_src_m,
     enum { precompute_size = 16 };
     const bool fast = MAX3(p->kd, p->kh, p->kw) <= precompute_size;
 
+    // backward by data also computes the forward deconvolution, which takes
+    // its source from diff_dst and writes its destination to diff_src
+    const int src_zero_point = p->attr.zero_points[DNNL_ARG_SRC];
+    const int dst_zero_point = p->attr.zero_points[DNNL_ARG_DST];
+
     /* pre-computes arrays of oh(ow) and kh(kw) for traversing in kernel */
     auto precompute_ok
             = [](int64_t i, int64_t O, int64_t K, int64_t S, int64_t P,
@@ -235,7 +244,7 @@ void compute_ref_direct_bwd_d(const prb_t *p, dnn_mem_t &diff_src_m,
                                   + kh[h])
                                 * KW
                         + kw[w];
-                ds += ((float *)diff_dst_m)[dst_off]
+                ds += (((float *)diff_dst_m)[dst_off] - src_zero_point)
                         * ((float *)wei_m)[wei_off];
             }
         }
@@ -263,7 +272,7 @@ void compute_ref_direct_bwd_d(const prb_t *p, dnn_mem_t &diff_src_m,
 
                         size_t dst_off = dst_off_f(p, mb, g, oc, od, oh, ow);
                         size_t wei_off = wei_off_f(p, g, oc, ic, kd, kh, kw);
-                        ds += ((float *)diff_dst_m)[dst_off]
+                        ds += (((float *)diff_dst_m)[dst_off] - src_zero_point)
                                 * ((float *)wei_m)[wei_off];
                     }
                 }
@@ -288,7 +297,8 @@ void compute_ref_direct_bwd_d(const prb_t *p, dnn_mem_t &diff_src_m,
                 }
                 maybe_scale(
                         conv_res, p->scales, g * p->ic / p->g + ic, p->attr);
-                maybe_post_ops(conv_res, ds, p->attr);
+                maybe_post_ops(conv_res, ds, p->attr, g * p->ic / p->g + ic);
+                conv_res += dst_zero_point;
 
                 ds = conv_res;
             });
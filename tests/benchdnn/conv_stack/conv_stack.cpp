@@ -0,0 +1,317 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dnnl.h"
+
+#include "src/common/dnnl_thread.hpp"
+
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+
+#include "conv_stack/conv_stack.hpp"
+
+namespace conv_stack {
+
+/* src_md is the source of the convolution if it is not NULL, otherwise the
+ * source has the format any unless it is the first convolution */
+static int init_conv_desc(const prb_t *p, int l,
+        const dnnl_memory_desc_t *src_md, dnnl_convolution_desc_t &cd) {
+    const conv::desc_t &d = p->layers[l];
+    const bool is_first = l == 0;
+    const bool is_last = l == p->n_layers() - 1;
+
+    dnnl_memory_desc_t src_d, wei_d, bia_d, dst_d;
+    dnnl_dims_t src_dims = {p->mb, d.ic, d.ih, d.iw};
+    dnnl_dims_t wei_dims = {d.g, d.oc / d.g, d.ic / d.g, d.kh, d.kw};
+    dnnl_dims_t bia_dims = {d.oc};
+    dnnl_dims_t dst_dims = {p->mb, d.oc, d.oh, d.ow};
+
+    if (src_md)
+        src_d = *src_md;
+    else
+        DNN_SAFE(dnnl_memory_desc_init_by_tag(&src_d, 4, src_dims, dnnl_f32,
+                         is_first ? p->stag : dnnl_format_tag_any),
+                WARN);
+    DNN_SAFE(dnnl_memory_desc_init_by_tag(&wei_d, 4 + d.has_groups,
+                     &wei_dims[!d.has_groups], dnnl_f32, dnnl_format_tag_any),
+            WARN);
+    DNN_SAFE(dnnl_memory_desc_init_by_tag(
+                     &bia_d, 1, bia_dims, dnnl_f32, dnnl_format_tag_any),
+            WARN);
+    DNN_SAFE(dnnl_memory_desc_init_by_tag(&dst_d, 4, dst_dims, dnnl_f32,
+                     is_last ? p->dtag : dnnl_format_tag_any),
+            WARN);
+
+    auto bph = [&](int64_t ih, int64_t oh, int64_t kh, int64_t sh, int64_t ph,
+                       int64_t dh) {
+        return (oh - 1) * sh - ih + ((kh - 1) * (dh + 1) + 1) - ph;
+    };
+    dnnl_dims_t strides = {d.sh, d.sw};
+    dnnl_dims_t dilates = {d.dh, d.dw};
+    dnnl_dims_t padding = {d.ph, d.pw};
+    dnnl_dims_t padding_r = {bph(d.ih, d.oh, d.kh, d.sh, d.ph, d.dh),
+            bph(d.iw, d.ow, d.kw, d.sw, d.pw, d.dw)};
+
+    DNN_SAFE(dnnl_dilated_convolution_forward_desc_init(&cd,
+                     dnnl_forward_inference, dnnl_convolution_direct, &src_d,
+                     &wei_d, &bia_d, &dst_d, strides, dilates, padding,
+                     padding_r),
+            WARN);
+
+    return OK;
+}
+
+static int init_pd(const prb_t *p, dnnl_primitive_desc_t &spd, res_t *r) {
+    const int n = p->n_layers();
+    std::vector<dnnl_convolution_desc_t> cds(n);
+    std::vector<dnnl_primitive_attr_t> attrs(n);
+
+    for (int l = 0; l < n; ++l) {
+        SAFE(init_conv_desc(p, l, NULL, cds[l]), WARN);
+        attrs[l] = create_dnnl_attr(
+                p->attr, p->layers[l].oc, NULL, &cds[l].dst_desc);
+    }
+
+    benchdnn_timer_t t;
+    t.start();
+    dnnl_status_t init_status = dnnl_conv_stack_primitive_desc_create(&spd, n,
+            cds.data(), (const const_dnnl_primitive_attr_t *)attrs.data(),
+            NULL, engine_tgt);
+    t.stop();
+    r->create_pd_ms = t.ms();
+
+    for (auto &a : attrs)
+        dnnl_primitive_attr_destroy(a);
+
+    if (init_status == dnnl_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(spd);
+    print(5, "dnnl implementation: %s\n", impl_str);
+
+    return OK;
+}
+
+/* the convolutions executed one by one, every convolution reads the
+ * destination of the previous one as is */
+static int init_layer_pds(
+        const prb_t *p, std::vector<dnnl_primitive_desc_t> &lpds, res_t *r) {
+    const dnnl_memory_desc_t *src_md = NULL;
+    for (int l = 0; l < p->n_layers(); ++l) {
+        dnnl_convolution_desc_t cd;
+        SAFE(init_conv_desc(p, l, src_md, cd), WARN);
+
+        auto dnnl_attr = create_dnnl_attr(
+                p->attr, p->layers[l].oc, NULL, &cd.dst_desc);
+        dnnl_primitive_desc_t lpd;
+        dnnl_status_t init_status = create_primitive_desc(
+                &lpd, &cd, dnnl_attr, engine_tgt, NULL, NULL);
+        dnnl_primitive_attr_destroy(dnnl_attr);
+
+        if (init_status == dnnl_unimplemented)
+            return r->state = UNIMPLEMENTED, OK;
+        else
+            SAFE(init_status, WARN);
+
+        print(5, "layer %d: dnnl implementation: %s\n", l,
+                query_impl_info(lpd));
+
+        lpds.push_back(lpd);
+        src_md = dnnl_primitive_desc_query_md(lpd, dnnl_query_dst_md, 0);
+    }
+
+    return OK;
+}
+
+/* the values are kept small so that the activations do not grow from one
+ * convolution to the next one */
+static int fill_data(
+        int seed, float scale, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp) {
+    const auto nelems = mem_fp.nelems();
+    const int range = 16;
+
+    dnnl::impl::parallel_nd(nelems, [&](int64_t i) {
+        const float gen = ((97 * i) + 17 * seed + 101) % range;
+        mem_fp.set_elem(i, (gen - range / 2) * scale);
+    });
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const auto nelems = dt_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    // both results come from the same kernels, the accumulation order may
+    // still differ on the borders of the tiles
+    const float trh = 1e-6 * p->n_layers();
+
+    for (int64_t i = 0; i < nelems; i++) {
+        const float dt = dt_mem.get_elem(i);
+        const float fp = fp_mem.get_elem(i);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false || (!ok && (r->errors < 10 || verbose >= 10))
+                || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump)
+            print(0, "[%4ld] layers:%8g fused:%8g diff:%8g rdiff:%8g\n",
+                    (long)i, fp, dt, diff, rel_diff);
+    }
+
+    if (r->errors) r->state = FAILED;
+
+    if (r->state == UNTESTED) r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    if (bench_mode == LIST) return r->state = LISTED, OK;
+
+    const int n = p->n_layers();
+
+    dnnl_primitive_desc_t spd;
+    dnnl_primitive_t s;
+
+    SAFE(init_pd(p, spd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
+
+    std::vector<dnnl_primitive_desc_t> lpds;
+    SAFE(init_layer_pds(p, lpds, r), WARN);
+    if (r->state == UNIMPLEMENTED) {
+        DNN_SAFE(dnnl_primitive_desc_destroy(spd), CRIT);
+        for (auto &lpd : lpds)
+            DNN_SAFE(dnnl_primitive_desc_destroy(lpd), CRIT);
+        return OK;
+    }
+
+    DNN_SAFE(create_primitive(&s, spd, r), WARN);
+    std::vector<dnnl_primitive_t> lps(n);
+    for (int l = 0; l < n; ++l)
+        DNN_SAFE(create_primitive(&lps[l], lpds[l], NULL), WARN);
+
+    auto qs = [&](dnnl_query_t query, int index = 0) {
+        return *dnnl_primitive_desc_query_md(spd, query, index);
+    };
+    auto qs_arg = [&](int arg) {
+        return *dnnl_primitive_desc_query_md(spd, dnnl_query_exec_arg_md, arg);
+    };
+    auto ql = [&](int l, dnnl_query_t query, int index = 0) {
+        return *dnnl_primitive_desc_query_md(lpds[l], query, index);
+    };
+
+    const auto fp = dnnl_f32;
+    const auto tag = get_default_tag(4);
+
+    // the memory is referenced by the arguments, hence no reallocations
+    std::vector<dnn_mem_t> wei_fp, bia_fp, wei_dt, bia_dt, lwei_dt, lbia_dt,
+            ldst_dt;
+    for (auto *v : {&wei_fp, &bia_fp, &wei_dt, &bia_dt, &lwei_dt, &lbia_dt,
+                 &ldst_dt})
+        v->reserve(n);
+
+    dnn_mem_t src_fp(qs(dnnl_query_src_md), fp, tag, engine_tgt);
+    dnn_mem_t src_dt(qs(dnnl_query_src_md), engine_tgt);
+    dnn_mem_t lsrc_dt(ql(0, dnnl_query_src_md), engine_tgt);
+    dnn_mem_t dst_dt(qs(dnnl_query_dst_md), engine_tgt);
+
+    SAFE(fill_data(0, 1.f / 8, src_dt, src_fp), WARN);
+    SAFE(lsrc_dt.reorder(src_fp), WARN);
+
+    args_t args;
+    std::vector<args_t> largs(n);
+    args.set(DNNL_ARG_SRC, src_dt);
+    args.set(DNNL_ARG_DST, dst_dt);
+
+    for (int l = 0; l < n; ++l) {
+        const auto &d = p->layers[l];
+        const auto wei_md = qs_arg(DNNL_ARG_MULTIPLE_WEIGHTS + l);
+        const auto bia_md = qs_arg(DNNL_ARG_MULTIPLE_BIAS + l);
+
+        wei_fp.emplace_back(wei_md, fp, get_default_tag(4 + d.has_groups),
+                engine_tgt);
+        bia_fp.emplace_back(bia_md, fp, dnnl_x, engine_tgt);
+        wei_dt.emplace_back(wei_md, engine_tgt);
+        bia_dt.emplace_back(bia_md, engine_tgt);
+        lwei_dt.emplace_back(ql(l, dnnl_query_weights_md), engine_tgt);
+        lbia_dt.emplace_back(ql(l, dnnl_query_weights_md, 1), engine_tgt);
+        ldst_dt.emplace_back(ql(l, dnnl_query_dst_md), engine_tgt);
+
+        const float wei_scale = 1.f / (8 * (d.ic / d.g) * d.kh * d.kw);
+        SAFE(fill_data(1 + l, wei_scale, wei_dt[l], wei_fp[l]), WARN);
+        SAFE(fill_data(n + 1 + l, 1.f / 8, bia_dt[l], bia_fp[l]), WARN);
+        SAFE(lwei_dt[l].reorder(wei_fp[l]), WARN);
+        SAFE(lbia_dt[l].reorder(bia_fp[l]), WARN);
+
+        args.set(DNNL_ARG_MULTIPLE_WEIGHTS + l, wei_dt[l]);
+        args.set(DNNL_ARG_MULTIPLE_BIAS + l, bia_dt[l]);
+
+        largs[l].set(DNNL_ARG_SRC, l == 0 ? lsrc_dt : ldst_dt[l - 1]);
+        largs[l].set(DNNL_ARG_WEIGHTS, lwei_dt[l]);
+        largs[l].set(DNNL_ARG_BIAS, lbia_dt[l]);
+        largs[l].set(DNNL_ARG_DST, ldst_dt[l]);
+    }
+
+    DNN_SAFE(execute_and_wait(s, stream_tgt, args), WARN);
+
+    if (bench_mode & CORR) {
+        for (int l = 0; l < n; ++l)
+            DNN_SAFE(execute_and_wait(lps[l], stream_tgt, largs[l]), WARN);
+        dnn_mem_t dst_fp(ldst_dt[n - 1], fp, tag, engine_tgt);
+        dnn_mem_t dst(dst_dt, fp, tag, engine_tgt);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    measure_perf(r, s, args);
+
+    if (bench_mode & PERF) {
+        double layers_ms = 0;
+        for (int l = 0; l < n; ++l) {
+            res_t lr {};
+            measure_perf(&lr, lps[l], largs[l]);
+            layers_ms += lr.timer.ms();
+        }
+        print(0, "conv_stack: fused:%g layers:%g (ms)\n", r->timer.ms(),
+                layers_ms);
+    }
+
+    DNN_SAFE(dnnl_primitive_desc_destroy(spd), CRIT);
+    DNN_SAFE(dnnl_primitive_destroy(s), CRIT);
+    for (int l = 0; l < n; ++l) {
+        DNN_SAFE(dnnl_primitive_desc_destroy(lpds[l]), CRIT);
+        DNN_SAFE(dnnl_primitive_destroy(lps[l]), CRIT);
+    }
+
+    return OK;
+}
+
+} // namespace conv_stack
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CONV_STACK_HPP
+#define CONV_STACK_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dnnl.h"
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+#include "perf_report.hpp"
+
+#include "conv/conv_common.hpp"
+
+namespace conv_stack {
+
+/* canonical form of a stack: the convolutions separated by `+`, e.g.
+ * mb2ic16ih28oc32oh28kh3ph1+ic32ih28oc32oh28kh1ph0
+ * the minibatch is taken from the first convolution */
+int str2layers(std::vector<conv::desc_t> &layers, std::string &name,
+        const char *str);
+
+struct prb_t {
+    prb_t(const std::vector<conv::desc_t> &layers, const std::string &name,
+            dnnl_format_tag_t stag, dnnl_format_tag_t dtag,
+            const attr_t &attr, int64_t mb = 0)
+        : layers(layers)
+        , name(name)
+        , stag(stag)
+        , dtag(dtag)
+        , attr(attr)
+        , mb(mb ? mb : layers[0].mb)
+        , ops(0) {
+        for (auto &l : this->layers)
+            l.mb = this->mb;
+        count_ops();
+    }
+    ~prb_t() {}
+
+    std::vector<conv::desc_t> layers;
+    std::string name;
+    dnnl_format_tag_t stag, dtag;
+    attr_t attr; /* the attributes of every convolution */
+    int64_t mb;
+
+    double ops;
+
+    int n_layers() const { return (int)layers.size(); }
+    void count_ops();
+
+    BENCHDNN_DISALLOW_COPY_AND_ASSIGN(prb_t);
+};
+std::ostream &operator<<(std::ostream &s, const prb_t &p);
+
+struct perf_report_t : public base_perf_report_t {
+    using base_perf_report_t::base_perf_report_t;
+
+    void report(const prb_t *p, const res_t *r, const char *prb_str) {
+        p_ = p;
+        base_report(r, prb_str);
+    }
+
+    virtual void dump_desc_csv(std::ostream &s) const override {
+        for (int l = 0; l < p_->n_layers(); ++l) {
+            const auto &d = p_->layers[l];
+            if (l > 0) s << '+';
+            s << d.g << ',' << d.mb << ',' << d.ic << ',' << d.ih << ','
+              << d.iw << ',' << d.oc << ',' << d.oh << ',' << d.ow << ','
+              << d.kh << ',' << d.kw << ',' << d.sh << ',' << d.sw << ','
+              << d.ph << ',' << d.pw << ',' << d.dh << ',' << d.dw;
+        }
+    }
+
+    virtual double ops() const override { return p_->ops; }
+    virtual const attr_t *attr() const override { return &p_->attr; }
+    virtual const char *name() const override {
+        return p_->name.empty() ? nullptr : p_->name.c_str();
+    }
+
+private:
+    const prb_t *p_ = NULL;
+};
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern bool allow_unimpl; /* true means do not treat unimplemented as error */
+
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv);
+
+} // namespace conv_stack
+
+#endif
@@ -0,0 +1,94 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_debug.hpp"
+
+#include "conv_stack/conv_stack.hpp"
+
+namespace conv_stack {
+
+int str2layers(std::vector<conv::desc_t> &layers, std::string &name,
+        const char *str) {
+    const std::string s = str;
+    layers.clear();
+    name.clear();
+
+    size_t pos_st = 0;
+    while (true) {
+        const size_t pos_en = s.find_first_of('+', pos_st);
+        const bool is_last = pos_en == std::string::npos;
+        const std::string layer_str = s.substr(pos_st, pos_en - pos_st);
+
+        conv::desc_t d;
+        if (conv::str2desc(&d, layer_str.c_str(), false) != OK) return FAIL;
+        if (conv::is_problem_3d(&d)) return FAIL;
+        if (d.name) {
+            // the name may only follow the last convolution
+            if (!is_last) return FAIL;
+            name = d.name;
+            d.name = NULL;
+        }
+
+        if (!layers.empty()) {
+            const auto &prev = layers.back();
+            const bool chained = d.ic == prev.oc && d.ih == prev.oh
+                    && d.iw == prev.ow;
+            if (!chained) return FAIL;
+        }
+        layers.push_back(d);
+
+        if (is_last) break;
+        pos_st = pos_en + 1;
+    }
+
+    return OK;
+}
+
+void prb_t::count_ops() {
+    if (ops > 0) return;
+
+    for (const auto &d : layers) {
+        const conv::prb_t p(d, FWD_I, conv::conf_f32, dnnl_format_tag_any,
+                dnnl_format_tag_any, dnnl_format_tag_any, conv::DIRECT,
+                attr_t(), mb);
+        ops += p.ops;
+    }
+}
+
+std::ostream &operator<<(std::ostream &s, const prb_t &p) {
+    dump_global_params(s);
+
+    if (p.stag != dnnl_format_tag_any)
+        s << "--stag=" << fmt_tag2str(p.stag) << " ";
+    if (p.dtag != dnnl_format_tag_any)
+        s << "--dtag=" << fmt_tag2str(p.dtag) << " ";
+    if (!p.attr.is_def()) s << "--attr=\"" << p.attr << "\" ";
+
+    for (int l = 0; l < p.n_layers(); ++l) {
+        conv::desc_t d = p.layers[l];
+        // the minibatch is printed for the first convolution only
+        if (l > 0) {
+            s << "+";
+            d.mb = 2;
+        }
+        s << d;
+    }
+    if (!p.name.empty()) s << "n" << p.name;
+
+    return s;
+}
+
+} // namespace conv_stack
@@ -260,6 +260,10 @@ attr_t::post_ops_t::kind_t attr_t::post_ops_t::str2kind(const char *str) {
     CASE(SWISH);
     CASE(LOG);
     CASE(CLIP);
+    CASE(ADD);
+    CASE(MUL);
+    CASE(DW_K3S1P1);
+    CASE(DW_K3S2P1);
 #undef CASE
     assert(!"unknown attr::post_ops::kind");
     return KIND_TOTAL;
@@ -284,6 +288,10 @@ const char *attr_t::post_ops_t::kind2str(attr_t::post_ops_t::kind_t kind) {
     CASE(SWISH, "swish");
     CASE(LOG, "log");
     CASE(CLIP, "clip");
+    CASE(ADD, "add");
+    CASE(MUL, "mul");
+    CASE(DW_K3S1P1, "dw_k3s1p1");
+    CASE(DW_K3S2P1, "dw_k3s2p1");
 #undef CASE
     assert(!"unknown attr::post_ops::kind");
     return "unknown attr::post_ops::kind";
@@ -308,6 +316,8 @@ dnnl_alg_kind_t attr_t::post_ops_t::kind2dnnl_kind(
     CASE(SWISH, dnnl_eltwise_swish);
     CASE(LOG, dnnl_eltwise_log);
     CASE(CLIP, dnnl_eltwise_clip);
+    CASE(ADD, dnnl_binary_add);
+    CASE(MUL, dnnl_binary_mul);
 #undef CASE
     assert(!"unknown attr::post_ops::kind");
     return dnnl_alg_kind_undef;
@@ -348,6 +358,28 @@ int attr_t::post_ops_t::from_str(const char *str, const char **end_s) {
                     } else {
                         e.sum.scale = 1.f;
                     }
+                } else if (e.is_binary()) {
+                    // :policy, where policy is common or per_oc
+                    e.binary.alg = kind2dnnl_kind(k);
+                    e.binary.policy = scale_t::COMMON;
+                    if (*s == ':') {
+                        ++s;
+                        using P = scale_t::policy_t;
+                        const P policies[] = {P::COMMON, P::PER_OC};
+                        bool found = false;
+                        for (P p : policies) {
+                            const char *ps = scale_t::policy2str(p);
+                            if (!strncasecmp(ps, s, strlen(ps))) {
+                                e.binary.policy = p;
+                                s += strlen(ps);
+                                found = true;
+                                break;
+                            }
+                        }
+                        if (!found) return FAIL;
+                    }
+                } else if (e.is_depthwise_conv()) {
+                    // no parameters, the kind defines the stride
                 } else {
                     e.eltwise.alg = kind2dnnl_kind(k);
                     e.eltwise.scale = 1.f;
@@ -492,6 +524,14 @@ std::ostream &operator<<(std::ostream &s, const attr_t::post_ops_t &post_ops) {
                 else if (e.eltwise.alpha != 0.f)
                     s << ":" << e.eltwise.alpha;
                 break;
+            case pk::ADD:
+            case pk::MUL:
+                s << kind2str(e.kind);
+                if (e.binary.policy != attr_t::scale_t::COMMON)
+                    s << ":" << attr_t::scale_t::policy2str(e.binary.policy);
+                break;
+            case pk::DW_K3S1P1:
+            case pk::DW_K3S2P1: s << kind2str(e.kind); break;
             default: assert(!"unknown kind"); s << "unknown_kind";
         }
     }
@@ -556,7 +596,7 @@ int attr_bundle_t::generate(int scale_mask) {
 }
 
 dnnl_primitive_attr_t create_dnnl_attr(const attr_t &attr, int64_t scale_cnt,
-        int scale_mask, const float *scales) {
+        int scale_mask, const float *scales, const dnnl_memory_desc_t *dst_md) {
     dnnl_primitive_attr_t dnnl_attr = NULL;
     DNN_SAFE_V(dnnl_primitive_attr_create(&dnnl_attr));
 
@@ -622,6 +662,31 @@ dnnl_primitive_attr_t create_dnnl_attr(const attr_t &attr, int64_t scale_cnt,
                             e.eltwise.scale, e.eltwise.alg, e.eltwise.alpha,
                             e.eltwise.beta));
                     break;
+                case attr_t::post_ops_t::ADD:
+                case attr_t::post_ops_t::MUL: {
+                    // f32 source broadcast across all dimensions of the
+                    // destination except the channel one for per_oc
+                    SAFE_V(dst_md != NULL ? OK : FAIL);
+                    const int ndims = dst_md->ndims;
+                    dnnl_dims_t dims;
+                    for (int d = 0; d < ndims; ++d)
+                        dims[d] = 1;
+                    if (e.binary.policy == attr_t::scale_t::PER_OC)
+                        dims[1] = dst_md->dims[1];
+                    dnnl_memory_desc_t src1_md;
+                    DNN_SAFE_V(dnnl_memory_desc_init_by_tag(&src1_md, ndims,
+                            dims, dnnl_f32, get_default_tag(ndims)));
+                    DNN_SAFE_V(dnnl_post_ops_append_binary(
+                            ops, e.binary.alg, &src1_md));
+                } break;
+                case attr_t::post_ops_t::DW_K3S1P1:
+                    DNN_SAFE_V(dnnl_post_ops_append_dw_k3s1p1(
+                            ops, dnnl_f32, dnnl_f32, dnnl_f32));
+                    break;
+                case attr_t::post_ops_t::DW_K3S2P1:
+                    DNN_SAFE_V(dnnl_post_ops_append_dw_k3s2p1(
+                            ops, dnnl_f32, dnnl_f32, dnnl_f32));
+                    break;
                 default: assert(!"unknown attr::post_ops::kind");
             }
         }
@@ -713,7 +778,15 @@ float compute_eltwise_bwd(attr_t::post_ops_t::kind_t kind, float d_dst,
     return NAN;
 }
 
-void maybe_post_ops(float &d, float dst, const attr_t &attr) {
+float binary_post_op_src1_value(
+        const attr_t::post_ops_t::entry_t &e, int64_t c) {
+    // powers of 2 keep the results exact for any data type
+    if (e.binary.policy != attr_t::scale_t::PER_OC) c = 0;
+    if (e.kind == attr_t::post_ops_t::ADD) return (float)(c % 5 - 2);
+    return 0.25f * (float)(1 << (c % 4));
+}
+
+void maybe_post_ops(float &d, float dst, const attr_t &attr, int64_t c) {
     using namespace dnnl::impl::math;
 
     const auto &ops = attr.post_ops;
@@ -727,6 +800,10 @@ void maybe_post_ops(float &d, float dst, const attr_t &attr) {
 
         if (e.kind == pk::SUM)
             d += e.sum.scale * dst;
+        else if (e.kind == pk::ADD)
+            d += binary_post_op_src1_value(e, c);
+        else if (e.kind == pk::MUL)
+            d *= binary_post_op_src1_value(e, c);
         else
             d = compute_eltwise_fwd(e.kind, d, s, a, b);
     }
@@ -104,6 +104,7 @@ struct attr_t {
         bool runtime(int arg) const { return get(arg).runtime; }
 
         bool is_def() const { return points.empty(); }
+        bool is_def(int arg) const { return points.count(arg) == 0; }
 
         void set(int arg, const entry_t &entry) {
             if (entry.value != 0 || entry.runtime) points[arg] = entry;
@@ -142,6 +143,10 @@ struct attr_t {
             SWISH,
             LOG,
             CLIP,
+            ADD,
+            MUL,
+            DW_K3S1P1,
+            DW_K3S2P1,
             KIND_TOTAL
         };
         static kind_t str2kind(const char *str);
@@ -158,7 +163,16 @@ struct attr_t {
                     dnnl_alg_kind_t alg;
                     float scale, alpha, beta;
                 } eltwise;
+                struct {
+                    dnnl_alg_kind_t alg;
+                    scale_t::policy_t policy;
+                } binary;
             };
+
+            bool is_binary() const { return kind == ADD || kind == MUL; }
+            bool is_depthwise_conv() const {
+                return kind == DW_K3S1P1 || kind == DW_K3S2P1;
+            }
         };
 
         post_ops_t() : len(0) {}
@@ -226,11 +240,14 @@ private:
 std::ostream &dump_global_params(std::ostream &s);
 
 dnnl_format_tag_t get_default_tag(int ndims);
+/* dst_md is required to create the source descriptors of binary post-ops */
 dnnl_primitive_attr_t create_dnnl_attr(const attr_t &attr, int64_t scale_cnt,
-        int scale_mask, const float *scales);
-inline dnnl_primitive_attr_t create_dnnl_attr(
-        const attr_t &attr, int64_t scale_cnt, const float *scales) {
-    return create_dnnl_attr(attr, scale_cnt, -1, scales);
+        int scale_mask, const float *scales,
+        const dnnl_memory_desc_t *dst_md = NULL);
+inline dnnl_primitive_attr_t create_dnnl_attr(const attr_t &attr,
+        int64_t scale_cnt, const float *scales,
+        const dnnl_memory_desc_t *dst_md = NULL) {
+    return create_dnnl_attr(attr, scale_cnt, -1, scales, dst_md);
 }
 
 dnnl_engine_kind_t str2engine_kind(const char *str);
@@ -241,5 +258,9 @@ float compute_eltwise_fwd(attr_t::post_ops_t::kind_t kind, float src,
         float scale, float alpha, float beta);
 float compute_eltwise_bwd(attr_t::post_ops_t::kind_t kind, float d_dst,
         float src, float alpha, float beta);
-void maybe_post_ops(float &d, float dst, const attr_t &attr);
+float binary_post_op_src1_value(
+        const attr_t::post_ops_t::entry_t &e, int64_t c);
+/* c is the channel (dimension 1 of the destination) used by per_oc binary
+ * post-ops */
+void maybe_post_ops(float &d, float dst, const attr_t &attr, int64_t c = 0);
 #endif
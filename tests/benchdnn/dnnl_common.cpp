@@ -14,9 +14,25 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <string.h>
+#include <thread>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
 #include "dnnl.h"
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include <omp.h>
+#endif
+
+#include "tests/test_thread.hpp"
+
 #include "dnnl_common.hpp"
 #include "dnnl_memory.hpp"
 
@@ -29,6 +45,46 @@ dnnl_engine_t engine_tgt;
 // Stream for target engine
 dnnl_stream_t stream_tgt;
 
+// Persistent JIT kernel cache directory
+std::string jit_kernel_cache_dir;
+
+// Run the primitives through a sample threadpool (THREADPOOL runtime only)
+bool use_threadpool {true};
+
+// Balance the work of the selected primitives with the dynamic scheduler
+bool dynamic_scheduling {false};
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+static dnnl::threadpool_iface *get_benchdnn_threadpool() {
+    static dnnl::testing::threadpool_t threadpool;
+    return &threadpool;
+}
+#endif
+
+dnnl_status_t create_benchdnn_stream(dnnl_stream_t *stream,
+        dnnl_engine_t engine, dnnl::threadpool_iface *threadpool) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    dnnl_engine_kind_t kind;
+    dnnl_status_t status = dnnl_engine_get_kind(engine, &kind);
+    if (status != dnnl_success) return status;
+
+    if (use_threadpool && kind == dnnl_cpu) {
+        if (!threadpool) threadpool = get_benchdnn_threadpool();
+        dnnl_stream_attr_t attr;
+        status = dnnl_stream_attr_create(&attr, dnnl_cpu);
+        if (status != dnnl_success) return status;
+        status = dnnl_stream_attr_set_threadpool(attr, threadpool);
+        if (status == dnnl_success)
+            status = dnnl_stream_create_v2(
+                    stream, engine, dnnl_stream_default_flags, attr);
+        dnnl_stream_attr_destroy(attr);
+        return status;
+    }
+#endif
+    (void)threadpool;
+    return dnnl_stream_create(stream, engine, dnnl_stream_default_flags);
+}
+
 args_t &args_t::set(int arg, const dnn_mem_t &mem) {
     args_.push_back(std::make_pair(arg, &mem));
     return *this;
@@ -52,6 +108,120 @@ void execute_map_args(const args_t &args) {
         if (!args.dnn_mem(i).is_mapped()) args.dnn_mem(i).map();
 }
 
+// Returns the number of threads available to benchdnn
+static int get_max_threads() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    static const int max_threads = omp_get_max_threads();
+    return max_threads;
+#else
+    return MAX2(1, (int)std::thread::hardware_concurrency());
+#endif
+}
+
+// Returns the number of threads of an instance in throughput mode
+static int get_instance_threads() {
+    const int max_threads = get_max_threads();
+    if (!(bench_mode & THROUGHPUT)) return max_threads;
+    return threads_per_instance > 0
+            ? threads_per_instance
+            : MAX2(1, max_threads / MAX2(1, n_instances));
+}
+
+void set_benchdnn_threads() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    const int nthr = get_instance_threads();
+    if (omp_get_max_threads() != nthr) omp_set_num_threads(nthr);
+#endif
+}
+
+dnnl_status_t create_primitive_desc(dnnl_primitive_desc_t *pd,
+        const_dnnl_op_desc_t op_desc, const_dnnl_primitive_attr_t attr,
+        dnnl_engine_t engine, const_dnnl_primitive_desc_t hint, res_t *r) {
+    set_benchdnn_threads();
+
+    benchdnn_timer_t t;
+    t.start();
+    dnnl_status_t status
+            = dnnl_primitive_desc_create(pd, op_desc, attr, engine, hint);
+    t.stop();
+    if (r) r->create_pd_ms = t.ms();
+    return status;
+}
+
+// Creates a primitive with the persistent JIT kernel cache and reports the
+// creation time when the JIT kernels are generated (cold) and when they are
+// restored from the cache (warm).
+static dnnl_status_t create_primitive_jit_kernel_cache(
+        dnnl_primitive_t *prim, const_dnnl_primitive_desc_t pd) {
+    auto create = [&](const char *dir, double &ms) {
+        dnnl_set_jit_kernel_cache_dir(dir);
+        // the primitives created before must not be reused
+        dnnl_flush_primitive_cache();
+        benchdnn_timer_t t;
+        t.start();
+        dnnl_status_t status = dnnl_primitive_create(prim, pd);
+        t.stop();
+        ms = t.ms();
+        return status;
+    };
+
+    const char *dir = jit_kernel_cache_dir.c_str();
+    double cold_ms = 0, store_ms = 0, warm_ms = 0;
+    dnnl_status_t status = create(nullptr, cold_ms);
+    if (status != dnnl_success) return status;
+    dnnl_primitive_destroy(*prim);
+
+    // populate the cache, unless it is already populated by previous runs
+    status = create(dir, store_ms);
+    if (status != dnnl_success) return status;
+    dnnl_primitive_destroy(*prim);
+
+    status = create(dir, warm_ms);
+    if (status != dnnl_success) return status;
+
+    print(0, "create: cold:%g warm:%g (ms)\n", cold_ms, warm_ms);
+    return status;
+}
+
+dnnl_status_t create_primitive(
+        dnnl_primitive_t *prim, const_dnnl_primitive_desc_t pd, res_t *r) {
+    if (!jit_kernel_cache_dir.empty())
+        return create_primitive_jit_kernel_cache(prim, pd);
+
+    auto create = [&](double &ms, size_t &code_size) {
+        size_t code_size_start = 0;
+        dnnl_get_jit_code_size(&code_size_start);
+        benchdnn_timer_t t;
+        t.start();
+        dnnl_status_t status = dnnl_primitive_create(prim, pd);
+        t.stop();
+        ms = t.ms();
+        dnnl_get_jit_code_size(&code_size);
+        code_size -= code_size_start;
+        return status;
+    };
+
+    // in performance mode the primitive is created from scratch and then
+    // taken from the primitive cache
+    const bool measure_hit = r && (bench_mode & PERF);
+    if (measure_hit) dnnl_flush_primitive_cache();
+
+    double miss_ms = 0;
+    size_t code_size = 0;
+    dnnl_status_t status = create(miss_ms, code_size);
+    if (status != dnnl_success) return status;
+    if (!r) return status;
+    r->create_miss_ms = miss_ms;
+    r->jit_code_size = code_size;
+
+    if (measure_hit) {
+        dnnl_primitive_destroy(*prim);
+        size_t hit_code_size = 0;
+        status = create(r->create_hit_ms, hit_code_size);
+    }
+    return status;
+}
+
 dnnl_status_t execute_and_wait(
         dnnl_primitive_t prim, dnnl_stream_t stream, const args_t &args) {
 
@@ -76,13 +246,22 @@ inline bool should_stop(const benchdnn_timer_t &t) {
     return stop;
 }
 
+// The executions rotate over the sets of arguments, so the arguments of an
+// execution are not in the cache if each of them has its own copies.
+using exec_args_sets_t = std::vector<std::vector<dnnl_exec_arg_t>>;
+
+inline dnnl_status_t execute_set(
+        dnnl_primitive_t prim, exec_args_sets_t &args_sets, int i) {
+    auto &dnnl_args = args_sets[i % args_sets.size()];
+    return dnnl_primitive_execute(
+            prim, stream_tgt, (int)dnnl_args.size(), dnnl_args.data());
+}
+
 inline int measure_perf_individual(benchdnn_timer_t &t, dnnl_primitive_t prim,
-        std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        exec_args_sets_t &args_sets) {
     t.reset();
-    while (true) {
-        DNN_SAFE(dnnl_primitive_execute(prim, stream_tgt, (int)dnnl_args.size(),
-                         dnnl_args.data()),
-                WARN);
+    for (int i = 0;; i++) {
+        DNN_SAFE(execute_set(prim, args_sets, i), WARN);
         t.stamp();
         if (should_stop(t)) break;
     }
@@ -90,14 +269,13 @@ inline int measure_perf_individual(benchdnn_timer_t &t, dnnl_primitive_t prim,
 }
 
 inline int measure_perf_aggregate(benchdnn_timer_t &t, dnnl_primitive_t prim,
-        std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        exec_args_sets_t &args_sets) {
     const int max_batch_times = 10000;
+    int n_execs = 0;
 
     // Warm-up run
     t.reset();
-    DNN_SAFE(dnnl_primitive_execute(
-                     prim, stream_tgt, (int)dnnl_args.size(), dnnl_args.data()),
-            WARN);
+    DNN_SAFE(execute_set(prim, args_sets, n_execs++), WARN);
     DNN_SAFE(dnnl_stream_wait(stream_tgt), WARN);
     t.stamp();
 
@@ -107,9 +285,7 @@ inline int measure_perf_aggregate(benchdnn_timer_t &t, dnnl_primitive_t prim,
 
     while (true) {
         for (int i = 0; i < cur_batch_times; i++) {
-            DNN_SAFE(dnnl_primitive_execute(prim, stream_tgt,
-                             (int)dnnl_args.size(), dnnl_args.data()),
-                    WARN);
+            DNN_SAFE(execute_set(prim, args_sets, n_execs++), WARN);
         }
         DNN_SAFE(dnnl_stream_wait(stream_tgt), WARN);
         t.stamp(cur_batch_times);
@@ -131,18 +307,240 @@ inline int measure_perf_aggregate(benchdnn_timer_t &t, dnnl_primitive_t prim,
     return OK;
 }
 
-int measure_perf(benchdnn_timer_t &t, dnnl_primitive_t prim, args_t &args) {
+inline int measure_perf_sets(benchdnn_timer_t &t, dnnl_primitive_t prim,
+        exec_args_sets_t &args_sets) {
+    // For CPU: measure indiividual iterations
+    // For GPU: measure iterations in batches to hide driver overhead
+    if (engine_tgt_kind == dnnl_cpu)
+        return measure_perf_individual(t, prim, args_sets);
+    return measure_perf_aggregate(t, prim, args_sets);
+}
+
+static bool is_cold_cache_arg(int arg) {
+    const bool is_wei = arg >= DNNL_ARG_WEIGHTS_0 && arg <= DNNL_ARG_BIAS;
+    if (cold_cache_mode == COLD_CACHE_WEI) return is_wei;
+
+    const bool is_src = (arg >= DNNL_ARG_SRC_0 && arg < DNNL_ARG_DST_0)
+            || (arg >= DNNL_ARG_MULTIPLE_SRC && arg < DNNL_ARG_MULTIPLE_DST);
+    const bool is_diff_dst
+            = arg >= DNNL_ARG_DIFF_DST_0 && arg < DNNL_ARG_DIFF_WEIGHTS_0;
+    return cold_cache_mode == COLD_CACHE_ALL
+            && (is_wei || is_src || is_diff_dst);
+}
+
+// Returns the amount of memory the copies of the cold-cache arguments should
+// take to evict each other from the last level cache.
+static size_t cold_cache_size() {
+    size_t llc_size = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0) llc_size = (size_t)l3;
+#endif
+    // a guess of the size of an L3 cache if it is not reported
+    if (llc_size == 0) llc_size = 64 * 1024 * 1024;
+    return 2 * llc_size;
+}
+
+// Appends a set of execution arguments with the arguments selected by
+// copy_arg replaced by their copies. The copies are unmapped and must not be
+// reallocated, so the caller reserves the memory for them.
+template <typename F>
+static void add_args_set_copy(const args_t &args,
+        const std::vector<dnnl_exec_arg_t> &dnnl_args,
+        std::vector<dnn_mem_t> &copies, exec_args_sets_t &args_sets,
+        F copy_arg) {
+    args_sets.push_back(dnnl_args);
+    for (int i = 0; i < args.size(); ++i) {
+        const dnn_mem_t &mem = args.dnn_mem(i);
+        if (!copy_arg(args.arg(i)) || mem.size() == 0) continue;
+        copies.emplace_back(mem.md_, mem.engine());
+        dnn_mem_t &copy = copies.back();
+        // the values are kept to avoid slow paths on special values
+        mem.map();
+        memcpy((void *)copy, (void *)mem, mem.size());
+        mem.unmap();
+        copy.unmap();
+        args_sets.back()[i].memory = copy.m_;
+    }
+}
+
+// Creates copies of the cold-cache arguments and a set of execution arguments
+// for each copy.
+static void init_cold_cache_args_sets(const args_t &args,
+        const std::vector<dnnl_exec_arg_t> &dnnl_args,
+        std::vector<dnn_mem_t> &copies, exec_args_sets_t &args_sets) {
+    const int max_n_sets = 1024;
+
+    size_t args_size = 0;
+    for (int i = 0; i < args.size(); ++i)
+        if (is_cold_cache_arg(args.arg(i))) args_size += args.dnn_mem(i).size();
+    if (args_size == 0) {
+        args_sets.push_back(dnnl_args);
+        return;
+    }
+
+    const int64_t n_sets_needed
+            = div_up((int64_t)cold_cache_size(), (int64_t)args_size);
+    const int n_sets = (int)MIN2((int64_t)max_n_sets, MAX2(2, n_sets_needed));
+    copies.reserve(n_sets * args.size());
+    for (int n = 0; n < n_sets; ++n)
+        add_args_set_copy(
+                args, dnnl_args, copies, args_sets, is_cold_cache_arg);
+}
+
+static double now_ms() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(
+            steady_clock::now().time_since_epoch())
+            .count();
+}
+
+// Executes the primitive on n_instances threads at a time. Each instance
+// has its own primitive, hence its own scratchpad, its own stream and
+// copies of the arguments, and runs on the number of threads the primitive
+// is created for, which mimics several copies of a model served by a single
+// process. The threads of the instances are not pinned to cores.
+static int measure_throughput(res_t *r, dnnl_primitive_t prim,
+        const args_t &args, const std::vector<dnnl_exec_arg_t> &dnnl_args) {
+    const int n = MAX2(1, n_instances);
+    const int nthr = get_instance_threads();
+
+    const_dnnl_primitive_desc_t pd;
+    DNN_SAFE(dnnl_primitive_get_primitive_desc(prim, &pd), WARN);
+    std::vector<dnnl_primitive_t> prims(n, nullptr);
+    for (auto &p : prims)
+        DNN_SAFE(dnnl_primitive_create(&p, pd), WARN);
+
+    std::vector<dnn_mem_t> copies;
+    copies.reserve(n * args.size());
+    exec_args_sets_t args_sets;
+    for (int i = 0; i < n; ++i)
+        add_args_set_copy(args, dnnl_args, copies, args_sets,
+                [](int) { return true; });
+
+    struct instance_t {
+        dnnl_status_t status = dnnl_success;
+        double start_ms = 0, stop_ms = 0;
+        std::vector<double> times_ms;
+    };
+    std::vector<instance_t> instances(n);
+    std::atomic<int> n_ready(0);
+
+    auto run_instance = [&](int i) {
+        instance_t &inst = instances[i];
+        auto &a = args_sets[i];
+        dnnl_primitive_t inst_prim = prims[i];
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        omp_set_num_threads(nthr);
+#endif
+        dnnl_stream_t stream = nullptr;
+        auto execute = [&]() {
+            dnnl_status_t status = dnnl_primitive_execute(
+                    inst_prim, stream, (int)a.size(), a.data());
+            if (status != dnnl_success) return status;
+            return dnnl_stream_wait(stream);
+        };
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        // each instance runs through a threadpool of its own
+        dnnl::testing::threadpool_t threadpool(nthr);
+        inst.status = create_benchdnn_stream(&stream, engine_tgt, &threadpool);
+#else
+        inst.status = create_benchdnn_stream(&stream, engine_tgt);
+#endif
+        // the warm-up run reserves the scratchpad of the instance
+        if (inst.status == dnnl_success) inst.status = execute();
+
+        // the instances start measurements at the same time
+        ++n_ready;
+        while (n_ready < n)
+            std::this_thread::yield();
+
+        inst.start_ms = now_ms();
+        while (inst.status == dnnl_success) {
+            const double ms = now_ms();
+            inst.status = execute();
+            inst.stop_ms = now_ms();
+            inst.times_ms.push_back(inst.stop_ms - ms);
+
+            const int times = (int)inst.times_ms.size();
+            const bool stop = fix_times_per_prb
+                    ? times >= fix_times_per_prb
+                    : inst.stop_ms - inst.start_ms >= max_ms_per_prb
+                            && times >= min_times_per_prb;
+            if (stop) break;
+        }
+
+        if (stream) dnnl_stream_destroy(stream);
+        dnnl_trim_scratchpad_arena();
+    };
+
+    if (!use_scratchpad_arena) dnnl_set_scratchpad_arena_trim_threshold(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n; ++i)
+        threads.emplace_back(run_instance, i);
+    for (auto &t : threads)
+        t.join();
+    if (!use_scratchpad_arena)
+        dnnl_set_scratchpad_arena_trim_threshold(SIZE_MAX);
+    for (auto &p : prims)
+        dnnl_primitive_destroy(p);
+
+    // the memory must be mapped to be destroyed
+    for (auto &copy : copies)
+        copy.map();
+
+    std::vector<double> times_ms;
+    double start_ms = instances[0].start_ms, stop_ms = instances[0].stop_ms;
+    for (const auto &inst : instances) {
+        DNN_SAFE(inst.status, WARN);
+        times_ms.insert(
+                times_ms.end(), inst.times_ms.begin(), inst.times_ms.end());
+        start_ms = MIN2(start_ms, inst.start_ms);
+        stop_ms = MAX2(stop_ms, inst.stop_ms);
+    }
+    std::sort(times_ms.begin(), times_ms.end());
+
+    auto percentile = [&](double p) {
+        const size_t idx = (size_t)ceil(p * times_ms.size());
+        return times_ms[MAX2((size_t)1, idx) - 1];
+    };
+    double sum_ms = 0;
+    for (double ms : times_ms)
+        sum_ms += ms;
+
+    auto &thr = r->thr;
+    thr.instances = n;
+    thr.threads = nthr;
+    thr.times = (long long)times_ms.size();
+    thr.total_ms = stop_ms - start_ms;
+    thr.avg_ms = sum_ms / times_ms.size();
+    thr.p50_ms = percentile(0.5);
+    thr.p99_ms = percentile(0.99);
+    return OK;
+}
+
+int measure_perf(res_t *r, dnnl_primitive_t prim, args_t &args) {
     int ret = OK;
     if (bench_mode & PERF) {
         std::vector<dnnl_exec_arg_t> dnnl_args;
         execute_unmap_args(args, dnnl_args);
 
-        // For CPU: measure indiividual iterations
-        // For GPU: measure iterations in batches to hide driver overhead
-        if (engine_tgt_kind == dnnl_cpu)
-            ret = measure_perf_individual(t, prim, dnnl_args);
-        else
-            ret = measure_perf_aggregate(t, prim, dnnl_args);
+        exec_args_sets_t args_sets(1, dnnl_args);
+        ret = measure_perf_sets(r->timer, prim, args_sets);
+
+        if (ret == OK && cold_cache_mode != COLD_CACHE_NONE) {
+            std::vector<dnn_mem_t> copies;
+            exec_args_sets_t cold_args_sets;
+            init_cold_cache_args_sets(args, dnnl_args, copies, cold_args_sets);
+            ret = measure_perf_sets(r->cold_timer, prim, cold_args_sets);
+            // the memory must be mapped to be destroyed
+            for (auto &copy : copies)
+                copy.map();
+        }
+
+        if (ret == OK && (bench_mode & THROUGHPUT))
+            ret = measure_throughput(r, prim, args, dnnl_args);
 
         if (ret == OK) execute_map_args(args);
     }
@@ -177,6 +575,34 @@ void maybe_prepare_runtime_zero_points(dnn_mem_t &zero_points_m,
     ((int *)zero_points_m)[0] = attr.zero_points[arg];
 }
 
+void maybe_prepare_binary_post_ops(std::vector<dnn_mem_t> &binary_po_m,
+        args_t &args, const attr_t &attr, dnnl_primitive_t prim,
+        dnnl_engine_t engine) {
+    const auto &po = attr.post_ops;
+    // args keep pointers to the memories, so no reallocation is allowed
+    binary_po_m.clear();
+    binary_po_m.reserve(po.len);
+
+    const_dnnl_primitive_desc_t const_pd;
+    DNN_SAFE_V(dnnl_primitive_get_primitive_desc(prim, &const_pd));
+
+    for (int idx = 0; idx < po.len; ++idx) {
+        const auto &e = po.entry[idx];
+        if (!e.is_binary()) continue;
+
+        const int arg = DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx) | DNNL_ARG_SRC_1;
+        const auto &md = *dnnl_primitive_desc_query_md(
+                const_pd, dnnl_query_exec_arg_md, arg);
+        binary_po_m.emplace_back(md, engine);
+
+        // the source is dense and only the channel dimension may be non-1
+        auto &m = binary_po_m.back();
+        for (int64_t c = 0; c < m.nelems(); ++c)
+            m.set_elem(c, binary_post_op_src1_value(e, c));
+        args.set(arg, m);
+    }
+}
+
 bool check_md_consistency_with_tag(
         const dnnl_memory_desc_t &md, dnnl_format_tag_t tag) {
     dnnl_memory_desc_t md_new_tag;
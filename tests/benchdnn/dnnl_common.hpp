@@ -19,9 +19,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string>
 #include <vector>
 
 #include "dnnl.h"
+#include "dnnl_threadpool_iface.hpp"
 #include "src/common/bfloat16.hpp"
 #include "src/common/float16.hpp"
 #include "src/common/nstl.hpp"
@@ -173,12 +175,31 @@ extern dnnl_engine_kind_t engine_tgt_kind;
 extern dnnl_engine_t engine_tgt;
 extern dnnl_stream_t stream_tgt;
 
+/* persistent JIT kernel cache directory, empty if the cache is not used */
+extern std::string jit_kernel_cache_dir;
+
+/* run the primitives through a sample threadpool, THREADPOOL runtime only */
+extern bool use_threadpool;
+
+/* balance the work of the primitives that support it dynamically */
+extern bool dynamic_scheduling;
+
+/* creates a stream for the engine; with the THREADPOOL CPU runtime the
+ * stream runs the primitives through the threadpool, or through the sample
+ * benchdnn threadpool if it is nullptr, unless --threadpool=false */
+dnnl_status_t create_benchdnn_stream(dnnl_stream_t *stream,
+        dnnl_engine_t engine, dnnl::threadpool_iface *threadpool = nullptr);
+
+/* sets the number of threads the primitives are created and executed with,
+ * which is the number of threads of an instance in throughput mode; called
+ * before the primitive descriptors are created, once the options of the
+ * problem are parsed */
+void set_benchdnn_threads();
+
 inline int init() {
     if (!engine_tgt) {
         DNN_SAFE(dnnl_engine_create(&engine_tgt, engine_tgt_kind, 0), CRIT);
-        DNN_SAFE(dnnl_stream_create(
-                         &stream_tgt, engine_tgt, dnnl_stream_default_flags),
-                CRIT);
+        DNN_SAFE(create_benchdnn_stream(&stream_tgt, engine_tgt), CRIT);
     }
 
     return OK;
@@ -212,10 +233,18 @@ private:
     std::vector<std::pair<int, const dnn_mem_t *>> args_;
 };
 
+/* create primitive descriptors and primitives measuring the creation time
+ * into r unless it is nullptr */
+dnnl_status_t create_primitive_desc(dnnl_primitive_desc_t *pd,
+        const_dnnl_op_desc_t op_desc, const_dnnl_primitive_attr_t attr,
+        dnnl_engine_t engine, const_dnnl_primitive_desc_t hint, res_t *r);
+dnnl_status_t create_primitive(
+        dnnl_primitive_t *prim, const_dnnl_primitive_desc_t pd, res_t *r);
+
 dnnl_status_t execute_and_wait(
         dnnl_primitive_t prim, dnnl_stream_t stream, const args_t &args);
 
-int measure_perf(benchdnn_timer_t &t, dnnl_primitive_t prim, args_t &args);
+int measure_perf(res_t *r, dnnl_primitive_t prim, args_t &args);
 
 void maybe_prepare_runtime_scales(dnn_mem_t &scales_m, const attr_t &attr,
         int64_t scale_cnt, const float *scales, dnnl_engine_t engine);
@@ -225,6 +254,12 @@ void maybe_prepare_runtime_scales(dnn_mem_t &scales_m,
 void maybe_prepare_runtime_zero_points(dnn_mem_t &zero_points_m,
         const attr_t &attr, int arg, dnnl_engine_t engine);
 
+/* creates and fills the source memories of binary post-ops and sets them as
+ * arguments of prim */
+void maybe_prepare_binary_post_ops(std::vector<dnn_mem_t> &binary_po_m,
+        args_t &args, const attr_t &attr, dnnl_primitive_t prim,
+        dnnl_engine_t engine);
+
 bool check_md_consistency_with_tag(
         const dnnl_memory_desc_t &md, dnnl_format_tag_t tag);
 
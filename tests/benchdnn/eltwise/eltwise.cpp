@@ -59,7 +59,7 @@ static int init_pd(const prb_t *p, dnnl_eltwise_desc_t &ed,
     }
 
     dnnl_status_t init_status
-            = dnnl_primitive_desc_create(&epd, &ed, NULL, engine_tgt, NULL);
+            = create_primitive_desc(&epd, &ed, NULL, engine_tgt, NULL, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -291,7 +291,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, ed, epd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&e, epd), WARN);
+    DNN_SAFE(create_primitive(&e, epd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(epd), CRIT);
 
     const auto fp = dnnl_f32;
@@ -359,7 +359,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, e, args);
+    measure_perf(r, e, args);
 
     DNN_SAFE(dnnl_primitive_destroy(e), CRIT);
 
@@ -100,11 +100,12 @@ inline int init_pd(const prb_t *p, dnnl_inner_product_desc_t &ipd,
                                                    : dnnl_unimplemented,
             CRIT);
 
-    auto dnnl_attr = create_dnnl_attr(p->attr, p->oc, p->scales);
+    auto dnnl_attr
+            = create_dnnl_attr(p->attr, p->oc, p->scales, &ipd.dst_desc);
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(
-            &ippd, &ipd, dnnl_attr, engine_tgt, NULL);
+    init_status = create_primitive_desc(
+            &ippd, &ipd, dnnl_attr, engine_tgt, NULL, r);
 
     dnnl_primitive_attr_destroy(dnnl_attr);
 
@@ -238,7 +239,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, ipd, ippd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&ip, ippd), WARN);
+    DNN_SAFE(create_primitive(&ip, ippd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(ippd), CRIT);
 
     auto &src_dt_d = p->dir == BWD_D ? ipd.diff_src_desc : ipd.src_desc;
@@ -273,12 +274,15 @@ int doit(const prb_t *p, res_t *r) {
     if (p->dir & FLAG_BIA) SAFE(fill_data(BIA, p, bia_dt, bia_fp, r), WARN);
 
     args_t args;
+    std::vector<dnn_mem_t> binary_po_m;
 
     if (p->dir & FLAG_FWD) {
         args.set(DNNL_ARG_SRC, src_dt);
         args.set(DNNL_ARG_WEIGHTS, wei_dt);
         if (p->dir & FLAG_BIA) args.set(DNNL_ARG_BIAS, bia_dt);
         args.set(DNNL_ARG_DST, dst_dt);
+        maybe_prepare_binary_post_ops(
+                binary_po_m, args, p->attr, ip, engine_tgt);
         DNN_SAFE(execute_and_wait(ip, stream_tgt, args), WARN);
         if (bench_mode & CORR) {
             compute_ref_fwd(p, src_fp, wei_fp, bia_fp, dst_fp);
@@ -316,7 +320,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, ip, args);
+    measure_perf(r, ip, args);
 
     DNN_SAFE(dnnl_primitive_destroy(ip), CRIT);
 
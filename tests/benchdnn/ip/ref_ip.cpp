@@ -42,7 +42,7 @@ void compute_ref_fwd(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &wei_m,
             d += ((float *)bia_m)[bia_off];
         }
         maybe_scale(d, p->scales, oc, p->attr);
-        maybe_post_ops(d, dst, p->attr);
+        maybe_post_ops(d, dst, p->attr, oc);
         dst = d;
     });
 }
@@ -423,8 +423,8 @@ static int init_pd(const prb_t *p, dnnl_layer_normalization_desc_t &ld,
             SAFE(init_fwd_status, WARN);
     }
     auto dnnl_attr = create_dnnl_attr(p->attr, 1, NULL);
-    dnnl_status_t init_status = dnnl_primitive_desc_create(
-            &lpd, &ld, dnnl_attr, engine_tgt, hint_fwd_pd);
+    dnnl_status_t init_status = create_primitive_desc(
+            &lpd, &ld, dnnl_attr, engine_tgt, hint_fwd_pd, r);
 
     dnnl_primitive_desc_destroy(hint_fwd_pd);
     dnnl_primitive_attr_destroy(dnnl_attr);
@@ -496,7 +496,7 @@ int doit(const prb_t *p, res_t *r) {
     dnn_mem_t d_ss_fp(2, dims2d, fp, dnnl_nc, engine_tgt),
             d_ss_dt(d_ss_fp.md_, engine_tgt);
 
-    DNN_SAFE(dnnl_primitive_create(&b, lpd), WARN);
+    DNN_SAFE(create_primitive(&b, lpd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(lpd), CRIT);
 
     args_t args;
@@ -583,7 +583,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, b, args);
+    measure_perf(r, b, args);
 
     DNN_SAFE(dnnl_primitive_destroy(b), CRIT);
 
@@ -136,7 +136,7 @@ int init_pd(const prb_t *p, dir_t dir, dnnl_lrn_desc_t &ld,
     }
 
     dnnl_status_t init_status
-            = dnnl_primitive_desc_create(&lpd, &ld, NULL, engine_tgt, hint);
+            = create_primitive_desc(&lpd, &ld, NULL, engine_tgt, hint, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -185,7 +185,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    DNN_SAFE(dnnl_primitive_create(&lf, lfpd), WARN);
+    DNN_SAFE(create_primitive(&lf, lfpd, r), WARN);
 
     const auto &data_desc
             = *dnnl_primitive_desc_query_md(lfpd, dnnl_query_src_md, 0);
@@ -225,7 +225,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(init_pd_bwd(p, lbd, lbpd, lfpd, r), WARN);
         if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-        DNN_SAFE(dnnl_primitive_create(&lb, lbpd), WARN);
+        DNN_SAFE(create_primitive(&lb, lbpd, r), WARN);
         DNN_SAFE(dnnl_primitive_desc_destroy(lbpd), CRIT);
 
         const_dnnl_primitive_desc_t const_lbpd;
@@ -258,7 +258,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, l, args);
+    measure_perf(r, l, args);
 
     DNN_SAFE(dnnl_primitive_desc_destroy(lfpd), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(lf), CRIT);
@@ -31,15 +31,23 @@
 
 namespace matmul {
 
-std::vector<const dt_conf_t *> cfg;
-std::vector<dnnl_format_tag_t> stag, wtag, dtag;
-std::vector<int64_t> ld_src, ld_wei, ld_dst;
-std::vector<bool> runtime_mb, runtime_m, runtime_n, runtime_k;
-std::vector<dnnl_data_type_t> bia_dt;
-std::vector<int> bia_mask;
+std::vector<const dt_conf_t *> cfg {defaults::cfg};
+std::vector<dnnl_format_tag_t> stag {defaults::tag};
+std::vector<dnnl_format_tag_t> wtag {defaults::tag};
+std::vector<dnnl_format_tag_t> dtag {defaults::tag};
+std::vector<int64_t> ld_src {defaults::ld};
+std::vector<int64_t> ld_wei {defaults::ld};
+std::vector<int64_t> ld_dst {defaults::ld};
+std::vector<bool> runtime_mb {defaults::runtime_val};
+std::vector<bool> runtime_m {defaults::runtime_val};
+std::vector<bool> runtime_n {defaults::runtime_val};
+std::vector<bool> runtime_k {defaults::runtime_val};
+std::vector<dnnl_data_type_t> bia_dt {defaults::bia_dt};
+std::vector<int> bia_mask {defaults::bia_mask};
+std::vector<bcast_t> bcast {defaults::bcast};
 
 attr_t attr;
-bool allow_unimpl;
+bool allow_unimpl = false;
 const char *skip_impl = "";
 const char *perf_template_csv
         = "perf,%engine%,%name%,%cfg%,%attr%,%DESC%,"
@@ -63,6 +71,7 @@ void reset_parameters() {
     runtime_k = {defaults::runtime_val};
     bia_dt = {defaults::bia_dt};
     bia_mask = {defaults::bia_mask};
+    bcast = {defaults::bcast};
     attr = attr_t();
     allow_unimpl = false;
     skip_impl = "";
@@ -91,10 +100,11 @@ void check_correctness(const desc_t *c) {
     for_(const auto &i_runtime_n : runtime_n)
     for_(const auto &i_runtime_k : runtime_k)
     for_(const auto &i_bia_cfg : bia_cfg)
+    for_(const auto &i_bcast : bcast)
     {
         const prb_t p(*c, i_cfg, i_stag, i_wtag, i_dtag, i_ld_src, i_ld_wei,
                 i_ld_dst, i_runtime_mb, i_runtime_m, i_runtime_n, i_runtime_k,
-                i_bia_cfg.first, i_bia_cfg.second, attr);
+                i_bia_cfg.first, i_bia_cfg.second, i_bcast, attr);
         std::stringstream ss;
         ss << p;
         const std::string cpp_pstr = ss.str();
@@ -118,7 +128,6 @@ void check_correctness(const desc_t *c) {
 
 int bench(int argc, char **argv) {
     driver_name = "matmul";
-    reset_parameters();
 
     using namespace parser;
     for (; argc > 0; --argc, ++argv) {
@@ -141,6 +150,7 @@ int bench(int argc, char **argv) {
                         runtime_k, str2bool, argv[0], "runtime_k")
                 || parse_dt(bia_dt, argv[0], "bia_dt")
                 || parse_vector_option(bia_mask, atoi, argv[0], "bia_mask")
+                || parse_vector_option(bcast, str2bcast, argv[0], "bcast")
                 || parse_attr(attr, argv[0])
                 || parse_allow_unimpl(allow_unimpl, argv[0])
                 || parse_skip_impl(skip_impl, argv[0])
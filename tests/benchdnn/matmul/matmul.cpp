@@ -47,7 +47,11 @@ int init_pd(const prb_t *p, dnnl_primitive_desc_t &matmul_pd, res_t *r) {
     src_dims[0 + (p->ndims == 3)] = dst_dims[0 + (p->ndims == 3)] = M;
     src_dims[1 + (p->ndims == 3)] = wei_dims[0 + (p->ndims == 3)] = K;
     wei_dims[1 + (p->ndims == 3)] = dst_dims[1 + (p->ndims == 3)] = N;
-    if (p->ndims == 3) src_dims[0] = wei_dims[0] = dst_dims[0] = MB;
+    if (p->ndims == 3) {
+        src_dims[0] = p->bcast == BCAST_SRC ? 1 : MB;
+        wei_dims[0] = p->bcast == BCAST_WEI ? 1 : MB;
+        dst_dims[0] = MB;
+    }
 
     prep_bia_dims(p, bia_dims, dst_dims);
 
@@ -73,11 +77,11 @@ int init_pd(const prb_t *p, dnnl_primitive_desc_t &matmul_pd, res_t *r) {
                                                     : dnnl_unimplemented,
             CRIT);
 
-    auto dnnl_attr = create_dnnl_attr(p->attr, p->n, p->scales);
+    auto dnnl_attr = create_dnnl_attr(p->attr, p->n, p->scales, &dst_d);
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(
-            &matmul_pd, &op_d, dnnl_attr, engine_tgt, NULL);
+    init_status = create_primitive_desc(
+            &matmul_pd, &op_d, dnnl_attr, engine_tgt, NULL, r);
     dnnl_primitive_attr_destroy(dnnl_attr);
 
     if (init_status == dnnl_unimplemented)
@@ -202,7 +206,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(init_pd(p, matmul_pd, r), WARN);
         if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-        DNN_SAFE(dnnl_primitive_create(&matmul, matmul_pd), WARN);
+        DNN_SAFE(create_primitive(&matmul, matmul_pd, r), WARN);
         DNN_SAFE(dnnl_primitive_desc_destroy(matmul_pd), CRIT);
     }
 
@@ -225,7 +229,7 @@ int doit(const prb_t *p, res_t *r) {
     if (p->runtime_mb || p->runtime_m || p->runtime_k) {
         src_dt_d.dims[0 + (p->ndims == 3)] = p->m;
         src_dt_d.dims[1 + (p->ndims == 3)] = p->k;
-        if (p->ndims == 3) src_dt_d.dims[0] = p->mb;
+        if (p->ndims == 3) src_dt_d.dims[0] = p->src_mb();
         src_dt = dnn_mem_t(
                 p->ndims, src_dt_d.dims, p->cfg[SRC].dt, p->stag, engine_tgt);
     } else {
@@ -234,7 +238,7 @@ int doit(const prb_t *p, res_t *r) {
     if (p->runtime_mb || p->runtime_k || p->runtime_n) {
         wei_dt_d.dims[0 + (p->ndims == 3)] = p->k;
         wei_dt_d.dims[1 + (p->ndims == 3)] = p->n;
-        if (p->ndims == 3) wei_dt_d.dims[0] = p->mb;
+        if (p->ndims == 3) wei_dt_d.dims[0] = p->wei_mb();
         wei_dt = dnn_mem_t(
                 p->ndims, wei_dt_d.dims, p->cfg[WEI].dt, p->wtag, engine_tgt);
     } else {
@@ -292,6 +296,9 @@ int doit(const prb_t *p, res_t *r) {
     args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_SRC, src_zero_points_m);
     args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, wei_zero_points_m);
     args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_DST, dst_zero_points_m);
+    std::vector<dnn_mem_t> binary_po_m;
+    maybe_prepare_binary_post_ops(
+            binary_po_m, args, p->attr, matmul, engine_tgt);
     DNN_SAFE(execute_and_wait(matmul, stream_tgt, args), WARN);
 
     if (bench_mode & CORR) {
@@ -300,7 +307,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare_dat(p, DST, c, dst_fp, r), WARN);
     }
 
-    measure_perf(r->timer, matmul, args);
+    measure_perf(r, matmul, args);
 
     DNN_SAFE(dnnl_primitive_destroy(matmul), CRIT);
 
@@ -47,6 +47,11 @@ extern const _dt_conf_t conf_bf16bf16bf16;
 extern const _dt_conf_t conf_f32bf16bf16;
 extern const _dt_conf_t conf_bf16f32bf16;
 
+// the operand which batch is broadcast
+enum bcast_t { BCAST_NONE, BCAST_SRC, BCAST_WEI };
+bcast_t str2bcast(const char *str);
+const char *bcast2str(bcast_t bcast);
+
 const int64_t LD_GOOD = INT64_MAX;
 const int64_t LD_NONE = INT64_MAX - 1;
 
@@ -58,6 +63,7 @@ const int64_t ld = LD_NONE;
 const bool runtime_val = false;
 const dnnl_data_type_t bia_dt = dnnl_data_type_undef;
 const int bia_mask = 2;
+const bcast_t bcast = BCAST_NONE;
 } // namespace defaults
 
 struct desc_t {
@@ -74,7 +80,7 @@ struct prb_t : public desc_t {
             dnnl_format_tag_t wtag, dnnl_format_tag_t dtag, int64_t ld_src,
             int64_t ld_wei, int64_t ld_dst, bool runtime_mb, bool runtime_m,
             bool runtime_n, bool runtime_k, dnnl_data_type_t bia_dt,
-            int bia_mask, const attr_t &attr)
+            int bia_mask, bcast_t bcast, const attr_t &attr)
         : desc_t(desc)
         , cfg(cfg)
         , stag(stag)
@@ -89,6 +95,7 @@ struct prb_t : public desc_t {
         , runtime_k(runtime_k)
         , bia_dt(bia_dt)
         , bia_mask(bia_mask)
+        , bcast(ndims == 3 ? bcast : BCAST_NONE)
         , attr(attr)
         , ops(2. * mb * m * n * k)
         , scales(NULL) {
@@ -105,6 +112,7 @@ struct prb_t : public desc_t {
     bool runtime_mb, runtime_m, runtime_n, runtime_k;
     dnnl_data_type_t bia_dt;
     int bia_mask;
+    bcast_t bcast;
 
     attr_t attr;
 
@@ -113,6 +121,9 @@ struct prb_t : public desc_t {
 
     void generate_oscales();
 
+    int64_t src_mb() const { return bcast == BCAST_SRC ? 1 : mb; }
+    int64_t wei_mb() const { return bcast == BCAST_WEI ? 1 : mb; }
+
     BENCHDNN_DISALLOW_COPY_AND_ASSIGN(prb_t);
 };
 std::ostream &operator<<(std::ostream &s, const prb_t &p);
@@ -149,10 +160,12 @@ private:
 };
 
 inline int64_t src_off_f(const prb_t *p, int64_t mb, int64_t m, int64_t k) {
+    if (p->bcast == BCAST_SRC) mb = 0;
     return (mb * p->m + m) * p->k + k;
 }
 
 inline int64_t wei_off_f(const prb_t *p, int64_t mb, int64_t k, int64_t n) {
+    if (p->bcast == BCAST_WEI) mb = 0;
     return (mb * p->k + k) * p->n + n;
 }
 
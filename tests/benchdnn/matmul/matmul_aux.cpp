@@ -125,6 +125,26 @@ int str2desc(desc_t *desc, const char *str) {
     return OK;
 }
 
+bcast_t str2bcast(const char *str) {
+#define CASE(_bcast, _str) \
+    if (!strcasecmp(_str, str)) return _bcast
+    CASE(BCAST_NONE, "none");
+    CASE(BCAST_SRC, "src");
+    CASE(BCAST_WEI, "wei");
+#undef CASE
+    assert(!"unknown broadcast");
+    return BCAST_NONE;
+}
+
+const char *bcast2str(bcast_t bcast) {
+    switch (bcast) {
+        case BCAST_NONE: return "none";
+        case BCAST_SRC: return "src";
+        case BCAST_WEI: return "wei";
+        default: assert(!"unknown broadcast"); return "unknown broadcast";
+    }
+}
+
 std::ostream &operator<<(std::ostream &s, const desc_t &d) {
     if (d.ndims == 3) s << "mb" << d.mb;
     s << "m" << d.m << "n" << d.n << "k" << d.k;
@@ -162,6 +182,9 @@ std::ostream &operator<<(std::ostream &s, const prb_t &p) {
             s << "--bia_mask=" << p.bia_mask << " ";
     }
 
+    if (p.bcast != defaults::bcast)
+        s << "--bcast=" << bcast2str(p.bcast) << " ";
+
     if (!p.attr.is_def()) s << "--attr=\"" << p.attr << "\" ";
 
     s << static_cast<const desc_t &>(p);
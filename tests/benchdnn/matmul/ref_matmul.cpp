@@ -56,7 +56,7 @@ void compute_ref(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &wei_m,
             tmp += bia_ptr[wei_off];
         }
         maybe_scale(tmp, p->scales, n, p->attr);
-        maybe_post_ops(tmp, dst, p->attr);
+        maybe_post_ops(tmp, dst, p->attr, p->ndims == 3 ? m : n);
         tmp += dst_zero_point;
         dst = tmp;
     });
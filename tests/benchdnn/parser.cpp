@@ -214,6 +214,12 @@ static bool parse_bench_mode(
             bench_mode, str2bench_mode, str, option_name);
 }
 
+static bool parse_cold_cache(
+        const char *str, const std::string &option_name = "cold-cache") {
+    return parse_single_value_option(
+            cold_cache_mode, str2cold_cache_mode, str, option_name);
+}
+
 static bool parse_max_ms_per_prb(
         const char *str, const std::string &option_name = "max-ms-per-prb") {
     if (parse_single_value_option(max_ms_per_prb, atof, str, option_name)) {
@@ -235,6 +241,31 @@ static bool parse_fix_times_per_prb(
     return false;
 }
 
+static bool parse_instances(
+        const char *str, const std::string &option_name = "instances") {
+    if (parse_single_value_option(n_instances, atoi, str, option_name)) {
+        if (n_instances < 1) n_instances = 1;
+        return true;
+    }
+    return false;
+}
+
+static bool parse_threads_per_instance(const char *str,
+        const std::string &option_name = "threads-per-instance") {
+    if (parse_single_value_option(
+                threads_per_instance, atoi, str, option_name)) {
+        if (threads_per_instance < 0) threads_per_instance = 0;
+        return true;
+    }
+    return false;
+}
+
+static bool parse_scratchpad_arena(
+        const char *str, const std::string &option_name = "scratchpad-arena") {
+    return parse_single_value_option(
+            use_scratchpad_arena, str2bool, str, option_name);
+}
+
 static bool parse_verbose(
         const char *str, const std::string &option_name = "verbose") {
     const std::string pattern = "-v"; // check short option first
@@ -254,8 +285,38 @@ static bool parse_engine_kind(
         DNN_SAFE(dnnl_engine_destroy(engine_tgt), CRIT);
 
         DNN_SAFE(dnnl_engine_create(&engine_tgt, engine_tgt_kind, 0), CRIT);
-        DNN_SAFE(dnnl_stream_create(
-                         &stream_tgt, engine_tgt, dnnl_stream_default_flags),
+        DNN_SAFE(create_benchdnn_stream(&stream_tgt, engine_tgt), CRIT);
+        return true;
+    }
+    return false;
+}
+
+static bool parse_threadpool(
+        const char *str, const std::string &option_name = "threadpool") {
+    if (parse_single_value_option(use_threadpool, str2bool, str, option_name)) {
+        DNN_SAFE(dnnl_stream_destroy(stream_tgt), CRIT);
+        DNN_SAFE(create_benchdnn_stream(&stream_tgt, engine_tgt), CRIT);
+        return true;
+    }
+    return false;
+}
+
+static bool parse_dynamic_scheduling(const char *str,
+        const std::string &option_name = "dynamic-scheduling") {
+    if (parse_single_value_option(
+                dynamic_scheduling, str2bool, str, option_name)) {
+        DNN_SAFE(dnnl_set_dynamic_scheduling(dynamic_scheduling), CRIT);
+        return true;
+    }
+    return false;
+}
+
+static bool parse_jit_kernel_cache(const char *str,
+        const std::string &option_name = "jit-kernel-cache") {
+    const std::string pattern = get_pattern(option_name);
+    if (pattern.find(str, 0, pattern.size()) != eol) {
+        jit_kernel_cache_dir = str + pattern.size();
+        DNN_SAFE(dnnl_set_jit_kernel_cache_dir(jit_kernel_cache_dir.c_str()),
                 CRIT);
         return true;
     }
@@ -267,16 +328,30 @@ bool parse_bench_settings(const char *str) {
 
     if (parse_bench_mode(str))
         ;
+    else if (parse_cold_cache(str))
+        ;
     else if (parse_max_ms_per_prb(str))
         ;
     else if (parse_fix_times_per_prb(str))
         ;
+    else if (parse_instances(str))
+        ;
+    else if (parse_threads_per_instance(str))
+        ;
+    else if (parse_scratchpad_arena(str))
+        ;
     else if (parse_verbose(str))
         ;
     else if (parse_engine_kind(str))
         ;
+    else if (parse_threadpool(str))
+        ;
+    else if (parse_dynamic_scheduling(str))
+        ;
     else if (parse_fast_ref_gpu(str))
         ;
+    else if (parse_jit_kernel_cache(str))
+        ;
     else
         return false;
     return true;
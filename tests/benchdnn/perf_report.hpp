@@ -35,7 +35,6 @@ struct base_perf_report_t {
 
     void handle_option(std::ostream &s, const char *&option, const res_t *r,
             const char *prb_str) const {
-        const auto &t = r->timer;
         benchdnn_timer_t::mode_t mode = benchdnn_timer_t::min;
         (void)mode;
         double unit = 1e0;
@@ -51,6 +50,11 @@ struct base_perf_report_t {
             c = *(++option);
         }
 
+        // the measurements with --cold-cache
+        const bool cold = !strncmp("cold_", option, strlen("cold_"));
+        if (cold) option += strlen("cold_");
+        const auto &t = cold ? r->cold_timer : r->timer;
+
 #define HANDLE(opt, ...) \
     if (!strncmp(opt "%", option, strlen(opt) + 1)) { \
         __VA_ARGS__; \
@@ -70,6 +74,17 @@ struct base_perf_report_t {
             return t.ticks(mode) / t.sec(mode) / unit;
         };
 
+        // the measurements with --mode=throughput
+        const auto &thr = r->thr;
+        auto get_thr_execs = [&]() -> double {
+            if (!thr.total_ms) return 0;
+            return thr.times / (thr.total_ms / 1e3) / unit;
+        };
+        auto get_thr_slowdown = [&]() -> double {
+            if (!r->timer.ms(benchdnn_timer_t::avg)) return 0;
+            return thr.avg_ms / r->timer.ms(benchdnn_timer_t::avg);
+        };
+
         HANDLE("alg", dump_alg(s));
         HANDLE("cfg", dump_cfg(s));
         HANDLE("DESC", dump_desc_csv(s));
@@ -94,12 +109,24 @@ struct base_perf_report_t {
         HANDLE("bw", s << get_bw());
         HANDLE("flops", s << get_flops());
         HANDLE("clocks", s << t.ticks(mode) / unit);
+        HANDLE("create_hit", s << r->create_hit_ms / unit);
+        HANDLE("create_miss", s << r->create_miss_ms / unit);
+        HANDLE("create_pd", s << r->create_pd_ms / unit);
         HANDLE("desc", s << prb_str);
         HANDLE("engine", s << engine_kind2str(engine_tgt_kind));
         HANDLE("freq", s << get_freq());
+        HANDLE("jit_size", s << r->jit_code_size / unit);
         HANDLE("ops", s << ops() / unit);
         HANDLE("time", s << t.ms(mode) / unit);
 
+        HANDLE("thr_execs", s << get_thr_execs());
+        HANDLE("thr_flops", s << get_thr_execs() * ops());
+        HANDLE("thr_instances", s << thr.instances);
+        HANDLE("thr_p50", s << thr.p50_ms / unit);
+        HANDLE("thr_p99", s << thr.p99_ms / unit);
+        HANDLE("thr_slowdown", s << get_thr_slowdown());
+        HANDLE("thr_threads", s << thr.threads);
+
 #undef HANDLE
 
         SAFE_V(FAIL);
@@ -110,15 +137,18 @@ struct base_perf_report_t {
 
         std::stringstream ss;
 
-        const char *pt = pt_;
-        char c;
-        while ((c = *pt++) != '\0') {
-            if (c != '%') {
-                ss << c;
-                continue;
+        auto handle_template = [&](const char *pt) {
+            char c;
+            while ((c = *pt++) != '\0') {
+                if (c != '%') {
+                    ss << c;
+                    continue;
+                }
+                handle_option(ss, pt, r, prb_str);
             }
-            handle_option(ss, pt, r, prb_str);
-        }
+        };
+        handle_template(pt_);
+        handle_template(suffix().c_str());
 
         std::string str = ss.str();
         print(0, "%s\n", str.c_str());
@@ -153,10 +183,22 @@ struct base_perf_report_t {
 private:
     const char *pt_;
 
+    // the cold-cache and throughput numbers follow the others unless the
+    // template places them itself
+    std::string suffix() const {
+        std::string s;
+        if (cold_cache_mode != COLD_CACHE_NONE && !strstr(pt_, "cold_"))
+            s += ",%-cold_time%,%0cold_time%";
+        if ((bench_mode & THROUGHPUT) && !strstr(pt_, "thr_"))
+            s += ",%thr_instances%,%thr_threads%,%Gthr_flops%,%thr_p50%,"
+                 "%thr_p99%,%thr_slowdown%";
+        return s;
+    }
+
     void dump_perf_footer() const {
         static bool footer_printed = false;
         if (!footer_printed) {
-            print(0, "Output template: %s\n", pt_);
+            print(0, "Output template: %s%s\n", pt_, suffix().c_str());
             footer_printed = true;
         }
     }
@@ -196,7 +196,7 @@ int init_pd(const prb_t *p, dir_t dir, dnnl_primitive_desc_t &ppd,
     }
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(&ppd, &pd, NULL, engine_tgt, hint);
+    init_status = create_primitive_desc(&ppd, &pd, NULL, engine_tgt, hint, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -233,7 +233,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd_fwd(p, pfpd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) { return OK; }
 
-    DNN_SAFE(dnnl_primitive_create(&pf, pfpd), WARN);
+    DNN_SAFE(create_primitive(&pf, pfpd, r), WARN);
 
     auto q_md = [](const_dnnl_primitive_desc_t pd, dnnl_query_t what) {
         const dnnl_memory_desc_t *md
@@ -291,7 +291,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(init_pd_bwd(p, pbpd, pfpd, r), WARN);
         if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-        DNN_SAFE(dnnl_primitive_create(&pb, pbpd), WARN);
+        DNN_SAFE(create_primitive(&pb, pbpd, r), WARN);
         DNN_SAFE(dnnl_primitive_desc_destroy(pbpd), CRIT);
 
         const_dnnl_primitive_desc_t const_pbpd;
@@ -323,7 +323,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, pl, args);
+    measure_perf(r, pl, args);
 
     DNN_SAFE(dnnl_primitive_desc_destroy(pfpd), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(pf), CRIT);
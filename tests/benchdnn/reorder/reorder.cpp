@@ -307,6 +307,7 @@ int doit(const prb_t *p, res_t *r) {
     dnnl_memory_desc_t src_md, dst_md;
     DNN_SAFE(maybe_runtime_md(p, SRC, src_dt_in_fmt_in.md_, src_md), WARN);
     DNN_SAFE(maybe_runtime_md(p, DST, dst_dt_out_fmt_out.md_, dst_md), WARN);
+    set_benchdnn_threads();
     dnnl_status_t init_status = dnnl_reorder_primitive_desc_create(&rpd,
             &src_md, engine_tgt, &dst_md, engine_tgt, attr_bundle.dnnl_attr());
     if (init_status == dnnl_unimplemented) {
@@ -319,7 +320,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_status, WARN);
 
     dnnl_primitive_t rp = NULL;
-    DNN_SAFE(dnnl_primitive_create(&rp, rpd), WARN);
+    DNN_SAFE(create_primitive(&rp, rpd, r), WARN);
     dnnl_primitive_desc_destroy(rpd);
 
     /* Step 4: fill input memory */
@@ -386,7 +387,7 @@ int doit(const prb_t *p, res_t *r) {
     }
 
     /* Step 7: performance measurement */
-    measure_perf(r->timer, rp, args);
+    measure_perf(r, rp, args);
 
     DNN_SAFE_V(dnnl_primitive_destroy(rp));
 
@@ -170,7 +170,7 @@ int init_pd(const prb_t *p, dnnl_primitive_desc_t &rpd, res_t *r) {
     }
 
     dnnl_status_t init_status = dnnl_success;
-    init_status = dnnl_primitive_desc_create(&rpd, &pd, NULL, engine_tgt, hint);
+    init_status = create_primitive_desc(&rpd, &pd, NULL, engine_tgt, hint, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -198,7 +198,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, rpd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) { return OK; }
 
-    DNN_SAFE(dnnl_primitive_create(&rp, rpd), WARN);
+    DNN_SAFE(create_primitive(&rp, rpd, r), WARN);
 
     auto q_md = [](const_dnnl_primitive_desc_t pd, dnnl_query_t what) {
         const dnnl_memory_desc_t *md
@@ -252,7 +252,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, rp, args);
+    measure_perf(r, rp, args);
 
     DNN_SAFE(dnnl_primitive_destroy(rp), CRIT);
     DNN_SAFE(dnnl_primitive_desc_destroy(rpd), CRIT);
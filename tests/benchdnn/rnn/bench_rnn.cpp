@@ -38,6 +38,7 @@ std::vector<activation_t> activation {RELU};
 std::vector<bool> skip_nonlinear {false};
 std::vector<int64_t> mb {0};
 std::vector<policy_t> scale_policy {policy_t::NONE};
+std::vector<bool> var_len {false};
 
 attr_t attr;
 bool allow_unimpl = false;
@@ -61,6 +62,7 @@ void reset_parameters() {
     mb = {0};
     attr = attr_t();
     scale_policy = {policy_t::NONE};
+    var_len = {false};
     allow_unimpl = false;
 }
 
@@ -72,12 +74,15 @@ void check_correctness(const desc_t *c) {
     for_(const auto &i_direction : direction)
     for_(const auto &i_activation : activation)
     for_(const auto &i_skip_nonlinear : skip_nonlinear)
+    for_(const auto &i_var_len : var_len)
     for (const auto &i_mb : mb) {
         check_case_validity(i_cfg, i_scale_policy);
         dnnl_prop_kind_t prop_kind = prop2prop_kind(i_prop);
+        const unsigned int i_flags = flags
+                | (i_var_len ? dnnl_rnn_flags_variable_length : 0x0U);
 
         const prb_t p(*c, i_cfg, prop_kind, i_alg, i_direction, attr,
-                i_scale_policy, flags, i_activation, alpha, beta,
+                i_scale_policy, i_flags, i_activation, alpha, beta,
                 i_skip_nonlinear, i_mb);
         std::stringstream ss;
         ss << p;
@@ -94,6 +99,9 @@ void check_correctness(const desc_t *c) {
         if (want_perf_report && bench_mode & PERF) {
             perf_report_t pr(perf_template);
             pr.report(&p, &res, pstr);
+            if (p.var_len())
+                print(0, "var-len: %.1f%% of the cells skipped\n",
+                        100. * (1. - p.computed_cells_ratio()));
         }
 
         benchdnn_stat.tests++;
@@ -116,6 +124,7 @@ int bench(int argc, char **argv) {
                 || parse_scale_policy(scale_policy, argv[0])
                 || parse_mb(mb, argv[0])
                 || parse_skip_nonlinear(skip_nonlinear, argv[0])
+                || parse_vector_option(var_len, str2bool, argv[0], "var-len")
                 || parse_attr(attr, argv[0])
                 || parse_allow_unimpl(allow_unimpl, argv[0])
                 || parse_perf_template(perf_template, perf_template_def,
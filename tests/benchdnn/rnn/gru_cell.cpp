@@ -35,10 +35,13 @@ void gru_fwd_postgemm_part1_template(T func1, const prb_t &p, float *gates_,
     for (int64_t i = 0; i < p.mb; i++)
         for (int64_t k = 0; k < p.dic; k++) {
             gates(i, GRU_U, k) = func1(p.linear_scales[GRU_U],
-                    gates(i, GRU_U, k) + bias(GRU_U, k));
+                    maybe_deq(p, gates(i, GRU_U, k), GRU_U * p.dic + k)
+                            + bias(GRU_U, k));
             gates(i, GRU_R, k) = func1(p.linear_scales[GRU_R],
-                    gates(i, GRU_R, k) + bias(GRU_R, k));
-            dst_iter_h(i, k) = src_iter_h(i, k) * gates(i, GRU_R, k);
+                    maybe_deq(p, gates(i, GRU_R, k), GRU_R * p.dic + k)
+                            + bias(GRU_R, k));
+            dst_iter_h(i, k) = maybe_q(
+                    p, maybe_deq(p, src_iter_h(i, k)) * gates(i, GRU_R, k));
         }
 }
 
@@ -65,8 +68,11 @@ void gru_fwd_postgemm_part2_template(T func1, const prb_t &p, float *gates_,
         for (int64_t k = 0; k < p.dic; k++) {
             double U = gates(i, GRU_U, k);
             double O = func1(p.linear_scales[GRU_O],
-                    gates(i, GRU_O, k) + bias(GRU_O, k));
-            dst_iter_h(i, k) = (float)(U * src_iter_h(i, k) + (1.0 - U) * O);
+                    maybe_deq(p, gates(i, GRU_O, k), GRU_O * p.dic + k)
+                            + bias(GRU_O, k));
+            dst_iter_h(i, k) = maybe_q(p,
+                    (float)(U * maybe_deq(p, src_iter_h(i, k))
+                            + (1.0 - U) * O));
 
             gates(i, GRU_O, k) = O;
         }
@@ -37,23 +37,27 @@ void lbr_gru_fwd_postgemm_template(T1 func1, T2 func2, const prb_t &p,
         for (int64_t j = 0; j < p.n_gates() - 1; j++)
             for (int64_t k = 0; k < p.dic; k++) {
                 gates(i, j, k) = func1(p.linear_scales[j],
-                        gates(i, j, k) + tmp_ws(i, j, k) + bias(j, k));
+                        maybe_deq(p, gates(i, j, k) + tmp_ws(i, j, k),
+                                j * p.dic + k)
+                                + bias(j, k));
             }
 
     for (int64_t i = 0; i < p.mb; i++)
         for (int64_t k = 0; k < p.dic; k++) {
             gates(i, GRU_O, k) = func2(p.linear_scales[GRU_O],
-                    gates(i, GRU_O, k)
+                    maybe_deq(p, gates(i, GRU_O, k), GRU_O * p.dic + k)
                             + gates(i, GRU_R, k)
-                                    * (tmp_ws(i, GRU_O, k)
+                                    * (maybe_deq(p, tmp_ws(i, GRU_O, k),
+                                               GRU_O * p.dic + k)
                                             + bias(LBR_GRU_U_PRIME, k))
                             + bias(GRU_O, k));
         }
 
     for (int64_t i = 0; i < p.mb; i++)
         for (int64_t k = 0; k < p.dic; k++) {
-            h_dst(i, k) = gates(i, GRU_U, k) * src_iter_h(i, k)
-                    + (1 - gates(i, GRU_U, k)) * gates(i, GRU_O, k);
+            h_dst(i, k) = maybe_q(p,
+                    gates(i, GRU_U, k) * maybe_deq(p, src_iter_h(i, k))
+                            + (1 - gates(i, GRU_U, k)) * gates(i, GRU_O, k));
         }
 }
 
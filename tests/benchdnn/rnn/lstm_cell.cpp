@@ -34,40 +34,20 @@ void lstm_fwd_postgemm_template(T1 func1, T2 func2, const prb_t &p,
     AOC<float> h_dst(dst_iter_h_, p.mb, p.wc);
     AOC<float> dst_iter_c(dst_iter_c_, p.mb, p.wc);
 
-    auto maybe_deq_w = [&](float g, int64_t oc) {
-        if (!is_cfg_u8(p.cfg)) return g;
-        float scale = 1.;
-        if (p.scale_policy == policy_t::PER_OC)
-            scale = p.wei_oc_scales[oc];
-        else if (p.scale_policy == policy_t::COMMON)
-            scale = p.wei_scale;
-        scale *= p.data_scale;
-        return g * (1.f / scale);
-    };
-
-    auto maybe_q_d = [&](float h) {
-        if (!is_cfg_u8(p.cfg)) return h;
-        float fp = p.data_scale * h + p.data_shift;
-        if (fp > p.cfg[input].max) fp = p.cfg[input].max;
-        if (fp < p.cfg[input].min) fp = p.cfg[input].min;
-        fp = mxcsr_round(fp);
-        return fp;
-    };
-
     // run the eltwise
     dnnl::impl::parallel_nd(p.mb, [&](int64_t ib) {
         for (int64_t ih = 0; ih < p.dic; ih++) {
             gates(ib, LSTM_I, ih) = func1(p.linear_scales[LSTM_I],
-                    maybe_deq_w(gates(ib, LSTM_I, ih), LSTM_I * p.dic + ih)
+                    maybe_deq(p, gates(ib, LSTM_I, ih), LSTM_I * p.dic + ih)
                             + bias(LSTM_I, ih));
             gates(ib, LSTM_F, ih) = func1(p.linear_scales[LSTM_F],
-                    maybe_deq_w(gates(ib, LSTM_F, ih), LSTM_F * p.dic + ih)
+                    maybe_deq(p, gates(ib, LSTM_F, ih), LSTM_F * p.dic + ih)
                             + bias(LSTM_F, ih));
             gates(ib, LSTM_C, ih) = func2(p.linear_scales[LSTM_C],
-                    maybe_deq_w(gates(ib, LSTM_C, ih), LSTM_C * p.dic + ih)
+                    maybe_deq(p, gates(ib, LSTM_C, ih), LSTM_C * p.dic + ih)
                             + bias(LSTM_C, ih));
             gates(ib, LSTM_O, ih) = func1(p.linear_scales[LSTM_O],
-                    maybe_deq_w(gates(ib, LSTM_O, ih), LSTM_O * p.dic + ih)
+                    maybe_deq(p, gates(ib, LSTM_O, ih), LSTM_O * p.dic + ih)
                             + bias(LSTM_O, ih));
             for (int64_t ig = 0; ig < 4; ig++) {
                 print(80,
@@ -79,8 +59,8 @@ void lstm_fwd_postgemm_template(T1 func1, T2 func2, const prb_t &p,
             float tmp = gates(ib, LSTM_F, ih) * src_iter_c(ib, ih)
                     + gates(ib, LSTM_I, ih) * gates(ib, LSTM_C, ih);
             dst_iter_c(ib, ih) = tmp;
-            h_dst(ib, ih) = maybe_q_d(
-                    gates(ib, LSTM_O, ih) * func2(p.linear_cscale, tmp));
+            h_dst(ib, ih) = maybe_q(
+                    p, gates(ib, LSTM_O, ih) * func2(p.linear_cscale, tmp));
             print(80, "recomp tmp(%a) cin(%a) ht(%a)\n", tmp,
                     src_iter_c(ib, ih), h_dst(ib, ih));
         }
@@ -57,6 +57,46 @@ void copy_init_bwd(const prb_t &p, float *ws_, const float *src_layer_,
                     &ws(lay + 1, dir_val, it_dest, C, 0));
         }
     }
+
+    if (!p.var_len()) return;
+
+    // The iterations past the end of a sequence do not contribute to the
+    // diffs. The diff of the last states of a sequence shorter than the batch
+    // is applied by copy_diff_last_iter() instead.
+    for_(int64_t it = 0; it < p.n_iter; it++)
+    for (int64_t nb = 0; nb < p.mb; nb++)
+        if (it >= p.seq_length(nb))
+            init_buffer(&ws(lay_dest, dir_val, it + 1, p.n_states(), nb * p.wc),
+                    p.dic, 0.);
+    for_(int64_t lay = 0; lay < p.n_layer; lay++)
+    for_(int64_t s = 0; s < p.n_states(); s++)
+    for (int64_t nb = 0; nb < p.mb; nb++)
+        if (p.seq_length(nb) < p.n_iter)
+            init_buffer(
+                    &ws(lay + 1, dir_val, it_dest, s, nb * p.wc), p.dic, 0.);
+}
+
+// Puts the diff of the last states of the sequences ending at the iteration
+// iter of the variable length batch
+void copy_diff_last_iter(const prb_t &p, float *ws_,
+        const float *diff_dst_iter_, const float *diff_dst_iter_c_,
+        int64_t lay, int64_t dir_val, int64_t iter) {
+    AOC<float> ws(ws_, p.n_layer + 2, p.n_dir(), p.n_iter + 2, p.n_states() + 1,
+            p.mb, p.wc);
+    AOC<const float> diff_dst_iter(
+            diff_dst_iter_, p.n_layer, p.n_dir(), p.mb, p.dic);
+    AOC<const float> diff_dst_iter_c(
+            diff_dst_iter_c_, p.n_layer, p.n_dir(), p.mb, p.dic);
+
+    for (int64_t nb = 0; nb < p.mb; nb++) {
+        if (p.seq_length(nb) != iter || iter == p.n_iter) continue;
+        copy(1, p.dic, p.dic, p.wc, &diff_dst_iter(lay - 1, dir_val, nb, 0),
+                &ws(lay, dir_val, iter + 1, H, nb, 0));
+        if (p.alg == VANILLA_LSTM)
+            copy(1, p.dic, p.dic, p.wc,
+                    &diff_dst_iter_c(lay - 1, dir_val, nb, 0),
+                    &ws(lay, dir_val, iter + 1, C, nb, 0));
+    }
 }
 
 void copy_res_bwd(const prb_t &p, float *lastit_states_,
@@ -212,6 +252,10 @@ void rnn_linear_bwd(const prb_t &p, const float *diff_dst_iter_,
                 int64_t ws_prev_iter
                         = (iter_dir == left2right) ? iter + 1 : iter - 1;
 
+                if (p.var_len())
+                    copy_diff_last_iter(p, wsb_, diff_dst_iter_,
+                            diff_dst_iter_c_, lay, dir_val, iter);
+
                 rnn_cell_bwd(p, &wsb(lay, dir_val, iter, p.n_states(), 0, 0),
                         &wsb(lay, dir_val, iter, H, 0, 0),
                         &wsb(lay, dir_val, iter, C, 0, 0),
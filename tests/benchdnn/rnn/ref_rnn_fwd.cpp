@@ -28,25 +28,30 @@ namespace rnn {
 void prepare_bias(const prb_t &p, float *bias_with_compensation_,
         const float *bias_, const float *weights_layer_,
         const float *weights_iter_) {
+    // LBR GRU keeps the bias of the iteration part of its last gate
+    // separately, which takes the compensation of the iteration weights
+    bool is_lbr = p.alg == LBR_GRU;
     AOC<const float> weights_layer(
             weights_layer_, p.n_layer, p.n_dir(), p.slc, p.n_gates(), p.dic);
     AOC<const float> weights_iter(
             weights_iter_, p.n_layer, p.n_dir(), p.sic, p.n_gates(), p.dic);
 
-    AOC<const float> bias(bias_, p.n_layer, p.n_dir(), p.n_gates(), p.dic);
-    AOC<float> bias_with_compensation(
-            bias_with_compensation_, p.n_layer, p.n_dir(), p.n_gates(), p.dic);
+    AOC<const float> bias(
+            bias_, p.n_layer, p.n_dir(), p.n_gates() + is_lbr, p.dic);
+    AOC<float> bias_with_compensation(bias_with_compensation_, p.n_layer,
+            p.n_dir(), p.n_gates() + is_lbr, p.dic);
 
     for (int layer = 0; layer < p.n_layer; ++layer)
         for (int dir = 0; dir < p.n_dir(); ++dir)
             for (int gate = 0; gate < p.n_gates(); ++gate)
                 for (int dic = 0; dic < p.dic; ++dic) {
-                    float weights_compensation = 0;
+                    float weights_iter_compensation = 0;
                     for (int sic = 0; sic < p.sic; ++sic)
-                        weights_compensation
+                        weights_iter_compensation
                                 += weights_iter(layer, dir, sic, gate, dic);
+                    float weights_layer_compensation = 0;
                     for (int slc = 0; slc < p.slc; ++slc)
-                        weights_compensation
+                        weights_layer_compensation
                                 += weights_layer(layer, dir, slc, gate, dic);
 
                     float scale = p.data_scale;
@@ -55,9 +60,22 @@ void prepare_bias(const prb_t &p, float *bias_with_compensation_,
                     else if (p.scale_policy == policy_t::COMMON)
                         scale *= p.wei_scale;
 
-                    bias_with_compensation(layer, dir, gate, dic)
-                            = bias(layer, dir, gate, dic)
-                            - weights_compensation * p.data_shift / scale;
+                    if (is_lbr && gate == GRU_O) {
+                        bias_with_compensation(layer, dir, gate, dic)
+                                = bias(layer, dir, gate, dic)
+                                - weights_layer_compensation * p.data_shift
+                                        / scale;
+                        bias_with_compensation(
+                                layer, dir, LBR_GRU_U_PRIME, dic)
+                                = bias(layer, dir, LBR_GRU_U_PRIME, dic)
+                                - weights_iter_compensation * p.data_shift
+                                        / scale;
+                    } else
+                        bias_with_compensation(layer, dir, gate, dic)
+                                = bias(layer, dir, gate, dic)
+                                - (weights_iter_compensation
+                                          + weights_layer_compensation)
+                                        * p.data_shift / scale;
                 }
 }
 
@@ -117,6 +135,12 @@ void copy_res_fwd(const prb_t &p, float *lastit_states_,
             auto from = &ws(p.n_layer, dir_val, it + 1, H, nb, 0);
             auto to = &lastlay_states(
                     it, nb, action == action_concat ? p.dlc : 0);
+            // the iterations past the end of a sequence have a zero output
+            if (it >= p.seq_length(nb)) {
+                for (int64_t c = 0; c < p.dlc; c++)
+                    to[c] = 0;
+                continue;
+            }
             copy(1, p.dlc, p.wc, lastlay_c, from, to, action, p.is_int8());
 
             if (p.is_int8() && p.cfg[dst_last_layer].dt != dnnl_u8) {
@@ -138,21 +162,21 @@ void copy_res_fwd(const prb_t &p, float *lastit_states_,
         }
     }
 
-    int64_t it_source = (iter_dir == left2right) ? p.n_iter : 1;
-
     // Copy states iteration
-    for (int64_t lay = 0; lay < p.n_layer; lay++) {
+    for_(int64_t lay = 0; lay < p.n_layer; lay++)
+    for (int64_t nb = 0; nb < p.mb; nb++) {
+        // the last states of a sequence are the ones of its last iteration
+        int64_t it_source = (iter_dir == left2right) ? p.seq_length(nb) : 1;
         if (p.alg == VANILLA_LSTM) {
-            copy(p.mb, p.dic, p.wc, p.dic,
-                    &ws(lay + 1, dir_val, it_source, C, 0, 0),
-                    &lastit_c_states(lay, dir_val, 0, 0));
+            copy(1, p.dic, p.wc, p.dic,
+                    &ws(lay + 1, dir_val, it_source, C, nb, 0),
+                    &lastit_c_states(lay, dir_val, nb, 0));
         }
 
-        copy(p.mb, p.dic, p.wc, p.dic,
-                &ws(lay + 1, dir_val, it_source, H, 0, 0),
-                &lastit_states(lay, dir_val, 0, 0));
+        copy(1, p.dic, p.wc, p.dic, &ws(lay + 1, dir_val, it_source, H, nb, 0),
+                &lastit_states(lay, dir_val, nb, 0));
         if (p.is_int8() && p.cfg[dst_last_iteration].dt != dnnl_u8)
-            data_deq10n(p.mb, p.dic, p.dic, &lastit_states(lay, dir_val, 0, 0),
+            data_deq10n(1, p.dic, p.dic, &lastit_states(lay, dir_val, nb, 0),
                     p.data_scale, p.data_shift);
     }
 }
@@ -282,8 +282,10 @@ int fill_bias(const prb_t &p, rnn_data_kind_t kind, dnn_mem_t &mem_dt,
     return OK;
 }
 
+// The creation of the forward primitive of a backward problem is recorded in
+// fwd_r, and the one of the measured primitive in r
 inline int init_pd(const prb_t &p, dnnl_rnn_desc_t rd[2],
-        dnnl_primitive_desc_t rpd[2], res_t *r) {
+        dnnl_primitive_desc_t rpd[2], res_t *r, res_t *fwd_r) {
     dnnl_prop_kind_t fwd_prop = dnnl_prop_kind_undef;
     bool is_bwd = false;
     switch (p.prop) {
@@ -455,8 +457,8 @@ inline int init_pd(const prb_t &p, dnnl_rnn_desc_t rd[2],
     create_dnnl_rnn_attr(p, &dnnl_attr);
     dnnl_status_t init_status = dnnl_success;
     for (int i = 0; i < 1 + (int)is_bwd; i++) {
-        init_status = dnnl_primitive_desc_create(
-                &(rpd[i]), &(rd[i]), dnnl_attr, engine_tgt, NULL);
+        init_status = create_primitive_desc(&(rpd[i]), &(rd[i]), dnnl_attr,
+                engine_tgt, NULL, is_bwd && i == 0 ? fwd_r : r);
         if (init_status == dnnl_unimplemented)
             return r->state = UNIMPLEMENTED, OK;
         else
@@ -516,6 +518,13 @@ int doit(const prb_t &p, res_t *r) {
         return OK;
     }
 
+    // the variable length sequences are only supported in the left to right
+    // direction
+    if (p.var_len() && p.direction != dnnl_unidirectional_left2right) {
+        r->state = SKIPPED;
+        return OK;
+    }
+
     dnn_mem_t input_dt;
     dnn_mem_t states_dt;
     dnn_mem_t c_states_dt;
@@ -559,6 +568,7 @@ int doit(const prb_t &p, res_t *r) {
     dnn_mem_t diff_c_last_iteration_fp;
 
     dnn_mem_t workspace_dt;
+    dnn_mem_t seq_lengths_dt;
 
     dnnl_rnn_desc_t rd[2];
     dnnl_primitive_desc_t rpd[2] = {nullptr};
@@ -571,7 +581,8 @@ int doit(const prb_t &p, res_t *r) {
         return OK;
     };
 
-    SAFE(init_pd(p, rd, rpd, r), WARN);
+    res_t fwd_res {};
+    SAFE(init_pd(p, rd, rpd, r, &fwd_res), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
     auto &input_dt_d = rd[0].src_layer_desc;
@@ -677,6 +688,14 @@ int doit(const prb_t &p, res_t *r) {
         workspace_dt = dnn_mem_t(*ws_md, engine_tgt);
     }
 
+    if (p.var_len()) {
+        dnnl_dims_t seq_lengths_dims = {p.mb};
+        seq_lengths_dt = dnn_mem_t(
+                1, seq_lengths_dims, dnnl_s32, dnnl_x, engine_tgt);
+        for (int64_t b = 0; b < p.mb; b++)
+            seq_lengths_dt.set_elem(b, p.seq_length(b));
+    }
+
     // for int8 RNN we need pass attributes for data q10n
     const_dnnl_primitive_attr_t rnn_attr;
     DNN_SAFE(dnnl_primitive_desc_get_attr(rpd[0], &rnn_attr), WARN);
@@ -739,11 +758,18 @@ int doit(const prb_t &p, res_t *r) {
 
     // Running the forward pass
     {
-        DNN_SAFE(dnnl_primitive_create(&c, rpd[0]), WARN);
+        DNN_SAFE(create_primitive(&c, rpd[0], is_bwd ? &fwd_res : r), WARN);
+        if (is_bwd)
+            print(2,
+                    "forward: create_pd:%g create_miss:%g create_hit:%g "
+                    "(ms) jit_size:%zu\n",
+                    fwd_res.create_pd_ms, fwd_res.create_miss_ms,
+                    fwd_res.create_hit_ms, fwd_res.jit_code_size);
 
         args.set(DNNL_ARG_SRC_LAYER, input_dt);
         args.set(DNNL_ARG_SRC_ITER, states_dt);
         if (p.alg == VANILLA_LSTM) args.set(DNNL_ARG_SRC_ITER_C, c_states_dt);
+        if (p.var_len()) args.set(DNNL_ARG_SRC_SEQ_LENGTHS, seq_lengths_dt);
         args.set(DNNL_ARG_WEIGHTS_LAYER, weights_input_dt);
         args.set(DNNL_ARG_WEIGHTS_ITER, weights_states_dt);
         args.set(DNNL_ARG_BIAS, bias_dt);
@@ -777,11 +803,12 @@ int doit(const prb_t &p, res_t *r) {
         args.clear();
         DNN_SAFE(dnnl_primitive_destroy(c), CRIT);
 
-        DNN_SAFE(dnnl_primitive_create(&c, rpd[1]), WARN);
+        DNN_SAFE(create_primitive(&c, rpd[1], r), WARN);
 
         args.set(DNNL_ARG_SRC_LAYER, input_dt);
         args.set(DNNL_ARG_SRC_ITER, states_dt);
         if (p.alg == VANILLA_LSTM) args.set(DNNL_ARG_SRC_ITER_C, c_states_dt);
+        if (p.var_len()) args.set(DNNL_ARG_SRC_SEQ_LENGTHS, seq_lengths_dt);
         args.set(DNNL_ARG_WEIGHTS_LAYER, bwd_weights_input_dt);
         args.set(DNNL_ARG_WEIGHTS_ITER, bwd_weights_states_dt);
         args.set(DNNL_ARG_BIAS, bias_dt);
@@ -843,7 +870,7 @@ int doit(const prb_t &p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, c, args);
+    measure_perf(r, c, args);
     cleanup();
 
     return OK;
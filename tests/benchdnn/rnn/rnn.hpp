@@ -255,7 +255,23 @@ struct prb_t : public desc_t {
         int64_t num_cells = (int64_t)n_dir() * n_layer * n_iter;
         int64_t cell_ops = (int64_t)2 * (n_gates() * dic) * mb * (sic + slc);
         int64_t prop_multiplier = prop == dnnl_backward ? 2 : 1;
-        ops = prop_multiplier * num_cells * cell_ops;
+        ops = prop_multiplier * num_cells * cell_ops * computed_cells_ratio();
+    }
+
+    bool var_len() const { return flags & dnnl_rnn_flags_variable_length; }
+
+    // Lengths of the sequences of the batch in the variable length mode.
+    // They decrease linearly from n_iter, the shortest being n_iter / mb.
+    int64_t seq_length(int64_t b) const {
+        return var_len() ? n_iter - b * n_iter / mb : n_iter;
+    }
+
+    // The fraction of the cells of the padded batch that are computed
+    double computed_cells_ratio() const {
+        int64_t computed = 0;
+        for (int64_t b = 0; b < mb; b++)
+            computed += seq_length(b);
+        return (double)computed / (mb * n_iter);
     }
 
     int64_t n_dir() const {
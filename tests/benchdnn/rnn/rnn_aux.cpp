@@ -197,6 +197,7 @@ std::ostream &operator<<(std::ostream &s, const prb_t &p) {
     s << " --direction=" << direction2str(p.direction)
       << " --cfg=" << cfg2str(p.cfg)
       << " --scaling=" << attr_t::scale_t::policy2str(p.scale_policy);
+    if (p.var_len()) s << " --var-len=true";
 
     s << " "
       << "l" << p.n_layer << "t" << p.n_iter << "mb" << p.mb << "sic" << p.sic
@@ -81,6 +81,12 @@ void data_deq10n(int64_t dimc, int64_t dimr, int64_t ld_src, float *src_,
         float data_scale, float data_shift);
 void gates_reduction(const prb_t &p, const float *b_gates_, float *diff_bias_);
 
+// (de)quantization of the int8 cells: the gates are dequantized from the
+// accumulated values of output channel oc, the states from u8
+float maybe_deq(const prb_t &p, const float in, int64_t oc);
+float maybe_deq(const prb_t &p, const float in);
+float maybe_q(const prb_t &p, float h);
+
 int compare_dat(const prb_t &p, rnn_data_kind_t kind, dnn_mem_t &mem_dt,
         dnn_mem_t &mem_fp, res_t *r, bool final_compare);
 
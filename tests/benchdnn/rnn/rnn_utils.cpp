@@ -51,4 +51,28 @@ void data_deq10n(int64_t dimc, int64_t dimr, int64_t ld_src, float *src_,
     });
 }
 
+float maybe_deq(const prb_t &p, const float in, int64_t oc) {
+    if (!is_cfg_u8(p.cfg)) return in;
+    float scale = p.data_scale;
+    if (p.scale_policy == policy_t::PER_OC)
+        scale *= p.wei_oc_scales[oc];
+    else if (p.scale_policy == policy_t::COMMON)
+        scale *= p.wei_scale;
+    return in * (1.f / scale);
+}
+
+float maybe_deq(const prb_t &p, const float in) {
+    if (!is_cfg_u8(p.cfg)) return in;
+    return (in - p.data_shift) * (1.f / p.data_scale);
+}
+
+float maybe_q(const prb_t &p, float h) {
+    if (!is_cfg_u8(p.cfg)) return h;
+    float fp = p.data_scale * h + p.data_shift;
+    if (fp > p.cfg[input].max) fp = p.cfg[input].max;
+    if (fp < p.cfg[input].min) fp = p.cfg[input].min;
+    fp = mxcsr_round(fp);
+    return fp;
+}
+
 } // namespace rnn
@@ -36,6 +36,18 @@ static int check_simple_enums() {
     CHECK_EQ(p::str2kind("relu"), p::kind_t::RELU);
     CHECK_EQ(p::str2kind("ReLU"), p::kind_t::RELU);
 
+    /* cold cache mode */
+    CHECK_CASE_STR_EQ(cold_cache_mode2str(COLD_CACHE_WEI), "wei");
+    CHECK_EQ(str2cold_cache_mode("none"), COLD_CACHE_NONE);
+    CHECK_EQ(str2cold_cache_mode("wei"), COLD_CACHE_WEI);
+    CHECK_EQ(str2cold_cache_mode("All"), COLD_CACHE_ALL);
+
+    /* bench mode */
+    CHECK_EQ(str2bench_mode("CP"), (bench_mode_t)(CORR | PERF));
+    CHECK_EQ(str2bench_mode("throughput"), (bench_mode_t)(PERF | THROUGHPUT));
+    CHECK_CASE_STR_EQ(
+            bench_mode2str((bench_mode_t)(PERF | THROUGHPUT)), "throughput");
+
     return OK;
 }
 
@@ -124,7 +124,7 @@ static int init_pd(const prb_t *p, dnnl_primitive_desc_t &spd, res_t *r) {
                          &sd, &data_d, p->axis, p->group),
                 WARN);
         init_status
-                = dnnl_primitive_desc_create(&spd, &sd, NULL, engine_tgt, fspd);
+                = create_primitive_desc(&spd, &sd, NULL, engine_tgt, fspd, r);
 
         DNN_SAFE(dnnl_primitive_desc_destroy(fspd), CRIT);
     }
@@ -149,7 +149,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, spd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&s, spd), WARN);
+    DNN_SAFE(create_primitive(&s, spd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(spd), CRIT);
 
     const_dnnl_primitive_desc_t const_spd;
@@ -182,7 +182,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare(p, dst_fp, data, r), WARN);
     }
 
-    measure_perf(r->timer, s, args);
+    measure_perf(r, s, args);
 
     DNN_SAFE_V(dnnl_primitive_destroy(s));
 
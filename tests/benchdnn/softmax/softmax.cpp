@@ -71,7 +71,7 @@ static int init_pd(const prb_t *p, dnnl_softmax_desc_t &sd,
     }
 
     dnnl_status_t init_status
-            = dnnl_primitive_desc_create(&spd, &sd, NULL, engine_tgt, NULL);
+            = create_primitive_desc(&spd, &sd, NULL, engine_tgt, NULL, r);
 
     if (init_status == dnnl_unimplemented)
         return r->state = UNIMPLEMENTED, OK;
@@ -203,7 +203,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, sd, spd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&s, spd), WARN);
+    DNN_SAFE(create_primitive(&s, spd, r), WARN);
     DNN_SAFE(dnnl_primitive_desc_destroy(spd), CRIT);
 
     const auto fp = dnnl_f32;
@@ -271,7 +271,7 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    measure_perf(r->timer, s, args);
+    measure_perf(r, s, args);
 
     DNN_SAFE(dnnl_primitive_destroy(s), CRIT);
 
@@ -48,6 +48,7 @@ static int init_pd(const prb_t *p, dnnl_primitive_desc_t &spd, res_t *r) {
                 WARN);
     }
 
+    set_benchdnn_threads();
     dnnl_status_t init_status = dnnl_sum_primitive_desc_create(&spd,
             p->dtag != dnnl_format_tag_undef ? &dst_d : NULL, p->n_inputs(),
             p->scales.data(), src_d.data(), NULL, engine_tgt);
@@ -134,7 +135,7 @@ int doit(const prb_t *p, res_t *r) {
     SAFE(init_pd(p, spd, r), WARN);
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
 
-    DNN_SAFE(dnnl_primitive_create(&s, spd), WARN);
+    DNN_SAFE(create_primitive(&s, spd, r), WARN);
 
     auto q = [=](dnnl_query_t query, int index = 0) {
         return *dnnl_primitive_desc_query_md(spd, query, index);
@@ -173,7 +174,7 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare(p, dst_data_type, dst_fp, dst, r), WARN);
     }
 
-    measure_perf(r->timer, s, args);
+    measure_perf(r, s, args);
 
     DNN_SAFE(dnnl_primitive_desc_destroy(spd), CRIT);
     DNN_SAFE(dnnl_primitive_destroy(s), CRIT);
@@ -0,0 +1,236 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#include <vector>
+
+namespace dnnl {
+
+struct conv_stack_layer_t {
+    memory::dim ic, oc, k, s, p;
+};
+
+struct conv_stack_test_params {
+    memory::dim mb, ih, iw;
+    std::vector<conv_stack_layer_t> layers;
+    bool with_relu;
+    memory::format_tag src_tag, dst_tag;
+};
+
+class conv_stack_test
+    : public ::testing::TestWithParam<conv_stack_test_params> {
+protected:
+    virtual void SetUp() {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "GPU engine is not supported");
+        auto p = ::testing::TestWithParam<
+                conv_stack_test_params>::GetParam();
+        Test(p);
+    }
+
+    void Test(const conv_stack_test_params &p) {
+        using tag = memory::format_tag;
+        using dt = memory::data_type;
+
+        auto eng = engine(get_test_engine_kind(), 0);
+        auto strm = stream(eng);
+        const int n = (int)p.layers.size();
+
+        // the convolutions of the stack and, for reference, the same
+        // convolutions executed one by one on plain layouts
+        std::vector<convolution_forward::desc> descs, ref_descs;
+        std::vector<primitive_attr> attrs;
+        std::vector<memory::dims> wei_dims, bia_dims;
+        memory::dims src_dims = {p.mb, p.layers[0].ic, p.ih, p.iw};
+        memory::dims dst_dims;
+        for (int l = 0; l < n; ++l) {
+            const auto &ld = p.layers[l];
+            const memory::dim oh = (src_dims[2] + 2 * ld.p - ld.k) / ld.s + 1;
+            const memory::dim ow = (src_dims[3] + 2 * ld.p - ld.k) / ld.s + 1;
+            dst_dims = {p.mb, ld.oc, oh, ow};
+            wei_dims.push_back({ld.oc, ld.ic, ld.k, ld.k});
+            bia_dims.push_back({ld.oc});
+
+            const bool is_first = l == 0, is_last = l == n - 1;
+            memory::desc src_md(
+                    src_dims, dt::f32, is_first ? p.src_tag : tag::any);
+            memory::desc dst_md(
+                    dst_dims, dt::f32, is_last ? p.dst_tag : tag::any);
+            memory::desc wei_md(wei_dims[l], dt::f32, tag::any);
+            memory::desc bia_md(bia_dims[l], dt::f32, tag::any);
+            descs.emplace_back(prop_kind::forward_inference,
+                    algorithm::convolution_direct, src_md, wei_md, bia_md,
+                    dst_md, memory::dims {ld.s, ld.s},
+                    memory::dims {ld.p, ld.p}, memory::dims {ld.p, ld.p});
+            ref_descs.emplace_back(prop_kind::forward_inference,
+                    algorithm::convolution_direct,
+                    memory::desc(src_dims, dt::f32, tag::nchw),
+                    memory::desc(wei_dims[l], dt::f32, tag::oihw),
+                    memory::desc(bia_dims[l], dt::f32, tag::x),
+                    memory::desc(dst_dims, dt::f32, tag::nchw),
+                    memory::dims {ld.s, ld.s}, memory::dims {ld.p, ld.p},
+                    memory::dims {ld.p, ld.p});
+
+            primitive_attr attr;
+            if (p.with_relu) {
+                post_ops ops;
+                ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+                attr.set_post_ops(ops);
+            }
+            attrs.push_back(attr);
+            src_dims = dst_dims;
+        }
+
+        auto pd = conv_stack::primitive_desc(descs, attrs, eng);
+        ASSERT_EQ(pd.src_desc().dims(),
+                (memory::dims {p.mb, p.layers[0].ic, p.ih, p.iw}));
+        ASSERT_EQ(pd.dst_desc().dims(), dst_dims);
+
+        memory src(pd.src_desc(), eng);
+        memory dst(pd.dst_desc(), eng);
+        fill_data<float>(pd.src_desc().get_size() / sizeof(float), src);
+
+        std::unordered_map<int, memory> args
+                = {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}};
+        std::vector<memory> ref_wei, ref_bia;
+        for (int l = 0; l < n; ++l) {
+            memory::desc wei_md(wei_dims[l], dt::f32, tag::oihw);
+            memory::desc bia_md(bia_dims[l], dt::f32, tag::x);
+            ref_wei.emplace_back(wei_md, eng);
+            ref_bia.emplace_back(bia_md, eng);
+            fill_data<float>(wei_md.get_size() / sizeof(float), ref_wei[l],
+                    1.f / wei_dims[l][1], 0.2f / wei_dims[l][1]);
+            fill_data<float>(bia_md.get_size() / sizeof(float), ref_bia[l]);
+
+            // the layout of the weights is chosen by the stack
+            memory wei(pd.weights_desc(l), eng);
+            memory bia(pd.bias_desc(l), eng);
+            reorder(ref_wei[l], wei).execute(strm, ref_wei[l], wei);
+            reorder(ref_bia[l], bia).execute(strm, ref_bia[l], bia);
+            args.insert({DNNL_ARG_MULTIPLE_WEIGHTS + l, wei});
+            args.insert({DNNL_ARG_MULTIPLE_BIAS + l, bia});
+        }
+
+        conv_stack(pd).execute(strm, args);
+
+        memory ref_src({pd.src_desc().dims(), dt::f32, tag::nchw}, eng);
+        reorder(src, ref_src).execute(strm, src, ref_src);
+        for (int l = 0; l < n; ++l) {
+            auto ref_pd = convolution_forward::primitive_desc(
+                    ref_descs[l], attrs[l], eng);
+            memory ref_dst(ref_pd.dst_desc(), eng);
+            convolution_forward(ref_pd).execute(strm,
+                    {{DNNL_ARG_SRC, ref_src}, {DNNL_ARG_WEIGHTS, ref_wei[l]},
+                            {DNNL_ARG_BIAS, ref_bia[l]},
+                            {DNNL_ARG_DST, ref_dst}});
+            ref_src = ref_dst;
+        }
+        strm.wait();
+
+        compare_data<float>(ref_src, dst);
+    }
+};
+
+TEST_P(conv_stack_test, TestsConvStack) {}
+
+using tag = memory::format_tag;
+INSTANTIATE_TEST_SUITE_P(TestConvStack, conv_stack_test,
+        ::testing::Values(
+                conv_stack_test_params {2, 14, 14,
+                        {{16, 16, 1, 1, 0}, {16, 16, 3, 1, 1},
+                                {16, 32, 1, 1, 0}},
+                        true, tag::any, tag::any},
+                conv_stack_test_params {2, 14, 14,
+                        {{16, 16, 1, 1, 0}, {16, 16, 3, 1, 1},
+                                {16, 32, 1, 1, 0}},
+                        true, tag::nchw, tag::nchw},
+                conv_stack_test_params {1, 30, 22,
+                        {{16, 32, 3, 2, 1}, {32, 16, 3, 1, 1}}, false,
+                        tag::nhwc, tag::nhwc},
+                conv_stack_test_params {1, 9, 9,
+                        {{3, 16, 3, 1, 1}, {16, 16, 3, 1, 1},
+                                {16, 16, 3, 1, 1}},
+                        true, tag::nchw, tag::any},
+                conv_stack_test_params {2, 7, 7, {{32, 32, 3, 1, 0}}, false,
+                        tag::any, tag::nchw}));
+
+TEST(conv_stack_test_iface, TestsInvalidStacks) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "GPU engine is not supported");
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+    auto eng = engine(get_test_engine_kind(), 0);
+
+    auto make_desc = [](memory::dim ic, memory::dim oc, tag src_tag,
+                             tag dst_tag) {
+        return convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct,
+                memory::desc({1, ic, 8, 8}, dt::f32, src_tag),
+                memory::desc({oc, ic, 1, 1}, dt::f32, tag::any),
+                memory::desc({1, oc, 8, 8}, dt::f32, dst_tag), {1, 1}, {0, 0},
+                {0, 0});
+    };
+
+    // the convolutions are not chained
+    EXPECT_ANY_THROW(conv_stack::primitive_desc(
+            {make_desc(16, 16, tag::nchw, tag::any),
+                    make_desc(32, 16, tag::any, tag::nchw)},
+            {}, eng));
+
+    // the intermediate activations have a user-defined layout
+    EXPECT_ANY_THROW(conv_stack::primitive_desc(
+            {make_desc(16, 16, tag::nchw, tag::nchw),
+                    make_desc(16, 16, tag::nchw, tag::nchw)},
+            {}, eng));
+
+    // only an eltwise post-op is supported
+    primitive_attr attr;
+    post_ops ops;
+    ops.append_sum(1.f);
+    attr.set_post_ops(ops);
+    EXPECT_ANY_THROW(conv_stack::primitive_desc(
+            {make_desc(16, 16, tag::nchw, tag::any),
+                    make_desc(16, 16, tag::any, tag::nchw)},
+            {attr, primitive_attr()}, eng));
+}
+
+TEST(conv_stack_test_iface, TestsMissingWeights) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "GPU engine is not supported");
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+    auto eng = engine(get_test_engine_kind(), 0);
+    auto strm = stream(eng);
+
+    auto desc = convolution_forward::desc(prop_kind::forward_inference,
+            algorithm::convolution_direct,
+            memory::desc({1, 16, 8, 8}, dt::f32, tag::nchw),
+            memory::desc({16, 16, 1, 1}, dt::f32, tag::any),
+            memory::desc({1, 16, 8, 8}, dt::f32, tag::nchw), {1, 1}, {0, 0},
+            {0, 0});
+    auto pd = conv_stack::primitive_desc({desc}, {}, eng);
+    memory src(pd.src_desc(), eng);
+    memory dst(pd.dst_desc(), eng);
+
+    EXPECT_ANY_THROW(conv_stack(pd).execute(
+            strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}}));
+}
+
+} // namespace dnnl
@@ -16,9 +16,13 @@
 
 #include <vector>
 
+#include <atomic>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
+#include "tests/test_thread.hpp"
+
 namespace dnnl {
 
 TEST(test_parallel, Test) {
@@ -29,6 +33,46 @@ TEST(test_parallel, Test) {
     });
 }
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+// Runs f with the parallel regions going through a sample threadpool, the
+// way the primitives executed on a stream with a threadpool do
+template <typename F>
+void run_with_threadpool(int num_threads, F f) {
+    testing::threadpool_t threadpool(num_threads);
+    impl::threadpool_utils::activate_threadpool(&threadpool);
+    f();
+    impl::threadpool_utils::deactivate_threadpool();
+}
+
+TEST(test_parallel, TestThreadpool) {
+    for (int num_threads : {1, 2, 3}) {
+        run_with_threadpool(num_threads, [&]() {
+            ASSERT_LE(dnnl_get_max_threads(), num_threads);
+
+            const int nthr = 7;
+            std::vector<std::atomic<int>> visits(nthr * nthr);
+            for (auto &v : visits)
+                v = 0;
+            impl::parallel(nthr, [&](int ithr, int nthr_) {
+                ASSERT_EQ(nthr_, nthr);
+                ASSERT_TRUE(dnnl_in_parallel());
+                ASSERT_EQ(dnnl_get_thread_num(), ithr);
+                ASSERT_EQ(dnnl_get_num_threads(), nthr);
+                // a nested region is executed by the calling thread
+                impl::parallel(nthr, [&](int jthr, int) {
+                    ASSERT_EQ(dnnl_get_thread_num(), jthr);
+                    visits[ithr * nthr + jthr]++;
+                });
+                ASSERT_EQ(dnnl_get_thread_num(), ithr);
+            });
+            ASSERT_FALSE(dnnl_in_parallel());
+            for (auto &v : visits)
+                ASSERT_EQ(v, 1);
+        });
+    }
+}
+#endif
+
 typedef ptrdiff_t data_t;
 
 struct nd_params_t {
@@ -157,6 +201,16 @@ TEST_P(test_for_nd, Parallel) {
     CheckID();
 }
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+TEST_P(test_for_nd, ParallelThreadpool) {
+    run_with_threadpool(3, [&]() {
+        impl::parallel(
+                0, [&](int ithr, int nthr) { emit_for_nd(ithr, nthr); });
+    });
+    CheckID();
+}
+#endif
+
 CPU_INSTANTIATE_TEST_SUITE_P(Case0, test_for_nd,
         ::testing::Values(np_t {{0}}, np_t {{1}}, np_t {{100}}, np_t {{0, 0}},
                 np_t {{1, 2}}, np_t {{10, 10}}, np_t {{0, 1, 0}},
@@ -189,25 +243,33 @@ CPU_INSTANTIATE_TEST_SUITE_P(
 
 class test_parallel_nd : public test_nd {
 protected:
+    // Runs the nd loop with the static or with the chunked scheduler
+    template <typename... Args>
+    void run_nd(Args... args) {
+        if (chunked_)
+            impl::parallel_nd_chunked(args...);
+        else
+            impl::parallel_nd(args...);
+    }
+
     void emit_parallel_nd() {
         switch ((int)p.dims.size()) {
             case 1:
-                impl::parallel_nd(p.dims[0], [&](ptrdiff_t d0) {
+                run_nd(p.dims[0], [&](ptrdiff_t d0) {
                     ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
                     data[d0] = d0;
                 });
                 break;
             case 2:
-                impl::parallel_nd(
-                        p.dims[0], p.dims[1], [&](ptrdiff_t d0, ptrdiff_t d1) {
-                            ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
-                            ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
-                            const ptrdiff_t idx = d0 * p.dims[1] + d1;
-                            data[idx] = idx;
-                        });
+                run_nd(p.dims[0], p.dims[1], [&](ptrdiff_t d0, ptrdiff_t d1) {
+                    ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                    ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
+                    const ptrdiff_t idx = d0 * p.dims[1] + d1;
+                    data[idx] = idx;
+                });
                 break;
             case 3:
-                impl::parallel_nd(p.dims[0], p.dims[1], p.dims[2],
+                run_nd(p.dims[0], p.dims[1], p.dims[2],
                         [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2) {
                             ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
                             ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
@@ -218,7 +280,7 @@ protected:
                         });
                 break;
             case 4:
-                impl::parallel_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3],
+                run_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3],
                         [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2,
                                 ptrdiff_t d3) {
                             ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
@@ -233,8 +295,7 @@ protected:
                         });
                 break;
             case 5:
-                impl::parallel_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3],
-                        p.dims[4],
+                run_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3], p.dims[4],
                         [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2,
                                 ptrdiff_t d3, ptrdiff_t d4) {
                             ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
@@ -252,8 +313,8 @@ protected:
                         });
                 break;
             case 6:
-                impl::parallel_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3],
-                        p.dims[4], p.dims[5],
+                run_nd(p.dims[0], p.dims[1], p.dims[2], p.dims[3], p.dims[4],
+                        p.dims[5],
                         [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2,
                                 ptrdiff_t d3, ptrdiff_t d4, ptrdiff_t d5) {
                             ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
@@ -275,6 +336,8 @@ protected:
             default: ASSERT_TRUE(false);
         }
     }
+
+    bool chunked_ = false;
 };
 
 TEST_P(test_parallel_nd, Test) {
@@ -282,6 +345,19 @@ TEST_P(test_parallel_nd, Test) {
     CheckID();
 }
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+TEST_P(test_parallel_nd, TestThreadpool) {
+    run_with_threadpool(3, [&]() { emit_parallel_nd(); });
+    CheckID();
+}
+#endif
+
+TEST_P(test_parallel_nd, TestChunked) {
+    chunked_ = true;
+    emit_parallel_nd();
+    CheckID();
+}
+
 CPU_INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd,
         ::testing::Values(np_t {{0}}, np_t {{1}}, np_t {{100}}, np_t {{0, 0}},
                 np_t {{1, 2}}, np_t {{10, 10}}, np_t {{0, 1, 0}},
@@ -291,4 +367,123 @@ CPU_INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd,
                 np_t {{4, 1, 4, 5, 2}}, np_t {{4, 3, 0, 3, 0, 1}},
                 np_t {{2, 1, 3, 1, 2, 1}}, np_t {{4, 1, 4, 3, 2, 2}}));
 
+class test_threadpool_stream : public ::testing::Test {
+protected:
+    // Executes a convolution followed by a reorder on the stream and returns
+    // the output
+    std::vector<float> run(const engine &eng, stream &strm) {
+        memory::desc src_md({2, 16, 10, 10}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        memory::desc wei_md({32, 16, 3, 3}, memory::data_type::f32,
+                memory::format_tag::oihw);
+        memory::desc dst_md({2, 32, 10, 10}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md,
+                {{2, 32, 10, 10}, memory::data_type::f32,
+                        memory::format_tag::any},
+                {1, 1}, {1, 1}, {1, 1});
+        auto pd = convolution_forward::primitive_desc(desc, eng);
+
+        memory src(src_md, eng), wei(wei_md, eng), dst(dst_md, eng);
+        fill_data<float>(src_md.get_size() / sizeof(float), src);
+        fill_data<float>(wei_md.get_size() / sizeof(float), wei);
+
+        memory conv_src = src, conv_wei = wei, conv_dst(pd.dst_desc(), eng);
+        if (pd.src_desc() != src_md) {
+            conv_src = memory(pd.src_desc(), eng);
+            reorder(src, conv_src).execute(strm, src, conv_src);
+        }
+        if (pd.weights_desc() != wei_md) {
+            conv_wei = memory(pd.weights_desc(), eng);
+            reorder(wei, conv_wei).execute(strm, wei, conv_wei);
+        }
+        convolution_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC, conv_src}, {DNNL_ARG_WEIGHTS, conv_wei},
+                        {DNNL_ARG_DST, conv_dst}});
+        reorder(conv_dst, dst).execute(strm, conv_dst, dst);
+        strm.wait();
+
+        auto mapped_dst = map_memory<float>(dst);
+        const float *ptr = mapped_dst;
+        return std::vector<float>(ptr, ptr + dst_md.get_size() / sizeof(float));
+    }
+};
+
+TEST_F(test_threadpool_stream, TestExecution) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Threadpools are supported on CPU only");
+
+    testing::threadpool_t threadpool(3);
+    stream_attr attr(engine::kind::cpu);
+    auto status = dnnl_stream_attr_set_threadpool(attr.get(), &threadpool);
+    SKIP_IF(status == dnnl_unimplemented,
+            "The library is built without the THREADPOOL CPU runtime");
+    ASSERT_EQ(status, dnnl_success);
+    ASSERT_EQ(attr.get_threadpool(), &threadpool);
+
+    engine eng(engine::kind::cpu, 0);
+    stream strm(eng);
+    stream tp_strm(eng, stream::flags::default_flags, attr);
+    EXPECT_EQ(run(eng, tp_strm), run(eng, strm));
+}
+
+// The primitives scheduled dynamically compute each output point in a single
+// chunk, so their results match the static scheduling ones exactly
+class test_dynamic_scheduling : public test_threadpool_stream {};
+
+TEST_F(test_dynamic_scheduling, TestMatchesStatic) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Dynamic scheduling is supported on CPU only");
+
+    auto run_pooling = [](const engine &eng, stream &strm) {
+        memory::desc src_md({2, 32, 10, 10}, memory::data_type::f32,
+                memory::format_tag::nhwc);
+        memory::desc dst_md({2, 32, 5, 5}, memory::data_type::f32,
+                memory::format_tag::nhwc);
+        auto pd = pooling_forward::primitive_desc(
+                {prop_kind::forward_inference, algorithm::pooling_avg,
+                        src_md, dst_md, {2, 2}, {3, 3}, {0, 0}, {1, 1}},
+                eng);
+        memory src(src_md, eng), dst(dst_md, eng);
+        fill_data<float>(src_md.get_size() / sizeof(float), src);
+        pooling_forward(pd).execute(
+                strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+        strm.wait();
+
+        auto mapped_dst = map_memory<float>(dst);
+        const float *ptr = mapped_dst;
+        return std::vector<float>(ptr, ptr + dst_md.get_size() / sizeof(float));
+    };
+
+    engine eng(engine::kind::cpu, 0);
+    stream strm(eng);
+    const auto conv_ref = run(eng, strm);
+    const auto pool_ref = run_pooling(eng, strm);
+
+    ASSERT_EQ(set_dynamic_scheduling(true), status::success);
+    const auto conv = run(eng, strm);
+    const auto pool = run_pooling(eng, strm);
+    ASSERT_EQ(set_dynamic_scheduling(false), status::success);
+
+    EXPECT_EQ(conv, conv_ref);
+    EXPECT_EQ(pool, pool_ref);
+}
+
+TEST_F(test_threadpool_stream, TestInvalidArguments) {
+    testing::threadpool_t threadpool(1);
+    stream_attr attr(engine::kind::gpu);
+    EXPECT_EQ(dnnl_stream_attr_set_threadpool(attr.get(), &threadpool),
+            dnnl_invalid_arguments);
+    EXPECT_EQ(attr.get_threadpool(), nullptr);
+
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Threadpools are supported on CPU only");
+    engine eng(engine::kind::cpu, 0);
+    dnnl_stream_t strm;
+    EXPECT_EQ(dnnl_stream_create_v2(&strm, eng.get(),
+                      dnnl_stream_default_flags, attr.get()),
+            dnnl_invalid_arguments);
+}
+
 } // namespace dnnl
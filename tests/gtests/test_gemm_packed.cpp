@@ -0,0 +1,219 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "cpu_isa_traits.hpp"
+#include "dnnl.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+namespace dnnl {
+
+struct packed_gemm_params {
+    char transa, transb;
+    memory::dim N, K;
+};
+
+class packed_gemm_test : public ::testing::TestWithParam<packed_gemm_params> {
+protected:
+    virtual void SetUp() {
+        p_ = ::testing::TestWithParam<packed_gemm_params>::GetParam();
+    }
+
+    memory::dim lda(memory::dim M) const {
+        return is_trans(p_.transa) ? M : p_.K;
+    }
+    memory::dim ldb() const { return is_trans(p_.transb) ? p_.K : p_.N; }
+
+    // Returns op(X)[i][j] of a row-major matrix X
+    template <typename T>
+    static T at(const std::vector<T> &x, char trans, memory::dim ld,
+            memory::dim i, memory::dim j) {
+        return is_trans(trans) ? x[j * ld + i] : x[i * ld + j];
+    }
+
+    static bool is_trans(char trans) { return trans == 'T' || trans == 't'; }
+
+    template <typename T>
+    static std::vector<T> make_matrix(memory::dim size, int seed) {
+        std::vector<T> x(size);
+        for (memory::dim i = 0; i < size; i++)
+            x[i] = (T)((i * 7 + seed) % 11 - 5);
+        return x;
+    }
+
+    packed_gemm_params p_;
+};
+
+TEST_P(packed_gemm_test, TestF32) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The packed GEMM API is supported on CPU only");
+    const auto B = make_matrix<float>(p_.K * p_.N, 1);
+    packed_matrix packed_b;
+    ASSERT_EQ(sgemm_pack_b(packed_b, p_.transa, p_.transb, 16, p_.N, p_.K,
+                      B.data(), ldb()),
+            status::success);
+    ASSERT_GT(packed_b.get_size(), 0u);
+
+    // the matrix is packed once and used with any number of rows
+    for (memory::dim M : {1, 3, 16, 45}) {
+        const auto A = make_matrix<float>(M * p_.K, 2);
+        std::vector<float> C(M * p_.N, 1.f), C_ref(C);
+        ASSERT_EQ(sgemm_compute(p_.transa, M, p_.N, p_.K, A.data(), lda(M),
+                          packed_b, 1.f, C.data(), p_.N),
+                status::success);
+        ASSERT_EQ(sgemm(p_.transa, p_.transb, M, p_.N, p_.K, 1.f, A.data(),
+                          lda(M), B.data(), ldb(), 1.f, C_ref.data(), p_.N),
+                status::success);
+        for (memory::dim i = 0; i < M * p_.N; i++)
+            ASSERT_NEAR(C[i], C_ref[i], 1e-4f * std::abs(C_ref[i]) + 1e-4f);
+    }
+}
+
+TEST_P(packed_gemm_test, TestBF16BF16F32) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The packed GEMM API is supported on CPU only");
+    SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
+            "Skip test for systems that do not support avx512_core.");
+    // the values are small integers, so the bf16 and f32 results are equal
+    const auto B = make_matrix<bfloat16_t>(p_.K * p_.N, 1);
+    const std::vector<float> B_f32(B.begin(), B.end());
+    packed_matrix packed_b;
+    ASSERT_EQ(gemm_bf16bf16f32_pack_b(packed_b, p_.transa, p_.transb, 16,
+                      p_.N, p_.K, (const uint16_t *)B.data(), ldb()),
+            status::success);
+    ASSERT_GT(packed_b.get_size(), 0u);
+
+    for (memory::dim M : {1, 3, 16, 45}) {
+        const auto A = make_matrix<bfloat16_t>(M * p_.K, 2);
+        const std::vector<float> A_f32(A.begin(), A.end());
+        std::vector<float> C(M * p_.N, 1.f), C_ref(C);
+        ASSERT_EQ(gemm_bf16bf16f32_compute(p_.transa, M, p_.N, p_.K,
+                          (const uint16_t *)A.data(), lda(M), packed_b, 1.f,
+                          C.data(), p_.N),
+                status::success);
+        ASSERT_EQ(sgemm(p_.transa, p_.transb, M, p_.N, p_.K, 1.f,
+                          A_f32.data(), lda(M), B_f32.data(), ldb(), 1.f,
+                          C_ref.data(), p_.N),
+                status::success);
+        for (memory::dim i = 0; i < M * p_.N; i++)
+            ASSERT_EQ(C[i], C_ref[i]);
+    }
+
+    // a bf16 matrix cannot be used in an f32 operation
+    const auto A = make_matrix<float>(4 * p_.K, 2);
+    std::vector<float> C(4 * p_.N);
+    EXPECT_EQ(sgemm_compute(p_.transa, 4, p_.N, p_.K, A.data(), lda(4),
+                      packed_b, 0.f, C.data(), p_.N),
+            status::invalid_arguments);
+}
+
+TEST_P(packed_gemm_test, TestU8S8S32) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The packed GEMM API is supported on CPU only");
+    const auto B = make_matrix<int8_t>(p_.K * p_.N, 1);
+    packed_matrix packed_b;
+    ASSERT_EQ(gemm_u8s8s32_pack_b(packed_b, p_.transa, p_.transb, 16, p_.N,
+                      p_.K, B.data(), ldb()),
+            status::success);
+
+    for (memory::dim M : {1, 3, 16, 45}) {
+        auto A = make_matrix<uint8_t>(M * p_.K, 2);
+        for (auto &a : A)
+            a = (uint8_t)(a % 8);
+        const std::vector<int32_t> co(p_.N, 3);
+        std::vector<int32_t> C(M * p_.N, 0);
+        ASSERT_EQ(gemm_u8s8s32_compute(p_.transa, 'R', M, p_.N, p_.K,
+                          A.data(), lda(M), packed_b, 0.f, C.data(), p_.N,
+                          co.data()),
+                status::success);
+        for (memory::dim i = 0; i < M; i++)
+            for (memory::dim j = 0; j < p_.N; j++) {
+                int32_t ref = co[j];
+                for (memory::dim k = 0; k < p_.K; k++)
+                    ref += (int32_t)at(A, p_.transa, lda(M), i, k)
+                            * (int32_t)at(B, p_.transb, ldb(), k, j);
+                ASSERT_EQ(C[i * p_.N + j], ref);
+            }
+    }
+}
+
+TEST_P(packed_gemm_test, TestS8S8S32) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The packed GEMM API is supported on CPU only");
+    const auto B = make_matrix<int8_t>(p_.K * p_.N, 1);
+    packed_matrix packed_b;
+    ASSERT_EQ(gemm_s8s8s32_pack_b(packed_b, p_.transa, p_.transb, 16, p_.N,
+                      p_.K, B.data(), ldb()),
+            status::success);
+
+    for (memory::dim M : {1, 3, 16, 45}) {
+        const auto A = make_matrix<int8_t>(M * p_.K, 2);
+        const int32_t co = -2;
+        std::vector<int32_t> C(M * p_.N, 0);
+        ASSERT_EQ(gemm_s8s8s32_compute(p_.transa, 'F', M, p_.N, p_.K,
+                          A.data(), lda(M), packed_b, 0.f, C.data(), p_.N,
+                          &co),
+                status::success);
+        for (memory::dim i = 0; i < M; i++)
+            for (memory::dim j = 0; j < p_.N; j++) {
+                int32_t ref = co;
+                for (memory::dim k = 0; k < p_.K; k++)
+                    ref += (int32_t)at(A, p_.transa, lda(M), i, k)
+                            * (int32_t)at(B, p_.transb, ldb(), k, j);
+                ASSERT_EQ(C[i * p_.N + j], ref);
+            }
+    }
+}
+
+TEST_P(packed_gemm_test, TestInvalidArguments) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The packed GEMM API is supported on CPU only");
+    const auto B = make_matrix<float>(p_.K * p_.N, 1);
+    packed_matrix packed_b;
+    ASSERT_EQ(sgemm_pack_b(packed_b, p_.transa, p_.transb, 16, p_.N, p_.K,
+                      B.data(), ldb()),
+            status::success);
+
+    // the operation must match the packed matrix
+    const memory::dim M = 4;
+    const auto A = make_matrix<float>(M * (p_.K + 1), 2);
+    std::vector<float> C(M * (p_.N + 1));
+    EXPECT_EQ(sgemm_compute(p_.transa, M, p_.N + 1, p_.K, A.data(), lda(M),
+                      packed_b, 0.f, C.data(), p_.N + 1),
+            status::invalid_arguments);
+    EXPECT_EQ(sgemm_compute(is_trans(p_.transa) ? 'N' : 'T', M, p_.N, p_.K,
+                      A.data(), p_.K + M, packed_b, 0.f, C.data(), p_.N),
+            status::invalid_arguments);
+
+    // an f32 matrix cannot be used in an integer operation
+    const int32_t co = 0;
+    EXPECT_EQ(gemm_s8s8s32_compute(p_.transa, 'F', M, p_.N, p_.K,
+                      (const int8_t *)A.data(), lda(M), packed_b, 0.f,
+                      (int32_t *)C.data(), p_.N, &co),
+            status::invalid_arguments);
+}
+
+INSTANTIATE_TEST_SUITE_P(TestPackedGemm, packed_gemm_test,
+        ::testing::Values(packed_gemm_params {'N', 'N', 30, 20},
+                packed_gemm_params {'N', 'T', 64, 33},
+                packed_gemm_params {'T', 'N', 17, 128},
+                packed_gemm_params {'T', 'T', 100, 7}));
+
+} // namespace dnnl
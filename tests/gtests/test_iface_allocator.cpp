@@ -0,0 +1,160 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace dnnl {
+
+namespace {
+struct allocator_log_t {
+    int allocations[4] = {0, 0, 0, 0};
+    int deallocations[4] = {0, 0, 0, 0};
+    bool misaligned = false;
+};
+
+void *test_allocate(size_t size, size_t alignment, dnnl_memory_usage_t usage,
+        void *context) {
+    auto *log = static_cast<allocator_log_t *>(context);
+    log->allocations[usage]++;
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, size) != 0) ptr = nullptr;
+#endif
+    if (ptr && (uintptr_t)ptr % alignment != 0) log->misaligned = true;
+    return ptr;
+}
+
+void test_deallocate(void *ptr, dnnl_memory_usage_t usage, void *context) {
+    auto *log = static_cast<allocator_log_t *>(context);
+    log->deallocations[usage]++;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+} // namespace
+
+class allocator_test : public ::testing::Test {
+protected:
+    virtual void TearDown() { trim_scratchpad_arena(); }
+};
+
+TEST_F(allocator_test, TestUserAllocator) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Engine allocators are supported on CPU only");
+
+    allocator_log_t log;
+    {
+        engine eng(engine::kind::cpu, 0);
+        eng.set_allocator(test_allocate, test_deallocate, &log);
+
+        memory::desc md({2, 16, 8, 8}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        memory mem(md, eng);
+        EXPECT_EQ(log.allocations[dnnl_memory_usage_user], 1);
+
+        // the memory is deallocated with the allocator it was allocated
+        // with
+        eng.set_allocator(nullptr, nullptr);
+        memory other_mem(md, eng);
+        EXPECT_EQ(log.allocations[dnnl_memory_usage_user], 1);
+    }
+    EXPECT_EQ(log.deallocations[dnnl_memory_usage_user], 1);
+    EXPECT_FALSE(log.misaligned);
+}
+
+TEST_F(allocator_test, TestScratchpadUsage) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Engine allocators are supported on CPU only");
+
+    trim_scratchpad_arena();
+    allocator_log_t log;
+    {
+        engine eng(engine::kind::cpu, 0);
+        eng.set_allocator(test_allocate, test_deallocate, &log);
+
+        memory::desc src_md({2, 8, 12, 12}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        memory::desc wei_md({8, 8, 3, 3}, memory::data_type::f32,
+                memory::format_tag::oihw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, src_md,
+                {1, 1}, {1, 1}, {1, 1});
+        auto pd = convolution_forward::primitive_desc(desc, eng);
+        SKIP_IF(pd.scratchpad_desc().get_size() == 0,
+                "The convolution does not need a scratchpad");
+
+        memory src(src_md, eng), wei(wei_md, eng), dst(src_md, eng);
+        stream strm(eng);
+        convolution_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dst}});
+        strm.wait();
+        EXPECT_EQ(log.allocations[dnnl_memory_usage_user], 3);
+        EXPECT_EQ(log.allocations[dnnl_memory_usage_scratchpad], 1);
+        trim_scratchpad_arena();
+    }
+    for (int usage = 0; usage < 4; usage++)
+        EXPECT_EQ(log.allocations[usage], log.deallocations[usage]);
+    EXPECT_FALSE(log.misaligned);
+}
+
+TEST_F(allocator_test, TestLibraryAllocatorFlags) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Engine allocators are supported on CPU only");
+
+    engine eng(engine::kind::cpu, 0);
+    eng.set_allocator(engine::allocator_flags::huge_pages
+            | engine::allocator_flags::first_touch);
+
+    // first touch fills the memory with zeros
+    memory::desc md({4, 64, 64, 64}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    memory mem(md, eng);
+    auto mapped = map_memory<float>(mem);
+    const float *ptr = mapped;
+    bool zeros = true;
+    for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+        zeros = zeros && ptr[i] == 0.f;
+    EXPECT_TRUE(zeros);
+    EXPECT_EQ((uintptr_t)ptr % (2 * 1024 * 1024), 0u);
+}
+
+TEST_F(allocator_test, TestInvalidArguments) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Engine allocators are supported on CPU only");
+
+    engine eng(engine::kind::cpu, 0);
+    dnnl_allocator_t allocator = {test_allocate, nullptr, nullptr, 0};
+    EXPECT_EQ(dnnl_engine_set_allocator(eng.get(), &allocator),
+            dnnl_invalid_arguments);
+    allocator = {nullptr, nullptr, nullptr, 0x80};
+    EXPECT_EQ(dnnl_engine_set_allocator(eng.get(), &allocator),
+            dnnl_invalid_arguments);
+    EXPECT_EQ(dnnl_engine_set_allocator(eng.get(), nullptr), dnnl_success);
+}
+
+} // namespace dnnl
@@ -177,6 +177,36 @@ TEST_F(attr_test, TestPostOps) {
     ASSERT_EQ(alg, algorithm::eltwise_bounded_relu);
     ASSERT_FLOAT_EQ(alpha, 3.3f);
     ASSERT_FLOAT_EQ(beta, 4.4f);
+
+    memory::desc src1_md({1, 8, 1, 1}, memory::data_type::f32,
+            memory::format_tag::abcd);
+    ops.append_binary(algorithm::binary_add, src1_md);
+    attr.set_post_ops(ops);
+
+    ASSERT_EQ(attr.get_post_ops().len(), 3);
+    ASSERT_EQ(attr.get_post_ops().kind(2), primitive::kind::binary);
+    memory::desc src1_md_out;
+    attr.get_post_ops().get_params_binary(2, alg, src1_md_out);
+    ASSERT_EQ(alg, algorithm::binary_add);
+    ASSERT_EQ(src1_md, src1_md_out);
+
+    ops.append_dw_k3s2p1(memory::data_type::f32, memory::data_type::undef,
+            memory::data_type::f32);
+    attr.set_post_ops(ops);
+
+    ASSERT_EQ(attr.get_post_ops().len(), 4);
+    ASSERT_EQ(attr.get_post_ops().kind(3), primitive::kind::convolution);
+    memory::data_type wei_dt, bias_dt, dst_dt;
+    attr.get_post_ops().get_params_dw_k3s2p1(3, wei_dt, bias_dt, dst_dt);
+    ASSERT_EQ(wei_dt, memory::data_type::f32);
+    ASSERT_EQ(bias_dt, memory::data_type::undef);
+    ASSERT_EQ(dst_dt, memory::data_type::f32);
+    EXPECT_ANY_THROW(attr.get_post_ops().get_params_dw_k3s1p1(
+            3, wei_dt, bias_dt, dst_dt));
+
+    // a single depthwise post-op is supported
+    EXPECT_ANY_THROW(ops.append_dw_k3s1p1(memory::data_type::f32,
+            memory::data_type::f32, memory::data_type::f32));
 }
 
 } // namespace dnnl
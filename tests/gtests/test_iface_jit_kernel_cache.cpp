@@ -0,0 +1,152 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dnnl {
+
+#ifdef __linux__
+class jit_kernel_cache_test : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        char tmpl[] = "/tmp/dnnl_jit_kernel_cache.XXXXXX";
+        if (mkdtemp(tmpl)) dir_ = tmpl;
+    }
+
+    virtual void TearDown() {
+        set_jit_kernel_cache_dir("");
+        for (const auto &f : files()) unlink(f.c_str());
+        if (!dir_.empty()) rmdir(dir_.c_str());
+    }
+
+    std::vector<std::string> files() const {
+        std::vector<std::string> result;
+        DIR *d = opendir(dir_.c_str());
+        if (!d) return result;
+        while (struct dirent *e = readdir(d)) {
+            std::string name = e->d_name;
+            if (name != "." && name != "..")
+                result.push_back(dir_ + "/" + name);
+        }
+        closedir(d);
+        return result;
+    }
+
+    // A kernel is stored by renaming a new file over the old one, so a file
+    // keeps its inode only when the kernel is restored from it
+    std::map<std::string, ino_t> inodes() const {
+        std::map<std::string, ino_t> result;
+        for (const auto &f : files()) {
+            struct stat st;
+            if (stat(f.c_str(), &st) == 0) result[f] = st.st_ino;
+        }
+        return result;
+    }
+
+    static off_t file_size(const std::string &f) {
+        struct stat st;
+        return stat(f.c_str(), &st) == 0 ? st.st_size : 0;
+    }
+
+    // Runs a convolution and returns its output
+    std::vector<float> run_conv(const engine &eng) {
+        const memory::dim mb = 2, ic = 32, oc = 32, ih = 10, kh = 3;
+        memory::desc src_md({mb, ic, ih, ih}, memory::data_type::f32,
+                memory::format_tag::any);
+        memory::desc wei_md({oc, ic, kh, kh}, memory::data_type::f32,
+                memory::format_tag::any);
+        memory::desc dst_md({mb, oc, ih, ih}, memory::data_type::f32,
+                memory::format_tag::any);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, dst_md,
+                {1, 1}, {1, 1}, {1, 1});
+        post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_tanh, 0.f, 0.f);
+        primitive_attr attr;
+        attr.set_post_ops(ops);
+        auto pd = convolution_forward::primitive_desc(desc, attr, eng);
+
+        memory src(pd.src_desc(), eng), wei(pd.weights_desc(), eng),
+                dst(pd.dst_desc(), eng);
+        fill_data<float>(pd.src_desc().get_size() / sizeof(float), src);
+        fill_data<float>(pd.weights_desc().get_size() / sizeof(float), wei);
+
+        stream strm(eng);
+        convolution_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dst}});
+        strm.wait();
+
+        auto mapped_dst = map_memory<float>(dst);
+        const float *ptr = mapped_dst;
+        return std::vector<float>(
+                ptr, ptr + pd.dst_desc().get_size() / sizeof(float));
+    }
+
+    std::string dir_;
+};
+
+TEST_F(jit_kernel_cache_test, TestRestoredKernelsAreCorrect) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The JIT kernel cache is supported on CPU only");
+    ASSERT_FALSE(dir_.empty());
+
+    engine eng(get_test_engine_kind(), 0);
+    flush_primitive_cache();
+    const auto ref = run_conv(eng);
+
+    ASSERT_EQ(set_jit_kernel_cache_dir(dir_), status::success);
+    flush_primitive_cache();
+    EXPECT_EQ(run_conv(eng), ref);
+
+    const auto cached_files = files();
+    ASSERT_FALSE(cached_files.empty());
+    const auto cached_inodes = inodes();
+
+    // the kernels are restored from the cache and not stored again
+    flush_primitive_cache();
+    EXPECT_EQ(run_conv(eng), ref);
+    EXPECT_EQ(files(), cached_files);
+    EXPECT_EQ(inodes(), cached_inodes);
+
+    // corrupted files are ignored and replaced
+    for (const auto &f : cached_files)
+        ASSERT_EQ(truncate(f.c_str(), 16), 0);
+    flush_primitive_cache();
+    EXPECT_EQ(run_conv(eng), ref);
+    for (const auto &f : cached_files)
+        EXPECT_GT(file_size(f), 16);
+    flush_primitive_cache();
+    EXPECT_EQ(run_conv(eng), ref);
+}
+#endif
+
+} // namespace dnnl
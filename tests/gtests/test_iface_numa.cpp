@@ -0,0 +1,279 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include <omp.h>
+#endif
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
+#define NUMA_BINDING_SUPPORTED 1
+#else
+#define NUMA_BINDING_SUPPORTED 0
+#endif
+
+namespace dnnl {
+
+#ifdef __linux__
+// Returns the CPUs the calling thread may run on
+static std::vector<int> get_affinity() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    return cpus;
+}
+#endif
+
+class numa_test : public ::testing::Test {
+protected:
+    // The fake topology splits the CPUs of the process into two nodes, or
+    // has two nodes with the same CPU if the process has only one
+    struct topology_t {
+        bool is_set = false;
+        std::vector<int> process_cpus;
+        std::vector<std::vector<int>> nodes;
+    };
+
+    static const topology_t &topology() {
+        static const topology_t t = init_topology();
+        return t;
+    }
+
+    static topology_t init_topology() {
+        topology_t t;
+#ifdef __linux__
+        // the library reads the topology once, so it is set before the
+        // first query, unless another one is set
+        if (getenv("DNNL_NUMA_TOPOLOGY")) return t;
+        t.process_cpus = get_affinity();
+        const size_t ncpus = t.process_cpus.size();
+        if (ncpus == 0) return t;
+        const size_t half = (ncpus + 1) / 2;
+        t.nodes.emplace_back(
+                t.process_cpus.begin(), t.process_cpus.begin() + half);
+        if (half == ncpus)
+            t.nodes.push_back(t.nodes[0]);
+        else
+            t.nodes.emplace_back(
+                    t.process_cpus.begin() + half, t.process_cpus.end());
+        std::string env;
+        for (const auto &cpus : t.nodes) {
+            if (!env.empty()) env += ";";
+            for (size_t i = 0; i < cpus.size(); i++)
+                env += (i ? "," : "") + std::to_string(cpus[i]);
+        }
+        setenv("DNNL_NUMA_TOPOLOGY", env.c_str(), 1);
+        t.is_set = true;
+#endif
+        return t;
+    }
+
+    virtual void SetUp() {
+        if (get_test_engine_kind() != engine::kind::cpu) return;
+        topology();
+        eng_ = engine(engine::kind::cpu, 0);
+        create_pd();
+
+        src_ = memory(pd_.src_desc(), eng_);
+        wei_ = memory(pd_.weights_desc(), eng_);
+        fill_data<float>(pd_.src_desc().get_size() / sizeof(float), src_);
+        fill_data<float>(pd_.weights_desc().get_size() / sizeof(float), wei_);
+    }
+
+    // Creates the convolution for the current number of threads
+    void create_pd() {
+        memory::desc src_md({2, 8, 12, 12}, memory::data_type::f32,
+                memory::format_tag::any);
+        memory::desc wei_md({8, 8, 3, 3}, memory::data_type::f32,
+                memory::format_tag::any);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, src_md,
+                {1, 1}, {1, 1}, {1, 1});
+        pd_ = convolution_forward::primitive_desc(desc, eng_);
+    }
+
+    // Returns a stream bound to a NUMA node
+    stream make_stream(int node) {
+        stream_attr attr(engine::kind::cpu);
+        attr.set_numa_node(node);
+        EXPECT_EQ(attr.get_numa_node(), node);
+        return stream(eng_, stream::flags::default_flags, attr);
+    }
+
+    // Executes the convolution on the stream and returns its output
+    std::vector<float> run(stream &strm) {
+        memory dst(pd_.dst_desc(), eng_);
+        convolution_forward(pd_).execute(strm,
+                {{DNNL_ARG_SRC, src_}, {DNNL_ARG_WEIGHTS, wei_},
+                        {DNNL_ARG_DST, dst}});
+        strm.wait();
+
+        auto mapped_dst = map_memory<float>(dst);
+        const float *ptr = mapped_dst;
+        return std::vector<float>(
+                ptr, ptr + pd_.dst_desc().get_size() / sizeof(float));
+    }
+
+    engine eng_;
+    convolution_forward::primitive_desc pd_;
+    memory src_, wei_;
+};
+
+TEST_F(numa_test, TestTopology) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "NUMA nodes are supported on CPU only");
+
+    const int nnodes = get_numa_node_count();
+    ASSERT_GE(nnodes, 1);
+
+    stream_attr attr(engine::kind::cpu);
+    EXPECT_EQ(attr.get_numa_node(), -1);
+    EXPECT_EQ(dnnl_stream_attr_set_numa_node(attr.get(), nnodes),
+            dnnl_invalid_arguments);
+    EXPECT_EQ(dnnl_stream_attr_set_numa_node(attr.get(), -2),
+            dnnl_invalid_arguments);
+    EXPECT_EQ(dnnl_stream_attr_set_numa_node(attr.get(), nnodes - 1),
+            NUMA_BINDING_SUPPORTED ? dnnl_success : dnnl_unimplemented);
+    EXPECT_EQ(dnnl_stream_attr_set_numa_node(attr.get(), -1), dnnl_success);
+    if (topology().is_set) EXPECT_EQ(nnodes, 2);
+
+    stream_attr gpu_attr(engine::kind::gpu);
+    EXPECT_EQ(dnnl_stream_attr_set_numa_node(gpu_attr.get(), 0),
+            dnnl_invalid_arguments);
+}
+
+TEST_F(numa_test, TestBoundExecution) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "NUMA nodes are supported on CPU only");
+    SKIP_IF(!NUMA_BINDING_SUPPORTED, "NUMA binding is not supported");
+
+    stream strm(eng_);
+    const auto ref = run(strm);
+    for (int node = 0; node < get_numa_node_count(); node++) {
+        stream node_strm = make_stream(node);
+        EXPECT_EQ(run(node_strm), ref);
+        // the threads are unbound for a stream without a node
+        EXPECT_EQ(run(strm), ref);
+    }
+}
+
+TEST_F(numa_test, TestWeightsReplication) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "NUMA nodes are supported on CPU only");
+    SKIP_IF(!NUMA_BINDING_SUPPORTED, "NUMA binding is not supported");
+
+    stream strm(eng_);
+    const int last_node = get_numa_node_count() - 1;
+    stream node_strm = make_stream(last_node);
+    const auto ref = run(strm);
+
+    wei_.set_numa_replicated();
+    EXPECT_EQ(run(node_strm), ref);
+
+    // the node keeps its copy of the weights even if the original ones are
+    // modified in place...
+    const size_t wei_size = pd_.weights_desc().get_size();
+    {
+        auto mapped_wei = map_memory<float>(wei_);
+        memset((float *)mapped_wei, 0, wei_size);
+    }
+    const auto zeros = run(strm);
+    EXPECT_NE(zeros, ref);
+    EXPECT_EQ(run(node_strm), ref);
+
+    // ... but drops it when the data handle changes
+    std::vector<float> buf(wei_size / sizeof(float), 0.f);
+    wei_.set_data_handle(buf.data());
+    EXPECT_EQ(run(node_strm), zeros);
+
+    // the memory which is not replicated is used as is
+    wei_.set_numa_replicated(false);
+    fill_data<float>(wei_size / sizeof(float), buf.data());
+    EXPECT_EQ(run(node_strm), run(strm));
+    EXPECT_NE(run(node_strm), zeros);
+}
+
+#ifdef __linux__
+TEST_F(numa_test, TestThreadAffinity) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "NUMA nodes are supported on CPU only");
+    SKIP_IF(!NUMA_BINDING_SUPPORTED, "NUMA binding is not supported");
+    SKIP_IF(!topology().is_set, "The topology is set by the environment");
+
+    const int node = get_numa_node_count() - 1;
+    const auto &node_cpus = topology().nodes[node];
+    const auto &process_cpus = topology().process_cpus;
+    stream node_strm = make_stream(node);
+    stream strm(eng_);
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // the primitive is created for more threads than the node has CPUs
+    const int saved_nthr = omp_get_max_threads();
+    const int nthr = (int)node_cpus.size() + 2;
+    omp_set_num_threads(nthr);
+    create_pd();
+
+    // Returns the CPUs of each thread of a team of n threads
+    auto get_team_affinity = [](int n) {
+        std::vector<std::vector<int>> cpus(n);
+#pragma omp parallel num_threads(n)
+        cpus[omp_get_thread_num()] = get_affinity();
+        return cpus;
+    };
+#endif
+
+    const auto ref = run(strm);
+    EXPECT_EQ(run(node_strm), ref);
+    // the calling thread stays bound to the node between the executions
+    EXPECT_EQ(get_affinity(), node_cpus);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // the threads of the runtime stay bound as well, and the number of
+    // threads is restored
+    EXPECT_EQ(omp_get_max_threads(), nthr);
+    const int team_size = (int)node_cpus.size();
+    for (const auto &cpus : get_team_affinity(team_size))
+        EXPECT_EQ(cpus, node_cpus);
+#endif
+
+    // all the threads are bound back to the CPUs the process had when the
+    // library was loaded
+    EXPECT_EQ(run(strm), ref);
+    EXPECT_EQ(get_affinity(), process_cpus);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    for (const auto &cpus : get_team_affinity(team_size))
+        EXPECT_EQ(cpus, process_cpus);
+    omp_set_num_threads(saved_nthr);
+#endif
+}
+#endif
+
+} // namespace dnnl
@@ -0,0 +1,246 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#include <string>
+#include <vector>
+
+namespace dnnl {
+
+class primitive_cache_test : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        old_capacity_ = get_primitive_cache_capacity();
+        is_enabled_ = set_primitive_cache_capacity(old_capacity_)
+                == status::success;
+        if (is_enabled_) flush_primitive_cache();
+    }
+
+    virtual void TearDown() {
+        if (!is_enabled_) return;
+        set_primitive_cache_capacity(old_capacity_);
+        set_primitive_cache_memory_capacity(0);
+        flush_primitive_cache();
+    }
+
+    static eltwise_forward create_relu(const engine &eng, memory::dim n) {
+        memory::desc md({n, 16, 4, 4}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        eltwise_forward::desc ed(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, 0.f, 0.f);
+        return eltwise_forward(eltwise_forward::primitive_desc(ed, eng));
+    }
+
+    int old_capacity_;
+    bool is_enabled_;
+};
+
+TEST_F(primitive_cache_test, TestCapacity) {
+    SKIP_IF(!is_enabled_, "Primitive cache is disabled");
+
+    EXPECT_EQ(set_primitive_cache_capacity(11), status::success);
+    EXPECT_EQ(get_primitive_cache_capacity(), 11);
+    EXPECT_EQ(dnnl_set_primitive_cache_capacity(-1), dnnl_invalid_arguments);
+    EXPECT_EQ(get_primitive_cache_capacity(), 11);
+}
+
+TEST_F(primitive_cache_test, TestHitsMissesAndFlush) {
+    SKIP_IF(!is_enabled_, "Primitive cache is disabled");
+    ASSERT_EQ(set_primitive_cache_capacity(8), status::success);
+
+    engine eng(get_test_engine_kind(), 0);
+    auto s0 = get_primitive_cache_stats();
+    EXPECT_EQ(s0.size, 0u);
+
+    create_relu(eng, 1);
+    create_relu(eng, 1);
+    create_relu(eng, 2);
+
+    auto s1 = get_primitive_cache_stats();
+    EXPECT_EQ(s1.misses - s0.misses, 2u);
+    EXPECT_EQ(s1.hits - s0.hits, 1u);
+    EXPECT_EQ(s1.size, 2u);
+
+    ASSERT_EQ(flush_primitive_cache(), status::success);
+    auto s2 = get_primitive_cache_stats();
+    EXPECT_EQ(s2.size, 0u);
+    EXPECT_EQ(s2.memory_size, 0u);
+
+    create_relu(eng, 1);
+    auto s3 = get_primitive_cache_stats();
+    EXPECT_EQ(s3.misses - s2.misses, 1u);
+}
+
+TEST_F(primitive_cache_test, TestEviction) {
+    SKIP_IF(!is_enabled_, "Primitive cache is disabled");
+    ASSERT_EQ(set_primitive_cache_capacity(2), status::success);
+
+    engine eng(get_test_engine_kind(), 0);
+    auto s0 = get_primitive_cache_stats();
+    for (memory::dim n = 1; n <= 4; n++)
+        create_relu(eng, n);
+
+    auto s1 = get_primitive_cache_stats();
+    EXPECT_EQ(s1.size, 2u);
+    EXPECT_EQ(s1.evictions - s0.evictions, 2u);
+
+    // the least recently used primitives are evicted
+    create_relu(eng, 4);
+    create_relu(eng, 1);
+    auto s2 = get_primitive_cache_stats();
+    EXPECT_EQ(s2.hits - s1.hits, 1u);
+    EXPECT_EQ(s2.misses - s1.misses, 1u);
+
+    // shrinking the capacity evicts the excess primitives
+    ASSERT_EQ(set_primitive_cache_capacity(1), status::success);
+    EXPECT_EQ(get_primitive_cache_stats().size, 1u);
+}
+
+TEST_F(primitive_cache_test, TestMemoryCapacity) {
+    SKIP_IF(!is_enabled_, "Primitive cache is disabled");
+    ASSERT_EQ(set_primitive_cache_capacity(8), status::success);
+
+    engine eng(get_test_engine_kind(), 0);
+    create_relu(eng, 1);
+    create_relu(eng, 2);
+    auto s0 = get_primitive_cache_stats();
+    EXPECT_EQ(s0.size, 2u);
+
+    // keep at most the memory of the largest primitive
+    ASSERT_EQ(set_primitive_cache_memory_capacity(s0.memory_size - 1),
+            status::success);
+    auto s1 = get_primitive_cache_stats();
+    EXPECT_LE(s1.memory_size, s0.memory_size - 1);
+    if (s0.memory_size > 0) { EXPECT_LT(s1.size, 2u); }
+}
+
+TEST_F(primitive_cache_test, TestSharingBetweenEngines) {
+    SKIP_IF(!is_enabled_, "Primitive cache is disabled");
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Primitives are shared between CPU engines only");
+    ASSERT_EQ(set_primitive_cache_capacity(8), status::success);
+
+    auto s0 = get_primitive_cache_stats();
+    {
+        engine eng(get_test_engine_kind(), 0);
+        create_relu(eng, 1);
+    }
+
+    // the primitive outlives the engine that created it
+    engine eng(get_test_engine_kind(), 0);
+    auto relu = create_relu(eng, 1);
+    auto s1 = get_primitive_cache_stats();
+    EXPECT_EQ(s1.hits - s0.hits, 1u);
+    EXPECT_EQ(s1.misses - s0.misses, 1u);
+
+    memory::desc md(
+            {1, 16, 4, 4}, memory::data_type::f32, memory::format_tag::nchw);
+    memory src(md, eng), dst(md, eng);
+    stream strm(eng);
+    relu.execute(strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    strm.wait();
+}
+
+TEST_F(primitive_cache_test, TestWarmUp) {
+    engine eng(get_test_engine_kind(), 0);
+
+    std::vector<eltwise_forward::desc> descs;
+    for (memory::dim n = 1; n <= 6; n++) {
+        memory::desc md({n, 16, 4, 4}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        descs.emplace_back(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, 0.f, 0.f);
+    }
+    std::vector<const_dnnl_op_desc_t> op_descs;
+    for (const auto &d : descs)
+        op_descs.push_back(&d.data);
+    // an invalid descriptor fails alone
+    op_descs.push_back(nullptr);
+
+    auto s0 = is_enabled_ ? get_primitive_cache_stats()
+                          : primitive_cache_stats_t();
+    auto results = warm_up_primitive_cache(eng, op_descs, {}, 4);
+    ASSERT_EQ(results.size(), op_descs.size());
+    for (size_t i = 0; i < descs.size(); i++) {
+        EXPECT_EQ(results[i].creation_status, status::success);
+        EXPECT_GE(results[i].time_ms, 0.);
+    }
+    EXPECT_EQ(results.back().creation_status, status::invalid_arguments);
+
+    if (!is_enabled_) return;
+
+    // the primitives created later are taken from the cache
+    auto s1 = get_primitive_cache_stats();
+    EXPECT_EQ(s1.misses - s0.misses, descs.size());
+    for (memory::dim n = 1; n <= 6; n++)
+        create_relu(eng, n);
+    auto s2 = get_primitive_cache_stats();
+    EXPECT_EQ(s2.hits - s1.hits, descs.size());
+    EXPECT_EQ(s2.misses, s1.misses);
+}
+
+TEST_F(primitive_cache_test, TestJitCodeSize) {
+    EXPECT_EQ(dnnl_get_jit_code_size(nullptr), dnnl_invalid_arguments);
+
+    engine eng(get_test_engine_kind(), 0);
+    memory::desc md(
+            {3, 16, 4, 4}, memory::data_type::f32, memory::format_tag::nchw);
+    eltwise_forward::desc ed(prop_kind::forward_inference,
+            algorithm::eltwise_relu, md, 0.f, 0.f);
+    eltwise_forward::primitive_desc pd(ed, eng);
+    SKIP_IF(std::string(pd.impl_info_str()).find("jit") != 0,
+            "Relu is not implemented with a JIT kernel");
+
+    const size_t size0 = get_jit_code_size();
+    eltwise_forward relu(pd);
+    const size_t size1 = get_jit_code_size();
+    EXPECT_GT(size1, size0);
+
+    // no code is generated for a primitive taken from the cache
+    if (!is_enabled_) return;
+    create_relu(eng, 3);
+    EXPECT_EQ(get_jit_code_size(), size1);
+}
+
+TEST_F(primitive_cache_test, TestPrimitiveDescIteration) {
+    engine eng(get_test_engine_kind(), 0);
+    memory::desc md(
+            {2, 32, 8, 8}, memory::data_type::f32, memory::format_tag::any);
+    eltwise_forward::desc ed(prop_kind::forward_training,
+            algorithm::eltwise_relu, md, 0.f, 0.f);
+
+    // a primitive descriptor taken from the cache must be iterated over
+    // exactly as a newly created one
+    auto get_impls = [&]() {
+        std::vector<std::string> impls;
+        eltwise_forward::primitive_desc pd(ed, eng);
+        do {
+            impls.emplace_back(pd.impl_info_str());
+        } while (pd.next_impl());
+        return impls;
+    };
+
+    auto impls0 = get_impls();
+    auto impls1 = get_impls();
+    ASSERT_FALSE(impls0.empty());
+    EXPECT_EQ(impls0, impls1);
+}
+
+} // namespace dnnl
@@ -0,0 +1,154 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace dnnl {
+
+class scratchpad_arena_test : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        if (get_test_engine_kind() != engine::kind::cpu) return;
+        eng_ = engine(engine::kind::cpu, 0);
+
+        // plain layouts make the convolution use an im2col buffer in the
+        // scratchpad
+        const memory::dim mb = 2, ic = 8, oc = 8, ih = 12, kh = 3;
+        memory::desc src_md({mb, ic, ih, ih}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        memory::desc wei_md({oc, ic, kh, kh}, memory::data_type::f32,
+                memory::format_tag::oihw);
+        memory::desc dst_md({mb, oc, ih, ih}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, dst_md,
+                {1, 1}, {1, 1}, {1, 1});
+        pd_ = convolution_forward::primitive_desc(desc, eng_);
+
+        src_ = memory(pd_.src_desc(), eng_);
+        wei_ = memory(pd_.weights_desc(), eng_);
+        fill_data<float>(pd_.src_desc().get_size() / sizeof(float), src_);
+        fill_data<float>(pd_.weights_desc().get_size() / sizeof(float), wei_);
+    }
+
+    virtual void TearDown() {
+        set_scratchpad_arena_trim_threshold(SIZE_MAX);
+        trim_scratchpad_arena();
+    }
+
+    // Executes the convolution and returns its output
+    std::vector<float> run(const convolution_forward &conv) {
+        memory dst(pd_.dst_desc(), eng_);
+        stream strm(eng_);
+        conv.execute(strm,
+                {{DNNL_ARG_SRC, src_}, {DNNL_ARG_WEIGHTS, wei_},
+                        {DNNL_ARG_DST, dst}});
+        strm.wait();
+
+        auto mapped_dst = map_memory<float>(dst);
+        const float *ptr = mapped_dst;
+        return std::vector<float>(
+                ptr, ptr + pd_.dst_desc().get_size() / sizeof(float));
+    }
+
+    // Returns true if the scratchpad of the convolution is served by the
+    // arena, which is not the case for GPU engines, for builds with
+    // DNNL_ENABLE_CONCURRENT_EXEC=ON and for implementations that do not
+    // need a scratchpad
+    bool uses_arena() {
+        if (get_test_engine_kind() != engine::kind::cpu) return false;
+        if (pd_.scratchpad_desc().get_size() == 0) return false;
+        const size_t requests = get_scratchpad_arena_stats().requests;
+        run(convolution_forward(pd_));
+        return get_scratchpad_arena_stats().requests > requests;
+    }
+
+    engine eng_;
+    convolution_forward::primitive_desc pd_;
+    memory src_, wei_;
+};
+
+TEST_F(scratchpad_arena_test, TestReuseAcrossExecutions) {
+    SKIP_IF(!uses_arena(), "The scratchpad arena is not used");
+
+    convolution_forward conv(pd_), other_conv(pd_);
+    run(conv);
+    const auto s0 = get_scratchpad_arena_stats();
+    EXPECT_GE(s0.reserved_bytes, pd_.scratchpad_desc().get_size());
+    EXPECT_GE(s0.peak_reserved_bytes, s0.reserved_bytes);
+
+    // the memory is kept between executions and shared by the primitives
+    for (int i = 0; i < 3; i++) {
+        run(conv);
+        run(other_conv);
+    }
+    const auto s1 = get_scratchpad_arena_stats();
+    EXPECT_EQ(s1.requests, s0.requests + 6);
+    EXPECT_EQ(s1.allocations, s0.allocations);
+    EXPECT_EQ(s1.reserved_bytes, s0.reserved_bytes);
+
+    ASSERT_EQ(trim_scratchpad_arena(), status::success);
+    EXPECT_LE(get_scratchpad_arena_stats().reserved_bytes,
+            s0.reserved_bytes - pd_.scratchpad_desc().get_size());
+}
+
+TEST_F(scratchpad_arena_test, TestTrimThreshold) {
+    SKIP_IF(!uses_arena(), "The scratchpad arena is not used");
+
+    ASSERT_EQ(trim_scratchpad_arena(), status::success);
+    ASSERT_EQ(set_scratchpad_arena_trim_threshold(0), status::success);
+
+    convolution_forward conv(pd_);
+    const auto s0 = get_scratchpad_arena_stats();
+    const auto ref = run(conv);
+    EXPECT_EQ(run(conv), ref);
+    const auto s1 = get_scratchpad_arena_stats();
+    EXPECT_EQ(s1.requests, s0.requests + 2);
+    EXPECT_EQ(s1.allocations, s0.allocations + 2);
+    EXPECT_EQ(s1.reserved_bytes, s0.reserved_bytes);
+}
+
+TEST_F(scratchpad_arena_test, TestConcurrentExecution) {
+    SKIP_IF(!uses_arena(), "The scratchpad arena is not used");
+
+    // each thread uses its own arena, so the same primitive can be executed
+    // by several threads at a time
+    convolution_forward conv(pd_);
+    const auto ref = run(conv);
+
+    const int nthreads = 4;
+    std::vector<std::vector<float>> results(nthreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; t++)
+        threads.emplace_back([&, t]() {
+            results[t] = run(conv);
+            trim_scratchpad_arena();
+        });
+    for (auto &t : threads)
+        t.join();
+
+    for (int t = 0; t < nthreads; t++)
+        EXPECT_EQ(results[t], ref);
+}
+
+} // namespace dnnl
@@ -330,6 +330,11 @@ static auto cases_ef = []() {
                              {{1, 1, 2}, data_type::s8, tag::abc},
                              {{1, 11, 2}, data_type::s8, tag::abc}},
             {}, true, dnnl_invalid_arguments});
+    // inconsistent batch: only a batch of 1 can be broadcast
+    cases.push_back({{{{2, 10, 1}, data_type::f32, tag::abc},
+                             {{1, 1, 2}, data_type::f32, tag::abc},
+                             {{3, 10, 2}, data_type::f32, tag::abc}},
+            {}, true, dnnl_invalid_arguments});
 
     // f32 data and zero-points
     cases.push_back({{{{10, 1}, data_type::f32, tag::ab},
@@ -419,6 +424,15 @@ static auto cases_f = [](memory::data_type dt) {
             {P::SCALES | P::COMMON | P::RUNTIME, {},
                     {{primitive::kind::sum}}}});
 
+    // batched + broadcast weights
+    cases.push_back({{{{3, 10, 2}, dt, tag::abc}, {{1, 2, 20}, dt, tag::abc},
+                             {{3, 10, 20}, dt, tag::abc}, data_type::f32},
+            {}});
+    // batched + broadcast src + output scale + post-ops(sum)
+    cases.push_back({{{{1, 10, 2}, dt, tag::abc}, {{3, 2, 20}, dt, tag::abc},
+                             {{3, 10, 20}, dt, tag::abc}},
+            {P::SCALES | P::COMMON, {}, {{primitive::kind::sum}}}});
+
     return ::testing::ValuesIn(cases);
 };
 
@@ -513,6 +527,15 @@ static auto cases_x8 = [](memory::data_type src_dt, memory::data_type dst_dt) {
                             P::ZERO_POINTS | P::DST | P::COMMON | P::RUNTIME},
                     {{primitive::kind::sum}}}});
 
+    // batched + broadcast weights + zero points
+    cases.push_back(
+            {{{{3, 10, 2}, src_dt, tag::abc},
+                     {{1, 2, 20}, data_type::s8, tag::acb},
+                     {{3, 10, 20}, dst_dt, tag::abc}, data_type::f32},
+                    {P::SCALES | P::COMMON,
+                            {P::ZERO_POINTS | P::SRC | P::COMMON, P::NONE,
+                                    P::ZERO_POINTS | P::DST | P::COMMON}}});
+
     return ::testing::ValuesIn(cases);
 };
 INSTANTIATE_TEST_SUITE_P(
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "dnnl.hpp"
+
+namespace dnnl {
+
+namespace {
+
+// Creates a convolution that is unique for the given id so that every call
+// with a distinct id misses the primitive cache
+convolution_forward create_conv(const engine &eng, int id) {
+    const memory::dim ic = 16 * (1 + id % 8), oc = 16 * (1 + id / 8);
+    memory::desc src_md({2, ic, 14, 14}, memory::data_type::f32,
+            memory::format_tag::any);
+    memory::desc wei_md({oc, ic, 3, 3}, memory::data_type::f32,
+            memory::format_tag::any);
+    memory::desc dst_md({2, oc, 14, 14}, memory::data_type::f32,
+            memory::format_tag::any);
+    convolution_forward::desc cd(prop_kind::forward_inference,
+            algorithm::convolution_direct, src_md, wei_md, dst_md, {1, 1},
+            {1, 1}, {1, 1});
+    convolution_forward::primitive_desc pd(cd, eng);
+    return convolution_forward(pd);
+}
+
+// Creates `n_prims` primitives from `nthr` threads and returns the creation
+// throughput in primitives per second. Ids in [id_base, id_base + n_prims)
+// are distributed over the threads unless `same_key` is set, in which case
+// every thread creates the very same primitive.
+double create_concurrently(const engine &eng, int nthr, int n_prims,
+        int id_base, bool same_key) {
+    std::vector<std::thread> threads;
+    std::vector<int> failures(nthr, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        threads.emplace_back([&, ithr]() {
+            for (int i = ithr; i < n_prims; i += nthr) {
+                try {
+                    create_conv(eng, same_key ? id_base : id_base + i);
+                } catch (error &) { failures[ithr]++; }
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    for (int ithr = 0; ithr < nthr; ithr++)
+        EXPECT_EQ(failures[ithr], 0);
+
+    double sec = std::chrono::duration<double>(end - start).count();
+    return sec > 0 ? n_prims / sec : 0;
+}
+
+} // namespace
+
+class primitive_cache_mt_test : public ::testing::Test {};
+
+// Reports how primitive creation throughput scales with the number of
+// threads creating distinct primitives concurrently.
+TEST_F(primitive_cache_mt_test, CreationThroughput) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Test is designed for CPU engine only");
+    engine eng(get_test_engine_kind(), 0);
+
+    const int n_prims = 32;
+    int id_base = 0;
+    for (int nthr : {1, 2, 4, 8}) {
+        double tput = create_concurrently(eng, nthr, n_prims, id_base, false);
+        std::cout << "[ INFO     ] threads: " << nthr
+                  << ", distinct primitives: " << n_prims
+                  << ", creation throughput: " << tput << " prims/s"
+                  << std::endl;
+        // use new ids for every run so that all the creations are misses
+        id_base += 64;
+    }
+}
+
+TEST_F(primitive_cache_mt_test, SamePrimitiveConcurrently) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Test is designed for CPU engine only");
+    engine eng(get_test_engine_kind(), 0);
+    create_concurrently(eng, 8, 32, 0, true);
+}
+
+} // namespace dnnl
@@ -14,14 +14,23 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cmath>
 #include <numeric>
+#include <stdlib.h>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
+#include "cpu_isa_traits.hpp"
 #include "dnnl.hpp"
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include <omp.h>
+#endif
+
 namespace dnnl {
 
 struct test_rnn_sizes_t {
@@ -505,4 +514,522 @@ CPU_INSTANTIATE_TEST_SUITE_P(TestRNN_failure, rnn_forward_test_f32,
                 //               L  D  T  MB  SLC  SIC  DLC  DIC
                 test_rnn_sizes_t(1, 1, 1, 1, 10, 5, 5, 5)}));
 
+TEST(rnn_seq_lengths_test, TestSequencesShorterThanIterations) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Sequences of different lengths are supported on CPU only");
+
+    // all the sequences end before the last iterations, which are not
+    // computed at all
+    auto eng = engine(get_test_engine_kind(), 0);
+    auto strm = stream(eng);
+    const memory::dim l = 2, d = 1, t = 5, mb = 3, c = 8, g = 4;
+    const std::vector<int32_t> seq_lengths = {3, 2, 1};
+    const auto dt = memory::data_type::f32;
+
+    memory::desc weights_md({l, d, c, g, c}, dt, fmt::ldigo);
+    memory::desc bias_md({l, d, g, c}, dt, fmt::ldgo);
+    memory weights_layer(weights_md, eng), weights_iter(weights_md, eng),
+            bias(bias_md, eng);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_layer);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_iter);
+    fill_data<float>(bias_md.get_size() / sizeof(float), bias);
+
+    auto run = [&](memory::dim at, memory::dim amb, rnn_flags flags,
+                       memory &src_layer, memory &src_iter, memory &src_iter_c,
+                       memory &dst_layer, memory &dst_iter, memory &dst_iter_c,
+                       const memory *lengths) {
+        memory::desc layer_md({at, amb, c}, dt, fmt::tnc);
+        memory::desc iter_md({l, d, amb, c}, dt, fmt::ldnc);
+        lstm_forward::primitive_desc pd(
+                lstm_forward::desc(prop_kind::forward_inference,
+                        dir::unidirectional_left2right, layer_md, iter_md,
+                        iter_md, weights_md, weights_md, bias_md, layer_md,
+                        iter_md, iter_md, flags),
+                eng);
+        std::unordered_map<int, memory> args = {
+                {DNNL_ARG_SRC_LAYER, src_layer}, {DNNL_ARG_SRC_ITER, src_iter},
+                {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                {DNNL_ARG_WEIGHTS_ITER, weights_iter}, {DNNL_ARG_BIAS, bias},
+                {DNNL_ARG_DST_LAYER, dst_layer}, {DNNL_ARG_DST_ITER, dst_iter},
+                {DNNL_ARG_DST_ITER_C, dst_iter_c}};
+        if (lengths) args.insert({DNNL_ARG_SRC_SEQ_LENGTHS, *lengths});
+        lstm_forward(pd).execute(strm, args);
+        strm.wait();
+    };
+
+    memory::desc layer_md({t, mb, c}, dt, fmt::tnc);
+    memory::desc iter_md({l, d, mb, c}, dt, fmt::ldnc);
+    memory src_layer(layer_md, eng), src_iter(iter_md, eng),
+            src_iter_c(iter_md, eng), dst_layer(layer_md, eng),
+            dst_iter(iter_md, eng), dst_iter_c(iter_md, eng),
+            lengths({{mb}, memory::data_type::s32, fmt::a}, eng);
+    fill_data<float>(layer_md.get_size() / sizeof(float), src_layer);
+    fill_data<float>(iter_md.get_size() / sizeof(float), src_iter);
+    fill_data<float>(iter_md.get_size() / sizeof(float), src_iter_c);
+    {
+        auto ptr = map_memory<int32_t>(lengths);
+        for (memory::dim b = 0; b < mb; b++)
+            ptr[b] = seq_lengths[b];
+    }
+    run(t, mb, rnn_flags::variable_length, src_layer, src_iter, src_iter_c,
+            dst_layer, dst_iter, dst_iter_c, &lengths);
+
+    // each sequence is compared to a run of its own iterations only
+    for (memory::dim b = 0; b < mb; b++) {
+        const memory::dim len = seq_lengths[b];
+        memory::desc b_layer_md({len, 1, c}, dt, fmt::tnc);
+        memory::desc b_iter_md({l, d, 1, c}, dt, fmt::ldnc);
+        memory b_src_layer(b_layer_md, eng), b_src_iter(b_iter_md, eng),
+                b_src_iter_c(b_iter_md, eng), b_dst_layer(b_layer_md, eng),
+                b_dst_iter(b_iter_md, eng), b_dst_iter_c(b_iter_md, eng);
+        {
+            auto src = map_memory<float>(src_layer);
+            auto b_src = map_memory<float>(b_src_layer);
+            for (memory::dim it = 0; it < len; it++)
+                for (memory::dim k = 0; k < c; k++)
+                    b_src[it * c + k] = src[(it * mb + b) * c + k];
+        }
+        for (auto p : {std::make_pair(&src_iter, &b_src_iter),
+                     std::make_pair(&src_iter_c, &b_src_iter_c)}) {
+            auto src = map_memory<float>(*p.first);
+            auto b_src = map_memory<float>(*p.second);
+            for (memory::dim ld = 0; ld < l * d; ld++)
+                for (memory::dim k = 0; k < c; k++)
+                    b_src[ld * c + k] = src[(ld * mb + b) * c + k];
+        }
+        run(len, 1, rnn_flags::undef, b_src_layer, b_src_iter, b_src_iter_c,
+                b_dst_layer, b_dst_iter, b_dst_iter_c, nullptr);
+
+        {
+            auto dst = map_memory<float>(dst_layer);
+            auto ref = map_memory<float>(b_dst_layer);
+            for (memory::dim it = 0; it < t; it++)
+                for (memory::dim k = 0; k < c; k++) {
+                    const float r = it < len ? ref[it * c + k] : 0.f;
+                    ASSERT_NEAR(dst[(it * mb + b) * c + k], r, 1e-5f);
+                }
+        }
+        for (auto p : {std::make_pair(&dst_iter, &b_dst_iter),
+                     std::make_pair(&dst_iter_c, &b_dst_iter_c)}) {
+            auto dst = map_memory<float>(*p.first);
+            auto ref = map_memory<float>(*p.second);
+            for (memory::dim ld = 0; ld < l * d; ld++)
+                for (memory::dim k = 0; k < c; k++)
+                    ASSERT_NEAR(dst[(ld * mb + b) * c + k], ref[ld * c + k],
+                            1e-5f);
+        }
+    }
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP && !defined(_WIN32)
+TEST(rnn_wavefront_test, TestWavefrontMatchesLinear) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The wavefront execution is supported on CPU only");
+
+    // the cells of a wavefront run on different threads, which may
+    // oversubscribe the cores
+    const int saved_nthr = omp_get_max_threads();
+    omp_set_num_threads(4);
+
+    auto eng = engine(get_test_engine_kind(), 0);
+    auto strm = stream(eng);
+    const memory::dim l = 3, d = 2, t = 5, mb = 2, c = 8, g = 4;
+    const auto dt = memory::data_type::f32;
+
+    memory::desc src_layer_md({t, mb, c}, dt, fmt::tnc);
+    memory::desc src_iter_md({l, d, mb, c}, dt, fmt::ldnc);
+    memory::desc weights_md({l, d, c, g, c}, dt, fmt::ldigo);
+    memory::desc bias_md({l, d, g, c}, dt, fmt::ldgo);
+    memory::desc dst_iter_md({l, d, mb, c}, dt, fmt::ldnc);
+
+    memory src_layer(src_layer_md, eng), src_iter(src_iter_md, eng),
+            src_iter_c(src_iter_md, eng), weights_layer(weights_md, eng),
+            weights_iter(weights_md, eng), bias(bias_md, eng);
+    fill_data<float>(src_layer_md.get_size() / sizeof(float), src_layer);
+    fill_data<float>(src_iter_md.get_size() / sizeof(float), src_iter);
+    fill_data<float>(src_iter_md.get_size() / sizeof(float), src_iter_c);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_layer);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_iter);
+    fill_data<float>(bias_md.get_size() / sizeof(float), bias);
+
+    // the execution mode is chosen when the primitive descriptor is
+    // created, and the cached primitives are dropped so that the primitive
+    // is created from the new primitive descriptor
+    auto run = [&](const char *wavefront, memory &dst_layer, memory &dst_iter,
+                       memory &dst_iter_c) {
+        setenv("DNNL_RNN_WAVEFRONT", wavefront, 1);
+        lstm_forward::primitive_desc pd(
+                lstm_forward::desc(prop_kind::forward_inference,
+                        dir::bidirectional_sum, src_layer_md, src_iter_md,
+                        src_iter_md, weights_md, weights_md, bias_md,
+                        src_layer_md, dst_iter_md, dst_iter_md),
+                eng);
+        unsetenv("DNNL_RNN_WAVEFRONT");
+        flush_primitive_cache();
+        lstm_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC_LAYER, src_layer},
+                        {DNNL_ARG_SRC_ITER, src_iter},
+                        {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                        {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                        {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                        {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                        {DNNL_ARG_DST_ITER, dst_iter},
+                        {DNNL_ARG_DST_ITER_C, dst_iter_c}});
+        strm.wait();
+    };
+
+    memory ref_dst_layer(src_layer_md, eng), ref_dst_iter(dst_iter_md, eng),
+            ref_dst_iter_c(dst_iter_md, eng);
+    memory dst_layer(src_layer_md, eng), dst_iter(dst_iter_md, eng),
+            dst_iter_c(dst_iter_md, eng);
+    run("0", ref_dst_layer, ref_dst_iter, ref_dst_iter_c);
+    run("1", dst_layer, dst_iter, dst_iter_c);
+    omp_set_num_threads(saved_nthr);
+
+    compare_data<float>(ref_dst_layer, dst_layer, 1e-5);
+    compare_data<float>(ref_dst_iter, dst_iter, 1e-5);
+    compare_data<float>(ref_dst_iter_c, dst_iter_c, 1e-5);
+}
+#endif
+
+TEST(lstm_peephole_projection_test, TestZeroPeepholeIdentityProjection) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "LSTM peephole and projection are supported on CPU only");
+
+    // zero peephole weights and an identity projection do not change the
+    // results of a vanilla LSTM
+    auto eng = engine(get_test_engine_kind(), 0);
+    auto strm = stream(eng);
+    const memory::dim l = 2, d = 1, t = 3, mb = 2, c = 8, g = 4;
+    const auto dt = memory::data_type::f32;
+
+    memory::desc src_layer_md({t, mb, c}, dt, fmt::tnc);
+    memory::desc src_iter_md({l, d, mb, c}, dt, fmt::ldnc);
+    memory::desc weights_md({l, d, c, g, c}, dt, fmt::ldigo);
+    memory::desc bias_md({l, d, g, c}, dt, fmt::ldgo);
+    memory::desc peephole_md({l, d, 3, c}, dt, fmt::ldgo);
+    memory::desc projection_md({l, d, c, c}, dt, fmt::ldio);
+
+    lstm_forward::primitive_desc ref_pd(
+            lstm_forward::desc(prop_kind::forward_inference,
+                    dir::unidirectional_left2right, src_layer_md, src_iter_md,
+                    src_iter_md, weights_md, weights_md, bias_md, src_layer_md,
+                    src_iter_md, src_iter_md),
+            eng);
+    lstm_forward::primitive_desc pd(
+            lstm_forward::desc(prop_kind::forward_inference,
+                    dir::unidirectional_left2right, src_layer_md, src_iter_md,
+                    src_iter_md, weights_md, weights_md, peephole_md,
+                    projection_md, bias_md, src_layer_md, src_iter_md,
+                    src_iter_md),
+            eng);
+    ASSERT_TRUE(pd.weights_peephole_desc() == peephole_md);
+    ASSERT_TRUE(pd.weights_projection_desc() == projection_md);
+    ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_WEIGHTS_PROJECTION)
+            == projection_md);
+    ASSERT_TRUE(ref_pd.weights_peephole_desc() == memory::desc());
+
+    memory src_layer(src_layer_md, eng), src_iter(src_iter_md, eng),
+            src_iter_c(src_iter_md, eng), weights_layer(weights_md, eng),
+            weights_iter(weights_md, eng), bias(bias_md, eng),
+            peephole(peephole_md, eng), projection(projection_md, eng);
+    fill_data<float>(src_layer_md.get_size() / sizeof(float), src_layer);
+    fill_data<float>(src_iter_md.get_size() / sizeof(float), src_iter);
+    fill_data<float>(src_iter_md.get_size() / sizeof(float), src_iter_c);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_layer);
+    fill_data<float>(weights_md.get_size() / sizeof(float), weights_iter);
+    fill_data<float>(bias_md.get_size() / sizeof(float), bias);
+    {
+        auto ptr = map_memory<float>(peephole);
+        for (size_t i = 0; i < peephole_md.get_size() / sizeof(float); i++)
+            ptr[i] = 0.f;
+    }
+    {
+        auto ptr = map_memory<float>(projection);
+        for (memory::dim ld = 0; ld < l * d; ld++)
+            for (memory::dim i = 0; i < c; i++)
+                for (memory::dim o = 0; o < c; o++)
+                    ptr[(ld * c + i) * c + o] = i == o ? 1.f : 0.f;
+    }
+
+    auto run = [&](const lstm_forward::primitive_desc &apd, memory &dst_layer,
+                       memory &dst_iter, memory &dst_iter_c) {
+        lstm_forward(apd).execute(strm,
+                {{DNNL_ARG_SRC_LAYER, src_layer},
+                        {DNNL_ARG_SRC_ITER, src_iter},
+                        {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                        {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                        {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                        {DNNL_ARG_WEIGHTS_PEEPHOLE, peephole},
+                        {DNNL_ARG_WEIGHTS_PROJECTION, projection},
+                        {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                        {DNNL_ARG_DST_ITER, dst_iter},
+                        {DNNL_ARG_DST_ITER_C, dst_iter_c}});
+        strm.wait();
+    };
+
+    memory ref_dst_layer(src_layer_md, eng), ref_dst_iter(src_iter_md, eng),
+            ref_dst_iter_c(src_iter_md, eng);
+    memory dst_layer(src_layer_md, eng), dst_iter(src_iter_md, eng),
+            dst_iter_c(src_iter_md, eng);
+    run(ref_pd, ref_dst_layer, ref_dst_iter, ref_dst_iter_c);
+    run(pd, dst_layer, dst_iter, dst_iter_c);
+
+    compare_data<float>(ref_dst_layer, dst_layer, 1e-5);
+    compare_data<float>(ref_dst_iter, dst_iter, 1e-5);
+    compare_data<float>(ref_dst_iter_c, dst_iter_c, 1e-5);
+}
+
+TEST(lstm_peephole_projection_test, TestProjectionDims) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "LSTM peephole and projection are supported on CPU only");
+
+    auto eng = engine(get_test_engine_kind(), 0);
+    const memory::dim l = 1, d = 1, t = 2, mb = 2, slc = 6, dhc = 8, dic = 4;
+    const auto dt = memory::data_type::f32;
+
+    memory::desc src_layer_md({t, mb, slc}, dt, fmt::any);
+    memory::desc src_iter_md({l, d, mb, dic}, dt, fmt::any);
+    memory::desc src_iter_c_md({l, d, mb, dhc}, dt, fmt::any);
+    memory::desc weights_layer_md({l, d, slc, 4, dhc}, dt, fmt::any);
+    memory::desc weights_iter_md({l, d, dic, 4, dhc}, dt, fmt::any);
+    memory::desc peephole_md({l, d, 3, dhc}, dt, fmt::any);
+    memory::desc projection_md({l, d, dhc, dic}, dt, fmt::any);
+    memory::desc bias_md({l, d, 4, dhc}, dt, fmt::any);
+    memory::desc dst_layer_md({t, mb, dic}, dt, fmt::any);
+
+    lstm_forward::primitive_desc pd(
+            lstm_forward::desc(prop_kind::forward_inference,
+                    dir::unidirectional_left2right, src_layer_md, src_iter_md,
+                    src_iter_c_md, weights_layer_md, weights_iter_md,
+                    peephole_md, projection_md, bias_md, dst_layer_md,
+                    src_iter_md, src_iter_c_md),
+            eng);
+    ASSERT_TRUE(pd.weights_projection_desc()
+            == memory::desc({l, d, dhc, dic}, dt, fmt::ldio));
+    ASSERT_TRUE(pd.weights_peephole_desc()
+            == memory::desc({l, d, 3, dhc}, dt, fmt::ldgo));
+
+    // the projection requires the hidden states to have dic channels
+    memory::desc bad_dst_layer_md({t, mb, dhc}, dt, fmt::any);
+    EXPECT_ANY_THROW(lstm_forward::desc(prop_kind::forward_inference,
+            dir::unidirectional_left2right, src_layer_md, src_iter_md,
+            src_iter_c_md, weights_layer_md, weights_iter_md, peephole_md,
+            projection_md, bias_md, bad_dst_layer_md, src_iter_md,
+            src_iter_c_md));
+}
+
+// Computes a unidirectional LSTM with peephole and projection, with the
+// plain layouts of the primitive's tensors, and compares the primitive to it
+class lstm_peephole_projection_ref_test : public ::testing::Test {
+protected:
+    const memory::dim l = 2, t = 3, mb = 2, dhc = 8, dic = 4, g = 4;
+    // the layers after the first one take the dic channels of the previous
+    // layer, so the first one takes the same number
+    const memory::dim slc = dic;
+
+    std::vector<float> src_layer, src_iter, src_iter_c, weights_layer,
+            weights_iter, peephole, projection, bias;
+
+    virtual void SetUp() {
+        // the values are rounded to bf16, so that the bf16 primitive
+        // computes the reference on the same inputs
+        auto make = [](memory::dim size, int seed, float scale) {
+            std::vector<float> x(size);
+            for (memory::dim i = 0; i < size; i++)
+                x[i] = (float)bfloat16_t(
+                        scale * std::sin((float)(i * 7 + seed)));
+            return x;
+        };
+        src_layer = make(t * mb * slc, 1, 1.f);
+        src_iter = make(l * mb * dic, 2, 1.f);
+        src_iter_c = make(l * mb * dhc, 3, 1.f);
+        weights_layer = make(l * slc * g * dhc, 4, 0.5f);
+        weights_iter = make(l * dic * g * dhc, 5, 0.5f);
+        peephole = make(l * 3 * dhc, 6, 0.5f);
+        projection = make(l * dhc * dic, 7, 0.5f);
+        bias = make(l * g * dhc, 8, 0.5f);
+    }
+
+    void compute_ref(std::vector<float> &dst_layer,
+            std::vector<float> &dst_iter,
+            std::vector<float> &dst_iter_c) const {
+        auto sigm = [](float x) { return 1.f / (1.f + std::exp(-x)); };
+        std::vector<float> x(src_layer), h(dic), c(dhc), gates(g * dhc),
+                ht(dhc);
+        dst_iter.resize(l * mb * dic);
+        dst_iter_c.resize(l * mb * dhc);
+        for (memory::dim ly = 0; ly < l; ly++) {
+            for (memory::dim b = 0; b < mb; b++) {
+                for (memory::dim k = 0; k < dic; k++)
+                    h[k] = src_iter[(ly * mb + b) * dic + k];
+                for (memory::dim j = 0; j < dhc; j++)
+                    c[j] = src_iter_c[(ly * mb + b) * dhc + j];
+                for (memory::dim it = 0; it < t; it++) {
+                    for (memory::dim gj = 0; gj < g * dhc; gj++) {
+                        float acc = bias[ly * g * dhc + gj];
+                        for (memory::dim k = 0; k < slc; k++)
+                            acc += x[(it * mb + b) * slc + k]
+                                    * weights_layer[(ly * slc + k) * g * dhc
+                                            + gj];
+                        for (memory::dim k = 0; k < dic; k++)
+                            acc += h[k]
+                                    * weights_iter[(ly * dic + k) * g * dhc
+                                            + gj];
+                        gates[gj] = acc;
+                    }
+                    const float *p = &peephole[ly * 3 * dhc];
+                    for (memory::dim j = 0; j < dhc; j++) {
+                        const float gi = sigm(gates[j] + p[j] * c[j]);
+                        const float gf
+                                = sigm(gates[dhc + j] + p[dhc + j] * c[j]);
+                        const float gc = std::tanh(gates[2 * dhc + j]);
+                        c[j] = gf * c[j] + gi * gc;
+                        const float go = sigm(
+                                gates[3 * dhc + j] + p[2 * dhc + j] * c[j]);
+                        ht[j] = go * std::tanh(c[j]);
+                    }
+                    for (memory::dim k = 0; k < dic; k++) {
+                        float acc = 0.f;
+                        for (memory::dim j = 0; j < dhc; j++)
+                            acc += ht[j]
+                                    * projection[(ly * dhc + j) * dic + k];
+                        h[k] = acc;
+                        x[(it * mb + b) * slc + k] = acc;
+                    }
+                }
+                for (memory::dim k = 0; k < dic; k++)
+                    dst_iter[(ly * mb + b) * dic + k] = h[k];
+                for (memory::dim j = 0; j < dhc; j++)
+                    dst_iter_c[(ly * mb + b) * dhc + j] = c[j];
+            }
+        }
+        dst_layer = x;
+    }
+
+    template <typename data_t>
+    static memory make_memory(const engine &eng, const memory::dims &dims,
+            memory::format_tag tag, const std::vector<float> &values) {
+        memory mem({dims, data_traits<data_t>::data_type, tag}, eng);
+        auto ptr = map_memory<data_t>(mem);
+        for (size_t i = 0; i < values.size(); i++)
+            ptr[i] = data_t(values[i]);
+        return mem;
+    }
+
+    template <typename data_t>
+    static void check(const memory &mem, const std::vector<float> &ref,
+            float threshold) {
+        auto ptr = map_memory<data_t>(mem);
+        for (size_t i = 0; i < ref.size(); i++)
+            ASSERT_NEAR((float)ptr[i], ref[i], threshold) << "index " << i;
+    }
+
+    // Runs the primitive with data_t states and weights and compares it to
+    // the reference
+    template <typename data_t>
+    void run(float threshold) {
+        auto eng = engine(get_test_engine_kind(), 0);
+        auto strm = stream(eng);
+        const memory::dim d = 1;
+
+        auto m_src_layer = make_memory<data_t>(
+                eng, {t, mb, slc}, fmt::tnc, src_layer);
+        auto m_src_iter = make_memory<data_t>(
+                eng, {l, d, mb, dic}, fmt::ldnc, src_iter);
+        auto m_src_iter_c = make_memory<float>(
+                eng, {l, d, mb, dhc}, fmt::ldnc, src_iter_c);
+        auto m_weights_layer = make_memory<data_t>(
+                eng, {l, d, slc, g, dhc}, fmt::ldigo, weights_layer);
+        auto m_weights_iter = make_memory<data_t>(
+                eng, {l, d, dic, g, dhc}, fmt::ldigo, weights_iter);
+        auto m_peephole = make_memory<float>(
+                eng, {l, d, 3, dhc}, fmt::ldgo, peephole);
+        auto m_projection = make_memory<data_t>(
+                eng, {l, d, dhc, dic}, fmt::ldio, projection);
+        auto m_bias = make_memory<float>(eng, {l, d, g, dhc}, fmt::ldgo, bias);
+        memory dst_layer(m_src_layer.get_desc(), eng),
+                dst_iter(m_src_iter.get_desc(), eng),
+                dst_iter_c(m_src_iter_c.get_desc(), eng);
+
+        lstm_forward::primitive_desc pd(
+                lstm_forward::desc(prop_kind::forward_inference,
+                        dir::unidirectional_left2right,
+                        m_src_layer.get_desc(), m_src_iter.get_desc(),
+                        m_src_iter_c.get_desc(), m_weights_layer.get_desc(),
+                        m_weights_iter.get_desc(), m_peephole.get_desc(),
+                        m_projection.get_desc(), m_bias.get_desc(),
+                        dst_layer.get_desc(), dst_iter.get_desc(),
+                        dst_iter_c.get_desc()),
+                eng);
+        lstm_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC_LAYER, m_src_layer},
+                        {DNNL_ARG_SRC_ITER, m_src_iter},
+                        {DNNL_ARG_SRC_ITER_C, m_src_iter_c},
+                        {DNNL_ARG_WEIGHTS_LAYER, m_weights_layer},
+                        {DNNL_ARG_WEIGHTS_ITER, m_weights_iter},
+                        {DNNL_ARG_WEIGHTS_PEEPHOLE, m_peephole},
+                        {DNNL_ARG_WEIGHTS_PROJECTION, m_projection},
+                        {DNNL_ARG_BIAS, m_bias},
+                        {DNNL_ARG_DST_LAYER, dst_layer},
+                        {DNNL_ARG_DST_ITER, dst_iter},
+                        {DNNL_ARG_DST_ITER_C, dst_iter_c}});
+        strm.wait();
+
+        std::vector<float> ref_dst_layer, ref_dst_iter, ref_dst_iter_c;
+        compute_ref(ref_dst_layer, ref_dst_iter, ref_dst_iter_c);
+        check<data_t>(dst_layer, ref_dst_layer, threshold);
+        check<data_t>(dst_iter, ref_dst_iter, threshold);
+        check<float>(dst_iter_c, ref_dst_iter_c, threshold);
+    }
+};
+
+TEST_F(lstm_peephole_projection_ref_test, TestF32) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "LSTM peephole and projection are supported on CPU only");
+    run<float>(1e-5f);
+}
+
+TEST_F(lstm_peephole_projection_ref_test, TestBF16) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "LSTM peephole and projection are supported on CPU only");
+    SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
+            "Skip test for systems that do not support avx512_core.");
+    // the states are rounded to bf16 at each iteration
+    run<bfloat16_t>(5e-2f);
+}
+
+TEST(lstm_peephole_projection_test, TestInt8IsRejected) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "LSTM peephole and projection are supported on CPU only");
+
+    auto eng = engine(get_test_engine_kind(), 0);
+    const memory::dim l = 1, d = 1, t = 2, mb = 2, c = 8, g = 4;
+    const auto u8 = memory::data_type::u8, s8 = memory::data_type::s8,
+               f32 = memory::data_type::f32;
+
+    memory::desc src_layer_md({t, mb, c}, u8, fmt::any);
+    memory::desc src_iter_md({l, d, mb, c}, u8, fmt::any);
+    memory::desc src_iter_c_md({l, d, mb, c}, f32, fmt::any);
+    memory::desc weights_md({l, d, c, g, c}, s8, fmt::any);
+    memory::desc peephole_md({l, d, 3, c}, f32, fmt::any);
+    memory::desc projection_md({l, d, c, c}, s8, fmt::any);
+    memory::desc bias_md({l, d, g, c}, f32, fmt::any);
+
+    auto make_pd = [&](const memory::desc &apeephole_md,
+                           const memory::desc &aprojection_md) {
+        return lstm_forward::primitive_desc(
+                lstm_forward::desc(prop_kind::forward_inference,
+                        dir::unidirectional_left2right, src_layer_md,
+                        src_iter_md, src_iter_c_md, weights_md, weights_md,
+                        apeephole_md, aprojection_md, bias_md, src_layer_md,
+                        src_iter_md, src_iter_c_md),
+                eng);
+    };
+    ASSERT_NO_THROW(make_pd(memory::desc(), memory::desc()));
+    EXPECT_ANY_THROW(make_pd(peephole_md, memory::desc()));
+    EXPECT_ANY_THROW(make_pd(memory::desc(), projection_md));
+}
+
 } // namespace dnnl
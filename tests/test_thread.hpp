@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef TEST_THREAD_HPP
+#define TEST_THREAD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dnnl_threadpool_iface.hpp"
+
+namespace dnnl {
+namespace testing {
+
+// A sample threadpool used to run the tests and benchdnn with the THREADPOOL
+// CPU runtime. The workers and the calling thread claim the instances of a
+// closure one by one, so a parallel_for() of any size completes on a pool of
+// any size.
+class threadpool_t : public threadpool_iface {
+public:
+    explicit threadpool_t(int num_threads = 0) {
+        if (num_threads <= 0)
+            num_threads = (int)std::thread::hardware_concurrency();
+        num_threads_ = std::max(1, num_threads);
+        for (int i = 1; i < num_threads_; i++)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    virtual ~threadpool_t() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &w : workers_)
+            w.join();
+    }
+
+    virtual int get_num_threads() const override { return num_threads_; }
+
+    virtual bool get_in_parallel() const override { return current() == this; }
+
+    virtual void parallel_for(
+            int n, const std::function<void(int, int)> &fn) override {
+        if (n <= 0) return;
+        if (n == 1 || workers_.empty() || get_in_parallel()) {
+            for (int i = 0; i < n; i++)
+                fn(i, n);
+            return;
+        }
+
+        // closures submitted by several threads are executed one by one
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn_ = &fn;
+            n_ = n;
+            next_ = 0;
+            active_++;
+            generation_++;
+        }
+        cv_.notify_all();
+
+        run(&fn, n);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        active_--;
+        done_cv_.wait(lock, [&]() { return active_ == 0; });
+        fn_ = nullptr;
+    }
+
+private:
+    static const threadpool_t *&current() {
+        static thread_local const threadpool_t *pool = nullptr;
+        return pool;
+    }
+
+    void run(const std::function<void(int, int)> *fn, int n) {
+        const threadpool_t *saved = current();
+        current() = this;
+        for (int i = next_++; i < n; i = next_++)
+            (*fn)(i, n);
+        current() = saved;
+    }
+
+    void work() {
+        unsigned long long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            // the closure may be already completed by the other threads
+            if (fn_ == nullptr) continue;
+
+            const std::function<void(int, int)> *fn = fn_;
+            const int n = n_;
+            active_++;
+            lock.unlock();
+            run(fn, n);
+            lock.lock();
+            if (--active_ == 0) done_cv_.notify_all();
+        }
+    }
+
+    int num_threads_;
+    std::vector<std::thread> workers_;
+
+    std::mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    bool stop_ = false;
+    unsigned long long generation_ = 0;
+    const std::function<void(int, int)> *fn_ = nullptr;
+    int n_ = 0;
+    int active_ = 0;
+    std::atomic<int> next_ {0};
+};
+
+} // namespace testing
+} // namespace dnnl
+
+#endif